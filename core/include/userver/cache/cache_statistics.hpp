@@ -6,8 +6,14 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include <userver/cache/update_type.hpp>
+#include <userver/concurrent/variable.hpp>
 #include <userver/utils/impl/internal_tag.hpp>
 #include <userver/utils/statistics/fwd.hpp>
 #include <userver/utils/statistics/rate_counter.hpp>
@@ -18,6 +24,9 @@ namespace cache {
 
 namespace impl {
 
+/// Durations of the named stages of an update, in the order of first report
+using StageDurations = std::vector<std::pair<std::string, std::chrono::milliseconds>>;
+
 struct UpdateStatistics final {
     utils::statistics::RateCounter update_attempt_count{0};
     utils::statistics::RateCounter update_no_changes_count{0};
@@ -29,6 +38,7 @@ struct UpdateStatistics final {
     std::atomic<std::chrono::steady_clock::time_point> last_update_start_time{{}};
     std::atomic<std::chrono::steady_clock::time_point> last_successful_update_start_time{{}};
     std::atomic<std::chrono::milliseconds> last_update_duration{{}};
+    concurrent::Variable<StageDurations, std::mutex> last_update_stage_durations;
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const UpdateStatistics& stats);
@@ -86,12 +96,23 @@ public:
     /// @param add the number of non-valid items newly received
     void IncreaseDocumentsParseFailures(std::size_t add);
 
+    /// @brief Accounts the time spent in a named stage of the `Update`, e.g.
+    /// in fetching or in parsing of the data. The stage durations of the last
+    /// update are reported as `time.last-update-stage-duration-ms` metrics
+    /// with the `stage` label.
+    /// @note This method can be called multiple times per `Update`, the
+    /// durations of a stage are summed up. If the `Update` runs the stages
+    /// concurrently, their durations may add up to more than the update took.
+    /// @warning Unlike the other methods, this one is not thread-safe.
+    void AddStageDuration(std::string_view stage, std::chrono::steady_clock::duration duration);
+
 private:
     void DoFinish(impl::UpdateState new_state);
 
     impl::Statistics& stats_;
     impl::UpdateStatistics& update_stats_;
     impl::UpdateState state_{impl::UpdateState::kNotFinished};
+    impl::StageDurations stage_durations_;
     const std::chrono::steady_clock::time_point update_start_time_;
 };
 
@@ -10,13 +10,16 @@
 #include <userver/cache/lru_cache_config.hpp>
 #include <userver/cache/lru_cache_statistics.hpp>
 #include <userver/cache/nway_lru_cache.hpp>
-#include <userver/concurrent/mutex_set.hpp>
+#include <userver/cache/policy.hpp>
+#include <userver/concurrent/single_flight.hpp>
 #include <userver/dump/common.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/impl/cached_time.hpp>
 #include <userver/utils/impl/wait_token_storage.hpp>
+#include <userver/utils/rand.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -51,10 +54,23 @@ impl::ExpirableValue<Value> Read(dump::Reader& reader, dump::To<impl::ExpirableV
 /// @brief Class for expirable LRU cache. Use cache::LruMap for not expirable
 /// LRU Cache.
 ///
+/// The eviction policy is selected by the `Policy` template parameter, see
+/// cache::CachePolicy. Cache hits do not block each other, see
+/// cache::NWayLRU.
+///
+/// Concurrent misses for the same key are coalesced: `update_func` is called
+/// once and all the callers receive its result, see concurrent::SingleFlight.
+/// The misses for other keys are not blocked by the update.
+///
 /// Example usage:
 ///
 /// @snippet cache/expirable_lru_cache_test.cpp Sample ExpirableLruCache
-template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Equal = std::equal_to<Key>,
+    CachePolicy Policy = CachePolicy::kLRU>
 class ExpirableLruCache final {
 public:
     using UpdateValueFunc = std::function<Value(const Key&)>;
@@ -82,7 +98,7 @@ public:
     /**
      * Sets background update mode. If "background_update" mode is kDisabled,
      * expiring values are not updated in background (asynchronously) or are
-     * updated if "background_update" is kEnabled.
+     * updated if "background_update" is kEnabled or kRefreshAhead.
      */
     void SetBackgroundUpdate(BackgroundUpdateMode background_update);
 
@@ -90,6 +106,9 @@ public:
      * @returns GetOptional("key", update_func) if it is not std::nullopt.
      * Otherwise the result of update_func(key) is returned, and additionally
      * stored in cache if "read_mode" is kUseCache.
+     *
+     * If update_func(key) is already running for a concurrent Get() or for a
+     * background update, waits for it and returns its result instead.
      */
     Value Get(const Key& key, const UpdateValueFunc& update_func, ReadMode read_mode = ReadMode::kUseCache);
 
@@ -134,7 +153,8 @@ public:
     /// Erase key from cache
     void InvalidateByKey(const Key& key);
 
-    /// Add async task for updating value by update_func(key)
+    /// Add async task for updating value by update_func(key), does nothing if
+    /// the value is being updated already
     void UpdateInBackground(const Key& key, UpdateValueFunc update_func);
 
     void Write(dump::Writer& writer) const;
@@ -151,50 +171,50 @@ private:
     bool ShouldUpdate(std::chrono::steady_clock::time_point update_time, std::chrono::steady_clock::time_point now)
         const;
 
-    cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal> lru_;
+    cache::NWayLRU<Key, impl::ExpirableValue<Value>, Hash, Equal, Policy> lru_;
     std::atomic<std::chrono::milliseconds> max_lifetime_{std::chrono::milliseconds(0)};
     std::atomic<BackgroundUpdateMode> background_update_mode_{BackgroundUpdateMode::kDisabled};
     impl::ExpirableLruCacheStatistics stats_;
-    concurrent::MutexSet<Key, Hash, Equal> mutex_set_;
+    concurrent::SingleFlight<Key, Value, Hash, Equal> single_flight_;
     utils::impl::WaitTokenStorage wait_token_storage_;
 };
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-ExpirableLruCache<Key, Value, Hash, Equal>::ExpirableLruCache(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+ExpirableLruCache<Key, Value, Hash, Equal, Policy>::ExpirableLruCache(
     size_t ways,
     size_t way_size,
     const Hash& hash,
     const Equal& equal
 )
-    : lru_(ways, way_size, hash, equal), mutex_set_{ways, way_size, hash, equal} {}
+    : lru_(ways, way_size, hash, equal), single_flight_{ways, hash, equal} {}
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-ExpirableLruCache<Key, Value, Hash, Equal>::~ExpirableLruCache() {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+ExpirableLruCache<Key, Value, Hash, Equal, Policy>::~ExpirableLruCache() {
     wait_token_storage_.WaitForAllTokens();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::SetWaySize(size_t way_size) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::SetWaySize(size_t way_size) {
     lru_.UpdateWaySize(way_size);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-std::chrono::milliseconds ExpirableLruCache<Key, Value, Hash, Equal>::GetMaxLifetime() const noexcept {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+std::chrono::milliseconds ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetMaxLifetime() const noexcept {
     return max_lifetime_.load();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::SetMaxLifetime(std::chrono::milliseconds max_lifetime) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::SetMaxLifetime(std::chrono::milliseconds max_lifetime) {
     max_lifetime_ = max_lifetime;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::SetBackgroundUpdate(BackgroundUpdateMode background_update) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::SetBackgroundUpdate(BackgroundUpdateMode background_update) {
     background_update_mode_ = background_update;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+Value ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Get(
     const Key& key,
     const UpdateValueFunc& update_func,
     ReadMode read_mode
@@ -205,25 +225,29 @@ Value ExpirableLruCache<Key, Value, Hash, Equal>::Get(
         return std::move(*opt_old_value);
     }
 
-    auto mutex = mutex_set_.GetMutexForKey(key);
-    std::lock_guard lock(mutex);
-    // Test one more time - concurrent ExpirableLruCache::Get()
-    // might have put the value
-    auto old_value = lru_.Get(key);
-    if (old_value && !IsExpired(old_value->update_time, now)) {
-        return std::move(old_value->value);
-    }
+    bool is_updater = false;
+    auto value = single_flight_.Execute(key, [&] {
+        is_updater = true;
+        // Test one more time - concurrent ExpirableLruCache::Get()
+        // might have put the value
+        auto old_value = lru_.Get(key);
+        if (old_value && !IsExpired(old_value->update_time, now)) {
+            return std::move(old_value->value);
+        }
 
-    auto value = update_func(key);
-    if (read_mode == ReadMode::kUseCache) {
-        lru_.Put(key, {value, now});
-    }
+        auto new_value = update_func(key);
+        if (read_mode == ReadMode::kUseCache) {
+            lru_.Put(key, {new_value, now});
+        }
+        return new_value;
+    });
+    if (!is_updater) impl::CacheCoalesced(stats_);
     return value;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
 std::optional<Value>
-ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(const Key& key, const UpdateValueFunc& update_func) {
+ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetOptional(const Key& key, const UpdateValueFunc& update_func) {
     auto now = utils::datetime::SteadyNow();
     auto old_value = lru_.Get(key);
 
@@ -245,8 +269,8 @@ ExpirableLruCache<Key, Value, Hash, Equal>::GetOptional(const Key& key, const Up
     return std::nullopt;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnexpirable(const Key& key) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetOptionalUnexpirable(const Key& key) {
     auto old_value = lru_.Get(key);
 
     if (old_value) {
@@ -258,8 +282,8 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnex
     return std::nullopt;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnexpirableWithUpdate(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetOptionalUnexpirableWithUpdate(
     const Key& key,
     const UpdateValueFunc& update_func
 ) {
@@ -280,8 +304,8 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalUnex
     return std::nullopt;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUpdate(const Key& key) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetOptionalNoUpdate(const Key& key) {
     auto now = utils::datetime::SteadyNow();
     auto old_value = lru_.Get(key);
 
@@ -299,58 +323,75 @@ std::optional<Value> ExpirableLruCache<Key, Value, Hash, Equal>::GetOptionalNoUp
     return std::nullopt;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key, const Value& value) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Put(const Key& key, const Value& value) {
     lru_.Put(key, {value, utils::datetime::SteadyNow()});
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::Put(const Key& key, Value&& value) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Put(const Key& key, Value&& value) {
     lru_.Put(key, {std::move(value), utils::datetime::SteadyNow()});
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-const impl::ExpirableLruCacheStatistics& ExpirableLruCache<Key, Value, Hash, Equal>::GetStatistics() const {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+const impl::ExpirableLruCacheStatistics& ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetStatistics() const {
     return stats_;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-size_t ExpirableLruCache<Key, Value, Hash, Equal>::GetSizeApproximate() const {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+size_t ExpirableLruCache<Key, Value, Hash, Equal, Policy>::GetSizeApproximate() const {
     return lru_.GetSize();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::Invalidate() {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Invalidate() {
     lru_.Invalidate();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::InvalidateByKey(const Key& key) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::InvalidateByKey(const Key& key) {
     lru_.InvalidateByKey(key);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::UpdateInBackground(const Key& key, UpdateValueFunc update_func) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::UpdateInBackground(
+    const Key& key,
+    UpdateValueFunc update_func
+) {
+    // The key is claimed before the task starts, so that frequent reads of
+    // an expiring key do not spawn a task per read. Concurrent Get() calls for
+    // the key wait for this update.
+    auto leader = single_flight_.TryLead(key);
+    if (!leader) {
+        // someone is updating the key right now
+        return;
+    }
+
     stats_.total.background_updates++;
     stats_.recent.GetCurrentCounter().background_updates++;
 
-    // cache will wait for all detached tasks in ~ExpirableLruCache()
-    engine::AsyncNoSpan([token = wait_token_storage_.GetToken(), this, key, update_func = std::move(update_func)] {
-        auto mutex = mutex_set_.GetMutexForKey(key);
-        std::unique_lock lock(mutex, std::try_to_lock);
-        if (!lock) {
-            // someone is updating the key right now
-            return;
-        }
+    struct Update final {
+        // cache will wait for all detached tasks in ~ExpirableLruCache()
+        utils::impl::WaitTokenStorage::Token token;
+        // destroyed before the token, because it refers to the cache
+        typename concurrent::SingleFlight<Key, Value, Hash, Equal>::Leader leader;
+    };
 
-        auto now = utils::datetime::SteadyNow();
-        auto value = update_func(key);
-        lru_.Put(key, {value, now});
+    engine::AsyncNoSpan([this,
+                         key,
+                         update_func = std::move(update_func),
+                         update = Update{wait_token_storage_.GetToken(), std::move(*leader)}]() mutable {
+        update.leader.Run([&] {
+            auto now = utils::datetime::SteadyNow();
+            auto value = update_func(key);
+            lru_.Put(key, {value, now});
+            return value;
+        });
     }).Detach();
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-bool ExpirableLruCache<Key, Value, Hash, Equal>::IsExpired(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+bool ExpirableLruCache<Key, Value, Hash, Equal, Policy>::IsExpired(
     std::chrono::steady_clock::time_point update_time,
     std::chrono::steady_clock::time_point now
 ) const {
@@ -358,20 +399,44 @@ bool ExpirableLruCache<Key, Value, Hash, Equal>::IsExpired(
     return max_lifetime.count() != 0 && update_time + max_lifetime < now;
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-bool ExpirableLruCache<Key, Value, Hash, Equal>::ShouldUpdate(
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+bool ExpirableLruCache<Key, Value, Hash, Equal, Policy>::ShouldUpdate(
     std::chrono::steady_clock::time_point update_time,
     std::chrono::steady_clock::time_point now
 ) const {
-    auto max_lifetime = max_lifetime_.load();
-    return (background_update_mode_.load() == BackgroundUpdateMode::kEnabled) && max_lifetime.count() != 0 &&
-           update_time + max_lifetime / 2 < now;
+    const auto max_lifetime = max_lifetime_.load();
+    if (max_lifetime.count() == 0) return false;
+
+    const auto update_start = update_time + max_lifetime / 2;
+    if (update_start >= now) return false;
+
+    switch (background_update_mode_.load()) {
+        case BackgroundUpdateMode::kDisabled:
+            return false;
+        case BackgroundUpdateMode::kEnabled:
+            return true;
+        case BackgroundUpdateMode::kRefreshAhead: {
+            // Every read in the second half of the lifetime triggers the update
+            // with a probability growing from 0 to 1 towards the expiry. The
+            // frequently read keys are updated soon after the half of the
+            // lifetime, the rarely read ones are mostly left to expire.
+            const auto window = max_lifetime - max_lifetime / 2;
+            const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - update_start);
+            return elapsed >= window || utils::RandRange(window.count()) < elapsed.count();
+        }
+    }
+    UINVARIANT(false, "Unexpected background update mode");
 }
 
-template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+template <
+    typename Key,
+    typename Value,
+    typename Hash = std::hash<Key>,
+    typename Equal = std::equal_to<Key>,
+    CachePolicy Policy = CachePolicy::kLRU>
 class LruCacheWrapper final {
 public:
-    using Cache = ExpirableLruCache<Key, Value, Hash, Equal>;
+    using Cache = ExpirableLruCache<Key, Value, Hash, Equal, Policy>;
     using ReadMode = typename Cache::ReadMode;
 
     LruCacheWrapper(std::shared_ptr<Cache> cache, typename Cache::UpdateValueFunc update_func)
@@ -398,25 +463,25 @@ private:
     typename Cache::UpdateValueFunc update_func_;
 };
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::Write(dump::Writer& writer) const {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Write(dump::Writer& writer) const {
     utils::impl::UpdateGlobalTime();
     lru_.Write(writer);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::Read(dump::Reader& reader) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::Read(dump::Reader& reader) {
     utils::impl::UpdateGlobalTime();
     lru_.Read(reader);
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void ExpirableLruCache<Key, Value, Hash, Equal>::SetDumper(std::shared_ptr<dump::Dumper> dumper) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void ExpirableLruCache<Key, Value, Hash, Equal, Policy>::SetDumper(std::shared_ptr<dump::Dumper> dumper) {
     lru_.SetDumper(std::move(dumper));
 }
 
-template <typename Key, typename Value, typename Hash, typename Equal>
-void DumpMetric(utils::statistics::Writer& writer, const ExpirableLruCache<Key, Value, Hash, Equal>& cache) {
+template <typename Key, typename Value, typename Hash, typename Equal, CachePolicy Policy>
+void DumpMetric(utils::statistics::Writer& writer, const ExpirableLruCache<Key, Value, Hash, Equal, Policy>& cache) {
     writer["current-documents-count"] = cache.GetSizeApproximate();
     writer = cache.GetStatistics();
 }
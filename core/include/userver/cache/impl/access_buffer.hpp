@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// A small index of the current thread, the indexes are assigned in the order
+/// of the first call
+std::size_t GetThreadIndex() noexcept;
+
+/// Bounded lossy multi-producer single-consumer buffer of the accessed
+/// elements, e.g. of the pointers to the nodes of a container.
+///
+/// Readers record the hits without taking the container lock exclusively,
+/// the owner of the exclusive lock replays them. The buffer is split into
+/// stripes, a thread records into its own stripe, so the readers of different
+/// threads mostly do not contend on the same atomics. The order of recording
+/// is kept within a stripe. When a stripe is full the access is dropped: the
+/// eviction order is a heuristic anyway, and the hits must never wait for it.
+template <typename T, std::size_t Capacity = 16, std::size_t Stripes = 4>
+class AccessBuffer final {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of 2");
+    static_assert(Stripes > 0);
+    static_assert(std::is_trivially_copyable_v<T> && std::atomic<T>::is_always_lock_free);
+
+public:
+    AccessBuffer() = default;
+
+    AccessBuffer(const AccessBuffer&) = delete;
+    AccessBuffer& operator=(const AccessBuffer&) = delete;
+
+    /// Thread-safe. `value` must not be equal to `T{}`.
+    /// @returns true if the stripe is at least half full and the buffer should
+    /// be drained
+    bool Record(T value) noexcept;
+
+    /// Calls `func(T)` for the recorded values. Must not be called
+    /// concurrently with other Drain or Clear calls.
+    template <typename Function>
+    void Drain(Function&& func);
+
+    /// Drops the recorded values. Must not be called concurrently with other
+    /// Drain or Clear calls.
+    void Clear() noexcept {
+        Drain([](T) noexcept {});
+    }
+
+private:
+    struct Stripe final {
+        // The next slot to drain
+        std::atomic<std::size_t> head{0};
+        // The next slot to record into
+        std::atomic<std::size_t> tail{0};
+        // `T{}` marks a slot that is free or is reserved, but not written yet
+        std::array<std::atomic<T>, Capacity> slots{};
+    };
+
+    std::array<concurrent::impl::InterferenceShield<Stripe>, Stripes> stripes_;
+};
+
+template <typename T, std::size_t Capacity, std::size_t Stripes>
+bool AccessBuffer<T, Capacity, Stripes>::Record(T value) noexcept {
+    auto& stripe = *stripes_[Stripes == 1 ? 0 : GetThreadIndex() % Stripes];
+
+    auto tail = stripe.tail.load(std::memory_order_relaxed);
+    do {
+        // acquire: the slot was released by Drain before head moved past it
+        if (tail - stripe.head.load(std::memory_order_acquire) >= Capacity) return true;
+    } while (!stripe.tail.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed));
+
+    stripe.slots[tail % Capacity].store(value, std::memory_order_release);
+
+    return tail + 1 - stripe.head.load(std::memory_order_relaxed) >= Capacity / 2;
+}
+
+template <typename T, std::size_t Capacity, std::size_t Stripes>
+template <typename Function>
+void AccessBuffer<T, Capacity, Stripes>::Drain(Function&& func) {
+    for (auto& shield : stripes_) {
+        auto& stripe = *shield;
+        auto head = stripe.head.load(std::memory_order_relaxed);
+        const auto tail = stripe.tail.load(std::memory_order_relaxed);
+
+        for (; head != tail; ++head) {
+            auto& slot = stripe.slots[head % Capacity];
+            const auto value = slot.load(std::memory_order_acquire);
+            // The slot is reserved, but is still being written to
+            if (value == T{}) break;
+
+            slot.store(T{}, std::memory_order_relaxed);
+            stripe.head.store(head + 1, std::memory_order_release);
+
+            func(value);
+        }
+    }
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
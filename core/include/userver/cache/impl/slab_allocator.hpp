@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Memory accounting of impl::SlabAllocator
+struct SlabMemoryStatistics final {
+    /// Memory taken from the OS, including the free chunks and pages
+    std::size_t mapped_bytes{0};
+    /// Memory of the allocated chunks, including their rounding up
+    std::size_t allocated_bytes{0};
+    /// Memory requested by the users
+    std::size_t requested_bytes{0};
+    std::size_t allocations{0};
+};
+
+/// @brief Allocator of byte buffers outside the general heap.
+///
+/// Small buffers are allocated as chunks of fixed-size pages, that are mapped
+/// directly from the OS. Each page holds the chunks of a single size class.
+/// The sizes of the classes grow geometrically, so that no more than 1/4 of
+/// an allocation is lost to rounding. A page is returned to the OS as soon as
+/// all its chunks are free. The buffers larger than a chunk are mapped one by
+/// one.
+///
+/// Not thread-safe.
+class SlabAllocator final {
+public:
+    static constexpr std::size_t kPageSize = 256 * 1024;
+    static constexpr std::size_t kMaxChunkSize = kPageSize / 8;
+
+    SlabAllocator() noexcept;
+    ~SlabAllocator();
+
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    /// @brief Allocates a buffer of `size` bytes.
+    /// @param may_map whether the allocator may take more memory from the OS
+    /// @returns nullptr if there is no free chunk to fit `size` and `may_map`
+    /// is false
+    /// @throws std::bad_alloc if the OS is out of memory
+    char* Allocate(std::size_t size, bool may_map);
+
+    /// Frees a buffer allocated by Allocate with the same `size`
+    void Deallocate(char* data, std::size_t size) noexcept;
+
+    /// @returns the memory taken by an allocation of `size` bytes
+    static std::size_t GetAllocationSize(std::size_t size) noexcept;
+
+    /// @returns the memory taken from the OS if an allocation of `size` bytes
+    /// does not fit into the free chunks
+    static std::size_t GetMappingSize(std::size_t size) noexcept;
+
+    const SlabMemoryStatistics& GetStatistics() const noexcept { return stats_; }
+
+private:
+    struct Page;
+    struct LargeBuffer;
+
+    static constexpr std::size_t kSizeClassCount = 48;
+
+    char* AllocateLarge(std::size_t size);
+    void DeallocateLarge(char* data, std::size_t size) noexcept;
+
+    Page* MapPage();
+    void UnmapPage(Page* page) noexcept;
+
+    // The pages with free chunks, by size class
+    std::array<Page*, kSizeClassCount> free_pages_{};
+    // All the mapped pages
+    Page* pages_{nullptr};
+    LargeBuffer* large_buffers_{nullptr};
+    // An empty page kept mapped to avoid mmap/munmap on the boundary
+    Page* spare_page_{nullptr};
+    SlabMemoryStatistics stats_;
+};
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -15,8 +15,16 @@ USERVER_NAMESPACE_BEGIN
 namespace cache {
 
 enum class BackgroundUpdateMode {
+    /// Expiring values are updated by the first read after the half of their
+    /// lifetime
     kEnabled,
+    /// Expiring values are not updated in background
     kDisabled,
+    /// Expiring values are updated by a read in the second half of their
+    /// lifetime with a probability growing towards the expiry, so that
+    /// the frequently read values are updated early and the rarely read ones
+    /// are left to expire
+    kRefreshAhead,
 };
 
 struct LruCacheConfig final {
@@ -1,22 +1,44 @@
 #pragma once
 
 #include <functional>
+#include <mutex>
 #include <optional>
+#include <shared_mutex>
 #include <vector>
 
 #include <boost/container_hash/hash.hpp>
 
+#include <userver/cache/impl/access_buffer.hpp>
 #include <userver/cache/lru_map.hpp>
+#include <userver/cache/policy.hpp>
 #include <userver/dump/dumper.hpp>
 #include <userver/dump/operations.hpp>
-#include <userver/engine/mutex.hpp>
+#include <userver/engine/shared_mutex.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace cache {
 
 /// @ingroup userver_containers
-template <typename T, typename U, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+///
+/// Cache hits take the lock of the way in shared mode only and do not wait
+/// for each other: the usage updates are recorded into a per-way buffer,
+/// striped by thread, and are applied by the next writer (or by a reader that
+/// manages to lock the way without waiting). A hit records a pointer to the
+/// element and does not copy the key. Updates are dropped when the buffer is
+/// full, which makes the eviction order slightly approximate under heavy
+/// contention.
+/// The lookup frequencies of cache::CachePolicy::kTinyLFU are not affected:
+/// every lookup, hit or miss, is counted right away.
+///
+/// The eviction policy is selected by the `Policy` template parameter, see
+/// cache::CachePolicy.
+template <
+    typename T,
+    typename U,
+    typename Hash = std::hash<T>,
+    typename Equal = std::equal_to<T>,
+    CachePolicy Policy = CachePolicy::kLRU>
 class NWayLRU final {
 public:
     /// @param ways is the number of ways (a.k.a. shards, internal hash-maps),
@@ -29,7 +51,7 @@ public:
     ///
     /// @param way_size is the maximum allowed amount of elements per way. When
     /// the size of a way reaches this number, existing elements are deleted
-    /// according to the LRU policy.
+    /// according to the `Policy`.
     ///
     /// The maximum total number of elements is `ways * way_size`.
     NWayLRU(size_t ways, size_t way_size, const Hash& hash = Hash(), const Equal& equal = Equal());
@@ -73,12 +95,20 @@ private:
         // max_size is not used, will be reset by Resize() in NWayLRU::NWayLRU
         Way(const Hash& hash, const Equal& equal) : cache(1, hash, equal) {}
 
-        mutable engine::Mutex mutex;
-        LruMap<T, U, Hash, Equal> cache;
+        mutable engine::SharedMutex mutex;
+        LruMap<T, U, Hash, Equal, Policy> cache;
+        // The nodes are recorded under the shared lock, and every modification
+        // of the way applies the accesses first, so the recorded nodes are alive
+        impl::AccessBuffer<const impl::LruNode<T, U>*> accesses;
     };
 
     Way& GetWay(const T& key);
 
+    static void TryApplyAccesses(Way& way);
+
+    // Must be called with the exclusive lock of the way held
+    static void ApplyAccesses(Way& way);
+
     void NotifyDumper();
 
     std::vector<Way> caches_;
@@ -86,8 +116,8 @@ private:
     std::shared_ptr<dump::Dumper> dumper_{nullptr};
 };
 
-template <typename T, typename U, typename Hash, typename Eq>
-NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash, const Eq& equal)
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
+NWayLRU<T, U, Hash, Eq, Policy>::NWayLRU(size_t ways, size_t way_size, const Hash& hash, const Eq& equal)
     : caches_(), hash_fn_(hash) {
     caches_.reserve(ways);
     for (size_t i = 0; i < ways; ++i) caches_.emplace_back(hash, equal);
@@ -96,22 +126,40 @@ NWayLRU<T, U, Hash, Eq>::NWayLRU(size_t ways, size_t way_size, const Hash& hash,
     for (auto& way : caches_) way.cache.SetMaxSize(way_size);
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-void NWayLRU<T, U, Hash, Eq>::Put(const T& key, U value) {
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
+void NWayLRU<T, U, Hash, Eq, Policy>::Put(const T& key, U value) {
     auto& way = GetWay(key);
     {
-        std::unique_lock<engine::Mutex> lock(way.mutex);
+        std::unique_lock lock(way.mutex);
+        ApplyAccesses(way);
         way.cache.Put(key, std::move(value));
     }
     NotifyDumper();
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
 template <typename Validator>
-std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key, Validator validator) {
+std::optional<U> NWayLRU<T, U, Hash, Eq, Policy>::Get(const T& key, Validator validator) {
     auto& way = GetWay(key);
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    auto* value = way.cache.Get(key);
+    {
+        std::shared_lock lock(way.mutex);
+        way.cache.RecordLookup(key);
+        const auto* node = way.cache.PeekNode(key);
+        if (!node) return std::nullopt;
+
+        if (validator(node->GetValue())) {
+            std::optional<U> result{node->GetValue()};
+            const bool should_apply = way.accesses.Record(node);
+            lock.unlock();
+            if (should_apply) TryApplyAccesses(way);
+            return result;
+        }
+    }
+
+    // The value is invalid, erase it unless it was replaced concurrently
+    std::unique_lock lock(way.mutex);
+    ApplyAccesses(way);
+    auto* value = way.cache.UpdateUsage(key);
 
     if (value) {
         if (validator(*value)) return *value;
@@ -121,61 +169,77 @@ std::optional<U> NWayLRU<T, U, Hash, Eq>::Get(const T& key, Validator validator)
     return std::nullopt;
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-void NWayLRU<T, U, Hash, Eq>::InvalidateByKey(const T& key) {
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
+void NWayLRU<T, U, Hash, Eq, Policy>::InvalidateByKey(const T& key) {
     auto& way = GetWay(key);
     {
-        std::unique_lock<engine::Mutex> lock(way.mutex);
+        std::unique_lock lock(way.mutex);
+        ApplyAccesses(way);
         way.cache.Erase(key);
     }
     NotifyDumper();
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-U NWayLRU<T, U, Hash, Eq>::GetOr(const T& key, const U& default_value) {
-    auto& way = GetWay(key);
-    std::unique_lock<engine::Mutex> lock(way.mutex);
-    return way.cache.GetOr(key, default_value);
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
+U NWayLRU<T, U, Hash, Eq, Policy>::GetOr(const T& key, const U& default_value) {
+    auto value = Get(key);
+    if (value) return std::move(*value);
+    return default_value;
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-void NWayLRU<T, U, Hash, Eq>::Invalidate() {
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
+void NWayLRU<T, U, Hash, Eq, Policy>::Invalidate() {
     for (auto& way : caches_) {
-        std::unique_lock<engine::Mutex> lock(way.mutex);
+        std::unique_lock lock(way.mutex);
+        way.accesses.Clear();
         way.cache.Clear();
     }
     NotifyDumper();
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
 template <typename Function>
-void NWayLRU<T, U, Hash, Eq>::VisitAll(Function func) const {
+void NWayLRU<T, U, Hash, Eq, Policy>::VisitAll(Function func) const {
     for (const auto& way : caches_) {
-        std::unique_lock<engine::Mutex> lock(way.mutex);
+        std::shared_lock lock(way.mutex);
         way.cache.VisitAll(func);
     }
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-size_t NWayLRU<T, U, Hash, Eq>::GetSize() const {
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
+size_t NWayLRU<T, U, Hash, Eq, Policy>::GetSize() const {
     size_t size{0};
     for (const auto& way : caches_) {
-        std::unique_lock<engine::Mutex> lock(way.mutex);
+        std::shared_lock lock(way.mutex);
         size += way.cache.GetSize();
     }
     return size;
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-void NWayLRU<T, U, Hash, Eq>::UpdateWaySize(size_t way_size) {
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
+void NWayLRU<T, U, Hash, Eq, Policy>::UpdateWaySize(size_t way_size) {
     for (auto& way : caches_) {
-        std::unique_lock<engine::Mutex> lock(way.mutex);
+        std::unique_lock lock(way.mutex);
+        ApplyAccesses(way);
         way.cache.SetMaxSize(way_size);
     }
 }
 
-template <typename T, typename U, typename Hash, typename Eq>
-typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(const T& key) {
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
+void NWayLRU<T, U, Hash, Eq, Policy>::TryApplyAccesses(Way& way) {
+    // Never wait for the writers on a hit, the next one applies the accesses
+    std::unique_lock lock(way.mutex, std::try_to_lock);
+    if (lock) ApplyAccesses(way);
+}
+
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
+void NWayLRU<T, U, Hash, Eq, Policy>::ApplyAccesses(Way& way) {
+    // UpdateUsage only relinks the nodes, the other recorded nodes stay alive
+    way.accesses.Drain([&way](const impl::LruNode<T, U>* node) { way.cache.UpdateUsage(node->GetKey()); });
+}
+
+template <typename T, typename U, typename Hash, typename Eq, CachePolicy Policy>
+typename NWayLRU<T, U, Hash, Eq, Policy>::Way& NWayLRU<T, U, Hash, Eq, Policy>::GetWay(const T& key) {
     /// It is needed to twist hash because there is hash map in LruMap. Otherwise
     /// nodes will fall into one bucket. According to
     /// https://www.boost.org/doc/libs/1_83_0/libs/container_hash/doc/html/hash.html#notes_hash_combine
@@ -186,12 +250,12 @@ typename NWayLRU<T, U, Hash, Eq>::Way& NWayLRU<T, U, Hash, Eq>::GetWay(const T&
     return caches_[n];
 }
 
-template <typename T, typename U, typename Hash, typename Equal>
-void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
+template <typename T, typename U, typename Hash, typename Equal, CachePolicy Policy>
+void NWayLRU<T, U, Hash, Equal, Policy>::Write(dump::Writer& writer) const {
     writer.Write(caches_.size());
 
     for (const Way& way : caches_) {
-        std::unique_lock<engine::Mutex> lock(way.mutex);
+        std::shared_lock lock(way.mutex);
 
         writer.Write(way.cache.GetSize());
 
@@ -202,8 +266,8 @@ void NWayLRU<T, U, Hash, Equal>::Write(dump::Writer& writer) const {
     }
 }
 
-template <typename T, typename U, typename Hash, typename Equal>
-void NWayLRU<T, U, Hash, Equal>::Read(dump::Reader& reader) {
+template <typename T, typename U, typename Hash, typename Equal, CachePolicy Policy>
+void NWayLRU<T, U, Hash, Equal, Policy>::Read(dump::Reader& reader) {
     Invalidate();
 
     const auto ways = reader.Read<std::size_t>();
@@ -217,15 +281,15 @@ void NWayLRU<T, U, Hash, Equal>::Read(dump::Reader& reader) {
     }
 }
 
-template <typename T, typename U, typename Hash, typename Equal>
-void NWayLRU<T, U, Hash, Equal>::NotifyDumper() {
+template <typename T, typename U, typename Hash, typename Equal, CachePolicy Policy>
+void NWayLRU<T, U, Hash, Equal, Policy>::NotifyDumper() {
     if (dumper_ != nullptr) {
         dumper_->OnUpdateCompleted();
     }
 }
 
-template <typename T, typename U, typename Hash, typename Equal>
-void NWayLRU<T, U, Hash, Equal>::SetDumper(std::shared_ptr<dump::Dumper> dumper) {
+template <typename T, typename U, typename Hash, typename Equal, CachePolicy Policy>
+void NWayLRU<T, U, Hash, Equal, Policy>::SetDumper(std::shared_ptr<dump::Dumper> dumper) {
     dumper_ = std::move(dumper);
 }
 
@@ -0,0 +1,335 @@
+#pragma once
+
+/// @file userver/cache/slab_cache.hpp
+/// @brief @copybrief cache::SlabCache
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/slab_allocator.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_buffer.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// Statistics of cache::SlabBytesCache and cache::SlabCache
+struct SlabCacheStatistics final {
+    std::size_t entries{0};
+    std::size_t hits{0};
+    std::size_t misses{0};
+    /// Entries evicted to fit the new ones into the memory limit
+    std::size_t evictions{0};
+    /// Values not stored, because they alone do not fit into the memory limit
+    std::size_t rejected{0};
+
+    /// Off-heap memory taken from the OS, it is bounded by the memory limit
+    std::size_t mapped_bytes{0};
+    /// Memory of the stored values, including their rounding up to a size class
+    std::size_t allocated_bytes{0};
+    /// Memory of the stored values
+    std::size_t stored_bytes{0};
+
+    SlabCacheStatistics& operator+=(const SlabCacheStatistics& other);
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const SlabCacheStatistics& stats);
+
+/// @ingroup userver_containers
+///
+/// @brief Thread-safe LRU cache of byte strings, bounded by the memory
+/// it takes rather than by the number of elements.
+///
+/// The values are stored in slab pages mapped directly from the OS, outside
+/// the general heap, see cache::impl::SlabAllocator. The memory limit bounds
+/// the mapped memory, the least recently used values are evicted to fit the
+/// new ones. The keys and the index stay in the heap.
+///
+/// Like in cache::NWayLRU, the cache is split into `ways`, each holding its
+/// part of the keys and of the memory limit under its own mutex.
+///
+/// @note The limit of a way should be many times the slab page size
+/// (cache::impl::SlabAllocator::kPageSize), because the values of different
+/// size classes do not share pages.
+template <typename Key, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class SlabBytesCache final {
+public:
+    SlabBytesCache(std::size_t ways, std::size_t max_bytes, const Hash& hash = Hash(), const Equal& equal = Equal());
+
+    /// @brief Stores a copy of `value`, evicting the least recently used values
+    /// if needed.
+    /// @returns false if `value` alone does not fit into the memory limit of
+    /// a way. In this case the old value of `key` is erased.
+    bool Put(const Key& key, std::string_view value);
+
+    /// @returns a copy of the value of `key`, updates its usage
+    std::optional<std::string> Get(const Key& key);
+
+    void Erase(const Key& key);
+
+    void Clear();
+
+    /// Sets the memory limit, evicts the values that do not fit into it
+    void SetMaxBytes(std::size_t max_bytes);
+
+    std::size_t GetSizeApproximate() const;
+
+    SlabCacheStatistics GetStatistics() const;
+
+private:
+    struct Slot final {
+        char* data{nullptr};
+        std::size_t size{0};
+    };
+
+    struct Way final {
+        Way(const Hash& hash, const Equal& equal) : lru(kInitialCapacity, hash, equal) {}
+
+        mutable engine::Mutex mutex;
+        impl::LruBase<Key, Slot, Hash, Equal> lru;
+        impl::SlabAllocator allocator;
+        std::size_t max_bytes{0};
+        std::size_t hits{0};
+        std::size_t misses{0};
+        std::size_t evictions{0};
+        std::size_t rejected{0};
+    };
+
+    static constexpr std::size_t kInitialCapacity = 1024;
+
+    Way& GetWay(const Key& key);
+
+    // Evicts the least recently used values until `size` bytes may be allocated
+    static char* Allocate(Way& way, std::size_t size);
+
+    static void Free(Way& way, const Slot& slot) noexcept;
+
+    static bool EvictOne(Way& way);
+
+    Hash hash_;
+    utils::FixedArray<Way> ways_;
+};
+
+/// @ingroup userver_containers
+///
+/// @brief Thread-safe LRU cache, bounded by the memory its values take after
+/// serialization.
+///
+/// The values are serialized with `dump::Write` and `dump::Read` and stored in
+/// a cache::SlabBytesCache. Each Get() deserializes a new copy of the value,
+/// so the cache suits the values that are cheap to deserialize compared to
+/// the cost of getting them otherwise.
+///
+/// Example usage:
+///
+/// @snippet cache/slab_cache_test.cpp Sample SlabCache
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class SlabCache final {
+public:
+    /// For the description of the arguments, see cache::SlabBytesCache
+    SlabCache(std::size_t ways, std::size_t max_bytes, const Hash& hash = Hash(), const Equal& equal = Equal())
+        : bytes_cache_(ways, max_bytes, hash, equal) {}
+
+    /// @returns false if `value` alone does not fit into the memory limit
+    /// @see cache::SlabBytesCache::Put
+    bool Put(const Key& key, const Value& value) {
+        dump::impl::BufferWriter writer;
+        writer.Write(value);
+        writer.Finish();
+        return bytes_cache_.Put(key, std::move(writer).Extract());
+    }
+
+    std::optional<Value> Get(const Key& key) {
+        auto data = bytes_cache_.Get(key);
+        if (!data) return std::nullopt;
+
+        dump::impl::BufferReader reader(std::move(*data));
+        auto value = reader.Read<Value>();
+        reader.Finish();
+        return value;
+    }
+
+    void Erase(const Key& key) { bytes_cache_.Erase(key); }
+
+    void Clear() { bytes_cache_.Clear(); }
+
+    void SetMaxBytes(std::size_t max_bytes) { bytes_cache_.SetMaxBytes(max_bytes); }
+
+    std::size_t GetSizeApproximate() const { return bytes_cache_.GetSizeApproximate(); }
+
+    SlabCacheStatistics GetStatistics() const { return bytes_cache_.GetStatistics(); }
+
+private:
+    SlabBytesCache<Key, Hash, Equal> bytes_cache_;
+};
+
+template <typename Key, typename Hash, typename Equal>
+SlabBytesCache<Key, Hash, Equal>::SlabBytesCache(
+    std::size_t ways,
+    std::size_t max_bytes,
+    const Hash& hash,
+    const Equal& equal
+)
+    : hash_(hash), ways_(ways, hash, equal) {
+    UINVARIANT(ways > 0, "The number of ways must be positive");
+    SetMaxBytes(max_bytes);
+}
+
+template <typename Key, typename Hash, typename Equal>
+bool SlabBytesCache<Key, Hash, Equal>::Put(const Key& key, std::string_view value) {
+    auto& way = GetWay(key);
+    std::lock_guard lock(way.mutex);
+
+    // The freed chunk is likely to be reused for the new value
+    auto node = way.lru.ExtractNode(key);
+    if (node) Free(way, node->GetValue());
+
+    if (impl::SlabAllocator::GetMappingSize(value.size()) > way.max_bytes) {
+        ++way.rejected;
+        return false;
+    }
+
+    const Slot slot{Allocate(way, value.size()), value.size()};
+    if (!value.empty()) std::memcpy(slot.data, value.data(), value.size());
+
+    if (node) {
+        node->SetValue(Slot{slot});
+        way.lru.InsertNode(std::move(node));
+        return true;
+    }
+
+    if (way.lru.GetSize() == way.lru.GetCapacity()) {
+        // The index grows with the number of values that fit into the limit
+        way.lru.SetMaxSize(way.lru.GetCapacity() * 2);
+    }
+    way.lru.Put(key, slot);
+    return true;
+}
+
+template <typename Key, typename Hash, typename Equal>
+std::optional<std::string> SlabBytesCache<Key, Hash, Equal>::Get(const Key& key) {
+    auto& way = GetWay(key);
+    std::lock_guard lock(way.mutex);
+
+    const auto* slot = way.lru.Get(key);
+    if (!slot) {
+        ++way.misses;
+        return std::nullopt;
+    }
+    ++way.hits;
+    return std::string(slot->data, slot->size);
+}
+
+template <typename Key, typename Hash, typename Equal>
+void SlabBytesCache<Key, Hash, Equal>::Erase(const Key& key) {
+    auto& way = GetWay(key);
+    std::lock_guard lock(way.mutex);
+
+    auto node = way.lru.ExtractNode(key);
+    if (node) Free(way, node->GetValue());
+}
+
+template <typename Key, typename Hash, typename Equal>
+void SlabBytesCache<Key, Hash, Equal>::Clear() {
+    for (auto& way : ways_) {
+        std::lock_guard lock(way.mutex);
+        way.lru.VisitAll([&way](const Key&, const Slot& slot) { Free(way, slot); });
+        way.lru.Clear();
+    }
+}
+
+template <typename Key, typename Hash, typename Equal>
+void SlabBytesCache<Key, Hash, Equal>::SetMaxBytes(std::size_t max_bytes) {
+    const auto way_max_bytes = max_bytes / ways_.size();
+    for (auto& way : ways_) {
+        std::lock_guard lock(way.mutex);
+        way.max_bytes = way_max_bytes;
+        while (way.allocator.GetStatistics().mapped_bytes > way.max_bytes && EvictOne(way)) {
+        }
+    }
+}
+
+template <typename Key, typename Hash, typename Equal>
+std::size_t SlabBytesCache<Key, Hash, Equal>::GetSizeApproximate() const {
+    std::size_t size = 0;
+    for (const auto& way : ways_) {
+        std::lock_guard lock(way.mutex);
+        size += way.lru.GetSize();
+    }
+    return size;
+}
+
+template <typename Key, typename Hash, typename Equal>
+SlabCacheStatistics SlabBytesCache<Key, Hash, Equal>::GetStatistics() const {
+    SlabCacheStatistics result;
+    for (const auto& way : ways_) {
+        std::lock_guard lock(way.mutex);
+        const auto& memory = way.allocator.GetStatistics();
+        result += SlabCacheStatistics{
+            way.lru.GetSize(),
+            way.hits,
+            way.misses,
+            way.evictions,
+            way.rejected,
+            memory.mapped_bytes,
+            memory.allocated_bytes,
+            memory.requested_bytes,
+        };
+    }
+    return result;
+}
+
+template <typename Key, typename Hash, typename Equal>
+typename SlabBytesCache<Key, Hash, Equal>::Way& SlabBytesCache<Key, Hash, Equal>::GetWay(const Key& key) {
+    return ways_[hash_(key) % ways_.size()];
+}
+
+template <typename Key, typename Hash, typename Equal>
+char* SlabBytesCache<Key, Hash, Equal>::Allocate(Way& way, std::size_t size) {
+    const auto mapping_size = impl::SlabAllocator::GetMappingSize(size);
+    while (true) {
+        const bool may_map = way.allocator.GetStatistics().mapped_bytes + mapping_size <= way.max_bytes;
+        if (auto* data = way.allocator.Allocate(size, may_map)) return data;
+        // Evicting everything frees all the pages, but the spare one
+        if (!EvictOne(way)) return way.allocator.Allocate(size, true);
+    }
+}
+
+template <typename Key, typename Hash, typename Equal>
+void SlabBytesCache<Key, Hash, Equal>::Free(Way& way, const Slot& slot) noexcept {
+    way.allocator.Deallocate(slot.data, slot.size);
+}
+
+template <typename Key, typename Hash, typename Equal>
+bool SlabBytesCache<Key, Hash, Equal>::EvictOne(Way& way) {
+    auto node = way.lru.ExtractLeastUsedNode();
+    if (!node) return false;
+    Free(way, node->GetValue());
+    ++way.evictions;
+    return true;
+}
+
+template <typename Key, typename Hash, typename Equal>
+void DumpMetric(utils::statistics::Writer& writer, const SlabBytesCache<Key, Hash, Equal>& cache) {
+    writer = cache.GetStatistics();
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void DumpMetric(utils::statistics::Writer& writer, const SlabCache<Key, Value, Hash, Equal>& cache) {
+    writer = cache.GetStatistics();
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -35,6 +35,8 @@ namespace components {
 /// Name | Description | Default value
 /// ---- | ----------- | -------------
 /// pool-statistics-disable | set to true to disable statistics for connection pool | false
+/// timings-us | set to true to add the `timings-us` percentiles of the requests in microseconds | false
+/// timings-histogram | set to true to add the `timings-histogram` histogram of the requests in microseconds, see utils::statistics::kTimingsHistogramBounds | false
 /// thread-name-prefix | set OS thread name to this value | ''
 /// threads | number of threads to process low level HTTP related IO system calls | 8
 /// fs-task-processor | task processor to run blocking HTTP related calls, like DNS resolving or hosts reading | -
@@ -71,7 +73,7 @@ public:
 private:
     void OnConfigUpdate(const dynamic_config::Snapshot& config);
 
-    void WriteStatistics(utils::statistics::Writer& writer);
+    void WriteStatistics(utils::statistics::Writer& writer, utils::statistics::TimingsMetrics timings_metrics);
 
     static std::vector<utils::NotNull<clients::http::Plugin*>>
     FindPlugins(const std::vector<std::string>& names, const components::ComponentContext& context);
@@ -18,11 +18,12 @@ namespace components {
 /// @brief Component for storing files in memory
 /// ## Static options:
 ///
-/// Name              | Description                                          | Default value
-/// ----------------- | ---------------------------------------------------- | -------------
-/// dir               | directory to cache files from                        | /var/www
-/// update-period     | Update period (0 - fill the cache only at startup)   | 0
-/// fs-task-processor | task processor to do filesystem operations           | fs-task-processor
+/// Name                 | Description                                                          | Default value
+/// -------------------- | -------------------------------------------------------------------- | -------------
+/// dir                  | directory to cache files from                                        | /var/www
+/// update-period        | Update period (0 - fill the cache only at startup)                   | 0
+/// fs-task-processor    | task processor to do filesystem operations                           | fs-task-processor
+/// max-loaded-file-size | files larger than that (in bytes) are read from disk on each request | unlimited
 
 // clang-format on
 
@@ -0,0 +1,298 @@
+#pragma once
+
+/// @file userver/concurrent/single_flight.hpp
+/// @brief @copybrief concurrent::SingleFlight
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <userver/engine/condition_variable.hpp>
+#include <userver/engine/exception.hpp>
+#include <userver/engine/mutex.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/fixed_array.hpp>
+#include <userver/utils/result_store.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace concurrent {
+
+namespace impl {
+
+/// The result of a call shared by the calls that joined it
+template <typename Value>
+class Flight final {
+public:
+    void SetValue(const Value& value) {
+        result_.SetValue(value);
+        Finish();
+    }
+
+    void SetException(std::exception_ptr&& exception) noexcept {
+        result_.SetException(std::move(exception));
+        Finish();
+    }
+
+    /// The call is completed without a result, the waiters have to retry
+    void Abandon() noexcept {
+        abandoned_ = true;
+        Finish();
+    }
+
+    /// @returns std::nullopt if the call was abandoned
+    std::optional<Value> Wait() {
+        std::unique_lock lock(mutex_);
+        if (!cv_.Wait(lock, [this] { return finished_; })) {
+            throw engine::WaitInterruptedException(engine::current_task::CancellationReason());
+        }
+        if (abandoned_) return std::nullopt;
+        return result_.Get();
+    }
+
+private:
+    void Finish() noexcept {
+        std::lock_guard lock(mutex_);
+        finished_ = true;
+        cv_.NotifyAll();
+    }
+
+    engine::Mutex mutex_;
+    engine::ConditionVariable cv_;
+    bool finished_{false};
+    bool abandoned_{false};
+    utils::ResultStore<Value> result_;
+};
+
+}  // namespace impl
+
+/// @ingroup userver_concurrency
+///
+/// @brief Deduplicates concurrent calls with equal keys ("single flight").
+///
+/// While a call for a key is in progress, the following calls for an equal
+/// key do not call their functions. Instead they wait for the call in
+/// progress and receive a copy of its result or its exception. Once the call
+/// completes, the next call for the key starts a new one.
+///
+/// Unlike concurrent::MutexSet, the waiters of a key are woken up only when
+/// the call for that key completes, the calls for other keys never wake them
+/// up or block them.
+///
+/// Typical usage is to protect an expensive source from a thundering herd of
+/// requests for the same hot key after a cache miss:
+/// @code
+/// auto value = single_flight.Execute(key, [&] { return client.Fetch(key); });
+/// @endcode
+///
+/// If the task executing the call is cancelled and the function throws, or a
+/// concurrent::SingleFlight::Leader is destroyed without a result, the call is
+/// abandoned: one of its waiters takes over and calls its own function, the
+/// rest of them wait for the new call.
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class SingleFlight final {
+public:
+    /// @param ways the number of independently locked parts of the key index,
+    /// the locks are only held for the index lookups
+    explicit SingleFlight(std::size_t ways = 16, const Hash& hash = Hash{}, const Equal& equal = Equal{});
+
+    /// @brief Calls `func()` and returns its result, unless a call for an equal
+    /// key is already in progress. In that case waits for the call in progress
+    /// and returns a copy of its result.
+    /// @throws anything `func` (of this or of the joined call) throws,
+    /// engine::WaitInterruptedException if the waiting task was cancelled
+    template <typename Func>
+    Value Execute(const Key& key, Func&& func);
+
+    class Leader;
+
+    /// @brief Starts a call for `key` unless a call for an equal key is in
+    /// progress, without waiting.
+    ///
+    /// The returned concurrent::SingleFlight::Leader may be passed to another
+    /// task, e.g. to compute the result in background. Until it is completed,
+    /// the calls for `key` wait for it.
+    /// @returns std::nullopt if a call for `key` is in progress
+    std::optional<Leader> TryLead(const Key& key);
+
+    /// @returns true if a call for `key` is in progress
+    bool IsInFlight(const Key& key);
+
+private:
+    using FlightPtr = std::shared_ptr<impl::Flight<Value>>;
+
+    struct Way final {
+        Way(const Hash& hash, const Equal& equal) : flights(0, hash, equal) {}
+
+        engine::Mutex mutex;
+        std::unordered_map<Key, FlightPtr, Hash, Equal> flights;
+    };
+
+    Way& GetWay(const Key& key);
+
+    void Erase(const Key& key);
+
+    Hash hash_;
+    utils::FixedArray<Way> ways_;
+};
+
+/// @brief The right and the duty to complete a call started by
+/// concurrent::SingleFlight::TryLead.
+///
+/// If the leader is destroyed without a result, the call is abandoned and one
+/// of the waiters takes it over.
+template <typename Key, typename Value, typename Hash, typename Equal>
+class SingleFlight<Key, Value, Hash, Equal>::Leader final {
+public:
+    Leader(Leader&& other) noexcept
+        : single_flight_(other.single_flight_), key_(std::move(other.key_)), flight_(std::move(other.flight_)) {}
+
+    Leader& operator=(Leader&&) = delete;
+
+    ~Leader() {
+        if (flight_) Abandon();
+    }
+
+    /// @brief Calls `func()` and passes the copies of its result or its
+    /// exception to the waiters.
+    /// @returns the result of `func()`
+    template <typename Func>
+    Value Run(Func&& func) {
+        static_assert(std::is_invocable_r_v<Value, Func&&>, "func must return Value");
+        UASSERT(flight_);
+
+        try {
+            Value value = std::invoke(std::forward<Func>(func));
+            SetValue(value);
+            return value;
+        } catch (...) {
+            if (flight_) {
+                // The waiters are not cancelled, they should not get the
+                // exception caused by the cancellation of this task
+                if (engine::current_task::ShouldCancel()) {
+                    Abandon();
+                } else {
+                    SetException(std::current_exception());
+                }
+            }
+            throw;
+        }
+    }
+
+private:
+    friend class SingleFlight;
+
+    Leader(SingleFlight& single_flight, const Key& key, FlightPtr flight)
+        : single_flight_(single_flight), key_(key), flight_(std::move(flight)) {}
+
+    void SetValue(const Value& value) {
+        // The calls that arrive after this one completes start a new call
+        single_flight_.Erase(key_);
+        const auto flight = std::exchange(flight_, nullptr);
+        try {
+            flight->SetValue(value);
+        } catch (...) {
+            flight->SetException(std::current_exception());
+            throw;
+        }
+    }
+
+    void SetException(std::exception_ptr&& exception) noexcept {
+        single_flight_.Erase(key_);
+        std::exchange(flight_, nullptr)->SetException(std::move(exception));
+    }
+
+    void Abandon() noexcept {
+        single_flight_.Erase(key_);
+        std::exchange(flight_, nullptr)->Abandon();
+    }
+
+    SingleFlight& single_flight_;
+    Key key_;
+    FlightPtr flight_;
+};
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+SingleFlight<Key, Value, Hash, Equal>::SingleFlight(std::size_t ways, const Hash& hash, const Equal& equal)
+    : hash_(hash), ways_(ways, hash, equal) {
+    UASSERT(ways > 0);
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+template <typename Func>
+Value SingleFlight<Key, Value, Hash, Equal>::Execute(const Key& key, Func&& func) {
+    auto& way = GetWay(key);
+    while (true) {
+        FlightPtr flight;
+        bool is_leader = false;
+        {
+            std::lock_guard lock(way.mutex);
+            auto& way_flight = way.flights[key];
+            // The waiters do not allocate anything
+            if (!way_flight) {
+                try {
+                    way_flight = std::make_shared<impl::Flight<Value>>();
+                } catch (...) {
+                    way.flights.erase(key);
+                    throw;
+                }
+                is_leader = true;
+            }
+            flight = way_flight;
+        }
+
+        if (is_leader) return Leader{*this, key, std::move(flight)}.Run(std::forward<Func>(func));
+
+        auto value = flight->Wait();
+        if (value) return std::move(*value);
+        // The call has been abandoned, take it over or join the new one
+    }
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+auto SingleFlight<Key, Value, Hash, Equal>::TryLead(const Key& key) -> std::optional<Leader> {
+    FlightPtr flight;
+    {
+        auto& way = GetWay(key);
+        std::lock_guard lock(way.mutex);
+        const auto [it, inserted] = way.flights.try_emplace(key);
+        if (!inserted) return std::nullopt;
+        try {
+            it->second = std::make_shared<impl::Flight<Value>>();
+        } catch (...) {
+            way.flights.erase(it);
+            throw;
+        }
+        flight = it->second;
+    }
+    return Leader{*this, key, std::move(flight)};
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+bool SingleFlight<Key, Value, Hash, Equal>::IsInFlight(const Key& key) {
+    auto& way = GetWay(key);
+    std::lock_guard lock(way.mutex);
+    return way.flights.count(key) != 0;
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+typename SingleFlight<Key, Value, Hash, Equal>::Way& SingleFlight<Key, Value, Hash, Equal>::GetWay(const Key& key) {
+    return ways_[hash_(key) % ways_.size()];
+}
+
+template <typename Key, typename Value, typename Hash, typename Equal>
+void SingleFlight<Key, Value, Hash, Equal>::Erase(const Key& key) {
+    auto& way = GetWay(key);
+    std::lock_guard lock(way.mutex);
+    way.flights.erase(key);
+}
+
+}  // namespace concurrent
+
+USERVER_NAMESPACE_END
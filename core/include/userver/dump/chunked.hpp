@@ -0,0 +1,170 @@
+#pragma once
+
+/// @file userver/dump/chunked.hpp
+/// @brief Parallel serialization of large containers, see dump::WriteChunked
+///
+/// @ingroup userver_dump_read_write
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/meta.hpp>
+#include <userver/dump/meta_containers.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/dump/operations_buffer.hpp>
+#include <userver/engine/get_all.hpp>
+#include <userver/engine/task/task_with_result.hpp>
+#include <userver/utils/async.hpp>
+#include <userver/utils/meta.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+class TaskProcessor;
+}  // namespace engine
+
+namespace dump {
+
+namespace impl {
+
+/// The number of chunks to split `size` elements into
+std::size_t GetChunkCount(std::size_t size, engine::TaskProcessor& task_processor);
+
+/// Writes the index (chunk count and sizes), then the chunks
+void WriteChunks(Writer& writer, const std::vector<std::string>& chunks);
+
+/// @throws `Error` on an invalid index
+std::vector<std::string> ReadChunks(Reader& reader);
+
+template <typename T>
+using MergeResult = decltype(std::declval<T&>().merge(std::declval<T&>()));
+
+template <typename T>
+void MergeChunk(T& result, T& chunk) {
+    if constexpr (meta::kIsDetected<MergeResult, T>) {
+        // Node-based containers splice the nodes without reallocating them
+        result.merge(chunk);
+    } else {
+        for (auto&& item : chunk) {
+            dump::Insert(result, meta::RangeValueType<T>(std::move(item)));
+        }
+    }
+}
+
+template <typename T>
+T MergeChunks(std::vector<T>&& chunks) {
+    if (chunks.empty()) return T{};
+
+    auto it = chunks.begin();
+    T result{};
+    if constexpr (meta::kIsReservable<T>) {
+        std::size_t total_size = 0;
+        for (const auto& chunk : chunks) total_size += std::size(chunk);
+        result.reserve(total_size);
+    } else {
+        result = std::move(*it++);
+    }
+
+    for (; it != chunks.end(); ++it) MergeChunk(result, *it);
+    return result;
+}
+
+}  // namespace impl
+
+/// @brief Writes a container in independent chunks that are serialized in
+/// parallel on `task_processor`
+///
+/// Each chunk holds a part of the elements in the format of the usual
+/// container `Write`. The chunks are accumulated in memory and then written
+/// to `writer` after an index of their sizes, so the peak memory usage of the
+/// dump write grows by the size of the serialized container.
+///
+/// The number of chunks depends on the worker count of `task_processor` and
+/// on the container size: small containers are written in a single chunk.
+///
+/// Must be read with dump::ReadChunked. Use cache::CacheUpdateTrait
+/// ::GetCacheTaskProcessor() to parallelize over the cache task processor:
+/// @code
+/// void WriteContents(dump::Writer& writer, const Map& contents) const override {
+///     dump::WriteChunked(writer, contents, GetCacheTaskProcessor());
+/// }
+///
+/// std::unique_ptr<const Map> ReadContents(dump::Reader& reader) const override {
+///     return std::make_unique<const Map>(dump::ReadChunked<Map>(reader, GetCacheTaskProcessor()));
+/// }
+/// @endcode
+template <typename T>
+std::enable_if_t<kIsContainer<T> && kIsWritable<meta::RangeValueType<T>>>
+WriteChunked(Writer& writer, const T& container, engine::TaskProcessor& task_processor) {
+    const auto size = std::size(container);
+    const auto chunk_count = impl::GetChunkCount(size, task_processor);
+
+    // The boundaries are found in a single pass, which is important for
+    // containers without random access
+    using Iterator = decltype(std::begin(container));
+    std::vector<std::pair<Iterator, std::size_t>> chunk_starts;
+    chunk_starts.reserve(chunk_count);
+    auto it = std::begin(container);
+    for (std::size_t i = 0; i < chunk_count; ++i) {
+        const auto chunk_size = size / chunk_count + (i < size % chunk_count ? 1 : 0);
+        chunk_starts.emplace_back(it, chunk_size);
+        std::advance(it, chunk_size);
+    }
+
+    std::vector<engine::TaskWithResult<std::string>> tasks;
+    tasks.reserve(chunk_count);
+    for (const auto& [chunk_begin, chunk_size] : chunk_starts) {
+        tasks.push_back(utils::Async(
+            task_processor,
+            "dump/write-chunk",
+            [chunk_it = chunk_begin, chunk_size = chunk_size]() mutable {
+                impl::BufferWriter chunk_writer;
+                chunk_writer.Write(chunk_size);
+                for (std::size_t i = 0; i < chunk_size; ++i, ++chunk_it) {
+                    // explicit cast for vector<bool> shenanigans
+                    chunk_writer.Write(static_cast<const meta::RangeValueType<T>&>(*chunk_it));
+                }
+                return std::move(chunk_writer).Extract();
+            }
+        ));
+    }
+
+    impl::WriteChunks(writer, engine::GetAll(tasks));
+}
+
+/// @brief Reads a container written by dump::WriteChunked, the chunks are
+/// parsed in parallel on `task_processor`
+///
+/// The chunks are parsed into separate containers that are then merged. Node
+/// based containers with a `merge` method (`std::unordered_map`, `std::map`,
+/// `std::set` etc.) splice the nodes, other containers move the elements via
+/// dump::Insert.
+template <typename T>
+std::enable_if_t<kIsContainer<T> && kIsReadable<meta::RangeValueType<T>>, T>
+ReadChunked(Reader& reader, engine::TaskProcessor& task_processor) {
+    auto chunks = impl::ReadChunks(reader);
+
+    std::vector<engine::TaskWithResult<T>> tasks;
+    tasks.reserve(chunks.size());
+    for (auto& chunk : chunks) {
+        tasks.push_back(utils::Async(task_processor, "dump/read-chunk", [&chunk] {
+            impl::BufferReader chunk_reader(std::move(chunk));
+            auto result = chunk_reader.Read<T>();
+            chunk_reader.Finish();
+            return result;
+        }));
+    }
+
+    return impl::MergeChunks(engine::GetAll(tasks));
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -6,6 +6,7 @@
 #include <string_view>
 #include <unordered_map>
 
+#include <userver/compression/zstd.hpp>
 #include <userver/dynamic_config/snapshot.hpp>
 #include <userver/formats/json/value.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -42,6 +43,9 @@ struct Config final {
     std::optional<std::chrono::milliseconds> max_dump_age;
     bool max_dump_age_set;
     bool dump_is_encrypted;
+    bool dump_is_mapped;
+    bool mapped_background_validation;
+    std::optional<compression::zstd::CompressionSettings> dump_compression;
 
     bool static_dumps_enabled;
     std::chrono::milliseconds static_min_dump_interval;
@@ -85,6 +85,25 @@ enum class UpdateType {
 /// `min-interval` | `string` (duration) | `WriteDumpAsync` calls performed in a fast succession are ignored | `0s`
 /// `fs-task-processor` | `string` | `TaskProcessor` for blocking disk IO | `fs-task-processor`
 /// `encrypted` | `boolean` | Whether to encrypt the dump | `false`
+/// `mapped` | `boolean` | Whether to write the dump in the memory-mapped format, see dump::MappedFileReader | `false`
+/// `mapped-background-validation` | `boolean` | Whether to validate a loaded memory-mapped dump in background | `true`
+/// `compressed` | `boolean` | Whether to compress the dump with zstd, see dump::CompressedWriter | `false`
+/// `compression-level` | `integer` | zstd compression level, from 1 to 22; negative levels are faster | `3`
+/// `compression-long-distance-matching` | `boolean` | Whether to use zstd long distance matching | `false`
+///
+/// Dumps in the memory-mapped format are not parsed on load: the file is
+/// mapped into memory, the sections are checksummed as they are read, and
+/// dump::MappedArray members of the data are used in place without reading
+/// them. The checksums of the data used in place are validated by a background
+/// task after the load, a corrupted dump is logged and removed. Only disable
+/// that with `mapped-background-validation: false` if the dumps are known to be
+/// intact, otherwise such data is never checksummed. The memory-mapped dumps
+/// are detected by the file magic, so toggling `mapped` needs no
+/// `format-version` bump.
+///
+/// Compressed dumps are written as a zstd stream (compressed first, then
+/// encrypted with `encrypted: true`) and can be inspected with the `zstd`
+/// utility. Bump `format-version` when toggling `compressed`.
 ///
 /// ## Sample usage
 /// @snippet core/src/dump/dumper_test.cpp  Sample Dumper usage
@@ -171,7 +190,7 @@ private:
     Dumper(const Config& initial_config, const components::ComponentContext& context, DumpableEntity& dumpable);
 
     class Impl;
-    utils::FastPimpl<Impl, 1088, 16> impl_;
+    utils::FastPimpl<Impl, 1200, 16> impl_;
 };
 
 }  // namespace dump
@@ -0,0 +1,121 @@
+#pragma once
+
+/// @file userver/dump/mapped_array.hpp
+/// @brief @copybrief dump::MappedArray
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+
+/// Writes `size, padding, data`, so that the data is aligned in the file when
+/// `writer` is a dump::MappedFileWriter
+void WriteAlignedBytes(Writer& writer, std::string_view data, std::size_t alignment);
+
+struct AlignedBytes final {
+    std::string_view data;
+    // Keeps `data` alive. Null if `data` is only valid until the next Read
+    std::shared_ptr<const void> keepalive;
+};
+
+/// Returns the data in place if `reader` is a dump::MappedFileReader
+AlignedBytes ReadAlignedBytes(Reader& reader, std::size_t alignment);
+
+}  // namespace impl
+
+/// @ingroup userver_containers
+///
+/// @brief An immutable array of trivially copyable elements that is used in
+/// place when loaded from a memory-mapped dump.
+///
+/// When read from a dump::MappedFileReader (`dump: mapped: true` in the static
+/// config), the elements are not copied or parsed: the array points into the
+/// dump file mapping and keeps it alive. The pages are loaded by the OS on
+/// first access. With other dump formats the elements are copied into memory.
+///
+/// Use it for the bulk of the cache data that is laid out flat, e.g. sorted
+/// keys and values of a lookup table.
+template <typename T>
+class MappedArray final {
+    static_assert(std::is_trivially_copyable_v<T>, "MappedArray elements are used in place, they must be trivial");
+    static_assert(alignof(T) < 256, "Over-aligned types are not supported");
+
+public:
+    using value_type = T;
+    using const_iterator = const T*;
+    using iterator = const_iterator;
+
+    MappedArray() = default;
+
+    explicit MappedArray(std::vector<T> values)
+        : MappedArray(std::make_shared<const std::vector<T>>(std::move(values))) {}
+
+    const T* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    const T* begin() const noexcept { return data_; }
+    const T* end() const noexcept { return data_ + size_; }
+
+    const T& operator[](std::size_t index) const noexcept { return data_[index]; }
+
+    /// @returns true if the elements point into a memory-mapped dump file
+    bool IsMapped() const noexcept { return is_mapped_; }
+
+private:
+    template <typename U>
+    friend MappedArray<U> Read(Reader& reader, To<MappedArray<U>>);
+
+    explicit MappedArray(std::shared_ptr<const std::vector<T>> values)
+        : storage_(values), data_(values->data()), size_(values->size()) {}
+
+    std::shared_ptr<const void> storage_;
+    const T* data_{nullptr};
+    std::size_t size_{0};
+    bool is_mapped_{false};
+};
+
+template <typename T>
+void Write(Writer& writer, const MappedArray<T>& array) {
+    impl::WriteAlignedBytes(
+        writer,
+        std::string_view{reinterpret_cast<const char*>(array.data()), array.size() * sizeof(T)},
+        alignof(T)
+    );
+}
+
+template <typename T>
+MappedArray<T> Read(Reader& reader, To<MappedArray<T>>) {
+    auto bytes = impl::ReadAlignedBytes(reader, alignof(T));
+    if (bytes.data.size() % sizeof(T) != 0) {
+        throw Error("MappedArray size is not a multiple of the element size");
+    }
+    const auto size = bytes.data.size() / sizeof(T);
+
+    if (bytes.keepalive) {
+        MappedArray<T> result;
+        result.storage_ = std::move(bytes.keepalive);
+        result.data_ = reinterpret_cast<const T*>(bytes.data.data());
+        result.size_ = size;
+        result.is_mapped_ = true;
+        return result;
+    }
+
+    std::vector<T> values(size);
+    if (size != 0) std::memcpy(values.data(), bytes.data.data(), bytes.data.size());
+    return MappedArray<T>(std::move(values));
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,44 @@
+#pragma once
+
+/// @file userver/dump/operations_buffer.hpp
+/// @brief In-memory `Writer` and `Reader`
+
+#include <string>
+#include <string_view>
+
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+/// A `Writer` that appends to an in-memory buffer
+class BufferWriter final : public Writer {
+public:
+    void Finish() override;
+
+    std::string Extract() &&;
+
+private:
+    void WriteRaw(std::string_view data) override;
+
+    std::string data_;
+};
+
+/// A `Reader` that reads from an in-memory buffer
+class BufferReader final : public Reader {
+public:
+    explicit BufferReader(std::string data);
+
+    void Finish() override;
+
+private:
+    std::string_view ReadRaw(std::size_t max_size) override;
+
+    std::string data_;
+    std::string_view unread_data_;
+};
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
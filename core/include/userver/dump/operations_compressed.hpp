@@ -0,0 +1,81 @@
+#pragma once
+
+/// @file userver/dump/operations_compressed.hpp
+/// @brief zstd-compressed dumps, see dump::CompressedWriter
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <userver/compression/zstd.hpp>
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// A `Writer` that compresses the data with zstd and writes it to another
+/// `Writer`, usually dump::FileWriter or dump::EncryptedWriter
+class CompressedWriter final : public Writer {
+public:
+    CompressedWriter(std::unique_ptr<Writer> inner, const compression::zstd::CompressionSettings& settings);
+
+    void Finish() override;
+
+private:
+    void WriteRaw(std::string_view data) override;
+
+    void Compress(std::string_view data);
+    void Flush();
+
+    std::unique_ptr<Writer> inner_;
+    compression::zstd::Compressor compressor_;
+    std::string input_;
+    std::string output_;
+};
+
+/// A `Reader` that decompresses the data read from another `Reader`
+class CompressedReader final : public Reader {
+public:
+    explicit CompressedReader(std::unique_ptr<Reader> inner);
+
+    void Finish() override;
+
+private:
+    std::string_view ReadRaw(std::size_t max_size) override;
+
+    void Fill(std::size_t min_size);
+
+    std::unique_ptr<Reader> inner_;
+    compression::zstd::Decompressor decompressor_;
+    std::string_view input_;
+    bool is_input_finished_{false};
+    // Decompressed data, [position_, buffer_size_) is not read yet
+    std::unique_ptr<char[]> buffer_;
+    std::size_t buffer_capacity_{0};
+    std::size_t buffer_size_{0};
+    std::size_t position_{0};
+};
+
+/// Wraps the readers and writers of another factory into
+/// dump::CompressedReader and dump::CompressedWriter
+class CompressedOperationsFactory final : public OperationsFactory {
+public:
+    CompressedOperationsFactory(
+        std::unique_ptr<OperationsFactory> inner,
+        compression::zstd::CompressionSettings settings
+    );
+
+    std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+    std::unique_ptr<Writer> CreateWriter(std::string full_path, tracing::ScopeTime& scope) override;
+
+private:
+    const std::unique_ptr<OperationsFactory> inner_;
+    const compression::zstd::CompressionSettings settings_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,138 @@
+#pragma once
+
+/// @file userver/dump/operations_mapped.hpp
+/// @brief Memory-mapped dump files, see dump::MappedFileReader
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/operations.hpp>
+
+#include <userver/dump/factory.hpp>
+#include <userver/dump/operations.hpp>
+#include <userver/dump/operations_file.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+class FileMapping;
+struct AlignedBytes;
+AlignedBytes ReadAlignedBytes(Reader& reader, std::size_t alignment);
+}  // namespace impl
+
+/// @brief Checks the magic of the memory-mapped dump format at the beginning
+/// and at the end of the file. Blocks the thread.
+/// @returns false if the file can't be read
+bool IsMappedDumpFile(const std::string& path);
+
+/// @brief A handle to a memory-mapped dump file. File operations block the
+/// thread.
+///
+/// The data is written in sections of `section_size` bytes, the checksums of
+/// all the sections are stored at the end of the file.
+class MappedFileWriter final : public Writer {
+public:
+    static constexpr std::size_t kDefaultSectionSize = 1 << 20;
+
+    /// @brief Creates a new dump file and opens it
+    /// @throws `Error` on a filesystem error
+    MappedFileWriter(
+        std::string path,
+        boost::filesystem::perms perms,
+        tracing::ScopeTime& scope,
+        std::size_t section_size = kDefaultSectionSize
+    );
+
+    void Finish() override;
+
+    /// The offset of the next written byte from the beginning of the mapping
+    std::size_t GetPosition() const noexcept;
+
+private:
+    void WriteRaw(std::string_view data) override;
+
+    void FlushSection();
+
+    FileWriter file_;
+    std::string section_;
+    std::size_t section_size_;
+    std::size_t payload_size_{0};
+    std::vector<std::uint64_t> checksums_;
+};
+
+/// @brief A handle to a memory-mapped dump file.
+///
+/// The file is mapped into memory as a whole and is never copied: the pages
+/// are faulted in by the OS as the data is read. The checksum of a section is
+/// validated the first time the section is read from.
+///
+/// The data of dump::MappedArray is used in place and is not read on load, so
+/// its sections are not validated by the reader. Not to fault in the whole
+/// file at startup, they are only validated by `MakeDeferredValidation`.
+///
+/// Unlike with other readers, the memory returned by `ReadRaw` (e.g. via
+/// `ReadStringViewUnsafe`) stays valid as long as the mapping is alive.
+class MappedFileReader final : public Reader {
+public:
+    /// @brief Opens and maps an existing dump file
+    /// @throws `Error` on a filesystem error or if the file is not a valid
+    /// memory-mapped dump
+    explicit MappedFileReader(std::string path);
+
+    ~MappedFileReader() override;
+
+    void Finish() override;
+
+    /// The offset of the next read byte from the beginning of the mapping
+    std::size_t GetPosition() const noexcept;
+
+    /// The mapping that the data returned from `ReadRaw` points into
+    const std::shared_ptr<const impl::FileMapping>& GetMapping() const noexcept;
+
+    /// @brief Returns a function that validates the sections that were not
+    /// read so far, e.g. the ones only used in place by dump::MappedArray.
+    ///
+    /// The function keeps the mapping alive and may outlive the reader. It
+    /// blocks the thread, stops early on the task cancellation and throws
+    /// `Error` on a checksum mismatch.
+    std::function<void()> MakeDeferredValidation() const;
+
+private:
+    friend impl::AlignedBytes impl::ReadAlignedBytes(Reader& reader, std::size_t alignment);
+
+    std::string_view ReadRaw(std::size_t max_size) override;
+
+    // Returns exactly `size` bytes without validating their sections
+    std::string_view ReadInPlace(std::size_t size);
+
+    void ValidateSections(std::size_t begin, std::size_t end);
+
+    std::string path_;
+    std::shared_ptr<const impl::FileMapping> mapping_;
+    std::string_view payload_;
+    std::size_t section_size_{0};
+    std::vector<std::uint64_t> checksums_;
+    std::vector<bool> validated_sections_;
+    std::size_t position_{0};
+};
+
+class MappedFileOperationsFactory final : public OperationsFactory {
+public:
+    explicit MappedFileOperationsFactory(boost::filesystem::perms perms);
+
+    std::unique_ptr<Reader> CreateReader(std::string full_path) override;
+
+    std::unique_ptr<Writer> CreateWriter(std::string full_path, tracing::ScopeTime& scope) override;
+
+private:
+    const boost::filesystem::perms perms_;
+};
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,48 @@
+#pragma once
+
+/// @file userver/dump/persistent_hash_map.hpp
+/// @brief Dump support for cache::PersistentHashMap
+///
+/// @ingroup userver_dump_read_write
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#include <userver/cache/persistent_hash_map.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/dump/meta.hpp>
+#include <userver/dump/operations.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+/// @brief cache::PersistentHashMap serialization support, the format matches
+/// the one of `std::unordered_map`
+template <typename K, typename V, typename Hash, typename Eq>
+std::enable_if_t<kIsWritable<K> && kIsWritable<V>>
+Write(Writer& writer, const cache::PersistentHashMap<K, V, Hash, Eq>& value) {
+    writer.Write(value.size());
+    for (const auto& [key, mapped] : value) {
+        writer.Write(key);
+        writer.Write(mapped);
+    }
+}
+
+/// @brief cache::PersistentHashMap deserialization support
+template <typename K, typename V, typename Hash, typename Eq>
+std::enable_if_t<kIsReadable<K> && kIsReadable<V>, cache::PersistentHashMap<K, V, Hash, Eq>>
+Read(Reader& reader, To<cache::PersistentHashMap<K, V, Hash, Eq>>) {
+    const auto size = reader.Read<std::size_t>();
+    cache::PersistentHashMap<K, V, Hash, Eq> result;
+    for (std::size_t i = 0; i < size; ++i) {
+        auto key = reader.Read<K>();
+        result.insert_or_assign(std::move(key), reader.Read<V>());
+    }
+    return result;
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -20,6 +20,7 @@ template <template <typename> typename TaskType, typename Function, typename...
 [[nodiscard]] auto MakeTaskWithResult(
     TaskProcessor& task_processor,
     Task::Importance importance,
+    Task::Priority priority,
     Deadline deadline,
     Function&& f,
     Args&&... args
@@ -28,7 +29,9 @@ template <template <typename> typename TaskType, typename Function, typename...
     constexpr auto kWaitMode = TaskType<ResultType>::kWaitMode;
 
     return TaskType<ResultType>{MakeTask(
-        {task_processor, importance, kWaitMode, deadline}, std::forward<Function>(f), std::forward<Args>(args)...
+        {task_processor, importance, kWaitMode, deadline, priority},
+        std::forward<Function>(f),
+        std::forward<Args>(args)...
     )};
 }
 
@@ -38,7 +41,12 @@ template <template <typename> typename TaskType, typename Function, typename...
 template <typename Function, typename... Args>
 [[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor, Function&& f, Args&&... args) {
     return impl::MakeTaskWithResult<TaskWithResult>(
-        task_processor, Task::Importance::kNormal, {}, std::forward<Function>(f), std::forward<Args>(args)...
+        task_processor,
+        Task::Importance::kNormal,
+        Task::Priority::kNormal,
+        {},
+        std::forward<Function>(f),
+        std::forward<Args>(args)...
     );
 }
 
@@ -46,7 +54,12 @@ template <typename Function, typename... Args>
 template <typename Function, typename... Args>
 [[nodiscard]] auto SharedAsyncNoSpan(TaskProcessor& task_processor, Function&& f, Args&&... args) {
     return impl::MakeTaskWithResult<SharedTaskWithResult>(
-        task_processor, Task::Importance::kNormal, {}, std::forward<Function>(f), std::forward<Args>(args)...
+        task_processor,
+        Task::Importance::kNormal,
+        Task::Priority::kNormal,
+        {},
+        std::forward<Function>(f),
+        std::forward<Args>(args)...
     );
 }
 
@@ -55,7 +68,12 @@ template <typename Function, typename... Args>
 template <typename Function, typename... Args>
 [[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor, Deadline deadline, Function&& f, Args&&... args) {
     return impl::MakeTaskWithResult<TaskWithResult>(
-        task_processor, Task::Importance::kNormal, deadline, std::forward<Function>(f), std::forward<Args>(args)...
+        task_processor,
+        Task::Importance::kNormal,
+        Task::Priority::kNormal,
+        deadline,
+        std::forward<Function>(f),
+        std::forward<Args>(args)...
     );
 }
 
@@ -64,7 +82,48 @@ template <typename Function, typename... Args>
 template <typename Function, typename... Args>
 [[nodiscard]] auto SharedAsyncNoSpan(TaskProcessor& task_processor, Deadline deadline, Function&& f, Args&&... args) {
     return impl::MakeTaskWithResult<SharedTaskWithResult>(
-        task_processor, Task::Importance::kNormal, deadline, std::forward<Function>(f), std::forward<Args>(args)...
+        task_processor,
+        Task::Importance::kNormal,
+        Task::Priority::kNormal,
+        deadline,
+        std::forward<Function>(f),
+        std::forward<Args>(args)...
+    );
+}
+
+/// Runs an asynchronous function call using specified task processor, the task
+/// is queued in the lane of the specified priority
+/// @see Task::Priority
+template <typename Function, typename... Args>
+[[nodiscard]] auto AsyncNoSpan(TaskProcessor& task_processor, Task::Priority priority, Function&& f, Args&&... args) {
+    return impl::MakeTaskWithResult<TaskWithResult>(
+        task_processor,
+        Task::Importance::kNormal,
+        priority,
+        {},
+        std::forward<Function>(f),
+        std::forward<Args>(args)...
+    );
+}
+
+/// Runs an asynchronous function call with deadline using specified task
+/// processor, the task is queued in the lane of the specified priority
+/// @see Task::Priority
+template <typename Function, typename... Args>
+[[nodiscard]] auto AsyncNoSpan(
+    TaskProcessor& task_processor,
+    Task::Priority priority,
+    Deadline deadline,
+    Function&& f,
+    Args&&... args
+) {
+    return impl::MakeTaskWithResult<TaskWithResult>(
+        task_processor,
+        Task::Importance::kNormal,
+        priority,
+        deadline,
+        std::forward<Function>(f),
+        std::forward<Args>(args)...
     );
 }
 
@@ -104,7 +163,12 @@ template <typename Function, typename... Args>
 template <typename Function, typename... Args>
 [[nodiscard]] auto CriticalAsyncNoSpan(TaskProcessor& task_processor, Function&& f, Args&&... args) {
     return impl::MakeTaskWithResult<TaskWithResult>(
-        task_processor, Task::Importance::kCritical, {}, std::forward<Function>(f), std::forward<Args>(args)...
+        task_processor,
+        Task::Importance::kCritical,
+        Task::Priority::kNormal,
+        {},
+        std::forward<Function>(f),
+        std::forward<Args>(args)...
     );
 }
 
@@ -114,7 +178,12 @@ template <typename Function, typename... Args>
 template <typename Function, typename... Args>
 [[nodiscard]] auto SharedCriticalAsyncNoSpan(TaskProcessor& task_processor, Function&& f, Args&&... args) {
     return impl::MakeTaskWithResult<SharedTaskWithResult>(
-        task_processor, Task::Importance::kCritical, {}, std::forward<Function>(f), std::forward<Args>(args)...
+        task_processor,
+        Task::Importance::kCritical,
+        Task::Priority::kNormal,
+        {},
+        std::forward<Function>(f),
+        std::forward<Args>(args)...
     );
 }
 
@@ -146,6 +215,7 @@ template <typename Function, typename... Args>
     return impl::MakeTaskWithResult<TaskWithResult>(
         current_task::GetTaskProcessor(),
         Task::Importance::kCritical,
+        Task::Priority::kNormal,
         deadline,
         std::forward<Function>(f),
         std::forward<Args>(args)...
@@ -24,6 +24,7 @@ struct TaskConfig final {
     Task::Importance importance{Task::Importance::kNormal};
     Task::WaitMode wait_mode{Task::WaitMode::kSingleWaiter};
     engine::Deadline deadline;
+    Task::Priority priority{Task::Priority::kNormal};
 };
 
 [[nodiscard]] TaskContext&
@@ -112,6 +112,15 @@ public:
     /// @note Can return less than len if socket is closed by peer.
     [[nodiscard]] size_t SendAll(const void* buf, size_t len, Deadline deadline);
 
+    /// @brief Sends exactly len bytes of a file starting at offset to the socket
+    /// without copying them to user space (sendfile(2) on Linux).
+    /// @param file_fd descriptor of a regular file opened for reading, its file
+    /// offset is not changed
+    /// @note Can return less than len if socket is closed by peer or the file
+    /// turns out to be shorter.
+    /// @warning Reading the file blocks the current thread on page cache misses.
+    [[nodiscard]] size_t SendFile(int file_fd, std::size_t offset, std::size_t len, Deadline deadline);
+
     /// @brief Accepts a connection from a listening socket.
     /// @see engine::io::Listen
     [[nodiscard]] Socket Accept(Deadline);
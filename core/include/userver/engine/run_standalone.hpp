@@ -20,6 +20,8 @@ struct TaskProcessorPoolsConfig final {
     std::size_t ev_threads_num = 1;
     std::string ev_thread_name = "ev";
     bool ev_default_loop_disabled = false;
+    /// Perform socket and pipe I/O through io_uring if the kernel supports it
+    bool ev_io_uring_enabled = false;
 };
 
 /// @brief Runs a payload in a temporary coroutine engine instance.
@@ -0,0 +1,67 @@
+#pragma once
+
+/// @file userver/engine/task/resource_usage.hpp
+/// @brief @copybrief engine::TaskResourceUsage
+
+#include <chrono>
+#include <cstdint>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine {
+
+/// @brief CPU time and heap memory consumed by a task.
+///
+/// The resources are accounted for each execution slice of the task (between
+/// the context switches), if `resource-usage-accounting` is enabled for its
+/// task processor in the static config of
+/// components::ManagerControllerComponent. Otherwise all the values are zero.
+///
+/// The heap memory is only accounted with jemalloc. The resources of the
+/// subtasks are not included.
+struct TaskResourceUsage final {
+    /// CPU time consumed by the task
+    std::chrono::nanoseconds cpu_time{0};
+    /// Bytes allocated by the task
+    std::uint64_t allocated_bytes{0};
+    /// Bytes freed by the task, including the memory allocated by other tasks
+    std::uint64_t deallocated_bytes{0};
+
+    TaskResourceUsage& operator+=(const TaskResourceUsage& other) noexcept {
+        cpu_time += other.cpu_time;
+        allocated_bytes += other.allocated_bytes;
+        deallocated_bytes += other.deallocated_bytes;
+        return *this;
+    }
+
+    TaskResourceUsage& operator-=(const TaskResourceUsage& other) noexcept {
+        cpu_time -= other.cpu_time;
+        allocated_bytes -= other.allocated_bytes;
+        deallocated_bytes -= other.deallocated_bytes;
+        return *this;
+    }
+};
+
+inline TaskResourceUsage operator-(TaskResourceUsage lhs, const TaskResourceUsage& rhs) noexcept {
+    lhs -= rhs;
+    return lhs;
+}
+
+namespace current_task {
+
+/// @brief Returns the resources consumed by the current task so far,
+/// including the current execution slice.
+///
+/// The usage of a part of a task is the difference of two calls:
+/// @code
+/// const auto start = engine::current_task::GetResourceUsage();
+/// DoWork();
+/// const auto usage = engine::current_task::GetResourceUsage() - start;
+/// @endcode
+TaskResourceUsage GetResourceUsage() noexcept;
+
+}  // namespace current_task
+
+}  // namespace engine
+
+USERVER_NAMESPACE_END
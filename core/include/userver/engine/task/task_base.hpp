@@ -44,6 +44,23 @@ public:
         kCritical,
     };
 
+    /// @brief Task priority, selects the TaskProcessor queue lane the task
+    /// waits in while it is ready to run.
+    ///
+    /// Lanes are dequeued by weighted round-robin, so lower priority tasks are
+    /// delayed under load, but never starved.
+    enum class Priority {
+        /// Latency-critical work, e.g. request handling
+        kCritical,
+
+        /// Default priority
+        kNormal,
+
+        /// Low-value work that may be delayed under load, e.g. cache updates,
+        /// periodic tasks, metrics collection
+        kBackground,
+    };
+
     /// Task state
     enum class State {
         kInvalid,    ///< Unusable
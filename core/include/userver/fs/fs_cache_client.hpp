@@ -23,14 +23,27 @@ public:
     /// @param update_period time (0 - fill the cache only at startup), not used
     /// in Linux
     /// @param tp task processor to do filesystem operations
-    FsCacheClient(std::string_view dir, std::chrono::milliseconds update_period, engine::TaskProcessor& tp);
+    /// @param max_loaded_file_size files larger than that are not kept in
+    /// memory, only their metadata is
+    FsCacheClient(
+        std::string_view dir,
+        std::chrono::milliseconds update_period,
+        engine::TaskProcessor& tp,
+        std::size_t max_loaded_file_size = kUnlimitedLoadedFileSize
+    );
 
     /// @brief get file from memory
     /// @param path to file
     /// @return file info and content ; `nullptr` if no file with specified name
     /// on FS
+    /// @note The content is not loaded for files larger than the limit, see
+    /// fs::FileInfoWithData::is_loaded
     FileInfoWithDataConstPtr TryGetFile(std::string_view path) const;
 
+    /// @brief task processor to do filesystem operations, e.g. to read the
+    /// files that are not loaded into memory
+    engine::TaskProcessor& GetTaskProcessor() const { return tp_; }
+
     /// @brief Concurrency-safe cache update
     void UpdateCache();
 
@@ -52,6 +65,7 @@ private:
     const std::string dir_;
     const std::chrono::milliseconds update_period_;
     engine::TaskProcessor& tp_;
+    const std::size_t max_loaded_file_size_;
 #ifndef __linux__
     utils::PeriodicTask cache_updater_;
 #endif
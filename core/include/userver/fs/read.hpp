@@ -3,6 +3,9 @@
 /// @file userver/fs/read.hpp
 /// @brief functions for asynchronous file read operations
 
+#include <chrono>
+#include <cstddef>
+#include <limits>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -19,8 +22,20 @@ namespace fs {
 struct FileInfoWithData {
     std::string data;
     std::string extension;
+    /// Path to the file on the filesystem
+    std::string path;
+    /// Size of the file, equals to `data.size()` if the file is loaded
+    std::size_t size{0};
+    /// Time of the last modification of the file
+    std::chrono::system_clock::time_point last_modified{};
+    /// Whether `data` holds the file contents. Files larger than the load
+    /// limit are described by the metadata only and should be read from `path`.
+    bool is_loaded{true};
 };
 
+/// Load limit that makes the functions below load every file
+inline constexpr std::size_t kUnlimitedLoadedFileSize = std::numeric_limits<std::size_t>::max();
+
 using FileInfoWithDataConstPtr = std::shared_ptr<const FileInfoWithData>;
 using FileInfoWithDataMap = std::unordered_map<std::string, FileInfoWithDataConstPtr>;
 
@@ -41,13 +56,29 @@ std::string GetLexicallyRelative(std::string_view path, std::string_view dir);
 /// @param async_tp TaskProcessor for synchronous waiting
 /// @param path to directory to traverse recursively
 /// @param flags settings read files
+/// @param max_loaded_size files larger than that are not loaded into memory,
+/// only their metadata is collected
 /// @returns map with relative to `path` filepaths and file info
 /// @throws std::runtime_error if read fails for any reason (e.g. no such file,
 /// read error, etc.),
 FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     engine::TaskProcessor& async_tp,
     const std::string& path,
-    utils::Flags<SettingsReadFile> flags = {SettingsReadFile::kSkipHidden}
+    utils::Flags<SettingsReadFile> flags = {SettingsReadFile::kSkipHidden},
+    std::size_t max_loaded_size = kUnlimitedLoadedFileSize
+);
+
+/// @brief Reads file metadata and, if the file is not larger than
+/// `max_loaded_size`, its contents asynchronously
+/// @param async_tp TaskProcessor for synchronous waiting
+/// @param path file to read
+/// @param max_loaded_size files larger than that are not loaded into memory
+/// @throws std::runtime_error if read fails for any reason (e.g. no such file,
+/// read error, etc.),
+FileInfoWithData ReadFileInfoWithData(
+    engine::TaskProcessor& async_tp,
+    const std::string& path,
+    std::size_t max_loaded_size = kUnlimitedLoadedFileSize
 );
 
 /// @brief Reads file contents asynchronously
@@ -10,6 +10,7 @@ namespace rcu {
 struct DefaultRcuTraits;
 struct SyncRcuTraits;
 struct BlockingRcuTraits;
+struct EpochRcuTraits;
 
 template <typename Key>
 struct DefaultRcuMapTraits;
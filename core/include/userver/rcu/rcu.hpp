@@ -4,9 +4,11 @@
 /// @brief @copybrief rcu::Variable
 
 #include <atomic>
+#include <cstdint>
 #include <cstdlib>
 #include <mutex>
 #include <optional>
+#include <type_traits>
 #include <utility>
 
 #include <userver/concurrent/impl/asymmetric_fence.hpp>
@@ -36,6 +38,8 @@ struct SnapshotRecord final {
     concurrent::impl::StripedReadIndicator indicator;
     concurrent::impl::SinglyLinkedHook<SnapshotRecord> free_list_hook;
     SnapshotRecord* next_retired{nullptr};
+    // Only used with rcu::EpochReclamation
+    std::uint64_t retire_epoch{0};
 };
 
 // Used instead of concurrent::impl::MemberHook to avoid instantiating
@@ -88,6 +92,20 @@ private:
     SnapshotRecord<T>* head_{nullptr};
 };
 
+// Process-wide epochs of rcu::EpochReclamation. A snapshot retired at epoch E
+// is not used by any reader once the epoch reaches E + 2.
+
+// Marks the current epoch as used for the lifetime of the lock. The snapshots
+// loaded after this call are protected by the lock.
+concurrent::impl::StripedReadIndicatorLock LockCurrentEpoch() noexcept;
+
+// Returns the epoch to mark a snapshot with after its removal.
+std::uint64_t GetRetireEpoch() noexcept;
+
+// Advances the epoch towards `target` while the readers of the previous epoch
+// are gone. Returns the resulting epoch.
+std::uint64_t TryAdvanceEpoch(std::uint64_t target) noexcept;
+
 }  // namespace impl
 
 /// @brief A handle to the retired object version, which an RCU deleter should
@@ -159,6 +177,26 @@ private:
     utils::impl::WaitTokenStorage wait_token_storage_;
 };
 
+/// @brief Protects each snapshot with its own read indicator, like a hazard
+/// pointer does. A snapshot is reclaimed on the first write or Cleanup after
+/// its readers are gone.
+/// @see rcu::DefaultRcuTraits
+struct HazardPointerReclamation final {};
+
+/// @brief Protects the snapshots with process-wide epochs, which are shared by
+/// all the rcu::Variable instances with this policy.
+///
+/// A read marks the current epoch instead of a specific snapshot, so there is
+/// no retry loop on concurrent writes and no per-snapshot read indicator to
+/// scan on writes. The readers may still be held across context switches and
+/// moved between threads.
+///
+/// The price is that a long-living ReadablePtr of any such variable delays the
+/// reclamation of all the snapshots retired after it was taken, so prefer it
+/// for small hot values (configs, small lookup tables) with short reads.
+/// @see rcu::DefaultRcuTraits
+struct EpochReclamation final {};
+
 /// @brief Default RCU traits. Deletes garbage asynchronously.
 /// Designed for storing data of multi-megabyte or multi-gigabyte caches.
 /// @note Allows reads from any kind of thread.
@@ -175,6 +213,10 @@ struct DefaultRcuTraits {
     /// 1. should contain `void Delete(SnapshotHandle<T>) noexcept`;
     /// 2. force synchronous cleanup of remaining handles on destruction.
     using DeleterType = AsyncDeleter;
+
+    /// `ReclamationType` defines how the readers protect the snapshots from
+    /// reclamation: rcu::HazardPointerReclamation or rcu::EpochReclamation.
+    using ReclamationType = HazardPointerReclamation;
 };
 
 /// @brief Deletes garbage synchronously.
@@ -197,6 +239,24 @@ struct BlockingRcuTraits : public DefaultRcuTraits {
     using DeleterType = SyncDeleter;
 };
 
+/// @brief Rcu traits for frequently read small values, uses epochs instead of
+/// per-snapshot read indicators.
+/// @note Allows reads from any kind of thread.
+/// Only allows writes from coroutine threads.
+/// @see rcu::EpochReclamation
+/// @see rcu::DefaultRcuTraits
+struct EpochRcuTraits : public DefaultRcuTraits {
+    using ReclamationType = EpochReclamation;
+};
+
+namespace impl {
+
+template <typename RcuTraits>
+inline constexpr bool kIsEpochReclamation =
+    std::is_same_v<typename RcuTraits::ReclamationType, EpochReclamation>;
+
+}  // namespace impl
+
 /// Reader smart pointer for rcu::Variable<T>. You may use operator*() or
 /// operator->() to do something with the stored value. Once created,
 /// ReadablePtr references the same immutable value: if Variable's value is
@@ -206,6 +266,14 @@ template <typename T, typename RcuTraits>
 class [[nodiscard]] ReadablePtr final {
 public:
     explicit ReadablePtr(const Variable<T, RcuTraits>& ptr) {
+        if constexpr (impl::kIsEpochReclamation<RcuTraits>) {
+            // LockCurrentEpoch issues AsymmetricThreadFenceLight, which pairs with
+            // AsymmetricThreadFenceHeavy in TryAdvanceEpoch, see the comment below.
+            lock_ = impl::LockCurrentEpoch();
+            ptr_ = &*ptr.current_.load(std::memory_order_seq_cst)->data;
+            return;
+        }
+
         auto* record = ptr.current_.load();
 
         while (true) {
@@ -460,6 +528,10 @@ private:
         current_.store(&new_snapshot, std::memory_order_seq_cst);
 
         UASSERT(old_snapshot);
+        if constexpr (impl::kIsEpochReclamation<RcuTraits>) {
+            last_retire_epoch_ = impl::GetRetireEpoch();
+            old_snapshot->retire_epoch = last_retire_epoch_;
+        }
         retired_list_.Push(*old_snapshot);
         ScanRetiredList(lock);
     }
@@ -484,6 +556,15 @@ private:
         UASSERT(lock.owns_lock());
         if (retired_list_.IsEmpty()) return;
 
+        if constexpr (impl::kIsEpochReclamation<RcuTraits>) {
+            const auto epoch = impl::TryAdvanceEpoch(last_retire_epoch_ + 2);
+            retired_list_.RemoveAndDisposeIf(
+                [epoch](impl::SnapshotRecord<T>& record) { return record.retire_epoch + 2 <= epoch; },
+                [&](impl::SnapshotRecord<T>& record) { DeleteSnapshot(record); }
+            );
+            return;
+        }
+
         concurrent::impl::AsymmetricThreadFenceHeavy();
 
         retired_list_.RemoveAndDisposeIf(
@@ -503,6 +584,8 @@ private:
     MutexType mutex_{};
     impl::SnapshotRecordFreeList<T> free_list_;
     impl::SnapshotRecordRetiredList<T> retired_list_;
+    // Only used with rcu::EpochReclamation
+    std::uint64_t last_retire_epoch_{0};
     // Must be placed after 'free_list_' to force sync cleanup before
     // the destruction of free_list_.
     DeleterType deleter_{};
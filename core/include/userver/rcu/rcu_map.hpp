@@ -10,7 +10,9 @@
 #include <unordered_map>
 #include <utility>
 
+#include <userver/cache/persistent_hash_map.hpp>
 #include <userver/rcu/rcu.hpp>
+#include <userver/utils/lazy_prvalue.hpp>
 #include <userver/utils/traceful_exception.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -42,12 +44,29 @@ public:
 /// type `Key`
 /// - `MutexType` is a writer's mutex type that has to be used to protect
 /// structure on update
+/// - `MapType` is a map type that stores the keys and the value pointers, it
+/// is copied on each keyset change
 template <typename Key>
 struct DefaultRcuMapTraits : public impl::ShouldInheritFromDefaultRcuMapTraits {
     using Hash = std::hash<Key>;
     using KeyEqual = std::equal_to<Key>;
     using MutexType = engine::Mutex;
     using DeleterType = AsyncDeleter;
+
+    template <typename K, typename V, typename H, typename E>
+    using MapType = std::unordered_map<K, V, H, E>;
+};
+
+/// @brief RcuMap traits for write-heavy maps.
+///
+/// The keys are stored in cache::PersistentHashMap, which is copied in O(1)
+/// and modified in O(log n) without affecting the copies. So a keyset change
+/// costs O(log n) instead of copying the whole map, for the price of somewhat
+/// slower lookups and iteration.
+template <typename Key>
+struct PersistentRcuMapTraits : public DefaultRcuMapTraits<Key> {
+    template <typename K, typename V, typename H, typename E>
+    using MapType = cache::PersistentHashMap<K, V, H, E>;
 };
 
 /// @brief Forward iterator for the rcu::RcuMap
@@ -61,7 +80,7 @@ class RcuMapIterator final {
     );
     using Hash = typename RcuMapTraits::Hash;
     using KeyEqual = typename RcuMapTraits::KeyEqual;
-    using MapType = std::unordered_map<Key, std::shared_ptr<Value>, Hash, KeyEqual>;
+    using MapType = typename RcuMapTraits::template MapType<Key, std::shared_ptr<Value>, Hash, KeyEqual>;
     using BaseIterator = typename MapType::const_iterator;
     using RcuTraits = typename impl::RcuTraitsFromRcuMapTraits<RcuMapTraits>;
 
@@ -102,7 +121,9 @@ private:
 /// Only keyset changes are thread-safe in scope of this class.
 /// Values are stored in `shared_ptr`s and are not copied during keyset change.
 /// The map itself is implemented as rcu::Variable, so every keyset change
-/// (e.g. insert or erase) triggers the whole map copying.
+/// (e.g. insert or erase) triggers the whole map copying. Use
+/// rcu::PersistentRcuMapTraits for maps with frequent keyset changes, with
+/// them only O(log n) of the map is copied.
 /// @note No synchronization is provided for value access, it must be
 /// implemented by Value when necessary.
 ///
@@ -130,7 +151,7 @@ public:
     using Iterator = RcuMapIterator<Key, Value, Value, RcuMapTraits>;
     using ConstValuePtr = std::shared_ptr<const Value>;
     using ConstIterator = RcuMapIterator<Key, Value, const Value, RcuMapTraits>;
-    using RawMap = std::unordered_map<Key, ValuePtr, Hash, KeyEqual>;
+    using RawMap = typename RcuMapTraits::template MapType<Key, ValuePtr, Hash, KeyEqual>;
     using Snapshot = std::unordered_map<Key, ConstValuePtr, Hash, KeyEqual>;
     using InsertReturnType = InsertReturnTypeImpl<ValuePtr>;
 
@@ -301,7 +322,7 @@ const typename RcuMap<K, V, RcuMapTraits>::ValuePtr RcuMap<K, V, RcuMapTraits>::
     auto value = Get(key);
     if (!value) {
         auto txn = rcu_.StartWrite();
-        auto insertion_result = txn->emplace(key, std::make_shared<V>());
+        auto insertion_result = txn->try_emplace(key, std::make_shared<V>());
         value = insertion_result.first->second;
         if (insertion_result.second) txn.Commit();
     }
@@ -331,7 +352,7 @@ template <typename K, typename V, typename RcuMapTraits>
 typename RcuMap<K, V, RcuMapTraits>::InsertReturnType
 RcuMap<K, V, RcuMapTraits>::DoInsert(const K& key, typename RcuMap<K, V, RcuMapTraits>::ValuePtr value) {
     auto txn = rcu_.StartWrite();
-    auto insertion_result = txn->emplace(key, std::move(value));
+    auto insertion_result = txn->try_emplace(key, std::move(value));
     InsertReturnType result{insertion_result.first->second, insertion_result.second};
     if (result.inserted) txn.Commit();
     return result;
@@ -344,13 +365,14 @@ RcuMap<K, V, RcuMapTraits>::TryEmplace(const K& key, Args&&... args) {
     InsertReturnType result{Get(key), false};
     if (!result.value) {
         auto txn = rcu_.StartWrite();
-        auto insertion_result = txn->try_emplace(key, nullptr);
+        // The value is constructed only if the key is missing
+        auto insertion_result = txn->try_emplace(key, utils::LazyPrvalue([&] {
+            return std::make_shared<V>(std::forward<Args>(args)...);
+        }));
+        result.value = insertion_result.first->second;
         if (insertion_result.second) {
-            result.value = insertion_result.first->second = std::make_shared<V>(std::forward<Args>(args)...);
             txn.Commit();
             result.inserted = true;
-        } else {
-            result.value = insertion_result.first->second;
         }
     }
     return result;
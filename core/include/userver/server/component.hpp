@@ -43,6 +43,8 @@ namespace components {
 /// listener | (*required*) *see below* | -
 /// listener-monitor | *see below* | -
 /// set-response-server-hostname | set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header | false
+/// handler-timings-us | set to true to add the `timings-us` percentiles of the handlers in microseconds | false
+/// handler-timings-histogram | set to true to add the `timings-histogram` histogram of the handlers in microseconds, see utils::statistics::kTimingsHistogramBounds | false
 ///
 /// Server is configured by 'listener' and 'listener-monitor' entries.
 /// 'listener' is a required entry that describes the request processing
@@ -78,6 +80,7 @@ namespace components {
 /// connection.keepalive_timeout | timeout in seconds to drop connection if there's not data received from it | 600
 /// connection.stream_close_check_delay | delay in microseconds of the start of stream close check routine; do not set if not sure what it is doing | 20ms
 /// connection.http-version | the HTTP protocol version | '1.1'
+/// connection.http1-parser | HTTP/1.1 request parser: 'llhttp' or 'simd', a faster line-based parser with SIMD-accelerated scanning | llhttp
 /// connection.http2-session.max_concurrent_streams | max number of concurrent open streams | 100
 /// connection.http2-session.max_frame_size | max size of the HTTP/2.0 frame | 16384
 /// connection.http2-session.initial_window_size | the initial window size of the server | 65536
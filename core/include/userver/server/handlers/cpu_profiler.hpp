@@ -0,0 +1,85 @@
+#pragma once
+
+/// @file userver/server/handlers/cpu_profiler.hpp
+/// @brief @copybrief server::handlers::CpuProfiler
+
+#include <userver/server/handlers/http_handler_base.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+// clang-format off
+
+/// @ingroup userver_components userver_http_handlers
+///
+/// @brief Handler that controls the sampling CPU profiler of the task
+/// processors.
+///
+/// While active, the profiler samples each task processor thread every
+/// `interval-us` microseconds of the CPU time the thread consumes. A sample
+/// is the stacktrace of the thread and the tag of the running task: the name
+/// of the HTTP handler that serves the request, which is inherited by the
+/// tasks the request starts. The samples are aggregated in memory until
+/// `reset`, so the profile of a long period takes no more memory than that
+/// of a short one.
+///
+/// The sampling costs a signal and a stack unwinding per sample and does not
+/// stop the threads, so with the default interval of 10ms the profiler may be
+/// kept running in production.
+///
+/// The profiler uses SIGPROF, do not use it together with other profilers that
+/// use the signal, e.g. gperftools. Linux only.
+///
+/// The component has no service configuration except the
+/// @ref userver_http_handlers "common handler options".
+///
+/// ## Static configuration example:
+///
+/// @code
+/// handler-cpu-profiler:
+///     path: /service/cpu-profiler/{command}
+///     method: POST
+///     task_processor: monitor-task-processor
+/// @endcode
+///
+/// ## Schema
+/// Set an URL path argument `command` to one of the following values:
+/// * `start` - to start sampling, an optional argument `interval-us` sets the
+///   sampling interval in microseconds of the CPU time (10000 by default)
+/// * `stop` - to stop sampling, the collected stacks are kept
+/// * `reset` - to drop the collected stacks
+/// * `stat` - to get the profiler state and the number of samples
+/// * `collapsed` - to get the collected stacks in the collapsed format:
+///   `<thread>;<handler>;<root frame>;...;<leaf frame> <samples>`. The output
+///   may be passed to `flamegraph.pl` or opened in speedscope.
+///
+/// @code
+/// $ curl -X POST localhost:1188/service/cpu-profiler/start?interval-us=5000
+/// $ sleep 60
+/// $ curl -X POST localhost:1188/service/cpu-profiler/collapsed > service.folded
+/// $ curl -X POST localhost:1188/service/cpu-profiler/stop
+/// $ flamegraph.pl service.folded > service.svg
+/// @endcode
+
+// clang-format on
+
+class CpuProfiler final : public HttpHandlerBase {
+public:
+    CpuProfiler(const components::ComponentConfig&, const components::ComponentContext&);
+
+    /// @ingroup userver_component_names
+    /// @brief The default name of server::handlers::CpuProfiler
+    static constexpr std::string_view kName = "handler-cpu-profiler";
+
+    std::string HandleRequestThrow(const http::HttpRequest&, request::RequestContext&) const override;
+
+    static yaml_config::Schema GetStaticConfigSchema();
+};
+
+}  // namespace server::handlers
+
+template <>
+inline constexpr bool components::kHasValidate<server::handlers::CpuProfiler> = true;
+
+USERVER_NAMESPACE_END
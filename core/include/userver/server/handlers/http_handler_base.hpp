@@ -191,7 +191,11 @@ private:
     ) const;
 
     template <typename HttpStatistics>
-    void FormatStatistics(utils::statistics::Writer result, const HttpStatistics& stats);
+    void FormatStatistics(
+        utils::statistics::Writer result,
+        const HttpStatistics& stats,
+        utils::statistics::TimingsMetrics timings_metrics
+    );
 
     void SetResponseServerHostname(http::HttpResponse& response) const;
 
@@ -200,6 +204,8 @@ private:
     const dynamic_config::Source config_source_;
     const std::vector<http::HttpMethod> allowed_methods_;
     const std::string handler_name_;
+    // engine::impl::CpuProfilerTag of the request tasks
+    const std::string* const cpu_profiler_tag_;
     utils::statistics::Entry statistics_holder_;
     std::optional<logging::Level> log_level_;
     std::unordered_map<int, logging::Level> log_level_for_status_codes_;
@@ -19,6 +19,12 @@ namespace server::handlers {
 /// @brief Handler that returns HTTP 200 if file exist
 /// and returns file data with mapped content/type
 ///
+/// Single range requests and conditional requests by ETag and
+/// If-Modified-Since are supported. Files that components::FsCache keeps in
+/// memory are sent without copying, larger ones are sent from the filesystem
+/// with sendfile(2) if the connection is not encrypted. The file is read on the
+/// fs-task-processor of components::FsCache, not on the worker threads.
+///
 /// ## HttpHandlerStatic Dynamic config
 /// * @ref USERVER_FILES_CONTENT_TYPE_MAP
 ///
@@ -3,8 +3,11 @@
 /// @file userver/server/handlers/server_monitor.hpp
 /// @brief @copybrief server::handlers::ServerMonitor
 
+#include <utility>
+
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/utils/statistics/fwd.hpp>
+#include <userver/utils/statistics/prometheus.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -30,6 +33,12 @@ enum class StatsFormat;
 ///   utils::statistics::ToPrometheusFormatUntyped, utils::statistics::ToGraphiteFormat, utils::statistics::ToJsonFormat,
 ///   utils::statistics::ToSolomonFormat, utils::statistics::ToPrettyFormat.
 ///
+/// For the services with hundreds of thousands of metrics consider:
+/// * 'cache-prometheus-series: true' - keep the formatted Prometheus series between the requests,
+///   see utils::statistics::PrometheusFormatter. Costs about the size of the output in memory;
+/// * 'response-body-stream: true' - send the Prometheus output in parts while it is being formatted,
+///   instead of building it as a whole.
+///
 /// ## Static configuration example:
 ///
 /// @snippet components/common_server_component_list_test.cpp  Sample handler server monitor component config
@@ -55,9 +64,19 @@ public:
 
     std::string HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const override;
 
+    void HandleStreamRequest(
+        const http::HttpRequest& request,
+        request::RequestContext& context,
+        http::ResponseBodyStream& response_body_stream
+    ) const override;
+
     static yaml_config::Schema GetStaticConfigSchema();
 
 private:
+    std::pair<impl::StatsFormat, utils::statistics::Request> ParseRequest(const http::HttpRequest& request) const;
+
+    const utils::statistics::PrometheusFormatter& GetPrometheusFormatter(impl::StatsFormat format) const;
+
     std::string GetResponseDataForLogging(
         const http::HttpRequest& request,
         request::RequestContext& context,
@@ -69,6 +88,8 @@ private:
     using CommonLabels = std::unordered_map<std::string, std::string>;
     const CommonLabels common_labels_;
     const std::optional<impl::StatsFormat> default_format_;
+    const utils::statistics::PrometheusFormatter prometheus_formatter_;
+    const utils::statistics::PrometheusFormatter prometheus_untyped_formatter_;
 };
 
 }  // namespace server::handlers
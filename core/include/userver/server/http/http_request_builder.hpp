@@ -34,6 +34,8 @@ public:
 
     HttpRequestBuilder& AddHeader(std::string&& header, std::string&& value);
 
+    HttpRequestBuilder& ReserveHeaders(std::size_t count);
+
     HttpRequestBuilder& AddRequestArg(std::string&& key, std::string&& value);
 
     HttpRequestBuilder& SetPathArgs(std::vector<std::pair<std::string, std::string>> args);
@@ -4,11 +4,15 @@
 /// @brief @copybrief server::http::HttpResponse
 
 #include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
 #include <variant>
 
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/single_consumer_event.hpp>
+#include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/http/content_type.hpp>
 #include <userver/http/header_map.hpp>
 #include <userver/server/http/http_response_cookie.hpp>
@@ -20,6 +24,10 @@
 
 USERVER_NAMESPACE_BEGIN
 
+namespace fs::blocking {
+class FileDescriptor;
+}  // namespace fs::blocking
+
 namespace server::http {
 
 // RFC 9110 states that in case of missing Content-Type it may be assumed to be
@@ -127,6 +135,18 @@ public:
     /// @cond
     // TODO: server internals. remove from public interface
     void SendResponse(engine::io::RwBase& socket) override;
+
+    // Sends `size` bytes of the file starting at `offset` as the body, unless
+    // a data body is set. Plain TCP connections send it with sendfile(2),
+    // other transports read it in chunks. The file is only read
+    // on `fs_task_processor`.
+    void SetFileBody(
+        fs::blocking::FileDescriptor file,
+        std::size_t offset,
+        std::size_t size,
+        engine::TaskProcessor& fs_task_processor
+    );
+    bool HasFileBody() const noexcept { return file_body_ != nullptr; }
     /// @endcond
 
     void SetStatusServiceUnavailable() override { SetStatus(HttpStatus::kServiceUnavailable); }
@@ -147,6 +167,17 @@ public:
 private:
     friend class Http2ResponseWriter;
 
+    struct FileBody;
+
+    // Returns the size of the body sent
+    std::size_t SendFileBody(engine::io::RwBase& socket) const;
+
+    // For the transports that frame the body themselves. The reader owns
+    // the file, returns the next chunk of the body on each call and may
+    // outlive the response.
+    std::function<std::string()> ExtractFileBodyReader();
+    std::size_t GetFileBodySize() const;
+
     // Returns total size of the response
     std::size_t SetBodyStreamed(engine::io::RwBase& socket, USERVER_NAMESPACE::http::headers::HeadersString& header);
 
@@ -161,6 +192,7 @@ private:
     engine::SingleConsumerEvent headers_end_{engine::SingleConsumerEvent::NoAutoReset()};
     std::optional<Queue::Consumer> body_stream_;
     Producer body_stream_producer_;
+    std::unique_ptr<FileBody> file_body_;
     bool is_stream_body_{false};
 };
 
@@ -4,6 +4,7 @@
 #include <chrono>
 #include <functional>
 #include <limits>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -82,8 +83,11 @@ public:
     virtual ~ResponseBase() noexcept;
 
     void SetData(std::string data);
-    const std::string& GetData() const { return data_; }
-    std::string&& ExtractData() { return std::move(data_); }
+    /// Sets the body that is owned elsewhere and may be shared between
+    /// responses, e.g. a cached one. It is sent without being copied.
+    void SetSharedData(std::shared_ptr<const std::string> data);
+    const std::string& GetData() const { return shared_data_ ? *shared_data_ : data_; }
+    std::string&& ExtractData();
 
     virtual bool IsBodyStreamed() const = 0;
     virtual bool WaitForHeadersEnd() = 0;
@@ -112,6 +116,10 @@ public:
     std::optional<std::int32_t> GetStreamId() const { return stream_id_; }
     void SetStreamProdicer(http::impl::Http2StreamEventProducer&& producer);
     http::impl::Http2StreamEventProducer GetStreamProducer();
+
+    // Returns nullptr if the body is not shared
+    std::shared_ptr<const std::string> ExtractSharedData() noexcept;
+    bool HasSharedData() const noexcept { return shared_data_ != nullptr; }
     /// @endcond
 
 protected:
@@ -138,6 +146,7 @@ private:
     ResponseDataAccounter& accounter_;
     std::optional<Guard> guard_;
     std::string data_;
+    std::shared_ptr<const std::string> shared_data_;
     std::chrono::steady_clock::time_point create_time_;
     std::chrono::steady_clock::time_point ready_time_;
     std::chrono::steady_clock::time_point sent_time_;
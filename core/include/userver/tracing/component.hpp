@@ -25,6 +25,17 @@ namespace components {
 /// ---- | ----------- | -------------
 /// service-name | name of the service to write in traces | ''
 /// tracer | type of the tracer to trace, currently supported only 'native' | 'native'
+/// tail-sampling.enabled | keep the finished spans of each trace in memory and log them only if the trace is sampled when its root span finishes | false
+/// tail-sampling.latency-threshold | utils::StringToDuration suitable duration string, traces with the root span that took longer are always logged | 1s
+/// tail-sampling.probability | probability to log a trace that is neither failed nor slow | 0
+/// tail-sampling.max-buffer-size | the finished spans of a pending trace beyond this many bytes are dropped, the root span gets the `tail_sampling_dropped_spans` tag | 65536
+///
+/// With the tail sampling the traces that finished with an error (the
+/// tracing::kErrorFlag tag in any of the spans) are always logged. A trace is
+/// logged without waiting for its root span as soon as a span fails or a span
+/// finishes after `latency-threshold` since the start of the trace. The spans
+/// of the dropped traces are never written to the logs. The log records that
+/// are not spans are not affected.
 ///
 /// ## Static configuration example:
 ///
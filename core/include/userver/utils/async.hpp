@@ -41,7 +41,7 @@ private:
 
     struct Impl;
 
-    static constexpr std::size_t kImplSize = 4264;
+    static constexpr std::size_t kImplSize = 4296;
     static constexpr std::size_t kImplAlign = 8;
     utils::FastPimpl<Impl, kImplSize, kImplAlign> pimpl_;
 };
@@ -92,6 +92,14 @@ inline auto SpanLazyPrvalue(std::string&& name) {
 ///   the function is guaranteed to start regardless of engine::TaskProcessor
 ///   load limits
 ///
+/// By engine::TaskBase::Priority:
+///
+/// * By default, tasks wait for execution in the `kNormal` queue lane.
+/// * Overloads of `utils::Async` and `engine::AsyncNoSpan` accepting
+///   engine::TaskBase::Priority put the task into the `kCritical` or
+///   `kBackground` lane. Lanes are dequeued by weighted round-robin, so
+///   background work is delayed under load, but never starved.
+///
 /// By tracing::Span:
 ///
 /// * Functions from `utils::*Async*` family (which you should use by default)
@@ -244,6 +252,38 @@ template <typename Function, typename... Args>
     );
 }
 
+/// @overload
+/// @ingroup userver_concurrency
+///
+/// The task waits for execution in the task processor queue lane of the
+/// specified priority, so that e.g. a burst of background work does not delay
+/// latency-critical tasks on the same task processor. Task execution may be
+/// cancelled before the function starts execution in case of TaskProcessor
+/// overload.
+///
+/// @param task_processor Task processor to run on
+/// @param priority Queue lane of the task, see engine::Task::Priority
+/// @param name Name of the task to show in logs
+/// @param f Function to execute asynchronously
+/// @param args Arguments to pass to the function
+/// @returns engine::TaskWithResult
+template <typename Function, typename... Args>
+[[nodiscard]] auto Async(
+    engine::TaskProcessor& task_processor,
+    engine::Task::Priority priority,
+    std::string name,
+    Function&& f,
+    Args&&... args
+) {
+    return engine::AsyncNoSpan(
+        task_processor,
+        priority,
+        impl::SpanLazyPrvalue(std::move(name)),
+        std::forward<Function>(f),
+        std::forward<Args>(args)...
+    );
+}
+
 /// @overload
 /// @ingroup userver_concurrency
 ///
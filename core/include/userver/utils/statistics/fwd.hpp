@@ -22,6 +22,8 @@ class Request;
 class Entry;
 class Writer;
 
+struct TimingsMetrics;
+
 class MetricsStorage;
 using MetricsStoragePtr = std::shared_ptr<MetricsStorage>;
 
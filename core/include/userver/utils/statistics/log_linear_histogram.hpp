@@ -0,0 +1,290 @@
+#pragma once
+
+/// @file userver/utils/statistics/log_linear_histogram.hpp
+/// @brief @copybrief utils::statistics::LogLinearHistogram
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <initializer_list>
+
+#include <userver/utils/span.hpp>
+#include <userver/utils/statistics/histogram_aggregator.hpp>
+#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/writer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::statistics {
+
+/** @brief Histogram with buckets of constant relative width (log-linear, like
+ * HdrHistogram), that calculates percentiles of values of any magnitude with
+ * a given relative precision.
+ *
+ * Values in `[0, 2^(PrecisionBits + 1))` are counted exactly. Each following
+ * range `[2^k, 2^(k+1))` is split into `2^PrecisionBits` buckets of equal
+ * width, so a percentile is off by at most `2^-PrecisionBits` of its value
+ * (1.6% for 6 bits, 0.8% for 7 bits). Values from `2^MaxValueBits` on are
+ * counted in the last bucket.
+ *
+ * The memory is constant: there are
+ * `(MaxValueBits - PrecisionBits + 1) * 2^PrecisionBits` counters of type
+ * `Counter`.
+ *
+ * Account() is a single relaxed atomic increment of the bucket, there is no
+ * shared total count to contend on.
+ *
+ * Like utils::statistics::Percentile, the histogram may be used with
+ * utils::statistics::RecentPeriod, the windows are merged by Add(). Merging
+ * loses no precision, so the histograms of multiple hosts or handlers may be
+ * summed. ToHistogram() converts the histogram to a summable
+ * utils::statistics::HistogramAggregator metric with the given bounds.
+ * utils::statistics::DumpTimings writes the timings metrics of a histogram of
+ * microseconds.
+ *
+ * @b Example:
+ * Microsecond timings up to 134 seconds with 1.6% precision:
+ *
+ * @code
+ * using Timings = utils::statistics::LogLinearHistogram<6, 27>;
+ * utils::statistics::RecentPeriod<Timings, Timings> timings;
+ *
+ * void Account(std::chrono::microseconds us) {
+ *   timings.GetCurrentCounter().Account(us.count());
+ * }
+ *
+ * void DumpMetric(utils::statistics::Writer& writer, const Component& component) {
+ *   const auto timings_us = component.timings.GetStatsForPeriod();
+ *   utils::statistics::DumpTimings(writer, timings_us, component.timings_metrics);
+ * }
+ * @endcode
+ *
+ * Type is safe to read/write concurrently from different threads/coroutines.
+ */
+template <std::size_t PrecisionBits = 7, std::size_t MaxValueBits = 32, typename Counter = std::uint32_t>
+class LogLinearHistogram final {
+public:
+    static_assert(PrecisionBits > 0 && PrecisionBits < MaxValueBits && MaxValueBits < 64);
+    static_assert(
+        std::atomic<Counter>::is_always_lock_free,
+        "`std::atomic<Counter>` is not lock-free. Please choose some "
+        "other `Counter` type"
+    );
+
+    static constexpr std::size_t kBucketCount = (MaxValueBits - PrecisionBits + 1) << PrecisionBits;
+
+    LogLinearHistogram() noexcept { Reset(); }
+
+    LogLinearHistogram(const LogLinearHistogram& other) noexcept { *this = other; }
+
+    LogLinearHistogram& operator=(const LogLinearHistogram& rhs) noexcept {
+        if (this == &rhs) return *this;
+
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            counters_[i].store(rhs.LoadBucket(i), std::memory_order_relaxed);
+        }
+        return *this;
+    }
+
+    /// @brief Account for another value.
+    ///
+    /// `count` is added to the bucket corresponding to `value`
+    void Account(std::uint64_t value, Counter count = 1) noexcept {
+        counters_[GetBucketIndex(value)].fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /// @brief Get X percentile - min value P so that total number
+    /// of elements in buckets is no less than X percent.
+    ///
+    /// Returns the highest value of the found bucket, so that the percentile
+    /// is never underestimated.
+    ///
+    /// @param percent - value in [0..100] - requested percentile.
+    /// If outside of 100, then returns last bucket that has any element in it.
+    std::uint64_t GetPercentile(double percent) const noexcept {
+        const auto total = Count();
+        if (total == 0) return 0;
+
+        const auto want_sum = static_cast<double>(total) * percent;
+        std::uint64_t sum = 0;
+        std::uint64_t max_value = 0;
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            const auto value = LoadBucket(i);
+            sum += value;
+            if (static_cast<double>(sum) * 100 > want_sum) return GetBucketMaxValue(i);
+
+            if (value) max_value = GetBucketMaxValue(i);
+        }
+        return max_value;
+    }
+
+    template <class Duration = std::chrono::seconds>
+    void Add(
+        const LogLinearHistogram& other,
+        [[maybe_unused]] Duration this_epoch_duration = Duration(),
+        [[maybe_unused]] Duration before_this_epoch_duration = Duration()
+    ) noexcept {
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            if (const auto value = other.LoadBucket(i)) {
+                counters_[i].fetch_add(value, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @brief Zero out all the buckets.
+    void Reset() noexcept {
+        for (auto& counter : counters_) counter.store(0, std::memory_order_relaxed);
+    }
+
+    /// @brief Total number of elements
+    std::uint64_t Count() const noexcept {
+        std::uint64_t count = 0;
+        for (std::size_t i = 0; i < kBucketCount; ++i) count += LoadBucket(i);
+        return count;
+    }
+
+    /// @brief Converts the histogram to a summable histogram metric with the
+    /// given bucket bounds.
+    ///
+    /// A bucket of the log-linear histogram is attributed by its highest
+    /// value, so each exported bucket is exact up to the relative precision.
+    /// The bounds of the form `2^k - 1` split no buckets and are exact, they
+    /// match the exponential buckets of Prometheus native histograms.
+    HistogramAggregator ToHistogram(utils::span<const double> upper_bounds) const {
+        HistogramAggregator result{upper_bounds};
+        const auto* const bounds_end = upper_bounds.data() + upper_bounds.size();
+        const auto* bound = upper_bounds.data();
+        for (std::size_t i = 0; i < kBucketCount; ++i) {
+            const auto value = LoadBucket(i);
+            if (!value) continue;
+
+            const auto max_value = static_cast<double>(GetBucketMaxValue(i));
+            bound = std::lower_bound(bound, bounds_end, max_value);
+            if (bound == bounds_end) {
+                result.AccountInf(value);
+            } else {
+                result.AccountAt(bound - upper_bounds.data(), value);
+            }
+        }
+        return result;
+    }
+
+    /// @brief Index of the bucket that counts `value`
+    static constexpr std::size_t GetBucketIndex(std::uint64_t value) noexcept {
+        if (value < (std::uint64_t{1} << (PrecisionBits + 1))) return value;
+        if (value >> MaxValueBits) return kBucketCount - 1;
+
+        // The `PrecisionBits + 1` highest bits of the value select the bucket
+        const std::size_t shift = 63 - __builtin_clzll(value) - PrecisionBits;
+        return (shift << PrecisionBits) + (value >> shift);
+    }
+
+    /// @brief The highest value that is counted in the bucket
+    static constexpr std::uint64_t GetBucketMaxValue(std::size_t index) noexcept {
+        if (index < (std::size_t{1} << (PrecisionBits + 1))) return index;
+
+        const std::size_t shift = (index >> PrecisionBits) - 1;
+        const std::uint64_t mantissa = index - (shift << PrecisionBits);
+        return ((mantissa + 1) << shift) - 1;
+    }
+
+private:
+    std::uint64_t LoadBucket(std::size_t index) const noexcept {
+        return counters_[index].load(std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<Counter>, kBucketCount> counters_;
+};
+
+namespace impl {
+
+template <typename Histogram>
+void DumpPercentiles(
+    Writer& writer,
+    const Histogram& histogram,
+    std::uint64_t divisor,
+    std::initializer_list<double> percents
+) {
+    for (double percent : percents) {
+        writer.ValueWithLabels(
+            histogram.GetPercentile(percent) / divisor, {"percentile", statistics::GetPercentileFieldName(percent)}
+        );
+    }
+}
+
+}  // namespace impl
+
+template <std::size_t PrecisionBits, std::size_t MaxValueBits, typename Counter>
+void DumpMetric(
+    Writer& writer,
+    const LogLinearHistogram<PrecisionBits, MaxValueBits, Counter>& histogram,
+    std::initializer_list<double> percents = {0, 50, 90, 95, 98, 99, 99.6, 99.9, 100}
+) {
+    impl::DumpPercentiles(writer, histogram, 1, percents);
+}
+
+/// @brief The percentiles of a utils::statistics::LogLinearHistogram with
+/// the values divided by `divisor`, e.g. milliseconds of a histogram of
+/// microseconds. Created by utils::statistics::ScalePercentiles.
+template <typename Histogram>
+struct ScaledPercentiles final {
+    const Histogram& histogram;
+    std::uint64_t divisor;
+};
+
+/// @brief Allows to write the percentiles of a histogram in coarser units:
+/// @code
+/// writer["timings"] = utils::statistics::ScalePercentiles(timings_us, 1000);
+/// @endcode
+template <typename Histogram>
+ScaledPercentiles<Histogram> ScalePercentiles(const Histogram& histogram, std::uint64_t divisor) noexcept {
+    return {histogram, divisor};
+}
+
+template <typename Histogram>
+void DumpMetric(
+    Writer& writer,
+    const ScaledPercentiles<Histogram>& percentiles,
+    std::initializer_list<double> percents = {0, 50, 90, 95, 98, 99, 99.6, 99.9, 100}
+) {
+    impl::DumpPercentiles(writer, percentiles.histogram, percentiles.divisor, percents);
+}
+
+/// @brief The optional metrics of the timings in microseconds, see
+/// utils::statistics::DumpTimings
+struct TimingsMetrics final {
+    /// Write the `timings-us` percentiles in microseconds
+    bool percentiles_us{false};
+    /// Write the `timings-histogram` summable histogram in microseconds
+    bool histogram{false};
+};
+
+/// The `2^k - 1` microseconds bounds from 31us to 134s of the
+/// `timings-histogram` metrics. Such bounds split no buckets of
+/// utils::statistics::LogLinearHistogram, so the conversion is exact.
+inline constexpr auto kTimingsHistogramBounds = [] {
+    std::array<double, 23> bounds{};
+    for (std::size_t i = 0; i < bounds.size(); ++i) {
+        bounds[i] = static_cast<double>((std::uint64_t{1} << (i + 5)) - 1);
+    }
+    return bounds;
+}();
+
+/// @brief Writes the `timings` percentiles in milliseconds and the opted-in
+/// `timings_metrics` of a histogram of microseconds
+template <typename Histogram>
+void DumpTimings(Writer& writer, const Histogram& timings_us, TimingsMetrics timings_metrics) {
+    writer["timings"] = ScalePercentiles(timings_us, 1000);
+    if (timings_metrics.percentiles_us) {
+        writer["timings-us"] = timings_us;
+    }
+    if (timings_metrics.histogram) {
+        writer["timings-histogram"] = timings_us.ToHistogram(kTimingsHistogramBounds);
+    }
+}
+
+}  // namespace utils::statistics
+
+USERVER_NAMESPACE_END
@@ -60,6 +60,7 @@ namespace utils::statistics {
  * total timing percentiles.
  *
  * @see utils::statistics::Histogram for the summable equivalent
+ * @see utils::statistics::LogLinearHistogram for values of any magnitude
  */
 template <
     std::size_t M,
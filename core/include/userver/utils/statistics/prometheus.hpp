@@ -3,6 +3,9 @@
 /// @file userver/utils/statistics/prometheus.hpp
 /// @brief Statistics output in Prometheus format.
 
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <string>
 
 #include <userver/utils/statistics/storage.hpp>
@@ -34,6 +37,66 @@ ToPrometheusFormat(const utils::statistics::Storage& statistics, const utils::st
 std::string
 ToPrometheusFormatUntyped(const utils::statistics::Storage& statistics, const utils::statistics::Request& request = {});
 
+/// Settings of utils::statistics::PrometheusFormatter
+struct PrometheusFormatterSettings final {
+    /// Whether to output the metric types, like ToPrometheusFormat() does,
+    /// or not, like ToPrometheusFormatUntyped() does
+    bool typed{true};
+
+    /// Whether to keep the formatted series between the calls
+    bool cache_series{true};
+
+    /// Approximate size of the parts of the output passed to the consumer
+    std::size_t chunk_size{64 * 1024};
+};
+
+/// @brief Prometheus formatter for large metric trees, that may keep the
+/// formatted series between the calls and passes the output in parts.
+///
+/// The output is the same as of ToPrometheusFormat() or
+/// ToPrometheusFormatUntyped(). With `cache_series` each series (a metric
+/// path with its labels) is converted into the Prometheus name and labels only
+/// once. If the value of a series did not change since the previous call, its
+/// formatted line is reused as is. The series that were not written for a few
+/// calls are forgotten.
+///
+/// The metric writers are still called on each call, only the formatting of
+/// their metrics is skipped.
+///
+/// The cache takes about the size of the formatted output. The calls that
+/// run concurrently with another one format without the cache.
+class PrometheusFormatter final {
+public:
+    /// Consumer of the parts of the output
+    using ChunkConsumer = std::function<void(std::string&& chunk)>;
+
+    explicit PrometheusFormatter(const PrometheusFormatterSettings& settings = {});
+    ~PrometheusFormatter();
+
+    PrometheusFormatter(const PrometheusFormatter&) = delete;
+    PrometheusFormatter& operator=(const PrometheusFormatter&) = delete;
+
+    /// Outputs `statistics` as a single string
+    std::string ToString(const utils::statistics::Storage& statistics, const utils::statistics::Request& request = {})
+        const;
+
+    /// @brief Outputs `statistics` in parts of about
+    /// PrometheusFormatterSettings::chunk_size bytes.
+    ///
+    /// The consumer is called while the metrics are being written, it may
+    /// block, e.g. to send the part to a client.
+    /// @throws anything the consumer throws, the rest of the output is dropped
+    void Write(
+        const utils::statistics::Storage& statistics,
+        const utils::statistics::Request& request,
+        const ChunkConsumer& consumer
+    ) const;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
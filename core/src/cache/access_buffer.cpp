@@ -0,0 +1,24 @@
+#include <userver/cache/impl/access_buffer.hpp>
+
+#include <userver/compiler/thread_local.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+namespace {
+
+std::atomic<std::size_t> next_thread_index{0};
+
+compiler::ThreadLocal local_thread_index = [] { return next_thread_index.fetch_add(1, std::memory_order_relaxed); };
+
+}  // namespace
+
+std::size_t GetThreadIndex() noexcept {
+    auto thread_index = local_thread_index.Use();
+    return *thread_index;
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <userver/cache/impl/access_buffer.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kElementCount = 10'000;
+const std::array<int, kElementCount> kElements{};
+
+}  // namespace
+
+TEST(AccessBuffer, DrainInOrder) {
+    cache::impl::AccessBuffer<const int*, 8, 1> buffer;
+    EXPECT_FALSE(buffer.Record(&kElements[0]));
+    EXPECT_FALSE(buffer.Record(&kElements[1]));
+    EXPECT_FALSE(buffer.Record(&kElements[2]));
+    EXPECT_TRUE(buffer.Record(&kElements[3])) << "half full";
+
+    std::vector<const int*> drained;
+    buffer.Drain([&drained](const int* element) { drained.push_back(element); });
+    EXPECT_EQ(drained, (std::vector<const int*>{&kElements[0], &kElements[1], &kElements[2], &kElements[3]}));
+
+    drained.clear();
+    buffer.Drain([&drained](const int* element) { drained.push_back(element); });
+    EXPECT_TRUE(drained.empty());
+}
+
+TEST(AccessBuffer, DropsWhenFull) {
+    cache::impl::AccessBuffer<const int*, 4, 1> buffer;
+    for (int i = 0; i < 10; ++i) buffer.Record(&kElements[i]);
+
+    std::vector<const int*> drained;
+    buffer.Drain([&drained](const int* element) { drained.push_back(element); });
+    EXPECT_EQ(drained, (std::vector<const int*>{&kElements[0], &kElements[1], &kElements[2], &kElements[3]}));
+
+    buffer.Record(&kElements[42]);
+    buffer.Clear();
+    buffer.Drain([](const int*) { FAIL(); });
+}
+
+TEST(AccessBuffer, StripesByThread) {
+    cache::impl::AccessBuffer<const int*, 4, 2> buffer;
+
+    // The new threads get the consecutive indexes and fill different stripes
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 2; ++t) {
+        threads.emplace_back([&buffer, t] {
+            for (int i = 0; i < 4; ++i) buffer.Record(&kElements[t * 4 + i]);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    std::vector<const int*> drained;
+    buffer.Drain([&drained](const int* element) { drained.push_back(element); });
+    EXPECT_EQ(drained.size(), 8);
+}
+
+TEST(AccessBuffer, ConcurrentRecords) {
+    constexpr int kThreads = 4;
+
+    cache::impl::AccessBuffer<const int*, 16> buffer;
+    std::atomic<bool> stop{false};
+    std::atomic<int> recorded{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < kThreads; ++t) {
+        threads.emplace_back([&buffer, &recorded] {
+            for (int i = 0; i < kElementCount; ++i) {
+                buffer.Record(&kElements[i]);
+                ++recorded;
+            }
+        });
+    }
+
+    int drained = 0;
+    std::thread drainer([&] {
+        while (!stop) {
+            buffer.Drain([&drained](const int* element) {
+                EXPECT_GE(element, kElements.data());
+                EXPECT_LT(element, kElements.data() + kElementCount);
+                ++drained;
+            });
+        }
+    });
+
+    for (auto& thread : threads) thread.join();
+    stop = true;
+    drainer.join();
+    buffer.Drain([&drained](const int*) { ++drained; });
+
+    EXPECT_GT(drained, 0);
+    EXPECT_LE(drained, recorded.load());
+}
+
+USERVER_NAMESPACE_END
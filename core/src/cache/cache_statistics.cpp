@@ -1,5 +1,7 @@
 #include <userver/cache/cache_statistics.hpp>
 
+#include <algorithm>
+
 #include <userver/utils/assert.hpp>
 #include <userver/utils/datetime.hpp>
 #include <userver/utils/statistics/writer.hpp>
@@ -37,6 +39,13 @@ void CombineStatistics(
     result.last_successful_update_start_time =
         std::max(a.last_successful_update_start_time.load(), b.last_successful_update_start_time.load());
     result.last_update_duration = std::max(a.last_update_duration.load(), b.last_update_duration.load());
+
+    // The stages of different update types are not comparable, so the ones of
+    // the most recent update are taken
+    const auto& latest = a.last_update_start_time.load() >= b.last_update_start_time.load() ? a : b;
+    auto stage_durations = latest.last_update_stage_durations.Lock();
+    auto result_stage_durations = result.last_update_stage_durations.Lock();
+    *result_stage_durations = *stage_durations;
 }
 
 }  // namespace
@@ -72,6 +81,14 @@ void DumpMetric(utils::statistics::Writer& writer, const UpdateStatistics& stats
             TimeStampToMillisecondsFromNow(stats.last_successful_update_start_time.load());
         age["last-update-duration-ms"] =
             std::chrono::duration_cast<std::chrono::milliseconds>(stats.last_update_duration.load()).count();
+
+        const auto stage_durations = [&stats] {
+            auto locked = stats.last_update_stage_durations.Lock();
+            return *locked;
+        }();
+        for (const auto& [stage, duration] : stage_durations) {
+            age["last-update-stage-duration-ms"].ValueWithLabels(duration.count(), {"stage", stage});
+        }
     }
 }
 
@@ -129,6 +146,18 @@ void UpdateStatisticsScope::IncreaseDocumentsParseFailures(std::size_t add) {
     update_stats_.documents_parse_failures += utils::statistics::Rate{add};
 }
 
+void UpdateStatisticsScope::AddStageDuration(std::string_view stage, std::chrono::steady_clock::duration duration) {
+    const auto duration_ms = std::chrono::duration_cast<std::chrono::milliseconds>(duration);
+    const auto it = std::find_if(stage_durations_.begin(), stage_durations_.end(), [stage](const auto& item) {
+        return item.first == stage;
+    });
+    if (it != stage_durations_.end()) {
+        it->second += duration_ms;
+    } else {
+        stage_durations_.emplace_back(stage, duration_ms);
+    }
+}
+
 void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
     UASSERT(new_state != impl::UpdateState::kNotFinished);
     // TODO Some production caches call Finish multiple times. We should fix those
@@ -146,6 +175,10 @@ void UpdateStatisticsScope::DoFinish(impl::UpdateState new_state) {
     }
     update_stats_.last_update_duration =
         std::chrono::duration_cast<std::chrono::milliseconds>(update_stop_time - update_start_time_);
+    {
+        auto stage_durations = update_stats_.last_update_stage_durations.Lock();
+        *stage_durations = std::move(stage_durations_);
+    }
 
     state_ = new_state;
 }
@@ -0,0 +1,63 @@
+#include <userver/cache/cache_statistics.hpp>
+
+#include <optional>
+#include <string>
+
+#include <fmt/format.h>
+
+#include <userver/utest/utest.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::string_view kStageMetric = "cache.{}.time.last-update-stage-duration-ms";
+
+std::optional<std::int64_t> GetStageDuration(
+    const cache::impl::Statistics& stats,
+    std::string_view update_type,
+    std::string stage
+) {
+    utils::statistics::Storage storage;
+    const auto holder = storage.RegisterWriter("cache", [&](utils::statistics::Writer& writer) { writer = stats; });
+    const utils::statistics::Snapshot snapshot{storage};
+    const auto metric = snapshot.SingleMetricOptional(fmt::format(kStageMetric, update_type), {{"stage", stage}});
+    if (!metric) return std::nullopt;
+    return metric->AsInt();
+}
+
+}  // namespace
+
+UTEST(CacheStatistics, StageDurations) {
+    using namespace std::chrono_literals;
+    cache::impl::Statistics stats;
+
+    {
+        cache::UpdateStatisticsScope scope(stats, cache::UpdateType::kFull);
+        scope.AddStageDuration("fetch", 5ms);
+        scope.AddStageDuration("parse", 3ms);
+        scope.AddStageDuration("fetch", 2ms);
+        scope.Finish(42);
+    }
+
+    EXPECT_EQ(GetStageDuration(stats, "full", "fetch"), 7);
+    EXPECT_EQ(GetStageDuration(stats, "full", "parse"), 3);
+    EXPECT_EQ(GetStageDuration(stats, "any", "fetch"), 7);
+    EXPECT_EQ(GetStageDuration(stats, "incremental", "fetch"), std::nullopt);
+
+    {
+        cache::UpdateStatisticsScope scope(stats, cache::UpdateType::kIncremental);
+        scope.AddStageDuration("fetch", 1ms);
+        scope.FinishNoChanges();
+    }
+
+    // "any" reports the stages of the most recent update
+    EXPECT_EQ(GetStageDuration(stats, "full", "fetch"), 7);
+    EXPECT_EQ(GetStageDuration(stats, "incremental", "fetch"), 1);
+    EXPECT_EQ(GetStageDuration(stats, "any", "fetch"), 1);
+    EXPECT_EQ(GetStageDuration(stats, "any", "parse"), std::nullopt);
+}
+
+USERVER_NAMESPACE_END
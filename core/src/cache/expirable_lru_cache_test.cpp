@@ -1,10 +1,13 @@
 #include <string>
+#include <vector>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/cache/expirable_lru_cache.hpp>
 #include <userver/dump/operations_mock.hpp>
+#include <userver/engine/single_use_event.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/mock_now.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -324,6 +327,88 @@ UTEST(ExpirableLruCache, BackgroundUpdate) {
     EXPECT_EQ(2, cache.Get(key, UpdateNever()));
 }
 
+UTEST(ExpirableLruCache, BackgroundUpdateOncePerKey) {
+    auto counter = std::make_shared<Counter>();
+
+    auto cache = CreateSimpleCache();
+    cache.SetMaxLifetime(std::chrono::seconds(3));
+    cache.SetBackgroundUpdate(cache::BackgroundUpdateMode::kEnabled);
+
+    SimpleCacheKey key = "my-key";
+
+    utils::datetime::MockNowSet(std::chrono::system_clock::now());
+    EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1)));
+
+    utils::datetime::MockSleep(std::chrono::seconds(2));
+
+    counter->Flush();
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 2)));
+    }
+    EngineYield();
+
+    EXPECT_EQ(Counter::One(), *counter);
+    EXPECT_EQ(1, cache.GetStatistics().total.background_updates.load());
+    EXPECT_EQ(2, cache.Get(key, UpdateNever()));
+}
+
+UTEST(ExpirableLruCache, RefreshAhead) {
+    auto counter = std::make_shared<Counter>();
+
+    auto cache = CreateSimpleCache();
+    cache.SetMaxLifetime(std::chrono::seconds(100));
+    cache.SetBackgroundUpdate(cache::BackgroundUpdateMode::kRefreshAhead);
+
+    SimpleCacheKey key = "my-key";
+
+    utils::datetime::MockNowSet(std::chrono::system_clock::now());
+    EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 1)));
+
+    // No updates in the first half of the lifetime
+    utils::datetime::MockSleep(std::chrono::seconds(49));
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(1, cache.Get(key, UpdateNever()));
+    }
+    EngineYield();
+
+    // A frequently read key is updated before the expiry
+    utils::datetime::MockSleep(std::chrono::seconds(50));
+    counter->Flush();
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(1, cache.Get(key, UpdateValue(counter, 2)));
+    }
+    EngineYield();
+
+    EXPECT_EQ(Counter::One(), *counter);
+    EXPECT_EQ(2, cache.Get(key, UpdateNever()));
+}
+
+UTEST_MT(ExpirableLruCache, CoalescedMisses, 4) {
+    auto cache = CreateSimpleCache();
+    SimpleCacheKey key = "my-key";
+
+    std::atomic<int> calls{0};
+    engine::SingleUseEvent release;
+    const auto update = [&](const SimpleCacheKey&) {
+        ++calls;
+        release.WaitNonCancellable();
+        return 1;
+    };
+
+    std::vector<engine::TaskWithResult<SimpleCacheValue>> tasks;
+    for (int i = 0; i < 10; ++i) {
+        tasks.push_back(utils::Async("get", [&] { return cache.Get(key, update); }));
+    }
+    engine::SleepFor(std::chrono::milliseconds{10});
+    release.Send();
+
+    for (auto& task : tasks) EXPECT_EQ(1, task.Get());
+    EXPECT_EQ(1, calls.load());
+    // The late callers may find the value in the cache
+    const auto& stats = cache.GetStatistics().total;
+    EXPECT_EQ(9, stats.coalesced_updates.load() + stats.hits.load());
+}
+
 UTEST(ExpirableLruCache, Example) {
     /// [Sample ExpirableLruCache]
     using Key = std::string;
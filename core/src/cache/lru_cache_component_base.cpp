@@ -63,6 +63,13 @@ properties:
         type: boolean
         description: enables asynchronous updates for expiring values
         defaultDescription: false
+    refresh-ahead:
+        type: boolean
+        description: |
+            with background-update, updates the expiring values with
+            a probability growing towards the expiry instead of on the first
+            read after the half of the lifetime
+        defaultDescription: false
     config-settings:
         type: boolean
         description: enables dynamic reconfiguration with CacheConfigSet
@@ -17,8 +17,16 @@ constexpr std::string_view kWays = "ways";
 constexpr std::string_view kSize = "size";
 constexpr std::string_view kLifetime = "lifetime";
 constexpr std::string_view kBackgroundUpdate = "background-update";
+constexpr std::string_view kRefreshAhead = "refresh-ahead";
 constexpr std::string_view kLifetimeMs = "lifetime-ms";
 
+template <typename ConfigValue>
+BackgroundUpdateMode ParseBackgroundUpdateMode(const ConfigValue& config) {
+    if (!config[kBackgroundUpdate].template As<bool>(false)) return BackgroundUpdateMode::kDisabled;
+    return config[kRefreshAhead].template As<bool>(false) ? BackgroundUpdateMode::kRefreshAhead
+                                                          : BackgroundUpdateMode::kEnabled;
+}
+
 }  // namespace
 
 using dump::impl::ParseMs;
@@ -26,9 +34,7 @@ using dump::impl::ParseMs;
 LruCacheConfig::LruCacheConfig(const yaml_config::YamlConfig& config)
     : size(config[kSize].As<std::size_t>()),
       lifetime(config[kLifetime].As<std::chrono::milliseconds>(0)),
-      background_update(
-          config[kBackgroundUpdate].As<bool>(false) ? BackgroundUpdateMode::kEnabled : BackgroundUpdateMode::kDisabled
-      ) {
+      background_update(ParseBackgroundUpdateMode(config)) {
     if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -38,9 +44,7 @@ LruCacheConfig::LruCacheConfig(const components::ComponentConfig& config)
 LruCacheConfig::LruCacheConfig(const formats::json::Value& value)
     : size(value[kSize].As<std::size_t>()),
       lifetime(ParseMs(value[kLifetimeMs])),
-      background_update(
-          value[kBackgroundUpdate].As<bool>(false) ? BackgroundUpdateMode::kEnabled : BackgroundUpdateMode::kDisabled
-      ) {
+      background_update(ParseBackgroundUpdateMode(value)) {
     if (size == 0) throw std::runtime_error("cache-size is non-positive");
 }
 
@@ -12,13 +12,15 @@ ExpirableLruCacheStatisticsBase::ExpirableLruCacheStatisticsBase(const Expirable
     : hits(other.hits.load()),
       misses(other.misses.load()),
       stale(other.stale.load()),
-      background_updates(other.background_updates.load()) {}
+      background_updates(other.background_updates.load()),
+      coalesced_updates(other.coalesced_updates.load()) {}
 
 void ExpirableLruCacheStatisticsBase::Reset() {
     hits = 0;
     misses = 0;
     stale = 0;
     background_updates = 0;
+    coalesced_updates = 0;
 }
 
 ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
@@ -28,6 +30,7 @@ ExpirableLruCacheStatisticsBase& ExpirableLruCacheStatisticsBase::operator+=(
     misses += other.misses.load();
     stale += other.stale.load();
     background_updates += other.background_updates.load();
+    coalesced_updates += other.coalesced_updates.load();
     return *this;
 }
 
@@ -49,11 +52,23 @@ void CacheStale(ExpirableLruCacheStatistics& stats) {
     LOG_TRACE() << "stale cache";
 }
 
+void CacheCoalesced(ExpirableLruCacheStatistics& stats) {
+    ++stats.total.coalesced_updates;
+    ++stats.recent.GetCurrentCounter().coalesced_updates;
+    LOG_TRACE() << "cache update coalesced";
+}
+
 void DumpMetric(utils::statistics::Writer& writer, const ExpirableLruCacheStatistics& stats) {
     writer["hits"] = stats.total.hits.load();
     writer["misses"] = stats.total.misses.load();
     writer["stale"] = stats.total.stale.load();
     writer["background-updates"] = stats.total.background_updates.load();
+    writer["coalesced-updates"] = stats.total.coalesced_updates.load();
+
+    const auto total_hits = stats.total.hits.load();
+    const auto total_requests = total_hits + stats.total.misses.load();
+    writer["hit_ratio"]["total"] =
+        static_cast<double>(total_hits) / static_cast<double>(total_requests ? total_requests : 1);
 
     auto s1min = stats.recent.GetStatsForPeriod();
     double s1min_hits = s1min.hits.load();
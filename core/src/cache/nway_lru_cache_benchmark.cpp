@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <utils/impl/parallelize_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::uint64_t kSize = 10'000;
+constexpr std::uint64_t kPrime = 7919;
+
+using LruCache = cache::NWayLRU<std::uint64_t, std::string>;
+using TinyLfuCache = cache::NWayLRU<
+    std::uint64_t,
+    std::string,
+    std::hash<std::uint64_t>,
+    std::equal_to<std::uint64_t>,
+    cache::CachePolicy::kTinyLFU>;
+
+}  // namespace
+
+// All the threads hit the cache, state.range(0) is the number of threads
+template <typename Cache>
+void nway_lru_get_contention(benchmark::State& state) {
+    engine::RunStandalone(state.range(0), [&] {
+        Cache cache(16, kSize / 16 * 2);
+        for (std::uint64_t i = 0; i < kSize; ++i) cache.Put(i, std::to_string(i));
+
+        RunParallelBenchmark(state, [&](auto& range) {
+            std::uint64_t i = 0;
+            for ([[maybe_unused]] auto _ : range) {
+                benchmark::DoNotOptimize(cache.Get(i++ * kPrime % kSize));
+            }
+        });
+    });
+}
+BENCHMARK_TEMPLATE(nway_lru_get_contention, LruCache)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+BENCHMARK_TEMPLATE(nway_lru_get_contention, TinyLfuCache)->Arg(1)->Arg(2)->Arg(4)->Arg(8);
+
+// Hot keys interleaved with a scan over the keys that are never requested
+// again, reports the resulting hit ratio
+template <typename Cache>
+void nway_lru_scan_hit_ratio(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        constexpr std::uint64_t kHotKeys = 1'000;
+        Cache cache(16, kHotKeys * 2 / 16);
+
+        std::uint64_t hits = 0;
+        std::uint64_t requests = 0;
+        std::uint64_t scan_key = kHotKeys;
+        for ([[maybe_unused]] auto _ : state) {
+            const auto key = (requests % 2 == 0) ? requests * kPrime % kHotKeys : scan_key++;
+            if (cache.Get(key)) {
+                ++hits;
+            } else {
+                cache.Put(key, std::to_string(key));
+            }
+            ++requests;
+        }
+        state.counters["hit_ratio"] = static_cast<double>(hits) / static_cast<double>(requests ? requests : 1);
+    });
+}
+BENCHMARK_TEMPLATE(nway_lru_scan_hit_ratio, LruCache);
+BENCHMARK_TEMPLATE(nway_lru_scan_hit_ratio, TinyLfuCache);
+
+USERVER_NAMESPACE_END
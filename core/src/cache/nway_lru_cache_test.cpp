@@ -1,6 +1,9 @@
 #include <userver/utest/utest.hpp>
 
+#include <vector>
+
 #include <userver/cache/nway_lru_cache.hpp>
+#include <userver/engine/async.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -54,6 +57,69 @@ UTEST(NWayLRU, SetMultipleWays) {
     EXPECT_EQ(1, cache.Get(1));
 }
 
+UTEST(NWayLRU, GetUpdatesUsage) {
+    Cache cache(1, 2);
+    cache.Put(1, 1);
+    cache.Put(2, 2);
+
+    // The hit is applied before the next write
+    EXPECT_EQ(1, cache.Get(1));
+    cache.Put(3, 3);
+
+    EXPECT_EQ(1, cache.Get(1));
+    EXPECT_FALSE(cache.Get(2).has_value());
+    EXPECT_EQ(3, cache.Get(3));
+}
+
+UTEST_MT(NWayLRU, ConcurrentGets, 4) {
+    Cache cache(2, 100);
+    for (int i = 0; i < 100; ++i) cache.Put(i, i);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int t = 0; t < 4; ++t) {
+        tasks.push_back(engine::AsyncNoSpan([&cache, t] {
+            for (int i = 0; i < 10'000; ++i) {
+                const auto key = (i * 7 + t) % 100;
+                if (i % 100 == 0) cache.Put(key, key);
+                const auto value = cache.Get(key);
+                if (value) EXPECT_EQ(key, *value);
+            }
+        }));
+    }
+    for (auto& task : tasks) task.Get();
+
+    EXPECT_LE(cache.GetSize(), 200);
+}
+
+UTEST(NWayLRU, TinyLfu) {
+    cache::NWayLRU<int, int, std::hash<int>, std::equal_to<int>, cache::CachePolicy::kTinyLFU> cache(1, 100);
+    for (int i = 0; i < 10; ++i) {
+        cache.Put(i, i);
+        for (int j = 0; j < 5; ++j) EXPECT_EQ(i, cache.Get(i));
+    }
+
+    for (int i = 1000; i < 1200; ++i) cache.Put(i, i);
+
+    EXPECT_EQ(100, cache.GetSize());
+    for (int i = 0; i < 10; ++i) EXPECT_EQ(i, cache.Get(i)) << i;
+
+    EXPECT_FALSE(cache.Get(0, [](int) { return false; }).has_value());
+    EXPECT_FALSE(cache.Get(0).has_value());
+}
+
+UTEST(NWayLRU, TinyLfuCountsMisses) {
+    cache::NWayLRU<int, int, std::hash<int>, std::equal_to<int>, cache::CachePolicy::kTinyLFU> cache(1, 100);
+    for (int i = 1000; i < 1100; ++i) cache.Put(i, i);
+
+    // The key is requested before it gets into the cache, so it is admitted
+    // over the keys that were only put
+    for (int i = 0; i < 5; ++i) EXPECT_FALSE(cache.Get(1).has_value());
+    cache.Put(1, 1);
+    cache.Put(2000, 2000);
+
+    EXPECT_EQ(1, cache.Get(1));
+}
+
 UTEST(NWayLRU, HashCombine) {
     for (const auto seed : std::vector<std::size_t>{0, 1, 7, 42, 100, 1000}) {
         /// @note: checking for seed used in way selection to not be equal after
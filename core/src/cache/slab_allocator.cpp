@@ -0,0 +1,261 @@
+#include <userver/cache/impl/slab_allocator.hpp>
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+namespace {
+
+constexpr std::size_t kMinChunkSize = 64;
+constexpr std::size_t kChunkAlignment = 16;
+constexpr std::size_t kOsPageSize = 4096;
+
+constexpr std::size_t RoundUp(std::size_t size, std::size_t alignment) noexcept {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+struct SizeClasses final {
+    std::array<std::size_t, 64> chunk_sizes{};
+    std::size_t count{0};
+};
+
+// 64, 80, 112, 144, ... each class is at most 5/4 of the previous one
+constexpr SizeClasses MakeSizeClasses() {
+    SizeClasses result;
+    std::size_t size = kMinChunkSize;
+    while (size < SlabAllocator::kMaxChunkSize) {
+        result.chunk_sizes[result.count++] = size;
+        size = std::max(RoundUp(size * 5 / 4, kChunkAlignment), size + kChunkAlignment);
+    }
+    result.chunk_sizes[result.count++] = SlabAllocator::kMaxChunkSize;
+    return result;
+}
+
+constexpr SizeClasses kSizeClasses = MakeSizeClasses();
+
+std::size_t GetSizeClass(std::size_t size) noexcept {
+    UASSERT(size <= SlabAllocator::kMaxChunkSize);
+    const auto* begin = kSizeClasses.chunk_sizes.data();
+    return std::lower_bound(begin, begin + kSizeClasses.count, size) - begin;
+}
+
+char* Map(std::size_t size) {
+    void* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) throw std::bad_alloc();
+    return static_cast<char*>(data);
+}
+
+// Intrusive doubly linked lists of pages and buffers
+template <typename Node>
+struct Links final {
+    Node* prev{nullptr};
+    Node* next{nullptr};
+};
+
+template <auto Member, typename Node>
+void PushFront(Node*& head, Node* node) noexcept {
+    (node->*Member).prev = nullptr;
+    (node->*Member).next = head;
+    if (head) (head->*Member).prev = node;
+    head = node;
+}
+
+template <auto Member, typename Node>
+void Remove(Node*& head, Node* node) noexcept {
+    auto& links = node->*Member;
+    if (links.prev) {
+        (links.prev->*Member).next = links.next;
+    } else {
+        UASSERT(head == node);
+        head = links.next;
+    }
+    if (links.next) (links.next->*Member).prev = links.prev;
+    links = {};
+}
+
+}  // namespace
+
+struct SlabAllocator::Page final {
+    Links<Page> all_links;
+    Links<Page> free_links;
+
+    std::size_t size_class{0};
+    std::size_t chunk_size{0};
+    std::size_t capacity{0};
+    std::size_t used{0};
+    // Chunks below this index were allocated at least once
+    std::size_t touched{0};
+
+    struct FreeChunk final {
+        FreeChunk* next;
+    };
+    FreeChunk* free_chunks{nullptr};
+
+    static constexpr std::size_t kHeaderSize = 128;
+
+    void Reset(std::size_t new_size_class) noexcept {
+        size_class = new_size_class;
+        chunk_size = kSizeClasses.chunk_sizes[new_size_class];
+        capacity = (kPageSize - kHeaderSize) / chunk_size;
+        used = 0;
+        touched = 0;
+        free_chunks = nullptr;
+    }
+
+    char* GetChunks() noexcept { return reinterpret_cast<char*>(this) + kHeaderSize; }
+};
+
+struct SlabAllocator::LargeBuffer final {
+    Links<LargeBuffer> links;
+    std::size_t mapping_size{0};
+
+    static constexpr std::size_t kHeaderSize = 64;
+
+    char* GetData() noexcept { return reinterpret_cast<char*>(this) + kHeaderSize; }
+};
+
+SlabAllocator::SlabAllocator() noexcept {
+    static_assert(sizeof(Page) <= Page::kHeaderSize);
+    static_assert(sizeof(LargeBuffer) <= LargeBuffer::kHeaderSize);
+    static_assert(kSizeClasses.count <= kSizeClassCount);
+}
+
+SlabAllocator::~SlabAllocator() {
+    while (pages_) UnmapPage(pages_);
+    while (large_buffers_) {
+        auto* buffer = large_buffers_;
+        Remove<&LargeBuffer::links>(large_buffers_, buffer);
+        ::munmap(buffer, buffer->mapping_size);
+    }
+}
+
+char* SlabAllocator::Allocate(std::size_t size, bool may_map) {
+    if (size > kMaxChunkSize) {
+        if (!may_map) return nullptr;
+        return AllocateLarge(size);
+    }
+
+    const auto size_class = GetSizeClass(size);
+    auto& free_pages = free_pages_[size_class];
+    if (!free_pages) {
+        Page* page = std::exchange(spare_page_, nullptr);
+        if (!page) {
+            if (!may_map) return nullptr;
+            page = MapPage();
+        }
+        page->Reset(size_class);
+        PushFront<&Page::free_links>(free_pages, page);
+    }
+
+    auto* page = free_pages;
+    char* chunk = nullptr;
+    if (page->free_chunks) {
+        chunk = reinterpret_cast<char*>(std::exchange(page->free_chunks, page->free_chunks->next));
+    } else {
+        UASSERT(page->touched < page->capacity);
+        chunk = page->GetChunks() + page->touched++ * page->chunk_size;
+    }
+    if (++page->used == page->capacity) Remove<&Page::free_links>(free_pages, page);
+
+    stats_.allocated_bytes += page->chunk_size;
+    stats_.requested_bytes += size;
+    ++stats_.allocations;
+    return chunk;
+}
+
+void SlabAllocator::Deallocate(char* data, std::size_t size) noexcept {
+    UASSERT(data);
+    if (size > kMaxChunkSize) {
+        DeallocateLarge(data, size);
+        return;
+    }
+
+    auto* page = reinterpret_cast<Page*>(reinterpret_cast<std::uintptr_t>(data) & ~(kPageSize - 1));
+    UASSERT(page->size_class == GetSizeClass(size));
+    auto& free_pages = free_pages_[page->size_class];
+
+    if (page->used == page->capacity) PushFront<&Page::free_links>(free_pages, page);
+    page->free_chunks = new (data) Page::FreeChunk{page->free_chunks};
+    --page->used;
+
+    stats_.allocated_bytes -= page->chunk_size;
+    stats_.requested_bytes -= size;
+    --stats_.allocations;
+
+    if (page->used == 0) {
+        Remove<&Page::free_links>(free_pages, page);
+        if (spare_page_) {
+            UnmapPage(page);
+        } else {
+            spare_page_ = page;
+        }
+    }
+}
+
+std::size_t SlabAllocator::GetAllocationSize(std::size_t size) noexcept {
+    if (size > kMaxChunkSize) return GetMappingSize(size);
+    return kSizeClasses.chunk_sizes[GetSizeClass(size)];
+}
+
+std::size_t SlabAllocator::GetMappingSize(std::size_t size) noexcept {
+    if (size > kMaxChunkSize) return RoundUp(LargeBuffer::kHeaderSize + size, kOsPageSize);
+    return kPageSize;
+}
+
+char* SlabAllocator::AllocateLarge(std::size_t size) {
+    const auto mapping_size = GetMappingSize(size);
+    auto* buffer = new (Map(mapping_size)) LargeBuffer{};
+    buffer->mapping_size = mapping_size;
+    PushFront<&LargeBuffer::links>(large_buffers_, buffer);
+
+    stats_.mapped_bytes += mapping_size;
+    stats_.allocated_bytes += mapping_size;
+    stats_.requested_bytes += size;
+    ++stats_.allocations;
+    return buffer->GetData();
+}
+
+void SlabAllocator::DeallocateLarge(char* data, std::size_t size) noexcept {
+    auto* buffer = reinterpret_cast<LargeBuffer*>(data - LargeBuffer::kHeaderSize);
+    UASSERT(buffer->mapping_size == GetMappingSize(size));
+    Remove<&LargeBuffer::links>(large_buffers_, buffer);
+
+    stats_.mapped_bytes -= buffer->mapping_size;
+    stats_.allocated_bytes -= buffer->mapping_size;
+    stats_.requested_bytes -= size;
+    --stats_.allocations;
+    ::munmap(buffer, buffer->mapping_size);
+}
+
+SlabAllocator::Page* SlabAllocator::MapPage() {
+    // Pages are aligned to their size to find the page of a chunk quickly
+    char* mapping = Map(kPageSize * 2);
+    const auto offset = RoundUp(reinterpret_cast<std::uintptr_t>(mapping), kPageSize) -
+                        reinterpret_cast<std::uintptr_t>(mapping);
+    if (offset != 0) ::munmap(mapping, offset);
+    ::munmap(mapping + offset + kPageSize, kPageSize - offset);
+
+    auto* page = new (mapping + offset) Page{};
+    PushFront<&Page::all_links>(pages_, page);
+    stats_.mapped_bytes += kPageSize;
+    return page;
+}
+
+void SlabAllocator::UnmapPage(Page* page) noexcept {
+    if (page == spare_page_) spare_page_ = nullptr;
+    Remove<&Page::all_links>(pages_, page);
+    stats_.mapped_bytes -= kPageSize;
+    ::munmap(page, kPageSize);
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,111 @@
+#include <userver/cache/impl/slab_allocator.hpp>
+
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+using cache::impl::SlabAllocator;
+
+TEST(SlabAllocator, AllocationSize) {
+    EXPECT_EQ(SlabAllocator::GetAllocationSize(0), 64);
+    EXPECT_EQ(SlabAllocator::GetAllocationSize(64), 64);
+    EXPECT_EQ(SlabAllocator::GetAllocationSize(65), 80);
+    EXPECT_EQ(SlabAllocator::GetAllocationSize(SlabAllocator::kMaxChunkSize), SlabAllocator::kMaxChunkSize);
+
+    for (std::size_t size = 1; size <= SlabAllocator::kMaxChunkSize; size += 7) {
+        const auto allocation_size = SlabAllocator::GetAllocationSize(size);
+        EXPECT_GE(allocation_size, size);
+        EXPECT_LE(allocation_size, std::max<std::size_t>(64, size * 5 / 4 + 16)) << size;
+    }
+
+    EXPECT_GE(SlabAllocator::GetAllocationSize(SlabAllocator::kMaxChunkSize + 1), SlabAllocator::kMaxChunkSize + 1);
+}
+
+TEST(SlabAllocator, AllocateDeallocate) {
+    SlabAllocator allocator;
+
+    std::vector<std::pair<char*, std::size_t>> buffers;
+    for (std::size_t size = 1; size < SlabAllocator::kMaxChunkSize * 4; size = size * 3 / 2 + 1) {
+        auto* data = allocator.Allocate(size, true);
+        ASSERT_TRUE(data);
+        std::memset(data, static_cast<int>(size % 256), size);
+        buffers.emplace_back(data, size);
+    }
+
+    const auto& stats = allocator.GetStatistics();
+    EXPECT_EQ(stats.allocations, buffers.size());
+    EXPECT_GE(stats.allocated_bytes, stats.requested_bytes);
+    EXPECT_GE(stats.mapped_bytes, stats.allocated_bytes);
+
+    for (const auto& [data, size] : buffers) {
+        for (std::size_t i = 0; i < size; ++i) ASSERT_EQ(data[i], static_cast<char>(size % 256));
+        allocator.Deallocate(data, size);
+    }
+
+    EXPECT_EQ(stats.allocations, 0);
+    EXPECT_EQ(stats.allocated_bytes, 0);
+    EXPECT_EQ(stats.requested_bytes, 0);
+    // A single empty page is kept
+    EXPECT_LE(stats.mapped_bytes, SlabAllocator::kPageSize);
+}
+
+TEST(SlabAllocator, ReusesFreeChunks) {
+    SlabAllocator allocator;
+    auto* first = allocator.Allocate(100, true);
+    auto* second = allocator.Allocate(100, true);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(allocator.GetStatistics().mapped_bytes, SlabAllocator::kPageSize);
+
+    allocator.Deallocate(first, 100);
+    EXPECT_EQ(allocator.Allocate(100, false), first);
+
+    // A full page requires mapping
+    std::vector<char*> chunks;
+    while (auto* chunk = allocator.Allocate(100, false)) chunks.push_back(chunk);
+    EXPECT_FALSE(chunks.empty());
+    EXPECT_EQ(allocator.GetStatistics().mapped_bytes, SlabAllocator::kPageSize);
+    EXPECT_TRUE(allocator.Allocate(100, true));
+    EXPECT_EQ(allocator.GetStatistics().mapped_bytes, 2 * SlabAllocator::kPageSize);
+}
+
+TEST(SlabAllocator, ReturnsEmptyPages) {
+    SlabAllocator allocator;
+    std::vector<char*> chunks;
+    for (int i = 0; i < 3; ++i) {
+        chunks.push_back(allocator.Allocate(SlabAllocator::kMaxChunkSize, true));
+        chunks.push_back(allocator.Allocate(1000, true));
+        chunks.push_back(allocator.Allocate(10000, true));
+    }
+    EXPECT_EQ(allocator.GetStatistics().mapped_bytes, 3 * SlabAllocator::kPageSize);
+
+    for (std::size_t i = 0; i < chunks.size(); i += 3) allocator.Deallocate(chunks[i], SlabAllocator::kMaxChunkSize);
+    for (std::size_t i = 1; i < chunks.size(); i += 3) allocator.Deallocate(chunks[i], 1000);
+    // One of the empty pages is kept as a spare
+    EXPECT_EQ(allocator.GetStatistics().mapped_bytes, 2 * SlabAllocator::kPageSize);
+
+    // The spare page is reused by another size class
+    EXPECT_TRUE(allocator.Allocate(50, false));
+}
+
+TEST(SlabAllocator, LargeBuffers) {
+    SlabAllocator allocator;
+    const auto size = SlabAllocator::kPageSize * 3;
+    EXPECT_FALSE(allocator.Allocate(size, false));
+
+    auto* data = allocator.Allocate(size, true);
+    ASSERT_TRUE(data);
+    std::memset(data, 'x', size);
+    EXPECT_EQ(allocator.GetStatistics().mapped_bytes, SlabAllocator::GetMappingSize(size));
+
+    allocator.Deallocate(data, size);
+    EXPECT_EQ(allocator.GetStatistics().mapped_bytes, 0);
+
+    // Leaked buffers are unmapped in the destructor
+    EXPECT_TRUE(allocator.Allocate(size, true));
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,49 @@
+#include <userver/cache/slab_cache.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+namespace {
+
+double GetUnusedRatio(std::size_t used, std::size_t total) {
+    if (total == 0) return 0;
+    return 1 - static_cast<double>(used) / static_cast<double>(total);
+}
+
+}  // namespace
+
+SlabCacheStatistics& SlabCacheStatistics::operator+=(const SlabCacheStatistics& other) {
+    entries += other.entries;
+    hits += other.hits;
+    misses += other.misses;
+    evictions += other.evictions;
+    rejected += other.rejected;
+    mapped_bytes += other.mapped_bytes;
+    allocated_bytes += other.allocated_bytes;
+    stored_bytes += other.stored_bytes;
+    return *this;
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const SlabCacheStatistics& stats) {
+    writer["current-documents-count"] = stats.entries;
+    writer["hits"] = stats.hits;
+    writer["misses"] = stats.misses;
+    writer["evictions"] = stats.evictions;
+    writer["rejected"] = stats.rejected;
+
+    if (auto memory = writer["memory"]) {
+        memory["mapped-bytes"] = stats.mapped_bytes;
+        memory["allocated-bytes"] = stats.allocated_bytes;
+        memory["stored-bytes"] = stats.stored_bytes;
+
+        // The share of the allocated memory lost to rounding up to size classes
+        memory["fragmentation"]["internal"] = GetUnusedRatio(stats.stored_bytes, stats.allocated_bytes);
+        // The share of the mapped memory in free chunks and pages
+        memory["fragmentation"]["external"] = GetUnusedRatio(stats.allocated_bytes, stats.mapped_bytes);
+    }
+}
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,151 @@
+#include <userver/utest/utest.hpp>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <userver/cache/slab_cache.hpp>
+#include <userver/dump/common_containers.hpp>
+#include <userver/engine/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using cache::impl::SlabAllocator;
+
+constexpr std::size_t kMaxBytes = 4 * SlabAllocator::kPageSize;
+
+}  // namespace
+
+UTEST(SlabBytesCache, PutGet) {
+    cache::SlabBytesCache<std::string> cache(1, kMaxBytes);
+    EXPECT_EQ(cache.Get("a"), std::nullopt);
+
+    EXPECT_TRUE(cache.Put("a", "value"));
+    EXPECT_TRUE(cache.Put("b", ""));
+    EXPECT_EQ(cache.Get("a"), "value");
+    EXPECT_EQ(cache.Get("b"), "");
+    EXPECT_EQ(cache.GetSizeApproximate(), 2);
+
+    EXPECT_TRUE(cache.Put("a", std::string(1000, 'x')));
+    EXPECT_EQ(cache.Get("a"), std::string(1000, 'x'));
+    EXPECT_EQ(cache.GetSizeApproximate(), 2);
+
+    cache.Erase("a");
+    EXPECT_EQ(cache.Get("a"), std::nullopt);
+
+    const auto stats = cache.GetStatistics();
+    EXPECT_EQ(stats.entries, 1);
+    EXPECT_EQ(stats.hits, 3);
+    EXPECT_EQ(stats.misses, 2);
+    EXPECT_EQ(stats.stored_bytes, 0);
+    EXPECT_EQ(stats.allocated_bytes, SlabAllocator::GetAllocationSize(0));
+}
+
+UTEST(SlabBytesCache, EvictsByBytes) {
+    cache::SlabBytesCache<int> cache(1, kMaxBytes);
+    const std::string value(1000, 'x');
+
+    const int count = 10 * kMaxBytes / value.size();
+    for (int i = 0; i < count; ++i) {
+        EXPECT_TRUE(cache.Put(i, value));
+        EXPECT_LE(cache.GetStatistics().mapped_bytes, kMaxBytes);
+    }
+
+    const auto stats = cache.GetStatistics();
+    EXPECT_GT(stats.evictions, 0);
+    EXPECT_EQ(stats.entries + stats.evictions, count);
+    EXPECT_EQ(stats.stored_bytes, stats.entries * value.size());
+    // Everything but the last page is filled
+    EXPECT_GE(stats.allocated_bytes, kMaxBytes - 2 * SlabAllocator::kPageSize);
+
+    // The least recently used values are evicted
+    EXPECT_EQ(cache.Get(0), std::nullopt);
+    EXPECT_EQ(cache.Get(count - 1), value);
+}
+
+UTEST(SlabBytesCache, MixedSizes) {
+    cache::SlabBytesCache<int> cache(1, kMaxBytes);
+
+    for (int i = 0; i < 10000; ++i) {
+        const auto size = static_cast<std::size_t>(i * 7919 % 50000);
+        EXPECT_TRUE(cache.Put(i, std::string(size, 'x')));
+        ASSERT_LE(cache.GetStatistics().mapped_bytes, kMaxBytes + SlabAllocator::kPageSize);
+    }
+
+    const auto value = cache.Get(9999);
+    ASSERT_TRUE(value);
+    EXPECT_EQ(value->size(), 9999 * 7919 % 50000);
+}
+
+UTEST(SlabBytesCache, Rejects) {
+    cache::SlabBytesCache<int> cache(2, kMaxBytes);
+    EXPECT_TRUE(cache.Put(1, "old"));
+    EXPECT_FALSE(cache.Put(1, std::string(kMaxBytes, 'x')));
+    EXPECT_EQ(cache.Get(1), std::nullopt);
+    EXPECT_EQ(cache.GetStatistics().rejected, 1);
+}
+
+UTEST(SlabBytesCache, SetMaxBytes) {
+    cache::SlabBytesCache<int> cache(1, kMaxBytes);
+    for (int i = 0; i < 1000; ++i) cache.Put(i, std::string(1000, 'x'));
+
+    cache.SetMaxBytes(kMaxBytes / 2);
+    EXPECT_LE(cache.GetStatistics().mapped_bytes, kMaxBytes / 2);
+    EXPECT_EQ(cache.Get(999), std::string(1000, 'x'));
+
+    cache.Clear();
+    const auto stats = cache.GetStatistics();
+    EXPECT_EQ(stats.entries, 0);
+    EXPECT_EQ(stats.allocated_bytes, 0);
+    EXPECT_LE(stats.mapped_bytes, SlabAllocator::kPageSize);
+}
+
+UTEST_MT(SlabBytesCache, Concurrent, 4) {
+    cache::SlabBytesCache<int> cache(4, 4 * kMaxBytes);
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (int task = 0; task < 4; ++task) {
+        tasks.push_back(engine::AsyncNoSpan([&cache, task] {
+            for (int i = 0; i < 1000; ++i) {
+                const int key = (task * 1000 + i) % 1500;
+                cache.Put(key, std::string(key, 'x'));
+                const auto value = cache.Get(key);
+                if (value) {
+                    EXPECT_EQ(value->size(), key);
+                }
+            }
+        }));
+    }
+    for (auto& task : tasks) task.Get();
+
+    EXPECT_EQ(cache.GetStatistics().entries, cache.GetSizeApproximate());
+}
+
+UTEST(SlabCache, Sample) {
+    /// [Sample SlabCache]
+    using Key = std::string;
+    using Value = std::map<std::string, int>;
+
+    // Stores up to 64MiB of serialized values
+    cache::SlabCache<Key, Value> cache(/*ways*/ 4, /*max_bytes*/ 64 * 1024 * 1024);
+
+    cache.Put("key", Value{{"a", 1}, {"b", 2}});
+    EXPECT_EQ(cache.Get("key"), (Value{{"a", 1}, {"b", 2}}));
+    EXPECT_EQ(cache.Get("missing"), std::nullopt);
+    /// [Sample SlabCache]
+}
+
+UTEST(SlabCache, Statistics) {
+    cache::SlabCache<int, std::string> cache(1, kMaxBytes);
+    cache.Put(1, std::string(100, 'x'));
+
+    const auto stats = cache.GetStatistics();
+    EXPECT_EQ(stats.entries, 1);
+    EXPECT_GT(stats.stored_bytes, 100);
+    EXPECT_GE(stats.allocated_bytes, stats.stored_bytes);
+    EXPECT_EQ(stats.mapped_bytes, SlabAllocator::kPageSize);
+}
+
+USERVER_NAMESPACE_END
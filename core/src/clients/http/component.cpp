@@ -124,9 +124,13 @@ HttpClient::HttpClient(const ComponentConfig& component_config, const ComponentC
     const auto thread_name_prefix = component_config["thread-name-prefix"].As<std::string>("");
     auto stats_name = "httpclient" + (thread_name_prefix.empty() ? "" : ("-" + thread_name_prefix));
     auto& storage = context.FindComponent<components::StatisticsStorage>().GetStorage();
-    statistics_holder_ = storage.RegisterWriter(std::move(stats_name), [this](utils::statistics::Writer& writer) {
-        return WriteStatistics(writer);
-    });
+    utils::statistics::TimingsMetrics timings_metrics;
+    timings_metrics.percentiles_us = component_config["timings-us"].As<bool>(false);
+    timings_metrics.histogram = component_config["timings-histogram"].As<bool>(false);
+    statistics_holder_ = storage.RegisterWriter(
+        std::move(stats_name),
+        [this, timings_metrics](utils::statistics::Writer& writer) { return WriteStatistics(writer, timings_metrics); }
+    );
 }
 
 std::vector<utils::NotNull<clients::http::Plugin*>>
@@ -151,11 +155,11 @@ void HttpClient::OnConfigUpdate(const dynamic_config::Snapshot& config) {
     http_client_.SetConfig(config[kClientConfig]);
 }
 
-void HttpClient::WriteStatistics(utils::statistics::Writer& writer) {
+void HttpClient::WriteStatistics(utils::statistics::Writer& writer, utils::statistics::TimingsMetrics timings_metrics) {
     if (!disable_pool_stats_) {
-        DumpMetric(writer, http_client_.GetPoolStatistics());
+        DumpMetric(writer, http_client_.GetPoolStatistics(), timings_metrics);
     }
-    DumpMetric(writer, http_client_.GetDestinationStatistics());
+    DumpMetric(writer, http_client_.GetDestinationStatistics(), timings_metrics);
 }
 
 yaml_config::Schema HttpClient::GetStaticConfigSchema() {
@@ -168,6 +172,14 @@ properties:
         type: boolean
         description: set to true to disable statistics for connection pool
         defaultDescription: false
+    timings-us:
+        type: boolean
+        description: set to true to add the `timings-us` percentiles of the requests in microseconds
+        defaultDescription: false
+    timings-histogram:
+        type: boolean
+        description: set to true to add the `timings-histogram` histogram of the requests in microseconds
+        defaultDescription: false
     thread-name-prefix:
         type: string
         description: set OS thread name to this value
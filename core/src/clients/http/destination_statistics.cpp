@@ -63,10 +63,16 @@ DestinationStatistics::DestinationsMap::ConstIterator DestinationStatistics::beg
 
 DestinationStatistics::DestinationsMap::ConstIterator DestinationStatistics::end() const { return rcu_map_.end(); }
 
-void DumpMetric(utils::statistics::Writer& writer, const DestinationStatistics& stats) {
+void DumpMetric(
+    utils::statistics::Writer& writer,
+    const DestinationStatistics& stats,
+    utils::statistics::TimingsMetrics timings_metrics
+) {
     for (const auto& [url, stat_ptr] : stats) {
         const InstanceStatistics instance_stat{*stat_ptr};
-        writer.ValueWithLabels(DestinationStatisticsView{instance_stat}, {{"http_destination", url}, {"version", "2"}});
+        writer.ValueWithLabels(
+            DestinationStatisticsView{instance_stat, timings_metrics}, {{"http_destination", url}, {"version", "2"}}
+        );
     }
 }
 
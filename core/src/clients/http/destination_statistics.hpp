@@ -38,7 +38,11 @@ private:
     std::atomic<size_t> current_auto_destinations_{0};
 };
 
-void DumpMetric(utils::statistics::Writer& writer, const DestinationStatistics& stats);
+void DumpMetric(
+    utils::statistics::Writer& writer,
+    const DestinationStatistics& stats,
+    utils::statistics::TimingsMetrics timings_metrics = {}
+);
 
 }  // namespace clients::http
 
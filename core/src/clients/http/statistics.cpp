@@ -55,8 +55,8 @@ void RequestStats::StoreTiming() noexcept {
     UASSERT(stats_);
     auto now = std::chrono::steady_clock::now();
     auto diff = now - start_time_;
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(diff).count();
-    stats_->timings_percentile_.GetCurrentCounter().Account(ms);
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(diff).count();
+    stats_->timings_percentile_.GetCurrentCounter().Account(us);
 }
 
 void RequestStats::StoreTimeToStart(std::chrono::microseconds micro_seconds) noexcept {
@@ -152,7 +152,7 @@ void Statistics::AccountStatus(int code) { reply_status_.Account(code); }
 void DumpMetric(utils::statistics::Writer& writer, const DestinationStatisticsView& view) {
     const auto& stats = view.stats;
 
-    writer["timings"] = stats.timings_percentile;
+    utils::statistics::DumpTimings(writer, stats.timings_percentile, view.timings_metrics);
 
     for (std::size_t i = 0; i < Statistics::kErrorGroupCount; i++) {
         const auto error_group = static_cast<Statistics::ErrorGroup>(i);
@@ -170,8 +170,9 @@ void DumpMetric(utils::statistics::Writer& writer, const DestinationStatisticsVi
     writer["sockets"]["open"] = stats.multi.socket_open;
 }
 
-void DumpMetric(utils::statistics::Writer& writer, const InstanceStatistics& stats) {
-    writer = DestinationStatisticsView{stats};
+void DumpMetric(utils::statistics::Writer& writer, const InstanceStatisticsView& view) {
+    const auto& stats = view.stats;
+    writer = DestinationStatisticsView{stats, view.timings_metrics};
 
     writer["last-time-to-start-us"] = SumToMean(stats.last_time_to_start_us, stats.instances_aggregated);
     writer["event-loop-load"][utils::statistics::DurationToString(utils::statistics::kDefaultMaxPeriod)] =
@@ -185,14 +186,22 @@ void DumpMetric(utils::statistics::Writer& writer, const InstanceStatistics& sta
         utils::statistics::Rate{stats.multi.socket_open.value - stats.multi.socket_close.value};
 }
 
-void DumpMetric(utils::statistics::Writer& writer, const PoolStatistics& stats) {
+void DumpMetric(utils::statistics::Writer& writer, const InstanceStatistics& stats) {
+    writer = InstanceStatisticsView{stats};
+}
+
+void DumpMetric(
+    utils::statistics::Writer& writer,
+    const PoolStatistics& stats,
+    utils::statistics::TimingsMetrics timings_metrics
+) {
     InstanceStatistics sum_stats;
 
     for (const auto& stat : stats.multi) {
         sum_stats += stat;
     }
 
-    writer.ValueWithLabels(sum_stats, {"version", "2"});
+    writer.ValueWithLabels(InstanceStatisticsView{sum_stats, timings_metrics}, {"version", "2"});
 }
 
 InstanceStatistics::InstanceStatistics(const Statistics& other)
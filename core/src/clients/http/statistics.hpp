@@ -6,7 +6,7 @@
 #include <vector>
 
 #include <userver/utils/datetime.hpp>
-#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/log_linear_histogram.hpp>
 #include <userver/utils/statistics/rate.hpp>
 #include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
@@ -63,11 +63,10 @@ struct MultiStats {
     }
 };
 
-using Percentile = utils::statistics::Percentile<
-    /*buckets =*/2000,
-    unsigned int,
-    /*extra_buckets=*/1180,
-    /*extra_bucket_size=*/100>;
+// Microseconds up to 134 seconds with 1.6% precision
+using Percentile = utils::statistics::LogLinearHistogram<
+    /*precision_bits=*/6,
+    /*max_value_bits=*/27>;
 
 class Statistics {
 public:
@@ -143,13 +142,25 @@ struct PoolStatistics {
 
 struct DestinationStatisticsView {
     const InstanceStatistics& stats;
+    utils::statistics::TimingsMetrics timings_metrics{};
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const DestinationStatisticsView& view);
 
+struct InstanceStatisticsView {
+    const InstanceStatistics& stats;
+    utils::statistics::TimingsMetrics timings_metrics{};
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const InstanceStatisticsView& view);
+
 void DumpMetric(utils::statistics::Writer& writer, const InstanceStatistics& stats);
 
-void DumpMetric(utils::statistics::Writer& writer, const PoolStatistics& stats);
+void DumpMetric(
+    utils::statistics::Writer& writer,
+    const PoolStatistics& stats,
+    utils::statistics::TimingsMetrics timings_metrics = {}
+);
 
 }  // namespace clients::http
 
@@ -14,7 +14,8 @@ FsCache::FsCache(const components::ComponentConfig& config, const components::Co
       client_(
           config["dir"].As<std::string>("/var/www"),
           config["update-period"].As<std::chrono::milliseconds>(0),
-          context.GetTaskProcessor(config["fs-task-processor"].As<std::string>("fs-task-processor"))
+          context.GetTaskProcessor(config["fs-task-processor"].As<std::string>("fs-task-processor")),
+          config["max-loaded-file-size"].As<std::size_t>(fs::kUnlimitedLoadedFileSize)
       ) {}
 
 yaml_config::Schema FsCache::GetStaticConfigSchema() {
@@ -36,6 +37,13 @@ properties:
         type: string
         description: task processor to do filesystem operations
         defaultDescription: fs-task-processor
+    max-loaded-file-size:
+        type: integer
+        description: |
+            files larger than that (in bytes) are not kept in memory and are
+            read from the filesystem on each request
+        defaultDescription: unlimited
+        minimum: 0
 )");
 }
 
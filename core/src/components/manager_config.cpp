@@ -111,6 +111,30 @@ properties:
                     lead to inaccuracy in coro pool size estimation.
                     local_cache_size=0 disables local cache.
                 defaultDescription: 8
+            idle_release_timeout:
+                type: string
+                description: |
+                    enables the adaptive pool size: idle coroutines above
+                    initial_size that were not needed for that long are
+                    destroyed and their stacks are returned to the OS. Lets
+                    the memory go back down after a load spike.
+                    0 disables the release.
+                defaultDescription: 0s
+            stack_memory:
+                type: string
+                description: |
+                    how the stack memory is backed. 'default' faults the pages
+                    in on first access, 'transparent-huge-pages' asks the kernel
+                    to back the stacks with huge pages (only works for
+                    stack_size of at least a huge page), 'prefaulted' faults
+                    all the stack pages in on coroutine creation, trading
+                    memory for fewer page faults. Stack usage monitor can not
+                    observe prefaulted stacks.
+                defaultDescription: default
+                enum:
+                  - default
+                  - transparent-huge-pages
+                  - prefaulted
     event_thread_pool:
         type: object
         description: event thread pool options
@@ -121,6 +145,27 @@ properties:
                 description: >
                     number of threads to process low level IO system calls
                     (number of ev loops to start in libev)
+            io_uring_enabled:
+                type: boolean
+                description: |
+                    whether to perform socket and pipe I/O through io_uring
+                    submitted right from the coroutines instead of waiting for
+                    readiness via libev. Falls back to libev if the kernel
+                    does not support io_uring (Linux 5.6+ is required)
+                defaultDescription: false
+            io_uring_entries:
+                type: integer
+                description: size of the io_uring submission queue of each ev thread
+                defaultDescription: 1024
+            cpu_affinity:
+                type: string
+                description: |
+                    CPU list in the Linux 'cpulist' format (e.g. `0-3,48-51`),
+                    ev thread #i is pinned to the i-th CPU of the list
+                    (round-robin). Sockets are then served by ev threads on
+                    the NUMA node of the task processor worker that created
+                    them, if there are any.
+                defaultDescription: no pinning
     components:
         type: object
         description: 'dictionary of "component name": "options"'
@@ -173,6 +218,23 @@ properties:
                     enum:
                       - global-task-queue
                       - work-stealing-task-queue
+                cpu-affinity:
+                    type: string
+                    description: |
+                        CPU list in the Linux 'cpulist' format (e.g. `0-23,48-71`),
+                        worker thread #i is pinned to the i-th CPU of the list
+                        (round-robin). With `work-stealing-task-queue` workers
+                        steal from the workers on the same NUMA node first.
+                        Coroutine stacks are reused on the NUMA node they
+                        were last run on.
+                    defaultDescription: no pinning
+                resource-usage-accounting:
+                    type: boolean
+                    description: |
+                        whether to account the CPU time and the heap memory
+                        (with jemalloc) consumed by each task, see
+                        engine::TaskResourceUsage
+                    defaultDescription: false
                 task-trace:
                     type: object
                     description: .
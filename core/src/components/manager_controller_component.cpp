@@ -46,6 +46,18 @@ void DumpMetric(utils::statistics::Writer& writer, const engine::TaskProcessor&
         context_switch["no_overloaded"] = counter.GetTasksNoOverloadSensor().value;
     }
 
+    if (auto queue_wait_time = writer["queue-wait-time"]) {
+        queue_wait_time.ValueWithLabels(
+            task_processor.GetQueueWaitTimeHistogram(Task::Priority::kCritical), {{"task_priority", "critical"}}
+        );
+        queue_wait_time.ValueWithLabels(
+            task_processor.GetQueueWaitTimeHistogram(Task::Priority::kNormal), {{"task_priority", "normal"}}
+        );
+        queue_wait_time.ValueWithLabels(
+            task_processor.GetQueueWaitTimeHistogram(Task::Priority::kBackground), {{"task_priority", "background"}}
+        );
+    }
+
     writer["worker-threads"] = task_processor.GetWorkerCount();
 }
 
@@ -98,7 +110,10 @@ void ManagerControllerComponent::WriteStatistics(utils::statistics::Writer& writ
         if (auto coro_stats = coro_pool["coroutines"]) {
             coro_stats["active"] = stats.active_coroutines;
             coro_stats["total"] = stats.total_coroutines;
+            coro_stats["created"] = utils::statistics::Rate{stats.created_coroutines};
+            coro_stats["destroyed"] = utils::statistics::Rate{stats.destroyed_coroutines};
         }
+        coro_pool["stacks"]["resident-bytes"] = stats.stacks_resident_bytes;
         if (auto stack_usage_stats = coro_pool["stack-usage"]) {
             stack_usage_stats["max-usage-percent"] = stats.max_stack_usage_pct;
             stack_usage_stats["is-monitor-active"] = stats.is_stack_usage_monitor_active;
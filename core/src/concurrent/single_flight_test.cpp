@@ -0,0 +1,184 @@
+#include <userver/utest/utest.hpp>
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <userver/concurrent/single_flight.hpp>
+#include <userver/engine/single_use_event.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utils/async.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+UTEST(SingleFlight, Execute) {
+    concurrent::SingleFlight<std::string, int> single_flight;
+    EXPECT_EQ(single_flight.Execute("key", [] { return 42; }), 42);
+    EXPECT_FALSE(single_flight.IsInFlight("key"));
+
+    // The completed calls are not cached
+    EXPECT_EQ(single_flight.Execute("key", [] { return 43; }), 43);
+}
+
+UTEST_MT(SingleFlight, Coalesce, 4) {
+    concurrent::SingleFlight<std::string, int> single_flight;
+    std::atomic<int> calls{0};
+    engine::SingleUseEvent release;
+
+    auto leader = utils::Async("leader", [&] {
+        return single_flight.Execute("key", [&] {
+            ++calls;
+            release.WaitNonCancellable();
+            return 42;
+        });
+    });
+    while (!single_flight.IsInFlight("key")) engine::Yield();
+
+    std::vector<engine::TaskWithResult<int>> followers;
+    for (int i = 0; i < 8; ++i) {
+        followers.push_back(utils::Async("follower", [&] {
+            return single_flight.Execute("key", [&] {
+                ++calls;
+                return 0;
+            });
+        }));
+    }
+    engine::SleepFor(std::chrono::milliseconds{10});
+    release.Send();
+
+    EXPECT_EQ(leader.Get(), 42);
+    for (auto& follower : followers) EXPECT_EQ(follower.Get(), 42);
+    EXPECT_EQ(calls.load(), 1);
+    EXPECT_FALSE(single_flight.IsInFlight("key"));
+}
+
+UTEST(SingleFlight, Exception) {
+    concurrent::SingleFlight<std::string, int> single_flight;
+    engine::SingleUseEvent release;
+
+    auto leader = utils::Async("leader", [&] {
+        return single_flight.Execute("key", [&]() -> int {
+            release.WaitNonCancellable();
+            throw std::runtime_error("failure");
+        });
+    });
+    while (!single_flight.IsInFlight("key")) engine::Yield();
+
+    auto follower = utils::Async("follower", [&] { return single_flight.Execute("key", [] { return 0; }); });
+    engine::Yield();
+    release.Send();
+
+    UEXPECT_THROW(leader.Get(), std::runtime_error);
+    UEXPECT_THROW(follower.Get(), std::runtime_error);
+
+    // A failed call is not remembered
+    EXPECT_EQ(single_flight.Execute("key", [] { return 42; }), 42);
+}
+
+UTEST(SingleFlight, TryLead) {
+    concurrent::SingleFlight<std::string, int> single_flight;
+
+    auto leader = single_flight.TryLead("key");
+    ASSERT_TRUE(leader);
+    EXPECT_TRUE(single_flight.IsInFlight("key"));
+    EXPECT_FALSE(single_flight.TryLead("key"));
+
+    auto follower = utils::Async("follower", [&] { return single_flight.Execute("key", [] { return 0; }); });
+    auto background = utils::Async("background", [leader = std::move(*leader)]() mutable {
+        return leader.Run([] { return 42; });
+    });
+
+    EXPECT_EQ(background.Get(), 42);
+    EXPECT_EQ(follower.Get(), 42);
+    EXPECT_FALSE(single_flight.IsInFlight("key"));
+}
+
+UTEST(SingleFlight, AbandonedLeader) {
+    concurrent::SingleFlight<std::string, int> single_flight;
+
+    auto leader = single_flight.TryLead("key");
+    ASSERT_TRUE(leader);
+    auto follower = utils::Async("follower", [&] { return single_flight.Execute("key", [] { return 0; }); });
+    engine::Yield();
+
+    // The follower takes the call over
+    leader.reset();
+    EXPECT_EQ(follower.Get(), 0);
+    EXPECT_FALSE(single_flight.IsInFlight("key"));
+}
+
+UTEST_MT(SingleFlight, CancelledLeader, 2) {
+    concurrent::SingleFlight<std::string, int> single_flight;
+    std::atomic<int> calls{0};
+
+    auto leader = utils::Async("leader", [&] {
+        return single_flight.Execute("key", [&] {
+            ++calls;
+            engine::InterruptibleSleepFor(std::chrono::hours{1});
+            engine::current_task::CancellationPoint();
+            return 1;
+        });
+    });
+    while (!single_flight.IsInFlight("key")) engine::Yield();
+
+    std::vector<engine::TaskWithResult<int>> followers;
+    for (int i = 0; i < 4; ++i) {
+        followers.push_back(utils::Async("follower", [&] {
+            return single_flight.Execute("key", [&] {
+                ++calls;
+                return 2;
+            });
+        }));
+    }
+    engine::SleepFor(std::chrono::milliseconds{10});
+
+    // The waiters do not get the exception caused by the cancellation
+    leader.RequestCancel();
+    UEXPECT_THROW(leader.Get(), engine::TaskCancelledException);
+    for (auto& follower : followers) EXPECT_EQ(follower.Get(), 2);
+    EXPECT_EQ(calls.load(), 2);
+    EXPECT_FALSE(single_flight.IsInFlight("key"));
+}
+
+UTEST(SingleFlight, KeysDoNotBlockEachOther) {
+    // A single way, so that both keys share the index
+    concurrent::SingleFlight<int, int> single_flight{1};
+    engine::SingleUseEvent release;
+
+    auto leader = utils::Async("leader", [&] {
+        return single_flight.Execute(1, [&] {
+            release.WaitNonCancellable();
+            return 1;
+        });
+    });
+    while (!single_flight.IsInFlight(1)) engine::Yield();
+
+    EXPECT_EQ(single_flight.Execute(2, [] { return 2; }), 2);
+
+    release.Send();
+    EXPECT_EQ(leader.Get(), 1);
+}
+
+UTEST(SingleFlight, CancelledWaiter) {
+    concurrent::SingleFlight<int, int> single_flight;
+    engine::SingleUseEvent release;
+
+    auto leader = utils::Async("leader", [&] {
+        return single_flight.Execute(1, [&] {
+            release.WaitNonCancellable();
+            return 1;
+        });
+    });
+    while (!single_flight.IsInFlight(1)) engine::Yield();
+
+    auto follower = utils::Async("follower", [&] { return single_flight.Execute(1, [] { return 0; }); });
+    engine::Yield();
+    follower.RequestCancel();
+    UEXPECT_THROW(follower.Get(), engine::WaitInterruptedException);
+
+    release.Send();
+    EXPECT_EQ(leader.Get(), 1);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,52 @@
+#include <userver/dump/chunked.hpp>
+
+#include <fmt/format.h>
+
+#include <engine/task/task_processor.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/unsafe.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump::impl {
+
+namespace {
+
+// Smaller chunks are not worth a separate task
+constexpr std::size_t kMinChunkSize = 1024;
+
+// Protects from spawning a task per garbage "chunk" of a corrupted dump
+constexpr std::size_t kMaxChunkCount = 1024;
+
+}  // namespace
+
+std::size_t GetChunkCount(std::size_t size, engine::TaskProcessor& task_processor) {
+    const auto max_chunks = std::clamp<std::size_t>(task_processor.GetWorkerCount(), 1, kMaxChunkCount);
+    return std::clamp<std::size_t>(size / kMinChunkSize, 1, max_chunks);
+}
+
+void WriteChunks(Writer& writer, const std::vector<std::string>& chunks) {
+    writer.Write(chunks.size());
+    for (const auto& chunk : chunks) writer.Write(chunk.size());
+    for (const auto& chunk : chunks) WriteStringViewUnsafe(writer, chunk);
+}
+
+std::vector<std::string> ReadChunks(Reader& reader) {
+    const auto chunk_count = reader.Read<std::size_t>();
+    if (chunk_count > kMaxChunkCount) {
+        throw Error(fmt::format("Invalid dump chunk count: chunk-count={}, max={}", chunk_count, kMaxChunkCount));
+    }
+
+    std::vector<std::size_t> sizes;
+    sizes.reserve(chunk_count);
+    for (std::size_t i = 0; i < chunk_count; ++i) sizes.push_back(reader.Read<std::size_t>());
+
+    std::vector<std::string> chunks;
+    chunks.reserve(chunk_count);
+    for (const auto size : sizes) chunks.emplace_back(ReadStringViewUnsafe(reader, size));
+    return chunks;
+}
+
+}  // namespace dump::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include <userver/dump/chunked.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/engine/run_standalone.hpp>
+#include <userver/engine/task/current_task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = std::unordered_map<std::uint64_t, std::string>;
+
+Map MakeMap(std::size_t size) {
+    Map map;
+    map.reserve(size);
+    for (std::uint64_t i = 0; i < size; ++i) map.emplace(i, std::string(32, 'a') + std::to_string(i));
+    return map;
+}
+
+}  // namespace
+
+// state.range(0) is the number of threads, 0 stands for the plain Write
+void dump_chunked_write(benchmark::State& state) {
+    engine::RunStandalone(std::max<std::size_t>(state.range(0), 1), [&] {
+        const auto map = MakeMap(1'000'000);
+
+        for ([[maybe_unused]] auto _ : state) {
+            dump::impl::BufferWriter writer;
+            if (state.range(0) == 0) {
+                writer.Write(map);
+            } else {
+                dump::WriteChunked(writer, map, engine::current_task::GetTaskProcessor());
+            }
+            benchmark::DoNotOptimize(std::move(writer).Extract());
+        }
+    });
+}
+BENCHMARK(dump_chunked_write)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond);
+
+void dump_chunked_read(benchmark::State& state) {
+    engine::RunStandalone(std::max<std::size_t>(state.range(0), 1), [&] {
+        dump::impl::BufferWriter writer;
+        if (state.range(0) == 0) {
+            writer.Write(MakeMap(1'000'000));
+        } else {
+            dump::WriteChunked(writer, MakeMap(1'000'000), engine::current_task::GetTaskProcessor());
+        }
+        const auto data = std::move(writer).Extract();
+
+        for ([[maybe_unused]] auto _ : state) {
+            dump::impl::BufferReader reader(data);
+            if (state.range(0) == 0) {
+                benchmark::DoNotOptimize(reader.Read<Map>());
+            } else {
+                benchmark::DoNotOptimize(dump::ReadChunked<Map>(reader, engine::current_task::GetTaskProcessor()));
+            }
+        }
+    });
+}
+BENCHMARK(dump_chunked_read)->Arg(0)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,107 @@
+#include <userver/dump/chunked.hpp>
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_mock.hpp>
+#include <userver/engine/task/current_task.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kThreads = 4;
+
+template <typename T>
+std::string WriteChunked(const T& value) {
+    dump::MockWriter writer;
+    dump::WriteChunked(writer, value, engine::current_task::GetTaskProcessor());
+    writer.Finish();
+    return std::move(writer).Extract();
+}
+
+template <typename T>
+T ReadChunked(std::string data) {
+    dump::MockReader reader(std::move(data));
+    auto result = dump::ReadChunked<T>(reader, engine::current_task::GetTaskProcessor());
+    reader.Finish();
+    return result;
+}
+
+std::size_t GetChunkCount(std::string data) {
+    dump::MockReader reader(std::move(data));
+    return reader.Read<std::size_t>();
+}
+
+}  // namespace
+
+UTEST_MT(DumpChunked, UnorderedMap, kThreads) {
+    std::unordered_map<int, std::string> map;
+    for (int i = 0; i < 100'000; ++i) map.emplace(i, std::to_string(i));
+
+    const auto data = WriteChunked(map);
+    EXPECT_EQ(GetChunkCount(data), kThreads);
+    EXPECT_EQ(ReadChunked<decltype(map)>(data), map);
+}
+
+UTEST_MT(DumpChunked, VectorKeepsOrder, kThreads) {
+    std::vector<std::string> vector;
+    for (int i = 0; i < 10'000; ++i) vector.push_back(std::to_string(i));
+
+    EXPECT_EQ(ReadChunked<decltype(vector)>(WriteChunked(vector)), vector);
+}
+
+UTEST_MT(DumpChunked, NodeContainers, kThreads) {
+    std::map<int, int> map;
+    std::unordered_set<int> set;
+    for (int i = 0; i < 10'000; ++i) {
+        map.emplace(i, -i);
+        set.insert(i);
+    }
+
+    EXPECT_EQ(ReadChunked<decltype(map)>(WriteChunked(map)), map);
+    EXPECT_EQ(ReadChunked<decltype(set)>(WriteChunked(set)), set);
+}
+
+UTEST_MT(DumpChunked, SmallContainers, kThreads) {
+    const std::vector<int> empty;
+    const auto empty_data = WriteChunked(empty);
+    EXPECT_EQ(GetChunkCount(empty_data), 1);
+    EXPECT_EQ(ReadChunked<std::vector<int>>(empty_data), empty);
+
+    const std::vector<int> small{1, 2, 3};
+    const auto small_data = WriteChunked(small);
+    EXPECT_EQ(GetChunkCount(small_data), 1);
+    EXPECT_EQ(ReadChunked<std::vector<int>>(small_data), small);
+}
+
+UTEST(DumpChunked, SingleThread) {
+    const std::vector<int> vector(10'000, 42);
+    const auto data = WriteChunked(vector);
+    EXPECT_EQ(GetChunkCount(data), 1);
+
+    EXPECT_EQ(ReadChunked<std::vector<int>>(data), vector);
+}
+
+UTEST(DumpChunked, InvalidChunkCount) {
+    dump::MockWriter writer;
+    writer.Write(std::size_t{1'000'000});
+    UEXPECT_THROW(ReadChunked<std::vector<int>>(std::move(writer).Extract()), dump::Error);
+}
+
+UTEST(DumpChunked, ExtraDataInChunk) {
+    dump::MockWriter writer;
+    writer.Write(std::size_t{1});
+    writer.Write(std::size_t{3});
+    writer.Write(std::size_t{1});
+    writer.Write(42);
+    writer.Write(42);
+    UEXPECT_THROW(ReadChunked<std::vector<int>>(std::move(writer).Extract()), dump::Error);
+}
+
+USERVER_NAMESPACE_END
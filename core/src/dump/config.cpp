@@ -18,10 +18,25 @@ constexpr std::string_view kDumpFormatVersion = "format-version";
 constexpr std::string_view kMaxDumpCount = "max-count";
 constexpr std::string_view kWorldReadable = "world-readable";
 constexpr std::string_view kEncrypted = "encrypted";
+constexpr std::string_view kMapped = "mapped";
+constexpr std::string_view kMappedBackgroundValidation = "mapped-background-validation";
+constexpr std::string_view kCompressed = "compressed";
+constexpr std::string_view kCompressionLevel = "compression-level";
+constexpr std::string_view kCompressionLongDistanceMatching = "compression-long-distance-matching";
 
 constexpr auto kDefaultFsTaskProcessor = std::string_view{"fs-task-processor"};
 constexpr auto kDefaultMaxDumpCount = uint64_t{1};
 
+std::optional<compression::zstd::CompressionSettings> ParseCompression(const yaml_config::YamlConfig& config) {
+    if (!config[kCompressed].As<bool>(false)) return std::nullopt;
+
+    compression::zstd::CompressionSettings settings;
+    settings.level = config[kCompressionLevel].As<int>(settings.level);
+    settings.long_distance_matching =
+        config[kCompressionLongDistanceMatching].As<bool>(settings.long_distance_matching);
+    return settings;
+}
+
 }  // namespace
 
 namespace impl {
@@ -61,6 +76,9 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config, std::str
       max_dump_age(config[kMaxDumpAge].As<std::optional<std::chrono::milliseconds>>()),
       max_dump_age_set(config.HasMember(kMaxDumpAge)),
       dump_is_encrypted(config[kEncrypted].As<bool>(false)),
+      dump_is_mapped(config[kMapped].As<bool>(false)),
+      mapped_background_validation(config[kMappedBackgroundValidation].As<bool>(true)),
+      dump_compression(ParseCompression(config)),
       static_dumps_enabled(config[kDumpsEnabled].As<bool>()),
       static_min_dump_interval(config[kMinDumpInterval].As<std::chrono::milliseconds>(0)) {
     if (max_dump_age && *max_dump_age <= std::chrono::milliseconds::zero()) {
@@ -69,6 +87,12 @@ Config::Config(std::string name, const yaml_config::YamlConfig& config, std::str
     if (max_dump_count == 0) {
         throw std::logic_error(fmt::format("{}: {} must not be 0", this->name, kMaxDumpCount));
     }
+    if (dump_is_encrypted && dump_is_mapped) {
+        throw std::logic_error(fmt::format("{}: {} and {} dumps are not compatible", this->name, kEncrypted, kMapped));
+    }
+    if (dump_compression && dump_is_mapped) {
+        throw std::logic_error(fmt::format("{}: {} and {} dumps are not compatible", this->name, kCompressed, kMapped));
+    }
 }
 
 DynamicConfig::DynamicConfig(const Config& config, ConfigPatch&& patch)
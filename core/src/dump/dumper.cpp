@@ -1,5 +1,7 @@
 #include <userver/dump/dumper.hpp>
 
+#include <functional>
+
 #include <fmt/format.h>
 #include <boost/filesystem/operations.hpp>
 
@@ -32,6 +34,7 @@
 #include <userver/components/dump_configurator.hpp>
 #include <userver/dump/config.hpp>
 #include <userver/dump/factory.hpp>
+#include <userver/dump/operations_mapped.hpp>
 #include <userver/testsuite/dump_control.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -163,6 +166,7 @@ private:
 
     // Must go after all the fields it uses.
     engine::TaskWithResult<void> periodic_task_;
+    engine::TaskWithResult<void> mapped_validation_task_;
 
     utils::statistics::Entry statistics_holder_;
     concurrent::AsyncEventSubscriberScope config_subscription_;
@@ -399,6 +403,9 @@ void Dumper::Impl::CancelWriteTaskAndWait() noexcept {
     if (periodic_task_.IsValid()) {
         periodic_task_.SyncCancel();
     }
+    if (mapped_validation_task_.IsValid()) {
+        mapped_validation_task_.SyncCancel();
+    }
 }
 
 void Dumper::Impl::DoWriteDump(TimePoint update_time, tracing::ScopeTime& scope, DumpData& dump_data) {
@@ -429,6 +436,8 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(DumpData& dump_data, const D
     }
 
     const auto load_start = std::chrono::steady_clock::now();
+    std::string loaded_path;
+    std::function<void()> mapped_validation;
 
     const std::optional<TimePoint> update_time =
         utils::CriticalAsync(fs_task_processor_, read_span_name_, [&] {
@@ -442,6 +451,12 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(DumpData& dump_data, const D
                 dump_data.dumpable.ReadAndSet(*reader);
                 reader->Finish();
 
+                const auto* mapped_reader = dynamic_cast<const MappedFileReader*>(reader.get());
+                if (mapped_reader && static_config_.mapped_background_validation) {
+                    loaded_path = dump_stats->full_path;
+                    mapped_validation = mapped_reader->MakeDeferredValidation();
+                }
+
                 LOG_INFO() << Name() << ": a dump has been loaded successfully";
                 return std::optional{dump_stats->update_time};
             } catch (const std::exception& ex) {
@@ -453,6 +468,24 @@ std::optional<TimePoint> Dumper::Impl::LoadFromDump(DumpData& dump_data, const D
     if (!update_time) return {};
     const UpdateTime update_times{*update_time, *update_time};
 
+    if (mapped_validation) {
+        mapped_validation_task_ = utils::CriticalAsync(
+            fs_task_processor_,
+            "validate-dump/" + Name(),
+            [this, path = std::move(loaded_path), validate = std::move(mapped_validation)] {
+                try {
+                    validate();
+                } catch (const std::exception& ex) {
+                    // The data is already in use, at least do not load it again
+                    LOG_ERROR() << Name() << ": the loaded dump is corrupted, removing \"" << path
+                                << "\". Reason: " << ex;
+                    boost::system::error_code error;
+                    boost::filesystem::remove(path, error);
+                }
+            }
+        );
+    }
+
     {
         auto update_data = update_data_.Lock();
         update_data->update_time = update_times;
@@ -564,6 +597,26 @@ properties:
                 type: boolean
                 description: Whether to encrypt the dump
                 defaultDescription: false
+            mapped:
+                type: boolean
+                description: Whether to write the dump in the memory-mapped format, see dump::MappedFileReader
+                defaultDescription: false
+            mapped-background-validation:
+                type: boolean
+                description: Whether to validate the in-place data of a loaded memory-mapped dump in background
+                defaultDescription: true
+            compressed:
+                type: boolean
+                description: Whether to compress the dump with zstd
+                defaultDescription: false
+            compression-level:
+                type: integer
+                description: zstd compression level, from 1 to 22; negative levels are faster
+                defaultDescription: 3
+            compression-long-distance-matching:
+                type: boolean
+                description: Whether to enable zstd long distance matching, uses a 128MiB window
+                defaultDescription: false
 )");
 }
 
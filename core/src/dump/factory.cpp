@@ -1,8 +1,10 @@
 #include <userver/dump/factory.hpp>
 
 #include <dump/secdist.hpp>
+#include <userver/dump/operations_compressed.hpp>
 #include <userver/dump/operations_encrypted.hpp>
 #include <userver/dump/operations_file.hpp>
+#include <userver/dump/operations_mapped.hpp>
 #include <userver/storages/secdist/component.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -19,6 +21,49 @@ boost::filesystem::perms GetPerms(const Config& config) {
         return perms::owner_read;
 }
 
+std::unique_ptr<dump::OperationsFactory>
+WithCompression(std::unique_ptr<dump::OperationsFactory> factory, const Config& config) {
+    if (!config.dump_compression) return factory;
+    return std::make_unique<dump::CompressedOperationsFactory>(std::move(factory), *config.dump_compression);
+}
+
+// The memory-mapped dumps are detected by the file magic, so toggling
+// `mapped` does not make the existing dumps unreadable
+class DetectMappedDumps final : public dump::OperationsFactory {
+public:
+    DetectMappedDumps(
+        std::unique_ptr<dump::OperationsFactory> writer_factory,
+        std::unique_ptr<dump::OperationsFactory> other_formats_factory
+    )
+        : writer_factory_(std::move(writer_factory)), other_formats_factory_(std::move(other_formats_factory)) {}
+
+    std::unique_ptr<dump::Reader> CreateReader(std::string full_path) override {
+        if (dump::IsMappedDumpFile(full_path)) return std::make_unique<dump::MappedFileReader>(std::move(full_path));
+        auto& factory = other_formats_factory_ ? *other_formats_factory_ : *writer_factory_;
+        return factory.CreateReader(std::move(full_path));
+    }
+
+    std::unique_ptr<dump::Writer> CreateWriter(std::string full_path, tracing::ScopeTime& scope) override {
+        return writer_factory_->CreateWriter(std::move(full_path), scope);
+    }
+
+private:
+    const std::unique_ptr<dump::OperationsFactory> writer_factory_;
+    // Reads the dumps that are not memory-mapped, `writer_factory_` if null
+    const std::unique_ptr<dump::OperationsFactory> other_formats_factory_;
+};
+
+std::unique_ptr<dump::OperationsFactory> CreateFileOperationsFactory(const Config& config) {
+    auto dump_perms = GetPerms(config);
+    auto file_factory = WithCompression(std::make_unique<dump::FileOperationsFactory>(dump_perms), config);
+    if (config.dump_is_mapped) {
+        return std::make_unique<DetectMappedDumps>(
+            std::make_unique<dump::MappedFileOperationsFactory>(dump_perms), std::move(file_factory)
+        );
+    }
+    return std::make_unique<DetectMappedDumps>(std::move(file_factory), nullptr);
+}
+
 }  // namespace
 
 std::unique_ptr<dump::OperationsFactory>
@@ -28,15 +73,16 @@ CreateOperationsFactory(const Config& config, const components::ComponentContext
     if (config.dump_is_encrypted) {
         const auto& secdist = context.FindComponent<components::Secdist>().Get();
         auto secret_key = secdist.Get<dump::Secdist>().GetSecretKey(config.name);
-        return std::make_unique<dump::EncryptedOperationsFactory>(std::move(secret_key), dump_perms);
+        return WithCompression(
+            std::make_unique<dump::EncryptedOperationsFactory>(std::move(secret_key), dump_perms), config
+        );
     } else {
-        return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+        return CreateFileOperationsFactory(config);
     }
 }
 
 std::unique_ptr<dump::OperationsFactory> CreateDefaultOperationsFactory(const Config& config) {
-    auto dump_perms = GetPerms(config);
-    return std::make_unique<dump::FileOperationsFactory>(dump_perms);
+    return CreateFileOperationsFactory(config);
 }
 
 }  // namespace dump
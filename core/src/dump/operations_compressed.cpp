@@ -0,0 +1,154 @@
+#include <userver/dump/operations_compressed.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/dump/unsafe.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace {
+
+// Small writes are batched, so that zstd is called for large blocks
+constexpr std::size_t kInputBlockSize = 128 * 1024;
+
+// The compressed data is read from the inner reader in blocks of this size
+constexpr std::size_t kReadBlockSize = 128 * 1024;
+
+// The data is decompressed in portions of at least this size
+constexpr std::size_t kOutputBlockSize = 128 * 1024;
+
+}  // namespace
+
+CompressedWriter::CompressedWriter(
+    std::unique_ptr<Writer> inner,
+    const compression::zstd::CompressionSettings& settings
+)
+    : inner_(std::move(inner)), compressor_(settings) {
+    UASSERT(inner_);
+    input_.reserve(kInputBlockSize);
+}
+
+void CompressedWriter::WriteRaw(std::string_view data) {
+    if (input_.size() + data.size() < kInputBlockSize) {
+        input_.append(data);
+        return;
+    }
+
+    Compress(input_);
+    input_.clear();
+    Compress(data);
+    Flush();
+}
+
+void CompressedWriter::Compress(std::string_view data) {
+    try {
+        compressor_.Compress(data, output_);
+    } catch (const std::exception& ex) {
+        throw Error(fmt::format("Failed to compress the dump: {}", ex.what()));
+    }
+}
+
+void CompressedWriter::Flush() {
+    if (output_.empty()) return;
+    WriteStringViewUnsafe(*inner_, output_);
+    output_.clear();
+}
+
+void CompressedWriter::Finish() {
+    Compress(input_);
+    input_.clear();
+    try {
+        compressor_.Finish(output_);
+    } catch (const std::exception& ex) {
+        throw Error(fmt::format("Failed to compress the dump: {}", ex.what()));
+    }
+    Flush();
+
+    inner_->Finish();
+}
+
+CompressedReader::CompressedReader(std::unique_ptr<Reader> inner) : inner_(std::move(inner)) { UASSERT(inner_); }
+
+std::string_view CompressedReader::ReadRaw(std::size_t max_size) {
+    if (buffer_size_ - position_ < max_size) Fill(max_size);
+
+    const auto size = std::min(max_size, buffer_size_ - position_);
+    const std::string_view result{buffer_.get() + position_, size};
+    position_ += size;
+    return result;
+}
+
+void CompressedReader::Fill(std::size_t min_size) {
+    // The buffer is allocated once for the largest read and is not
+    // zero-filled, the data is decompressed right after the unread part
+    const auto unread_size = buffer_size_ - position_;
+    const auto capacity = std::max(min_size, kOutputBlockSize);
+    if (capacity > buffer_capacity_) {
+        std::unique_ptr<char[]> new_buffer{new char[capacity]};
+        if (unread_size != 0) std::memcpy(new_buffer.get(), buffer_.get() + position_, unread_size);
+        buffer_ = std::move(new_buffer);
+        buffer_capacity_ = capacity;
+    } else if (unread_size != 0) {
+        std::memmove(buffer_.get(), buffer_.get() + position_, unread_size);
+    }
+    buffer_size_ = unread_size;
+    position_ = 0;
+
+    while (buffer_size_ < min_size) {
+        if (input_.empty() && !is_input_finished_) {
+            input_ = ReadUnsafeAtMost(*inner_, kReadBlockSize);
+            is_input_finished_ = input_.empty();
+        }
+
+        std::size_t written = 0;
+        try {
+            written = decompressor_.Decompress(input_, buffer_.get() + buffer_size_, buffer_capacity_ - buffer_size_);
+        } catch (const std::exception& ex) {
+            throw Error(fmt::format("Failed to decompress the dump: {}", ex.what()));
+        }
+        buffer_size_ += written;
+
+        if (written == 0 && input_.empty() && is_input_finished_) break;
+    }
+}
+
+void CompressedReader::Finish() {
+    Fill(1);
+    if (buffer_size_ != position_) {
+        throw Error(fmt::format(
+            "Unexpected extra data at the end of the compressed dump: unread-size={}", buffer_size_ - position_
+        ));
+    }
+    if (!decompressor_.IsFrameComplete()) {
+        throw Error("The compressed dump is truncated");
+    }
+
+    inner_->Finish();
+}
+
+CompressedOperationsFactory::CompressedOperationsFactory(
+    std::unique_ptr<OperationsFactory> inner,
+    compression::zstd::CompressionSettings settings
+)
+    : inner_(std::move(inner)), settings_(std::move(settings)) {
+    UASSERT(inner_);
+}
+
+std::unique_ptr<Reader> CompressedOperationsFactory::CreateReader(std::string full_path) {
+    return std::make_unique<CompressedReader>(inner_->CreateReader(std::move(full_path)));
+}
+
+std::unique_ptr<Writer> CompressedOperationsFactory::CreateWriter(std::string full_path, tracing::ScopeTime& scope) {
+    return std::make_unique<CompressedWriter>(inner_->CreateWriter(std::move(full_path), scope), settings_);
+}
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
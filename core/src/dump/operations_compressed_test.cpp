@@ -0,0 +1,149 @@
+#include <userver/dump/operations_compressed.hpp>
+
+#include <userver/compression/zstd.hpp>
+#include <userver/dump/common.hpp>
+#include <userver/dump/operations_file.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kPerms = boost::filesystem::perms::owner_read | boost::filesystem::perms::owner_write;
+
+std::string DumpFilePath(const fs::blocking::TempDirectory& dir) { return dir.GetPath() + "/dump"; }
+
+dump::CompressedOperationsFactory MakeFactory(compression::zstd::CompressionSettings settings = {}) {
+    return dump::CompressedOperationsFactory{
+        std::make_unique<dump::FileOperationsFactory>(kPerms), std::move(settings)};
+}
+
+std::string MakeData(std::size_t size) {
+    std::string data;
+    for (std::size_t i = 0; data.size() < size; ++i) data += std::to_string(i % 1000);
+    data.resize(size);
+    return data;
+}
+
+}  // namespace
+
+UTEST(DumpOperationsCompressed, WriteReadRaw) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+    auto factory = MakeFactory();
+
+    constexpr std::size_t kMaxLength = 1000;
+    std::string expected;
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    auto writer = factory.CreateWriter(path, scope_time);
+    for (std::size_t i = 0; i <= kMaxLength; ++i) {
+        WriteStringViewUnsafe(*writer, std::string(i, 'a' + i % 26));
+        expected += std::string(i, 'a' + i % 26);
+    }
+    // Larger than the internal buffer
+    const auto large = MakeData(1'000'000);
+    WriteStringViewUnsafe(*writer, large);
+    expected += large;
+    writer->Finish();
+
+    const auto contents = fs::blocking::ReadFileContents(path);
+    EXPECT_LT(contents.size(), expected.size() / 5);
+    // The dump is a plain zstd stream
+    EXPECT_EQ(compression::zstd::Decompress(contents, expected.size()), expected);
+
+    auto reader = factory.CreateReader(path);
+    for (std::size_t i = 0; i <= kMaxLength; ++i) {
+        EXPECT_EQ(ReadStringViewUnsafe(*reader, i), std::string(i, 'a' + i % 26));
+    }
+    EXPECT_EQ(ReadStringViewUnsafe(*reader, large.size()), large);
+    reader->Finish();
+}
+
+UTEST(DumpOperationsCompressed, EmptyDump) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+    auto factory = MakeFactory();
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    auto writer = factory.CreateWriter(path, scope_time);
+    writer->Finish();
+
+    auto reader = factory.CreateReader(path);
+    EXPECT_EQ(ReadStringViewUnsafe(*reader, 0), "");
+    reader->Finish();
+}
+
+UTEST(DumpOperationsCompressed, LongDistanceMatching) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    compression::zstd::CompressionSettings settings;
+    settings.level = 1;
+    settings.long_distance_matching = true;
+    auto factory = MakeFactory(settings);
+
+    const auto data = MakeData(1'000'000);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    auto writer = factory.CreateWriter(path, scope_time);
+    writer->Write(data);
+    writer->Finish();
+
+    auto reader = factory.CreateReader(path);
+    EXPECT_EQ(reader->Read<std::string>(), data);
+    reader->Finish();
+}
+
+UTEST(DumpOperationsCompressed, Underread) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+    auto factory = MakeFactory();
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    auto writer = factory.CreateWriter(path, scope_time);
+    writer->Write(42);
+    writer->Write(42);
+    writer->Finish();
+
+    auto reader = factory.CreateReader(path);
+    EXPECT_EQ(reader->Read<int>(), 42);
+    UEXPECT_THROW(reader->Finish(), dump::Error);
+}
+
+UTEST(DumpOperationsCompressed, Truncated) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+    auto factory = MakeFactory();
+
+    const auto data = MakeData(100'000);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    auto writer = factory.CreateWriter(path, scope_time);
+    WriteStringViewUnsafe(*writer, data);
+    writer->Finish();
+
+    const auto contents = fs::blocking::ReadFileContents(path);
+    fs::blocking::RewriteFileContents(path, contents.substr(0, contents.size() - 1));
+
+    auto reader = factory.CreateReader(path);
+    UEXPECT_THROW(ReadStringViewUnsafe(*reader, data.size()), dump::Error);
+}
+
+UTEST(DumpOperationsCompressed, NotCompressed) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+    auto factory = MakeFactory();
+
+    fs::blocking::RewriteFileContents(path, "not a zstd stream");
+
+    auto reader = factory.CreateReader(path);
+    UEXPECT_THROW(reader->Read<std::string>(), dump::Error);
+}
+
+USERVER_NAMESPACE_END
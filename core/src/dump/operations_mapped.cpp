@@ -0,0 +1,367 @@
+#include <userver/dump/operations_mapped.hpp>
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/mapped_array.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace dump {
+
+namespace impl {
+
+class FileMapping final {
+public:
+    explicit FileMapping(const std::string& path) {
+        auto fd = fs::blocking::FileDescriptor::Open(path, fs::blocking::OpenFlag::kRead);
+        size_ = fd.GetSize();
+        if (size_ == 0) return;
+
+        void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd.GetNative(), 0);
+        if (data == MAP_FAILED) {
+            throw std::system_error(errno, std::generic_category(), "mmap");
+        }
+        data_ = static_cast<const char*>(data);
+        // The dumps are mostly read front to back
+        ::madvise(data, size_, MADV_SEQUENTIAL);
+    }
+
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    ~FileMapping() {
+        if (data_) ::munmap(const_cast<char*>(data_), size_);
+    }
+
+    std::string_view GetData() const noexcept { return {data_, size_}; }
+
+private:
+    const char* data_{nullptr};
+    std::size_t size_{0};
+};
+
+}  // namespace impl
+
+namespace {
+
+// File layout:
+//   header: magic, format, section size; padded to kHeaderSize
+//   payload: the data written via WriteRaw
+//   checksums: one per section of the payload
+//   trailer: payload size, checksum of the checksums, magic
+constexpr std::string_view kMagic = "USRVMMAP";
+constexpr std::uint64_t kFormat = 1;
+constexpr std::size_t kHeaderSize = 64;
+constexpr std::size_t kTrailerSize = 3 * sizeof(std::uint64_t);
+
+static_assert(kMagic.size() == sizeof(std::uint64_t));
+
+// Non-cryptographic, only detects the corruption of the file. Hashes 4 words
+// in parallel, so it is much faster than the disk and the deserialization.
+std::uint64_t Checksum(std::string_view data) noexcept {
+    constexpr std::uint64_t kMultiplier = 0x9E37'79B9'7F4A'7C15;
+    constexpr std::size_t kBlockSize = 4 * sizeof(std::uint64_t);
+
+    std::array<std::uint64_t, 4> lanes{1, 2, 3, 4};
+    const auto mix = [](std::uint64_t lane, std::uint64_t word) {
+        lane = (lane ^ word) * kMultiplier;
+        return lane ^ (lane >> 29);
+    };
+
+    std::size_t offset = 0;
+    for (; offset + kBlockSize <= data.size(); offset += kBlockSize) {
+        for (std::size_t i = 0; i < lanes.size(); ++i) {
+            std::uint64_t word = 0;
+            std::memcpy(&word, data.data() + offset + i * sizeof(word), sizeof(word));
+            lanes[i] = mix(lanes[i], word);
+        }
+    }
+    for (; offset < data.size(); offset += sizeof(std::uint64_t)) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, data.data() + offset, std::min(sizeof(word), data.size() - offset));
+        lanes[0] = mix(lanes[0], word);
+    }
+
+    std::uint64_t result = data.size();
+    for (const auto lane : lanes) result = mix(result, lane);
+    return result;
+}
+
+std::string_view AsBytes(const std::uint64_t& value) noexcept {
+    return {reinterpret_cast<const char*>(&value), sizeof(value)};
+}
+
+std::uint64_t ReadWord(std::string_view data, std::size_t offset) noexcept {
+    std::uint64_t result = 0;
+    std::memcpy(&result, data.data() + offset, sizeof(result));
+    return result;
+}
+
+void ValidateSection(
+    const std::string& path,
+    std::string_view payload,
+    std::size_t section_size,
+    std::size_t section,
+    std::uint64_t checksum
+) {
+    if (Checksum(payload.substr(section * section_size, section_size)) != checksum) {
+        throw Error(fmt::format(
+            "Checksum mismatch in the dump file \"{}\": section={}, offset={}",
+            path,
+            section,
+            kHeaderSize + section * section_size
+        ));
+    }
+}
+
+}  // namespace
+
+bool IsMappedDumpFile(const std::string& path) {
+    try {
+        auto fd = fs::blocking::FileDescriptor::Open(path, fs::blocking::OpenFlag::kRead);
+        const auto size = fd.GetSize();
+        if (size < kHeaderSize + kTrailerSize) return false;
+
+        const auto has_magic_at = [&fd](std::size_t offset) {
+            std::array<char, kMagic.size()> magic{};
+            fd.Seek(offset);
+            return fd.Read(magic.data(), magic.size()) == magic.size() &&
+                   std::string_view{magic.data(), magic.size()} == kMagic;
+        };
+        return has_magic_at(0) && has_magic_at(size - kMagic.size());
+    } catch (const std::exception&) {
+        // The reader of the other format reports the error
+        return false;
+    }
+}
+
+MappedFileWriter::MappedFileWriter(
+    std::string path,
+    boost::filesystem::perms perms,
+    tracing::ScopeTime& scope,
+    std::size_t section_size
+)
+    : file_(std::move(path), perms, scope), section_size_(section_size) {
+    UINVARIANT(section_size_ > 0, "Section size must be positive");
+    section_.reserve(section_size_);
+
+    std::string header(kHeaderSize, '\0');
+    const std::uint64_t format = kFormat;
+    const std::uint64_t section_size_word = section_size_;
+    header.replace(0, kMagic.size(), kMagic);
+    header.replace(8, 8, AsBytes(format));
+    header.replace(16, 8, AsBytes(section_size_word));
+    WriteStringViewUnsafe(file_, header);
+}
+
+void MappedFileWriter::WriteRaw(std::string_view data) {
+    while (!data.empty()) {
+        const auto chunk = data.substr(0, section_size_ - section_.size());
+        section_.append(chunk);
+        data.remove_prefix(chunk.size());
+        payload_size_ += chunk.size();
+        if (section_.size() == section_size_) FlushSection();
+    }
+}
+
+void MappedFileWriter::FlushSection() {
+    checksums_.push_back(Checksum(section_));
+    WriteStringViewUnsafe(file_, section_);
+    section_.clear();
+}
+
+std::size_t MappedFileWriter::GetPosition() const noexcept { return kHeaderSize + payload_size_; }
+
+void MappedFileWriter::Finish() {
+    if (!section_.empty()) FlushSection();
+
+    const std::string_view checksums{
+        reinterpret_cast<const char*>(checksums_.data()), checksums_.size() * sizeof(std::uint64_t)};
+    WriteStringViewUnsafe(file_, checksums);
+
+    const std::uint64_t payload_size = payload_size_;
+    const std::uint64_t checksums_checksum = Checksum(checksums);
+    WriteStringViewUnsafe(file_, AsBytes(payload_size));
+    WriteStringViewUnsafe(file_, AsBytes(checksums_checksum));
+    WriteStringViewUnsafe(file_, kMagic);
+
+    file_.Finish();
+}
+
+MappedFileReader::MappedFileReader(std::string path) : path_(std::move(path)) {
+    try {
+        mapping_ = std::make_shared<const impl::FileMapping>(path_);
+    } catch (const std::exception& ex) {
+        throw Error(fmt::format("Failed to map the dump file \"{}\". Reason: {}", path_, ex.what()));
+    }
+
+    const auto file = mapping_->GetData();
+    const auto throw_invalid = [this](std::string_view reason) {
+        throw Error(fmt::format("Invalid memory-mapped dump file \"{}\": {}", path_, reason));
+    };
+
+    if (file.size() < kHeaderSize + kTrailerSize) throw_invalid("the file is too small");
+    if (file.substr(0, kMagic.size()) != kMagic || file.substr(file.size() - kMagic.size()) != kMagic) {
+        throw_invalid("bad magic");
+    }
+    if (ReadWord(file, 8) != kFormat) throw_invalid(fmt::format("unknown format {}", ReadWord(file, 8)));
+
+    section_size_ = ReadWord(file, 16);
+    const auto payload_size = ReadWord(file, file.size() - kTrailerSize);
+    const auto checksums_checksum = ReadWord(file, file.size() - kTrailerSize + 8);
+    if (section_size_ == 0) throw_invalid("zero section size");
+
+    const auto data_size = file.size() - kHeaderSize - kTrailerSize;
+    const auto section_count = payload_size / section_size_ + (payload_size % section_size_ != 0);
+    if (payload_size > data_size || (data_size - payload_size) != section_count * sizeof(std::uint64_t)) {
+        throw_invalid(fmt::format("payload-size={} does not match file-size={}", payload_size, file.size()));
+    }
+
+    payload_ = file.substr(kHeaderSize, payload_size);
+    const auto checksums = file.substr(kHeaderSize + payload_size, section_count * sizeof(std::uint64_t));
+    if (Checksum(checksums) != checksums_checksum) throw_invalid("checksums are corrupted");
+
+    checksums_.resize(section_count);
+    if (section_count != 0) std::memcpy(checksums_.data(), checksums.data(), checksums.size());
+    validated_sections_.assign(section_count, false);
+}
+
+MappedFileReader::~MappedFileReader() = default;
+
+std::string_view MappedFileReader::ReadRaw(std::size_t max_size) {
+    const auto size = std::min(max_size, payload_.size() - position_);
+    ValidateSections(position_, position_ + size);
+
+    const auto result = payload_.substr(position_, size);
+    position_ += size;
+    return result;
+}
+
+void MappedFileReader::ValidateSections(std::size_t begin, std::size_t end) {
+    if (begin == end) return;
+
+    for (auto section = begin / section_size_; section * section_size_ < end; ++section) {
+        if (validated_sections_[section]) continue;
+        ValidateSection(path_, payload_, section_size_, section, checksums_[section]);
+        validated_sections_[section] = true;
+    }
+}
+
+std::string_view MappedFileReader::ReadInPlace(std::size_t size) {
+    if (size > payload_.size() - position_) {
+        throw Error(fmt::format(
+            "Unexpected end-of-file while trying to read from the dump file \"{}\": requested-size={}", path_, size
+        ));
+    }
+    const auto result = payload_.substr(position_, size);
+    position_ += size;
+    return result;
+}
+
+std::function<void()> MappedFileReader::MakeDeferredValidation() const {
+    std::vector<std::size_t> sections;
+    for (std::size_t section = 0; section < validated_sections_.size(); ++section) {
+        if (!validated_sections_[section]) sections.push_back(section);
+    }
+
+    return [path = path_,
+            mapping = mapping_,
+            payload = payload_,
+            section_size = section_size_,
+            checksums = checksums_,
+            sections = std::move(sections)] {
+        for (const auto section : sections) {
+            if (engine::current_task::ShouldCancel()) return;
+            ValidateSection(path, payload, section_size, section, checksums[section]);
+        }
+    };
+}
+
+std::size_t MappedFileReader::GetPosition() const noexcept { return kHeaderSize + position_; }
+
+const std::shared_ptr<const impl::FileMapping>& MappedFileReader::GetMapping() const noexcept { return mapping_; }
+
+void MappedFileReader::Finish() {
+    if (position_ != payload_.size()) {
+        throw Error(fmt::format(
+            "Unexpected extra data at the end of the dump file \"{}\": "
+            "payload-size={}, position={}, unread-size={}",
+            path_,
+            payload_.size(),
+            position_,
+            payload_.size() - position_
+        ));
+    }
+}
+
+MappedFileOperationsFactory::MappedFileOperationsFactory(boost::filesystem::perms perms) : perms_(perms) {}
+
+std::unique_ptr<Reader> MappedFileOperationsFactory::CreateReader(std::string full_path) {
+    return std::make_unique<MappedFileReader>(std::move(full_path));
+}
+
+std::unique_ptr<Writer> MappedFileOperationsFactory::CreateWriter(std::string full_path, tracing::ScopeTime& scope) {
+    return std::make_unique<MappedFileWriter>(std::move(full_path), perms_, scope);
+}
+
+namespace impl {
+
+void WriteAlignedBytes(Writer& writer, std::string_view data, std::size_t alignment) {
+    UASSERT(alignment > 0 && alignment < 256);
+    writer.Write(data.size());
+
+    std::size_t padding = 0;
+    if (const auto* mapped_writer = dynamic_cast<const MappedFileWriter*>(&writer)) {
+        // The data starts after the padding size byte and the padding
+        const auto data_position = mapped_writer->GetPosition() + 1;
+        padding = (alignment - data_position % alignment) % alignment;
+    }
+
+    const std::array<char, 256> zeros{};
+    const auto padding_byte = static_cast<char>(padding);
+    WriteStringViewUnsafe(writer, std::string_view{&padding_byte, 1});
+    WriteStringViewUnsafe(writer, std::string_view{zeros.data(), padding});
+    WriteStringViewUnsafe(writer, data);
+}
+
+AlignedBytes ReadAlignedBytes(Reader& reader, std::size_t alignment) {
+    const auto size = reader.Read<std::size_t>();
+    const auto padding = static_cast<unsigned char>(ReadStringViewUnsafe(reader, 1)[0]);
+    ReadStringViewUnsafe(reader, padding);
+
+    auto* mapped_reader = dynamic_cast<MappedFileReader*>(&reader);
+    if (!mapped_reader) return {ReadStringViewUnsafe(reader, size), nullptr};
+
+    // The data used in place is not touched, its sections are validated
+    // by MappedFileReader::MakeDeferredValidation
+    const auto data = mapped_reader->ReadInPlace(size);
+    if (reinterpret_cast<std::uintptr_t>(data.data()) % alignment == 0) {
+        return {data, mapped_reader->GetMapping()};
+    }
+
+    // The data is copied, so it is validated as any other read
+    const auto begin = static_cast<std::size_t>(data.data() - mapped_reader->payload_.data());
+    mapped_reader->ValidateSections(begin, begin + data.size());
+    return {data, nullptr};
+}
+
+}  // namespace impl
+
+}  // namespace dump
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,212 @@
+#include <userver/dump/operations_mapped.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <userver/dump/common.hpp>
+#include <userver/dump/mapped_array.hpp>
+#include <userver/dump/unsafe.hpp>
+#include <userver/fs/blocking/read.hpp>
+#include <userver/fs/blocking/temp_directory.hpp>
+#include <userver/fs/blocking/write.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr auto kPerms = boost::filesystem::perms::owner_read | boost::filesystem::perms::owner_write;
+
+std::string DumpFilePath(const fs::blocking::TempDirectory& dir) { return dir.GetPath() + "/dump"; }
+
+}  // namespace
+
+UTEST(DumpOperationsMapped, WriteReadRaw) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    constexpr std::size_t kMaxLength = 100;
+    constexpr std::size_t kSectionSize = 64;
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, kPerms, scope_time, kSectionSize);
+    for (std::size_t i = 0; i <= kMaxLength; ++i) {
+        WriteStringViewUnsafe(writer, std::string(i, 'a' + i % 26));
+    }
+    writer.Finish();
+
+    dump::MappedFileReader reader(path);
+    for (std::size_t i = 0; i <= kMaxLength; ++i) {
+        EXPECT_EQ(ReadStringViewUnsafe(reader, i), std::string(i, 'a' + i % 26));
+    }
+    reader.Finish();
+}
+
+UTEST(DumpOperationsMapped, EmptyDump) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, kPerms, scope_time);
+    writer.Finish();
+
+    dump::MappedFileReader reader(path);
+    EXPECT_EQ(ReadStringViewUnsafe(reader, 0), "");
+    reader.Finish();
+}
+
+UTEST(DumpOperationsMapped, Underread) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, kPerms, scope_time);
+    writer.Write(std::string(10, 'a'));
+    writer.Write(42);
+    writer.Finish();
+
+    dump::MappedFileReader reader(path);
+    EXPECT_EQ(reader.Read<std::string>(), std::string(10, 'a'));
+    UEXPECT_THROW(reader.Finish(), dump::Error);
+}
+
+UTEST(DumpOperationsMapped, Overread) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, kPerms, scope_time);
+    WriteStringViewUnsafe(writer, std::string(10, 'a'));
+    writer.Finish();
+
+    dump::MappedFileReader reader(path);
+    UEXPECT_THROW(ReadStringViewUnsafe(reader, 11), dump::Error);
+}
+
+UTEST(DumpOperationsMapped, CorruptedSection) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    constexpr std::size_t kSectionSize = 16;
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, kPerms, scope_time, kSectionSize);
+    WriteStringViewUnsafe(writer, std::string(kSectionSize * 4, 'a'));
+    writer.Finish();
+
+    // Corrupt the third section
+    auto contents = fs::blocking::ReadFileContents(path);
+    const auto corrupted_offset = writer.GetPosition() - kSectionSize * 2;
+    contents[corrupted_offset] = 'b';
+    fs::blocking::RewriteFileContents(path, contents);
+
+    dump::MappedFileReader reader(path);
+    // Sections are validated lazily, the intact ones are read successfully
+    EXPECT_EQ(ReadStringViewUnsafe(reader, kSectionSize * 2), std::string(kSectionSize * 2, 'a'));
+    UEXPECT_THROW_MSG(ReadStringViewUnsafe(reader, 1), dump::Error, "Checksum mismatch");
+}
+
+UTEST(DumpOperationsMapped, InvalidFile) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    fs::blocking::RewriteFileContents(path, std::string(100, 'a'));
+    UEXPECT_THROW_MSG(dump::MappedFileReader{path}, dump::Error, "bad magic");
+}
+
+UTEST(DumpOperationsMapped, MappedArray) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    const std::vector<std::uint64_t> values{1, 2, 3, 5, 8, 13, 21};
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, kPerms, scope_time);
+    // Misalign the array in the file
+    writer.Write(std::string(3, 'a'));
+    writer.Write(dump::MappedArray<std::uint64_t>(values));
+    writer.Write(dump::MappedArray<std::uint64_t>{});
+    writer.Finish();
+
+    auto reader = std::make_unique<dump::MappedFileReader>(path);
+    EXPECT_EQ(reader->Read<std::string>(), std::string(3, 'a'));
+    const auto array = reader->Read<dump::MappedArray<std::uint64_t>>();
+    const auto empty = reader->Read<dump::MappedArray<std::uint64_t>>();
+    reader->Finish();
+    // The array keeps the mapping alive
+    reader.reset();
+
+    EXPECT_TRUE(array.IsMapped());
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(array.data()) % alignof(std::uint64_t), 0);
+    EXPECT_EQ(std::vector<std::uint64_t>(array.begin(), array.end()), values);
+    EXPECT_TRUE(empty.empty());
+}
+
+UTEST(DumpOperationsMapped, MappedArrayDeferredValidation) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    constexpr std::size_t kSectionSize = 64;
+    const std::vector<std::uint64_t> values(100, 42);
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::MappedFileWriter writer(path, kPerms, scope_time, kSectionSize);
+    writer.Write(dump::MappedArray<std::uint64_t>(values));
+    writer.Write(std::string{"tail"});
+    writer.Finish();
+
+    // Corrupt the middle of the array
+    auto contents = fs::blocking::ReadFileContents(path);
+    contents[writer.GetPosition() / 2] ^= 1;
+    fs::blocking::RewriteFileContents(path, contents);
+
+    dump::MappedFileReader reader(path);
+    // The array is used in place, so its sections are not validated on load
+    const auto array = reader.Read<dump::MappedArray<std::uint64_t>>();
+    EXPECT_TRUE(array.IsMapped());
+    EXPECT_EQ(reader.Read<std::string>(), "tail");
+    reader.Finish();
+
+    const auto validate = reader.MakeDeferredValidation();
+    UEXPECT_THROW_MSG(validate(), dump::Error, "Checksum mismatch");
+}
+
+UTEST(DumpOperationsMapped, IsMappedDumpFile) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+    EXPECT_FALSE(dump::IsMappedDumpFile(path));
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::FileWriter file_writer(path, kPerms, scope_time);
+    file_writer.Write(std::string(100, 'a'));
+    file_writer.Finish();
+    EXPECT_FALSE(dump::IsMappedDumpFile(path));
+
+    boost::filesystem::remove(path);
+    dump::MappedFileWriter mapped_writer(path, kPerms, scope_time);
+    mapped_writer.Write(std::string(100, 'a'));
+    mapped_writer.Finish();
+    EXPECT_TRUE(dump::IsMappedDumpFile(path));
+}
+
+UTEST(DumpOperationsMapped, MappedArrayFromFileReader) {
+    const auto dir = fs::blocking::TempDirectory::Create();
+    const auto path = DumpFilePath(dir);
+
+    const std::vector<std::uint32_t> values{1, 2, 3};
+
+    auto scope_time = tracing::Span::CurrentSpan().CreateScopeTime("dump");
+    dump::FileWriter writer(path, kPerms, scope_time);
+    writer.Write(dump::MappedArray<std::uint32_t>(values));
+    writer.Finish();
+
+    dump::FileReader reader(path);
+    const auto array = reader.Read<dump::MappedArray<std::uint32_t>>();
+    reader.Finish();
+
+    EXPECT_FALSE(array.IsMapped());
+    EXPECT_EQ(std::vector<std::uint32_t>(array.begin(), array.end()), values);
+}
+
+USERVER_NAMESPACE_END
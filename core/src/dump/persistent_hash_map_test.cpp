@@ -0,0 +1,40 @@
+#include <userver/dump/persistent_hash_map.hpp>
+
+#include <string>
+#include <unordered_map>
+
+#include <userver/dump/test_helpers.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::PersistentHashMap<std::string, int>;
+using UnorderedMap = std::unordered_map<std::string, int>;
+
+UnorderedMap ToUnorderedMap(const Map& map) { return {map.begin(), map.end()}; }
+
+}  // namespace
+
+TEST(DumpPersistentHashMap, WriteReadCycle) {
+    Map map;
+    for (int i = 0; i < 1000; ++i) map.insert_or_assign(std::to_string(i), i);
+
+    const auto after_cycle = dump::FromBinary<Map>(dump::ToBinary(map));
+    EXPECT_EQ(after_cycle.size(), map.size());
+    EXPECT_EQ(ToUnorderedMap(after_cycle), ToUnorderedMap(map));
+
+    EXPECT_TRUE(dump::FromBinary<Map>(dump::ToBinary(Map{})).empty());
+}
+
+TEST(DumpPersistentHashMap, CompatibleWithUnorderedMap) {
+    const UnorderedMap original{{"a", 1}, {"b", 2}, {"c", 3}};
+
+    const auto map = dump::FromBinary<Map>(dump::ToBinary(original));
+    EXPECT_EQ(ToUnorderedMap(map), original);
+
+    EXPECT_EQ(dump::FromBinary<UnorderedMap>(dump::ToBinary(map)), original);
+}
+
+USERVER_NAMESPACE_END
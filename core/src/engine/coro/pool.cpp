@@ -3,10 +3,12 @@
 #include <algorithm>  // for std::max/std::min
 #include <iterator>
 #include <optional>
+#include <vector>
 
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <utils/numa.hpp>
 #include <utils/sys_info.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -17,12 +19,14 @@ Pool::Pool(PoolConfig config, Executor executor)
     : config_(FixupConfig(std::move(config))),
       executor_(executor),
       local_coroutine_move_size_((config_.local_cache_size + 1) / 2),
-      stack_allocator_(config_.stack_size),
+      stack_allocator_(config_.stack_size, config_.stack_memory, stack_registry_),
       stack_usage_monitor_(config_.stack_size),
       initial_coroutines_(config_.initial_size),
-      used_coroutines_(config_.max_size),
+      used_coroutines_(utils::numa::GetNodesCount(), config_.max_size),
       idle_coroutines_num_(config_.initial_size),
-      total_coroutines_num_(0) {
+      total_coroutines_num_(0),
+      idle_low_water_mark_(config_.initial_size),
+      next_idle_release_(utils::datetime::SteadyCoarseClock::now() + config_.idle_release_timeout) {
     UASSERT(local_coroutine_move_size_ <= config_.local_cache_size);
     moodycamel::ProducerToken token(initial_coroutines_);
 
@@ -55,7 +59,9 @@ typename Pool::CoroutinePtr Pool::GetCoroutine() {
         coroutine = std::move(local_coro_buffer_.back());
         local_coro_buffer_.pop_back();
     } else if (initial_coroutines_.try_dequeue(mover)) {
-        --idle_coroutines_num_;
+        OnIdleCoroutinesTaken(1);
+    } else if (TryDequeueFromOtherNodes(mover)) {
+        OnIdleCoroutinesTaken(1);
     } else {
         coroutine.emplace(CreateCoroutine());
     }
@@ -67,7 +73,9 @@ void Pool::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
     if (config_.local_cache_size == 0) {
         const bool ok =
             // We only ever return coroutines into our 'working set'.
-            used_coroutines_.enqueue(GetUsedPoolToken<moodycamel::ProducerToken>(), std::move(coroutine_ptr.Get()));
+            GetLocalUsedCoroutines().enqueue(
+                GetUsedPoolToken<moodycamel::ProducerToken>(), std::move(coroutine_ptr.Get())
+            );
         if (ok) {
             ++idle_coroutines_num_;
         }
@@ -84,10 +92,13 @@ void Pool::PutCoroutine(CoroutinePtr&& coroutine_ptr) {
 PoolStats Pool::GetStats() const {
     PoolStats stats;
     stats.active_coroutines =
-        total_coroutines_num_.load() - (used_coroutines_.size_approx() + initial_coroutines_.size_approx());
+        total_coroutines_num_.load() - (GetUsedCoroutinesSizeApprox() + initial_coroutines_.size_approx());
     stats.total_coroutines = std::max(total_coroutines_num_.load(), stats.active_coroutines);
     stats.max_stack_usage_pct = stack_usage_monitor_.GetMaxStackUsagePct();
     stats.is_stack_usage_monitor_active = stack_usage_monitor_.IsActive();
+    stats.created_coroutines = stack_registry_.GetAllocatedCount();
+    stats.destroyed_coroutines = stack_registry_.GetDeallocatedCount();
+    stats.stacks_resident_bytes = stack_registry_.GetResidentBytes();
     return stats;
 }
 
@@ -101,7 +112,7 @@ void Pool::ClearLocalCache() {
         return_to_pool_from_local_cache_num =
             std::min(config_.max_size - current_idle_coroutines_num, local_coro_buffer_.size());
 
-        const bool ok = used_coroutines_.enqueue_bulk(
+        const bool ok = GetLocalUsedCoroutines().enqueue_bulk(
             GetUsedPoolToken<moodycamel::ProducerToken>(),
             std::make_move_iterator(local_coro_buffer_.begin()),
             return_to_pool_from_local_cache_num
@@ -149,14 +160,14 @@ void Pool::OnCoroutineDestruction() noexcept { --total_coroutines_num_; }
 bool Pool::TryPopulateLocalCache() {
     if (local_coroutine_move_size_ == 0) return false;
 
-    const std::size_t dequeued_num = used_coroutines_.try_dequeue_bulk(
+    const std::size_t dequeued_num = GetLocalUsedCoroutines().try_dequeue_bulk(
         GetUsedPoolToken<moodycamel::ConsumerToken>(),
         std::back_inserter(local_coro_buffer_),
         local_coroutine_move_size_
     );
     if (dequeued_num == 0) return false;
 
-    idle_coroutines_num_.fetch_sub(dequeued_num);
+    OnIdleCoroutinesTaken(dequeued_num);
     return true;
 }
 
@@ -168,7 +179,7 @@ void Pool::DepopulateLocalCache() {
         return_to_pool_from_local_cache_num =
             std::min(config_.max_size - current_idle_coroutines_num, local_coroutine_move_size_);
 
-        const bool ok = used_coroutines_.enqueue_bulk(
+        const bool ok = GetLocalUsedCoroutines().enqueue_bulk(
             GetUsedPoolToken<moodycamel::ProducerToken>(),
             std::make_move_iterator(local_coro_buffer_.end() - return_to_pool_from_local_cache_num),
             return_to_pool_from_local_cache_num
@@ -184,6 +195,60 @@ void Pool::DepopulateLocalCache() {
     local_coro_buffer_.erase(local_coro_buffer_.end() - local_coroutine_move_size_, local_coro_buffer_.end());
 }
 
+void Pool::OnIdleCoroutinesTaken(std::size_t count) noexcept {
+    const auto old_idle_num = idle_coroutines_num_.fetch_sub(count);
+    // The counter may briefly lag behind the queues
+    const auto idle_num = old_idle_num > count ? old_idle_num - count : 0;
+    // Racy, but the mark only has to be approximately right
+    if (idle_num < idle_low_water_mark_.load(std::memory_order_relaxed)) {
+        idle_low_water_mark_.store(idle_num, std::memory_order_relaxed);
+    }
+}
+
+void Pool::MaybeReleaseIdleCoroutines() {
+    if (config_.idle_release_timeout == std::chrono::milliseconds::zero()) return;
+
+    const auto now = utils::datetime::SteadyCoarseClock::now();
+    auto next_release = next_idle_release_.load(std::memory_order_relaxed);
+    if (now < next_release) return;
+    if (!next_idle_release_.compare_exchange_strong(next_release, now + config_.idle_release_timeout)) {
+        // Some other thread does the release
+        return;
+    }
+
+    ReleaseIdleCoroutines();
+}
+
+void Pool::ReleaseIdleCoroutines() {
+    const std::size_t unused_num = idle_low_water_mark_.load();
+    const std::size_t total_num = total_coroutines_num_.load();
+    const std::size_t release_num =
+        std::min(unused_num, total_num > config_.initial_size ? total_num - config_.initial_size : 0);
+
+    std::vector<Coroutine> released;
+    if (release_num != 0) {
+        released.reserve(release_num);
+        // Used coroutines go first, as they hold the faulted-in stack pages
+        for (auto& used_coroutines : used_coroutines_) {
+            used_coroutines.try_dequeue_bulk(std::back_inserter(released), release_num - released.size());
+            if (released.size() == release_num) break;
+        }
+        if (released.size() < release_num) {
+            initial_coroutines_.try_dequeue_bulk(std::back_inserter(released), release_num - released.size());
+        }
+        idle_coroutines_num_ -= released.size();
+        total_coroutines_num_ -= released.size();
+    }
+
+    idle_low_water_mark_.store(idle_coroutines_num_.load());
+
+    if (!released.empty()) {
+        LOG_DEBUG() << "Releasing " << released.size() << " idle coroutines, " << total_coroutines_num_.load()
+                    << " coroutines left";
+    }
+    // Coroutines are destroyed and their stacks are unmapped here
+}
+
 std::size_t Pool::GetStackSize() const { return config_.stack_size; }
 
 PoolConfig Pool::FixupConfig(PoolConfig&& config) {
@@ -199,10 +264,39 @@ void Pool::AccountStackUsage() { stack_usage_monitor_.AccountStackUsage(); }
 
 template <typename Token>
 Token& Pool::GetUsedPoolToken() {
-    thread_local Token token(used_coroutines_);
+    thread_local Token token(GetLocalUsedCoroutines());
     return token;
 }
 
+moodycamel::ConcurrentQueue<Pool::Coroutine>& Pool::GetLocalUsedCoroutines() noexcept {
+    // Threads are pinned before they touch the pool, so the node of a thread
+    // never changes after the first call and tokens always match the queue.
+    thread_local const std::size_t node = utils::numa::GetCurrentThreadNode().value_or(0);
+    return used_coroutines_[node < used_coroutines_.size() ? node : 0];
+}
+
+template <typename Mover>
+bool Pool::TryDequeueFromOtherNodes(Mover& mover) {
+    if (used_coroutines_.size() == 1) return false;
+
+    // Prefer a stack from a remote node to mmap-ing a new one
+    auto& local_used_coroutines = GetLocalUsedCoroutines();
+    for (auto& used_coroutines : used_coroutines_) {
+        if (&used_coroutines != &local_used_coroutines && used_coroutines.try_dequeue(mover)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t Pool::GetUsedCoroutinesSizeApprox() const noexcept {
+    std::size_t size = 0;
+    for (const auto& used_coroutines : used_coroutines_) {
+        size += used_coroutines.size_approx();
+    }
+    return size;
+}
+
 //////////////////////////////////////////////////////////////
 
 Pool::CoroutinePtr::CoroutinePtr(Pool::Coroutine&& coro, Pool& pool) noexcept : coro_(std::move(coro)), pool_(&pool) {}
@@ -7,7 +7,10 @@
 
 #include <engine/coro/pool_config.hpp>
 #include <engine/coro/pool_stats.hpp>
+#include <engine/coro/stack_allocator.hpp>
 #include <engine/coro/stack_usage_monitor.hpp>
+#include <userver/utils/datetime/steady_coarse_clock.hpp>
+#include <userver/utils/fixed_array.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -35,6 +38,11 @@ public:
     void RegisterThread();
     void AccountStackUsage();
 
+    // Destroys the idle coroutines that were not needed during the last
+    // idle_release_timeout, if it is time to. Must be called outside of
+    // coroutines.
+    void MaybeReleaseIdleCoroutines();
+
 private:
     static PoolConfig FixupConfig(PoolConfig&& config);
 
@@ -44,9 +52,19 @@ private:
     bool TryPopulateLocalCache();
     void DepopulateLocalCache();
 
+    void OnIdleCoroutinesTaken(std::size_t count) noexcept;
+    void ReleaseIdleCoroutines();
+
     template <typename Token>
     Token& GetUsedPoolToken();
 
+    moodycamel::ConcurrentQueue<Coroutine>& GetLocalUsedCoroutines() noexcept;
+
+    template <typename Mover>
+    bool TryDequeueFromOtherNodes(Mover& mover);
+
+    std::size_t GetUsedCoroutinesSizeApprox() const noexcept;
+
     const PoolConfig config_;
     const Executor executor_;
 
@@ -60,10 +78,10 @@ private:
     // outside of any coroutine.
     static inline thread_local std::vector<Coroutine> local_coro_buffer_;
 
-    boost::coroutines2::protected_fixedsize_stack stack_allocator_;
-    // Some pointers arithmetic in StackUsageMonitor depends on this.
+    StackRegistry stack_registry_;
+    // Some pointers arithmetic in StackUsageMonitor depends on the stacks layout.
     // If you change the allocator, adjust the math there accordingly.
-    static_assert(std::is_same_v<decltype(stack_allocator_), boost::coroutines2::protected_fixedsize_stack>);
+    StackAllocator stack_allocator_;
     StackUsageMonitor stack_usage_monitor_;
 
     // We aim to reuse coroutines as much as possible,
@@ -73,10 +91,18 @@ private:
     // The same could've been achieved with some LIFO container, but apparently
     // we don't have a container handy enough to not just use 2 queues.
     moodycamel::ConcurrentQueue<Coroutine> initial_coroutines_;
-    moodycamel::ConcurrentQueue<Coroutine> used_coroutines_;
+    // One queue per NUMA node. Threads pinned to a node return coroutines to
+    // and take them from the queue of that node, so that stacks (which are
+    // placed on the node that first touches them) are reused on the same node.
+    utils::FixedArray<moodycamel::ConcurrentQueue<Coroutine>> used_coroutines_;
 
     std::atomic<std::size_t> idle_coroutines_num_;
     std::atomic<std::size_t> total_coroutines_num_;
+
+    // The lowest idle_coroutines_num_ since the last idle coroutines release,
+    // that many coroutines were not needed during the whole period.
+    std::atomic<std::size_t> idle_low_water_mark_;
+    std::atomic<utils::datetime::SteadyCoarseClock::time_point> next_idle_release_;
 };
 
 class Pool::CoroutinePtr final {
@@ -1,15 +1,31 @@
 #include "pool_config.hpp"
 
+#include <userver/utils/trivial_map.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
 
+StackMemoryMode Parse(const yaml_config::YamlConfig& value, formats::parse::To<StackMemoryMode>) {
+    static constexpr utils::TrivialBiMap kMap([](auto selector) {
+        return selector()
+            .Case(StackMemoryMode::kDefault, "default")
+            .Case(StackMemoryMode::kTransparentHugePages, "transparent-huge-pages")
+            .Case(StackMemoryMode::kPrefaulted, "prefaulted");
+    });
+
+    return utils::ParseFromValueString(value, kMap);
+}
+
 PoolConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<PoolConfig>) {
     PoolConfig config;
     config.initial_size = value["initial_size"].As<size_t>(config.initial_size);
     config.max_size = value["max_size"].As<size_t>(config.max_size);
     config.stack_size = value["stack_size"].As<size_t>(config.stack_size);
     config.local_cache_size = value["local_cache_size"].As<size_t>(config.local_cache_size);
+    config.idle_release_timeout =
+        value["idle_release_timeout"].As<std::chrono::milliseconds>(config.idle_release_timeout);
+    config.stack_memory = value["stack_memory"].As<StackMemoryMode>(config.stack_memory);
     return config;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <chrono>
 #include <string>
 
 #include <userver/formats/yaml.hpp>
@@ -9,13 +10,30 @@ USERVER_NAMESPACE_BEGIN
 
 namespace engine::coro {
 
+/// How the memory of the coroutine stacks is provided by the kernel
+enum class StackMemoryMode {
+    /// Pages are faulted in on first access
+    kDefault,
+    /// Stacks are madvise-d with MADV_HUGEPAGE, only has an effect for stacks
+    /// of at least a huge page size
+    kTransparentHugePages,
+    /// All the pages of a stack are faulted in on allocation
+    kPrefaulted,
+};
+
 struct PoolConfig {
     std::size_t initial_size = 1000;
     std::size_t max_size = 4000;
     std::size_t stack_size = 256 * 1024ULL;
     std::size_t local_cache_size = 8;
+    // idle coroutines above initial_size that were not needed for that long
+    // are destroyed and their stacks are unmapped, zero disables the release
+    std::chrono::milliseconds idle_release_timeout{0};
+    StackMemoryMode stack_memory{StackMemoryMode::kDefault};
 };
 
+StackMemoryMode Parse(const yaml_config::YamlConfig& value, formats::parse::To<StackMemoryMode>);
+
 PoolConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<PoolConfig>);
 
 }  // namespace engine::coro
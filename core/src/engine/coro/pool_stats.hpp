@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
 USERVER_NAMESPACE_BEGIN
@@ -12,6 +13,9 @@ struct PoolStats {
     size_t total_coroutines = 0;
     std::uint16_t max_stack_usage_pct = 0;
     bool is_stack_usage_monitor_active = false;
+    std::uint64_t created_coroutines = 0;
+    std::uint64_t destroyed_coroutines = 0;
+    std::size_t stacks_resident_bytes = 0;
 };
 
 inline PoolStats& operator+=(PoolStats& lhs, const PoolStats& rhs) {
@@ -21,6 +25,9 @@ inline PoolStats& operator+=(PoolStats& lhs, const PoolStats& rhs) {
         lhs.max_stack_usage_pct = rhs.max_stack_usage_pct;
     }
     lhs.is_stack_usage_monitor_active |= rhs.is_stack_usage_monitor_active;
+    lhs.created_coroutines += rhs.created_coroutines;
+    lhs.destroyed_coroutines += rhs.destroyed_coroutines;
+    lhs.stacks_resident_bytes += rhs.stacks_resident_bytes;
     return lhs;
 }
 
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <engine/coro/pool.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Pool = engine::coro::Pool;
+
+void NoopExecutor(Pool::TaskPipe& task_pipe) {
+    for ([[maybe_unused]] auto* context : task_pipe) {
+    }
+}
+
+// Pool keeps thread_local tokens, they must die before the pool does
+template <typename Func>
+void RunInNewThread(Func func) {
+    std::thread(std::move(func)).join();
+}
+
+}  // namespace
+
+TEST(CoroPool, ReleaseIdleCoroutines) {
+    engine::coro::PoolConfig config;
+    config.initial_size = 2;
+    config.max_size = 100;
+    config.local_cache_size = 0;
+    config.idle_release_timeout = std::chrono::milliseconds{1};
+    Pool pool(config, &NoopExecutor);
+
+    RunInNewThread([&pool] {
+        std::vector<Pool::CoroutinePtr> coroutines;
+        for (int i = 0; i < 10; ++i) {
+            coroutines.push_back(pool.GetCoroutine());
+        }
+        for (auto& coroutine : coroutines) {
+            std::move(coroutine).ReturnToPool();
+        }
+        coroutines.clear();
+        EXPECT_EQ(pool.GetStats().total_coroutines, 10);
+
+        // All the coroutines were in use during this period
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        pool.MaybeReleaseIdleCoroutines();
+        EXPECT_EQ(pool.GetStats().total_coroutines, 10);
+
+        // Nothing was taken from the pool, excess coroutines go away
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        pool.MaybeReleaseIdleCoroutines();
+        const auto stats = pool.GetStats();
+        EXPECT_EQ(stats.total_coroutines, 2);
+        EXPECT_EQ(stats.created_coroutines, 10);
+        EXPECT_EQ(stats.destroyed_coroutines, 8);
+    });
+}
+
+TEST(CoroPool, NoReleaseByDefault) {
+    engine::coro::PoolConfig config;
+    config.initial_size = 0;
+    config.local_cache_size = 0;
+    Pool pool(config, &NoopExecutor);
+
+    RunInNewThread([&pool] {
+        std::move(pool.GetCoroutine()).ReturnToPool();
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        pool.MaybeReleaseIdleCoroutines();
+        EXPECT_EQ(pool.GetStats().total_coroutines, 1);
+    });
+}
+
+#ifdef __linux__
+TEST(CoroPool, PrefaultedStacks) {
+    engine::coro::PoolConfig config;
+    config.initial_size = 4;
+    config.stack_memory = engine::coro::StackMemoryMode::kPrefaulted;
+    Pool pool(config, &NoopExecutor);
+
+    EXPECT_GE(pool.GetStats().stacks_resident_bytes, config.initial_size * pool.GetStackSize());
+}
+#endif
+
+USERVER_NAMESPACE_END
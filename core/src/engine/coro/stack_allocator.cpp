@@ -0,0 +1,146 @@
+#include <engine/coro/stack_allocator.hpp>
+
+#include <sys/mman.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+#include <userver/utils/assert.hpp>
+
+#include <utils/sys_info.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+namespace {
+
+char* GetMappingBegin(const boost::context::stack_context& sctx) noexcept {
+    return static_cast<char*>(sctx.sp) - sctx.size;
+}
+
+void Prefault(char* begin, std::size_t size) noexcept {
+#ifdef MADV_POPULATE_WRITE
+    // Linux 5.14+, saves a page fault per page
+    if (::madvise(begin, size, MADV_POPULATE_WRITE) == 0) return;
+#endif
+
+    const auto page_size = utils::sys_info::GetPageSize();
+    // Touch from the top, the way the stack grows
+    for (std::size_t offset = size; offset >= page_size; offset -= page_size) {
+        *static_cast<volatile char*>(begin + offset - page_size) = 0;
+    }
+}
+
+}  // namespace
+
+std::size_t StackRegistry::GetResidentBytes() const {
+#ifdef __linux__
+    const auto mapping_size = stack_mapping_size_.load();
+    if (mapping_size == 0) return 0;
+
+    // Each shard contributes its share of the samples
+    std::vector<void*> sampled_stacks;
+    sampled_stacks.reserve(kMaxSampledStacks);
+    std::size_t total_stacks = 0;
+    for (auto& shard : shards_) {
+        const std::lock_guard lock{shard->mutex};
+        total_stacks += shard->stacks.size();
+        const auto samples = std::min(shard->stacks.size(), kMaxSampledStacks / kShards);
+        std::copy_n(shard->stacks.begin(), samples, std::back_inserter(sampled_stacks));
+    }
+    if (sampled_stacks.empty()) return 0;
+
+    const auto page_size = utils::sys_info::GetPageSize();
+    std::vector<unsigned char> pages(mapping_size / page_size);
+    std::size_t resident_pages = 0;
+    std::size_t accounted_stacks = 0;
+    for (void* stack_top : sampled_stacks) {
+        // The stack could have been unmapped since we've released the lock,
+        // mincore fails with ENOMEM then and the stack is not accounted.
+        if (::mincore(static_cast<char*>(stack_top) - mapping_size, mapping_size, pages.data()) != 0) continue;
+        resident_pages +=
+            std::count_if(pages.begin(), pages.end(), [](unsigned char page) { return (page & 1) != 0; });
+        ++accounted_stacks;
+    }
+    if (accounted_stacks == 0) return 0;
+
+    return resident_pages * page_size / accounted_stacks * total_stacks;
+#else
+    return 0;
+#endif
+}
+
+std::uint64_t StackRegistry::GetAllocatedCount() const noexcept { return allocated_count_.load(); }
+
+std::uint64_t StackRegistry::GetDeallocatedCount() const noexcept { return deallocated_count_.load(); }
+
+void StackRegistry::Add(const boost::context::stack_context& sctx) {
+    [[maybe_unused]] const auto old_mapping_size = stack_mapping_size_.exchange(sctx.size);
+    UASSERT(old_mapping_size == 0 || old_mapping_size == sctx.size);
+    {
+        auto& shard = *shards_[GetShardIndex(sctx.sp)];
+        const std::lock_guard lock{shard.mutex};
+        shard.stacks.insert(sctx.sp);
+    }
+    ++allocated_count_;
+}
+
+void StackRegistry::Remove(const boost::context::stack_context& sctx) noexcept {
+    {
+        auto& shard = *shards_[GetShardIndex(sctx.sp)];
+        const std::lock_guard lock{shard.mutex};
+        shard.stacks.erase(sctx.sp);
+    }
+    ++deallocated_count_;
+}
+
+std::size_t StackRegistry::GetShardIndex(const void* stack_top) noexcept {
+    // Stack tops are page-aligned and often adjacent, mix the page number
+    const auto page = reinterpret_cast<std::uintptr_t>(stack_top) >> 12;
+    return static_cast<std::size_t>((page * 0x9E3779B97F4A7C15ULL) >> 32) % kShards;
+}
+
+StackAllocator::StackAllocator(std::size_t stack_size, StackMemoryMode mode, StackRegistry& registry) noexcept
+    : impl_(stack_size), mode_(mode), registry_(&registry) {}
+
+boost::context::stack_context StackAllocator::allocate() {
+    auto sctx = impl_.allocate();
+
+    // Skip the guard page
+    const auto page_size = utils::sys_info::GetPageSize();
+    char* const stack_begin = GetMappingBegin(sctx) + page_size;
+    const std::size_t stack_size = sctx.size - page_size;
+
+    switch (mode_) {
+        case StackMemoryMode::kDefault:
+            break;
+        case StackMemoryMode::kTransparentHugePages:
+#ifdef MADV_HUGEPAGE
+            // Just a hint, the kernel may ignore it
+            ::madvise(stack_begin, stack_size, MADV_HUGEPAGE);
+#endif
+            break;
+        case StackMemoryMode::kPrefaulted:
+            Prefault(stack_begin, stack_size);
+            break;
+    }
+
+    try {
+        registry_->Add(sctx);
+    } catch (...) {
+        impl_.deallocate(sctx);
+        throw;
+    }
+    return sctx;
+}
+
+void StackAllocator::deallocate(boost::context::stack_context& sctx) noexcept {
+    registry_->Remove(sctx);
+    impl_.deallocate(sctx);
+}
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+
+#include <coroutines/coroutine.hpp>
+#include <userver/concurrent/impl/interference_shield.hpp>
+
+#include <engine/coro/pool_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::coro {
+
+/// Bookkeeping of the stacks allocated by StackAllocator
+class StackRegistry final {
+public:
+    /// Estimates the resident memory of all the live stacks. Takes a syscall
+    /// per stack for at most kMaxSampledStacks of them, the result for the
+    /// rest is extrapolated.
+    std::size_t GetResidentBytes() const;
+
+    static constexpr std::size_t kMaxSampledStacks = 128;
+
+    std::uint64_t GetAllocatedCount() const noexcept;
+    std::uint64_t GetDeallocatedCount() const noexcept;
+
+private:
+    friend class StackAllocator;
+
+    void Add(const boost::context::stack_context& sctx);
+    void Remove(const boost::context::stack_context& sctx) noexcept;
+
+    // Stacks are allocated and freed by all the task processor threads,
+    // sharding keeps them from contending on a single lock
+    static constexpr std::size_t kShards = 16;
+
+    struct Shard final {
+        std::mutex mutex;
+        // stack tops, all the stacks are of the same size
+        std::unordered_set<void*> stacks;
+    };
+
+    static std::size_t GetShardIndex(const void* stack_top) noexcept;
+
+    mutable std::array<concurrent::impl::InterferenceShield<Shard>, kShards> shards_;
+    std::atomic<std::size_t> stack_mapping_size_{0};
+
+    std::atomic<std::uint64_t> allocated_count_{0};
+    std::atomic<std::uint64_t> deallocated_count_{0};
+};
+
+/// @brief Coroutine stack allocator, that hints the kernel on how to back the
+/// stack memory and registers the stacks in a StackRegistry.
+///
+/// The memory layout is exactly the one of
+/// boost::coroutines2::protected_fixedsize_stack (a guard page below the
+/// stack), StackUsageMonitor relies on it.
+class StackAllocator final {
+public:
+    StackAllocator(std::size_t stack_size, StackMemoryMode mode, StackRegistry& registry) noexcept;
+
+    boost::context::stack_context allocate();
+
+    void deallocate(boost::context::stack_context& sctx) noexcept;
+
+private:
+    boost::coroutines2::protected_fixedsize_stack impl_;
+    StackMemoryMode mode_;
+    StackRegistry* registry_;
+};
+
+}  // namespace engine::coro
+
+USERVER_NAMESPACE_END
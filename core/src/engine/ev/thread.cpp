@@ -11,6 +11,7 @@
 #include <userver/utils/thread_name.hpp>
 
 #include <utils/check_syscall.hpp>
+#include <utils/numa.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -27,14 +28,31 @@ const auto kCpuStatsThrottle = static_cast<std::size_t>(kCpuStatsCollectInterval
 
 }  // namespace
 
-Thread::Thread(const std::string& thread_name) : Thread(thread_name, EventLoop::EvLoopType::kNewLoop) {}
-
-Thread::Thread(const std::string& thread_name, UseDefaultEvLoop)
-    : Thread(thread_name, EventLoop::EvLoopType::kDefaultLoop) {}
-
-Thread::Thread(const std::string& thread_name, EventLoop::EvLoopType ev_loop_type)
-    : event_loop_(ev_loop_type), name_{thread_name}, cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle} {
+Thread::Thread(const std::string& thread_name, std::size_t io_uring_entries, std::optional<std::size_t> cpu)
+    : Thread(thread_name, EventLoop::EvLoopType::kNewLoop, io_uring_entries, cpu) {}
+
+Thread::Thread(
+    const std::string& thread_name,
+    UseDefaultEvLoop,
+    std::size_t io_uring_entries,
+    std::optional<std::size_t> cpu
+)
+    : Thread(thread_name, EventLoop::EvLoopType::kDefaultLoop, io_uring_entries, cpu) {}
+
+Thread::Thread(
+    const std::string& thread_name,
+    EventLoop::EvLoopType ev_loop_type,
+    std::size_t io_uring_entries,
+    std::optional<std::size_t> cpu
+)
+    : event_loop_(ev_loop_type),
+      name_{thread_name},
+      cpu_(cpu),
+      cpu_stats_storage_{kCpuStatsCollectInterval, kCpuStatsThrottle} {
     UASSERT_MSG(kDeferredInterval > std::chrono::milliseconds{4}, "Timer events would happen too often");
+    if (io_uring_entries != 0) {
+        io_uring_ = io::sys_linux::IoUring::TryCreate(io_uring_entries);
+    }
     Start();
 }
 
@@ -109,9 +127,22 @@ void Thread::Start() {
     ev_timer_init(&defer_timer_, UpdateTimersWatcher, 0.0, defer_duration.count());
     ev_timer_start(loop, &defer_timer_);
 
+    if (io_uring_) {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+        ev_io_init(&watch_io_uring_, IoUringWatcher, io_uring_->GetCompletionFd(), EV_READ);
+        ev_io_start(loop, &watch_io_uring_);
+    }
+
     is_running_ = true;
     thread_ = std::thread([this] {
         utils::SetCurrentThreadName(name_);
+        if (cpu_) {
+            try {
+                utils::numa::PinCurrentThreadToCpu(*cpu_);
+            } catch (const std::exception& ex) {
+                LOG_ERROR() << "Failed to pin ev thread " << name_ << " to CPU " << *cpu_ << ": " << ex;
+            }
+        }
         RunEvLoop();
     });
 }
@@ -137,6 +168,7 @@ void Thread::RunEvLoop() {
     ev_async_stop(GetEvLoop(), &watch_update_);
     ev_async_stop(GetEvLoop(), &watch_break_);
     ev_timer_stop(GetEvLoop(), &defer_timer_);
+    if (io_uring_) ev_io_stop(GetEvLoop(), &watch_io_uring_);
 }
 
 void Thread::UpdateLoopWatcher(struct ev_loop* loop, ev_async*, int) noexcept {
@@ -174,6 +206,13 @@ void Thread::BreakLoopWatcherImpl() {
     ev_break(GetEvLoop(), EVBREAK_ALL);
 }
 
+void Thread::IoUringWatcher(struct ev_loop* loop, ev_io*, int) noexcept {
+    auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
+    UASSERT(ev_thread != nullptr);
+    UASSERT(ev_thread->io_uring_);
+    ev_thread->io_uring_->ReapCompletions();
+}
+
 void Thread::Acquire(struct ev_loop* loop) noexcept {
     auto* ev_thread = static_cast<Thread*>(ev_userdata(loop));
     UASSERT(ev_thread != nullptr);
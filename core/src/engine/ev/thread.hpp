@@ -3,6 +3,7 @@
 #include <atomic>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 
@@ -12,6 +13,7 @@
 
 #include <engine/ev/async_payload_base.hpp>
 #include <engine/ev/event_loop.hpp>
+#include <engine/io/sys_linux/io_uring.hpp>
 #include <userver/concurrent/impl/intrusive_mpsc_queue.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
@@ -27,8 +29,19 @@ public:
     struct UseDefaultEvLoop {};
     static constexpr UseDefaultEvLoop kUseDefaultEvLoop{};
 
-    explicit Thread(const std::string& thread_name);
-    Thread(const std::string& thread_name, UseDefaultEvLoop);
+    // io_uring is set up if `io_uring_entries` is not 0 and the kernel
+    // supports it. The OS thread is pinned to `cpu` if it is set.
+    explicit Thread(
+        const std::string& thread_name,
+        std::size_t io_uring_entries = 0,
+        std::optional<std::size_t> cpu = std::nullopt
+    );
+    Thread(
+        const std::string& thread_name,
+        UseDefaultEvLoop,
+        std::size_t io_uring_entries = 0,
+        std::optional<std::size_t> cpu = std::nullopt
+    );
 
     ~Thread();
 
@@ -48,8 +61,16 @@ public:
     std::uint8_t GetCurrentLoadPercent() const;
     const std::string& GetName() const;
 
+    // nullptr if io_uring is disabled or unavailable
+    io::sys_linux::IoUring* GetIoUring() const noexcept { return io_uring_.get(); }
+
 private:
-    Thread(const std::string& thread_name, EventLoop::EvLoopType ev_loop_type);
+    Thread(
+        const std::string& thread_name,
+        EventLoop::EvLoopType ev_loop_type,
+        std::size_t io_uring_entries,
+        std::optional<std::size_t> cpu
+    );
 
     void RegisterInEvLoop(AsyncPayloadBase& payload);
 
@@ -63,6 +84,7 @@ private:
     void UpdateLoopWatcherImpl();
     static void BreakLoopWatcher(struct ev_loop*, ev_async* w, int) noexcept;
     void BreakLoopWatcherImpl();
+    static void IoUringWatcher(struct ev_loop*, ev_io* w, int) noexcept;
 
     static void Acquire(struct ev_loop* loop) noexcept;
     static void Release(struct ev_loop* loop) noexcept;
@@ -81,7 +103,11 @@ private:
     ev_async watch_update_{};
     ev_async watch_break_{};
 
+    std::unique_ptr<io::sys_linux::IoUring> io_uring_;
+    ev_io watch_io_uring_{};
+
     const std::string name_;
+    const std::optional<std::size_t> cpu_;
     utils::statistics::ThreadCpuStatsStorage cpu_stats_storage_;
     bool is_running_{false};
 };
@@ -21,6 +21,8 @@ void ThreadControlBase::RunPayloadInEvLoopDeferred(AsyncPayloadBase& payload, De
 
 bool ThreadControlBase::IsInEvThread() const noexcept { return thread_.IsInEvThread(); }
 
+io::sys_linux::IoUring* ThreadControlBase::GetIoUring() const noexcept { return thread_.GetIoUring(); }
+
 // NOLINTNEXTLINE(readability-make-member-function-const)
 void ThreadControlBase::DoStart(ev_timer& w) noexcept {
     UASSERT(IsInEvThread());
@@ -20,6 +20,10 @@ namespace engine {
 class Deadline;
 }  // namespace engine
 
+namespace engine::io::sys_linux {
+class IoUring;
+}  // namespace engine::io::sys_linux
+
 namespace engine::ev {
 
 namespace impl {
@@ -139,6 +143,9 @@ public:
 
     bool IsInEvThread() const noexcept;
 
+    /// nullptr if io_uring is not enabled for the ev thread
+    io::sys_linux::IoUring* GetIoUring() const noexcept;
+
 protected:
     explicit ThreadControlBase(Thread& thread) noexcept;
 
@@ -4,6 +4,8 @@
 
 #include <userver/utils/assert.hpp>
 
+#include <utils/numa.hpp>
+
 #include "thread.hpp"
 #include "thread_control.hpp"
 
@@ -17,12 +19,28 @@ ThreadPool::ThreadPool(ThreadPoolConfig config, UseDefaultEvLoop)
     : ThreadPool(std::move(config), !config.ev_default_loop_disabled) {}
 
 ThreadPool::ThreadPool(ThreadPoolConfig config, bool use_ev_default_loop) : use_ev_default_loop_(use_ev_default_loop) {
+    const std::size_t io_uring_entries = config.io_uring_enabled ? config.io_uring_entries : 0;
+    const auto get_cpu = [&config](std::size_t index) -> std::optional<std::size_t> {
+        if (config.cpu_affinity.empty()) return std::nullopt;
+        return config.cpu_affinity[index % config.cpu_affinity.size()];
+    };
     threads_ = utils::GenerateFixedArray(config.threads, [&](std::size_t index) {
         const auto thread_name = fmt::format("{}_{}", config.thread_name, index);
-        return (use_ev_default_loop && index == 0) ? Thread(thread_name, Thread::kUseDefaultEvLoop)
-                                                   : Thread(thread_name);
+        return (use_ev_default_loop && index == 0)
+                   ? Thread(thread_name, Thread::kUseDefaultEvLoop, io_uring_entries, get_cpu(index))
+                   : Thread(thread_name, io_uring_entries, get_cpu(index));
     });
 
+    if (!config.cpu_affinity.empty()) {
+        numa_node_threads_ = utils::FixedArray<NodeThreads>(utils::numa::GetNodesCount());
+        for (std::size_t index = 0; index < threads_.size(); ++index) {
+            const auto node = utils::numa::GetCpuNode(*get_cpu(index));
+            if (node < numa_node_threads_.size()) {
+                numa_node_threads_[node].indices.push_back(index);
+            }
+        }
+    }
+
     default_controls_.controls = utils::GenerateFixedArray(threads_.size(), [this](std::size_t index) {
         return ThreadControl(threads_[index]);
     });
@@ -42,7 +60,22 @@ ThreadPool::~ThreadPool() {
 
 std::size_t ThreadPool::GetSize() const { return threads_.size(); }
 
-ThreadControl& ThreadPool::NextThread() { return default_controls_.Next(); }
+ThreadControl& ThreadPool::NextThread() {
+    if (!numa_node_threads_.empty()) {
+        // Prefer ev threads on the NUMA node of the calling worker, so that
+        // the socket buffers and the coroutine stacks stay on the same node
+        const auto node = utils::numa::GetCurrentThreadNode();
+        if (node && *node < numa_node_threads_.size()) {
+            auto& node_threads = numa_node_threads_[*node];
+            if (!node_threads.indices.empty()) {
+                // just ignore next_idx overflow
+                const auto index = node_threads.indices[node_threads.next_idx++ % node_threads.indices.size()];
+                return default_controls_.controls[index];
+            }
+        }
+    }
+    return default_controls_.Next();
+}
 
 TimerThreadControl& ThreadPool::NextTimerThread() { return timer_controls_.Next(); }
 
@@ -53,10 +53,17 @@ private:
         bool Empty() const noexcept { return controls.empty(); }
     };
 
+    struct NodeThreads final {
+        std::vector<std::size_t> indices;
+        std::atomic<std::size_t> next_idx{0};
+    };
+
     BunchOfControls<ThreadControl> default_controls_;
     BunchOfControls<TimerThreadControl> timer_controls_;
 
     utils::FixedArray<Thread> threads_;
+    // ev threads by NUMA node, empty if the threads are not pinned
+    utils::FixedArray<NodeThreads> numa_node_threads_;
 
     const bool use_ev_default_loop_;
 };
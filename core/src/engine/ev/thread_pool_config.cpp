@@ -1,5 +1,7 @@
 #include "thread_pool_config.hpp"
 
+#include <utils/numa.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine::ev {
@@ -8,6 +10,9 @@ ThreadPoolConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<
     ThreadPoolConfig config;
     config.threads = value["threads"].As<std::size_t>(config.threads);
     config.thread_name = value["thread_name"].As<std::string>(config.thread_name);
+    config.io_uring_enabled = value["io_uring_enabled"].As<bool>(config.io_uring_enabled);
+    config.io_uring_entries = value["io_uring_entries"].As<std::size_t>(config.io_uring_entries);
+    config.cpu_affinity = utils::numa::ParseCpuList(value["cpu_affinity"].As<std::string>({}));
     return config;
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <userver/formats/yaml.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -13,6 +14,10 @@ struct ThreadPoolConfig {
     std::size_t threads = 2;
     std::string thread_name = "event-worker";
     bool ev_default_loop_disabled = false;
+    bool io_uring_enabled = false;
+    std::size_t io_uring_entries = 1024;
+    // ev thread i is pinned to cpu_affinity[i % size], no pinning if empty
+    std::vector<std::size_t> cpu_affinity;
 };
 
 ThreadPoolConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<ThreadPoolConfig>);
@@ -11,6 +11,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/ev/thread_control.hpp>
 #include <engine/task/task_context.hpp>
 #include <utils/check_syscall.hpp>
 
@@ -59,6 +60,8 @@ Direction::SingleUserGuard::SingleUserGuard(Direction& dir) : dir_(dir) { dir_.p
 Direction::SingleUserGuard::~SingleUserGuard() { dir_.poller_.SwitchStateToReadyToUse(); }
 #endif  // #ifndef NDEBUG
 
+Direction::Direction(const ev::ThreadControl& control) : poller_(control), io_uring_(control.GetIoUring()) {}
+
 // Write operations on socket usually do not block, so it makes sense to reuse
 // the same ThreadControl for the sake of better balancing of ev threads.
 FdControl::FdControl(const ev::ThreadControl& control) : read_(control), write_(control) {}
@@ -12,6 +12,7 @@
 #include <userver/logging/log.hpp>
 #include <userver/utils/assert.hpp>
 
+#include <engine/io/sys_linux/io_uring.hpp>
 #include <engine/task/task_context.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 
@@ -99,13 +100,67 @@ public:
         const Context&... context
     );
 
+    // Same as PerformIo, but if io_uring is enabled for the ev thread, submits
+    // `opcode` to it and resumes on completion instead of waiting for
+    // readiness. `io_func` is used otherwise and for TransferMode::kPartial,
+    // which must not wait once some data has been transferred.
+    template <typename IoFunc, typename... Context>
+    size_t PerformIo(
+        SingleUserGuard& guard,
+        sys_linux::IoUringOpcode opcode,
+        IoFunc&& io_func,
+        void* buf,
+        size_t len,
+        TransferMode mode,
+        Deadline deadline,
+        const Context&... context
+    );
+
+    // PerformIoV counterpart of the io_uring-aware PerformIo
+    template <typename IoFunc, typename... Context>
+    size_t PerformIoV(
+        SingleUserGuard& guard,
+        sys_linux::IoUringOpcode opcode,
+        IoFunc&& io_func,
+        struct iovec* list,
+        std::size_t list_size,
+        TransferMode mode,
+        Deadline deadline,
+        const Context&... context
+    );
+
+    // For transfers that do not go through a user-space buffer, e.g. sendfile.
+    // (IoFunc*)(int, size_t processed_bytes, size_t len)
+    template <typename IoFunc, typename... Context>
+    size_t PerformRangeIo(
+        SingleUserGuard& guard,
+        IoFunc&& io_func,
+        size_t len,
+        TransferMode mode,
+        Deadline deadline,
+        const Context&... context
+    );
+
+    // nullptr if io_uring is not enabled for the ev thread or the fd is known
+    // to complete io_uring requests with EAGAIN
+    sys_linux::IoUring* GetIoUring() const noexcept { return is_io_uring_nonblocking_ ? nullptr : io_uring_; }
+
+    // To be called once io_uring completes a request on the fd with EAGAIN.
+    // The kernel honours O_NONBLOCK for some files (e.g. pipes) instead of
+    // waiting for them within the ring, so such requests would only add a
+    // round trip before the readiness wait.
+    void OnIoUringNonblocking() noexcept { is_io_uring_nonblocking_ = true; }
+
     engine::impl::ContextAccessor* TryGetContextAccessor() noexcept { return poller_.TryGetContextAccessor(); }
 
 private:
     friend class FdControl;
-    explicit Direction(const ev::ThreadControl& control) : poller_(control) {}
+    explicit Direction(const ev::ThreadControl& control);
 
-    void Reset(int fd, Kind kind) { poller_.Reset(fd, kind); }
+    void Reset(int fd, Kind kind) {
+        poller_.Reset(fd, kind);
+        is_io_uring_nonblocking_ = false;
+    }
 
     void WakeupWaiters() { poller_.WakeupWaiters(); }
 
@@ -116,7 +171,15 @@ private:
     ErrorMode
     TryHandleError(int error_code, size_t processed_bytes, TransferMode mode, Deadline deadline, Context&... context);
 
+    template <typename... Context>
+    [[noreturn]] static void ThrowInterrupted(size_t processed_bytes, const Context&... context);
+
+    // Consumes `offset` bytes from the head of `list`
+    static void AdvanceIoV(struct iovec*& list, std::size_t& list_size, std::size_t offset) noexcept;
+
     FdPoller poller_;
+    sys_linux::IoUring* const io_uring_;
+    bool is_io_uring_nonblocking_{false};
 };
 
 class FdControl final {
@@ -174,11 +237,7 @@ ErrorMode Direction::TryHandleError(
             throw(IoCancelled(/*bytes_transferred =*/processed_bytes) << ... << context);
         }
         if (!poller_.Wait(deadline)) {
-            if (current_task::ShouldCancel()) {
-                throw(IoCancelled(/*bytes_transferred =*/processed_bytes) << ... << context);
-            } else {
-                throw(IoTimeout(/*bytes_transferred =*/processed_bytes) << ... << context);
-            }
+            ThrowInterrupted(processed_bytes, context...);
         }
         if (!IsValid()) {
             throw((IoException() << "Fd closed during ") << ... << context);
@@ -201,6 +260,31 @@ ErrorMode Direction::TryHandleError(
     return ErrorMode::kProcessed;
 }
 
+template <typename... Context>
+void Direction::ThrowInterrupted(size_t processed_bytes, const Context&... context) {
+    if (current_task::ShouldCancel()) {
+        throw(IoCancelled(/*bytes_transferred =*/processed_bytes) << ... << context);
+    } else {
+        throw(IoTimeout(/*bytes_transferred =*/processed_bytes) << ... << context);
+    }
+}
+
+inline void Direction::AdvanceIoV(struct iovec*& list, std::size_t& list_size, std::size_t offset) noexcept {
+    while (list_size > 0) {
+        const std::size_t len = list->iov_len;
+        if (offset >= len) {
+            ++list;
+            offset -= len;
+            --list_size;
+            UASSERT(list_size != 0 || offset == 0);
+        } else {
+            list->iov_len -= offset;
+            list->iov_base = static_cast<char*>(list->iov_base) + offset;
+            break;
+        }
+    }
+}
+
 template <typename IoFunc, typename... Context>
 size_t Direction::PerformIoV(
     SingleUserGuard&,
@@ -222,20 +306,7 @@ size_t Direction::PerformIoV(
             if (mode == TransferMode::kOnce) {
                 break;
             }
-            std::size_t offset = chunk_size;
-            while (list_size > 0) {
-                const std::size_t len = list->iov_len;
-                if (offset >= len) {
-                    ++list;
-                    offset -= len;
-                    --list_size;
-                    UASSERT(list_size != 0 || offset == 0);
-                } else {
-                    list->iov_len -= offset;
-                    list->iov_base = static_cast<char*>(list->iov_base) + offset;
-                    break;
-                }
-            }
+            AdvanceIoV(list, list_size, chunk_size);
         } else if (!chunk_size || TryHandleError(errno, processed_bytes, mode, deadline, context...) == ErrorMode::kFatal) {
             break;
         }
@@ -273,6 +344,146 @@ size_t Direction::PerformIo(
     return pos - begin;
 }
 
+template <typename IoFunc, typename... Context>
+size_t Direction::PerformRangeIo(
+    SingleUserGuard&,
+    IoFunc&& io_func,
+    size_t len,
+    TransferMode mode,
+    Deadline deadline,
+    const Context&... context
+) {
+    size_t processed_bytes = 0;
+
+    while (processed_bytes < len) {
+        auto chunk_size = io_func(Fd(), processed_bytes, len - processed_bytes);
+
+        if (chunk_size > 0) {
+            processed_bytes += chunk_size;
+            if (mode == TransferMode::kOnce) {
+                break;
+            }
+        } else if (!chunk_size ||
+                   TryHandleError(errno, processed_bytes, mode, deadline, context...) == ErrorMode::kFatal) {
+            break;
+        }
+    }
+    return processed_bytes;
+}
+
+template <typename IoFunc, typename... Context>
+size_t Direction::PerformIo(
+    SingleUserGuard& guard,
+    sys_linux::IoUringOpcode opcode,
+    IoFunc&& io_func,
+    void* buf,
+    size_t len,
+    TransferMode mode,
+    Deadline deadline,
+    const Context&... context
+) {
+    if (!GetIoUring() || mode == TransferMode::kPartial) {
+        return PerformIo(guard, std::forward<IoFunc>(io_func), buf, len, mode, deadline, context...);
+    }
+
+    char* const begin = static_cast<char*>(buf);
+    char* const end = begin + len;
+
+    char* pos = begin;
+
+    while (pos < end) {
+        sys_linux::IoUringCompletion completion;
+        if (!is_io_uring_nonblocking_) {
+            completion = io_uring_->Transfer(opcode, Fd(), pos, end - pos, deadline);
+        }
+
+        ssize_t chunk_size = -1;
+        int error_code = 0;
+        switch (completion.status) {
+            case sys_linux::IoUringCompletion::Status::kCompleted:
+                chunk_size = completion.result < 0 ? -1 : completion.result;
+                error_code = -completion.result;
+                if (error_code == EAGAIN) {
+                    OnIoUringNonblocking();
+                }
+                break;
+            case sys_linux::IoUringCompletion::Status::kInterrupted:
+                ThrowInterrupted(pos - begin, context...);
+            case sys_linux::IoUringCompletion::Status::kNotSubmitted:
+                chunk_size = io_func(Fd(), pos, end - pos);
+                error_code = errno;
+                break;
+        }
+
+        if (chunk_size > 0) {
+            pos += chunk_size;
+            if (mode == TransferMode::kOnce) {
+                break;
+            }
+        } else if (!chunk_size ||
+                   TryHandleError(error_code, pos - begin, mode, deadline, context...) == ErrorMode::kFatal) {
+            break;
+        }
+    }
+    return pos - begin;
+}
+
+template <typename IoFunc, typename... Context>
+size_t Direction::PerformIoV(
+    SingleUserGuard& guard,
+    sys_linux::IoUringOpcode opcode,
+    IoFunc&& io_func,
+    struct iovec* list,
+    std::size_t list_size,
+    TransferMode mode,
+    Deadline deadline,
+    const Context&... context
+) {
+    if (!GetIoUring() || mode == TransferMode::kPartial) {
+        return PerformIoV(guard, std::forward<IoFunc>(io_func), list, list_size, mode, deadline, context...);
+    }
+
+    UASSERT(list_size > 0);
+    UASSERT(list_size <= IOV_MAX);
+    std::size_t processed_bytes = 0;
+    do {
+        sys_linux::IoUringCompletion completion;
+        if (!is_io_uring_nonblocking_) {
+            completion = io_uring_->TransferV(opcode, Fd(), list, list_size, deadline);
+        }
+
+        ssize_t chunk_size = -1;
+        int error_code = 0;
+        switch (completion.status) {
+            case sys_linux::IoUringCompletion::Status::kCompleted:
+                chunk_size = completion.result < 0 ? -1 : completion.result;
+                error_code = -completion.result;
+                if (error_code == EAGAIN) {
+                    OnIoUringNonblocking();
+                }
+                break;
+            case sys_linux::IoUringCompletion::Status::kInterrupted:
+                ThrowInterrupted(processed_bytes, context...);
+            case sys_linux::IoUringCompletion::Status::kNotSubmitted:
+                chunk_size = io_func(Fd(), list, list_size);
+                error_code = errno;
+                break;
+        }
+
+        if (chunk_size > 0) {
+            processed_bytes += chunk_size;
+            if (mode == TransferMode::kOnce) {
+                break;
+            }
+            AdvanceIoV(list, list_size, chunk_size);
+        } else if (!chunk_size ||
+                   TryHandleError(error_code, processed_bytes, mode, deadline, context...) == ErrorMode::kFatal) {
+            break;
+        }
+    } while (list_size != 0);
+    return processed_bytes;
+}
+
 }  // namespace engine::io::impl
 
 USERVER_NAMESPACE_END
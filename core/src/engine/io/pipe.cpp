@@ -61,7 +61,16 @@ size_t PipeReader::ReadAll(void* buf, size_t len, Deadline deadline) {
     }
     auto& dir = fd_control_->Read();
     impl::Direction::SingleUserGuard guard(dir);
-    return dir.PerformIo(guard, &::read, buf, len, impl::TransferMode::kWhole, deadline, "ReadAll from pipe");
+    return dir.PerformIo(
+        guard,
+        sys_linux::IoUringOpcode::kRead,
+        &::read,
+        buf,
+        len,
+        impl::TransferMode::kWhole,
+        deadline,
+        "ReadAll from pipe"
+    );
 }
 
 int PipeReader::Fd() const { return fd_control_ ? fd_control_->Fd() : kInvalidFd; }
@@ -94,7 +103,16 @@ size_t PipeWriter::WriteAll(const void* buf, size_t len, Deadline deadline) {
     impl::Direction::SingleUserGuard guard(dir);
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
     void* nonconst_buf = const_cast<void*>(buf);
-    return dir.PerformIo(guard, &::write, nonconst_buf, len, impl::TransferMode::kWhole, deadline, "WriteAll to pipe");
+    return dir.PerformIo(
+        guard,
+        sys_linux::IoUringOpcode::kWrite,
+        &::write,
+        nonconst_buf,
+        len,
+        impl::TransferMode::kWhole,
+        deadline,
+        "WriteAll to pipe"
+    );
 }
 
 int PipeWriter::Fd() const { return fd_control_ ? fd_control_->Fd() : kInvalidFd; }
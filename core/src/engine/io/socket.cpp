@@ -1,11 +1,17 @@
 #include <userver/engine/io/socket.hpp>
 
 #include <fcntl.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 #include <sys/socket.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <array>
 #include <cerrno>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -25,6 +31,13 @@ namespace {
 
 constexpr size_t kMaxStackSizeVector = 32;
 
+// MAC_COMPAT: no accept4 flags, io_uring is not available anyway
+#ifdef SOCK_NONBLOCK
+constexpr int kIoUringAcceptFlags = SOCK_NONBLOCK | SOCK_CLOEXEC;
+#else
+constexpr int kIoUringAcceptFlags = 0;
+#endif
+
 // MAC_COMPAT: does not accept flags in type
 impl::FdControlHolder MakeSocket(AddrDomain domain, SocketType type) {
     return impl::FdControl::Adopt(utils::CheckSyscallCustomException<IoSystemError>(
@@ -117,6 +130,29 @@ private:
     const Sockaddr& dest_addr_;
 };
 
+class SendFileWrapper {
+public:
+    SendFileWrapper(int file_fd, std::size_t offset) : file_fd_(file_fd), offset_(offset) {}
+
+    [[nodiscard]] ssize_t operator()(int fd, std::size_t processed_bytes, std::size_t len) const {
+        auto offset = static_cast<off_t>(offset_ + processed_bytes);
+#ifdef __linux__
+        return ::sendfile(fd, file_fd_, &offset, len);
+#else
+        // MAC_COMPAT: sendfile has a different signature and semantics, so read
+        // a chunk and send as much of it as the socket accepts
+        std::array<char, 64 * 1024> buffer;
+        const auto read = ::pread(file_fd_, buffer.data(), std::min(len, buffer.size()), offset);
+        if (read <= 0) return read;
+        return SendWrapper(fd, buffer.data(), read);
+#endif
+    }
+
+private:
+    const int file_fd_;
+    const std::size_t offset_;
+};
+
 void FillIoSendData(const IoData* data, struct iovec* dst, std::size_t count) {
     UASSERT(data);
     UASSERT(count > 0);
@@ -167,12 +203,33 @@ void Socket::Connect(const Sockaddr& addr, Deadline deadline) {
 
     peername_ = addr;
 
-    if (!::connect(Fd(), addr.Data(), addr.Size())) {
-        return;
+    std::optional<int> io_uring_error;
+    if (auto* io_uring = fd_control_->Write().GetIoUring()) {
+        const auto completion = io_uring->Connect(Fd(), addr.Data(), addr.Size(), deadline);
+        switch (completion.status) {
+            case sys_linux::IoUringCompletion::Status::kCompleted:
+                io_uring_error = -completion.result;
+                break;
+            case sys_linux::IoUringCompletion::Status::kInterrupted:
+                if (current_task::ShouldCancel()) {
+                    throw IoCancelled() << "Connect to " << addr;
+                }
+                throw IoTimeout() << "Connect to " << addr;
+            case sys_linux::IoUringCompletion::Status::kNotSubmitted:
+                break;
+        }
+    }
+
+    int err_value = 0;
+    if (io_uring_error) {
+        err_value = *io_uring_error;
+    } else if (::connect(Fd(), addr.Data(), addr.Size()) != 0) {
+        err_value = errno;
     }
 
-    int err_value = errno;
-    if (err_value == EINPROGRESS) {
+    // The connection may still be in progress, e.g. if the io_uring request
+    // was completed in the nonblocking mode
+    if (err_value == EINPROGRESS || err_value == EALREADY) {
         if (!WaitWriteable(deadline)) {
             if (current_task::ShouldCancel()) {
                 throw IoCancelled() << "Connect to " << addr;
@@ -241,7 +298,15 @@ size_t Socket::RecvSome(void* buf, size_t len, Deadline deadline) {
     dir.ResetReady();
     impl::Direction::SingleUserGuard guard(dir);
     return dir.PerformIo(
-        guard, &RecvWrapper, buf, len, impl::TransferMode::kOnce, deadline, "RecvSome from ", peername_
+        guard,
+        sys_linux::IoUringOpcode::kRecv,
+        &RecvWrapper,
+        buf,
+        len,
+        impl::TransferMode::kOnce,
+        deadline,
+        "RecvSome from ",
+        peername_
     );
 }
 
@@ -253,7 +318,15 @@ size_t Socket::RecvAll(void* buf, size_t len, Deadline deadline) {
     dir.ResetReady();
     impl::Direction::SingleUserGuard guard(dir);
     return dir.PerformIo(
-        guard, &RecvWrapper, buf, len, impl::TransferMode::kWhole, deadline, "RecvAll from ", peername_
+        guard,
+        sys_linux::IoUringOpcode::kRecv,
+        &RecvWrapper,
+        buf,
+        len,
+        impl::TransferMode::kWhole,
+        deadline,
+        "RecvAll from ",
+        peername_
     );
 }
 
@@ -309,6 +382,7 @@ size_t Socket::SendAll(const struct iovec* list, std::size_t list_size, Deadline
     impl::Direction::SingleUserGuard guard(dir);
     return dir.PerformIoV(
         guard,
+        sys_linux::IoUringOpcode::kSendmsg,
         &writev,
         const_cast<struct iovec*>(list),  // NOLINT(cppcoreguidelines-pro-type-const-cast)
         list_size,
@@ -328,6 +402,7 @@ size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
     impl::Direction::SingleUserGuard guard(dir);
     return dir.PerformIo(
         guard,
+        sys_linux::IoUringOpcode::kSend,
         &SendWrapper,
         const_cast<void*>(buf),  // NOLINT(cppcoreguidelines-pro-type-const-cast)
         len,
@@ -338,6 +413,24 @@ size_t Socket::SendAll(const void* buf, size_t len, Deadline deadline) {
     );
 }
 
+size_t Socket::SendFile(int file_fd, std::size_t offset, std::size_t len, Deadline deadline) {
+    if (!IsValid()) {
+        throw IoException("Attempt to SendFile to closed socket");
+    }
+    auto& dir = fd_control_->Write();
+    dir.ResetReady();
+    impl::Direction::SingleUserGuard guard(dir);
+    return dir.PerformRangeIo(
+        guard,
+        SendFileWrapper{file_fd, offset},
+        len,
+        impl::TransferMode::kWhole,
+        deadline,
+        "SendFile to ",
+        peername_
+    );
+}
+
 Socket::RecvFromResult Socket::RecvSomeFrom(void* buf, size_t len, Deadline deadline) {
     if (!IsValid()) {
         throw IoException("Attempt to RecvSomeFrom via closed socket");
@@ -393,12 +486,36 @@ Socket Socket::Accept(Deadline deadline) {
         Sockaddr buf;
         auto len = buf.Capacity();
 
+        int fd = -1;
+        sys_linux::IoUringCompletion completion;
+        if (auto* io_uring = dir.GetIoUring()) {
+            completion = io_uring->Accept(dir.Fd(), buf.Data(), &len, kIoUringAcceptFlags, deadline);
+        }
+        switch (completion.status) {
+            case sys_linux::IoUringCompletion::Status::kCompleted:
+                if (completion.result >= 0) {
+                    fd = completion.result;
+                } else {
+                    errno = -completion.result;
+                    if (errno == EAGAIN) {
+                        dir.OnIoUringNonblocking();
+                    }
+                }
+                break;
+            case sys_linux::IoUringCompletion::Status::kInterrupted:
+                if (current_task::ShouldCancel()) {
+                    throw IoCancelled() << "Accept";
+                }
+                throw IoTimeout() << "Accept";
+            case sys_linux::IoUringCompletion::Status::kNotSubmitted:
 // MAC_COMPAT: no accept4
 #ifdef HAVE_ACCEPT4
-        int fd = ::accept4(dir.Fd(), buf.Data(), &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                fd = ::accept4(dir.Fd(), buf.Data(), &len, SOCK_NONBLOCK | SOCK_CLOEXEC);
 #else
-        int fd = ::accept(dir.Fd(), buf.Data(), &len);
+                fd = ::accept(dir.Fd(), buf.Data(), &len);
 #endif
+                break;
+        }
 
         UASSERT(len <= buf.Capacity());
         if (fd != -1) {
@@ -23,10 +23,18 @@ namespace {
 
 constexpr auto kDeadlineMaxTime = std::chrono::seconds{60};
 
+// Benchmarks with the `io_uring:1` argument perform I/O through io_uring,
+// falling back to the ev I/O if the kernel does not support it
+engine::TaskProcessorPoolsConfig MakePoolsConfig(const benchmark::State& state) {
+    engine::TaskProcessorPoolsConfig config;
+    config.ev_io_uring_enabled = state.range(0) != 0;
+    return config;
+}
+
 }  // namespace
 
 void socket_send_all(benchmark::State& state) {
-    engine::RunStandalone([&]() {
+    engine::RunStandalone(1, MakePoolsConfig(state), [&]() {
         const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
         internal::net::TcpListener listener;
         auto [server, client] = listener.MakeSocketPair(test_deadline);
@@ -49,10 +57,10 @@ void socket_send_all(benchmark::State& state) {
         task_reader.Get();
     });
 }
-BENCHMARK(socket_send_all);
+BENCHMARK(socket_send_all)->ArgName("io_uring")->Arg(0)->Arg(1);
 
 void socket_send_all_v(benchmark::State& state) {
-    engine::RunStandalone([&]() {
+    engine::RunStandalone(1, MakePoolsConfig(state), [&]() {
         const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
         internal::net::TcpListener listener;
         auto [server, client] = listener.MakeSocketPair(test_deadline);
@@ -73,7 +81,35 @@ void socket_send_all_v(benchmark::State& state) {
         task_reader.Get();
     });
 }
-BENCHMARK(socket_send_all_v);
+BENCHMARK(socket_send_all_v)->ArgName("io_uring")->Arg(0)->Arg(1);
+
+// Every recv has to wait for the data, which is the case the I/O backends
+// differ the most in
+void socket_ping_pong(benchmark::State& state) {
+    engine::RunStandalone(2, MakePoolsConfig(state), [&]() {
+        const auto test_deadline = Deadline::FromDuration(kDeadlineMaxTime);
+        internal::net::TcpListener listener;
+        auto [server, client] = listener.MakeSocketPair(test_deadline);
+        auto task_echo = engine::AsyncNoSpan(
+            [test_deadline](auto&& server) {
+                char c = 0;
+                while (server.RecvSome(&c, 1, test_deadline) > 0) {
+                    [[maybe_unused]] const auto sent_bytes = server.SendAll(&c, 1, test_deadline);
+                }
+            },
+            std::move(server)
+        );
+        for ([[maybe_unused]] auto _ : state) {
+            char c = 'x';
+            auto bytes = client.SendAll(&c, 1, test_deadline);
+            bytes += client.RecvAll(&c, 1, test_deadline);
+            benchmark::DoNotOptimize(bytes);
+        }
+        client.Close();
+        task_echo.Get();
+    });
+}
+BENCHMARK(socket_ping_pong)->ArgName("io_uring")->Arg(0)->Arg(1);
 
 [[maybe_unused]] void socket_send_all_v_range(benchmark::State& state) {
     engine::RunStandalone(2, [&]() {
@@ -15,9 +15,13 @@
 #include <userver/engine/io/sockaddr.hpp>
 #include <userver/engine/io/socket.hpp>
 #include <userver/engine/mutex.hpp>
+#include <userver/engine/run_standalone.hpp>
 #include <userver/engine/single_consumer_event.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/engine/wait_any.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/internal/net/net_listener.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -29,6 +33,12 @@ using Deadline = engine::Deadline;
 using TcpListener = internal::net::TcpListener;
 using UdpListener = internal::net::UdpListener;
 
+engine::TaskProcessorPoolsConfig MakeIoUringPoolsConfig() {
+    engine::TaskProcessorPoolsConfig config;
+    config.ev_io_uring_enabled = true;
+    return config;
+}
+
 }  // namespace
 
 UTEST(Socket, ConnectFail) {
@@ -193,6 +203,32 @@ UTEST(Socket, SendAllVector) {
     EXPECT_EQ(bytes_sent, bytes_read);
 }
 
+UTEST(Socket, SendFile) {
+    const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    const auto file = fs::blocking::TempFile::Create();
+    const std::string contents(100 * 1024, 'x');
+    fs::blocking::RewriteFileContents(file.GetPath(), "head" + contents + "tail");
+    auto fd = fs::blocking::FileDescriptor::Open(file.GetPath(), fs::blocking::OpenFlag::kRead);
+
+    TcpListener listener;
+    auto sockets = listener.MakeSocketPair(deadline);
+    auto listen_task = engine::AsyncNoSpan([&sockets, &deadline, &contents] {
+        std::string buf(contents.size() + 4, '\0');
+        EXPECT_EQ(sockets.first.ReadAll(buf.data(), buf.size(), deadline), buf.size());
+        EXPECT_EQ(buf, contents + "tail");
+    });
+
+    EXPECT_EQ(sockets.second.SendFile(fd.GetNative(), 4, contents.size() + 4, deadline), contents.size() + 4);
+    listen_task.Get();
+
+    // The range is clamped by the end of file
+    EXPECT_EQ(sockets.second.SendFile(fd.GetNative(), contents.size() + 6, 100, deadline), 2);
+    std::array<char, 2> tail{};
+    EXPECT_EQ(sockets.first.ReadAll(tail.data(), tail.size(), deadline), 2);
+    EXPECT_EQ(std::string_view(tail.data(), tail.size()), "il");
+}
+
 UTEST(Socket, WaitAnyRead) {
     const auto deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
     TcpListener listener;
@@ -483,4 +519,61 @@ UTEST(Socket, WriteALot) {
     }
 }
 
+// Falls back to the ev I/O if io_uring is not available in the environment,
+// the behavior must be the same anyway
+TEST(Socket, IoUringSendRecv) {
+    engine::RunStandalone(2, MakeIoUringPoolsConfig(), [] {
+        const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+        TcpListener listener;
+        auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+        auto echo_task = engine::AsyncNoSpan([&server = server, test_deadline] {
+            std::array<char, 10> buf{};
+            EXPECT_EQ(server.RecvAll(buf.data(), buf.size(), test_deadline), buf.size());
+            EXPECT_EQ(server.SendAll(buf.data(), buf.size(), test_deadline), buf.size());
+        });
+
+        EXPECT_EQ(client.SendAll({{"chunk", 5}, {"CHUNK", 5}}, test_deadline), 10);
+
+        std::array<char, 10> buf{};
+        EXPECT_EQ(client.RecvAll(buf.data(), buf.size(), test_deadline), buf.size());
+        EXPECT_EQ(std::string_view(buf.data(), buf.size()), "chunkCHUNK");
+        echo_task.Get();
+
+        server.Close();
+        EXPECT_EQ(client.RecvSome(buf.data(), buf.size(), test_deadline), 0);
+    });
+}
+
+TEST(Socket, IoUringInterrupted) {
+    engine::RunStandalone(1, MakeIoUringPoolsConfig(), [] {
+        const auto test_deadline = Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+        TcpListener listener;
+        auto [server, client] = listener.MakeSocketPair(test_deadline);
+
+        std::array<char, 16> buf{};
+        UEXPECT_THROW(
+            [[maybe_unused]] auto received =
+                server.RecvSome(buf.data(), buf.size(), Deadline::FromDuration(std::chrono::milliseconds{10})),
+            io::IoTimeout
+        );
+
+        engine::SingleConsumerEvent has_started_event;
+        auto recv_task = engine::AsyncNoSpan([&server = server, &buf, &has_started_event, test_deadline] {
+            has_started_event.Send();
+            return server.RecvAll(buf.data(), buf.size(), test_deadline);
+        });
+        ASSERT_TRUE(has_started_event.WaitForEvent());
+        recv_task.RequestCancel();
+        UEXPECT_THROW(recv_task.Get(), io::IoCancelled);
+
+        // The socket is still usable after the interrupted requests
+        EXPECT_EQ(client.SendAll("data", 4, test_deadline), 4);
+        EXPECT_EQ(server.RecvSome(buf.data(), buf.size(), test_deadline), 4);
+        EXPECT_EQ(std::string_view(buf.data(), 4), "data");
+    });
+}
+
 USERVER_NAMESPACE_END
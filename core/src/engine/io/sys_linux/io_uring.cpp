@@ -0,0 +1,513 @@
+#include <engine/io/sys_linux/io_uring.hpp>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define USERVER_IMPL_HAS_IO_URING
+#endif
+
+#include <userver/logging/log.hpp>
+
+#ifdef USERVER_IMPL_HAS_IO_URING
+
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+#include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/utils/assert.hpp>
+
+#include <engine/impl/future_utils.hpp>
+#include <engine/impl/wait_list_light.hpp>
+#include <engine/task/task_context.hpp>
+
+// Goes last, as it drags in linux/fs.h macros (e.g. BLOCK_SIZE) that clash
+// with identifiers in the headers above
+#include <linux/io_uring.h>
+
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::sys_linux {
+
+#ifdef USERVER_IMPL_HAS_IO_URING
+
+namespace {
+
+// RW_CUR_POS implies a 5.6+ kernel, which has all the opcodes we use
+constexpr std::uint32_t kRequiredFeatures = IORING_FEAT_NODROP | IORING_FEAT_RW_CUR_POS;
+
+// io_uring_cqe::res is a signed 32-bit integer, so a single transfer is capped
+constexpr std::size_t kMaxTransferSize = 1 << 30;
+
+// Completions of the requests nobody waits for (e.g. cancellations)
+constexpr std::uint64_t kIgnoredUserData = 0;
+
+// Offset for read/write requests meaning "use the current file position"
+constexpr std::uint64_t kCurrentPosition = std::numeric_limits<std::uint64_t>::max();
+
+constexpr std::chrono::milliseconds kCancelRetryInterval{1};
+
+int IoUringSetup(unsigned entries, io_uring_params& params) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int IoUringEnter(int ring_fd, unsigned to_submit, unsigned flags) noexcept {
+    int ret = -1;
+    do {
+        ret = static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, to_submit, 0, flags, nullptr, 0));
+    } while (ret == -1 && errno == EINTR);
+    return ret;
+}
+
+int IoUringRegister(int ring_fd, unsigned opcode, const void* arg, unsigned nr_args) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_register, ring_fd, opcode, arg, nr_args));
+}
+
+class Mapping final {
+public:
+    Mapping() noexcept = default;
+
+    Mapping(int fd, std::size_t size, off_t offset) noexcept
+        : size_(size),
+          ptr_(::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, offset)) {}
+
+    Mapping(Mapping&& other) noexcept
+        : size_(std::exchange(other.size_, 0)), ptr_(std::exchange(other.ptr_, MAP_FAILED)) {}
+
+    Mapping& operator=(Mapping&& other) noexcept {
+        std::swap(size_, other.size_);
+        std::swap(ptr_, other.ptr_);
+        return *this;
+    }
+
+    ~Mapping() {
+        if (ptr_ != MAP_FAILED) ::munmap(ptr_, size_);
+    }
+
+    bool IsValid() const noexcept { return ptr_ != MAP_FAILED; }
+
+    template <typename T>
+    T* At(std::uint32_t offset) const noexcept {
+        UASSERT(IsValid());
+        return reinterpret_cast<T*>(static_cast<char*>(ptr_) + offset);
+    }
+
+private:
+    std::size_t size_{0};
+    void* ptr_{MAP_FAILED};
+};
+
+template <typename T>
+T LoadAcquire(const T* ptr) noexcept {
+    return __atomic_load_n(ptr, __ATOMIC_ACQUIRE);
+}
+
+// The SQ tail is published and re-checked around the is_submitting_ flag,
+// which requires a single total order of these operations
+template <typename T>
+T LoadSeqCst(const T* ptr) noexcept {
+    return __atomic_load_n(ptr, __ATOMIC_SEQ_CST);
+}
+
+template <typename T>
+bool CompareExchangeSeqCst(T* ptr, T& expected, T desired) noexcept {
+    return __atomic_compare_exchange_n(ptr, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+std::uint8_t ToSqeOpcode(IoUringOpcode opcode) {
+    switch (opcode) {
+        case IoUringOpcode::kRecv:
+            return IORING_OP_RECV;
+        case IoUringOpcode::kSend:
+            return IORING_OP_SEND;
+        case IoUringOpcode::kRead:
+            return IORING_OP_READ;
+        case IoUringOpcode::kWrite:
+            return IORING_OP_WRITE;
+        case IoUringOpcode::kReadv:
+            return IORING_OP_READV;
+        case IoUringOpcode::kWritev:
+            return IORING_OP_WRITEV;
+        case IoUringOpcode::kSendmsg:
+            return IORING_OP_SENDMSG;
+    }
+    UINVARIANT(false, "Unexpected io_uring opcode " + std::to_string(static_cast<int>(opcode)));
+}
+
+}  // namespace
+
+struct IoUring::Rings final {
+    Mapping sq_ring;
+    Mapping cq_ring;  // invalid if the kernel maps both rings at once
+    Mapping sqes_mapping;
+
+    const unsigned* sq_head{nullptr};
+    unsigned* sq_tail{nullptr};
+    unsigned sq_entries{0};
+    const unsigned* sq_ring_mask{nullptr};
+    const unsigned* sq_flags{nullptr};
+    unsigned* sq_array{nullptr};
+    io_uring_sqe* sqes{nullptr};
+    // Position + 1 of the last SQ entry filled in each slot, entries are
+    // exposed to the kernel only when all the preceding ones are filled
+    std::unique_ptr<std::atomic<unsigned>[]> sq_published;
+
+    unsigned* cq_head{nullptr};
+    const unsigned* cq_tail{nullptr};
+    const unsigned* cq_ring_mask{nullptr};
+    const io_uring_cqe* cqes{nullptr};
+};
+
+class IoUring::Operation final : public engine::impl::ContextAccessor {
+public:
+    Operation() = default;
+
+    bool IsReady() const noexcept override { return waiters_->IsSignaled(); }
+
+    engine::impl::EarlyWakeup TryAppendWaiter(engine::impl::TaskContext& waiter) override {
+        return engine::impl::EarlyWakeup{waiters_->GetSignalOrAppend(&waiter)};
+    }
+
+    void RemoveWaiter(engine::impl::TaskContext& waiter) noexcept override { waiters_->Remove(waiter); }
+
+    void AfterWait() noexcept override {}
+
+    void RethrowErrorResult() const override {}
+
+    std::uint64_t GetUserData() noexcept { return reinterpret_cast<std::uintptr_t>(this); }
+
+    std::int32_t GetResult() const noexcept {
+        UASSERT(IsReady());
+        return result_;
+    }
+
+    // The operation may be destroyed by the awaiting task right after this call
+    void Complete(std::int32_t result) noexcept {
+        result_ = result;
+        waiters_->SetSignalAndWakeupOne();
+    }
+
+private:
+    std::int32_t result_{0};
+    engine::impl::FastPimplWaitListLight waiters_;
+};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(std::size_t entries) noexcept {
+    io_uring_params params{};
+    const int ring_fd = IoUringSetup(static_cast<unsigned>(entries), params);
+    if (ring_fd == -1) {
+        const std::error_code ec(errno, std::system_category());
+        LOG_WARNING() << "io_uring is unavailable, falling back to the ev I/O: " << ec.message();
+        return {};
+    }
+    if ((params.features & kRequiredFeatures) != kRequiredFeatures) {
+        LOG_WARNING() << "io_uring lacks the required features (kernel is older than 5.6), "
+                         "falling back to the ev I/O";
+        ::close(ring_fd);
+        return {};
+    }
+
+    auto rings = std::make_unique<Rings>();
+    const auto sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    const auto cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool is_single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+
+    rings->sq_ring =
+        Mapping(ring_fd, is_single_mmap ? std::max(sq_ring_size, cq_ring_size) : sq_ring_size, IORING_OFF_SQ_RING);
+    if (!is_single_mmap) {
+        rings->cq_ring = Mapping(ring_fd, cq_ring_size, IORING_OFF_CQ_RING);
+    }
+    rings->sqes_mapping = Mapping(ring_fd, params.sq_entries * sizeof(io_uring_sqe), IORING_OFF_SQES);
+
+    const auto& cq_ring = is_single_mmap ? rings->sq_ring : rings->cq_ring;
+    const int event_fd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (!rings->sq_ring.IsValid() || !cq_ring.IsValid() || !rings->sqes_mapping.IsValid() || event_fd == -1 ||
+        IoUringRegister(ring_fd, IORING_REGISTER_EVENTFD, &event_fd, 1) == -1) {
+        const std::error_code ec(errno, std::system_category());
+        LOG_WARNING() << "Failed to set up io_uring, falling back to the ev I/O: " << ec.message();
+        if (event_fd != -1) ::close(event_fd);
+        rings.reset();
+        ::close(ring_fd);
+        return {};
+    }
+
+    const auto& sq_ring = rings->sq_ring;
+    rings->sq_head = sq_ring.At<const unsigned>(params.sq_off.head);
+    rings->sq_tail = sq_ring.At<unsigned>(params.sq_off.tail);
+    rings->sq_entries = params.sq_entries;
+    rings->sq_ring_mask = sq_ring.At<const unsigned>(params.sq_off.ring_mask);
+    rings->sq_flags = sq_ring.At<const unsigned>(params.sq_off.flags);
+    rings->sq_array = sq_ring.At<unsigned>(params.sq_off.array);
+    rings->sqes = rings->sqes_mapping.At<io_uring_sqe>(0);
+    rings->sq_published = std::make_unique<std::atomic<unsigned>[]>(params.sq_entries);
+
+    rings->cq_head = cq_ring.At<unsigned>(params.cq_off.head);
+    rings->cq_tail = cq_ring.At<const unsigned>(params.cq_off.tail);
+    rings->cq_ring_mask = cq_ring.At<const unsigned>(params.cq_off.ring_mask);
+    rings->cqes = cq_ring.At<const io_uring_cqe>(params.cq_off.cqes);
+
+    LOG_INFO() << "io_uring is set up with " << params.sq_entries << " submission entries";
+    return std::unique_ptr<IoUring>(new IoUring(ring_fd, event_fd, std::move(rings)));
+}
+
+IoUring::IoUring(int ring_fd, int event_fd, std::unique_ptr<Rings> rings) noexcept
+    : ring_fd_(ring_fd), event_fd_(event_fd), rings_(std::move(rings)), sq_reserved_(*rings_->sq_tail) {}
+
+IoUring::~IoUring() {
+    // All the operations are awaited by their submitters, so there can be only
+    // ignored completions left
+    ::close(ring_fd_);
+    ::close(event_fd_);
+}
+
+int IoUring::GetCompletionFd() const noexcept { return event_fd_; }
+
+void IoUring::ReapCompletions() noexcept {
+    std::uint64_t counter = 0;
+    [[maybe_unused]] const auto ret = ::read(event_fd_, &counter, sizeof(counter));
+
+    if (LoadAcquire(rings_->sq_flags) & IORING_SQ_CQ_OVERFLOW) {
+        // Flush the completions kept by the kernel due to CQ overflow
+        IoUringEnter(ring_fd_, 0, IORING_ENTER_GETEVENTS);
+    }
+    DoReapCompletions();
+
+    // The entries refused by the kernel on CQ overflow are still in the SQ
+    SubmitPending();
+}
+
+void IoUring::DoReapCompletions() noexcept {
+    auto& rings = *rings_;
+    unsigned head = LoadAcquire(rings.cq_head);
+    while (head != LoadAcquire(rings.cq_tail)) {
+        // The entry is read before claiming it, as the kernel may reuse it
+        // right after the head moves. If another reaper has claimed it first,
+        // the values are dropped and `head` is reloaded.
+        const auto& cqe = rings.cqes[head & *rings.cq_ring_mask];
+        const std::uint64_t user_data = cqe.user_data;
+        const std::int32_t result = cqe.res;
+        if (!CompareExchangeSeqCst(rings.cq_head, head, head + 1)) continue;
+        ++head;
+
+        if (user_data == kIgnoredUserData) continue;
+        // NOLINTNEXTLINE(performance-no-int-to-ptr)
+        reinterpret_cast<Operation*>(static_cast<std::uintptr_t>(user_data))->Complete(result);
+    }
+}
+
+template <typename Prepare>
+bool IoUring::TrySubmit(std::uint64_t user_data, Prepare&& prepare) noexcept {
+    auto& rings = *rings_;
+    unsigned position = sq_reserved_.load();
+    do {
+        if (position - LoadAcquire(rings.sq_head) >= rings.sq_entries) {
+            // The SQ is full of entries that are being submitted by other threads
+            return false;
+        }
+    } while (!sq_reserved_.compare_exchange_weak(position, position + 1));
+
+    const unsigned index = position & *rings.sq_ring_mask;
+    auto& sqe = rings.sqes[index];
+    sqe = io_uring_sqe{};
+    prepare(sqe);
+    sqe.user_data = user_data;
+    rings.sq_array[index] = index;
+    rings.sq_published[index].store(position + 1);
+
+    PublishSubmissions();
+    SubmitPending();
+    return true;
+}
+
+void IoUring::PublishSubmissions() noexcept {
+    auto& rings = *rings_;
+
+    // Moves the SQ tail over all the consecutive filled entries. Submitters do
+    // not wait for the preceding entries to be filled: the one who fills the
+    // entry at the tail publishes the following filled entries as well.
+    // Marking an entry filled and checking the tail are both sequentially
+    // consistent, so the entry is noticed either here or by its predecessor.
+    unsigned tail = LoadSeqCst(rings.sq_tail);
+    while (rings.sq_published[tail & *rings.sq_ring_mask].load() == tail + 1) {
+        if (CompareExchangeSeqCst(rings.sq_tail, tail, tail + 1)) ++tail;
+    }
+}
+
+void IoUring::SubmitPending() noexcept {
+    auto& rings = *rings_;
+
+    // Only one thread at a time enters the kernel and submits all the pending
+    // entries in a batch, the other submitters leave their entries to it.
+    // The submitter re-checks the SQ after dropping the flag, so an entry
+    // published meanwhile is not left behind.
+    while (LoadSeqCst(rings.sq_tail) != LoadAcquire(rings.sq_head) && !is_submitting_.exchange(true)) {
+        const unsigned pending = LoadSeqCst(rings.sq_tail) - LoadAcquire(rings.sq_head);
+        const bool is_failed = pending != 0 && IoUringEnter(ring_fd_, pending, 0) == -1;
+        is_submitting_.store(false);
+
+        if (is_failed) {
+            // The entries stay in the SQ (e.g. EBUSY on CQ overflow) and are
+            // submitted along with the next request or by ReapCompletions
+            const std::error_code ec(errno, std::system_category());
+            LOG_LIMITED_WARNING() << "io_uring submission failed: " << ec.message();
+            return;
+        }
+    }
+}
+
+template <typename Prepare>
+IoUringCompletion IoUring::Execute(Prepare&& prepare, Deadline deadline) {
+    Operation operation;
+    if (!TrySubmit(operation.GetUserData(), std::forward<Prepare>(prepare))) {
+        return {IoUringCompletion::Status::kNotSubmitted, 0};
+    }
+
+    // The kernel serves requests on ready fds inline, pick such completions up
+    // right away instead of bouncing through the ev thread
+    DoReapCompletions();
+
+    auto& current = current_task::GetCurrentTaskContext();
+    engine::impl::FutureWaitStrategy wait_strategy{operation, current};
+    if (current.Sleep(wait_strategy, deadline) != engine::impl::TaskContext::WakeupSource::kWaitList) {
+        CancelAndWait(operation);
+        if (operation.GetResult() == -ECANCELED || operation.GetResult() == -EINTR) {
+            return {IoUringCompletion::Status::kInterrupted, operation.GetResult()};
+        }
+    }
+    return {IoUringCompletion::Status::kCompleted, operation.GetResult()};
+}
+
+void IoUring::CancelAndWait(Operation& operation) noexcept {
+    // The kernel may still be using the buffers, so the request has to be
+    // completed before returning to the caller
+    const TaskCancellationBlocker cancellation_blocker;
+
+    const auto target = operation.GetUserData();
+    while (!operation.IsReady() && !TrySubmit(kIgnoredUserData, [target](io_uring_sqe& sqe) {
+        sqe.opcode = IORING_OP_ASYNC_CANCEL;
+        sqe.fd = -1;
+        sqe.addr = target;
+    })) {
+        engine::SleepFor(kCancelRetryInterval);
+    }
+    DoReapCompletions();
+
+    auto& current = current_task::GetCurrentTaskContext();
+    engine::impl::FutureWaitStrategy wait_strategy{operation, current};
+    [[maybe_unused]] const auto wakeup_source = current.Sleep(wait_strategy, Deadline{});
+    UASSERT(wakeup_source == engine::impl::TaskContext::WakeupSource::kWaitList);
+}
+
+IoUringCompletion IoUring::Transfer(IoUringOpcode opcode, int fd, void* buf, std::size_t len, Deadline deadline) {
+    UASSERT(opcode != IoUringOpcode::kReadv && opcode != IoUringOpcode::kWritev);
+    return Execute(
+        [&](io_uring_sqe& sqe) {
+            sqe.opcode = ToSqeOpcode(opcode);
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(buf);
+            sqe.len = static_cast<std::uint32_t>(std::min(len, kMaxTransferSize));
+            if (opcode == IoUringOpcode::kSend) {
+                sqe.msg_flags = MSG_NOSIGNAL;
+            } else if (opcode == IoUringOpcode::kRead || opcode == IoUringOpcode::kWrite) {
+                sqe.off = kCurrentPosition;
+            }
+        },
+        deadline
+    );
+}
+
+IoUringCompletion IoUring::TransferV(
+    IoUringOpcode opcode,
+    int fd,
+    const struct iovec* list,
+    std::size_t list_size,
+    Deadline deadline
+) {
+    UASSERT(
+        opcode == IoUringOpcode::kReadv || opcode == IoUringOpcode::kWritev || opcode == IoUringOpcode::kSendmsg
+    );
+    // Outlives the request, which is completed before Execute returns
+    struct msghdr message {};
+    message.msg_iov = const_cast<struct iovec*>(list);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    message.msg_iovlen = list_size;
+    return Execute(
+        [&](io_uring_sqe& sqe) {
+            sqe.opcode = ToSqeOpcode(opcode);
+            sqe.fd = fd;
+            if (opcode == IoUringOpcode::kSendmsg) {
+                sqe.addr = reinterpret_cast<std::uintptr_t>(&message);
+                sqe.len = 1;
+                sqe.msg_flags = MSG_NOSIGNAL;
+            } else {
+                sqe.addr = reinterpret_cast<std::uintptr_t>(list);
+                sqe.len = static_cast<std::uint32_t>(list_size);
+                sqe.off = kCurrentPosition;
+            }
+        },
+        deadline
+    );
+}
+
+IoUringCompletion
+IoUring::Accept(int fd, struct sockaddr* addr, socklen_t* addrlen, int flags, Deadline deadline) {
+    return Execute(
+        [&](io_uring_sqe& sqe) {
+            sqe.opcode = IORING_OP_ACCEPT;
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(addr);
+            sqe.addr2 = reinterpret_cast<std::uintptr_t>(addrlen);
+            sqe.accept_flags = static_cast<std::uint32_t>(flags);
+        },
+        deadline
+    );
+}
+
+IoUringCompletion IoUring::Connect(int fd, const struct sockaddr* addr, socklen_t addrlen, Deadline deadline) {
+    return Execute(
+        [&](io_uring_sqe& sqe) {
+            sqe.opcode = IORING_OP_CONNECT;
+            sqe.fd = fd;
+            sqe.addr = reinterpret_cast<std::uintptr_t>(addr);
+            sqe.off = addrlen;
+        },
+        deadline
+    );
+}
+
+#else  // USERVER_IMPL_HAS_IO_URING
+
+struct IoUring::Rings final {};
+
+std::unique_ptr<IoUring> IoUring::TryCreate(std::size_t) noexcept {
+    LOG_WARNING() << "io_uring is not supported on this platform, falling back to the ev I/O";
+    return {};
+}
+
+IoUring::~IoUring() = default;
+
+int IoUring::GetCompletionFd() const noexcept { return event_fd_; }
+
+void IoUring::ReapCompletions() noexcept {}
+
+IoUringCompletion IoUring::Transfer(IoUringOpcode, int, void*, std::size_t, Deadline) { return {}; }
+
+IoUringCompletion IoUring::TransferV(IoUringOpcode, int, const struct iovec*, std::size_t, Deadline) { return {}; }
+
+IoUringCompletion IoUring::Accept(int, struct sockaddr*, socklen_t*, int, Deadline) { return {}; }
+
+IoUringCompletion IoUring::Connect(int, const struct sockaddr*, socklen_t, Deadline) { return {}; }
+
+#endif  // USERVER_IMPL_HAS_IO_URING
+
+}  // namespace engine::io::sys_linux
+
+USERVER_NAMESPACE_END
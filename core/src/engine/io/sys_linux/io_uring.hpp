@@ -0,0 +1,120 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include <userver/engine/deadline.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::io::sys_linux {
+
+/// Data transfer requests supported by IoUring::Transfer and
+/// IoUring::TransferV
+enum class IoUringOpcode {
+    kRecv,    ///< recv(2), Transfer only
+    kSend,    ///< send(2) with MSG_NOSIGNAL, Transfer only
+    kRead,    ///< read(2), Transfer only
+    kWrite,   ///< write(2), Transfer only
+    kReadv,   ///< readv(2), TransferV only
+    kWritev,  ///< writev(2), TransferV only
+    /// sendmsg(2) with MSG_NOSIGNAL, TransferV only. Unlike kWritev, the
+    /// kernel waits for the socket within the ring even if it is nonblocking.
+    kSendmsg,
+};
+
+/// Outcome of a request executed by IoUring
+struct IoUringCompletion final {
+    enum class Status {
+        /// `result` holds the syscall result, negated errno on failure
+        kCompleted,
+        /// The wait was interrupted by deadline or task cancellation and the
+        /// request has been cancelled without transferring anything
+        kInterrupted,
+        /// The ring refused the request, the caller should fall back to the
+        /// readiness-based path
+        kNotSubmitted,
+    };
+
+    Status status{Status::kNotSubmitted};
+    std::int32_t result{0};
+};
+
+/// @brief Completion-based I/O backend built on Linux io_uring.
+///
+/// Requests are submitted directly from the calling coroutine, which is put
+/// to sleep until the request completes. Completions are reaped either by the
+/// submitting thread (for requests the kernel serves inline) or by the owning
+/// ev thread, that watches the completion eventfd.
+///
+/// All the request methods must be called from a coroutine and may be called
+/// from multiple threads simultaneously without taking locks: submitters
+/// reserve SQ entries and publish them with atomics, reapers claim completions
+/// one by one. Buffers passed to requests are guaranteed to be unused by the
+/// kernel once the method returns.
+class IoUring final {
+public:
+    /// @returns nullptr if io_uring is not supported by the kernel (or is
+    /// forbidden by seccomp) or lacks the required features
+    static std::unique_ptr<IoUring> TryCreate(std::size_t entries) noexcept;
+
+    IoUring(IoUring&&) = delete;
+    IoUring& operator=(IoUring&&) = delete;
+    ~IoUring();
+
+    /// The eventfd that becomes readable once there are completions to reap
+    int GetCompletionFd() const noexcept;
+
+    /// Reaps all the available completions and wakes up the corresponding
+    /// tasks. To be called by the ev thread on GetCompletionFd() readiness.
+    void ReapCompletions() noexcept;
+
+    IoUringCompletion Transfer(IoUringOpcode opcode, int fd, void* buf, std::size_t len, Deadline deadline);
+
+    IoUringCompletion
+    TransferV(IoUringOpcode opcode, int fd, const struct iovec* list, std::size_t list_size, Deadline deadline);
+
+    /// accept4(2) counterpart, `result` holds the new fd on success
+    IoUringCompletion Accept(int fd, struct sockaddr* addr, socklen_t* addrlen, int flags, Deadline deadline);
+
+    IoUringCompletion Connect(int fd, const struct sockaddr* addr, socklen_t addrlen, Deadline deadline);
+
+private:
+    class Operation;
+    struct Rings;
+
+    IoUring(int ring_fd, int event_fd, std::unique_ptr<Rings> rings) noexcept;
+
+    template <typename Prepare>
+    IoUringCompletion Execute(Prepare&& prepare, Deadline deadline);
+
+    template <typename Prepare>
+    bool TrySubmit(std::uint64_t user_data, Prepare&& prepare) noexcept;
+
+    void SubmitPending() noexcept;
+
+    void CancelAndWait(Operation& operation) noexcept;
+
+    void PublishSubmissions() noexcept;
+
+    void DoReapCompletions() noexcept;
+
+    const int ring_fd_;
+    const int event_fd_;
+    const std::unique_ptr<Rings> rings_;
+
+    // SQ entries handed out to the submitters, the SQ tail lags behind it
+    // until the entries are filled
+    std::atomic<unsigned> sq_reserved_;
+    // Set while a thread submits the pending entries to the kernel
+    std::atomic<bool> is_submitting_{false};
+};
+
+}  // namespace engine::io::sys_linux
+
+USERVER_NAMESPACE_END
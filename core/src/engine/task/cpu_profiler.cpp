@@ -0,0 +1,538 @@
+#include <engine/task/cpu_profiler.hpp>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include <csignal>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <boost/container_hash/hash.hpp>
+#include <boost/stacktrace/frame.hpp>
+#include <boost/stacktrace/safe_dump_to.hpp>
+
+#include <engine/task/task_context.hpp>
+#include <userver/compiler/thread_local.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/strerror.hpp>
+
+// Not defined by glibc before 2.41
+#if defined(__linux__) && !defined(sigev_notify_thread_id)
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+constexpr std::size_t kMaxFrames = 64;
+// Samples of a thread between two task steps. The samples of a longer step
+// that do not fit are attributed to the last stack of the buffer.
+constexpr std::size_t kMaxPendingSamples = 16;
+// Bounds the memory of the profiler, samples of the new stacks above the
+// limit are dropped until Reset()
+constexpr std::size_t kMaxStacks = 20'000;
+
+// Tag of the samples taken outside of the tasks, e.g. in the scheduler
+const std::string kNoTaskTag{"<no task>"};
+constexpr std::string_view kUntaggedTaskName = "<untagged>";
+
+struct Sample final {
+    CpuProfilerTag task_tag{nullptr};
+    std::size_t first_frame{0};
+    std::size_t frames_count{0};
+    // Leaf frame first
+    std::array<const void*, kMaxFrames> frames{};
+};
+
+struct StackKey final {
+    CpuProfilerTag thread_tag{nullptr};
+    CpuProfilerTag task_tag{nullptr};
+    std::vector<const void*> frames;
+
+    bool operator==(const StackKey& other) const noexcept {
+        return thread_tag == other.thread_tag && task_tag == other.task_tag && frames == other.frames;
+    }
+};
+
+struct StackKeyHash final {
+    std::size_t operator()(const StackKey& key) const noexcept {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, key.thread_tag);
+        boost::hash_combine(seed, key.task_tag);
+        boost::hash_range(seed, key.frames.begin(), key.frames.end());
+        return seed;
+    }
+};
+
+using Stacks = std::unordered_map<StackKey, std::uint64_t, StackKeyHash>;
+
+struct ThreadSamples final {
+    explicit ThreadSamples(CpuProfilerTag thread_tag) : thread_tag(thread_tag) {}
+
+    const CpuProfilerTag thread_tag;
+
+    // Written by the signal handler and read by AccountSamples() of the same
+    // thread, so only the compiler reordering matters
+    std::atomic<std::size_t> count{0};
+    // Samples taken while the buffer was full
+    std::atomic<std::uint64_t> overflow{0};
+    std::array<Sample, kMaxPendingSamples> samples{};
+
+    // Stacks of the thread, written by AccountSamples() of the thread. The
+    // mutex is only contended by the rare readers of the profile.
+    std::mutex stacks_mutex;
+    Stacks stacks;
+    std::uint64_t accounted{0};
+    std::uint64_t dropped{0};
+};
+
+// Allocated in RegisterThread(), so that the signal handler neither
+// allocates nor initializes the thread-local
+compiler::ThreadLocal local_thread_samples = []() -> ThreadSamples* { return nullptr; };
+
+std::atomic<bool> is_sampling{false};
+
+std::string_view GetTagName(CpuProfilerTag tag) noexcept { return tag ? std::string_view{*tag} : kUntaggedTaskName; }
+
+std::string GetFrameName(const void* address) {
+    auto name = boost::stacktrace::frame(address).name();
+    if (name.empty()) return fmt::format("{}", address);
+
+    // ';' separates the frames of collapsed stacks
+    std::replace(name.begin(), name.end(), ';', ':');
+    return name;
+}
+
+#ifdef __linux__
+
+// The same signal is used by gperftools and perf-less profilers, do not use
+// them together with the CpuProfiler
+constexpr auto kProfilerSignal = SIGPROF;
+
+const void* GetInterruptedAddress([[maybe_unused]] void* context) noexcept {
+#if defined(__x86_64__)
+    return reinterpret_cast<const void*>(static_cast<ucontext_t*>(context)->uc_mcontext.gregs[REG_RIP]);
+#elif defined(__aarch64__)
+    return reinterpret_cast<const void*>(static_cast<ucontext_t*>(context)->uc_mcontext.pc);
+#else
+    return nullptr;
+#endif
+}
+
+void RecordSample(void* context) noexcept {
+    auto samples_scope = local_thread_samples.Use();
+    auto* samples = *samples_scope;
+    if (!samples || !is_sampling.load(std::memory_order_relaxed)) return;
+
+    const auto count = samples->count.load(std::memory_order_relaxed);
+    if (count == kMaxPendingSamples) {
+        samples->overflow.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& sample = samples->samples[count];
+    const auto* task = current_task::GetCurrentTaskContextUnchecked();
+    sample.task_tag = task ? task->GetCpuProfilerTag() : &kNoTaskTag;
+
+    const auto dumped = boost::stacktrace::safe_dump_to(sample.frames.data(), sizeof(sample.frames));
+    const auto* const frames_end = std::find(sample.frames.data(), sample.frames.data() + dumped, nullptr);
+    sample.frames_count = frames_end - sample.frames.data();
+
+    // Skip the frames of the signal handler, the interrupted code starts
+    // at the address the signal arrived at
+    sample.first_frame = 0;
+    if (const auto* interrupted = GetInterruptedAddress(context)) {
+        const auto* const begin = sample.frames.data();
+        const auto* const end = begin + sample.frames_count;
+        const auto* const it = std::find(begin, end, interrupted);
+        if (it != end) sample.first_frame = it - begin;
+    }
+
+    std::atomic_signal_fence(std::memory_order_release);
+    samples->count.store(count + 1, std::memory_order_relaxed);
+}
+
+void ProfilerSignalHandler(int, siginfo_t*, void* context) noexcept {
+    const auto saved_errno = errno;
+    RecordSample(context);
+    errno = saved_errno;
+}
+
+void InstallSignalHandler() {
+    struct sigaction sa {};
+    // SA_ONSTACK uses the alt-stack of StackUsageMonitor if there is one,
+    // SA_RESTART keeps the interrupted syscalls from failing with EINTR
+    sa.sa_flags = SA_SIGINFO | SA_RESTART | SA_ONSTACK;
+    sa.sa_sigaction = &ProfilerSignalHandler;
+    sigemptyset(&sa.sa_mask);
+    if (sigaction(kProfilerSignal, &sa, nullptr) == -1) {
+        const auto saved_errno = errno;
+        throw std::runtime_error(
+            fmt::format("Failed to set up the CPU profiler signal handler: {}", utils::strerror(saved_errno))
+        );
+    }
+}
+
+std::optional<timer_t> CreateTimer(pthread_t thread, pid_t tid, std::chrono::microseconds interval) noexcept {
+    clockid_t clock{};
+    if (const auto error = ::pthread_getcpuclockid(thread, &clock)) {
+        LOG_WARNING() << "Failed to get the CPU clock of thread " << tid << " for the CPU profiler: "
+                      << utils::strerror(error);
+        return std::nullopt;
+    }
+
+    sigevent event{};
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = kProfilerSignal;
+    event.sigev_notify_thread_id = tid;
+
+    timer_t timer{};
+    if (::timer_create(clock, &event, &timer) == -1) {
+        const auto saved_errno = errno;
+        LOG_WARNING() << "Failed to create the CPU profiler timer of thread " << tid << ": "
+                      << utils::strerror(saved_errno);
+        return std::nullopt;
+    }
+
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(interval);
+    itimerspec spec{};
+    spec.it_interval.tv_sec = seconds.count();
+    spec.it_interval.tv_nsec = std::chrono::nanoseconds{interval - seconds}.count();
+    spec.it_value = spec.it_interval;
+    if (::timer_settime(timer, 0, &spec, nullptr) == -1) {
+        const auto saved_errno = errno;
+        LOG_WARNING() << "Failed to start the CPU profiler timer of thread " << tid << ": "
+                      << utils::strerror(saved_errno);
+        ::timer_delete(timer);
+        return std::nullopt;
+    }
+    return timer;
+}
+
+#endif
+
+}  // namespace
+
+CpuProfilerTag MakeCpuProfilerTag(std::string_view name) {
+    static std::mutex mutex;
+    static auto& tags = *new std::unordered_set<std::string>();
+
+    const std::lock_guard lock(mutex);
+    return &*tags.emplace(name).first;
+}
+
+class CpuProfiler::Impl final {
+public:
+    ~Impl() { Stop(); }
+
+    void RegisterThread(std::string_view thread_tag) noexcept {
+#ifdef __linux__
+        try {
+            auto samples = std::make_unique<ThreadSamples>(MakeCpuProfilerTag(thread_tag));
+
+            // The first unwinding may allocate while loading the unwind info
+            {
+                std::array<const void*, kMaxFrames> frames{};
+                boost::stacktrace::safe_dump_to(frames.data(), sizeof(frames));
+            }
+
+            const std::lock_guard lock(threads_mutex_);
+            // UnregisterThread() moves the samples of the thread into
+            // retired_samples_ without allocating
+            retired_samples_.reserve(retired_samples_.size() + threads_.size() + 1);
+            threads_.reserve(threads_.size() + 1);
+            {
+                auto local_samples = local_thread_samples.Use();
+                UASSERT(!*local_samples);
+                *local_samples = samples.get();
+            }
+            auto& thread = threads_.emplace_back(
+                ThreadInfo{static_cast<pid_t>(::syscall(SYS_gettid)), ::pthread_self(), std::move(samples), {}}
+            );
+            if (is_sampling) thread.timer = CreateTimer(thread.pthread, thread.tid, interval_);
+        } catch (const std::exception& ex) {
+            LOG_ERROR() << "Failed to register the thread in the CPU profiler: " << ex;
+        }
+#else
+        (void)thread_tag;
+#endif
+    }
+
+    void UnregisterThread() noexcept {
+#ifdef __linux__
+        AccountSamples();
+
+        const std::lock_guard lock(threads_mutex_);
+        const auto it = std::find_if(threads_.begin(), threads_.end(), [](const ThreadInfo& thread) {
+            return ::pthread_equal(thread.pthread, ::pthread_self());
+        });
+        if (it == threads_.end()) return;
+
+        if (it->timer) ::timer_delete(*it->timer);
+        {
+            auto local_samples = local_thread_samples.Use();
+            *local_samples = nullptr;
+        }
+        // The signals pending for the thread see no buffer from now on
+        std::atomic_signal_fence(std::memory_order_seq_cst);
+        // The stacks of the thread are kept until Reset()
+        retired_samples_.push_back(std::move(it->samples));
+        threads_.erase(it);
+#endif
+    }
+
+    void AccountSamples() noexcept {
+        auto samples_scope = local_thread_samples.Use();
+        auto* samples = *samples_scope;
+        if (!samples || samples->count.load(std::memory_order_relaxed) == 0) return;
+
+        const std::lock_guard lock(samples->stacks_mutex);
+        std::uint64_t* last_stack_samples = nullptr;
+        std::size_t consumed = 0;
+        auto count = samples->count.load(std::memory_order_relaxed);
+        while (true) {
+            std::atomic_signal_fence(std::memory_order_acquire);
+            for (; consumed < count; ++consumed) {
+                last_stack_samples = AddSample(*samples, samples->samples[consumed]);
+            }
+
+            // The signal handler may have appended more samples meanwhile
+            if (samples->count.compare_exchange_strong(count, 0, std::memory_order_relaxed)) break;
+        }
+
+        // A long step mostly runs the same code, so the samples that did not
+        // fit into the buffer are most likely taken in the last sampled stack
+        const auto overflow = samples->overflow.exchange(0, std::memory_order_relaxed);
+        if (overflow == 0) return;
+        if (last_stack_samples) {
+            *last_stack_samples += overflow;
+            samples->accounted += overflow;
+        } else {
+            samples->dropped += overflow;
+        }
+    }
+
+    void Start(std::chrono::microseconds interval) {
+#ifdef __linux__
+        if (interval <= std::chrono::microseconds::zero()) {
+            throw std::invalid_argument("CPU profiler sampling interval must be positive");
+        }
+
+        const std::lock_guard lock(threads_mutex_);
+        StopTimers();
+        if (!is_signal_handler_installed_) {
+            InstallSignalHandler();
+            is_signal_handler_installed_ = true;
+        }
+
+        interval_ = interval;
+        is_sampling = true;
+        for (auto& thread : threads_) thread.timer = CreateTimer(thread.pthread, thread.tid, interval_);
+        LOG_INFO() << "CPU profiler started with sampling interval " << interval_.count() << "us for "
+                   << threads_.size() << " threads";
+#else
+        (void)interval;
+        throw std::runtime_error("CPU profiler is only supported on Linux");
+#endif
+    }
+
+    void Stop() {
+#ifdef __linux__
+        const std::lock_guard lock(threads_mutex_);
+        if (!is_sampling) return;
+
+        StopTimers();
+        is_sampling = false;
+        LOG_INFO() << "CPU profiler stopped";
+#endif
+    }
+
+    void Reset() {
+        const std::lock_guard lock(threads_mutex_);
+#ifdef __linux__
+        for (auto& thread : threads_) {
+            auto& samples = *thread.samples;
+            const std::lock_guard stacks_lock(samples.stacks_mutex);
+            stacks_count_.fetch_sub(samples.stacks.size(), std::memory_order_relaxed);
+            samples.stacks.clear();
+            samples.accounted = 0;
+            samples.dropped = 0;
+        }
+#endif
+        for (const auto& samples : retired_samples_) {
+            stacks_count_.fetch_sub(samples->stacks.size(), std::memory_order_relaxed);
+        }
+        retired_samples_.clear();
+    }
+
+    CpuProfilerStatistics GetStatistics() const {
+        CpuProfilerStatistics result;
+        const std::lock_guard lock(threads_mutex_);
+        result.is_active = is_sampling;
+        result.interval = interval_;
+
+        ForEachThreadSamples([&result](const ThreadSamples& samples) {
+            result.samples += samples.accounted;
+            result.dropped_samples += samples.dropped;
+            result.stacks += samples.stacks.size();
+        });
+        return result;
+    }
+
+    std::string GetCollapsedStacks() const {
+        std::vector<std::pair<StackKey, std::uint64_t>> stacks;
+        {
+            const std::lock_guard lock(threads_mutex_);
+            ForEachThreadSamples([&stacks](const ThreadSamples& samples) {
+                stacks.insert(stacks.end(), samples.stacks.begin(), samples.stacks.end());
+            });
+        }
+
+        // Symbolization is slow, the workers should not wait for it
+        std::unordered_map<const void*, std::string> frame_names;
+        // Stacks that differ only in the addresses within the same functions
+        // are merged
+        std::map<std::string, std::uint64_t> collapsed;
+
+        std::string line;
+        for (const auto& [key, samples] : stacks) {
+            line.clear();
+            fmt::format_to(std::back_inserter(line), "{};{}", GetTagName(key.thread_tag), GetTagName(key.task_tag));
+            for (auto it = key.frames.rbegin(); it != key.frames.rend(); ++it) {
+                auto name_it = frame_names.find(*it);
+                if (name_it == frame_names.end()) name_it = frame_names.emplace(*it, GetFrameName(*it)).first;
+                line += ';';
+                line += name_it->second;
+            }
+            collapsed[line] += samples;
+        }
+
+        std::string result;
+        for (const auto& [stack, samples] : collapsed) {
+            fmt::format_to(std::back_inserter(result), "{} {}\n", stack, samples);
+        }
+        return result;
+    }
+
+private:
+#ifdef __linux__
+    struct ThreadInfo final {
+        pid_t tid{0};
+        pthread_t pthread{};
+        std::unique_ptr<ThreadSamples> samples;
+        std::optional<timer_t> timer;
+    };
+
+    // Must be called with threads_mutex_ held
+    void StopTimers() noexcept {
+        for (auto& thread : threads_) {
+            if (thread.timer) ::timer_delete(*thread.timer);
+            thread.timer.reset();
+        }
+    }
+#endif
+
+    // Must be called with threads_mutex_ held
+    template <typename Function>
+    void ForEachThreadSamples(Function&& func) const {
+#ifdef __linux__
+        for (const auto& thread : threads_) {
+            const std::lock_guard lock(thread.samples->stacks_mutex);
+            func(std::as_const(*thread.samples));
+        }
+#endif
+        // Nobody writes the stacks of the unregistered threads
+        for (const auto& samples : retired_samples_) func(std::as_const(*samples));
+    }
+
+    // Must be called with samples.stacks_mutex held. Returns the sample count
+    // of the stack, nullptr if the sample is dropped.
+    std::uint64_t* AddSample(ThreadSamples& samples, const Sample& sample) noexcept {
+        try {
+            const auto* const frames = sample.frames.data();
+            StackKey key{
+                samples.thread_tag,
+                sample.task_tag,
+                std::vector<const void*>(frames + sample.first_frame, frames + sample.frames_count),
+            };
+            auto it = samples.stacks.find(key);
+            if (it == samples.stacks.end()) {
+                // The limit is shared by all the threads, the concurrent
+                // threads may exceed it by a few stacks
+                if (stacks_count_.load(std::memory_order_relaxed) >= kMaxStacks) {
+                    ++samples.dropped;
+                    return nullptr;
+                }
+                it = samples.stacks.emplace(std::move(key), 0).first;
+                stacks_count_.fetch_add(1, std::memory_order_relaxed);
+            }
+            ++it->second;
+            ++samples.accounted;
+            return &it->second;
+        } catch (const std::bad_alloc&) {
+            ++samples.dropped;
+            return nullptr;
+        }
+    }
+
+    mutable std::mutex threads_mutex_;
+#ifdef __linux__
+    std::vector<ThreadInfo> threads_;
+#endif
+    // Samples of the unregistered threads, kept until Reset()
+    std::vector<std::unique_ptr<ThreadSamples>> retired_samples_;
+    std::chrono::microseconds interval_{0};
+    bool is_signal_handler_installed_{false};
+
+    // Unique stacks of all the threads
+    std::atomic<std::size_t> stacks_count_{0};
+};
+
+CpuProfiler::CpuProfiler() : impl_(std::make_unique<Impl>()) {}
+
+CpuProfiler::~CpuProfiler() = default;
+
+void CpuProfiler::RegisterThread(std::string_view thread_tag) noexcept { impl_->RegisterThread(thread_tag); }
+
+void CpuProfiler::UnregisterThread() noexcept { impl_->UnregisterThread(); }
+
+void CpuProfiler::AccountSamples() noexcept { impl_->AccountSamples(); }
+
+void CpuProfiler::Start(std::chrono::microseconds interval) { impl_->Start(interval); }
+
+void CpuProfiler::Stop() { impl_->Stop(); }
+
+void CpuProfiler::Reset() { impl_->Reset(); }
+
+CpuProfilerStatistics CpuProfiler::GetStatistics() const { return impl_->GetStatistics(); }
+
+std::string CpuProfiler::GetCollapsedStacks() const { return impl_->GetCollapsedStacks(); }
+
+CpuProfiler& GetCpuProfiler() noexcept {
+    // Never destroyed, the threads of the task processors may outlive statics
+    static auto& profiler = *new CpuProfiler();
+    return profiler;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
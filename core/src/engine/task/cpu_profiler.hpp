@@ -0,0 +1,78 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+// Name of the code the CPU is spent on, e.g. a handler name. Tags are
+// interned and never freed, so that the signal handler may read them.
+using CpuProfilerTag = const std::string*;
+
+CpuProfilerTag MakeCpuProfilerTag(std::string_view name);
+
+struct CpuProfilerStatistics final {
+    bool is_active{false};
+    std::chrono::microseconds interval{0};
+    // Samples aggregated into the stacks
+    std::uint64_t samples{0};
+    // Samples lost due to the limit of unique stacks
+    std::uint64_t dropped_samples{0};
+    // Unique stacks of each thread, summed over the threads
+    std::uint64_t stacks{0};
+};
+
+// Sampling profiler of the CPU time of the TaskProcessor threads.
+//
+// Each registered thread gets a timer of its CPU time, that sends SIGPROF to
+// the thread each `interval` of the CPU time it consumed. The signal handler
+// dumps the stacktrace of the thread and the CpuProfilerTag of the current
+// task into a thread-local buffer. The buffer is folded into the stacks of the
+// thread by AccountSamples(), that the thread calls between the task steps.
+// The stacks of all the threads are merged only by GetCollapsedStacks().
+//
+// Linux-only, Start() throws on other platforms.
+class CpuProfiler final {
+public:
+    CpuProfiler();
+    ~CpuProfiler();
+
+    CpuProfiler(const CpuProfiler&) = delete;
+    CpuProfiler& operator=(const CpuProfiler&) = delete;
+
+    // `thread_tag` is the first frame of the stacks sampled on the current
+    // thread, e.g. the task processor thread name
+    void RegisterThread(std::string_view thread_tag) noexcept;
+    void UnregisterThread() noexcept;
+
+    // Moves the samples of the current thread into the stacks of the thread
+    void AccountSamples() noexcept;
+
+    void Start(std::chrono::microseconds interval);
+    void Stop();
+
+    // Drops the collected stacks
+    void Reset();
+
+    CpuProfilerStatistics GetStatistics() const;
+
+    // Collapsed stacks with sample counts, one per line:
+    // `<thread>;<tag>;<root frame>;...;<leaf frame> <samples>`
+    // The format is accepted by flamegraph.pl and speedscope.
+    std::string GetCollapsedStacks() const;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+CpuProfiler& GetCpuProfiler() noexcept;
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
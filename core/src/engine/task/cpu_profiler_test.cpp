@@ -0,0 +1,107 @@
+#include <engine/task/cpu_profiler.hpp>
+
+#include <chrono>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+#include <engine/task/task_context.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+#ifdef __linux__
+
+namespace {
+
+constexpr std::string_view kTestTag = "cpu-profiler-test";
+
+bool HasTaggedSamples() {
+    auto& profiler = engine::impl::GetCpuProfiler();
+    return profiler.GetStatistics().samples != 0 && profiler.GetCollapsedStacks().find(kTestTag) != std::string::npos;
+}
+
+// Burns the CPU in short steps, the samples are accounted between the steps
+void BurnCpuUntilSampled(engine::Deadline deadline) {
+    while (!HasTaggedSamples() && !deadline.IsReached()) {
+        const auto step_end = std::chrono::steady_clock::now() + std::chrono::milliseconds{5};
+        while (std::chrono::steady_clock::now() < step_end) {
+        }
+        engine::Yield();
+    }
+}
+
+std::chrono::nanoseconds GetThreadCpuTime() {
+    timespec time{};
+    ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return std::chrono::seconds{time.tv_sec} + std::chrono::nanoseconds{time.tv_nsec};
+}
+
+}  // namespace
+
+UTEST(CpuProfiler, TagsSamplesOfSubtasks) {
+    auto& profiler = engine::impl::GetCpuProfiler();
+    profiler.Reset();
+    profiler.Start(std::chrono::milliseconds{1});
+
+    engine::current_task::GetCurrentTaskContext().SetCpuProfilerTag(engine::impl::MakeCpuProfilerTag(kTestTag));
+    const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+    engine::AsyncNoSpan([deadline] { BurnCpuUntilSampled(deadline); }).Get();
+    profiler.Stop();
+
+    const auto stats = profiler.GetStatistics();
+    EXPECT_FALSE(stats.is_active);
+    ASSERT_GT(stats.samples, 0U);
+    EXPECT_GT(stats.stacks, 0U);
+
+    const auto collapsed = profiler.GetCollapsedStacks();
+    EXPECT_NE(collapsed.find(kTestTag), std::string::npos) << collapsed;
+
+    profiler.Reset();
+    EXPECT_EQ(profiler.GetStatistics().samples, 0U);
+    EXPECT_EQ(profiler.GetCollapsedStacks(), "");
+}
+
+UTEST(CpuProfiler, CountsSamplesOfLongSteps) {
+    auto& profiler = engine::impl::GetCpuProfiler();
+    profiler.Reset();
+    profiler.Start(std::chrono::milliseconds{1});
+
+    // A single step of up to 200 sampling intervals, the CPU timers may tick
+    // more rarely than requested. Still much more than the per-thread buffer
+    // of the samples holds.
+    engine::AsyncNoSpan([] {
+        const auto step_end = GetThreadCpuTime() + std::chrono::milliseconds{200};
+        while (GetThreadCpuTime() < step_end) {
+        }
+    }).Get();
+
+    // The samples are accounted after the step, possibly after Get() returns
+    constexpr std::uint64_t kMinSamples = 32;
+    const auto deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+    while (profiler.GetStatistics().samples < kMinSamples && !deadline.IsReached()) {
+        engine::SleepFor(std::chrono::milliseconds{1});
+    }
+    profiler.Stop();
+
+    const auto stats = profiler.GetStatistics();
+    EXPECT_GE(stats.samples, kMinSamples);
+    EXPECT_EQ(stats.dropped_samples, 0U);
+
+    profiler.Reset();
+}
+
+#endif
+
+UTEST(CpuProfiler, TagsAreInterned) {
+    const auto tag = engine::impl::MakeCpuProfilerTag("handler-a");
+    EXPECT_EQ(tag, engine::impl::MakeCpuProfilerTag("handler-a"));
+    EXPECT_NE(tag, engine::impl::MakeCpuProfilerTag("handler-b"));
+    EXPECT_EQ(*tag, "handler-a");
+}
+
+USERVER_NAMESPACE_END
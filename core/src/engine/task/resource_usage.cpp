@@ -0,0 +1,38 @@
+#include <engine/task/resource_usage.hpp>
+
+#include <time.h>
+
+#include <userver/compiler/thread_local.hpp>
+#include <utils/jemalloc.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+namespace {
+
+// mallctl is too slow to be called on each context switch, the counters
+// of the thread are read through the pointers
+compiler::ThreadLocal local_allocation_counters = [] { return utils::jemalloc::GetThreadAllocationCounters(); };
+
+std::chrono::nanoseconds GetThreadCpuTime() noexcept {
+    timespec ts{};
+    if (::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return {};
+    return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+}  // namespace
+
+TaskResourceUsage GetThreadResourceUsage() noexcept {
+    TaskResourceUsage usage;
+    usage.cpu_time = GetThreadCpuTime();
+
+    auto counters = local_allocation_counters.Use();
+    if (counters->allocated) usage.allocated_bytes = *counters->allocated;
+    if (counters->deallocated) usage.deallocated_bytes = *counters->deallocated;
+    return usage;
+}
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <userver/engine/task/resource_usage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+// Resources consumed by the calling thread since its start, the usage of
+// a task execution slice is the difference of the values before and after it
+TaskResourceUsage GetThreadResourceUsage() noexcept;
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,86 @@
+#include <userver/engine/task/resource_usage.hpp>
+
+#include <chrono>
+#include <memory>
+
+#include <engine/task/task_processor.hpp>
+#include <engine/task/task_processor_config.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+#include <userver/utest/utest.hpp>
+#include <utils/jemalloc.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::chrono::milliseconds kBusyTime{20};
+
+std::unique_ptr<engine::TaskProcessor> MakeTaskProcessor(bool resource_usage_accounting) {
+    engine::TaskProcessorConfig config;
+    config.name = "resource-usage";
+    config.thread_name = "resource-usage";
+    config.worker_threads = 1;
+    config.resource_usage_accounting = resource_usage_accounting;
+    return std::make_unique<engine::TaskProcessor>(
+        std::move(config), engine::current_task::GetTaskProcessor().GetTaskProcessorPools()
+    );
+}
+
+void BurnCpu(std::chrono::milliseconds duration) {
+    const auto end = std::chrono::steady_clock::now() + duration;
+    while (std::chrono::steady_clock::now() < end) {
+    }
+}
+
+}  // namespace
+
+UTEST(TaskResourceUsage, Disabled) {
+    auto task_processor = MakeTaskProcessor(false);
+    const auto usage = engine::AsyncNoSpan(*task_processor, [] {
+                           BurnCpu(kBusyTime);
+                           return engine::current_task::GetResourceUsage();
+                       }).Get();
+    EXPECT_EQ(usage.cpu_time.count(), 0);
+    EXPECT_EQ(usage.allocated_bytes, 0U);
+}
+
+UTEST(TaskResourceUsage, CpuTimeOfSlices) {
+    auto task_processor = MakeTaskProcessor(true);
+    const auto [busy, idle] = engine::AsyncNoSpan(*task_processor, [] {
+                                  auto start = engine::current_task::GetResourceUsage();
+                                  BurnCpu(kBusyTime / 2);
+                                  engine::Yield();
+                                  BurnCpu(kBusyTime / 2);
+                                  const auto busy = engine::current_task::GetResourceUsage() - start;
+
+                                  start = engine::current_task::GetResourceUsage();
+                                  engine::SleepFor(kBusyTime);
+                                  const auto idle = engine::current_task::GetResourceUsage() - start;
+                                  return std::make_pair(busy, idle);
+                              }).Get();
+
+    // The CPU time of the thread may lag behind the wall time, e.g. under
+    // the CPU throttling, so only a part of it is checked
+    EXPECT_GE(busy.cpu_time, kBusyTime / 4);
+    EXPECT_LT(idle.cpu_time, kBusyTime / 2);
+}
+
+UTEST(TaskResourceUsage, Allocations) {
+    if (!utils::jemalloc::GetThreadAllocationCounters().allocated) {
+        GTEST_SKIP() << "Allocations are only accounted with jemalloc";
+    }
+
+    constexpr std::size_t kSize = 1 << 20;
+    auto task_processor = MakeTaskProcessor(true);
+    const auto usage = engine::AsyncNoSpan(*task_processor, [] {
+                           auto data = std::make_unique<char[]>(kSize);
+                           engine::Yield();
+                           data.reset();
+                           return engine::current_task::GetResourceUsage();
+                       }).Get();
+    EXPECT_GE(usage.allocated_bytes, kSize);
+    EXPECT_GE(usage.deallocated_bytes, kSize);
+}
+
+USERVER_NAMESPACE_END
@@ -10,6 +10,7 @@
 #include <userver/engine/async.hpp>
 #include <userver/engine/impl/task_context_holder.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/resource_usage.hpp>
 #include <userver/utils/assert.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -151,6 +152,11 @@ TaskProcessor& GetTaskProcessor() { return GetCurrentTaskContext().GetTaskProces
 
 std::size_t GetStackSize() { return GetTaskProcessor().GetTaskProcessorPools()->GetCoroPool().GetStackSize(); }
 
+TaskResourceUsage GetResourceUsage() noexcept {
+    auto* const context = GetCurrentTaskContextUnchecked();
+    return context ? context->GetResourceUsage() : TaskResourceUsage{};
+}
+
 ev::ThreadControl& GetEventThread() { return GetTaskProcessor().EventThreadPool().NextThread(); }
 
 }  // namespace current_task
@@ -25,6 +25,7 @@
 #include <engine/impl/generic_wait_list.hpp>
 #include <engine/task/coro_unwinder.hpp>
 #include <engine/task/cxxabi_eh_globals.hpp>
+#include <engine/task/resource_usage.hpp>
 #include <engine/task/task_processor.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -96,6 +97,11 @@ constexpr SleepState MakeNextEpochSleepState(SleepState::Epoch current) {
     return {SleepFlags::kNone, Epoch{utils::UnderlyingValue(current) + 1}};
 }
 
+CpuProfilerTag GetCurrentCpuProfilerTag() noexcept {
+    const auto* current = current_task::GetCurrentTaskContextUnchecked();
+    return current ? current->GetCpuProfilerTag() : nullptr;
+}
+
 auto* const kFinishedDetachedToken = reinterpret_cast<DetachedTasksSyncBlock::Token*>(1);
 
 }  // namespace
@@ -103,6 +109,7 @@ auto* const kFinishedDetachedToken = reinterpret_cast<DetachedTasksSyncBlock::To
 TaskContext::TaskContext(
     TaskProcessor& task_processor,
     Task::Importance importance,
+    Task::Priority priority,
     Task::WaitMode wait_type,
     Deadline deadline,
     utils::impl::WrappedCallBase& payload
@@ -110,10 +117,12 @@ TaskContext::TaskContext(
     : task_processor_(task_processor),
       task_counter_token_(task_processor_.GetTaskCounter()),
       is_critical_(importance == Task::Importance::kCritical),
+      priority_(priority),
       payload_(&payload),
       finish_waiters_(wait_type),
       cancel_deadline_(deadline),
-      trace_csw_left_(task_processor_.GetTaskTraceMaxCswForNewTask()) {
+      trace_csw_left_(task_processor_.GetTaskTraceMaxCswForNewTask()),
+      cpu_profiler_tag_(GetCurrentCpuProfilerTag()) {
     UASSERT(payload_);
     LOG_TRACE() << "task with task_id=" << ReadableTaskId(current_task::GetCurrentTaskContextUnchecked())
                 << " created task with task_id=" << ReadableTaskId(this) << logging::LogExtra::Stacktrace();
@@ -315,12 +324,14 @@ TaskContext::WakeupSource TaskContext::Sleep(WaitStrategy& wait_strategy, Deadli
     UASSERT(task_pipe_);
     TraceStateTransition(Task::State::kSuspended);
     ProfilerStopExecution();
+    ResourceUsageStopExecution();
 
     auto& task_pipe_ref = *task_pipe_;
     TsanAcquireBarrier();
     [[maybe_unused]] TaskContext* context = task_pipe_ref().get();
     TsanReleaseBarrier();
 
+    ResourceUsageStartExecution();
     ProfilerStartExecution();
     TraceStateTransition(Task::State::kRunning);
     UASSERT(context == this);
@@ -461,6 +472,7 @@ void TaskContext::CoroFunc(TaskPipe& task_pipe) {
         context->yield_reason_ = YieldReason::kNone;
         context->task_pipe_ = &task_pipe;
 
+        context->ResourceUsageStartExecution();
         context->ProfilerStartExecution();
 
         // We only let tasks ran with CriticalAsync enter function body, others
@@ -497,6 +509,7 @@ void TaskContext::CoroFunc(TaskPipe& task_pipe) {
         }
 
         context->ProfilerStopExecution();
+        context->ResourceUsageStopExecution();
 
         context->task_pipe_ = nullptr;
         context->TsanAcquireBarrier();
@@ -610,6 +623,23 @@ void TaskContext::ProfilerStopExecution() {
     }
 }
 
+TaskResourceUsage TaskContext::GetResourceUsage() const noexcept {
+    UASSERT(IsCurrent());
+    auto usage = resource_usage_;
+    if (slice_start_usage_) usage += GetThreadResourceUsage() - *slice_start_usage_;
+    return usage;
+}
+
+void TaskContext::ResourceUsageStartExecution() noexcept {
+    if (task_processor_.ShouldAccountResourceUsage()) slice_start_usage_ = GetThreadResourceUsage();
+}
+
+void TaskContext::ResourceUsageStopExecution() noexcept {
+    if (!slice_start_usage_) return;
+    resource_usage_ += GetThreadResourceUsage() - *slice_start_usage_;
+    slice_start_usage_.reset();
+}
+
 void TaskContext::TraceStateTransition(Task::State state) {
     if (trace_csw_left_ == 0) return;
     --trace_csw_left_;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <vector>
@@ -13,8 +14,10 @@
 #include <engine/ev/thread_control.hpp>
 #include <engine/task/context_timer.hpp>
 #include <engine/task/counted_coroutine_ptr.hpp>
+#include <engine/task/cpu_profiler.hpp>
 #include <engine/task/cxxabi_eh_globals.hpp>
 #include <engine/task/sleep_state.hpp>
+#include <engine/task/task_lanes.hpp>
 #include <engine/task/task_counter.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/future_status.hpp>
@@ -23,6 +26,7 @@
 #include <userver/engine/impl/task_local_storage.hpp>
 #include <userver/engine/impl/wait_list_fwd.hpp>
 #include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/resource_usage.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/utils/flags.hpp>
@@ -80,7 +84,14 @@ public:
         kBootstrap = static_cast<uint32_t>(SleepFlags::kWakeupByBootstrap),
     };
 
-    TaskContext(TaskProcessor&, Task::Importance, Task::WaitMode, Deadline, utils::impl::WrappedCallBase& payload);
+    TaskContext(
+        TaskProcessor&,
+        Task::Importance,
+        Task::Priority,
+        Task::WaitMode,
+        Deadline,
+        utils::impl::WrappedCallBase& payload
+    );
 
     ~TaskContext() noexcept;
 
@@ -105,6 +116,9 @@ public:
     // simultaneously
     bool IsSharedWaitAllowed() const;
 
+    // task processor queue lane this task is scheduled to
+    Task::Priority GetPriority() const noexcept { return priority_; }
+
     // whether user code finished executing, coroutine may still be running
     bool IsFinished() const noexcept;
 
@@ -161,6 +175,15 @@ public:
 
     void SetCancelDeadline(Deadline deadline);
 
+    // the CPU profiler attributes the samples of this task to the tag, it is
+    // inherited by the subtasks
+    CpuProfilerTag GetCpuProfilerTag() const noexcept { return cpu_profiler_tag_.load(std::memory_order_relaxed); }
+    void SetCpuProfilerTag(CpuProfilerTag tag) noexcept { cpu_profiler_tag_.store(tag, std::memory_order_relaxed); }
+
+    // resources consumed by the task so far, must only be called from this
+    // context
+    TaskResourceUsage GetResourceUsage() const noexcept;
+
     bool HasLocalStorage() const noexcept;
     task_local::Storage& GetLocalStorage() noexcept;
 
@@ -198,6 +221,9 @@ private:
     void ProfilerStartExecution();
     void ProfilerStopExecution();
 
+    void ResourceUsageStartExecution() noexcept;
+    void ResourceUsageStopExecution() noexcept;
+
     void TraceStateTransition(Task::State state);
 
     void TsanAcquireBarrier() noexcept;
@@ -210,6 +236,7 @@ private:
     bool is_cancellable_{true};
     bool is_background_{false};
     bool within_sleep_{false};
+    const Task::Priority priority_;
     EhGlobals eh_globals_;
 
     utils::impl::WrappedCallBase* payload_;
@@ -229,6 +256,14 @@ private:
 
     std::size_t trace_csw_left_;
 
+    // read by the CPU profiler signal handler
+    std::atomic<CpuProfilerTag> cpu_profiler_tag_;
+
+    // accounted only if the task processor has resource usage accounting on
+    TaskResourceUsage resource_usage_{};
+    // thread resource usage at the start of the current execution slice
+    std::optional<TaskResourceUsage> slice_start_usage_;
+
     AtomicSleepState sleep_state_{SleepState{SleepFlags::kSleeping, SleepState::Epoch{0}}};
     WakeupSource wakeup_source_{WakeupSource::kNone};
 
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include <userver/engine/task/task.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace engine::impl {
+
+// number of Task::Priority values, i.e. task processor queue lanes
+inline constexpr std::size_t kTaskPriorityCount = 3;
+
+inline constexpr std::size_t kCriticalLane = static_cast<std::size_t>(Task::Priority::kCritical);
+inline constexpr std::size_t kNormalLane = static_cast<std::size_t>(Task::Priority::kNormal);
+inline constexpr std::size_t kBackgroundLane = static_cast<std::size_t>(Task::Priority::kBackground);
+
+// Weighted round-robin of lanes to look into first: when all the lanes are
+// non-empty, 6 out of 10 tasks are taken from the critical lane, 3 from the
+// normal one and 1 from the background one. Empty lanes are skipped, so
+// no lane is starved and no worker idles while there are tasks.
+inline constexpr std::array<std::size_t, 10> kLanesSchedule{
+    kCriticalLane,
+    kNormalLane,
+    kCriticalLane,
+    kNormalLane,
+    kCriticalLane,
+    kBackgroundLane,
+    kCriticalLane,
+    kNormalLane,
+    kCriticalLane,
+    kCriticalLane,
+};
+
+}  // namespace engine::impl
+
+USERVER_NAMESPACE_END
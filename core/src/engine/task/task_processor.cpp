@@ -13,9 +13,11 @@
 #include <userver/utils/rand.hpp>
 #include <userver/utils/thread_name.hpp>
 #include <userver/utils/threads.hpp>
+#include <utils/numa.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 #include <engine/task/counted_coroutine_ptr.hpp>
+#include <engine/task/cpu_profiler.hpp>
 #include <engine/task/task_context.hpp>
 #include <engine/task/task_processor_pools.hpp>
 
@@ -42,6 +44,26 @@ constexpr OverloadActionAndValue<OverloadBitAndValue> GetOverloadActionAndValue(
     }
 }
 
+// Bucket bounds of queue wait time histograms, in microseconds
+constexpr double kQueueWaitTimeBoundsUs[] = {
+    10,
+    20,
+    50,
+    100,
+    200,
+    500,
+    1'000,
+    2'000,
+    5'000,
+    10'000,
+    20'000,
+    50'000,
+    100'000,
+    200'000,
+    500'000,
+    1'000'000,
+};
+
 void SetTaskQueueWaitTimepoint(impl::TaskContext* context) {
     static constexpr std::size_t kTaskTimestampInterval = 4;
     thread_local std::size_t task_count = 0;
@@ -98,8 +120,14 @@ auto MakeTaskQueue(TaskProcessorConfig config) {
 TaskProcessor::TaskProcessor(TaskProcessorConfig config, std::shared_ptr<impl::TaskProcessorPools> pools)
     : task_queue_(MakeTaskQueue(config)),
       task_counter_(config.worker_threads),
+      queue_wait_time_{
+          utils::statistics::Histogram{kQueueWaitTimeBoundsUs},
+          utils::statistics::Histogram{kQueueWaitTimeBoundsUs},
+          utils::statistics::Histogram{kQueueWaitTimeBoundsUs},
+      },
       config_(std::move(config)),
       pools_(std::move(pools)) {
+    static_assert(std::tuple_size_v<decltype(queue_wait_time_)> == impl::kTaskPriorityCount);
     utils::impl::FinishStaticRegistration();
     try {
         LOG_INFO() << "creating task_processor " << Name() << " "
@@ -174,6 +202,10 @@ ev::ThreadPool& TaskProcessor::EventThreadPool() { return pools_->EventThreadPoo
 
 impl::CountedCoroutinePtr TaskProcessor::GetCoroutine() { return {pools_->GetCoroPool().GetCoroutine(), *this}; }
 
+const utils::statistics::Histogram& TaskProcessor::GetQueueWaitTimeHistogram(Task::Priority priority) const {
+    return queue_wait_time_[static_cast<std::size_t>(priority)];
+}
+
 std::size_t TaskProcessor::GetTaskQueueSize() const {
     return std::visit([](auto&& arg) { return arg.GetSizeApproximate(); }, task_queue_);
 }
@@ -284,6 +316,16 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
             break;
     }
 
+    if (!config_.cpu_affinity.empty()) {
+        const auto cpu = config_.cpu_affinity[index % config_.cpu_affinity.size()];
+        try {
+            utils::numa::PinCurrentThreadToCpu(cpu);
+        } catch (const std::exception& ex) {
+            LOG_ERROR() << "Failed to pin worker #" << index << " of task processor " << Name() << " to CPU " << cpu
+                        << ": " << ex;
+        }
+    }
+
     std::visit([index](auto& obj) { obj.PrepareWorker(index); }, task_queue_);
 
     pools_->GetCoroPool().PrepareLocalCache();
@@ -293,11 +335,15 @@ void TaskProcessor::PrepareWorkerThread(std::size_t index) noexcept {
     impl::SetLocalTaskCounterData(task_counter_, index);
 
     pools_->GetCoroPool().RegisterThread();
+    impl::GetCpuProfiler().RegisterThread(config_.thread_name);
 
     TaskProcessorThreadStartedHook();
 }
 
-void TaskProcessor::FinalizeWorkerThread() noexcept { pools_->GetCoroPool().ClearLocalCache(); }
+void TaskProcessor::FinalizeWorkerThread() noexcept {
+    impl::GetCpuProfiler().UnregisterThread();
+    pools_->GetCoroPool().ClearLocalCache();
+}
 
 void TaskProcessor::ProcessTasks() noexcept {
     while (true) {
@@ -316,6 +362,8 @@ void TaskProcessor::ProcessTasks() noexcept {
         }
 
         pools_->GetCoroPool().AccountStackUsage();
+        impl::GetCpuProfiler().AccountSamples();
+        pools_->GetCoroPool().MaybeReleaseIdleCoroutines();
 
         if (has_failed || context->IsFinished()) {
             context->FinishDetached();
@@ -324,6 +372,16 @@ void TaskProcessor::ProcessTasks() noexcept {
 }
 
 void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
+    const auto wait_timepoint = context.GetQueueWaitTimepoint();
+    const bool has_wait_time = wait_timepoint != std::chrono::steady_clock::time_point();
+    const auto wait_time = has_wait_time ? std::chrono::steady_clock::now() - wait_timepoint
+                                         : std::chrono::steady_clock::duration{};
+    if (has_wait_time) {
+        const auto wait_time_us = std::chrono::duration_cast<std::chrono::microseconds>(wait_time);
+        LOG_TRACE() << "queue wait time = " << wait_time_us.count() << "us";
+        queue_wait_time_[static_cast<std::size_t>(context.GetPriority())].Account(wait_time_us.count());
+    }
+
     const auto [action, max_wait_time] = GetOverloadActionAndValue(action_bit_and_max_task_queue_wait_time_);
     const auto sensor_wait_time = sensor_task_queue_wait_time_.load();
 
@@ -332,11 +390,7 @@ void TaskProcessor::CheckWaitTime(impl::TaskContext& context) {
         return;
     }
 
-    const auto wait_timepoint = context.GetQueueWaitTimepoint();
-    if (wait_timepoint != std::chrono::steady_clock::time_point()) {
-        const auto wait_time = std::chrono::steady_clock::now() - wait_timepoint;
-        const auto wait_time_us = std::chrono::duration_cast<std::chrono::microseconds>(wait_time);
-        LOG_TRACE() << "queue wait time = " << wait_time_us.count() << "us";
+    if (has_wait_time) {
 
         SetTaskQueueWaitTimeOverloaded(max_wait_time.count() && wait_time >= max_wait_time);
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <cstdint>
 #include <functional>
@@ -11,12 +12,15 @@
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
 #include <engine/task/task_counter.hpp>
+#include <engine/task/task_lanes.hpp>
 #include <engine/task/task_processor_config.hpp>
 #include <engine/task/task_queue.hpp>
 #include <engine/task/work_stealing_queue/task_queue.hpp>
 #include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/engine/impl/detached_tasks_sync_block.hpp>
+#include <userver/engine/task/task_base.hpp>
 #include <userver/logging/logger.hpp>
+#include <userver/utils/statistics/histogram.hpp>
 #include <utils/statistics/thread_statistics.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -58,6 +62,10 @@ public:
 
     std::size_t GetTaskQueueSize() const;
 
+    // Time spent in the queue lane of the given priority by a sample of tasks,
+    // in microseconds
+    const utils::statistics::Histogram& GetQueueWaitTimeHistogram(Task::Priority priority) const;
+
     std::size_t GetWorkerCount() const { return workers_.size(); }
 
     void SetSettings(const TaskProcessorSettings& settings);
@@ -66,6 +74,8 @@ public:
 
     bool ShouldProfilerForceStacktrace() const;
 
+    bool ShouldAccountResourceUsage() const noexcept { return config_.resource_usage_accounting; }
+
     std::size_t GetTaskTraceMaxCswForNewTask() const;
 
     const std::string& GetTaskTraceLoggerName() const;
@@ -109,6 +119,8 @@ private:
     concurrent::impl::InterferenceShield<OverloadedCache> overloaded_cache_;
     std::variant<TaskQueue, WorkStealingTaskQueue> task_queue_;
     impl::TaskCounter task_counter_;
+    // one per Task::Priority
+    std::array<utils::statistics::Histogram, impl::kTaskPriorityCount> queue_wait_time_;
 
     const TaskProcessorConfig config_;
     const std::shared_ptr<impl::TaskProcessorPools> pools_;
@@ -9,6 +9,8 @@
 #include <userver/utils/trivial_map.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
+#include <utils/numa.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace engine {
@@ -63,6 +65,8 @@ TaskProcessorConfig Parse(const yaml_config::YamlConfig& value, formats::parse::
     config.os_scheduling = value["os-scheduling"].As<OsScheduling>(config.os_scheduling);
     config.spinning_iterations = value["spinning-iterations"].As<int>(config.spinning_iterations);
     config.task_processor_queue = value["task-processor-queue"].As<TaskQueueType>(config.task_processor_queue);
+    config.cpu_affinity = utils::numa::ParseCpuList(value["cpu-affinity"].As<std::string>({}));
+    config.resource_usage_accounting = value["resource-usage-accounting"].As<bool>(config.resource_usage_accounting);
 
     const auto task_trace = value["task-trace"];
     if (!task_trace.IsMissing()) {
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include <userver/formats/json_fwd.hpp>
 #include <userver/yaml_config/fwd.hpp>
@@ -33,11 +34,16 @@ struct TaskProcessorConfig {
     OsScheduling os_scheduling{OsScheduling::kNormal};
     int spinning_iterations{1000};
     TaskQueueType task_processor_queue{TaskQueueType::kGlobalTaskQueue};
+    // worker i is pinned to cpu_affinity[i % size], no pinning if empty
+    std::vector<std::size_t> cpu_affinity;
 
     std::size_t task_trace_every{1000};
     std::size_t task_trace_max_csw{0};
     std::string task_trace_logger_name;
 
+    // whether to account CPU time and heap usage of each task
+    bool resource_usage_accounting{false};
+
     void SetName(const std::string& new_name);
 };
 
@@ -1,5 +1,10 @@
 #include <engine/task/task_processor.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 #include <engine/task/task_processor_config.hpp>
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
@@ -74,4 +79,62 @@ UTEST_MT(TaskProcessor, MetricsAliveAndRunning, 2) {
     EXPECT_EQ(task_counter.GetRunningTasks(), 1);
 }
 
+UTEST(TaskProcessor, PriorityLanes) {
+    constexpr std::size_t kTasksPerLane = 100;
+
+    const auto queue_types = {engine::TaskQueueType::kGlobalTaskQueue, engine::TaskQueueType::kWorkStealingTaskQueue};
+    for (const auto queue_type : queue_types) {
+        engine::TaskProcessorConfig config;
+        config.name = "priority-lanes";
+        config.thread_name = "priority-lanes";
+        config.worker_threads = 1;
+        config.task_processor_queue = queue_type;
+        engine::TaskProcessor task_processor(
+            std::move(config), engine::current_task::GetTaskProcessor().GetTaskProcessorPools()
+        );
+
+        // Occupy the only worker until all the tasks are queued
+        std::atomic<bool> queued{false};
+        auto gate = engine::AsyncNoSpan(task_processor, [&queued] {
+            while (!queued) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+
+        std::vector<engine::Task::Priority> execution_order;
+        std::vector<engine::TaskWithResult<void>> tasks;
+        for (const auto priority : {engine::Task::Priority::kBackground, engine::Task::Priority::kCritical}) {
+            for (std::size_t i = 0; i < kTasksPerLane; ++i) {
+                tasks.push_back(engine::AsyncNoSpan(
+                    task_processor, priority, [&execution_order, priority] { execution_order.push_back(priority); }
+                ));
+            }
+        }
+        queued = true;
+
+        gate.Get();
+        for (auto& task : tasks) {
+            task.Get();
+        }
+
+        // Background tasks were queued first, but the critical ones overtake
+        // them. Background lane is not starved either.
+        ASSERT_EQ(execution_order.size(), 2 * kTasksPerLane);
+        std::size_t critical_first{0};
+        std::size_t background_first{0};
+        for (std::size_t i = 0; i < kTasksPerLane; ++i) {
+            if (execution_order[i] == engine::Task::Priority::kCritical) {
+                ++critical_first;
+            } else {
+                ++background_first;
+            }
+        }
+        EXPECT_GE(critical_first, kTasksPerLane * 3 / 4);
+        EXPECT_GT(background_first, 0);
+
+        const auto& wait_time = task_processor.GetQueueWaitTimeHistogram(engine::Task::Priority::kCritical);
+        EXPECT_GT(wait_time.GetView().GetTotalCount(), 0);
+    }
+}
+
 USERVER_NAMESPACE_END
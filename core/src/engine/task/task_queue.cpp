@@ -1,6 +1,7 @@
 #include <engine/task/task_queue.hpp>
 
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_lanes.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -8,10 +9,24 @@ namespace engine {
 
 namespace {
 constexpr std::size_t kSemaphoreInitialCount = 0;
-}
+}  // namespace
+
+struct TaskQueue::ConsumerTokens final {
+    explicit ConsumerTokens(std::array<Lane, kLanesCount>& lanes)
+        : tokens{
+              moodycamel::ConsumerToken(lanes[impl::kCriticalLane]),
+              moodycamel::ConsumerToken(lanes[impl::kNormalLane]),
+              moodycamel::ConsumerToken(lanes[impl::kBackgroundLane]),
+          } {}
+
+    std::array<moodycamel::ConsumerToken, kLanesCount> tokens;
+    std::size_t schedule_step{0};
+};
 
 TaskQueue::TaskQueue(const TaskProcessorConfig& config)
-    : queue_semaphore_(kSemaphoreInitialCount, config.spinning_iterations) {}
+    : queue_semaphore_(kSemaphoreInitialCount, config.spinning_iterations) {
+    static_assert(kLanesCount == impl::kTaskPriorityCount);
+}
 
 void TaskQueue::Push(boost::intrusive_ptr<impl::TaskContext>&& context) {
     UASSERT(context);
@@ -21,11 +36,11 @@ void TaskQueue::Push(boost::intrusive_ptr<impl::TaskContext>&& context) {
 
 boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
     // Current thread handles only a single TaskProcessor, so it's safe to store
-    // a token for the task processor in a thread-local variable.
-    thread_local moodycamel::ConsumerToken token(queue_);
+    // tokens for the task processor in a thread-local variable.
+    thread_local ConsumerTokens tokens(lanes_);
 
     boost::intrusive_ptr<impl::TaskContext> context{
-        DoPopBlocking(token),
+        DoPopBlocking(tokens),
         /* add_ref= */ false};
 
     if (!context) {
@@ -38,29 +53,45 @@ boost::intrusive_ptr<impl::TaskContext> TaskQueue::PopBlocking() {
 
 void TaskQueue::StopProcessing() { DoPush(nullptr); }
 
-std::size_t TaskQueue::GetSizeApproximate() const noexcept { return queue_.size_approx(); }
+std::size_t TaskQueue::GetSizeApproximate() const noexcept {
+    std::size_t size{0};
+    for (const auto& lane : lanes_) {
+        size += lane.size_approx();
+    }
+    return size;
+}
 
 void TaskQueue::PrepareWorker(std::size_t) {}
 
 void TaskQueue::DoPush(impl::TaskContext* context) {
+    const auto lane = context ? static_cast<std::size_t>(context->GetPriority()) : impl::kNormalLane;
+
     // This piece of code is copy-pasted from
     // moodycamel::BlockingConcurrentQueue::enqueue
-    queue_.enqueue(context);
+    lanes_[lane].enqueue(context);
     queue_semaphore_.signal();
 }
 
-impl::TaskContext* TaskQueue::DoPopBlocking(moodycamel::ConsumerToken& token) {
+impl::TaskContext* TaskQueue::DoPopBlocking(ConsumerTokens& tokens) {
     impl::TaskContext* context{};
 
-    // This piece of code is copy-pasted from
+    const auto preferred_lane = impl::kLanesSchedule[tokens.schedule_step++ % impl::kLanesSchedule.size()];
+
+    // This piece of code is based on
     // moodycamel::BlockingConcurrentQueue::wait_dequeue
     queue_semaphore_.wait();
-    while (!queue_.try_dequeue(token, context)) {
+    while (true) {
+        if (lanes_[preferred_lane].try_dequeue(tokens.tokens[preferred_lane], context)) {
+            return context;
+        }
+        for (std::size_t lane = 0; lane < kLanesCount; ++lane) {
+            if (lane != preferred_lane && lanes_[lane].try_dequeue(tokens.tokens[lane], context)) {
+                return context;
+            }
+        }
         // Can happen when another consumer steals our item in exchange for another
         // item in a Moodycamel sub-queue that we have already passed.
     }
-
-    return context;
 }
 
 }  // namespace engine
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <array>
+
 #include <moodycamel/blockingconcurrentqueue.h>
 #include <moodycamel/lightweightsemaphore.h>
 #include <boost/smart_ptr/intrusive_ptr.hpp>
@@ -30,11 +32,18 @@ public:
     void PrepareWorker(std::size_t index);
 
 private:
+    // One lane per Task::Priority
+    static constexpr std::size_t kLanesCount = 3;
+
+    using Lane = moodycamel::ConcurrentQueue<impl::TaskContext*>;
+
+    struct ConsumerTokens;
+
     void DoPush(impl::TaskContext* context);
 
-    impl::TaskContext* DoPopBlocking(moodycamel::ConsumerToken& token);
+    impl::TaskContext* DoPopBlocking(ConsumerTokens& tokens);
 
-    moodycamel::ConcurrentQueue<impl::TaskContext*> queue_;
+    std::array<Lane, kLanesCount> lanes_;
     moodycamel::LightweightSemaphore queue_semaphore_;
 };
 
@@ -15,6 +15,7 @@
 #include <userver/utils/span.hpp>
 
 #include <engine/task/task_context.hpp>
+#include <engine/task/task_lanes.hpp>
 #include <engine/task/work_stealing_queue/task_queue.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -50,13 +51,20 @@ Consumer::Consumer(WorkStealingTaskQueue& owner, ConsumersManager& consumers_man
       rnd_(utils::Rand()),
       steps_count_(rnd_()),
       global_queue_token_(owner_.global_queue_.CreateConsumerToken()),
-      background_queue_token_(owner.background_queue_.CreateConsumerToken()) {}
+      background_queue_token_(owner.background_queue_.CreateConsumerToken()),
+      critical_queue_token_(owner.critical_queue_.CreateConsumerToken()) {}
 
 void Consumer::Push(impl::TaskContext* ctx) {
-    if (ctx && ctx->IsBackground()) {
+    if (ctx && (ctx->IsBackground() || ctx->GetPriority() == Task::Priority::kBackground)) {
         owner_.background_queue_.Push(background_queue_token_, ctx);
         return;
     }
+    if (ctx && ctx->GetPriority() == Task::Priority::kCritical) {
+        // Critical tasks are shared between all the consumers, so that they
+        // don't wait behind the local queue of a busy one
+        owner_.PushCritical(&critical_queue_token_, ctx);
+        return;
+    }
     const std::size_t surplus_queue_size = local_queue_surplus_.GetSize();
     if (surplus_queue_size) {
         if (!local_queue_surplus_.TryPush(ctx)) {
@@ -81,6 +89,8 @@ WorkStealingTaskQueue* Consumer::GetOwner() const noexcept { return &owner_; }
 
 void Consumer::SetIndex(std::size_t index) noexcept { inner_index_ = index; }
 
+void Consumer::SetNumaNode(std::size_t numa_node) noexcept { numa_node_ = numa_node; }
+
 bool Consumer::IsStopped() const noexcept { return consumers_manager_.IsStopped(); }
 
 void Consumer::EmptySurplusQueue(impl::TaskContext* extra) {
@@ -105,17 +115,23 @@ Consumer::StealFromAnotherConsumerOrGlobalQueue(const std::size_t attempts, std:
     std::size_t stealed_size = 0;
     for (std::size_t i = 0; i < attempts && to_steal_count > 0 && stealed_size == 0; ++i) {
         std::size_t start_index = rnd_() % owner_.consumers_count_;
-        for (std::size_t shift = 0; shift < owner_.consumers_count_ && to_steal_count > 0 && stealed_size == 0;
-             ++shift) {
-            std::size_t index = (start_index + shift) % owner_.consumers_count_;
-            Consumer* victim = &owner_.consumers_[index];
-            if (victim == this) {
-                continue;
+        // With NUMA sharding the consumers of the same node are visited first
+        for (const bool same_node : {true, false}) {
+            for (std::size_t shift = 0; shift < owner_.consumers_count_ && to_steal_count > 0 && stealed_size == 0;
+                 ++shift) {
+                std::size_t index = (start_index + shift) % owner_.consumers_count_;
+                Consumer* victim = &owner_.consumers_[index];
+                if (victim == this || (owner_.is_numa_sharded_ && (victim->numa_node_ == numa_node_) != same_node)) {
+                    continue;
+                }
+                const std::size_t tasks_count =
+                    victim->Steal(utils::span(steal_buffer_.data() + stealed_size, to_steal_count));
+                stealed_size += tasks_count;
+                to_steal_count -= tasks_count;
+            }
+            if (!owner_.is_numa_sharded_) {
+                break;
             }
-            const std::size_t tasks_count =
-                victim->Steal(utils::span(steal_buffer_.data() + stealed_size, to_steal_count));
-            stealed_size += tasks_count;
-            to_steal_count -= tasks_count;
         }
 
         if (stealed_size == 0) {
@@ -187,8 +203,33 @@ impl::TaskContext* Consumer::TryPopFromOwnerQueue(const bool is_global) {
     return context;
 }
 
+impl::TaskContext* Consumer::TryPopCritical() {
+    if (owner_.critical_queue_size_.load() <= 0) {
+        return nullptr;
+    }
+    // Never move critical tasks to the local queue, they would lose priority
+    impl::TaskContext* context = owner_.critical_queue_.TryPop(critical_queue_token_);
+    if (context) {
+        owner_.critical_queue_size_.fetch_sub(1);
+    }
+    return context;
+}
+
 impl::TaskContext* Consumer::ProbabilisticPopFromOwnerQueues() {
     impl::TaskContext* context = nullptr;
+
+    // Same weighted round-robin of lanes as in TaskQueue. The normal lane is
+    // the local queue, which DoPop() looks into right after this function.
+    const auto preferred_lane = impl::kLanesSchedule[steps_count_ % impl::kLanesSchedule.size()];
+    if (preferred_lane == impl::kCriticalLane) {
+        context = TryPopCritical();
+    } else if (preferred_lane == impl::kBackgroundLane) {
+        context = owner_.background_queue_.TryPop(background_queue_token_);
+    }
+    if (context) {
+        return context;
+    }
+
     if (steps_count_ % kFrequencyGlobalQueuePop == 0) {
         context = owner_.global_queue_.TryPop(global_queue_token_);
         if (context) {
@@ -200,11 +241,18 @@ impl::TaskContext* Consumer::ProbabilisticPopFromOwnerQueues() {
 }
 
 impl::TaskContext* Consumer::TryPop() {
+    // The preferred lane of this step has already been looked into, so the
+    // lanes are visited here only as a fallback to avoid idling
     impl::TaskContext* context = TryPopFromOwnerQueue(/* is_global */ true);
     if (context) {
         return context;
     }
 
+    context = TryPopCritical();
+    if (context) {
+        return context;
+    }
+
     if (consumers_manager_.AllowStealing()) {
         context = StealFromAnotherConsumerOrGlobalQueue(steal_attempts_count_, kDefaultStealSize);
         bool last = consumers_manager_.StopStealing();
@@ -227,7 +275,12 @@ impl::TaskContext* Consumer::TryPop() {
 }
 
 impl::TaskContext* Consumer::TryPopBeforeSleep() {
-    impl::TaskContext* context = StealFromAnotherConsumerOrGlobalQueue(1, 1);
+    impl::TaskContext* context = TryPopCritical();
+    if (context) {
+        return context;
+    }
+
+    context = StealFromAnotherConsumerOrGlobalQueue(1, 1);
     if (context) {
         return context;
     }
@@ -37,6 +37,8 @@ private:
 
     void SetIndex(std::size_t index) noexcept;
 
+    void SetNumaNode(std::size_t numa_node) noexcept;
+
     bool IsStopped() const noexcept;
 
     void EmptySurplusQueue(impl::TaskContext* extra);
@@ -47,6 +49,8 @@ private:
 
     impl::TaskContext* TryPopFromOwnerQueue(const bool is_global);
 
+    impl::TaskContext* TryPopCritical();
+
     impl::TaskContext* ProbabilisticPopFromOwnerQueues();
 
     impl::TaskContext* TryPop();
@@ -73,6 +77,7 @@ private:
     ConsumersManager& consumers_manager_;
     const std::size_t steal_attempts_count_;
     std::size_t inner_index_{0};
+    std::size_t numa_node_{0};
     // kConsumerStealBufferSize + 1 for extra task in push
     std::array<impl::TaskContext*, kConsumerStealBufferSize + 1> steal_buffer_{};
     std::minstd_rand rnd_;
@@ -80,6 +85,7 @@ private:
     std::atomic<std::int32_t> sleep_counter_{0};
     GlobalQueue::Token global_queue_token_;
     GlobalQueue::Token background_queue_token_;
+    GlobalQueue::Token critical_queue_token_;
 #ifndef __linux__
     std::condition_variable cv_;
     std::mutex mutex_;
@@ -4,6 +4,7 @@
 #include <userver/utils/rand.hpp>
 
 #include <engine/task/task_context.hpp>
+#include <utils/numa.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -19,10 +20,16 @@ WorkStealingTaskQueue::WorkStealingTaskQueue(const TaskProcessorConfig& config)
     : consumers_count_(config.worker_threads),
       global_queue_(consumers_count_),
       background_queue_(consumers_count_),
+      critical_queue_(consumers_count_),
       consumers_(config.worker_threads, *this, consumers_manager_),
       consumers_manager_(consumers_count_) {
     for (size_t i = 0; i < consumers_count_; ++i) {
         consumers_[i].SetIndex(i);
+        if (!config.cpu_affinity.empty()) {
+            const auto numa_node = utils::numa::GetCpuNode(config.cpu_affinity[i % config.cpu_affinity.size()]);
+            consumers_[i].SetNumaNode(numa_node);
+            is_numa_sharded_ |= (numa_node != consumers_[0].numa_node_);
+        }
     }
 }
 
@@ -51,6 +58,7 @@ std::size_t WorkStealingTaskQueue::GetSizeApproximate() const noexcept {
     }
     size += global_queue_.GetSizeApproximate();
     size += background_queue_.GetSizeApproximate();
+    size += critical_queue_.GetSizeApproximate();
     return size;
 }
 
@@ -68,6 +76,10 @@ void WorkStealingTaskQueue::DoPush(impl::TaskContext* context) {
             consumer->Push(context);
         } else if (context && context->IsBackground()) {
             background_queue_.Push(context);
+        } else if (context && context->GetPriority() == Task::Priority::kCritical) {
+            PushCritical(nullptr, context);
+        } else if (context && context->GetPriority() == Task::Priority::kBackground) {
+            background_queue_.Push(context);
         } else {
             global_queue_.Push(context);
         }
@@ -75,6 +87,15 @@ void WorkStealingTaskQueue::DoPush(impl::TaskContext* context) {
     consumers_manager_.NotifyNewTask();
 }
 
+void WorkStealingTaskQueue::PushCritical(GlobalQueue::Token* token, impl::TaskContext* context) {
+    critical_queue_size_.fetch_add(1);
+    if (token) {
+        critical_queue_.Push(*token, context);
+    } else {
+        critical_queue_.Push(context);
+    }
+}
+
 impl::TaskContext* WorkStealingTaskQueue::DoPopBlocking() {
     Consumer* consumer = GetConsumer();
     UASSERT(consumer != nullptr);
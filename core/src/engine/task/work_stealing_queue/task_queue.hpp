@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 
 #include <boost/smart_ptr/intrusive_ptr.hpp>
 
@@ -36,14 +38,22 @@ public:
 private:
     void DoPush(impl::TaskContext* context);
 
+    void PushCritical(GlobalQueue::Token* token, impl::TaskContext* context);
+
     impl::TaskContext* DoPopBlocking();
 
     Consumer* GetConsumer();
 
     const std::size_t consumers_count_;
+    // whether the consumers are pinned to CPUs of more than one NUMA node
+    bool is_numa_sharded_{false};
 
     GlobalQueue global_queue_;
     GlobalQueue background_queue_;
+    GlobalQueue critical_queue_;
+    // Approximate count of tasks in critical_queue_, allows consumers to skip
+    // the lane cheaply while it is not used
+    std::atomic<std::int64_t> critical_queue_size_{0};
     utils::FixedArray<Consumer> consumers_;
     ConsumersManager consumers_manager_;
 };
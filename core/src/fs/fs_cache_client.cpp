@@ -40,8 +40,16 @@ bool IsFilepathHidden(const std::string& path) {
 }  // namespace
 #endif  // __linux__
 
-FsCacheClient::FsCacheClient(std::string_view dir, std::chrono::milliseconds update_period, engine::TaskProcessor& tp)
-    : dir_(GetNormalizeDirectory(dir)), update_period_(update_period), tp_(tp) {
+FsCacheClient::FsCacheClient(
+    std::string_view dir,
+    std::chrono::milliseconds update_period,
+    engine::TaskProcessor& tp,
+    std::size_t max_loaded_file_size
+)
+    : dir_(GetNormalizeDirectory(dir)),
+      update_period_(update_period),
+      tp_(tp),
+      max_loaded_file_size_(max_loaded_file_size) {
     UpdateCache();
 
     if (update_period_ == std::chrono::milliseconds(0)) {
@@ -56,7 +64,8 @@ FsCacheClient::FsCacheClient(std::string_view dir, std::chrono::milliseconds upd
 }
 
 void FsCacheClient::UpdateCache() {
-    auto map = fs::ReadRecursiveFilesInfoWithData(tp_, dir_, {fs::SettingsReadFile::kSkipHidden});
+    auto map =
+        fs::ReadRecursiveFilesInfoWithData(tp_, dir_, {fs::SettingsReadFile::kSkipHidden}, max_loaded_file_size_);
     data_.Assign(std::move(map));
 }
 
@@ -101,9 +110,7 @@ void FsCacheClient::HandleDeleteDirectory(engine::io::sys_linux::Inotify& inotif
 void FsCacheClient::HandleCreate(const std::string& path) {
     if (IsFilepathHidden(path)) return;
 
-    FileInfoWithData info{};
-    info.extension = boost::filesystem::path(path).extension().string();
-    info.data = ReadFileContents(tp_, path);
+    auto info = ReadFileInfoWithData(tp_, path, max_loaded_file_size_);
     data_.InsertOrAssign(GetLexicallyRelative(path, dir_), std::make_shared<const FileInfoWithData>(std::move(info)));
 }
 
@@ -18,6 +18,21 @@ bool IsHiddenFile(const boost::filesystem::path& path) {
     return name != ".." && name != "." && name[0] == '.';
 }
 
+FileInfoWithData ReadFileInfoWithDataBlocking(const std::string& path, std::size_t max_loaded_size) {
+    FileInfoWithData info{};
+    const boost::filesystem::path fs_path{path};
+    info.extension = fs_path.extension().string();
+    info.path = path;
+    info.size = boost::filesystem::file_size(fs_path);
+    info.last_modified = std::chrono::system_clock::from_time_t(boost::filesystem::last_write_time(fs_path));
+    info.is_loaded = info.size <= max_loaded_size;
+    if (info.is_loaded) {
+        info.data = fs::blocking::ReadFileContents(path);
+        info.size = info.data.size();
+    }
+    return info;
+}
+
 }  // namespace
 
 std::string GetLexicallyRelative(std::string_view path, std::string_view dir) {
@@ -34,7 +49,8 @@ std::string ReadFileContents(engine::TaskProcessor& async_tp, const std::string&
 FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
     engine::TaskProcessor& async_tp,
     const std::string& path,
-    utils::Flags<SettingsReadFile> flags
+    utils::Flags<SettingsReadFile> flags,
+    std::size_t max_loaded_size
 ) {
     FileInfoWithDataMap data{};
     for (auto it = utils::Async(
@@ -45,15 +61,18 @@ FileInfoWithDataMap ReadRecursiveFilesInfoWithData(
         // only files
         if (it->status().type() != boost::filesystem::regular_file) continue;
         if ((flags & SettingsReadFile::kSkipHidden) && IsHiddenFile(it->path())) continue;
-        FileInfoWithData info{};
-        info.extension = it->path().extension().string();
-        info.data = ReadFileContents(async_tp, it->path().string());
+        auto info = ReadFileInfoWithData(async_tp, it->path().string(), max_loaded_size);
         data[GetLexicallyRelative(it->path().string(), path)] =
             std::make_shared<const FileInfoWithData>(std::move(info));
     }
     return data;
 }
 
+FileInfoWithData
+ReadFileInfoWithData(engine::TaskProcessor& async_tp, const std::string& path, std::size_t max_loaded_size) {
+    return engine::AsyncNoSpan(async_tp, &ReadFileInfoWithDataBlocking, path, max_loaded_size).Get();
+}
+
 bool FileExists(engine::TaskProcessor& async_tp, const std::string& path) {
     return engine::AsyncNoSpan(async_tp, &fs::blocking::FileExists, path).Get();
 }
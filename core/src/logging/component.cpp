@@ -97,7 +97,10 @@ void Logging::Init(const ComponentConfig& config, const ComponentContext& contex
         }
 
         logger->StartConsumerTask(
-            context.GetTaskProcessor(tp_name), logger_config.message_queue_size, logger_config.queue_overflow_behavior
+            context.GetTaskProcessor(tp_name),
+            logger_config.message_queue_size,
+            logger_config.queue_overflow_behavior,
+            logger_config.message_buffer_size
         );
 
         auto insertion_result = loggers_.emplace(logger_config.logger_name, std::move(logger));
@@ -273,6 +276,7 @@ properties:
                       - tskv
                       - ltsv
                       - raw
+                      - json
                 flush_level:
                     type: string
                     description: messages of this and higher levels get flushed to the file immediately
@@ -288,6 +292,10 @@ properties:
                     enum:
                       - discard
                       - block
+                message_buffer_size:
+                    type: integer
+                    description: the size in bytes of the per-thread buffer that records of the task processor threads go through before the queue, must be a power of 2, 0 disables the buffers
+                    defaultDescription: 32768
                 fs-task-processor:
                     type: string
                     description: task processor for disk I/O operations for this logger
@@ -24,6 +24,7 @@ QueueOverflowBehavior Parse(const yaml_config::YamlConfig& value, formats::parse
 
 struct LoggerConfig final {
     static constexpr size_t kDefaultMessageQueueSize = 1 << 16;
+    static constexpr size_t kDefaultMessageBufferSize = 1 << 15;
 
     void SetName(std::string name);
 
@@ -38,6 +39,9 @@ struct LoggerConfig final {
     size_t message_queue_size = kDefaultMessageQueueSize;
     QueueOverflowBehavior queue_overflow_behavior = QueueOverflowBehavior::kDiscard;
 
+    // per task processor thread, must be a power of 2, 0 disables the buffers
+    size_t message_buffer_size = kDefaultMessageBufferSize;
+
     std::optional<std::string> fs_task_processor;
 
     std::optional<TestsuiteCaptureConfig> testsuite_capture;
@@ -1,5 +1,6 @@
 #include "buffered_file_sink.hpp"
 
+#include "fd_sink.hpp"
 #include "open_file_helper.hpp"
 
 USERVER_NAMESPACE_BEGIN
@@ -24,6 +25,17 @@ BufferedFileSink::~BufferedFileSink() = default;
 
 void BufferedFileSink::Write(std::string_view log) { file_.Write(log); }
 
+void BufferedFileSink::WriteBatch(utils::span<const std::string_view> logs) {
+    if (logs.size() == 1) {
+        file_.Write(logs[0]);
+        return;
+    }
+    // A batch is large enough to bypass the stdio buffer, which would split it
+    // into many small writes
+    file_.FlushLight();
+    WriteVectored(::fileno(file_.GetNative()), logs);
+}
+
 void BufferedFileSink::Flush() {
     if (file_.IsOpen()) {
         file_.FlushLight();
@@ -1,13 +1,66 @@
 #include "fd_sink.hpp"
 
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <system_error>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+// Not IOV_MAX to stay small enough for a coroutine stack
+constexpr std::size_t kMaxIovecCount = 256;
+
+}  // namespace
+
+void WriteVectored(int fd, utils::span<const std::string_view> logs) {
+    std::array<struct ::iovec, kMaxIovecCount> iovecs{};
+
+    while (!logs.empty()) {
+        const auto count = std::min(logs.size(), iovecs.size());
+        for (std::size_t i = 0; i < count; ++i) {
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+            iovecs[i].iov_base = const_cast<char*>(logs[i].data());
+            iovecs[i].iov_len = logs[i].size();
+        }
+        logs = logs.subspan(count);
+
+        auto* current = iovecs.data();
+        auto* const end = current + count;
+        while (current != end) {
+            const auto result = ::writev(fd, current, static_cast<int>(end - current));
+            if (result < 0) {
+                if (errno == EAGAIN || errno == EINTR) continue;
+
+                const auto code = std::make_error_code(std::errc{errno});
+                throw std::system_error(code, "calling ::writev");
+            }
+            auto written = static_cast<std::size_t>(result);
+
+            // Skip the fully written records and adjust the partially written one
+            while (current != end && written >= current->iov_len) {
+                written -= current->iov_len;
+                ++current;
+            }
+            if (current != end) {
+                current->iov_base = static_cast<char*>(current->iov_base) + written;
+                current->iov_len -= written;
+            }
+        }
+    }
+}
+
 FdSink::FdSink(fs::blocking::FileDescriptor fd) : fd_{std::move(fd)} {}
 
 void FdSink::Write(std::string_view log) { fd_.Write(log); }
 
+void FdSink::WriteBatch(utils::span<const std::string_view> logs) { WriteVectored(fd_.GetNative(), logs); }
+
 void FdSink::Flush() {
     if (fd_.IsOpen()) {
         fd_.FSync();
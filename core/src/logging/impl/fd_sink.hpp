@@ -10,6 +10,9 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+/// Writes all the `logs` to `fd` with as few writev(2) calls as possible
+void WriteVectored(int fd, utils::span<const std::string_view> logs);
+
 class FdSink : public BaseSink {
 public:
     explicit FdSink(fs::blocking::FileDescriptor fd);
@@ -21,6 +24,8 @@ public:
 protected:
     void Write(std::string_view log) final;
 
+    void WriteBatch(utils::span<const std::string_view> logs) final;
+
     fs::blocking::FileDescriptor& GetFd();
 
     void SetFd(fs::blocking::FileDescriptor&& fd);
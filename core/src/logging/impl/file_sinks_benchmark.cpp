@@ -1,7 +1,10 @@
 #include <benchmark/benchmark.h>
 
+#include <vector>
+
 #include <userver/fs/blocking/temp_directory.hpp>
 #include <userver/utils/rand.hpp>
+#include <utils/gbench_allocated_bytes.hpp>
 
 #include "buffered_file_sink.hpp"
 #include "file_sink.hpp"
@@ -14,11 +17,13 @@ void check_file_sink(benchmark::State& state) {
     const auto temp_root = fs::blocking::TempDirectory::Create();
     const std::string filename = temp_root.GetPath() + "/temp_file_" + std::to_string(utils::Rand());
     auto sink = logging::impl::FileSink(filename);
+    const utils::GbenchAllocatedBytes allocated_bytes;
     for ([[maybe_unused]] auto _ : state) {
         for (auto i = 0; i < kCountLogs; ++i) {
             sink.Log({"message\n", logging::Level::kWarning});
         }
     }
+    allocated_bytes.Report(state);
     sink.Flush();
 }
 BENCHMARK(check_file_sink);
@@ -27,13 +32,48 @@ void check_buffered_file_sink(benchmark::State& state) {
     const auto temp_root = fs::blocking::TempDirectory::Create();
     const std::string filename = temp_root.GetPath() + "/temp_file_" + std::to_string(utils::Rand());
     auto sink = logging::impl::BufferedFileSink(filename);
+    const utils::GbenchAllocatedBytes allocated_bytes;
     for ([[maybe_unused]] auto _ : state) {
         for (auto i = 0; i < kCountLogs; ++i) {
             sink.Log({"message\n", logging::Level::kWarning});
         }
     }
+    allocated_bytes.Report(state);
     sink.Flush();
 }
 BENCHMARK(check_buffered_file_sink);
 
+namespace {
+
+constexpr std::size_t kBatchSize = 256;
+
+template <typename Sink>
+void check_sink_batch(benchmark::State& state) {
+    const auto temp_root = fs::blocking::TempDirectory::Create();
+    const std::string filename = temp_root.GetPath() + "/temp_file_" + std::to_string(utils::Rand());
+    auto sink = Sink(filename);
+    // What TpLogger passes to the sinks when draining its buffer
+    const std::vector<logging::impl::LogMessage> batch(kBatchSize, {"message\n", logging::Level::kWarning});
+    const utils::GbenchAllocatedBytes allocated_bytes;
+    for ([[maybe_unused]] auto _ : state) {
+        for (std::size_t i = 0; i < kCountLogs / kBatchSize; ++i) {
+            sink.LogBatch(batch);
+        }
+    }
+    allocated_bytes.Report(state);
+    sink.Flush();
+    state.counters["records"] =
+        benchmark::Counter(state.iterations() * (kCountLogs / kBatchSize) * kBatchSize, benchmark::Counter::kIsRate);
+}
+
+}  // namespace
+
+void check_file_sink_batch(benchmark::State& state) { check_sink_batch<logging::impl::FileSink>(state); }
+BENCHMARK(check_file_sink_batch);
+
+void check_buffered_file_sink_batch(benchmark::State& state) {
+    check_sink_batch<logging::impl::BufferedFileSink>(state);
+}
+BENCHMARK(check_buffered_file_sink_batch);
+
 USERVER_NAMESPACE_END
@@ -181,6 +181,28 @@ UTEST_P(FileSinks, TestValidWriteMultiInFile) {
     EXPECT_EQ(test::ReadFromFile(Filename()), test::Messages("message", "message 2", "message 3"));
 }
 
+UTEST_P(FileSinks, TestValidWriteBatchInFile) {
+    EXPECT_NO_THROW(Sink().Log({"message\n", logging::Level::kWarning}));
+    Sink().SetLevel(logging::Level::kInfo);
+
+    std::vector<logging::impl::LogMessage> batch{
+        {"message 2\n", logging::Level::kInfo},
+        {"filtered\n", logging::Level::kDebug},
+    };
+    // More records than a single writev(2) takes
+    for (int i = 0; i < 300; ++i) batch.push_back({"batched\n", logging::Level::kError});
+    batch.push_back({"message 3\n", logging::Level::kCritical});
+    EXPECT_NO_THROW(Sink().LogBatch(batch));
+    EXPECT_NO_THROW(Sink().Flush());
+
+    const auto logs = test::ReadFromFile(Filename());
+    ASSERT_EQ(logs.size(), 303);
+    EXPECT_EQ(logs[0], "message");
+    EXPECT_EQ(logs[1], "message 2");
+    EXPECT_EQ(logs[2], "batched");
+    EXPECT_EQ(logs[302], "message 3");
+}
+
 INSTANTIATE_UTEST_SUITE_P(
     /* no prefix */,
     FileSinks,
@@ -0,0 +1,121 @@
+#include "log_ring_buffer.hpp"
+
+#include <cstring>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+namespace {
+
+// Each record starts with a 8-byte header followed by the 8-byte time:
+// | padding (1 bit) | unused | level (8 bits) | size (32 bits) |
+// A padding record consists of the header only.
+constexpr std::uint64_t kPaddingBit = std::uint64_t{1} << 63;
+constexpr std::uint64_t kSizeMask = 0xffffffff;
+constexpr int kLevelShift = 32;
+
+constexpr std::size_t kWordSize = sizeof(std::uint64_t);
+constexpr std::size_t kHeaderSize = 2 * kWordSize;
+
+constexpr std::size_t GetRecordSize(std::size_t payload_size) noexcept {
+    return (kHeaderSize + payload_size + kWordSize - 1) / kWordSize * kWordSize;
+}
+
+std::uint64_t ReadWord(const char* data) noexcept {
+    std::uint64_t result{};
+    std::memcpy(&result, data, sizeof(result));
+    return result;
+}
+
+void WriteWord(char* data, std::uint64_t value) noexcept { std::memcpy(data, &value, sizeof(value)); }
+
+}  // namespace
+
+LogRingBuffer::LogRingBuffer(std::size_t capacity)
+    : capacity_(capacity), data_(new std::uint64_t[capacity / kWordSize]()) {
+    UINVARIANT(
+        capacity >= 2 * kHeaderSize && capacity <= (std::size_t{1} << 31) && (capacity & (capacity - 1)) == 0,
+        "Log buffer size must be a power of 2"
+    );
+}
+
+LogRingBuffer::~LogRingBuffer() = default;
+
+bool LogRingBuffer::TryPush(Level level, std::string_view payload, std::uint64_t time) noexcept {
+    const auto record_size = GetRecordSize(payload.size());
+    // Huge records would lead to a lot of padding
+    if (record_size > capacity_ / 2) return false;
+
+    auto& producer = *producer_;
+    auto position = producer.head;
+    const auto space_till_end = capacity_ - (position & (capacity_ - 1));
+    const auto padding_size = record_size > space_till_end ? space_till_end : 0;
+    const auto new_position = position + padding_size + record_size;
+    if (new_position - producer.cached_tail > capacity_) {
+        // Synchronizes with Release, the space is not read by the consumer anymore
+        producer.cached_tail = tail_->load(std::memory_order_acquire);
+        if (new_position - producer.cached_tail > capacity_) return false;
+    }
+
+    if (padding_size != 0) {
+        WriteWord(GetRecord(position), kPaddingBit | padding_size);
+        position += padding_size;
+    }
+    auto* const record = GetRecord(position);
+    WriteWord(record, (static_cast<std::uint64_t>(level) << kLevelShift) | payload.size());
+    WriteWord(record + kWordSize, time);
+    std::memcpy(record + kHeaderSize, payload.data(), payload.size());
+
+    producer.head = new_position;
+    head_->store(new_position, std::memory_order_release);
+    return true;
+}
+
+bool LogRingBuffer::Front(Record& record) noexcept {
+    auto& consumer = *consumer_;
+    while (true) {
+        if (consumer.read_position == consumer.cached_head) {
+            consumer.cached_head = head_->load(std::memory_order_acquire);
+            if (consumer.read_position == consumer.cached_head) return false;
+        }
+
+        const auto* const data = GetRecord(consumer.read_position);
+        const auto header = ReadWord(data);
+        const auto size = header & kSizeMask;
+        if (header & kPaddingBit) {
+            consumer.read_position += size;
+            continue;
+        }
+
+        record.payload = std::string_view{data + kHeaderSize, size};
+        record.level = static_cast<Level>((header >> kLevelShift) & 0xff);
+        record.time = ReadWord(data + kWordSize);
+        return true;
+    }
+}
+
+void LogRingBuffer::Pop() noexcept {
+    auto& consumer = *consumer_;
+    UASSERT(consumer.read_position != consumer.cached_head);
+    const auto header = ReadWord(GetRecord(consumer.read_position));
+    UASSERT(!(header & kPaddingBit));
+    consumer.read_position += GetRecordSize(header & kSizeMask);
+}
+
+void LogRingBuffer::Release() noexcept {
+    auto& consumer = *consumer_;
+    if (consumer.released_position == consumer.read_position) return;
+    consumer.released_position = consumer.read_position;
+    tail_->store(consumer.read_position, std::memory_order_release);
+}
+
+char* LogRingBuffer::GetRecord(std::uint64_t position) const noexcept {
+    return reinterpret_cast<char*>(data_.get()) + (position & (capacity_ - 1));
+}
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
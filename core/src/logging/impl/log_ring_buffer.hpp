@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+#include <userver/concurrent/impl/interference_shield.hpp>
+#include <userver/logging/level.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// @brief Bounded wait-free SPSC byte buffer of formatted log records.
+///
+/// The producer copies the record after the head position and publishes it by
+/// advancing the head. The consumer reads the records right from the buffer
+/// and gives the space back by advancing the tail, so a record costs no
+/// allocations and no read-modify-write operations. Records are never split
+/// at the buffer end, a padding record fills the rest of the buffer instead.
+class LogRingBuffer final {
+public:
+    struct Record final {
+        std::string_view payload;
+        Level level{};
+        // Set by the producer, e.g. for merging the records of several buffers
+        std::uint64_t time{};
+    };
+
+    /// @param capacity buffer size in bytes, must be a power of 2
+    explicit LogRingBuffer(std::size_t capacity);
+
+    LogRingBuffer(LogRingBuffer&&) = delete;
+    LogRingBuffer& operator=(LogRingBuffer&&) = delete;
+    ~LogRingBuffer();
+
+    /// @returns false if the buffer has no space for the record
+    /// @note Only a single producer may call TryPush at a time
+    bool TryPush(Level level, std::string_view payload, std::uint64_t time) noexcept;
+
+    /// @brief Reads the oldest record that was not popped yet, the payload
+    /// stays valid until Release().
+    /// @returns false if there are no published records
+    /// @note Only a single consumer may call Front, Pop and Release at a time
+    bool Front(Record& record) noexcept;
+
+    /// Skips the record returned by Front
+    void Pop() noexcept;
+
+    /// Makes the space taken by the popped records available to the producer
+    void Release() noexcept;
+
+    std::size_t GetCapacity() const noexcept { return capacity_; }
+
+private:
+    char* GetRecord(std::uint64_t position) const noexcept;
+
+    const std::size_t capacity_;
+    const std::unique_ptr<std::uint64_t[]> data_;
+
+    concurrent::impl::InterferenceShield<std::atomic<std::uint64_t>> head_{0};
+    concurrent::impl::InterferenceShield<std::atomic<std::uint64_t>> tail_{0};
+
+    struct ProducerState final {
+        std::uint64_t head{0};
+        std::uint64_t cached_tail{0};
+    };
+    struct ConsumerState final {
+        std::uint64_t read_position{0};
+        std::uint64_t released_position{0};
+        std::uint64_t cached_head{0};
+    };
+    concurrent::impl::InterferenceShield<ProducerState> producer_;
+    concurrent::impl::InterferenceShield<ConsumerState> consumer_;
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,123 @@
+#include "log_ring_buffer.hpp"
+
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::vector<std::string> PopAll(logging::impl::LogRingBuffer& buffer) {
+    std::vector<std::string> result;
+    logging::impl::LogRingBuffer::Record record;
+    while (buffer.Front(record)) {
+        result.emplace_back(record.payload);
+        buffer.Pop();
+    }
+    buffer.Release();
+    return result;
+}
+
+}  // namespace
+
+TEST(LogRingBuffer, Basic) {
+    logging::impl::LogRingBuffer buffer{1024};
+    EXPECT_TRUE(PopAll(buffer).empty());
+
+    EXPECT_TRUE(buffer.TryPush(logging::Level::kInfo, "first\n", 1));
+    EXPECT_TRUE(buffer.TryPush(logging::Level::kError, "second\n", 2));
+
+    logging::impl::LogRingBuffer::Record record;
+    ASSERT_TRUE(buffer.Front(record));
+    EXPECT_EQ(record.payload, "first\n");
+    EXPECT_EQ(record.level, logging::Level::kInfo);
+    EXPECT_EQ(record.time, 1);
+    buffer.Pop();
+
+    ASSERT_TRUE(buffer.Front(record));
+    EXPECT_EQ(record.payload, "second\n");
+    EXPECT_EQ(record.level, logging::Level::kError);
+    EXPECT_EQ(record.time, 2);
+    buffer.Pop();
+    buffer.Release();
+
+    EXPECT_FALSE(buffer.Front(record));
+}
+
+TEST(LogRingBuffer, Full) {
+    logging::impl::LogRingBuffer buffer{256};
+    const std::string record(48, '*');
+
+    // 64 bytes per record including the header
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(buffer.TryPush(logging::Level::kInfo, record, i));
+    }
+    EXPECT_FALSE(buffer.TryPush(logging::Level::kInfo, record, 4));
+    EXPECT_FALSE(buffer.TryPush(logging::Level::kInfo, "x", 4));
+
+    // The space is only available after Release
+    logging::impl::LogRingBuffer::Record front;
+    ASSERT_TRUE(buffer.Front(front));
+    buffer.Pop();
+    EXPECT_FALSE(buffer.TryPush(logging::Level::kInfo, record, 4));
+    buffer.Release();
+    EXPECT_TRUE(buffer.TryPush(logging::Level::kInfo, record, 4));
+
+    EXPECT_EQ(PopAll(buffer).size(), 4);
+
+    // Too large to ever fit without a lot of padding
+    EXPECT_FALSE(buffer.TryPush(logging::Level::kInfo, std::string(200, '*'), 5));
+}
+
+TEST(LogRingBuffer, WrapAround) {
+    logging::impl::LogRingBuffer buffer{256};
+
+    for (int i = 0; i < 100; ++i) {
+        // Records of different sizes make the padding appear at different offsets
+        const auto first = fmt::format("{}:{}", i, std::string(i % 50, 'a'));
+        const auto second = fmt::format("{}:{}", i, std::string(i % 30, 'b'));
+        ASSERT_TRUE(buffer.TryPush(logging::Level::kInfo, first, i));
+        ASSERT_TRUE(buffer.TryPush(logging::Level::kWarning, second, i));
+
+        EXPECT_EQ(PopAll(buffer), (std::vector<std::string>{first, second}));
+    }
+}
+
+TEST(LogRingBuffer, ProducerConsumer) {
+    constexpr int kRecords = 100000;
+    logging::impl::LogRingBuffer buffer{1 << 12};
+
+    std::thread producer([&buffer] {
+        for (int i = 0; i < kRecords; ++i) {
+            const auto record = fmt::format("{}{}", i, std::string(i % 40, '.'));
+            while (!buffer.TryPush(logging::Level::kInfo, record, i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int next_record = 0;
+    logging::impl::LogRingBuffer::Record record;
+    while (next_record < kRecords) {
+        for (int popped = 0; popped < 100 && buffer.Front(record); ++popped) {
+            ASSERT_EQ(record.time, next_record);
+            int index = -1;
+            ASSERT_EQ(std::sscanf(std::string{record.payload}.c_str(), "%d", &index), 1);
+            ASSERT_EQ(index, next_record);
+            ASSERT_EQ(record.payload.size(), std::to_string(index).size() + index % 40);
+            buffer.Pop();
+            ++next_record;
+        }
+        buffer.Release();
+    }
+
+    producer.join();
+    EXPECT_TRUE(PopAll(buffer).empty());
+}
+
+USERVER_NAMESPACE_END
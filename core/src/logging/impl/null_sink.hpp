@@ -12,6 +12,8 @@ public:
 
 protected:
     void Write(std::string_view /*log*/) override {}
+
+    void WriteBatch(utils::span<const std::string_view> /*logs*/) override {}
 };
 
 }  // namespace logging::impl
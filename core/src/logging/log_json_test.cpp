@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <logging/logging_test.hpp>
+#include <userver/formats/json/serialize.hpp>
+#include <userver/formats/json/value.hpp>
+#include <userver/logging/impl/log_record.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+std::vector<formats::json::Value> ParseJsonRecords(std::string_view log) {
+    std::vector<formats::json::Value> result;
+    for (const auto& line : utils::text::Split(log, "\n")) {
+        if (line.empty()) continue;
+        result.push_back(formats::json::FromString(line));
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST_F(LoggingJsonTest, Basic) {
+    constexpr auto kJsonTextToLog = "This is the JSON text to log";
+    LOG_INFO() << kJsonTextToLog;
+    logging::LogFlush();
+
+    const auto str = GetStreamString();
+    ASSERT_FALSE(str.empty());
+    EXPECT_EQ(str.front(), '{') << str;
+    EXPECT_EQ(str.back(), '\n') << str;
+
+    const auto records = ParseJsonRecords(str);
+    ASSERT_EQ(records.size(), 1) << str;
+    const auto& record = records[0];
+    EXPECT_EQ(record["text"].As<std::string>(), kJsonTextToLog);
+    EXPECT_EQ(record["level"].As<std::string>(), "INFO");
+    EXPECT_TRUE(record.HasMember("timestamp")) << str;
+    EXPECT_TRUE(record.HasMember("module")) << str;
+    EXPECT_TRUE(record.HasMember("thread_id")) << str;
+}
+
+TEST_F(LoggingJsonTest, Escaping) {
+    const std::string text = "quote\" backslash\\ newline\n tab\t control\x01 utf8 \xd0\xbf\xd1\x80\xd0\xb8";
+    LOG_INFO() << text << logging::LogExtra{{"key\"with\tescaping", text}};
+    logging::LogFlush();
+
+    const auto records = ParseJsonRecords(GetStreamString());
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0]["text"].As<std::string>(), text);
+    EXPECT_EQ(records[0]["key\"with\tescaping"].As<std::string>(), text);
+}
+
+TEST_F(LoggingJsonTest, TypedTags) {
+    LOG_INFO() << "typed" << logging::LogExtra{
+        {"int", -42},
+        {"unsigned", 42U},
+        {"double", 1.5},
+        {"string", "42"},
+        {"nan", std::numeric_limits<double>::quiet_NaN()},
+        {"inf", std::numeric_limits<double>::infinity()},
+    };
+    logging::LogFlush();
+
+    const auto records = ParseJsonRecords(GetStreamString());
+    ASSERT_EQ(records.size(), 1);
+    const auto& record = records[0];
+    EXPECT_TRUE(record["int"].IsInt64());
+    EXPECT_EQ(record["int"].As<int>(), -42);
+    EXPECT_TRUE(record["unsigned"].IsUInt64());
+    EXPECT_EQ(record["unsigned"].As<unsigned>(), 42);
+    EXPECT_TRUE(record["double"].IsDouble());
+    EXPECT_DOUBLE_EQ(record["double"].As<double>(), 1.5);
+    EXPECT_TRUE(record["string"].IsString());
+    EXPECT_EQ(record["string"].As<std::string>(), "42");
+    // Not representable as JSON numbers
+    EXPECT_TRUE(record["nan"].IsString());
+    EXPECT_TRUE(record["inf"].IsString());
+}
+
+TEST_F(LoggingJsonTest, MultipleRecords) {
+    for (int i = 0; i < 10; ++i) {
+        LOG_INFO() << "record " << i << logging::LogExtra{{"index", i}};
+    }
+    logging::LogFlush();
+
+    const auto records = ParseJsonRecords(GetStreamString());
+    ASSERT_EQ(records.size(), 10);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ(records[i]["text"].As<std::string>(), "record " + std::to_string(i));
+        EXPECT_EQ(records[i]["index"].As<int>(), i);
+    }
+}
+
+TEST_F(LoggingJsonTest, FromLogRecord) {
+    const logging::impl::LogTag tags[] = {
+        {"trace_id", "abcdef", logging::impl::TagType::kString},
+        {"count", "7", logging::impl::TagType::kInteger},
+        {"key\twith\ttabs", "value\n", logging::impl::TagType::kString},
+    };
+    logging::impl::LogRecord record;
+    record.level = logging::Level::kWarning;
+    record.timestamp = std::chrono::system_clock::now();
+    record.text = "structured \"text\"";
+    record.tags = tags;
+
+    // Records of the structured loggers are formatted this way when forwarded
+    // to the text loggers
+    GetStreamLogger()->LogStructured(record);
+    logging::LogFlush();
+
+    const auto records = ParseJsonRecords(GetStreamString());
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0]["text"].As<std::string>(), record.text);
+    EXPECT_EQ(records[0]["level"].As<std::string>(), "WARNING");
+    EXPECT_EQ(records[0]["trace_id"].As<std::string>(), "abcdef");
+    EXPECT_EQ(records[0]["count"].As<int>(), 7);
+    EXPECT_EQ(records[0]["key\twith\ttabs"].As<std::string>(), "value\n");
+}
+
+TEST_F(LoggingTest, FromLogRecord) {
+    const logging::impl::LogTag tags[] = {
+        {"count", "7", logging::impl::TagType::kInteger},
+    };
+    logging::impl::LogRecord record;
+    record.level = logging::Level::kInfo;
+    record.timestamp = std::chrono::system_clock::now();
+    record.text = "structured\ttext";
+    record.tags = tags;
+
+    GetStreamLogger()->LogStructured(record);
+
+    EXPECT_EQ(LoggedText(), "structured\\ttext");
+    EXPECT_NE(GetStreamString().find("\tcount=7\t"), std::string::npos) << GetStreamString();
+}
+
+USERVER_NAMESPACE_END
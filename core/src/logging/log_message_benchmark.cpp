@@ -2,6 +2,7 @@
 
 #include <ostream>
 
+#include <userver/logging/impl/log_record.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/log.hpp>
@@ -148,6 +149,34 @@ void LogPrependedTags(benchmark::State& state) {
 }
 BENCHMARK(LogPrependedTags);
 
+class FormatLogger final : public logging::impl::LoggerBase {
+public:
+    explicit FormatLogger(logging::Format format) noexcept : LoggerBase(format) { SetLevel(logging::Level::kInfo); }
+    void Log(logging::Level, std::string_view) override {}
+    void LogStructured(const logging::impl::LogRecord&) override {}
+    void Flush() override {}
+};
+
+void LogWithTagsInFormat(benchmark::State& state) {
+    const auto format = static_cast<logging::Format>(state.range(0));
+    const logging::DefaultLoggerGuard guard{std::make_shared<FormatLogger>(format)};
+    const logging::LogExtra extra{
+        {"string", "some\tvalue"},
+        {"int", 42},
+        {"double", 0.5},
+        {"trace_id", "0123456789abcdef0123456789abcdef"},
+    };
+
+    for ([[maybe_unused]] auto _ : state) {
+        LOG_INFO() << "Some text to log" << extra;
+    }
+}
+BENCHMARK(LogWithTagsInFormat)
+    ->Arg(static_cast<int>(logging::Format::kTskv))
+    ->Arg(static_cast<int>(logging::Format::kLtsv))
+    ->Arg(static_cast<int>(logging::Format::kJson))
+    ->Arg(static_cast<int>(logging::Format::kStructured));
+
 }  // namespace
 
 USERVER_NAMESPACE_END
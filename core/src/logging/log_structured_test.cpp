@@ -0,0 +1,136 @@
+#include <chrono>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/logging/impl/log_record.hpp>
+#include <userver/logging/impl/logger_base.hpp>
+#include <userver/logging/impl/tag_writer.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/logging/logger.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utest/default_logger_fixture.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+struct StoredRecord final {
+    logging::Level level{};
+    std::chrono::system_clock::time_point timestamp;
+    std::string text;
+    std::map<std::string, std::pair<std::string, logging::impl::TagType>> tags;
+    bool is_trace{false};
+};
+
+class RecordingLogger final : public logging::impl::LoggerBase {
+public:
+    RecordingLogger() noexcept : LoggerBase(logging::Format::kStructured) { SetLevel(logging::Level::kInfo); }
+
+    void Log(logging::Level, std::string_view msg) override { ADD_FAILURE() << "Unexpected text record: " << msg; }
+
+    void LogStructured(const logging::impl::LogRecord& record) override { Store(record, false); }
+
+    void TraceStructured(const logging::impl::LogRecord& record) override { Store(record, true); }
+
+    void PrependCommonTags(logging::impl::TagWriter writer) const override {
+        logging::impl::default_::PrependCommonTags(writer);
+    }
+
+    const std::vector<StoredRecord>& GetRecords() const { return records_; }
+
+private:
+    void Store(const logging::impl::LogRecord& record, bool is_trace) {
+        StoredRecord stored;
+        stored.level = record.level;
+        stored.timestamp = record.timestamp;
+        stored.text = record.text;
+        for (const auto& tag : record.tags) {
+            EXPECT_TRUE(stored.tags.emplace(tag.key, std::pair{std::string{tag.value}, tag.type}).second) << tag.key;
+        }
+        stored.is_trace = is_trace;
+        records_.push_back(std::move(stored));
+    }
+
+    std::vector<StoredRecord> records_;
+};
+
+class LoggingStructuredTest : public utest::DefaultLoggerFixture<::testing::Test> {
+protected:
+    LoggingStructuredTest() { SetDefaultLogger(logger_); }
+
+    const std::vector<StoredRecord>& GetRecords() const { return logger_->GetRecords(); }
+
+private:
+    std::shared_ptr<RecordingLogger> logger_ = std::make_shared<RecordingLogger>();
+};
+
+}  // namespace
+
+TEST_F(LoggingStructuredTest, Basic) {
+    const auto before = std::chrono::system_clock::now();
+    LOG_WARNING() << "text\twith \"special\" characters\n";
+    const auto after = std::chrono::system_clock::now();
+
+    ASSERT_EQ(GetRecords().size(), 1);
+    const auto& record = GetRecords()[0];
+    // Neither escaped nor quoted
+    EXPECT_EQ(record.text, "text\twith \"special\" characters\n");
+    EXPECT_EQ(record.level, logging::Level::kWarning);
+    EXPECT_LE(before, record.timestamp);
+    EXPECT_LE(record.timestamp, after);
+    EXPECT_FALSE(record.is_trace);
+    EXPECT_EQ(record.tags.count("module"), 1);
+    EXPECT_EQ(record.tags.count("text"), 0);
+    EXPECT_EQ(record.tags.count("timestamp"), 0);
+    EXPECT_EQ(record.tags.count("level"), 0);
+}
+
+TEST_F(LoggingStructuredTest, TypedTags) {
+    LOG_INFO() << "typed"
+               << logging::LogExtra{
+                      {"int", -42},
+                      {"unsigned", 42U},
+                      {"double", 0.5},
+                      {"string", "str\tvalue"},
+                      {"key.with\tescaping", "value"},
+                  };
+
+    ASSERT_EQ(GetRecords().size(), 1);
+    const auto& tags = GetRecords()[0].tags;
+    using logging::impl::TagType;
+    EXPECT_EQ(tags.at("int"), std::pair(std::string{"-42"}, TagType::kInteger));
+    EXPECT_EQ(tags.at("unsigned"), std::pair(std::string{"42"}, TagType::kInteger));
+    EXPECT_EQ(tags.at("double"), std::pair(std::string{"0.5"}, TagType::kFloat));
+    EXPECT_EQ(tags.at("string"), std::pair(std::string{"str\tvalue"}, TagType::kString));
+    EXPECT_EQ(tags.at("key.with\tescaping"), std::pair(std::string{"value"}, TagType::kString));
+}
+
+UTEST_F(LoggingStructuredTest, Span) {
+    {
+        tracing::Span span("structured_span");
+        span.AddTag("custom", 42);
+        LOG_INFO() << "inside";
+    }
+
+    ASSERT_EQ(GetRecords().size(), 2);
+    const auto& log = GetRecords()[0];
+    EXPECT_EQ(log.text, "inside");
+    EXPECT_FALSE(log.is_trace);
+    EXPECT_EQ(log.tags.count("trace_id"), 1);
+    EXPECT_EQ(log.tags.count("span_id"), 1);
+
+    const auto& trace = GetRecords()[1];
+    EXPECT_TRUE(trace.is_trace);
+    EXPECT_EQ(trace.tags.at("stopwatch_name").first, "structured_span");
+    EXPECT_EQ(trace.tags.at("custom"), std::pair(std::string{"42"}, logging::impl::TagType::kInteger));
+    EXPECT_EQ(trace.tags.at("trace_id").first, log.tags.at("trace_id").first);
+    EXPECT_EQ(trace.tags.count("total_time"), 1);
+    EXPECT_EQ(trace.tags.count("start_timestamp"), 1);
+}
+
+USERVER_NAMESPACE_END
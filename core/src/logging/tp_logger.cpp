@@ -1,9 +1,18 @@
 #include "tp_logger.hpp"
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <thread>
+#include <utility>
+
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
+#include <userver/compiler/thread_local.hpp>
+#include <userver/concurrent/impl/asymmetric_fence.hpp>
 #include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/logging/logger.hpp>
@@ -15,10 +24,65 @@ USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+struct LogWorkerBuffer final {
+    explicit LogWorkerBuffer(std::size_t size) : buffer(size) {}
+
+    LogRingBuffer buffer;
+    const std::thread::id owner{std::this_thread::get_id()};
+    // Written by the owner only, tells the consumer that the owner may have
+    // missed the stop of the logger
+    std::atomic<bool> is_pushing{false};
+    LogWorkerBuffer* next{nullptr};
+};
+
+namespace {
+
+// Matches the number of records WriteVectored passes to a single writev(2)
+constexpr std::size_t kMaxBatchSize = 256;
+
+constexpr std::size_t kProducerWaitYields = 16;
+constexpr std::chrono::microseconds kProducerWaitSleep{50};
+
+// A producer is in the middle of a push only while copying the payload, so it
+// is waited for by yielding first. If it is preempted in the middle, spinning
+// could take the whole time slice, so the consumer sleeps instead.
+void WaitForBufferProducer(std::size_t attempt) noexcept {
+    if (attempt < kProducerWaitYields) {
+        std::this_thread::yield();
+    } else if (engine::current_task::IsTaskProcessorThread()) {
+        engine::SleepFor(kProducerWaitSleep);
+    } else {
+        std::this_thread::sleep_for(kProducerWaitSleep);
+    }
+}
+
+std::uint64_t GetBufferTime() noexcept { return std::chrono::steady_clock::now().time_since_epoch().count(); }
+
+std::atomic<std::uint64_t> next_logger_id{1};
+
+// The worker buffers of the recently used loggers of the current thread
+struct WorkerBufferCache final {
+    static constexpr std::size_t kSize = 8;
+
+    std::array<std::uint64_t, kSize> logger_ids{};
+    std::array<LogWorkerBuffer*, kSize> buffers{};
+    std::size_t next_replaced{0};
+};
+
+compiler::ThreadLocal local_worker_buffers = [] { return WorkerBufferCache{}; };
+
+}  // namespace
+
 struct TpLogger::ActionVisitor final {
     TpLogger& logger;
 
     void operator()(impl::async::Log&& log) const {
+        if (log.is_spilled) {
+            // The consumer writes the worker buffers only after this record, so
+            // the producers may use them again once all the spilled ones are here
+            auto& consumed_spilled = *logger.consumed_spilled_;
+            consumed_spilled.store(consumed_spilled.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        }
         logger.AccountLogConsumed();
         logger.BackendLog(std::move(log));
     }
@@ -45,19 +109,30 @@ struct TpLogger::ActionVisitor final {
     }
 };
 
-TpLogger::TpLogger(Format format, std::string logger_name) : LoggerBase(format), logger_name_(std::move(logger_name)) {
+TpLogger::TpLogger(Format format, std::string logger_name)
+    : LoggerBase(format), logger_name_(std::move(logger_name)), id_(next_logger_id.fetch_add(1)) {
     SetLevel(logging::Level::kInfo);
 }
 
 void TpLogger::StartConsumerTask(
     engine::TaskProcessor& task_processor,
     std::size_t max_queue_size,
-    QueueOverflowBehavior overflow_policy
+    QueueOverflowBehavior overflow_policy,
+    std::size_t buffer_size
 ) {
     UINVARIANT(max_queue_size != 0 && max_queue_size <= (std::size_t{1} << 31), "Invalid max queue size");
     max_queue_size_.store(max_queue_size);
     overflow_policy_.store(overflow_policy);
 
+    if (buffer_size != 0) {
+        UINVARIANT(
+            buffer_size >= 64 && buffer_size <= (std::size_t{1} << 31) && (buffer_size & (buffer_size - 1)) == 0,
+            "Log buffer size must be a power of 2"
+        );
+        buffer_batch_.reserve(kMaxBatchSize);
+        buffer_size_.store(buffer_size);
+    }
+
     auto expected = State::kSync;
     const bool success = state_.compare_exchange_strong(expected, State::kAsync);
     UINVARIANT(success, "Logger can only be switched to async mode once");
@@ -85,6 +160,11 @@ TpLogger::~TpLogger() {
         "We may be in non coroutine context, async logger must be in "
         "sync mode and consuming task must be stopped"
     );
+
+    auto* worker_buffer = worker_buffers_.load();
+    while (worker_buffer) {
+        delete std::exchange(worker_buffer, worker_buffer->next);
+    }
 }
 
 void TpLogger::StopConsumerTask() {
@@ -132,17 +212,29 @@ void TpLogger::Log(Level level, std::string_view msg) {
         return;
     }
 
+    if (TryPushToBuffer(level, msg)) {
+        NotifyBufferConsumer();
+        return;
+    }
+
+    // The buffer is full or disabled, fall back to the queue, where the
+    // overflow policy applies
     if (TryWaitFreeQueueCapacity()) {
         // The queue might have concurrently become full, in which case the size
         // will temporarily go over the max size. The actual number of log actions
         // in queue_ will not typically go over max_size + n_threads.
         produced_->fetch_add(1);
+        const bool is_spilled = buffer_size_.load(std::memory_order_relaxed) != 0;
+        if (is_spilled) spilled_->fetch_add(1, std::memory_order_relaxed);
 
         try {
-            Push(impl::async::Log{level, std::string{msg}});
+            impl::async::Log log{level, std::string{msg}};
+            log.is_spilled = is_spilled;
+            Push(std::move(log));
         } catch (const std::exception&) {
             // failed to construct a Log action or a node in Push
             produced_->fetch_sub(1);
+            if (is_spilled) spilled_->fetch_sub(1, std::memory_order_relaxed);
             throw;
         }
     } else {
@@ -187,13 +279,28 @@ void TpLogger::ProcessingLoop() {
             UASSERT(state_ == State::kStoppingAsync);
             break;
         }
+        if (ConsumeBuffers(/*is_final=*/false)) continue;
+
+        if (buffer_wakeup_popped_) {
+            // The producers do not push the wakeup node while we are busy. Pairs
+            // with the light fence in NotifyBufferConsumer: either we see their
+            // records on the next iteration, or they see the reset flag.
+            buffer_wakeup_popped_ = false;
+            buffer_wakeup_pending_->store(false);
+            concurrent::impl::AsymmetricThreadFenceHeavy();
+            continue;
+        }
         queue_.WaitWhileEmpty(queue_consumer_);
     }
 
+    WaitForBufferProducers();
+    ConsumeBuffers(/*is_final=*/true);
     CleanUpQueue(std::move(queue_consumer_));
 }
 
 void TpLogger::BackendPerform(impl::async::Action&& action) noexcept {
+    // Keep the order with the records logged through the buffers before
+    ConsumeBuffers(/*is_final=*/false);
     try {
         std::visit(ActionVisitor{*this}, std::move(action));
     } catch (const std::exception& e) {
@@ -235,6 +342,125 @@ void TpLogger::DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept {
     }
 }
 
+LogWorkerBuffer* TpLogger::GetWorkerBuffer() {
+    {
+        auto cache = local_worker_buffers.Use();
+        for (std::size_t i = 0; i < WorkerBufferCache::kSize; ++i) {
+            if (cache->logger_ids[i] == id_) return cache->buffers[i];
+        }
+    }
+
+    const auto owner = std::this_thread::get_id();
+    auto* worker_buffer = worker_buffers_.load(std::memory_order_acquire);
+    while (worker_buffer && worker_buffer->owner != owner) {
+        worker_buffer = worker_buffer->next;
+    }
+    if (!worker_buffer) {
+        // Only the owner adds its buffer, so there are no duplicates
+        auto new_buffer = std::make_unique<LogWorkerBuffer>(buffer_size_.load(std::memory_order_relaxed));
+        new_buffer->next = worker_buffers_.load(std::memory_order_relaxed);
+        while (!worker_buffers_.compare_exchange_weak(
+            new_buffer->next, new_buffer.get(), std::memory_order_release, std::memory_order_relaxed
+        )) {
+        }
+        worker_buffer = new_buffer.release();
+    }
+
+    auto cache = local_worker_buffers.Use();
+    cache->logger_ids[cache->next_replaced] = id_;
+    cache->buffers[cache->next_replaced] = worker_buffer;
+    cache->next_replaced = (cache->next_replaced + 1) % WorkerBufferCache::kSize;
+    return worker_buffer;
+}
+
+bool TpLogger::TryPushToBuffer(Level level, std::string_view msg) {
+    // Other threads have no buffers, and may not use the asymmetric fences
+    if (buffer_size_.load(std::memory_order_relaxed) == 0 || !engine::current_task::IsTaskProcessorThread()) {
+        return false;
+    }
+    // While the spilled records are in the queue, the later ones follow them
+    // there, so that the records of a thread are written in order
+    if (spilled_->load(std::memory_order_relaxed) != consumed_spilled_->load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    auto* const worker_buffer = GetWorkerBuffer();
+    worker_buffer->is_pushing.store(true, std::memory_order_relaxed);
+    // Pairs with WaitForBufferProducers: either the consumer waits for us
+    // before the final ConsumeBuffers, or we see the stopping state
+    concurrent::impl::AsymmetricThreadFenceLight();
+    const bool pushed =
+        state_.load(std::memory_order_relaxed) == State::kAsync &&
+        worker_buffer->buffer.TryPush(level, msg, GetBufferTime());
+    worker_buffer->is_pushing.store(false, std::memory_order_release);
+    return pushed;
+}
+
+void TpLogger::NotifyBufferConsumer() noexcept {
+    // Pairs with the heavy fence in ProcessingLoop: either the consumer sees
+    // the published record, or we see the reset flag and push the wakeup node
+    concurrent::impl::AsymmetricThreadFenceLight();
+    if (buffer_wakeup_pending_->load(std::memory_order_relaxed)) return;
+    if (!buffer_wakeup_pending_->exchange(true)) {
+        DoPush(buffer_wakeup_node_);
+    }
+}
+
+bool TpLogger::ConsumeBuffers(bool is_final) noexcept {
+    auto* const worker_buffers = worker_buffers_.load(std::memory_order_acquire);
+    if (!worker_buffers) return false;
+
+    // A coroutine that has moved to another thread may push a record before
+    // its earlier one becomes visible to us. So the records are merged by the
+    // push time, and only the ones pushed before the start are taken.
+    const auto deadline = is_final ? std::numeric_limits<std::uint64_t>::max() : GetBufferTime();
+    bool has_records = false;
+
+    buffer_cursors_.clear();
+    for (auto* worker_buffer = worker_buffers; worker_buffer; worker_buffer = worker_buffer->next) {
+        LogRingBuffer::Record front;
+        if (!worker_buffer->buffer.Front(front)) continue;
+        has_records = true;
+        if (front.time < deadline) buffer_cursors_.push_back(BufferCursor{worker_buffer, front});
+    }
+
+    while (!buffer_cursors_.empty()) {
+        buffer_batch_.clear();
+        while (!buffer_cursors_.empty() && buffer_batch_.size() < kMaxBatchSize) {
+            const auto oldest = std::min_element(
+                buffer_cursors_.begin(),
+                buffer_cursors_.end(),
+                [](const BufferCursor& lhs, const BufferCursor& rhs) { return lhs.front.time < rhs.front.time; }
+            );
+            buffer_batch_.push_back(LogMessage{oldest->front.payload, oldest->front.level});
+
+            auto& buffer = oldest->buffer->buffer;
+            buffer.Pop();
+            if (!buffer.Front(oldest->front) || oldest->front.time >= deadline) {
+                *oldest = buffer_cursors_.back();
+                buffer_cursors_.pop_back();
+            }
+        }
+
+        BackendLogBatch(buffer_batch_);
+        for (auto* worker_buffer = worker_buffers; worker_buffer; worker_buffer = worker_buffer->next) {
+            worker_buffer->buffer.Release();
+        }
+    }
+    return has_records;
+}
+
+void TpLogger::WaitForBufferProducers() noexcept {
+    // The producers that have seen kAsync may still be pushing their records
+    concurrent::impl::AsymmetricThreadFenceHeavy();
+    for (auto* worker_buffer = worker_buffers_.load(std::memory_order_acquire); worker_buffer;
+         worker_buffer = worker_buffer->next) {
+        for (std::size_t attempt = 0; worker_buffer->is_pushing.load(std::memory_order_acquire); ++attempt) {
+            WaitForBufferProducer(attempt);
+        }
+    }
+}
+
 void TpLogger::AccountLogConsumed() noexcept {
     consumed_->store(consumed_->load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
     if (overflow_policy_.load() == QueueOverflowBehavior::kBlock) {
@@ -254,6 +480,11 @@ void TpLogger::ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcep
     // NOLINTNEXTLINE(cppcoreguidelines-pro-type-static-cast-downcast)
     auto& action_node = static_cast<impl::async::ActionNode&>(node);
     if (&action_node == &stop_node_) return;
+    if (&action_node == &buffer_wakeup_node_) {
+        // The flag is reset once the buffers run out of records, see ProcessingLoop
+        buffer_wakeup_popped_ = true;
+        return;
+    }
 
     BackendPerform(std::move(action_node.action));
     delete &action_node;
@@ -287,6 +518,22 @@ void TpLogger::BackendLog(impl::async::Log&& action) const {
     }
 }
 
+void TpLogger::BackendLogBatch(utils::span<const LogMessage> messages) const {
+    for (const auto& sink : GetSinks()) {
+        try {
+            sink->LogBatch(messages);
+        } catch (const std::exception& e) {
+            UASSERT_MSG(false, "While writing log messages caught an exception: " + std::string(e.what()));
+        }
+    }
+
+    if (std::any_of(messages.begin(), messages.end(), [this](const LogMessage& message) {
+            return ShouldFlush(message.level);
+        })) {
+        BackendFlush();
+    }
+}
+
 void TpLogger::BackendFlush() const {
     for (const auto& sink : GetSinks()) {
         try {
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 #include <future>
 #include <limits>
 #include <memory>
@@ -19,6 +20,7 @@
 #include <engine/impl/async_flat_combining_queue.hpp>
 #include <logging/config.hpp>
 #include <logging/impl/base_sink.hpp>
+#include <logging/impl/log_ring_buffer.hpp>
 #include <logging/impl/reopen_mode.hpp>
 #include <userver/concurrent/impl/interference_shield.hpp>
 #include <userver/concurrent/impl/intrusive_hooks.hpp>
@@ -36,6 +38,9 @@ struct Log {
     Level level{};
     std::string payload{};
     std::chrono::system_clock::time_point time{std::chrono::system_clock::now()};
+    // Went to the queue while the worker buffers were enabled, the later records
+    // of the same thread follow it through the queue until it is written
+    bool is_spilled{false};
 };
 
 struct FlushCoro {
@@ -61,7 +66,17 @@ struct ActionNode final : public concurrent::impl::SinglyLinkedBaseHook {
 
 }  // namespace async
 
+// A LogRingBuffer owned by a single task processor thread, defined in the .cpp
+struct LogWorkerBuffer;
+
 /// @brief Asynchronous logger that logs into a specific TaskProcessor.
+///
+/// In async mode the records logged from the task processor threads go
+/// through the per-thread LogRingBuffer: they are copied into it without
+/// allocations or contended atomics, and the consumer task writes them to the
+/// sinks in batches, merged by the push time. The action queue is then used
+/// for the records that do not fit into the buffer, for the records of other
+/// threads, and for flushes and reopens.
 class TpLogger final : public LoggerBase {
 public:
     TpLogger(Format format, std::string logger_name);
@@ -70,7 +85,8 @@ public:
     void StartConsumerTask(
         engine::TaskProcessor& task_processor,
         std::size_t max_queue_size,
-        QueueOverflowBehavior overflow_policy
+        QueueOverflowBehavior overflow_policy,
+        std::size_t buffer_size = 0
     );
 
     void StopConsumerTask();
@@ -107,12 +123,18 @@ private:
     bool TryWaitFreeQueueCapacity();
     void Push(impl::async::Action&& action);
     void DoPush(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
+    LogWorkerBuffer* GetWorkerBuffer();
+    bool TryPushToBuffer(Level level, std::string_view msg);
+    void NotifyBufferConsumer() noexcept;
+    bool ConsumeBuffers(bool is_final) noexcept;
+    void WaitForBufferProducers() noexcept;
     void ConsumeNode(concurrent::impl::SinglyLinkedBaseHook& node) noexcept;
     void ConsumeQueueOnce(Queue::Consumer& consumer) noexcept;
     void CleanUpQueue(Queue::Consumer&& consumer) noexcept;
     void AccountLogConsumed() noexcept;
     void BackendPerform(impl::async::Action&& action) noexcept;
     void BackendLog(impl::async::Log&& action) const;
+    void BackendLogBatch(utils::span<const LogMessage> messages) const;
     void BackendFlush() const;
     void BackendReopen(ReopenMode reopen_mode) const;
 
@@ -131,6 +153,30 @@ private:
     // A dummy action used for notifying the async task during stopping.
     impl::async::ActionNode stop_node_;
 
+    struct BufferCursor final {
+        LogWorkerBuffer* buffer;
+        LogRingBuffer::Record front;
+    };
+
+    // Identifies the logger in the thread-local cache of the worker buffers
+    const std::uint64_t id_;
+    // Set once before switching to kAsync, 0 disables the worker buffers
+    std::atomic<std::size_t> buffer_size_{0};
+    // An intrusive list, only grows until the logger is destroyed
+    std::atomic<LogWorkerBuffer*> worker_buffers_{nullptr};
+    // Consumer-only, reused between the batches
+    std::vector<LogMessage> buffer_batch_;
+    std::vector<BufferCursor> buffer_cursors_;
+    bool buffer_wakeup_popped_{false};
+    // A dummy action used for notifying the consumer about the records in the
+    // worker buffers. It is in the queue at most once, while the flag is set.
+    impl::async::ActionNode buffer_wakeup_node_;
+    concurrent::impl::InterferenceShield<std::atomic<bool>> buffer_wakeup_pending_{false};
+    // The spilled records that were pushed into the queue and written by the
+    // consumer, only change while the buffers overflow
+    concurrent::impl::InterferenceShield<std::atomic<std::uint64_t>> spilled_{0};
+    concurrent::impl::InterferenceShield<std::atomic<std::uint64_t>> consumed_spilled_{0};
+
     Queue queue_;
     concurrent::impl::InterferenceShield<std::atomic<QueueSize>> produced_{0};
     concurrent::impl::InterferenceShield<std::atomic<QueueSize>> consumed_{0};
@@ -8,6 +8,7 @@
 #include <userver/logging/logger.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/fast_scope_guard.hpp>
+#include <utils/gbench_allocated_bytes.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -31,9 +32,9 @@ protected:
 
     void TearDown(const benchmark::State&) override { guard_.reset(); }
 
-    auto StartAsyncLoggerScope() {
+    auto StartAsyncLoggerScope(std::size_t buffer_size = 0) {
         tp_logger_->StartConsumerTask(
-            engine::current_task::GetTaskProcessor(), 1 << 30, logging::QueueOverflowBehavior::kDiscard
+            engine::current_task::GetTaskProcessor(), 1 << 30, logging::QueueOverflowBehavior::kDiscard, buffer_size
         );
         return utils::FastScopeGuard([this]() noexcept { tp_logger_->StopConsumerTask(); });
     }
@@ -49,15 +50,35 @@ BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogString)(benchmark::State& state) {
     engine::RunStandalone(2, [&] {
         auto scope = StartAsyncLoggerScope();
         const auto msg = Launder(std::string(state.range(0), '*'));
+        // Only the allocations of the logging thread, not of the consumer task
+        const utils::GbenchAllocatedBytes allocated_bytes;
         for ([[maybe_unused]] auto _ : state) {
             LOG_INFO() << msg;
         }
+        allocated_bytes.Report(state, "allocated-bytes-per-record");
         state.SetComplexityN(state.range(0));
+        state.counters["records"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
     });
 }
 // Run benchmarks to output string of sizes of 8 bytes to 8 kilobytes
 BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogString)->RangeMultiplier(2)->Range(8, 8 << 10)->Complexity();
 
+BENCHMARK_DEFINE_F(TpLoggerBenchmark, LogStringBuffered)(benchmark::State& state) {
+    engine::RunStandalone(2, [&] {
+        auto scope = StartAsyncLoggerScope(logging::LoggerConfig::kDefaultMessageBufferSize);
+        const auto msg = Launder(std::string(state.range(0), '*'));
+        // Only the allocations of the logging thread, not of the consumer task
+        const utils::GbenchAllocatedBytes allocated_bytes;
+        for ([[maybe_unused]] auto _ : state) {
+            LOG_INFO() << msg;
+        }
+        allocated_bytes.Report(state, "allocated-bytes-per-record");
+        state.SetComplexityN(state.range(0));
+        state.counters["records"] = benchmark::Counter(state.iterations(), benchmark::Counter::kIsRate);
+    });
+}
+BENCHMARK_REGISTER_F(TpLoggerBenchmark, LogStringBuffered)->RangeMultiplier(2)->Range(8, 8 << 10)->Complexity();
+
 namespace {
 
 __attribute__((noinline)) void LogDebug() { LOG_DEBUG() << 42; }
@@ -3,6 +3,7 @@
 #include <gmock/gmock.h>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
 #include <userver/engine/task/cancel.hpp>
 #include <userver/utest/utest.hpp>
 #include <userver/utils/statistics/storage.hpp>
@@ -44,7 +45,8 @@ public:
 
     std::shared_ptr<logging::impl::TpLogger> StartAsyncLogger(
         std::size_t queue_size_max = 10,
-        QueueOverflowBehavior on_overflow = QueueOverflowBehavior::kDiscard
+        QueueOverflowBehavior on_overflow = QueueOverflowBehavior::kDiscard,
+        std::size_t buffer_size = 0
     ) {
         UASSERT_MSG(
             engine::current_task::IsTaskProcessorThread(), "Misconfigured test. Should be run in coroutine environment"
@@ -56,7 +58,7 @@ public:
             writer = logger->GetStatistics();
         });
 
-        logger->StartConsumerTask(engine::current_task::GetTaskProcessor(), queue_size_max, on_overflow);
+        logger->StartConsumerTask(engine::current_task::GetTaskProcessor(), queue_size_max, on_overflow, buffer_size);
 
         // Tracing should not break the TpLogger
         logger->SetLevel(logging::Level::kTrace);
@@ -587,6 +589,108 @@ UTEST_F(LoggingTestCoro, TpLoggerFlushMultiple) {
     EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations);
 }
 
+UTEST_F(LoggingTestCoro, TpLoggerBufferedAsync) {
+    auto logger = StartAsyncLogger(10, QueueOverflowBehavior::kDiscard, 1 << 12);
+
+    LOG_INFO_TO(logger) << "Some log";
+    LOG_INFO_TO(logger) << "Some other log";
+    logger->Flush();
+    EXPECT_THAT(GetStreamString(), testing::HasSubstr("text=Some log"));
+    EXPECT_THAT(GetStreamString(), testing::HasSubstr("text=Some other log"));
+    logger->StopConsumerTask();
+    EXPECT_EQ(GetRecordsCount(), 2);
+
+    EXPECT_EQ(GetMetric("total"), 2);
+    EXPECT_EQ(GetMetric("dropped"), 0);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerBufferedOverflow) {
+    auto logger = StartAsyncLogger(2, QueueOverflowBehavior::kDiscard, 1 << 12);
+
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        LOG_INFO_TO(logger) << i;
+    }
+    logger->StopConsumerTask();
+
+    EXPECT_GT(GetRecordsCount(), 2) << "The buffer was not used";
+    EXPECT_LT(GetRecordsCount(), kLoggingTestIterations) << "Nothing was skipped";
+    EXPECT_EQ(GetMetric("total"), 400);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerBufferedOrder) {
+    auto logger = StartAsyncLogger(10, QueueOverflowBehavior::kDiscard, 1 << 10);
+
+    // The large record does not fit into the buffer and goes through the queue
+    LOG_INFO_TO(logger) << "first";
+    LOG_INFO_TO(logger) << std::string(1000, 'x');
+    LOG_INFO_TO(logger) << "third";
+    logger->Flush();
+    LOG_INFO_TO(logger) << "fourth";
+    logger->StopConsumerTask();
+
+    const auto logs = GetStreamString();
+    const auto first = logs.find("text=first");
+    const auto second = logs.find("text=xxx");
+    const auto third = logs.find("text=third");
+    const auto fourth = logs.find("text=fourth");
+    ASSERT_NE(fourth, std::string::npos);
+    EXPECT_LT(first, second);
+    EXPECT_LT(second, third);
+    EXPECT_LT(third, fourth);
+    EXPECT_EQ(GetRecordsCount(), 4);
+}
+
+UTEST_F(LoggingTestCoro, TpLoggerBufferedOverflowOrder) {
+    // Fits a few records, the rest spill to the queue
+    auto logger = StartAsyncLogger(kLoggingTestIterations * 2, QueueOverflowBehavior::kDiscard, 1 << 10);
+
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        LOG_INFO_TO(logger) << "record " << i << ';';
+    }
+    logger->StopConsumerTask();
+
+    const auto logs = GetStreamString();
+    std::size_t position = 0;
+    for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+        const auto next = logs.find(fmt::format("text=record {};", i));
+        ASSERT_NE(next, std::string::npos) << i;
+        ASSERT_GE(next, position) << i;
+        position = next;
+    }
+    EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations);
+}
+
+UTEST_F_MT(LoggingTestCoro, TpLoggerBufferedOrderMT, 4) {
+    auto logger = StartAsyncLogger(kLoggingTestIterations * 10, QueueOverflowBehavior::kDiscard, 1 << 12);
+
+    // The coroutines move between the threads and their buffers
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (std::size_t task_index = 0; task_index < GetThreadCount(); ++task_index) {
+        tasks.push_back(engine::AsyncNoSpan([&logger, task_index] {
+            for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+                LOG_INFO_TO(logger) << i << " at " << task_index << ';';
+                engine::Yield();
+            }
+        }));
+    }
+    for (auto& task : tasks) {
+        task.Get();
+    }
+    logger->StopConsumerTask();
+
+    const auto logs = GetStreamString();
+    for (std::size_t task_index = 0; task_index < GetThreadCount(); ++task_index) {
+        std::size_t position = 0;
+        for (std::size_t i = 0; i < kLoggingTestIterations; ++i) {
+            const auto next = logs.find(fmt::format("text={} at {};", i, task_index));
+            ASSERT_NE(next, std::string::npos) << i << " at " << task_index;
+            ASSERT_GE(next, position) << i << " at " << task_index;
+            position = next;
+        }
+    }
+    EXPECT_EQ(GetRecordsCount(), kLoggingTestIterations * GetThreadCount());
+}
+
 UTEST_F_MT(LoggingTestCoro, TpLoggerLogMultipleMT, 4) {
     const std::size_t message_count = kLoggingTestIterations * (GetThreadCount() - 1);
     auto logger = StartAsyncLogger(message_count * 10, QueueOverflowBehavior::kDiscard);
@@ -634,6 +738,20 @@ UTEST_F_MT(LoggingTestCoro, TpLoggerLogMultipleFlushSyncMT, 4) {
     EXPECT_EQ(GetRecordsCount(), message_count);
 }
 
+UTEST_F_MT(LoggingTestCoro, TpLoggerLogMultipleBufferedMT, 4) {
+    const std::size_t message_count = kLoggingTestIterations * (GetThreadCount() - 1);
+    auto logger = StartAsyncLogger(message_count * 10, QueueOverflowBehavior::kDiscard, 1 << 12);
+    LogTestMT(logger, GetThreadCount(), kTestLogging);
+    EXPECT_EQ(GetRecordsCount(), message_count);
+}
+
+UTEST_F_MT(LoggingTestCoro, TpLoggerLogMultipleBufferedFlushSyncMT, 4) {
+    const std::size_t message_count = kLoggingTestIterations * GetThreadCount();
+    auto logger = StartAsyncLogger(message_count * 10, QueueOverflowBehavior::kDiscard, 1 << 12);
+    LogTestMT(logger, GetThreadCount(), kTestLogFlushSync);
+    EXPECT_EQ(GetRecordsCount(), message_count);
+}
+
 UTEST_F_MT(LoggingTestCoro, TpLoggerLogMultipleCancelMT, 4) {
     const std::size_t message_count = kLoggingTestIterations * (GetThreadCount() - 1);
     auto logger = StartAsyncLogger(message_count * 10, QueueOverflowBehavior::kDiscard);
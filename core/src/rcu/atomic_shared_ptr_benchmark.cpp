@@ -7,6 +7,7 @@
 #include <userver/engine/async.hpp>
 #include <userver/engine/run_standalone.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/rcu/rcu.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -76,4 +77,62 @@ void atomic_shared_ptr_contention(benchmark::State& state) {
 }
 BENCHMARK(atomic_shared_ptr_contention)->RangeMultiplier(2)->Ranges({{2, 32}, {false, true}});
 
+// The same scenarios for rcu::Variable, for a head-to-head comparison
+
+template <typename RcuTraits>
+void rcu_variable_read(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        rcu::Variable<int, RcuTraits> var(1);
+
+        for ([[maybe_unused]] auto _ : state) {
+            auto snapshot_ptr = var.Read();
+            benchmark::DoNotOptimize(*snapshot_ptr);
+        }
+    });
+}
+BENCHMARK_TEMPLATE(rcu_variable_read, rcu::DefaultRcuTraits);
+BENCHMARK_TEMPLATE(rcu_variable_read, rcu::EpochRcuTraits);
+
+template <typename RcuTraits>
+void rcu_variable_contention(benchmark::State& state) {
+    engine::RunStandalone(state.range(0), [&] {
+        std::atomic<bool> run{true};
+        rcu::Variable<std::unordered_map<int, int>, RcuTraits> var;
+
+        std::vector<engine::TaskWithResult<void>> tasks;
+        tasks.reserve(state.range(0) - 2);
+        for (int i = 0; i < state.range(0) - 2; i++)
+            tasks.push_back(engine::AsyncNoSpan([&]() {
+                while (run) {
+                    auto snapshot_ptr = var.Read();
+                    benchmark::DoNotOptimize(*snapshot_ptr);
+                }
+            }));
+
+        if (state.range(1))
+            tasks.push_back(engine::AsyncNoSpan([&]() {
+                size_t i = 0;
+                while (run) {
+                    auto writer = var.StartWrite();
+                    (*writer)[1] = i++;
+                    writer.Commit();
+                    engine::SleepFor(std::chrono::milliseconds{10});
+                }
+            }));
+
+        for ([[maybe_unused]] auto _ : state) {
+            auto snapshot_ptr = var.Read();
+            benchmark::DoNotOptimize(*snapshot_ptr);
+        }
+
+        run = false;
+    });
+}
+BENCHMARK_TEMPLATE(rcu_variable_contention, rcu::DefaultRcuTraits)
+    ->RangeMultiplier(2)
+    ->Ranges({{2, 32}, {false, true}});
+BENCHMARK_TEMPLATE(rcu_variable_contention, rcu::EpochRcuTraits)
+    ->RangeMultiplier(2)
+    ->Ranges({{2, 32}, {false, true}});
+
 USERVER_NAMESPACE_END
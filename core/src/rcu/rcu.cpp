@@ -1,16 +1,67 @@
 #include <userver/rcu/rcu.hpp>
 
 #include <atomic>
+#include <mutex>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace rcu::impl {
 
+namespace {
+
+struct EpochDomain final {
+    // Serializes the epoch flips and the reads of the retire epochs, so that
+    // every flip after GetRetireEpoch observes the removal of the snapshot.
+    std::mutex mutex;
+    std::atomic<std::uint64_t> epoch{0};
+    // The readers of the epoch E lock indicators[E % 2]
+    concurrent::impl::StripedReadIndicator indicators[2];
+};
+
+EpochDomain& GetEpochDomain() noexcept {
+    static EpochDomain domain;
+    return domain;
+}
+
+}  // namespace
+
 uint64_t GetNextEpoch() noexcept {
     static std::atomic<uint64_t> counter{1};  // 0 is the default value in data
     return counter++;
 }
 
+concurrent::impl::StripedReadIndicatorLock LockCurrentEpoch() noexcept {
+    auto& domain = GetEpochDomain();
+    // The epoch may be advanced right after the load. The reader is then
+    // accounted for in the previous epoch, which only delays the reclamation.
+    const auto epoch = domain.epoch.load(std::memory_order_relaxed);
+    auto lock = domain.indicators[epoch % 2].Lock();
+    concurrent::impl::AsymmetricThreadFenceLight();
+    return lock;
+}
+
+std::uint64_t GetRetireEpoch() noexcept {
+    auto& domain = GetEpochDomain();
+    const std::lock_guard lock(domain.mutex);
+    return domain.epoch.load(std::memory_order_relaxed);
+}
+
+std::uint64_t TryAdvanceEpoch(std::uint64_t target) noexcept {
+    auto& domain = GetEpochDomain();
+    const std::lock_guard lock(domain.mutex);
+    auto epoch = domain.epoch.load(std::memory_order_relaxed);
+    while (epoch < target) {
+        // The new readers use indicators[epoch % 2], the ones of the previous
+        // epoch must be gone before the indicator is reused. The fence makes
+        // sure that a reader either is visible here or loads the snapshots
+        // that have been stored before.
+        concurrent::impl::AsymmetricThreadFenceHeavy();
+        if (!domain.indicators[(epoch + 1) % 2].IsFree()) break;
+        domain.epoch.store(++epoch, std::memory_order_seq_cst);
+    }
+    return epoch;
+}
+
 }  // namespace rcu::impl
 
 USERVER_NAMESPACE_END
@@ -0,0 +1,97 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/rcu/rcu_map.hpp>
+#include <utils/impl/parallelize_benchmark.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using DefaultMap = rcu::RcuMap<std::uint64_t, std::uint64_t>;
+using PersistentMap = rcu::RcuMap<std::uint64_t, std::uint64_t, rcu::PersistentRcuMapTraits<std::uint64_t>>;
+
+constexpr std::uint64_t kPrime = 7919;
+
+template <typename Map>
+void FillMap(Map& map, std::uint64_t size) {
+    auto txn = map.StartWrite();
+    for (std::uint64_t i = 0; i < size; ++i) {
+        txn->insert_or_assign(i, std::make_shared<std::uint64_t>(i));
+    }
+    txn.Commit();
+}
+
+}  // namespace
+
+// Replaces the existing keys and adds/removes keys in a map of a stable size
+template <typename Map>
+void rcu_map_write(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        const auto size = static_cast<std::uint64_t>(state.range(0));
+        Map map;
+        FillMap(map, size);
+
+        std::uint64_t i = 0;
+        for ([[maybe_unused]] auto _ : state) {
+            const auto key = i * kPrime % size;
+            if (i % 2 == 0) {
+                map.InsertOrAssign(key, std::make_shared<std::uint64_t>(i));
+            } else {
+                map.Erase(key);
+                map.Emplace(key, i);
+            }
+            ++i;
+        }
+    });
+}
+BENCHMARK_TEMPLATE(rcu_map_write, DefaultMap)->RangeMultiplier(10)->Range(100, 100'000);
+BENCHMARK_TEMPLATE(rcu_map_write, PersistentMap)->RangeMultiplier(10)->Range(100, 100'000);
+
+template <typename Map>
+void rcu_map_read(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        const auto size = static_cast<std::uint64_t>(state.range(0));
+        Map map;
+        FillMap(map, size);
+
+        std::uint64_t i = 0;
+        for ([[maybe_unused]] auto _ : state) {
+            benchmark::DoNotOptimize(map.Get(i++ * kPrime % size));
+        }
+    });
+}
+BENCHMARK_TEMPLATE(rcu_map_read, DefaultMap)->RangeMultiplier(10)->Range(100, 100'000);
+BENCHMARK_TEMPLATE(rcu_map_read, PersistentMap)->RangeMultiplier(10)->Range(100, 100'000);
+
+// The measured thread writes, the others read the same map
+template <typename Map>
+void rcu_map_write_contention(benchmark::State& state) {
+    constexpr std::uint64_t kSize = 10'000;
+    engine::RunStandalone(state.range(0), [&] {
+        Map map;
+        FillMap(map, kSize);
+
+        RunParallelBenchmark(state, [&](auto& range) {
+            std::uint64_t i = 0;
+            if constexpr (std::is_same_v<std::decay_t<decltype(range)>, benchmark::State>) {
+                for ([[maybe_unused]] auto _ : range) {
+                    map.InsertOrAssign(i * kPrime % kSize, std::make_shared<std::uint64_t>(i));
+                    ++i;
+                }
+            } else {
+                for ([[maybe_unused]] auto _ : range) {
+                    benchmark::DoNotOptimize(map.Get(i++ * kPrime % kSize));
+                }
+            }
+        });
+    });
+}
+BENCHMARK_TEMPLATE(rcu_map_write_contention, DefaultMap)->Arg(2)->Arg(4)->Arg(6);
+BENCHMARK_TEMPLATE(rcu_map_write_contention, PersistentMap)->Arg(2)->Arg(4)->Arg(6);
+
+USERVER_NAMESPACE_END
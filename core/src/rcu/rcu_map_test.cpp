@@ -6,7 +6,9 @@
 #include <cstdint>
 #include <future>
 #include <mutex>
+#include <set>
 #include <thread>
+#include <vector>
 
 #include <userver/engine/sleep.hpp>
 #include <userver/utest/utest.hpp>
@@ -25,6 +27,9 @@ struct RcuTraitsStdMutex : rcu::DefaultRcuMapTraits<Key> {
 
 using StdMutexRcuMap = rcu::RcuMap<std::string, int, RcuTraitsStdMutex<std::string>>;
 
+template <typename Key, typename Value>
+using PersistentRcuMap = rcu::RcuMap<Key, Value, rcu::PersistentRcuMapTraits<Key>>;
+
 }  // namespace
 
 TEST(RcuMap, StdMutexBase) {
@@ -322,4 +327,90 @@ UTEST(RcuMap, StartWriteNoTearing) {
     UEXPECT_NO_THROW(checker.Get());
 }
 
+UTEST(RcuMapPersistent, Modify) {
+    PersistentRcuMap<std::string, int> map;
+    const auto& cmap = map;
+
+    UEXPECT_THROW(cmap["any"], rcu::MissingKeyException);
+    EXPECT_FALSE(map.Erase("any"));
+
+    UEXPECT_NO_THROW(*map["any"] = 1);
+    EXPECT_EQ(1, *cmap["any"]);
+    EXPECT_EQ(1, *map.Pop("any"));
+    EXPECT_FALSE(map.Get("any"));
+
+    EXPECT_TRUE(map.Insert("any", std::make_shared<int>(3)).inserted);
+    EXPECT_EQ(*map.Insert("any", std::make_shared<int>(0)).value, 3);
+    EXPECT_TRUE(map.Emplace("other", 4).inserted);
+    EXPECT_EQ(*map.Emplace("other", 0).value, 4);
+    EXPECT_TRUE(map.TryEmplace("third", 5).inserted);
+    EXPECT_EQ(*map.TryEmplace("third", 0).value, 5);
+
+    map.InsertOrAssign("any", std::make_shared<int>(6));
+    EXPECT_EQ(*cmap["any"], 6);
+    EXPECT_EQ(map.SizeApprox(), 3);
+
+    const auto snapshot = map.GetSnapshot();
+    EXPECT_EQ(snapshot.size(), 3);
+    EXPECT_EQ(*snapshot.at("other"), 4);
+
+    map.Clear();
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+UTEST(RcuMapPersistent, IterStability) {
+    PersistentRcuMap<int, int> map;
+    for (int i = 0; i < 1000; ++i) *map[i] = i;
+
+    std::set<int> seen;
+    for (const auto& [k, v] : map) {
+        // The keyset is fixed at the start of the iteration
+        map.Erase(k);
+        map.Emplace(k + 1000, 0);
+
+        ASSERT_TRUE(k >= 0 && k < 1000);
+        EXPECT_TRUE(seen.insert(k).second);
+        EXPECT_EQ(k, *v);
+    }
+    EXPECT_EQ(seen.size(), 1000);
+    EXPECT_EQ(map.SizeApprox(), 1000);
+    EXPECT_FALSE(map.Get(0));
+    EXPECT_TRUE(map.Get(1000));
+}
+
+UTEST_MT(RcuMapPersistent, ConcurrentWritesAndReads, 4) {
+    constexpr int kKeysPerWriter = 1000;
+    PersistentRcuMap<int, int> map;
+    std::atomic<bool> stop_flag{false};
+
+    auto reader = utils::Async("reader", [&] {
+        while (!stop_flag) {
+            // Writers only store the values equal to the keys
+            for (const auto& [k, v] : map) ASSERT_EQ(k, *v);
+        }
+    });
+
+    std::vector<engine::TaskWithResult<void>> writers;
+    for (int i = 0; i < 3; ++i) {
+        writers.push_back(utils::Async("writer", [i, &map] {
+            for (int round = 0; round < 3; ++round) {
+                for (int k = i * kKeysPerWriter; k < (i + 1) * kKeysPerWriter; ++k) {
+                    map.InsertOrAssign(k, std::make_shared<int>(k));
+                }
+                for (int k = i * kKeysPerWriter; k < (i + 1) * kKeysPerWriter; k += 2) {
+                    ASSERT_TRUE(map.Erase(k));
+                }
+            }
+        }));
+    }
+    for (auto& writer : writers) writer.Get();
+    stop_flag = true;
+    reader.Get();
+
+    EXPECT_EQ(map.SizeApprox(), 3 * kKeysPerWriter / 2);
+    for (int k = 0; k < 3 * kKeysPerWriter; ++k) {
+        EXPECT_EQ(static_cast<bool>(map.Get(k)), k % 2 == 1) << k;
+    }
+}
+
 USERVER_NAMESPACE_END
@@ -2,8 +2,10 @@
 
 #include <atomic>
 #include <future>
+#include <optional>
 #include <stdexcept>
 #include <thread>
+#include <vector>
 
 #include <engine/task/task_context.hpp>
 #include <userver/engine/sleep.hpp>
@@ -407,14 +409,13 @@ constexpr std::size_t kWritingTasks = 2;
 constexpr std::size_t kSleeperTask = 1;
 constexpr std::size_t kTotalTasks = kReadablePtrPingPongTasks + kReadingTasks + kWritingTasks + kSleeperTask;
 
-}  // namespace
-
-UTEST_MT(Rcu, TortureTest, kTotalTasks) {
-    rcu::Variable<CleaningUpInt> data{1};
+template <typename RcuTraits>
+void RunTortureTest() {
+    rcu::Variable<CleaningUpInt, RcuTraits> data{1};
     std::atomic<bool> keep_running{true};
 
     engine::Mutex ping_pong_mutex;
-    rcu::ReadablePtr<CleaningUpInt> ptr = data.Read();
+    rcu::ReadablePtr<CleaningUpInt, RcuTraits> ptr = data.Read();
 
     std::vector<engine::TaskWithResult<void>> tasks;
 
@@ -454,6 +455,12 @@ UTEST_MT(Rcu, TortureTest, kTotalTasks) {
     keep_running = false;
 }
 
+}  // namespace
+
+UTEST_MT(Rcu, TortureTest, kTotalTasks) { RunTortureTest<rcu::DefaultRcuTraits>(); }
+
+UTEST_MT(Rcu, EpochTortureTest, kTotalTasks) { RunTortureTest<rcu::EpochRcuTraits>(); }
+
 UTEST(Rcu, WritablePtrUnlocksInCommit) {
     rcu::Variable<int> var{1};
 
@@ -530,6 +537,85 @@ UTEST(Rcu, SyncDestruction) {
     EXPECT_TRUE(destroyed[2]);
 }
 
+namespace {
+
+struct EpochSyncRcuTraits : public rcu::EpochRcuTraits {
+    using DeleterType = rcu::SyncDeleter;
+};
+
+}  // namespace
+
+UTEST(Rcu, EpochDestruction) {
+    std::atomic<bool> destroyed[4]{false, false, false, false};
+    {
+        rcu::Variable<DestructionTracker, EpochSyncRcuTraits> var{destroyed[0]};
+
+        // Without readers the old snapshot is reclaimed right away
+        var.Emplace(destroyed[1]);
+        EXPECT_TRUE(destroyed[0]);
+        EXPECT_FALSE(destroyed[1]);
+
+        {
+            const auto reader = var.Read();
+            var.Emplace(destroyed[2]);
+            EXPECT_FALSE(destroyed[1]);
+        }
+
+        var.Emplace(destroyed[3]);
+        EXPECT_TRUE(destroyed[1]);
+        EXPECT_TRUE(destroyed[2]);
+        EXPECT_FALSE(destroyed[3]);
+    }
+
+    EXPECT_TRUE(destroyed[3]);
+}
+
+UTEST(Rcu, EpochCleanup) {
+    std::atomic<bool> destroyed[2]{false, false};
+    rcu::Variable<DestructionTracker, EpochSyncRcuTraits> var{destroyed[0]};
+
+    std::optional<rcu::ReadablePtr<DestructionTracker, EpochSyncRcuTraits>> reader = var.Read();
+    var.Emplace(destroyed[1]);
+    EXPECT_FALSE(destroyed[0]);
+
+    // The old snapshot is used by the reader
+    var.Cleanup();
+    EXPECT_FALSE(destroyed[0]);
+
+    reader.reset();
+    var.Cleanup();
+    EXPECT_TRUE(destroyed[0]);
+    EXPECT_FALSE(destroyed[1]);
+}
+
+UTEST_MT(Rcu, EpochReadersOfDifferentVariables, 4) {
+    rcu::Variable<CleaningUpInt, rcu::EpochRcuTraits> first{1};
+    rcu::Variable<CleaningUpInt, rcu::EpochRcuTraits> second{1};
+    std::atomic<bool> keep_running{true};
+
+    std::vector<engine::TaskWithResult<void>> tasks;
+    for (auto* var : {&first, &second}) {
+        tasks.push_back(engine::AsyncNoSpan([&, var] {
+            while (keep_running) {
+                const auto reader = var->Read();
+                // A reader of any variable keeps the snapshots of all of them
+                engine::Yield();
+                ASSERT_GT(reader->value, 0);
+            }
+        }));
+        tasks.push_back(engine::AsyncNoSpan([&, var] {
+            while (keep_running) {
+                const auto old = var->Read();
+                var->Assign(CleaningUpInt{old->value + 1});
+            }
+        }));
+    }
+
+    engine::SleepFor(std::chrono::milliseconds{100});
+    keep_running = false;
+    for (auto& task : tasks) task.Get();
+}
+
 UTEST_MT(Rcu, Core, 3) {
     const auto deadline = engine::Deadline::FromDuration(std::chrono::milliseconds{100});
     std::monostate non_null;
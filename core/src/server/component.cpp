@@ -193,6 +193,13 @@ properties:
                         enum:
                           - 1.1
                           - 2
+                    http1-parser:
+                        type: string
+                        description: HTTP/1.1 request parser implementation
+                        defaultDescription: llhttp
+                        enum:
+                          - llhttp
+                          - simd
                     http2-session:
                         type: object
                         description: settings of the HTTP/2.0 session
@@ -222,6 +229,14 @@ properties:
         type: boolean
         description: set to true to add the `X-YaTaxi-Server-Hostname` header with instance name, set to false to not add the header
         defaultDescription: false
+    handler-timings-us:
+        type: boolean
+        description: set to true to add the `timings-us` percentiles of the handlers in microseconds
+        defaultDescription: false
+    handler-timings-histogram:
+        type: boolean
+        description: set to true to add the `timings-histogram` histogram of the handlers in microseconds
+        defaultDescription: false
     middleware-pipeline-builder:
         type: string
         description: name of a component to build a server-wide middleware pipeline
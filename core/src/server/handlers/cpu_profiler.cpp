@@ -0,0 +1,77 @@
+#include <userver/server/handlers/cpu_profiler.hpp>
+
+#include <fmt/format.h>
+
+#include <engine/task/cpu_profiler.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/yaml_config/schema.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::handlers {
+
+namespace {
+
+constexpr std::chrono::microseconds kDefaultInterval{10'000};
+
+std::string FormatProfilerStatistics(const engine::impl::CpuProfilerStatistics& stats) {
+    return fmt::format(
+        "active: {}\ninterval-us: {}\nsamples: {}\ndropped-samples: {}\nstacks: {}\n",
+        stats.is_active,
+        stats.interval.count(),
+        stats.samples,
+        stats.dropped_samples,
+        stats.stacks
+    );
+}
+
+}  // namespace
+
+CpuProfiler::CpuProfiler(const components::ComponentConfig& config, const components::ComponentContext& context)
+    : HttpHandlerBase(config, context, /*is_monitor = */ true) {}
+
+std::string CpuProfiler::HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const {
+    auto& profiler = engine::impl::GetCpuProfiler();
+
+    const auto& command = request.GetPathArg("command");
+    if (command == "start") {
+        auto interval = kDefaultInterval;
+        if (request.HasArg("interval-us")) {
+            try {
+                interval = std::chrono::microseconds{utils::FromString<std::uint64_t>(request.GetArg("interval-us"))};
+            } catch (const std::exception& ex) {
+                request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+                return std::string{"invalid 'interval-us' value: "} + ex.what();
+            }
+            if (interval.count() == 0) {
+                request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+                return "'interval-us' must be positive";
+            }
+        }
+        profiler.Start(interval);
+        return "OK\n";
+    } else if (command == "stop") {
+        profiler.Stop();
+        return "OK\n";
+    } else if (command == "reset") {
+        profiler.Reset();
+        return "OK\n";
+    } else if (command == "stat") {
+        return FormatProfilerStatistics(profiler.GetStatistics());
+    } else if (command == "collapsed") {
+        return profiler.GetCollapsedStacks();
+    } else {
+        request.SetResponseStatus(server::http::HttpStatus::kBadRequest);
+        return "Unsupported command";
+    }
+}
+
+yaml_config::Schema CpuProfiler::GetStaticConfigSchema() {
+    auto schema = HttpHandlerBase::GetStaticConfigSchema();
+    schema.UpdateDescription("handler-cpu-profiler config");
+    return schema;
+}
+
+}  // namespace server::handlers
+
+USERVER_NAMESPACE_END
@@ -4,6 +4,8 @@
 #include <boost/algorithm/string/split.hpp>
 #include <boost/container/small_vector.hpp>
 
+#include <engine/task/cpu_profiler.hpp>
+#include <engine/task/task_context.hpp>
 #include <server/handlers/http_handler_base_statistics.hpp>
 #include <server/middlewares/handler_adapter.hpp>
 #include <server/request/internal_request_context.hpp>
@@ -143,6 +145,7 @@ HttpHandlerBase::HttpHandlerBase(
       config_source_(context.FindComponent<components::DynamicConfig>().GetSource()),
       allowed_methods_(InitAllowedMethods(GetConfig())),
       handler_name_(config.Name()),
+      cpu_profiler_tag_(engine::impl::MakeCpuProfilerTag(handler_name_)),
       log_level_(config["log-level"].As<std::optional<logging::Level>>()),
       log_level_for_status_codes_(ParseStatusCodesLogLevel(
           config["status-codes-log-level"].As<std::unordered_map<std::string, std::string>>({})
@@ -182,10 +185,12 @@ HttpHandlerBase::HttpHandlerBase(
     auto& statistics_storage = context.FindComponent<components::StatisticsStorage>().GetStorage();
     statistics_holder_ = statistics_storage.RegisterWriter(
         std::move(prefix),
-        [this](utils::statistics::Writer& result) {
-            FormatStatistics(result["handler"], *handler_statistics_);
+        [this, timings_metrics = server_component.GetServer().GetConfig().handler_timings_metrics](
+            utils::statistics::Writer& result
+        ) {
+            FormatStatistics(result["handler"], *handler_statistics_, timings_metrics);
             if constexpr (kIncludeServerHttpMetrics) {
-                FormatStatistics(result["request"], *request_statistics_);
+                FormatStatistics(result["request"], *request_statistics_, timings_metrics);
             }
         },
         std::move(labels)
@@ -254,7 +259,11 @@ void HttpHandlerBase::HandleHttpRequest(http::HttpRequest& http_request, request
         HandleRequestStream(http_request, context);
     } else {
         // !IsBodyStreamed()
-        response.SetData(HandleRequestThrow(http_request, context));
+        auto data = HandleRequestThrow(http_request, context);
+        // An empty result keeps the body the handler has shared
+        if (!data.empty() || !response.HasSharedData()) {
+            response.SetData(std::move(data));
+        }
     }
 }
 
@@ -262,6 +271,7 @@ void HttpHandlerBase::HandleRequest(http::HttpRequest& http_request, request::Re
     auto& response = http_request.GetHttpResponse();
 
     context.GetInternalContext().SetConfigSnapshot(config_source_.GetSnapshot());
+    engine::current_task::GetCurrentTaskContext().SetCpuProfilerTag(cpu_profiler_tag_);
     try {
         UASSERT(first_middleware_);
         first_middleware_->HandleRequest(http_request, context);
@@ -431,19 +441,25 @@ void HttpHandlerBase::LogUnknownException(const std::exception& ex, std::optiona
 const std::optional<logging::Level>& HttpHandlerBase::GetLogLevel() const { return log_level_; }
 
 template <typename HttpStatistics>
-void HttpHandlerBase::FormatStatistics(utils::statistics::Writer result, const HttpStatistics& stats) {
+void HttpHandlerBase::FormatStatistics(
+    utils::statistics::Writer result,
+    const HttpStatistics& stats,
+    utils::statistics::TimingsMetrics timings_metrics
+) {
     using Snapshot = typename HttpStatistics::Snapshot;
     Snapshot total;
 
     for (const auto method : GetAllowedMethods()) {
         const Snapshot by_method{stats.GetByMethod(method)};
         if (IsMethodStatisticIncluded()) {
-            result.ValueWithLabels(by_method, {"http_method", ToString(method)});
+            result.ValueWithLabels(
+                HttpHandlerStatisticsView{by_method, timings_metrics}, {"http_method", ToString(method)}
+            );
         }
         total.Add(by_method);
     }
 
-    result = total;
+    result = HttpHandlerStatisticsView{total, timings_metrics};
 }
 
 void HttpHandlerBase::SetResponseServerHostname(http::HttpResponse& response) const {
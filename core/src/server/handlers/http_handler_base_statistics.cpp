@@ -12,6 +12,7 @@ namespace {
 
 struct HttpHandlerStatisticsHelper {
     const HttpHandlerStatisticsSnapshot& snapshot;
+    utils::statistics::TimingsMetrics timings_metrics;
 };
 
 void DumpMetric(utils::statistics::Writer& writer, HttpHandlerStatisticsHelper helper) {
@@ -23,7 +24,10 @@ void DumpMetric(utils::statistics::Writer& writer, HttpHandlerStatisticsHelper h
     writer["rate-limit-reached"] = stats.rate_limit_reached;
     writer["deadline-received"] = stats.deadline_received;
     writer["cancelled-by-deadline"] = stats.cancelled_by_deadline;
-    writer["timings"] = stats.timings;
+    utils::statistics::DumpTimings(writer, stats.timings, helper.timings_metrics);
+    writer["cpu-time-us"] = stats.cpu_time_us;
+    writer["allocated-bytes"] = stats.allocated_bytes;
+    writer["deallocated-bytes"] = stats.deallocated_bytes;
 }
 
 }  // namespace
@@ -33,6 +37,11 @@ void HttpHandlerMethodStatistics::Account(const HttpHandlerStatisticsEntry& stat
     timings_.GetCurrentCounter().Account(stats.timing.count());
     if (stats.deadline.IsReachable()) ++deadline_received_;
     if (stats.cancelled_by_deadline) ++cancelled_by_deadline_;
+
+    const auto cpu_time_us = std::chrono::duration_cast<std::chrono::microseconds>(stats.resource_usage.cpu_time);
+    cpu_time_us_.Add(utils::statistics::Rate{static_cast<std::uint64_t>(cpu_time_us.count())});
+    allocated_bytes_.Add(utils::statistics::Rate{stats.resource_usage.allocated_bytes});
+    deallocated_bytes_.Add(utils::statistics::Rate{stats.resource_usage.deallocated_bytes});
 }
 
 std::size_t HttpHandlerMethodStatistics::GetInFlight() const noexcept {
@@ -53,7 +62,10 @@ HttpHandlerStatisticsSnapshot::HttpHandlerStatisticsSnapshot(const HttpHandlerMe
       too_many_requests_in_flight(stats.too_many_requests_in_flight_.Load()),
       rate_limit_reached(stats.rate_limit_reached_.Load()),
       deadline_received(stats.deadline_received_.Load()),
-      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()) {}
+      cancelled_by_deadline(stats.cancelled_by_deadline_.Load()),
+      cpu_time_us(stats.cpu_time_us_.Load()),
+      allocated_bytes(stats.allocated_bytes_.Load()),
+      deallocated_bytes(stats.deallocated_bytes_.Load()) {}
 
 void HttpHandlerStatisticsSnapshot::Add(const HttpHandlerStatisticsSnapshot& other) {
     timings.Add(other.timings);
@@ -64,10 +76,17 @@ void HttpHandlerStatisticsSnapshot::Add(const HttpHandlerStatisticsSnapshot& oth
     rate_limit_reached += other.rate_limit_reached;
     deadline_received += other.deadline_received;
     cancelled_by_deadline += other.cancelled_by_deadline;
+    cpu_time_us += other.cpu_time_us;
+    allocated_bytes += other.allocated_bytes;
+    deallocated_bytes += other.deallocated_bytes;
 }
 
 void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerStatisticsSnapshot& stats) {
-    writer.ValueWithLabels(HttpHandlerStatisticsHelper{stats}, {"version", "2"});
+    writer = HttpHandlerStatisticsView{stats, {}};
+}
+
+void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerStatisticsView& view) {
+    writer.ValueWithLabels(HttpHandlerStatisticsHelper{view.snapshot, view.timings_metrics}, {"version", "2"});
 }
 
 void HttpRequestMethodStatistics::Account(const HttpRequestStatisticsEntry& stats) noexcept {
@@ -88,7 +107,11 @@ HttpHandlerStatisticsScope::HttpHandlerStatisticsScope(
     http::HttpMethod method,
     server::http::HttpResponse& response
 )
-    : stats_(stats), method_(method), start_time_(std::chrono::steady_clock::now()), response_(response) {
+    : stats_(stats),
+      method_(method),
+      start_time_(std::chrono::steady_clock::now()),
+      start_resource_usage_(engine::current_task::GetResourceUsage()),
+      response_(response) {
     stats_.ForMethod(method).IncrementInFlight();
 }
 
@@ -98,9 +121,10 @@ HttpHandlerStatisticsScope::~HttpHandlerStatisticsScope() {
 
     HttpHandlerStatisticsEntry stats;
     stats.code = response_.GetStatus();
-    stats.timing = std::chrono::duration_cast<std::chrono::milliseconds>(finish_time - start_time_);
+    stats.timing = std::chrono::duration_cast<std::chrono::microseconds>(finish_time - start_time_);
     stats.deadline = data ? data->deadline : engine::Deadline{};
     stats.cancelled_by_deadline = cancelled_by_deadline_;
+    stats.resource_usage = engine::current_task::GetResourceUsage() - start_resource_usage_;
     stats_.ForMethod(method_).Account(stats);
     stats_.ForMethod(method_).DecrementInFlight();
 }
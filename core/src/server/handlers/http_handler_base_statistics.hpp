@@ -7,9 +7,10 @@
 
 #include <server/http/handler_methods.hpp>
 #include <userver/engine/deadline.hpp>
+#include <userver/engine/task/resource_usage.hpp>
 #include <userver/server/handlers/http_handler_base.hpp>
 #include <userver/server/http/http_status.hpp>
-#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/log_linear_histogram.hpp>
 #include <userver/utils/statistics/rate.hpp>
 #include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
@@ -22,9 +23,11 @@ namespace server::handlers {
 // Statistics for a single request from the handler perspective.
 struct HttpHandlerStatisticsEntry final {
     http::HttpStatus code{http::HttpStatus::kInternalServerError};
-    std::chrono::milliseconds timing{};
+    std::chrono::microseconds timing{};
     engine::Deadline deadline{};
     bool cancelled_by_deadline{false};
+    // zero unless the task processor accounts resource usage
+    engine::TaskResourceUsage resource_usage{};
 };
 
 struct HttpHandlerStatisticsSnapshot;
@@ -48,8 +51,9 @@ public:
 private:
     friend struct HttpHandlerStatisticsSnapshot;
 
-    using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
-    using RecentPeriod = utils::statistics::RecentPeriod<Percentile, Percentile, utils::datetime::SteadyClock>;
+    // Microseconds up to 134 seconds with 1.6% precision
+    using Timings = utils::statistics::LogLinearHistogram<6, 27>;
+    using RecentPeriod = utils::statistics::RecentPeriod<Timings, Timings, utils::datetime::SteadyClock>;
 
     RecentPeriod timings_;
     utils::statistics::HttpCodes reply_codes_;
@@ -59,6 +63,9 @@ private:
     utils::statistics::RateCounter rate_limit_reached_;
     utils::statistics::RateCounter deadline_received_;
     utils::statistics::RateCounter cancelled_by_deadline_;
+    utils::statistics::RateCounter cpu_time_us_;
+    utils::statistics::RateCounter allocated_bytes_;
+    utils::statistics::RateCounter deallocated_bytes_;
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerMethodStatistics& stats);
@@ -70,7 +77,7 @@ struct HttpHandlerStatisticsSnapshot final {
 
     void Add(const HttpHandlerStatisticsSnapshot& other);
 
-    HttpHandlerMethodStatistics::Percentile timings;
+    HttpHandlerMethodStatistics::Timings timings;
     utils::statistics::HttpCodes::Snapshot reply_codes;
     std::size_t in_flight{0};
     utils::statistics::Rate finished;
@@ -78,14 +85,25 @@ struct HttpHandlerStatisticsSnapshot final {
     utils::statistics::Rate rate_limit_reached;
     utils::statistics::Rate deadline_received;
     utils::statistics::Rate cancelled_by_deadline;
+    utils::statistics::Rate cpu_time_us;
+    utils::statistics::Rate allocated_bytes;
+    utils::statistics::Rate deallocated_bytes;
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerStatisticsSnapshot& stats);
 
+// Writes the snapshot with the opted-in timings metrics
+struct HttpHandlerStatisticsView final {
+    const HttpHandlerStatisticsSnapshot& snapshot;
+    utils::statistics::TimingsMetrics timings_metrics;
+};
+
+void DumpMetric(utils::statistics::Writer& writer, const HttpHandlerStatisticsView& view);
+
 // Statistics for a single request from the overall server or the external
 // client perspective. Includes the time spent in queue.
 struct HttpRequestStatisticsEntry final {
-    std::chrono::milliseconds timing;
+    std::chrono::microseconds timing;
 };
 
 class HttpRequestMethodStatistics final {
@@ -94,12 +112,13 @@ public:
 
     void Account(const HttpRequestStatisticsEntry& stats) noexcept;
 
-    using Percentile = utils::statistics::Percentile<2048, unsigned int, 120>;
+    // Microseconds up to 134 seconds with 1.6% precision
+    using Timings = utils::statistics::LogLinearHistogram<6, 27>;
 
-    Percentile GetTimings() const { return timings_.GetStatsForPeriod(); }
+    Timings GetTimings() const { return timings_.GetStatsForPeriod(); }
 
 private:
-    utils::statistics::RecentPeriod<Percentile, Percentile, utils::datetime::SteadyClock> timings_;
+    utils::statistics::RecentPeriod<Timings, Timings, utils::datetime::SteadyClock> timings_;
 };
 
 bool IsOkMethod(http::HttpMethod method) noexcept;
@@ -143,6 +162,7 @@ private:
     HttpHandlerStatistics& stats_;
     const http::HttpMethod method_;
     const std::chrono::steady_clock::time_point start_time_;
+    const engine::TaskResourceUsage start_resource_usage_;
     server::http::HttpResponse& response_;
     bool cancelled_by_deadline_{false};
 };
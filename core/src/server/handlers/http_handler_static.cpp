@@ -1,11 +1,27 @@
 #include <userver/server/handlers/http_handler_static.hpp>
 
+#include <sys/stat.h>
+
+#include <chrono>
+#include <optional>
+
+#include <cctz/time_zone.h>
+#include <fmt/format.h>
+
 #include <userver/components/component_config.hpp>
 #include <userver/components/component_context.hpp>
 #include <userver/dynamic_config/storage/component.hpp>
 #include <userver/dynamic_config/value.hpp>
+#include <userver/engine/async.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/http/common_headers.hpp>
+#include <userver/utils/text_light.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <server/http/http_cached_date.hpp>
+#include <server/http/http_range.hpp>
+#include <utils/check_syscall.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace server::handlers {
@@ -32,6 +48,69 @@ const dynamic_config::Key<dynamic_config::ValueDict<std::string>> kContentTypeMa
 )"},
 };
 
+struct FileVersion final {
+    std::size_t size{0};
+    std::chrono::system_clock::time_point last_modified{};
+};
+
+struct OpenedFile final {
+    fs::blocking::FileDescriptor file;
+    FileVersion version;
+};
+
+OpenedFile OpenFileBlocking(const std::string& path) {
+    auto file = fs::blocking::FileDescriptor::Open(path, fs::blocking::OpenFlag::kRead);
+    struct ::stat stat_buf {};
+    utils::CheckSyscall(::fstat(file.GetNative(), &stat_buf), "getting the status of '{}'", path);
+    return {
+        std::move(file),
+        {static_cast<std::size_t>(stat_buf.st_size), std::chrono::system_clock::from_time_t(stat_buf.st_mtime)}};
+}
+
+std::string MakeETag(const FileVersion& version) {
+    const auto mtime = std::chrono::system_clock::to_time_t(version.last_modified);
+    return fmt::format("\"{:x}-{:x}\"", mtime, version.size);
+}
+
+// Only the IMF-fixdate format is accepted, the obsolete ones are not
+std::optional<std::chrono::system_clock::time_point> ParseHttpDate(std::string_view value) {
+    static const std::string kFormatString = "%a, %d %b %Y %H:%M:%S";
+    // GMT per RFC, MakeHttpDate() formats UTC
+    if (!utils::text::EndsWith(value, " GMT") && !utils::text::EndsWith(value, " UTC")) return std::nullopt;
+    value.remove_suffix(4);
+
+    std::chrono::system_clock::time_point result;
+    if (!cctz::parse(kFormatString, std::string{value}, cctz::utc_time_zone(), &result)) return std::nullopt;
+    return result;
+}
+
+bool IsNotModified(const http::HttpRequest& request, const std::string& etag, const FileVersion& version) {
+    // If-Modified-Since is ignored in presence of If-None-Match, RFC 9110 13.1.3
+    const auto& if_none_match = request.GetHeader(USERVER_NAMESPACE::http::headers::kIfNoneMatch);
+    if (!if_none_match.empty()) return http::impl::IsAnyETagMatching(if_none_match, etag);
+
+    const auto& if_modified_since = request.GetHeader(USERVER_NAMESPACE::http::headers::kIfModifiedSince);
+    if (if_modified_since.empty()) return false;
+    const auto since = ParseHttpDate(if_modified_since);
+    return since && std::chrono::floor<std::chrono::seconds>(version.last_modified) <= *since;
+}
+
+http::impl::ByteRange GetRange(
+    const http::HttpRequest& request,
+    const std::string& etag,
+    const std::string& last_modified,
+    std::size_t size
+) {
+    const auto& range = request.GetHeader(USERVER_NAMESPACE::http::headers::kRange);
+    if (range.empty()) return {};
+
+    // The whole file is sent if it has changed since the client got a part
+    const auto& if_range = request.GetHeader(USERVER_NAMESPACE::http::headers::kIfRange);
+    if (!if_range.empty() && if_range != etag && if_range != last_modified) return {};
+
+    return http::impl::ParseRangeHeader(range, size);
+}
+
 }  // namespace
 
 HttpHandlerStatic::HttpHandlerStatic(
@@ -47,14 +126,72 @@ HttpHandlerStatic::HttpHandlerStatic(
 
 std::string HttpHandlerStatic::HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const {
     LOG_DEBUG() << "Handler: " << request.GetRequestPath();
+    auto& response = request.GetHttpResponse();
     const auto file = storage_.TryGetFile(request.GetRequestPath());
-    if (file) {
-        const auto config = config_.GetSnapshot();
-        request.GetHttpResponse().SetContentType(config[kContentTypeMap][file->extension]);
-        return file->data;
+    if (!file) {
+        response.SetStatusNotFound();
+        return "File not found";
+    }
+
+    std::optional<fs::blocking::FileDescriptor> opened_file;
+    FileVersion version{file->size, file->last_modified};
+    if (!file->is_loaded) {
+        try {
+            auto opened = engine::AsyncNoSpan(storage_.GetTaskProcessor(), &OpenFileBlocking, file->path).Get();
+            opened_file.emplace(std::move(opened.file));
+            version = opened.version;
+        } catch (const std::exception& ex) {
+            LOG_WARNING() << "Failed to open " << file->path << ": " << ex;
+            response.SetStatusNotFound();
+            return "File not found";
+        }
+    }
+
+    const auto config = config_.GetSnapshot();
+    response.SetContentType(config[kContentTypeMap][file->extension]);
+
+    auto etag = MakeETag(version);
+    auto last_modified = http::impl::MakeHttpDate(version.last_modified);
+    response.SetHeader(USERVER_NAMESPACE::http::headers::kAcceptRanges, std::string{"bytes"});
+    if (IsNotModified(request, etag, version)) {
+        response.SetStatus(http::HttpStatus::kNotModified);
+        response.SetHeader(USERVER_NAMESPACE::http::headers::kETag, std::move(etag));
+        response.SetHeader(USERVER_NAMESPACE::http::headers::kLastModified, std::move(last_modified));
+        return {};
+    }
+
+    auto range = GetRange(request, etag, last_modified, version.size);
+    response.SetHeader(USERVER_NAMESPACE::http::headers::kETag, std::move(etag));
+    response.SetHeader(USERVER_NAMESPACE::http::headers::kLastModified, std::move(last_modified));
+    switch (range.status) {
+        case http::impl::ByteRange::Status::kIgnored:
+            range.size = version.size;
+            break;
+        case http::impl::ByteRange::Status::kSatisfiable:
+            response.SetStatus(http::HttpStatus::kPartialContent);
+            response.SetHeader(
+                USERVER_NAMESPACE::http::headers::kContentRange,
+                fmt::format("bytes {}-{}/{}", range.offset, range.offset + range.size - 1, version.size)
+            );
+            break;
+        case http::impl::ByteRange::Status::kUnsatisfiable:
+            response.SetStatus(http::HttpStatus::kRangeNotSatisfiable);
+            response.SetHeader(
+                USERVER_NAMESPACE::http::headers::kContentRange, fmt::format("bytes */{}", version.size)
+            );
+            return {};
+    }
+
+    if (opened_file) {
+        response.SetFileBody(std::move(*opened_file), range.offset, range.size, storage_.GetTaskProcessor());
+        return {};
+    }
+    if (range.size == file->data.size()) {
+        // The cached contents are sent as is, without copying
+        response.SetSharedData(std::shared_ptr<const std::string>{file, &file->data});
+        return {};
     }
-    request.GetHttpResponse().SetStatusNotFound();
-    return "File not found";
+    return file->data.substr(range.offset, range.size);
 }
 
 yaml_config::Schema HttpHandlerStatic::GetStaticConfigSchema() {
@@ -62,7 +199,8 @@ yaml_config::Schema HttpHandlerStatic::GetStaticConfigSchema() {
 type: object
 description: |
     Handler that returns HTTP 200 if file exist
-    and returns file data with mapped content/type
+    and returns file data with mapped content/type.
+    Supports single range and conditional requests.
 additionalProperties: false
 properties:
     fs-cache-component:
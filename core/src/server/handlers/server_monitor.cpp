@@ -4,6 +4,7 @@
 #include <userver/components/statistics_storage.hpp>
 #include <userver/formats/json/serialize.hpp>
 #include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/http/http_response_body_stream.hpp>
 #include <userver/utils/statistics/graphite.hpp>
 #include <userver/utils/statistics/json.hpp>
 #include <userver/utils/statistics/pretty_format.hpp>
@@ -60,6 +61,14 @@ std::optional<StatsFormat> ParseFormat(std::string_view format) {
     )});
 }
 
+utils::statistics::PrometheusFormatterSettings
+MakePrometheusFormatterSettings(const components::ComponentConfig& config, bool typed) {
+    utils::statistics::PrometheusFormatterSettings settings;
+    settings.typed = typed;
+    settings.cache_series = config["cache-prometheus-series"].As<bool>(false);
+    return settings;
+}
+
 }  // namespace
 
 ServerMonitor::ServerMonitor(
@@ -69,37 +78,12 @@ ServerMonitor::ServerMonitor(
     : HttpHandlerBase(config, component_context, /*is_monitor = */ true),
       statistics_storage_(component_context.FindComponent<components::StatisticsStorage>().GetStorage()),
       common_labels_{config["common-labels"].As<CommonLabels>({})},
-      default_format_{ParseFormat(config["format"].As<std::string>({}))} {}
+      default_format_{ParseFormat(config["format"].As<std::string>({}))},
+      prometheus_formatter_{MakePrometheusFormatterSettings(config, /*typed=*/true)},
+      prometheus_untyped_formatter_{MakePrometheusFormatterSettings(config, /*typed=*/false)} {}
 
 std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request, request::RequestContext&) const {
-    const auto& prefix = request.GetArg("prefix");
-    const auto& path = request.GetArg("path");
-    if (!path.empty() && !prefix.empty() && path != prefix) {
-        throw handlers::ClientError(handlers::ExternalBody{"Use either 'path' or 'prefix' URL parameter, not both"});
-    }
-
-    std::vector<utils::statistics::Label> labels;
-    const auto& labels_json = request.GetArg("labels");
-    if (!labels_json.empty()) {
-        auto json = formats::json::FromString(labels_json);
-        for (auto [key, value] : Items(json)) {
-            labels.emplace_back(std::move(key), value.As<std::string>());
-        }
-    }
-
-    const auto arg_format = ParseFormat(request.GetArg("format"));
-
-    if (!default_format_.has_value() && !arg_format.has_value()) {
-        throw handlers::ClientError(handlers::ExternalBody{"No format was provided"});
-    }
-
-    const auto format = arg_format.has_value() ? arg_format.value() : default_format_.value();
-
-    using utils::statistics::Request;
-    auto common_labels = format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels_;
-    const auto statistics_request =
-        (path.empty() ? Request::MakeWithPrefix(prefix, std::move(common_labels), std::move(labels))
-                      : Request::MakeWithPath(path, std::move(common_labels), std::move(labels)));
+    const auto [format, statistics_request] = ParseRequest(request);
 
     request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
     switch (format) {
@@ -107,10 +91,8 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
             return utils::statistics::ToGraphiteFormat(statistics_storage_, statistics_request);
 
         case StatsFormat::kPrometheus:
-            return utils::statistics::ToPrometheusFormat(statistics_storage_, statistics_request);
-
         case StatsFormat::kPrometheusUntyped:
-            return utils::statistics::ToPrometheusFormatUntyped(statistics_storage_, statistics_request);
+            return GetPrometheusFormatter(format).ToString(statistics_storage_, statistics_request);
 
         case StatsFormat::kJson:
             request.GetHttpResponse().SetContentType("application/json");
@@ -133,6 +115,68 @@ std::string ServerMonitor::HandleRequestThrow(const http::HttpRequest& request,
     UINVARIANT(false, "Unexpected 'format' value");
 }
 
+void ServerMonitor::HandleStreamRequest(
+    const http::HttpRequest& request,
+    request::RequestContext& context,
+    http::ResponseBodyStream& response_body_stream
+) const {
+    const auto [format, statistics_request] = ParseRequest(request);
+    if (format != StatsFormat::kPrometheus && format != StatsFormat::kPrometheusUntyped) {
+        auto body = HandleRequestThrow(request, context);
+        response_body_stream.SetStatusCode(http::HttpStatus::kOk);
+        response_body_stream.SetEndOfHeaders();
+        response_body_stream.PushBodyChunk(std::move(body), {});
+        return;
+    }
+
+    request.GetHttpResponse().SetContentType("text/plain; charset=utf-8");
+    response_body_stream.SetStatusCode(http::HttpStatus::kOk);
+    response_body_stream.SetEndOfHeaders();
+    GetPrometheusFormatter(format).Write(
+        statistics_storage_,
+        statistics_request,
+        [&response_body_stream](std::string&& chunk) { response_body_stream.PushBodyChunk(std::move(chunk), {}); }
+    );
+}
+
+std::pair<StatsFormat, utils::statistics::Request> ServerMonitor::ParseRequest(const http::HttpRequest& request
+) const {
+    const auto& prefix = request.GetArg("prefix");
+    const auto& path = request.GetArg("path");
+    if (!path.empty() && !prefix.empty() && path != prefix) {
+        throw handlers::ClientError(handlers::ExternalBody{"Use either 'path' or 'prefix' URL parameter, not both"});
+    }
+
+    std::vector<utils::statistics::Label> labels;
+    const auto& labels_json = request.GetArg("labels");
+    if (!labels_json.empty()) {
+        auto json = formats::json::FromString(labels_json);
+        for (auto [key, value] : Items(json)) {
+            labels.emplace_back(std::move(key), value.As<std::string>());
+        }
+    }
+
+    const auto arg_format = ParseFormat(request.GetArg("format"));
+
+    if (!default_format_.has_value() && !arg_format.has_value()) {
+        throw handlers::ClientError(handlers::ExternalBody{"No format was provided"});
+    }
+
+    const auto format = arg_format.has_value() ? arg_format.value() : default_format_.value();
+
+    using utils::statistics::Request;
+    auto common_labels = format == StatsFormat::kSolomon ? Request::AddLabels{} : common_labels_;
+    return {
+        format,
+        path.empty() ? Request::MakeWithPrefix(prefix, std::move(common_labels), std::move(labels))
+                     : Request::MakeWithPath(path, std::move(common_labels), std::move(labels))};
+}
+
+const utils::statistics::PrometheusFormatter& ServerMonitor::GetPrometheusFormatter(StatsFormat format) const {
+    UASSERT(format == StatsFormat::kPrometheus || format == StatsFormat::kPrometheusUntyped);
+    return format == StatsFormat::kPrometheus ? prometheus_formatter_ : prometheus_untyped_formatter_;
+}
+
 std::string
 ServerMonitor::GetResponseDataForLogging(const http::HttpRequest&, request::RequestContext&, const std::string&) const {
     // Useless data for logs, no need to duplicate metrics in logs
@@ -163,6 +207,13 @@ properties:
           - pretty
           - solomon
           - internal
+    cache-prometheus-series:
+        type: boolean
+        description: |
+            keep the formatted Prometheus series between the requests, speeds up
+            the formatting of large metric trees at the cost of about the output size
+            of memory
+        defaultDescription: false
   )");
 }
 
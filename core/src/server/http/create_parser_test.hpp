@@ -10,6 +10,7 @@
 
 #include <server/http/http2_session.hpp>
 #include <server/http/http_request_parser.hpp>
+#include <server/http/http_request_simd_parser.hpp>
 #include <server/net/connection_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -18,7 +19,8 @@ namespace server {
 
 inline std::shared_ptr<request::RequestParser> CreateTestParser(
     server::http::HttpRequestParser::OnNewRequestCb&& cb,
-    USERVER_NAMESPACE::http::HttpVersion http_version = USERVER_NAMESPACE::http::HttpVersion::k11
+    USERVER_NAMESPACE::http::HttpVersion http_version = USERVER_NAMESPACE::http::HttpVersion::k11,
+    server::net::Http1ParserType http1_parser = server::net::Http1ParserType::kLlhttp
 ) {
     static const server::http::HandlerInfoIndex kTestHandlerInfoIndex;
     static const server::request::HttpRequestConfig kTestRequestConfig{
@@ -44,6 +46,10 @@ inline std::shared_ptr<request::RequestParser> CreateTestParser(
             test_accounter,
             engine::io::Sockaddr{}
         );
+    } else if (http1_parser == server::net::Http1ParserType::kSimd) {
+        return std::make_shared<server::http::HttpRequestSimdParser>(
+            kTestHandlerInfoIndex, kTestRequestConfig, std::move(cb), test_stats, test_accounter, engine::io::Sockaddr{}
+        );
     } else {
         return std::make_shared<server::http::HttpRequestParser>(
             kTestHandlerInfoIndex, kTestRequestConfig, std::move(cb), test_stats, test_accounter, engine::io::Sockaddr{}
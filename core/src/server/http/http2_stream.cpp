@@ -67,18 +67,44 @@ bool Stream::CheckUrlComplete() {
 
 void Stream::PushChunk(std::string&& chunk) {
     if (chunk.empty()) return;
-    chunks_.push_back(std::move(chunk));
+    chunks_.emplace_back(std::move(chunk));
+}
+
+void Stream::PushChunk(std::shared_ptr<const std::string>&& chunk) {
+    if (!chunk || chunk->empty()) return;
+    chunks_.emplace_back(std::move(chunk));
+}
+
+void Stream::SetBodyReader(std::function<std::string()>&& reader, std::size_t size) {
+    UASSERT(chunks_.empty());
+    UASSERT(!is_streaming_);
+    body_reader_ = std::move(reader);
+    body_reader_remaining_ = size;
 }
 
 ssize_t Stream::GetMaxSize(std::size_t max_len, std::uint32_t* flags) {
     auto& stream = *static_cast<Stream*>(nghttp2_provider_.source.ptr);
+    if (chunks_.empty() && body_reader_remaining_ != 0) {
+        try {
+            auto chunk = body_reader_();
+            UASSERT(!chunk.empty() && chunk.size() <= body_reader_remaining_);
+            body_reader_remaining_ -= chunk.size();
+            PushChunk(std::move(chunk));
+        } catch (const std::exception& e) {
+            LOG_LIMITED_ERROR() << "Failed to read the body of the stream " << id_ << ": " << e;
+            body_reader_ = {};
+            // Resets the stream
+            return NGHTTP2_ERR_TEMPORAL_CALLBACK_FAILURE;
+        }
+        if (body_reader_remaining_ == 0) body_reader_ = {};
+    }
     if (chunks_.empty() && !stream.is_streaming_) {
         *flags |= NGHTTP2_DATA_FLAG_EOF;
         return 0;
     }
     const std::size_t total =
-        std::accumulate(chunks_.begin(), chunks_.end(), std::size_t{0}, [](std::size_t size, const auto& str) {
-            return size + str.size();
+        std::accumulate(chunks_.begin(), chunks_.end(), std::size_t{0}, [](std::size_t size, const Chunk& chunk) {
+            return size + chunk.View().size();
         });
     if (total == 0 && stream.is_streaming_ && !stream.is_end_) {
         stream.is_deferred_ = true;
@@ -86,10 +112,11 @@ ssize_t Stream::GetMaxSize(std::size_t max_len, std::uint32_t* flags) {
     }
     if (!stream.is_streaming_) {
         UASSERT(chunks_.size() == 1);
-        if (pos_in_first_chunk_ + max_len >= chunks_[0].size()) {
+        const auto chunk_size = chunks_[0].View().size();
+        if (pos_in_first_chunk_ + max_len >= chunk_size && body_reader_remaining_ == 0) {
             *flags |= NGHTTP2_DATA_FLAG_EOF;
         }
-        return std::min(max_len, chunks_[0].size() - pos_in_first_chunk_);
+        return std::min(max_len, chunk_size - pos_in_first_chunk_);
     }
     UASSERT(total >= pos_in_first_chunk_);
     const auto remaining = total - pos_in_first_chunk_;
@@ -104,13 +131,13 @@ void Stream::Send(engine::io::Socket& socket, std::string_view data_frame_header
     boost::container::small_vector<engine::io::IoData, 16> parts{};
     parts.push_back({data_frame_header.data(), data_frame_header.size()});
     auto budget = max_len;
-    for (const auto& chunk : chunks_) {
+    for (const auto& chunk_data : chunks_) {
         if (budget == 0) {
             break;
         }
+        const auto chunk = chunk_data.View();
         UASSERT(chunk.size() > pos_in_first_chunk_);
-        const auto part =
-            std::string_view{chunk}.substr(pos_in_first_chunk_, std::min(chunk.size() - pos_in_first_chunk_, budget));
+        const auto part = chunk.substr(pos_in_first_chunk_, std::min(chunk.size() - pos_in_first_chunk_, budget));
         parts.push_back({part.data(), part.size()});
         pos_in_first_chunk_ += part.size();
         if (pos_in_first_chunk_ >= chunk.size()) {
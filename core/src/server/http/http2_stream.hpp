@@ -1,5 +1,10 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
 #include <nghttp2/nghttp2.h>
 #include <boost/container/small_vector.hpp>
 
@@ -42,18 +47,37 @@ public:
 
     bool CheckUrlComplete();
     void PushChunk(std::string&& chunk);
+    void PushChunk(std::shared_ptr<const std::string>&& chunk);
+    // The body of `size` bytes is read from `reader` chunk by chunk, when
+    // the flow control window allows to send the previous chunk
+    void SetBodyReader(std::function<std::string()>&& reader, std::size_t size);
     ssize_t GetMaxSize(std::size_t max_len, std::uint32_t* flags);
     void Send(engine::io::Socket& socket, std::string_view data_frame_header, std::size_t max_len);
     nghttp2_data_provider* GetNativeProvider() { return &nghttp2_provider_; }
 
 private:
+    // A body chunk, either owned by the stream or shared with other responses
+    class Chunk final {
+    public:
+        explicit Chunk(std::string&& data) noexcept : data_(std::move(data)) {}
+        explicit Chunk(std::shared_ptr<const std::string>&& data) noexcept : shared_data_(std::move(data)) {}
+
+        std::string_view View() const noexcept { return shared_data_ ? *shared_data_ : data_; }
+
+    private:
+        std::string data_;
+        std::shared_ptr<const std::string> shared_data_;
+    };
+
     bool url_complete_{false};
     HttpRequestConstructor constructor_;
     const Id id_;
     // Body sending
     nghttp2_data_provider nghttp2_provider_{};
-    boost::container::small_vector<std::string, 16> chunks_{};
+    boost::container::small_vector<Chunk, 16> chunks_{};
     std::size_t pos_in_first_chunk_{0};
+    std::function<std::string()> body_reader_;
+    std::size_t body_reader_remaining_{0};
     // for the streaming API
     bool is_streaming_{false};
     bool is_end_{false};
@@ -101,12 +101,18 @@ public:
     Http2ResponseWriter(HttpResponse& response, Http2Session& session) : response_(response), http2_session_(session) {}
 
     void WriteHttpResponse() {
-        auto data = response_.ExtractData();
+        // A shared body is referenced by the stream rather than copied
+        auto shared_data = response_.ExtractSharedData();
+        auto data = shared_data ? std::string{} : response_.ExtractData();
+        // nghttp2 frames the DATA itself, so the file can't be sent directly.
+        // It is read in chunks instead, as the flow control allows.
+        const bool is_file_body = !shared_data && data.empty() && response_.HasFileBody();
+        const std::string_view body = shared_data ? std::string_view{*shared_data} : std::string_view{data};
 
         auto headers = GetHeaders();
         const bool is_body_forbidden = IsBodyForbiddenForStatus(response_.status_);
 
-        if (is_body_forbidden && !data.empty()) {
+        if (is_body_forbidden && !body.empty()) {
             LOG_LIMITED_WARNING() << "Non-empty body provided for response with HTTP2 code "
                                   << static_cast<int>(response_.status_)
                                   << " which does not allow one, it will be dropped";
@@ -114,14 +120,22 @@ public:
 
         const auto stream_id = response_.GetStreamId().value();
         auto& stream = http2_session_.GetStreamChecked(Stream::Id{stream_id});
-        stream.SetStreaming(response_.IsBodyStreamed() && data.empty());
+        stream.SetStreaming(response_.IsBodyStreamed() && body.empty() && !is_file_body);
 
         std::size_t bytes = headers.GetSize();
         nghttp2_data_provider* provider{nullptr};
         if (response_.request_.GetMethod() != HttpMethod::kHead && !is_body_forbidden) {
-            if (!stream.IsStreaming()) {
-                bytes += data.size();
-                stream.PushChunk(std::move(data));
+            if (is_file_body) {
+                const auto file_body_size = response_.GetFileBodySize();
+                bytes += file_body_size;
+                stream.SetBodyReader(response_.ExtractFileBodyReader(), file_body_size);
+            } else if (!stream.IsStreaming()) {
+                bytes += body.size();
+                if (shared_data) {
+                    stream.PushChunk(std::move(shared_data));
+                } else {
+                    stream.PushChunk(std::move(data));
+                }
             }
             provider = stream.GetNativeProvider();
         }
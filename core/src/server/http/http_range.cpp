@@ -0,0 +1,100 @@
+#include <server/http/http_range.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <limits>
+#include <optional>
+#include <system_error>
+
+#include <userver/utils/str_icase.hpp>
+#include <userver/utils/text_light.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+namespace {
+
+constexpr std::string_view kBytesUnit = "bytes";
+constexpr std::string_view kWhitespaces = " \t";
+constexpr std::string_view kWeakPrefix = "W/";
+
+std::string_view Trim(std::string_view value) {
+    const auto begin = value.find_first_not_of(kWhitespaces);
+    if (begin == std::string_view::npos) return {};
+    const auto end = value.find_last_not_of(kWhitespaces);
+    return value.substr(begin, end - begin + 1);
+}
+
+std::optional<std::size_t> ParsePosition(std::string_view value) {
+    std::size_t result = 0;
+    const auto* const end = value.data() + value.size();
+    const auto [ptr, ec] = std::from_chars(value.data(), end, result);
+    if (ptr != end) return std::nullopt;
+    // positions beyond any file size are as good as the largest one
+    if (ec == std::errc::result_out_of_range) return std::numeric_limits<std::size_t>::max();
+    if (ec != std::errc{}) return std::nullopt;
+    return result;
+}
+
+std::string_view StripWeak(std::string_view etag) {
+    if (utils::text::StartsWith(etag, kWeakPrefix)) etag.remove_prefix(kWeakPrefix.size());
+    return etag;
+}
+
+}  // namespace
+
+ByteRange ParseRangeHeader(std::string_view header, std::size_t resource_size) {
+    header = Trim(header);
+    const auto unit_end = header.find('=');
+    if (unit_end == std::string_view::npos || !utils::StrIcaseEqual{}(Trim(header.substr(0, unit_end)), kBytesUnit)) {
+        return {};
+    }
+    const auto spec = Trim(header.substr(unit_end + 1));
+    if (spec.find(',') != std::string_view::npos) return {};
+
+    const auto dash = spec.find('-');
+    if (dash == std::string_view::npos) return {};
+    const auto first = Trim(spec.substr(0, dash));
+    const auto last = Trim(spec.substr(dash + 1));
+
+    if (first.empty()) {
+        // suffix-range, the last N bytes
+        const auto suffix_length = ParsePosition(last);
+        if (!suffix_length) return {};
+        if (*suffix_length == 0 || resource_size == 0) return {ByteRange::Status::kUnsatisfiable};
+
+        const auto size = std::min(*suffix_length, resource_size);
+        return {ByteRange::Status::kSatisfiable, resource_size - size, size};
+    }
+
+    const auto first_pos = ParsePosition(first);
+    if (!first_pos) return {};
+
+    auto last_pos = resource_size == 0 ? 0 : resource_size - 1;
+    if (!last.empty()) {
+        const auto parsed_last_pos = ParsePosition(last);
+        if (!parsed_last_pos || *parsed_last_pos < *first_pos) return {};
+        last_pos = std::min(last_pos, *parsed_last_pos);
+    }
+
+    if (*first_pos >= resource_size) return {ByteRange::Status::kUnsatisfiable};
+    return {ByteRange::Status::kSatisfiable, *first_pos, last_pos - *first_pos + 1};
+}
+
+bool IsAnyETagMatching(std::string_view if_none_match, std::string_view etag) {
+    if (Trim(if_none_match) == "*") return true;
+
+    etag = StripWeak(etag);
+    while (!if_none_match.empty()) {
+        const auto separator = if_none_match.find(',');
+        if (StripWeak(Trim(if_none_match.substr(0, separator))) == etag) return true;
+        if (separator == std::string_view::npos) break;
+        if_none_match.remove_prefix(separator + 1);
+    }
+    return false;
+}
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
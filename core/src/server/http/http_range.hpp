@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http::impl {
+
+/// Outcome of matching a Range header against a resource
+struct ByteRange final {
+    enum class Status {
+        /// The header is absent, malformed or asks for several ranges, the whole
+        /// resource should be sent with 200
+        kIgnored,
+        /// [offset, offset + size) should be sent with 206
+        kSatisfiable,
+        /// 416 should be sent
+        kUnsatisfiable,
+    };
+
+    Status status{Status::kIgnored};
+    std::size_t offset{0};
+    std::size_t size{0};
+};
+
+/// @brief Parses a single `bytes` range as described in RFC 9110 section 14.1
+/// for a resource of `resource_size` bytes.
+///
+/// Requests for several ranges are ignored, which RFC allows.
+ByteRange ParseRangeHeader(std::string_view header, std::size_t resource_size);
+
+/// @brief Checks the If-None-Match header value against the current entity tag
+/// using the weak comparison, as RFC 9110 section 13.1.2 demands.
+bool IsAnyETagMatching(std::string_view if_none_match, std::string_view etag);
+
+}  // namespace server::http::impl
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,69 @@
+#include <userver/utest/utest.hpp>
+
+#include <server/http/http_range.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::http::impl::ByteRange;
+using server::http::impl::ParseRangeHeader;
+
+void ExpectRange(std::string_view header, std::size_t resource_size, std::size_t offset, std::size_t size) {
+    const auto range = ParseRangeHeader(header, resource_size);
+    EXPECT_EQ(range.status, ByteRange::Status::kSatisfiable) << header;
+    EXPECT_EQ(range.offset, offset) << header;
+    EXPECT_EQ(range.size, size) << header;
+}
+
+void ExpectStatus(std::string_view header, std::size_t resource_size, ByteRange::Status status) {
+    EXPECT_EQ(ParseRangeHeader(header, resource_size).status, status) << header;
+}
+
+}  // namespace
+
+TEST(HttpRange, Satisfiable) {
+    ExpectRange("bytes=0-499", 10000, 0, 500);
+    ExpectRange("bytes=500-999", 10000, 500, 500);
+    ExpectRange("bytes=9500-", 10000, 9500, 500);
+    ExpectRange("bytes=-500", 10000, 9500, 500);
+    ExpectRange("bytes=0-0", 10000, 0, 1);
+    ExpectRange(" Bytes = 10 - 19 ", 10000, 10, 10);
+}
+
+TEST(HttpRange, Clamped) {
+    ExpectRange("bytes=9000-20000", 10000, 9000, 1000);
+    ExpectRange("bytes=-20000", 10000, 0, 10000);
+    ExpectRange("bytes=0-99999999999999999999999", 10000, 0, 10000);
+}
+
+TEST(HttpRange, Unsatisfiable) {
+    ExpectStatus("bytes=10000-", 10000, ByteRange::Status::kUnsatisfiable);
+    ExpectStatus("bytes=20000-30000", 10000, ByteRange::Status::kUnsatisfiable);
+    ExpectStatus("bytes=-0", 10000, ByteRange::Status::kUnsatisfiable);
+    ExpectStatus("bytes=0-", 0, ByteRange::Status::kUnsatisfiable);
+    ExpectStatus("bytes=-10", 0, ByteRange::Status::kUnsatisfiable);
+}
+
+TEST(HttpRange, Ignored) {
+    ExpectStatus("", 10000, ByteRange::Status::kIgnored);
+    ExpectStatus("items=0-10", 10000, ByteRange::Status::kIgnored);
+    ExpectStatus("bytes=10-5", 10000, ByteRange::Status::kIgnored);
+    ExpectStatus("bytes=a-b", 10000, ByteRange::Status::kIgnored);
+    ExpectStatus("bytes=-", 10000, ByteRange::Status::kIgnored);
+    ExpectStatus("bytes=10", 10000, ByteRange::Status::kIgnored);
+    ExpectStatus("bytes=0-10,20-30", 10000, ByteRange::Status::kIgnored);
+}
+
+TEST(HttpRange, ETagMatching) {
+    using server::http::impl::IsAnyETagMatching;
+
+    EXPECT_TRUE(IsAnyETagMatching(R"("abc")", R"("abc")"));
+    EXPECT_TRUE(IsAnyETagMatching(R"(W/"abc")", R"("abc")"));
+    EXPECT_TRUE(IsAnyETagMatching(R"("x", "abc")", R"("abc")"));
+    EXPECT_TRUE(IsAnyETagMatching(" * ", R"("abc")"));
+    EXPECT_FALSE(IsAnyETagMatching(R"("x", "y")", R"("abc")"));
+    EXPECT_FALSE(IsAnyETagMatching("", R"("abc")"));
+}
+
+USERVER_NAMESPACE_END
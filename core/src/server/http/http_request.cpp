@@ -282,7 +282,7 @@ void HttpRequest::SetPathArgs(std::vector<std::pair<std::string, std::string>> a
 
 void HttpRequest::AccountResponseTime() {
     if (pimpl_->request_statistics_) {
-        auto timing = std::chrono::duration_cast<std::chrono::milliseconds>(
+        auto timing = std::chrono::duration_cast<std::chrono::microseconds>(
             pimpl_->finish_send_response_time_ - pimpl_->start_time_
         );
         pimpl_->request_statistics_->ForMethod(GetMethod()).Account(handlers::HttpRequestStatisticsEntry{timing});
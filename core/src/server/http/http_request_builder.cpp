@@ -54,6 +54,11 @@ HttpRequestBuilder& HttpRequestBuilder::AddHeader(std::string&& header, std::str
     return *this;
 }
 
+HttpRequestBuilder& HttpRequestBuilder::ReserveHeaders(std::size_t count) {
+    request_->pimpl_->headers_.reserve(count);
+    return *this;
+}
+
 HttpRequestBuilder& HttpRequestBuilder::AddRequestArg(std::string&& key, std::string&& value) {
     request_->pimpl_->request_args_[std::move(key)].push_back(std::move(value));
     return *this;
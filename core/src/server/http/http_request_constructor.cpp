@@ -19,21 +19,19 @@ namespace server::http {
 
 namespace {
 
-void StripDuplicateStartingSlashes(std::string& s) {
-    if (s.empty() || s[0] != '/') return;
+// The most of the request body that is reserved before its bytes arrive
+constexpr std::size_t kMaxBodyReserve = 64 * 1024;
+
+std::string_view StripDuplicateStartingSlashes(std::string_view s) {
+    if (s.empty() || s[0] != '/') return s;
 
     size_t non_slash_pos = s.find_first_not_of('/');
-    if (non_slash_pos == std::string::npos) {
+    if (non_slash_pos == std::string_view::npos) {
         // all symbols are slashes
         non_slash_pos = s.size();
     }
 
-    if (non_slash_pos == 1) {
-        // fast path, no strip
-        return;
-    }
-
-    s = s.substr(non_slash_pos - 1);
+    return s.substr(non_slash_pos - 1);
 }
 
 }  // namespace
@@ -83,8 +81,9 @@ void HttpRequestConstructor::ParseUrl() {
     if (parsed_url_pimpl_->parsed_url.field_set & (1 << http_parser_url_fields::UF_PATH)) {
         const auto& str_info = parsed_url_pimpl_->parsed_url.field_data[http_parser_url_fields::UF_PATH];
 
-        auto request_path = url_.substr(str_info.off, str_info.len);
-        StripDuplicateStartingSlashes(request_path);
+        // Strip before copying, to allocate at most once
+        std::string request_path{
+            StripDuplicateStartingSlashes(std::string_view{url_}.substr(str_info.off, str_info.len))};
         LOG_TRACE() << "path='" << request_path << '\'';
         builder_.SetRequestPath(std::move(request_path));
     } else {
@@ -161,6 +160,22 @@ void HttpRequestConstructor::AppendBody(const char* data, size_t size) {
     body_ += std::string_view{data, size};
 }
 
+void HttpRequestConstructor::ReserveHeaders(size_t count) { builder_.ReserveHeaders(count); }
+
+void HttpRequestConstructor::ReserveBody(size_t size) {
+    // Content-Length comes from the client before any body bytes, so only
+    // a small prefix is reserved up front. Otherwise idle connections could pin
+    // up to max_request_size of memory each with just a few header bytes.
+    // Larger bodies grow as the data arrives.
+    if (request_size_ <= config_.max_request_size && size <= config_.max_request_size - request_size_) {
+        body_.reserve(std::min(size, kMaxBodyReserve));
+    }
+}
+
+size_t HttpRequestConstructor::GetHeadersCount() const { return headers_count_; }
+
+size_t HttpRequestConstructor::GetMaxHeadersSize() const { return config_.max_headers_size; }
+
 void HttpRequestConstructor::SetIsFinal(bool is_final) { builder_.SetIsFinal(is_final); }
 
 void HttpRequestConstructor::SetResponseStreamId(std::int32_t stream_id) { builder_.SetResponseStreamId(stream_id); }
@@ -235,6 +250,7 @@ void HttpRequestConstructor::AddHeader() {
 
     try {
         builder_.AddHeader(std::move(header_field_), std::move(header_value_));
+        ++headers_count_;
     } catch (const USERVER_NAMESPACE::http::headers::HeaderMap::TooManyHeadersException&) {
         SetStatus(Status::kHeadersTooLarge);
         utils::LogErrorAndThrow(fmt::format(
@@ -54,6 +54,15 @@ public:
     void AppendHeaderValue(const char* data, size_t size);
     void AppendBody(const char* data, size_t size);
 
+    // Preallocation hints, to avoid reallocations while the request is parsed.
+    // They do not avoid the copies: the URL, headers and body are still copied
+    // from the connection buffer into the strings owned by the request.
+    void ReserveHeaders(size_t count);
+    void ReserveBody(size_t size);
+    size_t GetHeadersCount() const;
+    // The headers size limit, that depends on the handler once the URL is parsed
+    size_t GetMaxHeadersSize() const;
+
     void SetIsFinal(bool is_final);
 
     // HTTP/2.0 only:
@@ -90,6 +99,7 @@ private:
     size_t request_size_ = 0;
     size_t url_size_ = 0;
     size_t headers_size_ = 0;
+    size_t headers_count_ = 0;
     bool url_parsed_ = false;
     Status status_ = Status::kOk;
 
@@ -98,6 +108,20 @@ private:
     HttpRequestBuilder builder_;
 };
 
+// Headers preallocation hint for the requests of a single connection, shared
+// by the HTTP/1.1 parsers. Requests on a connection usually come from the same
+// client and have a similar set of headers, so the previous one is a good
+// estimation.
+class HeadersCountEstimate final {
+public:
+    void ReserveFor(HttpRequestConstructor& request_constructor) const { request_constructor.ReserveHeaders(count_); }
+
+    void Update(const HttpRequestConstructor& request_constructor) { count_ = request_constructor.GetHeadersCount(); }
+
+private:
+    size_t count_ = 0;
+};
+
 }  // namespace server::http
 
 USERVER_NAMESPACE_END
@@ -1,12 +1,28 @@
+#include <string_view>
+#include <utility>
+
 #include <benchmark/benchmark.h>
 
 #include <server/http/http_request_constructor.hpp>
+#include <utils/gbench_allocated_bytes.hpp>
 #include <utils/gbench_auxilary.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace {
 
+constexpr std::string_view kUrl = "/hello?name=world";
+
+constexpr std::pair<std::string_view, std::string_view> kHeaders[] = {
+    {"Host", "localhost:11235"},
+    {"User-Agent", "curl/7.58.0"},
+    {"Accept", "*/*"},
+    {"Content-Type", "application/json"},
+    {"Content-Length", "18"},
+};
+
+constexpr std::string_view kBody = "{\"hello\": \"world\"}";
+
 void http_request_constructor_url_decode(benchmark::State& state) {
     std::string tmp = "1";
     std::string input;
@@ -15,7 +31,41 @@ void http_request_constructor_url_decode(benchmark::State& state) {
 
     for ([[maybe_unused]] auto _ : state) benchmark::DoNotOptimize(USERVER_NAMESPACE::http::parser::UrlDecode(input));
 }
+
+// Feeds a small JSON request into the constructor the way the HTTP/1.1
+// parsers do, to keep track of the allocations made per request
+void http_request_constructor_small_json(benchmark::State& state) {
+    static const server::http::HandlerInfoIndex kHandlerInfoIndex;
+    server::request::HttpRequestConfig config;
+    config.testing_mode = true;
+    server::request::ResponseDataAccounter data_accounter;
+    server::http::HeadersCountEstimate expected_headers_count;
+
+    const utils::GbenchAllocatedBytes allocated_bytes;
+    for ([[maybe_unused]] auto _ : state) {
+        server::http::HttpRequestConstructor constructor{config, kHandlerInfoIndex, data_accounter, {}};
+        expected_headers_count.ReserveFor(constructor);
+        constructor.SetMethod(server::http::HttpMethod::kPost);
+        constructor.AppendUrl(kUrl.data(), kUrl.size());
+        constructor.SetHttpMajor(1);
+        constructor.SetHttpMinor(1);
+        constructor.ParseUrl();
+        for (const auto& [field, value] : kHeaders) {
+            constructor.AppendHeaderField(field.data(), field.size());
+            constructor.AppendHeaderValue(value.data(), value.size());
+        }
+        constructor.AppendHeaderField("", 0);
+        constructor.ReserveBody(kBody.size());
+        constructor.AppendBody(kBody.data(), kBody.size());
+        expected_headers_count.Update(constructor);
+        benchmark::DoNotOptimize(constructor.Finalize());
+    }
+    allocated_bytes.Report(state, "allocated-bytes-per-request");
+}
+
 }  // namespace
+
 BENCHMARK(http_request_constructor_url_decode)->RangeMultiplier(2)->Range(1, 1024);
+BENCHMARK(http_request_constructor_small_json);
 
 USERVER_NAMESPACE_END
@@ -212,6 +212,10 @@ int HttpRequestParser::OnHeadersCompleteImpl(llhttp_t* p) {
         LOG_WARNING() << "can't append header value: " << ex;
         return -1;
     }
+    if (p->flags & F_CONTENT_LENGTH) {
+        // Have the body in a single allocation, even if it comes in parts
+        request_constructor_->ReserveBody(p->content_length);
+    }
     LOG_TRACE() << "headers complete";
     return 0;
 }
@@ -244,6 +248,7 @@ int HttpRequestParser::OnMessageCompleteImpl(llhttp_t* p) {
 void HttpRequestParser::CreateRequestConstructor() {
     stats_.parsing_request_count.Add(1);
     request_constructor_.emplace(request_constructor_config_, handler_info_index_, data_accounter_, remote_address_);
+    expected_headers_count_.ReserveFor(*request_constructor_);
     url_complete_ = false;
 }
 
@@ -264,6 +269,7 @@ bool HttpRequestParser::CheckUrlComplete(llhttp_t* p) {
 
 bool HttpRequestParser::FinalizeRequest() {
     bool res = FinalizeRequestImpl();
+    expected_headers_count_.Update(*request_constructor_);
     stats_.parsing_request_count.Subtract(1);
     request_constructor_.reset();
     return res;
@@ -65,6 +65,7 @@ private:
     const HttpRequestConstructor::Config request_constructor_config_;
 
     bool url_complete_ = false;
+    HeadersCountEstimate expected_headers_count_;
 
     OnNewRequestCb on_new_request_cb_;
 
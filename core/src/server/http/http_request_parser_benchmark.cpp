@@ -1,9 +1,12 @@
 #include <server/http/http_request_parser.hpp>
+#include <server/http/http_request_simd_parser.hpp>
 
 #include <benchmark/benchmark.h>
 
 #include <userver/http/http_version.hpp>
 
+#include <utils/gbench_allocated_bytes.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace {
@@ -19,7 +22,11 @@ constexpr std::string_view kHttpRequestDataMiddle =
 
 constexpr size_t kEntryCount = 1024;
 
-inline server::http::HttpRequestParser CreateBenchmarkParser(server::http::HttpRequestParser::OnNewRequestCb&& cb) {
+using server::http::HttpRequestParser;
+using server::http::HttpRequestSimdParser;
+
+template <typename Parser>
+Parser CreateBenchmarkParser(typename Parser::OnNewRequestCb&& cb) {
     static const server::http::HandlerInfoIndex kTestHandlerInfoIndex;
     static server::request::HttpRequestConfig kTestRequestConfig{
         /*.max_url_size = */ 8192,
@@ -33,31 +40,38 @@ inline server::http::HttpRequestParser CreateBenchmarkParser(server::http::HttpR
         /* deadline_expired_status_code = */ server::http::HttpStatus{498}};
     static server::net::ParserStats test_stats;
     static server::request::ResponseDataAccounter test_accounter;
-    return server::http::HttpRequestParser(
+    return Parser(
         kTestHandlerInfoIndex, kTestRequestConfig, std::move(cb), test_stats, test_accounter, engine::io::Sockaddr{}
     );
 }
 
 }  // namespace
 
+template <typename Parser>
 void http_request_parser_parse_benchmark_small(benchmark::State& state) {
-    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {});
+    auto parser = CreateBenchmarkParser<Parser>([](std::shared_ptr<server::http::HttpRequest>&&) {});
 
+    const utils::GbenchAllocatedBytes allocated_bytes;
     for ([[maybe_unused]] auto _ : state) {
         parser.Parse(kHttpRequestDataSmall);
     }
+    allocated_bytes.Report(state, "allocated-bytes-per-request");
 }
 
+template <typename Parser>
 void http_request_parser_parse_benchmark_middle(benchmark::State& state) {
-    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {});
+    auto parser = CreateBenchmarkParser<Parser>([](std::shared_ptr<server::http::HttpRequest>&&) {});
 
+    const utils::GbenchAllocatedBytes allocated_bytes;
     for ([[maybe_unused]] auto _ : state) {
         parser.Parse(kHttpRequestDataMiddle);
     }
+    allocated_bytes.Report(state, "allocated-bytes-per-request");
 }
 
+template <typename Parser>
 void http_request_parser_parse_benchmark_large_url(benchmark::State& state) {
-    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {});
+    auto parser = CreateBenchmarkParser<Parser>([](std::shared_ptr<server::http::HttpRequest>&&) {});
 
     std::string large_url;
     for (size_t i = 0; i < kEntryCount; ++i) {
@@ -65,13 +79,16 @@ void http_request_parser_parse_benchmark_large_url(benchmark::State& state) {
     }
     const std::string http_request_data = fmt::format("GET {} HTTP/1.1\r\n\r\n", large_url);
 
+    const utils::GbenchAllocatedBytes allocated_bytes;
     for ([[maybe_unused]] auto _ : state) {
         parser.Parse(http_request_data);
     }
+    allocated_bytes.Report(state, "allocated-bytes-per-request");
 }
 
+template <typename Parser>
 void http_request_parser_parse_benchmark_large_body(benchmark::State& state) {
-    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {});
+    auto parser = CreateBenchmarkParser<Parser>([](std::shared_ptr<server::http::HttpRequest>&&) {});
 
     std::string large_body;
     for (size_t i = 0; i < kEntryCount; ++i) {
@@ -84,13 +101,16 @@ void http_request_parser_parse_benchmark_large_body(benchmark::State& state) {
         large_body
     );
 
+    const utils::GbenchAllocatedBytes allocated_bytes;
     for ([[maybe_unused]] auto _ : state) {
         parser.Parse(http_request_data);
     }
+    allocated_bytes.Report(state, "allocated-bytes-per-request");
 }
 
+template <typename Parser>
 void http_request_parser_parse_benchmark_many_headers(benchmark::State& state) {
-    auto parser = CreateBenchmarkParser([](std::shared_ptr<server::http::HttpRequest>&&) {});
+    auto parser = CreateBenchmarkParser<Parser>([](std::shared_ptr<server::http::HttpRequest>&&) {});
 
     std::string headers;
     for (size_t i = 0; i < kEntryCount; ++i) {
@@ -102,15 +122,80 @@ void http_request_parser_parse_benchmark_many_headers(benchmark::State& state) {
         headers
     );
 
+    const utils::GbenchAllocatedBytes allocated_bytes;
+    for ([[maybe_unused]] auto _ : state) {
+        parser.Parse(http_request_data);
+    }
+    allocated_bytes.Report(state, "allocated-bytes-per-request");
+}
+
+template <typename Parser>
+void http_request_parser_parse_benchmark_split_body(benchmark::State& state) {
+    auto parser = CreateBenchmarkParser<Parser>([](std::shared_ptr<server::http::HttpRequest>&&) {});
+
+    // A typical JSON API request, with the body coming in several reads
+    std::string body = "{";
+    for (size_t i = 0; i < 32; ++i) {
+        body += fmt::format("\"key{}\": \"value{}\",", i, i);
+    }
+    body.back() = '}';
+    const std::string http_request_headers = fmt::format(
+        "POST /v1/hello HTTP/1.1\r\n"
+        "Host: localhost:11235\r\nUser-Agent: benchmark-client/1.0\r\nAccept: application/json\r\n"
+        "X-Request-Id: 0123456789abcdef0123456789abcdef\r\n"
+        "Content-Type: application/json\r\nContent-Length: {}\r\n\r\n",
+        body.size()
+    );
+    const std::string_view body_view{body};
+    const auto half_size = body_view.size() / 2;
+
+    const utils::GbenchAllocatedBytes allocated_bytes;
+    for ([[maybe_unused]] auto _ : state) {
+        parser.Parse(http_request_headers);
+        parser.Parse(body_view.substr(0, half_size));
+        parser.Parse(body_view.substr(half_size));
+    }
+    allocated_bytes.Report(state, "allocated-bytes-per-request");
+}
+
+template <typename Parser>
+void http_request_parser_parse_benchmark_gateway_headers(benchmark::State& state) {
+    auto parser = CreateBenchmarkParser<Parser>([](std::shared_ptr<server::http::HttpRequest>&&) {});
+
+    // A request that has passed through a couple of proxies and an API gateway
+    std::string headers;
+    for (size_t i = 0; i < 24; ++i) {
+        headers += fmt::format("X-Gateway-Header-{}: 0123456789abcdef-{}-fedcba9876543210\r\n", i, i);
+    }
+    const std::string http_request_data = fmt::format(
+        "GET /v1/users/1234567/orders?limit=20&offset=40 HTTP/1.1\r\n"
+        "Host: api.example.org\r\nUser-Agent: Mozilla/5.0 (X11; Linux x86_64) AppleWebKit/537.36\r\n"
+        "Accept: application/json\r\nAccept-Encoding: gzip, deflate, br\r\n"
+        "X-Forwarded-For: 203.0.113.7, 198.51.100.23\r\nX-Request-Id: 0123456789abcdef0123456789abcdef\r\n"
+        "{}\r\n",
+        headers
+    );
+
+    const utils::GbenchAllocatedBytes allocated_bytes;
     for ([[maybe_unused]] auto _ : state) {
         parser.Parse(http_request_data);
     }
+    allocated_bytes.Report(state, "allocated-bytes-per-request");
 }
 
-BENCHMARK(http_request_parser_parse_benchmark_small);
-BENCHMARK(http_request_parser_parse_benchmark_middle);
-BENCHMARK(http_request_parser_parse_benchmark_large_url);
-BENCHMARK(http_request_parser_parse_benchmark_large_body);
-BENCHMARK(http_request_parser_parse_benchmark_many_headers);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_small, HttpRequestParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_small, HttpRequestSimdParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_middle, HttpRequestParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_middle, HttpRequestSimdParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_large_url, HttpRequestParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_large_url, HttpRequestSimdParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_large_body, HttpRequestParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_large_body, HttpRequestSimdParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_many_headers, HttpRequestParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_many_headers, HttpRequestSimdParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_split_body, HttpRequestParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_split_body, HttpRequestSimdParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_gateway_headers, HttpRequestParser);
+BENCHMARK_TEMPLATE(http_request_parser_parse_benchmark_gateway_headers, HttpRequestSimdParser);
 
 USERVER_NAMESPACE_END
@@ -201,6 +201,41 @@ UTEST(HttpRequestParserParser, BodySimple) {
     EXPECT_EQ(parsed, true);
 }
 
+UTEST(HttpRequestParserParser, BodyInParts) {
+    std::vector<std::string> bodies;
+    auto parser = server::CreateTestParser([&bodies](std::shared_ptr<server::http::HttpRequest>&& request) {
+        bodies.push_back(request->RequestBody());
+    });
+
+    for (std::size_t split_pos = 1; split_pos < kHttpRequestBodySimple.size(); ++split_pos) {
+        parser->Parse(kHttpRequestBodySimple.substr(0, split_pos));
+        parser->Parse(kHttpRequestBodySimple.substr(split_pos));
+    }
+
+    EXPECT_EQ(bodies, std::vector<std::string>(kHttpRequestBodySimple.size() - 1, "body"));
+}
+
+UTEST(HttpRequestParserParser, KeepAliveHeaders) {
+    std::vector<std::size_t> headers_counts;
+    auto parser = server::CreateTestParser([&headers_counts](std::shared_ptr<server::http::HttpRequest>&& request) {
+        headers_counts.push_back(request->HeaderCount());
+        EXPECT_EQ(request->GetHeader("Host"), "localhost:11235");
+        EXPECT_EQ(request->GetRequestPath(), "/foo");
+    });
+
+    parser->Parse(
+        "GET //foo HTTP/1.1\r\n"
+        "Host: localhost:11235\r\nUser-Agent: curl/7.58.0\r\nAccept: */*\r\n\r\n"
+    );
+    parser->Parse("GET ///foo HTTP/1.1\r\nHost: localhost:11235\r\n\r\n");
+    parser->Parse(
+        "GET /foo HTTP/1.1\r\n"
+        "Host: localhost:11235\r\nUser-Agent: curl/7.58.0\r\nAccept: */*\r\nX-Header: value\r\n\r\n"
+    );
+
+    EXPECT_EQ(headers_counts, (std::vector<std::size_t>{3, 1, 4}));
+}
+
 // bad requests
 
 namespace {
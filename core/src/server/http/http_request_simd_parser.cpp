@@ -0,0 +1,617 @@
+#include "http_request_simd_parser.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+
+#include <userver/http/common_headers.hpp>
+#include <userver/logging/log.hpp>
+#include <userver/server/http/http_method.hpp>
+#include <userver/server/http/http_request.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/str_icase.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace impl {
+
+namespace {
+
+constexpr auto kControlChars = [] {
+    std::array<bool, 256> result{};
+    for (int c = 0; c < 0x20; ++c) result[c] = true;
+    result['\t'] = false;
+    result[0x7f] = true;
+    return result;
+}();
+
+// tchar from RFC 9110 section 5.6.2
+constexpr auto kTokenChars = [] {
+    std::array<bool, 256> result{};
+    for (int c = '0'; c <= '9'; ++c) result[c] = true;
+    for (int c = 'a'; c <= 'z'; ++c) result[c] = true;
+    for (int c = 'A'; c <= 'Z'; ++c) result[c] = true;
+    for (const unsigned char c : std::string_view{"!#$%&'*+-.^_`|~"}) result[c] = true;
+    return result;
+}();
+
+using FindFunction = const char* (*)(const char*, const char*) noexcept;
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+// The SIMD implementations are built for the CPU features they need and are
+// picked at runtime, so that they are used regardless of the -m flags
+#define USERVER_IMPL_SIMD_PARSER_DISPATCH
+
+// Token characters are looked up by nibbles: kTokenLowNibbles[c & 0xf] has
+// the bit `(c >> 4) - 2` set iff `c` is a token character. All of them are
+// in the 0x20-0x7f range, so a byte is enough for the high nibbles.
+constexpr auto kTokenLowNibbles = [] {
+    std::array<std::uint8_t, 16> result{};
+    for (int c = 0x20; c < 0x80; ++c) {
+        if (kTokenChars[c]) result[c & 0xf] |= 1 << ((c >> 4) - 2);
+    }
+    return result;
+}();
+
+constexpr auto kTokenHighNibbles = [] {
+    std::array<std::uint8_t, 16> result{};
+    for (int high = 2; high < 8; ++high) result[high] = 1 << (high - 2);
+    return result;
+}();
+
+static_assert([] {
+    for (int c = 0; c < 256; ++c) {
+        if (kTokenChars[c] != ((kTokenLowNibbles[c & 0xf] & kTokenHighNibbles[c >> 4]) != 0)) return false;
+    }
+    return true;
+}());
+
+const char* FindControlCharSse2(const char* begin, const char* end) noexcept {
+    while (end - begin >= 16) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        // For unsigned c: c < 0x20 <=> min(c, 0x1f) == c
+        const auto is_below_space = _mm_cmpeq_epi8(_mm_min_epu8(block, _mm_set1_epi8(0x1f)), block);
+        const auto is_tab = _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'));
+        const auto is_del = _mm_cmpeq_epi8(block, _mm_set1_epi8(0x7f));
+        const auto mask = static_cast<std::uint32_t>(
+            _mm_movemask_epi8(_mm_or_si128(_mm_andnot_si128(is_tab, is_below_space), is_del))
+        );
+        if (mask != 0) return begin + __builtin_ctz(mask);
+        begin += 16;
+    }
+    return FindControlCharScalar(begin, end);
+}
+
+__attribute__((target("sse4.2"))) const char* FindControlCharSse42(const char* begin, const char* end) noexcept {
+    // Pairs of inclusive ranges: everything below space except HTAB, and DEL
+    alignas(16) static constexpr char kRanges[16] = {0x00, 0x08, 0x0a, 0x1f, 0x7f, 0x7f};
+    const auto ranges = _mm_load_si128(reinterpret_cast<const __m128i*>(kRanges));
+    while (end - begin >= 16) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        const auto index =
+            _mm_cmpestri(ranges, 6, block, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+        if (index != 16) return begin + index;
+        begin += 16;
+    }
+    return FindControlCharScalar(begin, end);
+}
+
+__attribute__((target("avx2"))) const char* FindControlCharAvx2(const char* begin, const char* end) noexcept {
+    while (end - begin >= 32) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        const auto is_below_space = _mm256_cmpeq_epi8(_mm256_min_epu8(block, _mm256_set1_epi8(0x1f)), block);
+        const auto is_tab = _mm256_cmpeq_epi8(block, _mm256_set1_epi8('\t'));
+        const auto is_del = _mm256_cmpeq_epi8(block, _mm256_set1_epi8(0x7f));
+        const auto mask = static_cast<std::uint32_t>(
+            _mm256_movemask_epi8(_mm256_or_si256(_mm256_andnot_si256(is_tab, is_below_space), is_del))
+        );
+        if (mask != 0) return begin + __builtin_ctz(mask);
+        begin += 32;
+    }
+    return FindControlCharSse2(begin, end);
+}
+
+__attribute__((target("ssse3"))) const char* FindNonTokenCharSsse3(const char* begin, const char* end) noexcept {
+    const auto low_nibbles = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kTokenLowNibbles.data()));
+    const auto high_nibbles = _mm_loadu_si128(reinterpret_cast<const __m128i*>(kTokenHighNibbles.data()));
+    const auto nibble_mask = _mm_set1_epi8(0x0f);
+    while (end - begin >= 16) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin));
+        const auto low = _mm_shuffle_epi8(low_nibbles, _mm_and_si128(block, nibble_mask));
+        const auto high = _mm_shuffle_epi8(high_nibbles, _mm_and_si128(_mm_srli_epi16(block, 4), nibble_mask));
+        const auto is_non_token = _mm_cmpeq_epi8(_mm_and_si128(low, high), _mm_setzero_si128());
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(is_non_token));
+        if (mask != 0) return begin + __builtin_ctz(mask);
+        begin += 16;
+    }
+    return FindNonTokenCharScalar(begin, end);
+}
+
+__attribute__((target("avx2"))) const char* FindNonTokenCharAvx2(const char* begin, const char* end) noexcept {
+    // _mm256_shuffle_epi8 looks up within 128-bit lanes, so the tables are
+    // duplicated in both of them
+    const auto low_nibbles = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(kTokenLowNibbles.data()))
+    );
+    const auto high_nibbles = _mm256_broadcastsi128_si256(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(kTokenHighNibbles.data()))
+    );
+    const auto nibble_mask = _mm256_set1_epi8(0x0f);
+    while (end - begin >= 32) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(begin));
+        const auto low = _mm256_shuffle_epi8(low_nibbles, _mm256_and_si256(block, nibble_mask));
+        const auto high = _mm256_shuffle_epi8(high_nibbles, _mm256_and_si256(_mm256_srli_epi16(block, 4), nibble_mask));
+        const auto is_non_token = _mm256_cmpeq_epi8(_mm256_and_si256(low, high), _mm256_setzero_si256());
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(is_non_token));
+        if (mask != 0) return begin + __builtin_ctz(mask);
+        begin += 32;
+    }
+    return FindNonTokenCharSsse3(begin, end);
+}
+
+FindFunction ChooseFindControlChar() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return &FindControlCharAvx2;
+    if (__builtin_cpu_supports("sse4.2")) return &FindControlCharSse42;
+    return &FindControlCharSse2;
+}
+
+FindFunction ChooseFindNonTokenChar() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return &FindNonTokenCharAvx2;
+    if (__builtin_cpu_supports("ssse3")) return &FindNonTokenCharSsse3;
+    return &FindNonTokenCharScalar;
+}
+#endif
+
+}  // namespace
+
+const char* FindControlCharScalar(const char* begin, const char* end) noexcept {
+    while (begin != end && !kControlChars[static_cast<unsigned char>(*begin)]) ++begin;
+    return begin;
+}
+
+const char* FindNonTokenCharScalar(const char* begin, const char* end) noexcept {
+    while (begin != end && kTokenChars[static_cast<unsigned char>(*begin)]) ++begin;
+    return begin;
+}
+
+const char* FindControlChar(const char* begin, const char* end) noexcept {
+#ifdef USERVER_IMPL_SIMD_PARSER_DISPATCH
+    static const FindFunction kImpl = ChooseFindControlChar();
+    return kImpl(begin, end);
+#else
+    return FindControlCharScalar(begin, end);
+#endif
+}
+
+const char* FindNonTokenChar(const char* begin, const char* end) noexcept {
+#ifdef USERVER_IMPL_SIMD_PARSER_DISPATCH
+    static const FindFunction kImpl = ChooseFindNonTokenChar();
+    return kImpl(begin, end);
+#else
+    return FindNonTokenCharScalar(begin, end);
+#endif
+}
+
+}  // namespace impl
+
+namespace {
+
+// Room for the delimiters and whitespace of a line, that are not accounted
+// by the URL and headers size limits
+constexpr std::size_t kLineOverhead = 64;
+
+std::optional<HttpMethod> ParseMethod(std::string_view method) {
+    // Same mapping as for llhttp, TRACE is known but has no HttpMethod
+    if (method == "GET") return HttpMethod::kGet;
+    if (method == "POST") return HttpMethod::kPost;
+    if (method == "PUT") return HttpMethod::kPut;
+    if (method == "DELETE") return HttpMethod::kDelete;
+    if (method == "HEAD") return HttpMethod::kHead;
+    if (method == "PATCH") return HttpMethod::kPatch;
+    if (method == "OPTIONS") return HttpMethod::kOptions;
+    if (method == "CONNECT") return HttpMethod::kConnect;
+    if (method == "TRACE") return HttpMethod::kUnknown;
+    return std::nullopt;
+}
+
+bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+bool ParseVersion(std::string_view version, unsigned short& major, unsigned short& minor) {
+    constexpr std::string_view kPrefix = "HTTP/";
+    if (version.size() != kPrefix.size() + 3 || version.substr(0, kPrefix.size()) != kPrefix) return false;
+    version.remove_prefix(kPrefix.size());
+    if (!IsDigit(version[0]) || version[1] != '.' || !IsDigit(version[2])) return false;
+
+    major = version[0] - '0';
+    minor = version[2] - '0';
+    // The versions llhttp accepts
+    return (major == 1 && minor <= 1) || (major == 0 && minor == 9) || (major == 2 && minor == 0);
+}
+
+std::string_view TrimOws(std::string_view value) {
+    while (!value.empty() && (value.front() == ' ' || value.front() == '\t')) value.remove_prefix(1);
+    while (!value.empty() && (value.back() == ' ' || value.back() == '\t')) value.remove_suffix(1);
+    return value;
+}
+
+template <typename Func>
+void ForEachListElement(std::string_view value, Func func) {
+    while (true) {
+        const auto comma = value.find(',');
+        func(TrimOws(value.substr(0, comma)));
+        if (comma == std::string_view::npos) break;
+        value.remove_prefix(comma + 1);
+    }
+}
+
+template <typename Number>
+bool ParseNumber(std::string_view value, Number& result, int base) {
+    if (value.empty()) return false;
+    const auto* const end = value.data() + value.size();
+    const auto [ptr, ec] = std::from_chars(value.data(), end, result, base);
+    return ec == std::errc{} && ptr == end;
+}
+
+}  // namespace
+
+HttpRequestSimdParser::HttpRequestSimdParser(
+    const HandlerInfoIndex& handler_info_index,
+    const request::HttpRequestConfig& request_config,
+    OnNewRequestCb&& on_new_request_cb,
+    net::ParserStats& stats,
+    request::ResponseDataAccounter& data_accounter,
+    engine::io::Sockaddr remote_address
+)
+    : handler_info_index_(handler_info_index),
+      request_constructor_config_{request_config},
+      max_request_line_size_(request_config.max_url_size + kLineOverhead),
+      on_new_request_cb_(std::move(on_new_request_cb)),
+      stats_(stats),
+      data_accounter_(data_accounter),
+      remote_address_(std::move(remote_address)) {}
+
+bool HttpRequestSimdParser::Parse(std::string_view req) {
+    if (state_ == State::kFailed) return false;
+
+    while (!req.empty() && state_ != State::kUpgraded) {
+        if (!ParseStep(req)) return Fail();
+    }
+
+    if (state_ == State::kUpgraded) {
+        // returns true iff it is an HTTP/2 upgrade request
+        return !message_.is_websocket_upgrade;
+    }
+    return true;
+}
+
+HttpRequestSimdParser::LineStatus HttpRequestSimdParser::TakeLine(std::string_view& data, std::string_view& line) {
+    UASSERT(!data.empty());
+    if (!line_buffer_.empty() && line_buffer_.back() == '\r') {
+        // The previous piece has ended between CR and LF
+        if (data.front() != '\n') return LineStatus::kInvalid;
+        data.remove_prefix(1);
+        line_buffer_.pop_back();
+        line = line_buffer_;
+        return LineStatus::kComplete;
+    }
+
+    const auto* const begin = data.data();
+    const auto* const end = begin + data.size();
+    const auto* const line_end = impl::FindControlChar(begin, end);
+    if (line_end == end || (*line_end == '\r' && line_end + 1 == end)) {
+        const auto max_line_size = GetMaxLineSize();
+        if (line_buffer_.size() + data.size() > max_line_size) {
+            // Keeps just enough of the line for the constructor to report
+            // the limit that has been hit
+            line_buffer_.append(data.substr(0, max_line_size + 1 - line_buffer_.size()));
+            return LineStatus::kTooLong;
+        }
+        line_buffer_.append(data);
+        data = {};
+        return LineStatus::kIncomplete;
+    }
+    if (*line_end != '\r' || line_end[1] != '\n') return LineStatus::kInvalid;
+
+    if (line_buffer_.empty()) {
+        line = std::string_view{begin, static_cast<std::size_t>(line_end - begin)};
+    } else {
+        line_buffer_.append(begin, line_end);
+        line = line_buffer_;
+    }
+    data.remove_prefix(line_end - begin + 2);
+    return LineStatus::kComplete;
+}
+
+std::size_t HttpRequestSimdParser::GetMaxLineSize() const {
+    UASSERT(request_constructor_);
+    // An incomplete line is buffered until it exceeds the limit it is subject
+    // to. Header, chunk size and trailer lines are capped by the headers size,
+    // so a single line can't grow up to the request size limit.
+    if (state_ == State::kRequestLine) return max_request_line_size_;
+    return request_constructor_->GetMaxHeadersSize() + kLineOverhead;
+}
+
+bool HttpRequestSimdParser::ParseStep(std::string_view& data) {
+    switch (state_) {
+        case State::kBody:
+        case State::kChunkData:
+            return OnBody(data);
+        case State::kUpgraded:
+        case State::kFailed:
+            UASSERT_MSG(false, "no data is expected");
+            return false;
+        default:
+            break;
+    }
+
+    if (!request_constructor_) CreateRequestConstructor();
+
+    std::string_view line;
+    switch (TakeLine(data, line)) {
+        case LineStatus::kIncomplete:
+            return true;
+        case LineStatus::kTooLong:
+            LOG_WARNING() << "too long line in HTTP request, size=" << line_buffer_.size();
+            try {
+                // Let the constructor report the limit that has been hit
+                if (state_ == State::kRequestLine) {
+                    request_constructor_->AppendUrl(line_buffer_.data(), line_buffer_.size());
+                } else if (state_ == State::kHeaders) {
+                    request_constructor_->AppendHeaderField(line_buffer_.data(), line_buffer_.size());
+                }
+            } catch (const std::exception& ex) {
+                LOG_WARNING() << "can't append line: " << ex;
+            }
+            return false;
+        case LineStatus::kInvalid:
+            LOG_WARNING() << "invalid line ending or character in HTTP request";
+            return false;
+        case LineStatus::kComplete:
+            break;
+    }
+
+    bool result = false;
+    switch (state_) {
+        case State::kRequestLine:
+            // Empty lines before a request are ignored, RFC 9112 section 2.2
+            result = line.empty() || OnRequestLine(line);
+            break;
+        case State::kHeaders:
+            result = line.empty() ? OnHeadersComplete() : OnHeaderLine(line);
+            break;
+        case State::kChunkSize:
+            result = OnChunkSizeLine(line);
+            break;
+        case State::kChunkDataEnd:
+            result = line.empty();
+            state_ = State::kChunkSize;
+            break;
+        case State::kTrailers:
+            // Trailer fields are skipped
+            result = !line.empty() || OnMessageComplete();
+            break;
+        default:
+            UASSERT_MSG(false, "unexpected state");
+    }
+    line_buffer_.clear();
+    return result;
+}
+
+bool HttpRequestSimdParser::OnRequestLine(std::string_view line) {
+    message_ = MessageInfo{};
+
+    const auto method_end = line.find(' ');
+    if (method_end == std::string_view::npos) return false;
+    const auto method = ParseMethod(line.substr(0, method_end));
+    if (!method) {
+        LOG_WARNING() << "unsupported method in HTTP request";
+        return false;
+    }
+
+    const auto target_begin = method_end + 1;
+    const auto target_end = line.find(' ', target_begin);
+    if (target_end == std::string_view::npos || target_end == target_begin) return false;
+    const auto target = line.substr(target_begin, target_end - target_begin);
+    // HTAB passes the control characters scan
+    if (target.find('\t') != std::string_view::npos) return false;
+    if (!ParseVersion(line.substr(target_end + 1), message_.http_major, message_.http_minor)) return false;
+    message_.method = *method;
+
+    LOG_TRACE() << "url: '" << target << '\'';
+    request_constructor_->SetMethod(message_.method);
+    try {
+        request_constructor_->AppendUrl(target.data(), target.size());
+    } catch (const std::exception& ex) {
+        LOG_WARNING() << "can't append url: " << ex;
+        return false;
+    }
+    request_constructor_->SetHttpMajor(message_.http_major);
+    request_constructor_->SetHttpMinor(message_.http_minor);
+    try {
+        request_constructor_->ParseUrl();
+    } catch (const std::exception& ex) {
+        LOG_WARNING() << "can't parse url: " << ex;
+        return false;
+    }
+
+    state_ = State::kHeaders;
+    return true;
+}
+
+bool HttpRequestSimdParser::OnHeaderLine(std::string_view line) {
+    // field-name is a token immediately followed by a colon, so obsolete line
+    // folding is rejected here as well
+    const auto* const line_end = line.data() + line.size();
+    const auto name_size = static_cast<std::size_t>(impl::FindNonTokenChar(line.data(), line_end) - line.data());
+    if (name_size == 0 || name_size == line.size() || line[name_size] != ':') return false;
+
+    const auto name = line.substr(0, name_size);
+    const auto value = TrimOws(line.substr(name_size + 1));
+    LOG_TRACE() << "header: '" << name << "': '" << value << '\'';
+
+    const utils::StrIcaseEqual equal;
+    if (equal(name, USERVER_NAMESPACE::http::headers::kContentLength)) {
+        std::size_t content_length = 0;
+        if (message_.content_length || message_.has_transfer_encoding || !ParseNumber(value, content_length, 10)) {
+            LOG_WARNING() << "invalid or duplicate Content-Length in HTTP request";
+            return false;
+        }
+        message_.content_length = content_length;
+    } else if (equal(name, USERVER_NAMESPACE::http::headers::kTransferEncoding)) {
+        if (message_.content_length) {
+            LOG_WARNING() << "both Content-Length and Transfer-Encoding in HTTP request";
+            return false;
+        }
+        message_.has_transfer_encoding = true;
+        ForEachListElement(value, [&](std::string_view coding) {
+            // Only the final coding matters
+            message_.is_chunked = equal(coding, "chunked");
+        });
+    } else if (equal(name, USERVER_NAMESPACE::http::headers::kConnection)) {
+        ForEachListElement(value, [&](std::string_view option) {
+            if (equal(option, "close")) message_.connection_close = true;
+            if (equal(option, "keep-alive")) message_.connection_keep_alive = true;
+            if (equal(option, "upgrade")) message_.connection_upgrade = true;
+        });
+    } else if (equal(name, USERVER_NAMESPACE::http::headers::kUpgrade)) {
+        message_.has_upgrade = true;
+        message_.is_websocket_upgrade = equal(value, "websocket");
+    }
+
+    try {
+        request_constructor_->AppendHeaderField(name.data(), name.size());
+        request_constructor_->AppendHeaderValue(value.data(), value.size());
+    } catch (const std::exception& ex) {
+        LOG_WARNING() << "can't append header: " << ex;
+        return false;
+    }
+    return true;
+}
+
+bool HttpRequestSimdParser::OnHeadersComplete() {
+    if (message_.has_transfer_encoding && !message_.is_chunked) {
+        LOG_WARNING() << "Transfer-Encoding of HTTP request does not end with chunked";
+        return false;
+    }
+    try {
+        request_constructor_->AppendHeaderField("", 0);
+    } catch (const std::exception& ex) {
+        LOG_WARNING() << "can't append header value: " << ex;
+        return false;
+    }
+    LOG_TRACE() << "headers complete";
+
+    if (message_.method == HttpMethod::kConnect) return OnMessageComplete();
+    if (message_.is_chunked) {
+        state_ = State::kChunkSize;
+        return true;
+    }
+    if (message_.content_length.value_or(0) != 0) {
+        // Have the body in a single allocation, even if it comes in parts
+        request_constructor_->ReserveBody(*message_.content_length);
+        body_remaining_ = *message_.content_length;
+        state_ = State::kBody;
+        return true;
+    }
+    return OnMessageComplete();
+}
+
+bool HttpRequestSimdParser::OnChunkSizeLine(std::string_view line) {
+    // chunk extensions are ignored
+    const auto size_str = line.substr(0, line.find(';'));
+    std::size_t size = 0;
+    if (!ParseNumber(size_str, size, 16)) {
+        LOG_WARNING() << "invalid chunk size in HTTP request";
+        return false;
+    }
+
+    body_remaining_ = size;
+    state_ = size == 0 ? State::kTrailers : State::kChunkData;
+    return true;
+}
+
+bool HttpRequestSimdParser::OnBody(std::string_view& data) {
+    const auto size = std::min(body_remaining_, data.size());
+    try {
+        request_constructor_->AppendBody(data.data(), size);
+    } catch (const std::exception& ex) {
+        LOG_WARNING() << "can't append body: " << ex;
+        return false;
+    }
+    data.remove_prefix(size);
+    body_remaining_ -= size;
+
+    if (body_remaining_ != 0) return true;
+    if (state_ == State::kBody) return OnMessageComplete();
+    state_ = State::kChunkDataEnd;
+    return true;
+}
+
+bool HttpRequestSimdParser::OnMessageComplete() {
+    LOG_TRACE() << "message complete";
+    if (IsUpgrade()) {
+        state_ = State::kUpgraded;
+        FinalizeRequest();
+        return true;
+    }
+
+    request_constructor_->SetIsFinal(!ShouldKeepAlive());
+    state_ = State::kRequestLine;
+    return FinalizeRequest();
+}
+
+bool HttpRequestSimdParser::IsUpgrade() const {
+    return message_.method == HttpMethod::kConnect || (message_.connection_upgrade && message_.has_upgrade);
+}
+
+bool HttpRequestSimdParser::ShouldKeepAlive() const {
+    // Same as llhttp_should_keep_alive() for requests
+    if (message_.http_major > 0 && message_.http_minor > 0) return !message_.connection_close;
+    return message_.connection_keep_alive;
+}
+
+void HttpRequestSimdParser::CreateRequestConstructor() {
+    stats_.parsing_request_count.Add(1);
+    request_constructor_.emplace(request_constructor_config_, handler_info_index_, data_accounter_, remote_address_);
+    expected_headers_count_.ReserveFor(*request_constructor_);
+}
+
+bool HttpRequestSimdParser::Fail() {
+    state_ = State::kFailed;
+    line_buffer_.clear();
+    FinalizeRequest();
+    return false;
+}
+
+bool HttpRequestSimdParser::FinalizeRequest() {
+    bool res = FinalizeRequestImpl();
+    expected_headers_count_.Update(*request_constructor_);
+    stats_.parsing_request_count.Subtract(1);
+    request_constructor_.reset();
+    return res;
+}
+
+bool HttpRequestSimdParser::FinalizeRequestImpl() {
+    if (!request_constructor_) CreateRequestConstructor();
+
+    if (auto request = request_constructor_->Finalize()) {
+        on_new_request_cb_(std::move(request));
+    } else {
+        LOG_ERROR() << "request is null after Finalize()";
+        return false;
+    }
+    return true;
+}
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <server/net/stats.hpp>
+#include <server/request/request_parser.hpp>
+#include <userver/engine/io/sockaddr.hpp>
+
+#include <userver/server/request/request_config.hpp>
+
+#include "http_request_constructor.hpp"
+
+USERVER_NAMESPACE_BEGIN
+
+namespace server::http {
+
+namespace impl {
+
+// Returns the first control character of [begin, end), or `end` if there is
+// none. HTAB is not considered a control character, as header values may
+// contain it. Uses AVX2, SSE4.2 or SSE2 on x86-64, depending on the CPU the
+// code runs on.
+const char* FindControlChar(const char* begin, const char* end) noexcept;
+
+// Scalar counterpart of FindControlChar, for tests and benchmarks
+const char* FindControlCharScalar(const char* begin, const char* end) noexcept;
+
+// Returns the first character of [begin, end) that is not a tchar of RFC 9110,
+// or `end` if there is none. Uses AVX2 or SSSE3 on x86-64, depending on the
+// CPU the code runs on.
+const char* FindNonTokenChar(const char* begin, const char* end) noexcept;
+
+// Scalar counterpart of FindNonTokenChar, for tests and benchmarks
+const char* FindNonTokenCharScalar(const char* begin, const char* end) noexcept;
+
+}  // namespace impl
+
+/// HTTP/1.x request parser, an alternative to the llhttp-based
+/// HttpRequestParser that produces the same requests. Instead of per-token
+/// callbacks it handles the request head line by line, finding the line ends
+/// and validating the characters in a single SIMD scan, like picohttpparser.
+/// Header names are scanned for non-token characters with SIMD as well.
+///
+/// Compared to llhttp it is stricter: only the methods of RFC 9110 and PATCH
+/// are accepted and obsolete line folding is rejected. Chunked trailer fields
+/// are skipped.
+class HttpRequestSimdParser final : public request::RequestParser {
+public:
+    using OnNewRequestCb = std::function<void(std::shared_ptr<http::HttpRequest>&&)>;
+
+    HttpRequestSimdParser(
+        const HandlerInfoIndex& handler_info_index,
+        const request::HttpRequestConfig& request_config,
+        OnNewRequestCb&& on_new_request_cb,
+        net::ParserStats& stats,
+        request::ResponseDataAccounter& data_accounter,
+        engine::io::Sockaddr remote_address
+    );
+
+    HttpRequestSimdParser(HttpRequestSimdParser&&) = delete;
+    HttpRequestSimdParser& operator=(HttpRequestSimdParser&&) = delete;
+
+    bool Parse(std::string_view request) override;
+
+private:
+    enum class State {
+        kRequestLine,
+        kHeaders,
+        kBody,
+        kChunkSize,
+        kChunkData,
+        kChunkDataEnd,
+        kTrailers,
+        kUpgraded,
+        kFailed,
+    };
+
+    enum class LineStatus {
+        kComplete,
+        kIncomplete,
+        kInvalid,
+        kTooLong,
+    };
+
+    struct MessageInfo final {
+        HttpMethod method{HttpMethod::kUnknown};
+        unsigned short http_major{0};
+        unsigned short http_minor{0};
+        std::optional<std::size_t> content_length;
+        bool has_transfer_encoding{false};
+        bool is_chunked{false};
+        bool connection_close{false};
+        bool connection_keep_alive{false};
+        bool connection_upgrade{false};
+        bool has_upgrade{false};
+        bool is_websocket_upgrade{false};
+    };
+
+    // On kComplete `line` is the line without CRLF, valid until the next call
+    LineStatus TakeLine(std::string_view& data, std::string_view& line);
+
+    std::size_t GetMaxLineSize() const;
+
+    bool ParseStep(std::string_view& data);
+
+    bool OnRequestLine(std::string_view line);
+    bool OnHeaderLine(std::string_view line);
+    bool OnHeadersComplete();
+    bool OnChunkSizeLine(std::string_view line);
+    bool OnBody(std::string_view& data);
+    bool OnMessageComplete();
+
+    bool IsUpgrade() const;
+    bool ShouldKeepAlive() const;
+
+    void CreateRequestConstructor();
+
+    bool Fail();
+
+    bool FinalizeRequest();
+    bool FinalizeRequestImpl();
+
+    const HandlerInfoIndex& handler_info_index_;
+    const HttpRequestConstructor::Config request_constructor_config_;
+    const std::size_t max_request_line_size_;
+
+    State state_{State::kRequestLine};
+    std::string line_buffer_;
+    MessageInfo message_;
+    std::size_t body_remaining_{0};
+
+    HeadersCountEstimate expected_headers_count_;
+
+    OnNewRequestCb on_new_request_cb_;
+
+    std::optional<HttpRequestConstructor> request_constructor_;
+
+    net::ParserStats& stats_;
+    request::ResponseDataAccounter& data_accounter_;
+    engine::io::Sockaddr remote_address_;
+};
+
+}  // namespace server::http
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,302 @@
+#include <server/http/http_request_simd_parser.hpp>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gmock/gmock.h>
+
+#include <server/http/create_parser_test.hpp>
+#include <userver/utest/utest.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using server::net::Http1ParserType;
+
+struct RequestSummary final {
+    server::http::HttpMethod method{};
+    std::string url;
+    std::string path;
+    std::vector<std::pair<std::string, std::string>> args;
+    std::vector<std::pair<std::string, std::string>> headers;
+    std::string body;
+    int http_major{0};
+    int http_minor{0};
+    bool is_final{false};
+    server::http::HttpStatus status{};
+
+    bool operator==(const RequestSummary& other) const {
+        return std::tie(method, url, path, args, headers, body, http_major, http_minor, is_final, status) ==
+               std::tie(
+                   other.method,
+                   other.url,
+                   other.path,
+                   other.args,
+                   other.headers,
+                   other.body,
+                   other.http_major,
+                   other.http_minor,
+                   other.is_final,
+                   other.status
+               );
+    }
+};
+
+void PrintTo(const RequestSummary& summary, std::ostream* os) {
+    *os << ToString(summary.method) << ' ' << summary.url << " HTTP/" << summary.http_major << '.'
+        << summary.http_minor << ", status=" << static_cast<int>(summary.status) << ", final=" << summary.is_final
+        << ", headers=" << summary.headers.size() << ", body='" << summary.body << '\'';
+}
+
+RequestSummary Summarize(const server::http::HttpRequest& request) {
+    RequestSummary result;
+    result.method = request.GetMethod();
+    result.url = request.GetUrl();
+    result.path = request.GetRequestPath();
+    for (const auto& name : request.ArgNames()) {
+        for (const auto& value : request.GetArgVector(name)) result.args.emplace_back(name, value);
+    }
+    std::sort(result.args.begin(), result.args.end());
+    for (const auto& name : request.GetHeaderNames()) result.headers.emplace_back(name, request.GetHeader(name));
+    std::sort(result.headers.begin(), result.headers.end());
+    result.body = request.RequestBody();
+    result.http_major = request.GetHttpMajor();
+    result.http_minor = request.GetHttpMinor();
+    result.is_final = request.IsFinal();
+    result.status = request.GetHttpResponse().GetStatus();
+    return result;
+}
+
+struct ParseResult final {
+    std::vector<RequestSummary> requests;
+    std::vector<bool> parse_results;
+};
+
+ParseResult ParseInPieces(Http1ParserType parser_type, const std::vector<std::string_view>& pieces) {
+    ParseResult result;
+    auto parser = server::CreateTestParser(
+        [&result](std::shared_ptr<server::http::HttpRequest>&& request) {
+            result.requests.push_back(Summarize(*request));
+        },
+        http::HttpVersion::k11,
+        parser_type
+    );
+    for (const auto piece : pieces) result.parse_results.push_back(parser->Parse(piece));
+    return result;
+}
+
+void ExpectSameAsLlhttp(const std::vector<std::string_view>& pieces) {
+    const auto expected = ParseInPieces(Http1ParserType::kLlhttp, pieces);
+    const auto actual = ParseInPieces(Http1ParserType::kSimd, pieces);
+    EXPECT_EQ(actual.requests, expected.requests);
+    EXPECT_EQ(actual.parse_results, expected.parse_results);
+}
+
+// Keep-alive requests that are handled identically by both parsers
+constexpr std::string_view kCorpus[] = {
+    "GET / HTTP/1.1\r\n\r\n",
+    "GET /foo/bar?query1=value1&query2=value2&query1=value3 HTTP/1.1\r\n\r\n",
+    "GET http://www.example.org/pub/WWW/TheProject.html HTTP/1.1\r\n\r\n",
+    "HEAD /index.html HTTP/1.1\r\nHost: localhost:11235\r\nUser-Agent: curl/7.58.0\r\nAccept: */*\r\n\r\n",
+    "GET / HTTP/1.1\r\nHost:localhost:11235\r\nuser-AGENT: curl/7.58.0\r\nX-Tab: a\tb\r\n\r\n",
+    "GET / HTTP/1.1\r\nHost: *\"@!%\r\nUser-Agent: [-]{~},/\r\nX-Utf8: \xd0\xbf\xd1\x80\xd0\xb8\r\n\r\n",
+    "POST /v1/hello HTTP/1.1\r\nHost: localhost:11235\r\nContent-Type: application/json\r\n"
+    "Content-Length: 18\r\n\r\n{\"hello\": \"world\"}",
+    "PUT /chunked HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n4\r\nbody\r\n5;foo=bar\r\n-more\r\n0\r\n\r\n",
+    "DELETE /item/1 HTTP/1.0\r\nConnection: keep-alive\r\n\r\n",
+    "OPTIONS * HTTP/1.1\r\nHost: localhost\r\n\r\n",
+    "PATCH /item/1 HTTP/1.1\r\nContent-Length: 0\r\n\r\n",
+};
+
+// Requests after which the connection is closed
+constexpr std::string_view kFinalCorpus[] = {
+    "GET /final HTTP/1.1\r\nConnection: close\r\n\r\n",
+    "GET /old HTTP/1.0\r\n\r\n",
+};
+
+// Requests that both parsers reject
+constexpr std::string_view kBadCorpus[] = {
+    "GeT / HTTP/1.1\r\n\r\n",
+    "GET  HTTP/1.1\r\n\r\n",
+    "GET / HTTP/1.2\r\n\r\n",
+    "GET / HTTP/1.1\r\nBad Header: value\r\n\r\n",
+    "GET / HTTP/1.1\r\nHost: a\x01" "b\r\n\r\n",
+    "GET / HTTP/1.1\r\nHost: a\rb\r\n\r\n",
+    "POST / HTTP/1.1\r\nContent-Length: 1\r\nContent-Length: 2\r\n\r\nab",
+    "POST / HTTP/1.1\r\nContent-Length: 12a\r\n\r\n",
+    "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\nzz\r\n",
+};
+
+}  // namespace
+
+UTEST(HttpRequestSimdParser, FindControlChar) {
+    std::minstd_rand rng{42};
+    std::uniform_int_distribution<int> length_distribution{0, 100};
+    std::uniform_int_distribution<int> char_distribution{0x20, 0xff};
+    std::uniform_int_distribution<int> control_distribution{0x00, 0x1f};
+
+    for (int i = 0; i < 10000; ++i) {
+        std::string data(length_distribution(rng), '\0');
+        for (auto& c : data) c = static_cast<char>(char_distribution(rng));
+        if (!data.empty() && i % 3 != 0) {
+            data[rng() % data.size()] = static_cast<char>(i % 5 == 0 ? 0x7f : control_distribution(rng));
+        }
+
+        const auto* const begin = data.data();
+        const auto* const end = begin + data.size();
+        EXPECT_EQ(
+            server::http::impl::FindControlChar(begin, end) - begin,
+            server::http::impl::FindControlCharScalar(begin, end) - begin
+        ) << data;
+    }
+}
+
+UTEST(HttpRequestSimdParser, FindControlCharTab) {
+    const std::string data = std::string(40, '\t') + "value\r\n";
+    EXPECT_EQ(server::http::impl::FindControlChar(data.data(), data.data() + data.size()) - data.data(), 45);
+}
+
+UTEST(HttpRequestSimdParser, FindNonTokenChar) {
+    std::minstd_rand rng{42};
+    std::uniform_int_distribution<int> length_distribution{0, 100};
+    std::uniform_int_distribution<int> char_distribution{0x00, 0xff};
+    constexpr std::string_view kTokenChars = "abcXYZ019!#$%&'*+-.^_`|~";
+
+    for (int i = 0; i < 10000; ++i) {
+        std::string data(length_distribution(rng), '\0');
+        for (auto& c : data) c = kTokenChars[rng() % kTokenChars.size()];
+        if (!data.empty() && i % 3 != 0) {
+            data[rng() % data.size()] = static_cast<char>(char_distribution(rng));
+        }
+
+        const auto* const begin = data.data();
+        const auto* const end = begin + data.size();
+        EXPECT_EQ(
+            server::http::impl::FindNonTokenChar(begin, end) - begin,
+            server::http::impl::FindNonTokenCharScalar(begin, end) - begin
+        ) << data;
+    }
+}
+
+UTEST(HttpRequestSimdParser, SameAsLlhttp) {
+    for (const auto request : kCorpus) {
+        ExpectSameAsLlhttp({request});
+    }
+    for (const auto request : kFinalCorpus) {
+        ExpectSameAsLlhttp({request});
+    }
+}
+
+UTEST(HttpRequestSimdParser, SameAsLlhttpSplit) {
+    for (const auto request : kCorpus) {
+        for (std::size_t split_pos = 1; split_pos < request.size(); ++split_pos) {
+            ExpectSameAsLlhttp({request.substr(0, split_pos), request.substr(split_pos)});
+        }
+    }
+}
+
+UTEST(HttpRequestSimdParser, SameAsLlhttpPipelined) {
+    std::string requests;
+    for (const auto request : kCorpus) requests += request;
+    // Nothing may follow a final request
+    requests += kFinalCorpus[0];
+
+    for (std::size_t piece_size = 1; piece_size < 64; ++piece_size) {
+        std::vector<std::string_view> pieces;
+        for (std::size_t pos = 0; pos < requests.size(); pos += piece_size) {
+            pieces.push_back(std::string_view{requests}.substr(pos, piece_size));
+        }
+        const auto actual = ParseInPieces(Http1ParserType::kSimd, pieces);
+        EXPECT_EQ(actual.requests.size(), std::size(kCorpus) + 1);
+        EXPECT_EQ(actual.requests, ParseInPieces(Http1ParserType::kLlhttp, pieces).requests);
+    }
+}
+
+UTEST(HttpRequestSimdParser, BadRequests) {
+    for (const auto request : kBadCorpus) {
+        const auto expected = ParseInPieces(Http1ParserType::kLlhttp, {request});
+        const auto actual = ParseInPieces(Http1ParserType::kSimd, {request});
+        EXPECT_EQ(actual.parse_results, std::vector<bool>{false}) << request;
+        EXPECT_EQ(actual.parse_results, expected.parse_results) << request;
+        ASSERT_EQ(actual.requests.size(), 1) << request;
+        ASSERT_EQ(expected.requests.size(), 1) << request;
+        EXPECT_EQ(actual.requests.front().status, expected.requests.front().status) << request;
+    }
+}
+
+UTEST(HttpRequestSimdParser, LimitsStatus) {
+    const std::string long_url = "GET /" + std::string(70 * 1024, 'a') + " HTTP/1.1\r\n\r\n";
+    const auto actual = ParseInPieces(Http1ParserType::kSimd, {long_url});
+    ASSERT_EQ(actual.requests.size(), 1);
+    EXPECT_EQ(actual.requests.front().status, server::http::HttpStatus::kUriTooLong);
+
+    const auto expected = ParseInPieces(Http1ParserType::kLlhttp, {long_url});
+    EXPECT_EQ(actual.parse_results, expected.parse_results);
+}
+
+UTEST(HttpRequestSimdParser, LongHeaderLineInPieces) {
+    // A header line is not buffered beyond the headers size limit, even
+    // though the request size limit is larger
+    const std::string header_line = "X-Long: " + std::string(128 * 1024, 'a');
+    std::vector<std::string_view> pieces{"GET / HTTP/1.1\r\n"};
+    for (std::size_t pos = 0; pos < header_line.size(); pos += 4096) {
+        pieces.push_back(std::string_view{header_line}.substr(pos, 4096));
+    }
+
+    const auto actual = ParseInPieces(Http1ParserType::kSimd, pieces);
+    ASSERT_EQ(actual.requests.size(), 1);
+    EXPECT_EQ(actual.requests.front().status, server::http::HttpStatus::kRequestHeaderFieldsTooLarge);
+    EXPECT_EQ(std::count(actual.parse_results.begin(), actual.parse_results.end(), true), 17);
+}
+
+UTEST(HttpRequestSimdParser, Upgrade) {
+    constexpr std::string_view kWebSocket =
+        "GET /ws HTTP/1.1\r\nConnection: Upgrade\r\nUpgrade: websocket\r\n\r\n\x81\x85garbage";
+    const auto actual = ParseInPieces(Http1ParserType::kSimd, {kWebSocket});
+    EXPECT_EQ(actual.parse_results, std::vector<bool>{false});
+    ASSERT_EQ(actual.requests.size(), 1);
+    EXPECT_EQ(actual.requests.front().url, "/ws");
+    EXPECT_EQ(actual.parse_results, ParseInPieces(Http1ParserType::kLlhttp, {kWebSocket}).parse_results);
+
+    constexpr std::string_view kHttp2 =
+        "GET / HTTP/1.1\r\nConnection: Upgrade, HTTP2-Settings\r\nUpgrade: h2c\r\n"
+        "HTTP2-Settings: AAMAAABkAAQAAP__\r\n\r\n";
+    EXPECT_EQ(ParseInPieces(Http1ParserType::kSimd, {kHttp2}).parse_results, std::vector<bool>{true});
+}
+
+UTEST(HttpRequestSimdParser, MutatedRequests) {
+    std::string requests;
+    for (const auto request : kCorpus) requests += request;
+
+    std::minstd_rand rng{7};
+    for (int i = 0; i < 2000; ++i) {
+        auto mutated = requests;
+        for (int j = 0; j < 3; ++j) mutated[rng() % mutated.size()] = static_cast<char>(rng() % 256);
+
+        const auto split_pos = rng() % mutated.size();
+        const std::string_view data{mutated};
+        const std::vector<std::string_view> pieces{data.substr(0, split_pos), data.substr(split_pos)};
+        const auto expected = ParseInPieces(Http1ParserType::kLlhttp, pieces);
+        const auto actual = ParseInPieces(Http1ParserType::kSimd, pieces);
+
+        // The parsers may notice an error in different pieces, but must agree
+        // on the parsed requests and on whether the connection has failed
+        EXPECT_EQ(actual.requests, expected.requests) << mutated;
+        const auto has_failed = [](const ParseResult& result) {
+            return std::find(result.parse_results.begin(), result.parse_results.end(), false) !=
+                   result.parse_results.end();
+        };
+        EXPECT_EQ(has_failed(actual), has_failed(expected)) << mutated;
+
+        const auto failed = std::find(actual.parse_results.begin(), actual.parse_results.end(), false);
+        if (failed != actual.parse_results.end()) {
+            EXPECT_TRUE(std::all_of(failed, actual.parse_results.end(), [](bool res) { return !res; }));
+        }
+    }
+}
+
+USERVER_NAMESPACE_END
@@ -1,12 +1,19 @@
 #include <userver/server/http/http_response.hpp>
 
+#include <unistd.h>
+
+#include <algorithm>
 #include <array>
+#include <cerrno>
+#include <system_error>
 
 #include <cctz/time_zone.h>
 #include <fmt/compile.h>
 
+#include <userver/engine/async.hpp>
 #include <userver/engine/deadline.hpp>
 #include <userver/engine/io/socket.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
 #include <userver/hostinfo/blocking/get_hostname.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/http/content_type.hpp>
@@ -88,6 +95,29 @@ void AppendToCharArray(char*& data, const std::string_view what) {
 
 const std::string kEmptyString{};
 
+constexpr std::size_t kFileBodyChunkSize = 64 * 1024;
+
+// Returns less than `len` only if the file is shorter than expected
+std::size_t ReadFileRange(int fd, std::size_t offset, char* buffer, std::size_t len) {
+    std::size_t read_bytes = 0;
+    while (read_bytes < len) {
+        const auto ret = ::pread(fd, buffer + read_bytes, len - read_bytes, static_cast<off_t>(offset + read_bytes));
+        if (ret == 0) break;
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            throw std::system_error(errno, std::system_category(), "Error while reading the response body file");
+        }
+        read_bytes += ret;
+    }
+    return read_bytes;
+}
+
+void CheckFileBodySent(std::size_t sent, std::size_t expected) {
+    if (sent != expected) {
+        throw std::runtime_error(fmt::format("Sent {} of {} bytes of the response body file", sent, expected));
+    }
+}
+
 }  // namespace
 
 namespace server::http {
@@ -112,6 +142,22 @@ void OutputHeader(USERVER_NAMESPACE::http::headers::HeadersString& header, std::
 
 }  // namespace impl
 
+struct HttpResponse::FileBody {
+    fs::blocking::FileDescriptor file;
+    std::size_t offset;
+    std::size_t size;
+    engine::TaskProcessor& fs_task_processor;
+
+    // The disk reads may block, so they are not done on the worker
+    std::string ReadChunk(std::size_t pos, std::size_t chunk_size) const {
+        return engine::AsyncNoSpan(fs_task_processor, [this, pos, chunk_size] {
+                   std::string chunk(chunk_size, '\0');
+                   chunk.resize(ReadFileRange(file.GetNative(), offset + pos, chunk.data(), chunk.size()));
+                   return chunk;
+               }).Get();
+    }
+};
+
 HttpResponse::HttpResponse(const HttpRequest& request, request::ResponseDataAccounter& data_accounter)
     : HttpResponse{request, data_accounter, std::chrono::steady_clock::now(), utils::StrCaseHash{}} {}
 
@@ -235,6 +281,57 @@ void HttpResponse::SetHeadersEnd() { headers_end_.Send(); }
 
 bool HttpResponse::WaitForHeadersEnd() { return headers_end_.WaitForEvent(); }
 
+void HttpResponse::SetFileBody(
+    fs::blocking::FileDescriptor file,
+    std::size_t offset,
+    std::size_t size,
+    engine::TaskProcessor& fs_task_processor
+) {
+    UINVARIANT(file.IsOpen(), "File body must be an open file");
+    file_body_ = std::make_unique<FileBody>(FileBody{std::move(file), offset, size, fs_task_processor});
+}
+
+std::size_t HttpResponse::SendFileBody(engine::io::RwBase& socket) const {
+    UASSERT(file_body_);
+    const auto& body = *file_body_;
+
+    if (auto* tcp_socket = dynamic_cast<engine::io::Socket*>(&socket)) {
+        // sendfile(2) reads the file and may block on the page cache misses,
+        // the socket waits are asynchronous on any task processor
+        const auto sent = engine::AsyncNoSpan(body.fs_task_processor, [&body, tcp_socket] {
+                              return tcp_socket->SendFile(body.file.GetNative(), body.offset, body.size, {});
+                          }).Get();
+        CheckFileBodySent(sent, body.size);
+        return sent;
+    }
+
+    // e.g. TLS, the data has to pass through the user space anyway
+    std::size_t sent = 0;
+    while (sent < body.size) {
+        const auto chunk_size = std::min(body.size - sent, kFileBodyChunkSize);
+        const auto chunk = body.ReadChunk(sent, chunk_size);
+        CheckFileBodySent(sent + chunk.size(), sent + chunk_size);
+        sent += socket.WriteAll(chunk.data(), chunk.size(), engine::Deadline{});
+    }
+    return sent;
+}
+
+std::size_t HttpResponse::GetFileBodySize() const {
+    UASSERT(file_body_);
+    return file_body_->size;
+}
+
+std::function<std::string()> HttpResponse::ExtractFileBodyReader() {
+    UASSERT(file_body_);
+    return [body = std::shared_ptr<const FileBody>{std::move(file_body_)}, pos = std::size_t{0}]() mutable {
+        const auto chunk_size = std::min(body->size - pos, kFileBodyChunkSize);
+        auto chunk = body->ReadChunk(pos, chunk_size);
+        CheckFileBodySent(pos + chunk.size(), pos + chunk_size);
+        pos += chunk.size();
+        return chunk;
+    };
+}
+
 void HttpResponse::SendResponse(engine::io::RwBase& socket) {
     utils::SmallString<USERVER_NAMESPACE::http::headers::kTypicalHeadersSize> header;
 
@@ -304,21 +401,26 @@ HttpResponse::SetBodyNotStreamed(engine::io::RwBase& socket, USERVER_NAMESPACE::
     const bool is_body_forbidden = IsBodyForbiddenForStatus(status_);
     const bool is_head_request = request_.GetMethod() == HttpMethod::kHead;
     const auto& data = GetData();
+    const bool is_file_body = file_body_ && data.empty();
+    const auto body_size = is_file_body ? file_body_->size : data.size();
 
     if (!is_body_forbidden) {
         impl::OutputHeader(
-            header, USERVER_NAMESPACE::http::headers::kContentLength, fmt::format(FMT_COMPILE("{}"), data.size())
+            header, USERVER_NAMESPACE::http::headers::kContentLength, fmt::format(FMT_COMPILE("{}"), body_size)
         );
     }
     header.append(kCrlf);
 
-    if (is_body_forbidden && !data.empty()) {
+    if (is_body_forbidden && body_size != 0) {
         LOG_LIMITED_WARNING() << "Non-empty body provided for response with HTTP code " << static_cast<int>(status_)
                               << " which does not allow one, it will be dropped";
     }
 
     ssize_t sent_bytes = 0;
-    if (!is_head_request && !is_body_forbidden) {
+    if (!is_head_request && !is_body_forbidden && is_file_body) {
+        sent_bytes = socket.WriteAll(header.data(), header.size(), engine::Deadline{});
+        sent_bytes += SendFileBody(socket);
+    } else if (!is_head_request && !is_body_forbidden) {
         sent_bytes = socket.WriteAll({{header.data(), header.size()}, {data.data(), data.size()}}, engine::Deadline{});
     } else {
         sent_bytes = socket.WriteAll(header.data(), header.size(), engine::Deadline{});
@@ -356,10 +458,16 @@ HttpResponse::SetBodyStreamed(engine::io::RwBase& socket, USERVER_NAMESPACE::htt
             continue;
         }
 
-        auto size = first_chunk_processed ? fmt::format("\r\n{:x}\r\n", body_part.size())
-                                          : fmt::format("{:x}\r\n", body_part.size());
-        sent_bytes +=
-            socket.WriteAll({{size.data(), size.size()}, {body_part.data(), body_part.size()}}, engine::Deadline{});
+        // Enough for "\r\n{:x}\r\n" of any size_t
+        std::array<char, 2 + sizeof(std::size_t) * 2 + 2> size_buffer{};
+        const auto* const size_end =
+            first_chunk_processed ? fmt::format_to(size_buffer.data(), FMT_COMPILE("\r\n{:x}\r\n"), body_part.size())
+                                  : fmt::format_to(size_buffer.data(), FMT_COMPILE("{:x}\r\n"), body_part.size());
+        sent_bytes += socket.WriteAll(
+            {{size_buffer.data(), static_cast<std::size_t>(size_end - size_buffer.data())},
+             {body_part.data(), body_part.size()}},
+            engine::Deadline{}
+        );
 
         first_chunk_processed = true;
     }
@@ -5,11 +5,16 @@
 #include <gmock/gmock.h>
 
 #include <userver/engine/async.hpp>
+#include <userver/engine/task/current_task.hpp>
+#include <userver/fs/blocking/file_descriptor.hpp>
+#include <userver/fs/blocking/temp_file.hpp>
+#include <userver/fs/blocking/write.hpp>
 #include <userver/http/common_headers.hpp>
 #include <userver/internal/net/net_listener.hpp>
 #include <userver/server/http/http_request_builder.hpp>
 #include <userver/server/http/http_response.hpp>
 #include <userver/utest/utest.hpp>
+#include <userver/utils/text_light.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -41,6 +46,66 @@ UTEST(HttpResponse, Smoke) {
     EXPECT_EQ(reply.substr(reply.size() - 4 - kBody.size()), fmt::format("\r\n\r\n{}", kBody));
 }
 
+UTEST(HttpResponse, SharedData) {
+    const auto test_deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    server::request::ResponseDataAccounter accounter;
+    auto request = server::http::HttpRequestBuilder{accounter}.Build();
+    server::http::HttpResponse response{*request, accounter};
+
+    const auto body = std::make_shared<const std::string>(64 * 1024, 'a');
+    response.SetSharedData(body);
+    response.SetStatus(server::http::HttpStatus::kOk);
+    EXPECT_EQ(response.GetData().data(), body->data());
+
+    auto [server, client] = internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+    auto send_task = engine::AsyncNoSpan(
+        [](auto&& response, auto&& socket) { response.SendResponse(socket); }, std::ref(response), std::move(server)
+    );
+
+    std::string buffer(body->size() + 4096, '\0');
+    const auto reply_size = client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+    buffer.resize(reply_size);
+
+    EXPECT_THAT(buffer, testing::HasSubstr(fmt::format("\r\n{}: {}\r\n", http::headers::kContentLength, body->size())));
+    EXPECT_TRUE(utils::text::EndsWith(buffer, fmt::format("\r\n\r\n{}", *body)));
+    // The body is still shared after it has been sent
+    EXPECT_EQ(body.use_count(), 2);
+}
+
+UTEST(HttpResponse, FileBody) {
+    const auto test_deadline = engine::Deadline::FromDuration(utest::kMaxTestWaitTime);
+
+    const auto file = fs::blocking::TempFile::Create();
+    const std::string contents(256 * 1024, 'f');
+    fs::blocking::RewriteFileContents(file.GetPath(), "skip" + contents + "skip");
+
+    server::request::ResponseDataAccounter accounter;
+    auto request = server::http::HttpRequestBuilder{accounter}.Build();
+    server::http::HttpResponse response{*request, accounter};
+    response.SetFileBody(
+        fs::blocking::FileDescriptor::Open(file.GetPath(), fs::blocking::OpenFlag::kRead),
+        4,
+        contents.size(),
+        engine::current_task::GetTaskProcessor()
+    );
+    response.SetStatus(server::http::HttpStatus::kPartialContent);
+
+    auto [server, client] = internal::net::TcpListener{}.MakeSocketPair(test_deadline);
+    auto send_task = engine::AsyncNoSpan(
+        [](auto&& response, auto&& socket) { response.SendResponse(socket); }, std::ref(response), std::move(server)
+    );
+
+    std::string buffer(contents.size() + 4096, '\0');
+    const auto reply_size = client.RecvAll(buffer.data(), buffer.size(), test_deadline);
+    buffer.resize(reply_size);
+
+    EXPECT_THAT(
+        buffer, testing::HasSubstr(fmt::format("\r\n{}: {}\r\n", http::headers::kContentLength, contents.size()))
+    );
+    EXPECT_TRUE(utils::text::EndsWith(buffer, fmt::format("\r\n\r\n{}", contents)));
+}
+
 UTEST(HttpResponse, AccounterLifetimeIfNotSent) {
     auto accounter = std::make_unique<server::request::ResponseDataAccounter>();
     const auto request = server::http::HttpRequestBuilder{*accounter}.Build();
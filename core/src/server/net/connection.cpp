@@ -7,6 +7,7 @@
 #include <server/http/http2_session.hpp>
 #include <server/http/http2_writer.hpp>
 #include <server/http/http_request_parser.hpp>
+#include <server/http/http_request_simd_parser.hpp>
 #include <server/http/request_handler_base.hpp>
 #include <server/net/listener_config.hpp>
 
@@ -387,6 +388,16 @@ std::unique_ptr<request::RequestParser> Connection::MakeParser(USERVER_NAMESPACE
             peer_socket_.get()
         );
     }
+    if (config_.http1_parser == Http1ParserType::kSimd) {
+        return std::make_unique<http::HttpRequestSimdParser>(
+            request_handler_.GetHandlerInfoIndex(),
+            handler_defaults_config_,
+            on_req_cb,
+            stats_->parser_stats,
+            data_accounter_,
+            remote_address_
+        );
+    }
     return std::make_unique<http::HttpRequestParser>(
         request_handler_.GetHandlerInfoIndex(),
         handler_defaults_config_,
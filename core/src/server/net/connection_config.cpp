@@ -1,11 +1,19 @@
 #include <server/net/connection_config.hpp>
 
+#include <userver/utils/trivial_map.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace server::net {
 
+Http1ParserType Parse(const yaml_config::YamlConfig& value, formats::parse::To<Http1ParserType>) {
+    static constexpr utils::TrivialBiMap kMap([](auto selector) {
+        return selector().Case(Http1ParserType::kLlhttp, "llhttp").Case(Http1ParserType::kSimd, "simd");
+    });
+    return utils::ParseFromValueString(value, kMap);
+}
+
 Http2SessionConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<Http2SessionConfig>) {
     Http2SessionConfig conf{};
     conf.max_concurrent_streams = value["max_concurrent_streams"].As<std::uint32_t>(conf.max_concurrent_streams);
@@ -27,6 +35,7 @@ ConnectionConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<
     }
 
     config.http_version = value["http-version"].As<USERVER_NAMESPACE::http::HttpVersion>(config.http_version);
+    config.http1_parser = value["http1-parser"].As<Http1ParserType>(config.http1_parser);
 
     config.http2_session_config = value["http2-session"].As<Http2SessionConfig>(config.http2_session_config);
 
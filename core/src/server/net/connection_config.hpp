@@ -24,12 +24,20 @@ struct Http2SessionConfig final {
     std::uint32_t initial_window_size = 1 << 16;
 };
 
+enum class Http1ParserType {
+    kLlhttp,
+    kSimd,
+};
+
+Http1ParserType Parse(const yaml_config::YamlConfig& value, formats::parse::To<Http1ParserType>);
+
 struct ConnectionConfig {
     size_t in_buffer_size = 32 * 1024;
     size_t requests_queue_size_threshold = 100;
     std::chrono::seconds keepalive_timeout{10 * 60};
     std::chrono::milliseconds abort_check_delay{kDefaultAbortCheckDelay};
     USERVER_NAMESPACE::http::HttpVersion http_version = USERVER_NAMESPACE::http::HttpVersion::k11;
+    Http1ParserType http1_parser = Http1ParserType::kLlhttp;
     Http2SessionConfig http2_session_config;
 };
 
@@ -73,9 +73,28 @@ ResponseBase::~ResponseBase() noexcept {
 void ResponseBase::SetData(std::string data) {
     create_time_ = std::chrono::steady_clock::now();
     data_ = std::move(data);
+    shared_data_.reset();
     guard_.emplace(accounter_, create_time_, data_.size());
 }
 
+void ResponseBase::SetSharedData(std::shared_ptr<const std::string> data) {
+    UINVARIANT(data, "Shared response body must not be null");
+    create_time_ = std::chrono::steady_clock::now();
+    data_.clear();
+    shared_data_ = std::move(data);
+    guard_.emplace(accounter_, create_time_, shared_data_->size());
+}
+
+std::string&& ResponseBase::ExtractData() {
+    if (shared_data_) {
+        data_ = *shared_data_;
+        shared_data_.reset();
+    }
+    return std::move(data_);
+}
+
+std::shared_ptr<const std::string> ResponseBase::ExtractSharedData() noexcept { return std::move(shared_data_); }
+
 void ResponseBase::SetReady() { SetReady(std::chrono::steady_clock::now()); }
 
 void ResponseBase::SetReady(std::chrono::steady_clock::time_point now) {
@@ -302,7 +302,7 @@ void ServerImpl::WriteTotalHandlerStatistics(utils::statistics::Writer& writer)
         }
     }
 
-    writer = total;
+    writer = handlers::HttpHandlerStatisticsView{total, config_.handler_timings_metrics};
 }
 
 void ServerImpl::SetRpsRatelimitStatusCode(http::HttpStatus status_code) {
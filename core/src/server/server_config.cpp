@@ -17,6 +17,8 @@ ServerConfig Parse(const yaml_config::YamlConfig& value, formats::parse::To<Serv
     config.max_response_size_in_flight = value["max_response_size_in_flight"].As<std::optional<size_t>>();
     config.server_name = value["server-name"].As<std::string>(utils::GetUserverIdentifier());
     config.set_response_server_hostname = value["set-response-server-hostname"].As<bool>(false);
+    config.handler_timings_metrics.percentiles_us = value["handler-timings-us"].As<bool>(false);
+    config.handler_timings_metrics.histogram = value["handler-timings-histogram"].As<bool>(false);
     config.middleware_pipeline_builder =
         value["middleware-pipeline-builder"].As<std::string>(middlewares::PipelineBuilder::kName);
 
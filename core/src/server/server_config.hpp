@@ -3,6 +3,7 @@
 #include <optional>
 #include <string>
 
+#include <userver/utils/statistics/log_linear_histogram.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
 
 #include <server/net/listener_config.hpp>
@@ -19,6 +20,7 @@ struct ServerConfig {
     std::optional<size_t> max_response_size_in_flight;
     std::string server_name;
     bool set_response_server_hostname{false};
+    utils::statistics::TimingsMetrics handler_timings_metrics;
     std::string middleware_pipeline_builder;
 };
 
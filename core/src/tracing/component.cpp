@@ -5,6 +5,8 @@
 #include <userver/tracing/tracer.hpp>
 #include <userver/yaml_config/merge_schemas.hpp>
 
+#include <tracing/tail_sampling.hpp>
+
 USERVER_NAMESPACE_BEGIN
 
 namespace components {
@@ -35,6 +37,7 @@ Tracer::Tracer(const ComponentConfig& config, const ComponentContext& context) {
         tracing::Tracer::SetTracer(
             tracing::MakeTracer(std::move(service_name), std::move(opentracing_logger), tracer_type)
         );
+        tracing::Tracer::SetTailSampling(config["tail-sampling"].As<tracing::TailSampling>({}));
     } else {
         throw std::runtime_error("Tracer type is not supported: " + tracer_type);
     }
@@ -54,6 +57,36 @@ properties:
         type: string
         description: type of the tracer to trace, currently supported only 'native'
         defaultDescription: 'native'
+    tail-sampling:
+        type: object
+        description: |
+            keep the finished spans of each trace in memory and log them only
+            if the trace is sampled when its root span finishes
+        additionalProperties: false
+        properties:
+            enabled:
+                type: boolean
+                description: enable the tail-based sampling of the traces
+                defaultDescription: false
+            latency-threshold:
+                type: string
+                description: |
+                    utils::StringToDuration suitable duration string, traces
+                    with the root span that took longer are always logged
+                defaultDescription: 1s
+            probability:
+                type: number
+                description: probability to log a trace that is neither failed nor slow
+                defaultDescription: 0
+                minimum: 0
+                maximum: 1
+            max-buffer-size:
+                type: integer
+                description: |
+                    the finished spans of a pending trace that do not fit into
+                    this many bytes are dropped
+                defaultDescription: 65536
+                minimum: 1
 )");
 }
 
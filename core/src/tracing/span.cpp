@@ -1,16 +1,19 @@
 #include <tracing/span_impl.hpp>
 
 #include <type_traits>
+#include <variant>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
 #include <engine/task/task_context.hpp>
 #include <logging/log_helper_impl.hpp>
+#include <tracing/tail_sampling.hpp>
 #include <userver/engine/task/local_variable.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/hex.hpp>
@@ -34,6 +37,8 @@ constexpr std::string_view kReferenceType = "span_ref_type";
 constexpr std::string_view kReferenceTypeChild = "child";
 constexpr std::string_view kReferenceTypeFollows = "follows";
 
+constexpr std::string_view kTailSamplingDroppedSpansTag = "tail_sampling_dropped_spans";
+
 struct TsBuffer final {
     // digits + dot + fract + (to be sure)
     char data[32]{};
@@ -56,6 +61,24 @@ TsBuffer StartTsToString(std::chrono::system_clock::time_point start) {
     return buffer;
 }
 
+void PutStopwatchTags(
+    logging::impl::TagWriter& writer,
+    std::string_view name,
+    std::chrono::steady_clock::duration duration,
+    ReferenceType reference_type,
+    std::chrono::system_clock::time_point start_system_time
+) {
+    const auto total_time_ms = std::chrono::duration_cast<RealMilliseconds>(duration).count();
+    const auto timestamp_buffer = StartTsToString(start_system_time);
+    const auto ref_type = reference_type == ReferenceType::kChild ? kReferenceTypeChild : kReferenceTypeFollows;
+
+    writer.PutTag(kStopWatchTag, name);
+    writer.PutTag(kTotalTimeTag, total_time_ms);
+    writer.PutTag(kReferenceType, ref_type);
+    writer.PutTag(kTimeUnitsTag, "ms");
+    writer.PutTag(kStartTimestampTag, timestamp_buffer.ToStringView());
+}
+
 // Maintain coro-local span stack to identify "current span" in O(1).
 engine::TaskLocalVariable<SpanStack> task_local_spans;
 
@@ -67,6 +90,19 @@ std::string GenerateSpanId() {
     return utils::encoding::ToHex(&random_value, 8);
 }
 
+bool IsErrorFlagSet(const logging::LogExtra::Value& value) {
+    return std::visit(
+        [](const auto& flag) {
+            if constexpr (std::is_arithmetic_v<std::decay_t<decltype(flag)>>) {
+                return flag != 0;
+            } else {
+                return false;
+            }
+        },
+        value
+    );
+}
+
 }  // namespace
 
 Span::Impl::Impl(
@@ -106,35 +142,127 @@ Span::Impl::Impl(
     if (parent) {
         log_extra_inheritable_ = parent->log_extra_inheritable_;
         local_log_level_ = parent->local_log_level_;
+        tail_sampling_trace_ = parent->tail_sampling_trace_;
+    } else {
+        tail_sampling_trace_ = impl::MakeTailSamplingTrace(start_steady_time_);
+        is_tail_sampling_root_ = tail_sampling_trace_ != nullptr;
     }
 }
 
 Span::Impl::~Impl() {
+    if (tail_sampling_trace_ && !TailSample()) {
+        return;
+    }
+
     if (!ShouldLog()) {
         return;
     }
 
-    {
-        const impl::DetachLocalSpansScope ignore_local_span;
-        logging::LogHelper lh{logging::GetDefaultLogger(), log_level_, source_location_};
-        lh.MarkAsTrace(logging::LogHelper::InternalTag{});
-        std::move(*this).PutIntoLogger(lh.GetTagWriterAfterText({}));
+    std::move(*this).LogToDefaultLogger();
+}
+
+void Span::Impl::LogToDefaultLogger() && {
+    const impl::DetachLocalSpansScope ignore_local_span;
+    logging::LogHelper lh{logging::GetDefaultLogger(), log_level_, source_location_};
+    lh.MarkAsTrace(logging::LogHelper::InternalTag{});
+    std::move(*this).PutIntoLogger(lh.GetTagWriterAfterText({}));
+}
+
+bool Span::Impl::HasErrorTag() const {
+    if (IsErrorFlagSet(log_extra_inheritable_.GetValue(kErrorFlag))) return true;
+    return log_extra_local_ && IsErrorFlagSet(log_extra_local_->GetValue(kErrorFlag));
+}
+
+bool Span::Impl::TailSample() {
+    finish_steady_time_ = std::chrono::steady_clock::now();
+
+    if (!is_tail_sampling_root_) {
+        // Unloggable spans are not buffered at all
+        if (!ShouldLog()) return false;
+
+        auto decision = tail_sampling_trace_->TryDecide(HasErrorTag(), *finish_steady_time_);
+        if (!decision) {
+            // The record is built outside of the trace lock. If the decision
+            // is made meanwhile, the span is logged as usual.
+            impl::SpanRecordBuilder builder;
+            FillRecord(builder);
+            decision = tail_sampling_trace_->Buffer(builder);
+            if (!decision) return false;
+        }
+
+        LogRecords(decision->spans.GetFirst());
+        return decision->keep;
+    }
+
+    auto decision = tail_sampling_trace_->Decide(*finish_steady_time_, HasErrorTag());
+    if (!decision.keep) return false;
+
+    LogRecords(decision.spans.GetFirst());
+    if (decision.dropped_spans != 0) {
+        if (!log_extra_local_) log_extra_local_.emplace();
+        log_extra_local_->Extend(std::string{kTailSamplingDroppedSpansTag}, decision.dropped_spans);
+    }
+    return true;
+}
+
+void Span::Impl::FillRecord(impl::SpanRecordBuilder& builder) {
+    // The local tags are merged the same way PutIntoLogger does it, so the span
+    // may still be logged directly afterwards
+    auto& record = builder.record;
+    record.log_level = log_level_;
+    record.reference_type = reference_type_;
+    record.source_location = source_location_;
+    record.start_system_time = start_system_time_;
+    record.duration = finish_steady_time_.value_or(std::chrono::steady_clock::now()) - start_steady_time_;
+
+    builder.name = builder.AddString(name_);
+    builder.trace_id = builder.AddString(trace_id_);
+    builder.span_id = builder.AddString(span_id_);
+    builder.parent_id = builder.AddString(parent_id_);
+
+    if (tracer_ && tracer_->GetOptionalLogger()) {
+        formats::json::StringBuilder tags;
+        BuildOpentracingTags(tags);
+        builder.opentracing_tags = builder.AddString(tags.GetStringView());
+    }
+
+    time_storage_.ForEachTag([&builder](std::string_view key, std::string_view value) { builder.AddTag(key, value); });
+
+    if (log_extra_local_) {
+        log_extra_inheritable_.Extend(std::move(*log_extra_local_));
+        log_extra_local_.reset();
+    }
+    for (const auto& [key, value] : *log_extra_inheritable_.extra_) {
+        std::visit([&builder, &key = key](const auto& tag) { builder.AddTag(key, tag); }, value.GetValue());
+    }
+}
+
+void Span::Impl::LogRecords(const impl::SpanRecord* records) const {
+    for (const auto* record = records; record; record = record->next) {
+        {
+            const impl::DetachLocalSpansScope ignore_local_span;
+            logging::LogHelper lh{logging::GetDefaultLogger(), record->log_level, record->source_location};
+            lh.MarkAsTrace(logging::LogHelper::InternalTag{});
+            auto writer = lh.GetTagWriterAfterText({});
+
+            impl::LogSpanContextTo(record->trace_id, record->span_id, record->parent_id, writer);
+            PutStopwatchTags(writer, record->name, record->duration, record->reference_type, record->start_system_time);
+            for (const auto& tag : record->tags) {
+                writer.PutTag(tag);
+            }
+        }
+
+        if (!record->opentracing_tags.empty()) {
+            LogOpenTracingRecord(*record);
+        }
     }
 }
 
 void Span::Impl::PutIntoLogger(logging::impl::TagWriter writer) && {
-    const auto steady_now = std::chrono::steady_clock::now();
-    const auto duration = steady_now - start_steady_time_;
-    const auto total_time_ms = std::chrono::duration_cast<RealMilliseconds>(duration).count();
-    const auto timestamp_buffer = StartTsToString(start_system_time_);
-    const auto ref_type = GetReferenceType() == ReferenceType::kChild ? kReferenceTypeChild : kReferenceTypeFollows;
+    const auto steady_now = finish_steady_time_.value_or(std::chrono::steady_clock::now());
 
     tracer_->LogSpanContextTo(*this, writer);
-    writer.PutTag(kStopWatchTag, name_);
-    writer.PutTag(kTotalTimeTag, total_time_ms);
-    writer.PutTag(kReferenceType, ref_type);
-    writer.PutTag(kTimeUnitsTag, "ms");
-    writer.PutTag(kStartTimestampTag, timestamp_buffer.ToStringView());
+    PutStopwatchTags(writer, name_, steady_now - start_steady_time_, GetReferenceType(), start_system_time_);
 
     time_storage_.MergeInto(writer);
 
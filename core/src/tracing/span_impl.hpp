@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <list>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -27,6 +28,22 @@ namespace tracing {
 inline const std::string kLinkTag = "link";
 inline const std::string kParentLinkTag = "parent_link";
 
+namespace impl {
+
+class TailSamplingTrace;
+struct SpanRecord;
+class SpanRecordBuilder;
+
+// The span context tags as NoopTracer writes them
+void LogSpanContextTo(
+    std::string_view trace_id,
+    std::string_view span_id,
+    std::string_view parent_id,
+    logging::impl::TagWriter writer
+);
+
+}  // namespace impl
+
 class Span::Impl : public boost::intrusive::list_base_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>> {
 public:
     explicit Impl(
@@ -55,6 +72,9 @@ public:
     // Log this Span specifically
     void PutIntoLogger(logging::impl::TagWriter writer) &&;
 
+    // Log this Span into the default logger, ShouldLog() is not checked
+    void LogToDefaultLogger() &&;
+
     // Add the context of this Span a non-Span-specific log record
     void LogTo(logging::impl::TagWriter writer);
 
@@ -78,11 +98,23 @@ public:
 private:
     void LogOpenTracing() const;
     void DoLogOpenTracing(logging::impl::TagWriter writer) const;
+    void BuildOpentracingTags(formats::json::StringBuilder& output) const;
+    // Logs a buffered span of the trace with the tracer of this span
+    void LogOpenTracingRecord(const impl::SpanRecord& record) const;
     static void AddOpentracingTags(formats::json::StringBuilder& output, const logging::LogExtra& input);
 
     static std::string GetParentIdForLogging(const Span::Impl* parent);
     bool ShouldLog() const;
 
+    bool HasErrorTag() const;
+
+    // Returns true if the finished span should be logged right away
+    bool TailSample();
+    // Copies the finished span into a compact record to buffer
+    void FillRecord(impl::SpanRecordBuilder& builder);
+    // Logs the buffered spans of the trace that has been kept
+    void LogRecords(const impl::SpanRecord* records) const;
+
     const std::string name_;
     const bool is_no_log_span_;
     logging::Level log_level_;
@@ -98,6 +130,12 @@ private:
 
     const std::chrono::system_clock::time_point start_system_time_;
     const std::chrono::steady_clock::time_point start_steady_time_;
+    std::optional<std::chrono::steady_clock::time_point> finish_steady_time_;
+
+    // Set if the spans of the trace are buffered until the root span decides
+    // whether to log them, see tracing::TailSampling
+    std::shared_ptr<impl::TailSamplingTrace> tail_sampling_trace_;
+    bool is_tail_sampling_root_{false};
 
     std::string trace_id_;
     std::string span_id_;
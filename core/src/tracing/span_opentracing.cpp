@@ -9,6 +9,7 @@
 #include <userver/utils/trivial_map.hpp>
 
 #include <logging/log_helper_impl.hpp>
+#include <tracing/tail_sampling.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -113,16 +114,47 @@ void Span::Impl::DoLogOpenTracing(logging::impl::TagWriter writer) const {
     writer.PutTag(jaeger::kOperationName, name_);
 
     formats::json::StringBuilder tags;
-    {
-        const formats::json::StringBuilder::ArrayGuard guard(tags);
-        AddOpentracingTags(tags, log_extra_inheritable_);
-        if (log_extra_local_) {
-            AddOpentracingTags(tags, *log_extra_local_);
-        }
-    }
+    BuildOpentracingTags(tags);
     writer.PutTag("tags", tags.GetStringView());
 }
 
+void Span::Impl::BuildOpentracingTags(formats::json::StringBuilder& output) const {
+    const formats::json::StringBuilder::ArrayGuard guard(output);
+    AddOpentracingTags(output, log_extra_inheritable_);
+    if (log_extra_local_) {
+        AddOpentracingTags(output, *log_extra_local_);
+    }
+}
+
+void Span::Impl::LogOpenTracingRecord(const impl::SpanRecord& record) const {
+    if (!tracer_) {
+        return;
+    }
+
+    auto logger = tracer_->GetOptionalLogger();
+    if (!logger) {
+        return;
+    }
+
+    const impl::DetachLocalSpansScope ignore_local_span;
+    logging::LogHelper lh(*logger, record.log_level);
+    auto writer = lh.GetTagWriterAfterText({});
+
+    const auto duration_microseconds = std::chrono::duration_cast<std::chrono::microseconds>(record.duration).count();
+    const auto start_time =
+        std::chrono::duration_cast<std::chrono::microseconds>(record.start_system_time.time_since_epoch()).count();
+
+    writer.PutTag(jaeger::kServiceName, tracer_->GetServiceName());
+    writer.PutTag(jaeger::kTraceId, record.trace_id);
+    writer.PutTag(jaeger::kParentId, record.parent_id);
+    writer.PutTag(jaeger::kSpanId, record.span_id);
+    writer.PutTag(jaeger::kStartTime, start_time);
+    writer.PutTag(jaeger::kStartTimeMillis, start_time / 1000);
+    writer.PutTag(jaeger::kDuration, duration_microseconds);
+    writer.PutTag(jaeger::kOperationName, record.name);
+    writer.PutTag("tags", record.opentracing_tags);
+}
+
 void Span::Impl::AddOpentracingTags(formats::json::StringBuilder& output, const logging::LogExtra& input) {
     for (const auto& [key, value] : *input.extra_) {
         const auto tag_it = jaeger::kGetOpentracingTags.TryFind(key);
@@ -4,11 +4,15 @@
 #include <logging/log_helper_impl.hpp>
 #include <logging/logging_test.hpp>
 #include <tracing/no_log_spans.hpp>
+#include <tracing/tail_sampling.hpp>
 #include <userver/engine/sleep.hpp>
 #include <userver/formats/json/serialize.hpp>
+#include <userver/tracing/scope_time.hpp>
 #include <userver/tracing/span.hpp>
+#include <userver/tracing/tags.hpp>
 #include <userver/tracing/tracer.hpp>
 #include <userver/utest/utest.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/regex.hpp>
 #include <userver/utils/text_light.hpp>
 
@@ -688,4 +692,149 @@ UTEST_F(Span, MakeSpanWithParentIdTraceIdLinkWithExisting) {
     }
 }
 
+class TailSamplingSpan : public Span {
+protected:
+    static void SetTailSampling(
+        std::chrono::milliseconds latency_threshold,
+        double probability,
+        std::size_t max_buffer_size = 64 * 1024
+    ) {
+        tracing::TailSampling settings;
+        settings.enabled = true;
+        settings.latency_threshold = latency_threshold;
+        settings.probability = probability;
+        settings.max_buffer_size = max_buffer_size;
+        tracing::Tracer::SetTailSampling(std::move(settings));
+    }
+
+    ~TailSamplingSpan() override { tracing::Tracer::SetTailSampling(tracing::TailSampling{}); }
+
+    std::size_t CountInLogs(std::string_view span_name) {
+        logging::LogFlush();
+        const auto logs = GetStreamString();
+        const auto tag = fmt::format("stopwatch_name={}\t", span_name);
+
+        std::size_t count = 0;
+        for (auto pos = logs.find(tag); pos != std::string::npos; pos = logs.find(tag, pos + 1)) {
+            ++count;
+        }
+        return count;
+    }
+};
+
+UTEST_F(TailSamplingSpan, DropsFastTraces) {
+    SetTailSampling(std::chrono::hours{1}, 0.0);
+    {
+        auto root = tracing::Span::MakeRootSpan("tail_root");
+        { const tracing::Span child("tail_child"); }
+        utils::Async("tail_async_child", [] {}).Get();
+    }
+
+    EXPECT_EQ(CountInLogs("tail_root"), 0);
+    EXPECT_EQ(CountInLogs("tail_child"), 0);
+    EXPECT_EQ(CountInLogs("tail_async_child"), 0);
+}
+
+UTEST_F(TailSamplingSpan, KeepsFailedTraces) {
+    SetTailSampling(std::chrono::hours{1}, 0.0);
+    {
+        auto root = tracing::Span::MakeRootSpan("tail_root");
+        { const tracing::Span child("tail_child"); }
+        EXPECT_EQ(CountInLogs("tail_child"), 0);
+
+        // The failed span decides for the whole trace right away
+        utils::Async("tail_async_child", [] { tracing::Span::CurrentSpan().AddTag(tracing::kErrorFlag, true); }).Get();
+        EXPECT_EQ(CountInLogs("tail_child"), 1);
+        EXPECT_EQ(CountInLogs("tail_async_child"), 1);
+        EXPECT_EQ(CountInLogs("tail_root"), 0);
+    }
+
+    EXPECT_EQ(CountInLogs("tail_root"), 1);
+    EXPECT_EQ(CountInLogs("tail_child"), 1);
+    EXPECT_EQ(CountInLogs("tail_async_child"), 1);
+}
+
+UTEST_F(TailSamplingSpan, KeepsSlowTraces) {
+    SetTailSampling(std::chrono::milliseconds{1}, 0.0);
+    {
+        auto root = tracing::Span::MakeRootSpan("tail_root");
+        const tracing::Span child("tail_child");
+        engine::SleepFor(std::chrono::milliseconds{5});
+    }
+
+    EXPECT_EQ(CountInLogs("tail_root"), 1);
+    EXPECT_EQ(CountInLogs("tail_child"), 1);
+}
+
+UTEST_F(TailSamplingSpan, KeepsLongRunningTracesEarly) {
+    SetTailSampling(std::chrono::milliseconds{1}, 0.0);
+    {
+        auto root = tracing::Span::MakeRootSpan("tail_root");
+        { const tracing::Span child("tail_child"); }
+        engine::SleepFor(std::chrono::milliseconds{5});
+        { const tracing::Span child("tail_late_child"); }
+
+        // The buffered spans are not held until the root span finishes
+        EXPECT_EQ(CountInLogs("tail_child"), 1);
+        EXPECT_EQ(CountInLogs("tail_late_child"), 1);
+        EXPECT_EQ(CountInLogs("tail_root"), 0);
+    }
+
+    EXPECT_EQ(CountInLogs("tail_root"), 1);
+}
+
+UTEST_F(TailSamplingSpan, KeepsBufferedTags) {
+    SetTailSampling(std::chrono::hours{1}, 1.0);
+    {
+        auto root = tracing::Span::MakeRootSpan("tail_root");
+        root.AddTag("inherited_tag", "inherited_value");
+        tracing::Span child("tail_child");
+        child.AddNonInheritableTag("int_tag", 42);
+        child.AddNonInheritableTag("string_tag", "value");
+        { const tracing::ScopeTime scope{"tail_scope"}; }
+    }
+
+    EXPECT_EQ(CountInLogs("tail_child"), 1);
+    const auto logs = GetStreamString();
+    EXPECT_THAT(logs, HasSubstr("int_tag=42"));
+    EXPECT_THAT(logs, HasSubstr("string_tag=value"));
+    EXPECT_THAT(logs, HasSubstr("tail_scope_time="));
+    EXPECT_THAT(logs, HasSubstr("inherited_tag=inherited_value"));
+}
+
+UTEST_F(TailSamplingSpan, LimitsBufferedSpans) {
+    SetTailSampling(std::chrono::hours{1}, 1.0, 16 * 1024);
+    {
+        auto root = tracing::Span::MakeRootSpan("tail_root");
+        for (int i = 0; i < 5; ++i) {
+            const tracing::Span child("tail_child");
+        }
+        {
+            tracing::Span child("tail_huge_child");
+            child.AddNonInheritableTag("huge_tag", std::string(32 * 1024, 'x'));
+        }
+        { const tracing::Span child("tail_child"); }
+    }
+
+    EXPECT_EQ(CountInLogs("tail_root"), 1);
+    EXPECT_EQ(CountInLogs("tail_child"), 6);
+    EXPECT_EQ(CountInLogs("tail_huge_child"), 0);
+    EXPECT_THAT(GetStreamString(), HasSubstr("tail_sampling_dropped_spans=1"));
+}
+
+UTEST_F(TailSamplingSpan, LogsSpansFinishedAfterRoot) {
+    SetTailSampling(std::chrono::hours{1}, 1.0);
+    std::optional<tracing::Span> late_child;
+    {
+        auto root = tracing::Span::MakeRootSpan("tail_root");
+        late_child.emplace(root.CreateChild("tail_child"));
+        late_child->DetachFromCoroStack();
+    }
+    EXPECT_EQ(CountInLogs("tail_root"), 1);
+    EXPECT_EQ(CountInLogs("tail_child"), 0);
+
+    late_child.reset();
+    EXPECT_EQ(CountInLogs("tail_child"), 1);
+}
+
 USERVER_NAMESPACE_END
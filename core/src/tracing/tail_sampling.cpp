@@ -0,0 +1,215 @@
+#include <tracing/tail_sampling.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <random>
+#include <type_traits>
+#include <utility>
+
+#include <userver/rcu/rcu.hpp>
+#include <userver/tracing/tracer.hpp>
+#include <userver/utils/assert.hpp>
+#include <userver/utils/rand.hpp>
+#include <userver/yaml_config/yaml_config.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+namespace {
+
+auto& GlobalTailSampling() {
+    static rcu::Variable<TailSampling> settings{};
+    return settings;
+}
+
+}  // namespace
+
+TailSampling Parse(const yaml_config::YamlConfig& value, formats::parse::To<TailSampling>) {
+    TailSampling settings;
+    settings.enabled = value["enabled"].As<bool>(settings.enabled);
+    settings.latency_threshold = value["latency-threshold"].As<std::chrono::milliseconds>(settings.latency_threshold);
+    settings.probability = value["probability"].As<double>(settings.probability);
+    settings.max_buffer_size = value["max-buffer-size"].As<std::size_t>(settings.max_buffer_size);
+    return settings;
+}
+
+void Tracer::SetTailSampling(TailSampling&& settings) { GlobalTailSampling().Assign(std::move(settings)); }
+
+namespace impl {
+
+namespace {
+
+constexpr std::size_t kChunkSize = 4096;
+
+constexpr std::size_t AlignUp(std::size_t size, std::size_t alignment) noexcept {
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+constexpr std::size_t kTagsOffset = AlignUp(sizeof(SpanRecord), alignof(logging::impl::LogTag));
+
+static_assert(std::is_trivially_destructible_v<SpanRecord>);
+static_assert(std::is_trivially_destructible_v<logging::impl::LogTag>);
+static_assert(alignof(SpanRecord) <= alignof(std::max_align_t));
+
+}  // namespace
+
+SpanRecordBuilder::StringRef SpanRecordBuilder::AddString(std::string_view value) {
+    const StringRef result{data_.size(), value.size()};
+    data_.append(value.data(), value.data() + value.size());
+    return result;
+}
+
+std::size_t SpanRecordBuilder::GetRecordSize() const noexcept {
+    return AlignUp(kTagsOffset + tags_.size() * sizeof(logging::impl::LogTag) + data_.size(), alignof(SpanRecord));
+}
+
+SpanRecord& SpanRecordBuilder::CopyTo(char* memory) const noexcept {
+    auto* const tags = reinterpret_cast<logging::impl::LogTag*>(memory + kTagsOffset);
+    char* const strings = memory + kTagsOffset + tags_.size() * sizeof(logging::impl::LogTag);
+    std::memcpy(strings, data_.data(), data_.size());
+    const auto get_string = [strings](StringRef ref) { return std::string_view{strings + ref.offset, ref.size}; };
+
+    for (std::size_t i = 0; i < tags_.size(); ++i) {
+        const auto& tag = tags_[i];
+        new (tags + i) logging::impl::LogTag{get_string(tag.key), get_string(tag.value), tag.type};
+    }
+
+    auto* const result = new (memory) SpanRecord(record);
+    result->next = nullptr;
+    result->name = get_string(name);
+    result->trace_id = get_string(trace_id);
+    result->span_id = get_string(span_id);
+    result->parent_id = get_string(parent_id);
+    result->opentracing_tags = get_string(opentracing_tags);
+    result->tags = {tags, tags_.size()};
+    return *result;
+}
+
+SpanRecordArena::SpanRecordArena(SpanRecordArena&& other) noexcept
+    : chunks_(std::move(other.chunks_)),
+      free_begin_(std::exchange(other.free_begin_, nullptr)),
+      free_end_(std::exchange(other.free_end_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      first_(std::exchange(other.first_, nullptr)),
+      last_(std::exchange(other.last_, nullptr)) {
+    other.chunks_.clear();
+}
+
+SpanRecordArena& SpanRecordArena::operator=(SpanRecordArena&& other) noexcept {
+    if (this != &other) {
+        SpanRecordArena tmp{std::move(other)};
+        std::swap(chunks_, tmp.chunks_);
+        std::swap(free_begin_, tmp.free_begin_);
+        std::swap(free_end_, tmp.free_end_);
+        std::swap(size_, tmp.size_);
+        std::swap(first_, tmp.first_);
+        std::swap(last_, tmp.last_);
+    }
+    return *this;
+}
+
+bool SpanRecordArena::Append(const SpanRecordBuilder& builder, std::size_t max_size) {
+    const auto size = builder.GetRecordSize();
+    if (size_ + size > max_size) return false;
+
+    if (static_cast<std::size_t>(free_end_ - free_begin_) < size) {
+        const auto chunk_size = std::max(size, kChunkSize);
+        // new[] of char is aligned for any object of the fitting size
+        chunks_.emplace_back(new char[chunk_size]);
+        free_begin_ = chunks_.back().get();
+        free_end_ = free_begin_ + chunk_size;
+    }
+
+    auto& record = builder.CopyTo(free_begin_);
+    free_begin_ += size;
+    size_ += size;
+    if (last_) {
+        last_->next = &record;
+    } else {
+        first_ = &record;
+    }
+    last_ = &record;
+    return true;
+}
+
+TailSamplingTrace::TailSamplingTrace(const TailSampling& settings, std::chrono::steady_clock::time_point start_time)
+    : settings_(settings), start_time_(start_time) {}
+
+std::optional<TailSamplingTrace::Decision>
+TailSamplingTrace::TryDecide(bool is_error, std::chrono::steady_clock::time_point now) {
+    if (auto decision = GetDecision()) return decision;
+    // Otherwise the root span would keep the trace anyway, so the buffered
+    // spans of the long-running traces are not held until it finishes
+    if (!is_error && now - start_time_ < settings_.latency_threshold) return std::nullopt;
+
+    const std::lock_guard lock{mutex_};
+    if (auto decision = GetDecision()) return decision;
+    return Keep();
+}
+
+std::optional<TailSamplingTrace::Decision> TailSamplingTrace::Buffer(const SpanRecordBuilder& builder) {
+    const std::lock_guard lock{mutex_};
+    if (auto decision = GetDecision()) return decision;
+
+    if (!spans_.Append(builder, settings_.max_buffer_size)) ++dropped_spans_;
+    return std::nullopt;
+}
+
+TailSamplingTrace::Decision TailSamplingTrace::Decide(std::chrono::steady_clock::time_point now, bool is_error) {
+    const auto keep = [&] {
+        if (is_error || now - start_time_ >= settings_.latency_threshold) return true;
+        if (settings_.probability <= 0.0) return false;
+        std::bernoulli_distribution distribution{settings_.probability};
+        return utils::WithDefaultRandom(distribution);
+    };
+
+    const std::lock_guard lock{mutex_};
+    UASSERT_MSG(state_ != State::kDropped, "The tail sampling decision is made twice");
+    if (state_ == State::kKept || keep()) {
+        auto decision = Keep();
+        decision.dropped_spans = dropped_spans_;
+        return decision;
+    }
+
+    state_ = State::kDropped;
+    // The dropped spans are freed unformatted
+    spans_ = {};
+    return Decision{};
+}
+
+std::optional<TailSamplingTrace::Decision> TailSamplingTrace::GetDecision() const {
+    switch (state_.load(std::memory_order_acquire)) {
+        case State::kPending:
+            return std::nullopt;
+        case State::kKept: {
+            Decision decision;
+            decision.keep = true;
+            return decision;
+        }
+        case State::kDropped:
+            return Decision{};
+    }
+    UINVARIANT(false, "Unexpected tail sampling state");
+}
+
+TailSamplingTrace::Decision TailSamplingTrace::Keep() {
+    Decision decision;
+    decision.keep = true;
+    decision.spans = std::exchange(spans_, {});
+    state_.store(State::kKept, std::memory_order_release);
+    return decision;
+}
+
+std::shared_ptr<TailSamplingTrace> MakeTailSamplingTrace(std::chrono::steady_clock::time_point start_time) {
+    const auto settings = GlobalTailSampling().Read();
+    if (!settings->enabled) return nullptr;
+    return std::make_shared<TailSamplingTrace>(*settings, start_time);
+}
+
+}  // namespace impl
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
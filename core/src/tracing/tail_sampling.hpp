@@ -0,0 +1,185 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+#include <fmt/compile.h>
+#include <fmt/format.h>
+
+#include <userver/formats/parse/to.hpp>
+#include <userver/logging/impl/log_record.hpp>
+#include <userver/logging/impl/tag_writer.hpp>
+#include <userver/logging/level.hpp>
+#include <userver/tracing/span.hpp>
+#include <userver/utils/impl/source_location.hpp>
+#include <userver/utils/span.hpp>
+#include <userver/yaml_config/fwd.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace tracing {
+
+// Tail-based sampling of the traces: the finished spans of a trace are kept
+// in memory until its root span finishes and decides whether to log them.
+struct TailSampling {
+    bool enabled{false};
+    // The traces with the root span that took at least this long are logged
+    std::chrono::milliseconds latency_threshold{1000};
+    // Probability to log a trace that is neither failed nor slow
+    double probability{0.0};
+    // The finished spans of a pending trace that do not fit into this many
+    // bytes are dropped, even if the trace is logged
+    std::size_t max_buffer_size{64 * 1024};
+};
+
+TailSampling Parse(const yaml_config::YamlConfig& value, formats::parse::To<TailSampling>);
+
+namespace impl {
+
+// A finished span of a pending trace with the tags formatted into strings,
+// all of it stored in the SpanRecordArena of the trace
+struct SpanRecord final {
+    const SpanRecord* next{nullptr};
+    std::string_view name;
+    std::string_view trace_id;
+    std::string_view span_id;
+    std::string_view parent_id;
+    logging::Level log_level{logging::Level::kInfo};
+    ReferenceType reference_type{ReferenceType::kChild};
+    utils::impl::SourceLocation source_location{utils::impl::SourceLocation::Current()};
+    std::chrono::system_clock::time_point start_system_time;
+    std::chrono::steady_clock::duration duration{};
+    utils::span<const logging::impl::LogTag> tags;
+    // The tags of the opentracing log record, empty if there is none
+    std::string_view opentracing_tags;
+};
+
+// Collects a SpanRecord outside of the trace lock, to be copied into the arena
+// in one piece
+class SpanRecordBuilder final {
+public:
+    struct StringRef final {
+        std::size_t offset{0};
+        std::size_t size{0};
+    };
+
+    // The non-string fields are filled directly
+    SpanRecord record;
+    StringRef name;
+    StringRef trace_id;
+    StringRef span_id;
+    StringRef parent_id;
+    StringRef opentracing_tags;
+
+    StringRef AddString(std::string_view value);
+
+    template <typename T>
+    void AddTag(std::string_view key, const T& value);
+
+    std::size_t GetRecordSize() const noexcept;
+    SpanRecord& CopyTo(char* memory) const noexcept;
+
+private:
+    struct TagRef final {
+        StringRef key;
+        StringRef value;
+        logging::impl::TagType type;
+    };
+
+    fmt::memory_buffer data_;
+    boost::container::small_vector<TagRef, 16> tags_;
+};
+
+// Finished spans of a trace in memory chunks that are freed all at once
+class SpanRecordArena final {
+public:
+    SpanRecordArena() = default;
+    SpanRecordArena(SpanRecordArena&& other) noexcept;
+    SpanRecordArena& operator=(SpanRecordArena&& other) noexcept;
+
+    // Returns false if the record does not fit into `max_size` bytes in total
+    bool Append(const SpanRecordBuilder& builder, std::size_t max_size);
+
+    // In the order of appending
+    const SpanRecord* GetFirst() const noexcept { return first_; }
+
+private:
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char* free_begin_{nullptr};
+    char* free_end_{nullptr};
+    std::size_t size_{0};
+    SpanRecord* first_{nullptr};
+    SpanRecord* last_{nullptr};
+};
+
+// The state of a trace, shared by all its spans, including the spans of the
+// subtasks. The spans are stored as compact records, so dropping a trace costs
+// no log formatting work.
+class TailSamplingTrace final {
+public:
+    struct Decision final {
+        bool keep{false};
+        // The buffered spans to log before the current one, if the trace has
+        // just been kept
+        SpanRecordArena spans;
+        // The spans that did not fit into max_buffer_size
+        std::size_t dropped_spans{0};
+    };
+
+    TailSamplingTrace(const TailSampling& settings, std::chrono::steady_clock::time_point start_time);
+
+    // Called on a non-root span completion. Decides for the whole trace right
+    // away if the span fails, or if the root span is already slow.
+    // Returns std::nullopt if the span should be buffered.
+    std::optional<Decision> TryDecide(bool is_error, std::chrono::steady_clock::time_point now);
+
+    // Returns the decision instead if it has been made since TryDecide
+    std::optional<Decision> Buffer(const SpanRecordBuilder& builder);
+
+    // Called once on the root span completion
+    Decision Decide(std::chrono::steady_clock::time_point now, bool is_error);
+
+private:
+    enum class State { kPending, kKept, kDropped };
+
+    std::optional<Decision> GetDecision() const;
+    Decision Keep();
+
+    const TailSampling settings_;
+    const std::chrono::steady_clock::time_point start_time_;
+
+    std::atomic<State> state_{State::kPending};
+    std::mutex mutex_;
+    SpanRecordArena spans_;
+    std::size_t dropped_spans_{0};
+};
+
+// nullptr if the tail sampling is disabled
+std::shared_ptr<TailSamplingTrace> MakeTailSamplingTrace(std::chrono::steady_clock::time_point start_time);
+
+template <typename T>
+void SpanRecordBuilder::AddTag(std::string_view key, const T& value) {
+    const auto key_ref = AddString(key);
+    StringRef value_ref{data_.size(), 0};
+    if constexpr (std::is_arithmetic_v<T>) {
+        fmt::format_to(fmt::appender(data_), FMT_COMPILE("{}"), value);
+    } else {
+        const std::string_view string_value{value};
+        data_.append(string_value.data(), string_value.data() + string_value.size());
+    }
+    value_ref.size = data_.size() - value_ref.offset;
+    tags_.push_back(TagRef{key_ref, value_ref, logging::impl::GetTagType<T>()});
+}
+
+}  // namespace impl
+
+}  // namespace tracing
+
+USERVER_NAMESPACE_END
@@ -25,6 +25,12 @@ TimeStorage::Duration TimeStorage::DurationTotal(const std::string& key) const {
 }
 
 void TimeStorage::MergeInto(logging::impl::TagWriter writer) {
+    ForEachTag([&writer](std::string_view key, std::string_view value) {
+        writer.PutTag(logging::impl::RuntimeTagKey{key}, value);
+    });
+}
+
+void TimeStorage::ForEachTag(utils::function_ref<void(std::string_view key, std::string_view value)> func) const {
     fmt::basic_memory_buffer<char, 64> key_buffer{};
     fmt::basic_memory_buffer<char, 16> duration_memory_buffer{};
 
@@ -44,7 +50,7 @@ void TimeStorage::MergeInto(logging::impl::TagWriter writer) {
 
         const std::string_view key_tag_sw{key_buffer.data(), key_buffer.size()};
         const std::string_view duration_sw{duration_memory_buffer.data(), duration_memory_buffer.size()};
-        writer.PutTag(logging::impl::RuntimeTagKey{key_tag_sw}, duration_sw);
+        func(key_tag_sw, duration_sw);
     }
 }
 
@@ -5,6 +5,7 @@
 #include <unordered_map>
 
 #include <userver/logging/log_extra.hpp>
+#include <userver/utils/function_ref.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -32,6 +33,10 @@ public:
 
     void MergeInto(logging::impl::TagWriter writer);
 
+    /// Calls `func` with the key and the formatted value of each tag that
+    /// MergeInto would write
+    void ForEachTag(utils::function_ref<void(std::string_view key, std::string_view value)> func) const;
+
 private:
     std::unordered_map<std::string, Duration> data_;
 };
@@ -27,9 +27,7 @@ public:
 };
 
 void NoopTracer::LogSpanContextTo(const Span::Impl& span, logging::impl::TagWriter writer) const {
-    writer.PutTag(kTraceIdName, span.GetTraceId());
-    writer.PutTag(kSpanIdName, span.GetSpanId());
-    writer.PutTag(kParentIdName, span.GetParentId());
+    impl::LogSpanContextTo(span.GetTraceId(), span.GetSpanId(), span.GetParentId(), writer);
 }
 
 auto& GlobalNoLogSpans() {
@@ -64,6 +62,17 @@ bool ValueMatchesOneOfPrefixes(const T& value, const boost::container::flat_set<
 
 }  // namespace
 
+void impl::LogSpanContextTo(
+    std::string_view trace_id,
+    std::string_view span_id,
+    std::string_view parent_id,
+    logging::impl::TagWriter writer
+) {
+    writer.PutTag(kTraceIdName, trace_id);
+    writer.PutTag(kSpanIdName, span_id);
+    writer.PutTag(kParentIdName, parent_id);
+}
+
 Tracer::~Tracer() = default;
 
 void Tracer::SetNoLogSpans(NoLogSpans&& spans) {
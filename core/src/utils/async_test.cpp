@@ -37,6 +37,18 @@ UTEST(UtilsAsync, WithDeadlineCancellationPoint) {
     UEXPECT_THROW(task.Get(), engine::TaskCancelledException);
 }
 
+UTEST(UtilsAsync, WithPriority) {
+    auto& task_processor = engine::current_task::GetTaskProcessor();
+    auto critical = utils::Async(
+        task_processor, engine::Task::Priority::kCritical, "critical", [](int x) { return x; }, 1
+    );
+    auto background = utils::Async(task_processor, engine::Task::Priority::kBackground, "background", [] { return 2; });
+    auto no_span = engine::AsyncNoSpan(task_processor, engine::Task::Priority::kBackground, [] { return 3; });
+    EXPECT_EQ(critical.Get(), 1);
+    EXPECT_EQ(background.Get(), 2);
+    EXPECT_EQ(no_span.Get(), 3);
+}
+
 UTEST(UtilsAsync, MemberFunctions) {
     struct NotCopyable {
         NotCopyable() = default;
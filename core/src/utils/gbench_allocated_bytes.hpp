@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include <utils/jemalloc.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils {
+
+// Reports the bytes allocated by the benchmark thread per iteration as the
+// `counter_name` benchmark counter. The counters are only available if the
+// benchmark runs with jemalloc, otherwise nothing is reported.
+class GbenchAllocatedBytes final {
+public:
+    GbenchAllocatedBytes() : counters_(jemalloc::GetThreadAllocationCounters()), start_(Get()) {}
+
+    void Report(benchmark::State& state, const char* counter_name = "allocated-bytes-per-iteration") const {
+        if (!counters_.allocated) return;
+        state.counters[counter_name] =
+            benchmark::Counter(static_cast<double>(Get() - start_), benchmark::Counter::kAvgIterations);
+    }
+
+private:
+    std::uint64_t Get() const noexcept { return counters_.allocated ? *counters_.allocated : 0; }
+
+    const jemalloc::ThreadAllocationCounters counters_;
+    const std::uint64_t start_;
+};
+
+}  // namespace utils
+
+USERVER_NAMESPACE_END
@@ -35,6 +35,14 @@ std::error_code MallCtl(const char* name) {
     return MakeErrorCode(rc);
 }
 
+template <typename T>
+T MallCtlRead(const char* name, T default_value) noexcept {
+    T value{};
+    size_t size = sizeof(value);
+    if (mallctl(name, &value, &size, nullptr, 0) != 0) return default_value;
+    return value;
+}
+
 void MallocStatPrintCb(void* data, const char* msg) {
     auto* s = static_cast<std::string*>(data);
     *s += msg;
@@ -65,6 +73,14 @@ std::error_code EnableBgThreads() {
 
 std::error_code StopBgThreads() { return MallCtl<bool>("background_thread", false); }
 
+ThreadAllocationCounters GetThreadAllocationCounters() noexcept {
+    ThreadAllocationCounters counters;
+    counters.allocated = MallCtlRead<std::uint64_t*>("thread.allocatedp", nullptr);
+    counters.deallocated = MallCtlRead<std::uint64_t*>("thread.deallocatedp", nullptr);
+    if (!counters.allocated || !counters.deallocated) return {};
+    return counters;
+}
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
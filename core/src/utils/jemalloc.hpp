@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <system_error>
 
@@ -22,6 +23,15 @@ std::error_code EnableBgThreads();
 // blocking
 std::error_code StopBgThreads();
 
+// Counters of the bytes allocated and freed by the calling thread, valid until
+// the thread exits. nullptr if jemalloc is disabled or built without stats.
+struct ThreadAllocationCounters final {
+    const std::uint64_t* allocated{nullptr};
+    const std::uint64_t* deallocated{nullptr};
+};
+
+ThreadAllocationCounters GetThreadAllocationCounters() noexcept;
+
 }  // namespace utils::jemalloc
 
 USERVER_NAMESPACE_END
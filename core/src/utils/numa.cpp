@@ -0,0 +1,131 @@
+#include <utils/numa.hpp>
+
+#include <sched.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/format.h>
+
+#include <userver/fs/blocking/read.hpp>
+#include <userver/utils/from_string.hpp>
+#include <userver/utils/text_light.hpp>
+
+#include <utils/check_syscall.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace utils::numa {
+
+namespace {
+
+constexpr std::string_view kSysNodePath = "/sys/devices/system/node";
+
+// It is only used outside of coroutines (in freshly started OS threads)
+// or read via a non-inline function, so it does not need compiler::ThreadLocal
+thread_local std::optional<std::size_t> current_thread_node;
+
+std::size_t ParseCpu(std::string_view cpu, std::string_view cpu_list) {
+    try {
+        return utils::FromString<std::size_t>(utils::text::Trim(std::string{cpu}));
+    } catch (const std::exception& ex) {
+        throw std::runtime_error(fmt::format("Invalid CPU list '{}': {}", cpu_list, ex.what()));
+    }
+}
+
+std::string ReadTrimmed(const std::string& path) {
+    return utils::text::Trim(fs::blocking::ReadFileContents(path));
+}
+
+struct Topology final {
+    // node by CPU
+    std::vector<std::size_t> cpu_nodes;
+    std::size_t nodes_count{1};
+};
+
+Topology LoadTopology() {
+    Topology topology;
+#ifdef __linux__
+    try {
+        const auto online_nodes_path = fmt::format("{}/online", kSysNodePath);
+        if (!fs::blocking::FileExists(online_nodes_path)) {
+            return topology;
+        }
+        for (const auto node : ParseCpuList(ReadTrimmed(online_nodes_path))) {
+            topology.nodes_count = std::max(topology.nodes_count, node + 1);
+            const auto node_cpus = ParseCpuList(ReadTrimmed(fmt::format("{}/node{}/cpulist", kSysNodePath, node)));
+            for (const auto cpu : node_cpus) {
+                if (topology.cpu_nodes.size() <= cpu) {
+                    topology.cpu_nodes.resize(cpu + 1, 0);
+                }
+                topology.cpu_nodes[cpu] = node;
+            }
+        }
+    } catch (const std::exception&) {
+        // sysfs is not mounted or has an unexpected format, assume no NUMA
+        return Topology{};
+    }
+#endif
+    return topology;
+}
+
+const Topology& GetTopology() {
+    static const Topology kTopology = LoadTopology();
+    return kTopology;
+}
+
+}  // namespace
+
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list) {
+    std::vector<std::size_t> result;
+    if (utils::text::Trim(std::string{cpu_list}).empty()) {
+        return result;
+    }
+
+    std::size_t pos = 0;
+    while (pos <= cpu_list.size()) {
+        const auto comma = std::min(cpu_list.find(',', pos), cpu_list.size());
+        const auto range = cpu_list.substr(pos, comma - pos);
+        pos = comma + 1;
+
+        const auto dash = range.find('-');
+        const auto first = ParseCpu(range.substr(0, dash), cpu_list);
+        const auto last = (dash == std::string_view::npos) ? first : ParseCpu(range.substr(dash + 1), cpu_list);
+        if (last < first) {
+            throw std::runtime_error(fmt::format("Invalid CPU list '{}': descending range", cpu_list));
+        }
+        for (auto cpu = first; cpu <= last; ++cpu) {
+            result.push_back(cpu);
+        }
+    }
+    return result;
+}
+
+std::size_t GetNodesCount() { return GetTopology().nodes_count; }
+
+std::size_t GetCpuNode(std::size_t cpu) {
+    const auto& cpu_nodes = GetTopology().cpu_nodes;
+    return cpu < cpu_nodes.size() ? cpu_nodes[cpu] : 0;
+}
+
+void PinCurrentThreadToCpu(std::size_t cpu) {
+#ifdef __linux__
+    if (cpu >= CPU_SETSIZE) {
+        throw std::runtime_error(fmt::format("CPU {} is out of the supported range", cpu));
+    }
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+    // On Linux sched_setaffinity with pid 0 affects only the calling thread
+    utils::CheckSyscall(::sched_setaffinity(0, sizeof(cpu_set), &cpu_set), "pinning the thread to CPU {}", cpu);
+    current_thread_node = GetCpuNode(cpu);
+#else
+    throw std::runtime_error(fmt::format("Pinning threads to CPUs is not supported on this platform (CPU {})", cpu));
+#endif
+}
+
+std::optional<std::size_t> GetCurrentThreadNode() noexcept { return current_thread_node; }
+
+}  // namespace utils::numa
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+USERVER_NAMESPACE_BEGIN
+
+/// CPU and NUMA topology helpers for pinning engine threads
+namespace utils::numa {
+
+/// Parses a CPU list in the Linux 'cpulist' format, e.g. "0-23,48-71,96"
+/// @throws std::runtime_error on malformed input
+std::vector<std::size_t> ParseCpuList(std::string_view cpu_list);
+
+/// @returns the number of NUMA nodes of the host, 1 if NUMA is not supported
+std::size_t GetNodesCount();
+
+/// @returns the NUMA node of the CPU, 0 if unknown
+std::size_t GetCpuNode(std::size_t cpu);
+
+/// Pins the current OS thread to the CPU and remembers its NUMA node
+/// @throws std::system_error
+void PinCurrentThreadToCpu(std::size_t cpu);
+
+/// @returns the NUMA node of the current OS thread if it was pinned
+/// with PinCurrentThreadToCpu
+std::optional<std::size_t> GetCurrentThreadNode() noexcept;
+
+}  // namespace utils::numa
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,34 @@
+#include <utils/numa.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+USERVER_NAMESPACE_BEGIN
+
+TEST(Numa, ParseCpuList) {
+    using Cpus = std::vector<std::size_t>;
+
+    EXPECT_EQ(utils::numa::ParseCpuList(""), Cpus{});
+    EXPECT_EQ(utils::numa::ParseCpuList("5"), Cpus{5});
+    EXPECT_EQ(utils::numa::ParseCpuList("0-3"), (Cpus{0, 1, 2, 3}));
+    EXPECT_EQ(utils::numa::ParseCpuList("0-1,8,10-11"), (Cpus{0, 1, 8, 10, 11}));
+    EXPECT_EQ(utils::numa::ParseCpuList(" 2 , 4-5 "), (Cpus{2, 4, 5}));
+}
+
+TEST(Numa, ParseCpuListInvalid) {
+    EXPECT_THROW(utils::numa::ParseCpuList("1,"), std::runtime_error);
+    EXPECT_THROW(utils::numa::ParseCpuList("3-1"), std::runtime_error);
+    EXPECT_THROW(utils::numa::ParseCpuList("a-b"), std::runtime_error);
+    EXPECT_THROW(utils::numa::ParseCpuList("1-2-3"), std::runtime_error);
+}
+
+TEST(Numa, Topology) {
+    const auto nodes_count = utils::numa::GetNodesCount();
+    EXPECT_GE(nodes_count, 1);
+    EXPECT_LT(utils::numa::GetCpuNode(0), nodes_count);
+    EXPECT_EQ(utils::numa::GetCurrentThreadNode(), std::nullopt);
+}
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,174 @@
+#include <userver/utils/statistics/log_linear_histogram.hpp>
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <userver/utils/statistics/recentperiod.hpp>
+#include <userver/utils/statistics/storage.hpp>
+#include <userver/utils/statistics/testing.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Histogram = utils::statistics::LogLinearHistogram<7, 32>;
+
+}  // namespace
+
+static_assert(utils::statistics::kHasWriterSupport<Histogram>);
+
+TEST(LogLinearHistogram, Zero) {
+    Histogram h;
+
+    EXPECT_EQ(0U, h.Count());
+    EXPECT_EQ(0U, h.GetPercentile(0));
+    EXPECT_EQ(0U, h.GetPercentile(50));
+    EXPECT_EQ(0U, h.GetPercentile(100));
+}
+
+TEST(LogLinearHistogram, ExactSmallValues) {
+    Histogram h;
+
+    for (int i = 0; i < 256; i++) h.Account(i);
+
+    EXPECT_EQ(256U, h.Count());
+    EXPECT_EQ(0U, h.GetPercentile(0));
+    EXPECT_EQ(128U, h.GetPercentile(50));
+    EXPECT_EQ(255U, h.GetPercentile(100));
+    EXPECT_EQ(255U, h.GetPercentile(200));
+}
+
+TEST(LogLinearHistogram, RelativePrecision) {
+    for (std::uint64_t value = 1; value < (std::uint64_t{1} << 32); value = value * 17 / 16 + 1) {
+        const auto index = Histogram::GetBucketIndex(value);
+        ASSERT_LT(index, Histogram::kBucketCount);
+
+        const auto max_value = Histogram::GetBucketMaxValue(index);
+        EXPECT_GE(max_value, value);
+        EXPECT_LE(max_value - value, value / 128) << value;
+        if (index > 0) {
+            EXPECT_LT(Histogram::GetBucketMaxValue(index - 1), value) << value;
+        }
+    }
+}
+
+TEST(LogLinearHistogram, Overflow) {
+    Histogram h;
+
+    h.Account(std::uint64_t{1} << 40);
+
+    EXPECT_EQ(Histogram::kBucketCount - 1, Histogram::GetBucketIndex(std::uint64_t{1} << 40));
+    EXPECT_EQ((std::uint64_t{1} << 32) - 1, h.GetPercentile(100));
+}
+
+TEST(LogLinearHistogram, SubMillisecondPercentiles) {
+    // Microsecond timings: 999 requests of 400us and a slow one of 870us
+    Histogram h;
+    h.Account(400, 999);
+    h.Account(870);
+
+    const auto p99 = h.GetPercentile(99);
+    EXPECT_GE(p99, 400U);
+    EXPECT_LE(p99, 400U + 400U / 128);
+
+    const auto p100 = h.GetPercentile(100);
+    EXPECT_GE(p100, 870U);
+    EXPECT_LE(p100, 870U + 870U / 128);
+}
+
+TEST(LogLinearHistogram, AddAndCopy) {
+    Histogram first;
+    first.Account(10);
+    first.Account(1000);
+
+    Histogram second;
+    second.Account(100'000);
+
+    first.Add(second);
+    EXPECT_EQ(3U, first.Count());
+    EXPECT_EQ(first.GetPercentile(100), second.GetPercentile(100));
+
+    const Histogram copy{first};
+    EXPECT_EQ(3U, copy.Count());
+    EXPECT_EQ(10U, copy.GetPercentile(0));
+
+    first.Reset();
+    EXPECT_EQ(0U, first.Count());
+    EXPECT_EQ(3U, copy.Count());
+}
+
+TEST(LogLinearHistogram, RecentPeriod) {
+    utils::statistics::RecentPeriod<Histogram, Histogram> timings;
+    timings.GetCurrentCounter().Account(42);
+
+    const auto result = timings.GetStatsForPeriod(std::chrono::seconds{60}, true);
+    EXPECT_EQ(1U, result.Count());
+    EXPECT_EQ(42U, result.GetPercentile(50));
+}
+
+TEST(LogLinearHistogram, Concurrent) {
+    constexpr int kThreads = 8;
+    constexpr int kIterations = 10'000;
+
+    Histogram h;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < kThreads; i++) {
+        threads.emplace_back([&h] {
+            for (int j = 0; j < kIterations; j++) h.Account(j);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(std::uint64_t{kThreads} * kIterations, h.Count());
+
+    const Histogram copy{h};
+    EXPECT_EQ(h.Count(), copy.Count());
+    EXPECT_EQ(h.GetPercentile(99.9), copy.GetPercentile(99.9));
+}
+
+TEST(LogLinearHistogram, ToHistogram) {
+    Histogram h;
+    h.Account(1);
+    h.Account(255, 2);
+    h.Account(256);
+    h.Account(100'000);
+
+    const std::vector<double> bounds{1, 255, 1023};
+    const auto histogram = h.ToHistogram(bounds);
+    const auto view = histogram.GetView();
+
+    ASSERT_EQ(3U, view.GetBucketCount());
+    EXPECT_EQ(1U, view.GetValueAt(0));
+    EXPECT_EQ(2U, view.GetValueAt(1));
+    EXPECT_EQ(1U, view.GetValueAt(2));
+    EXPECT_EQ(1U, view.GetValueAtInf());
+}
+
+TEST(LogLinearHistogram, DumpTimings) {
+    utils::statistics::Storage storage;
+    Histogram h;
+    h.Account(20'000);
+    utils::statistics::TimingsMetrics timings_metrics;
+
+    auto holder = storage.RegisterWriter("test", [&](utils::statistics::Writer& writer) {
+        utils::statistics::DumpTimings(writer, h, timings_metrics);
+    });
+
+    const utils::statistics::Snapshot default_snapshot{storage};
+    const auto p50 = static_cast<std::int64_t>(h.GetPercentile(50));
+    EXPECT_EQ(p50 / 1000, default_snapshot.SingleMetric("test.timings", {{"percentile", "p50"}}).AsInt());
+    EXPECT_FALSE(default_snapshot.SingleMetricOptional("test.timings-us", {{"percentile", "p50"}}));
+    EXPECT_FALSE(default_snapshot.SingleMetricOptional("test.timings-histogram"));
+
+    timings_metrics = {/*percentiles_us=*/true, /*histogram=*/true};
+    const utils::statistics::Snapshot snapshot{storage};
+    EXPECT_EQ(p50, snapshot.SingleMetric("test.timings-us", {{"percentile", "p50"}}).AsInt());
+    const auto histogram = snapshot.SingleMetric("test.timings-histogram").AsHistogram();
+    ASSERT_EQ(utils::statistics::kTimingsHistogramBounds.size(), histogram.GetBucketCount());
+    // 20'000 falls into (16383, 32767]
+    EXPECT_EQ(1U, histogram.GetValueAt(10));
+}
+
+USERVER_NAMESPACE_END
@@ -1,12 +1,21 @@
 #include <userver/utils/statistics/prometheus.hpp>
 
 #include <algorithm>
+#include <exception>
 #include <iterator>
+#include <mutex>
+#include <optional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/container_hash/hash.hpp>
 
 #include <fmt/compile.h>
 #include <fmt/format.h>
 
+#include <userver/engine/mutex.hpp>
+#include <userver/utils/assert.hpp>
 #include <userver/utils/impl/transparent_hash.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/statistics/fmt.hpp>
@@ -22,73 +31,174 @@ namespace {
 
 enum class Typed { kYes, kNo };
 
+void DumpMetricType(
+    fmt::memory_buffer& buf,
+    std::string_view prometheus_name,
+    const MetricValue& value,
+    Typed is_typed
+) {
+    if (is_typed == Typed::kNo) {
+        const bool should_skip = value.Visit(utils::Overloaded{
+            [](std::int64_t) { return true; },
+            [](double) { return true; },
+            [](Rate) { return false; },
+            [](HistogramView) { return false; },
+        });
+        if (should_skip) return;
+    }
+
+    const auto type = value.Visit(utils::Overloaded{
+        [](std::int64_t) -> std::string_view { return "gauge"; },
+        [](double) -> std::string_view { return "gauge"; },
+        [](Rate) -> std::string_view { return "counter"; },
+        [](HistogramView) -> std::string_view { return "histogram"; },
+    });
+    fmt::format_to(std::back_inserter(buf), FMT_COMPILE("# TYPE {} {}\n"), prometheus_name, type);
+}
+
+// Labels without the braces
+void DumpLabelsRaw(fmt::memory_buffer& buf, utils::statistics::LabelsSpan labels) {
+    bool sep = false;
+    for (const auto& label : labels) {
+        if (sep) {
+            buf.push_back(',');
+        }
+        fmt::format_to(std::back_inserter(buf), FMT_COMPILE("{}=\""), impl::ToPrometheusLabel(label.Name()));
+        const auto& value = label.Value();
+        std::replace_copy(value.cbegin(), value.cend(), std::back_inserter(buf), '"', '\'');
+        buf.push_back('"');
+        sep = true;
+    }
+}
+
+void AppendHistogramMetric(
+    fmt::memory_buffer& buf,
+    std::string_view metric_suffix,
+    std::string_view prometheus_name,
+    std::string_view upper_bound,
+    std::string_view value,
+    std::string_view raw_labels
+) {
+    fmt::format_to(std::back_inserter(buf), FMT_COMPILE("{}_{}{{"), prometheus_name, metric_suffix);
+    if (!upper_bound.empty()) {
+        fmt::format_to(std::back_inserter(buf), FMT_COMPILE("le=\"{}\""), upper_bound);
+    }
+    if (!raw_labels.empty()) {
+        if (!upper_bound.empty()) {
+            buf.push_back(',');
+        }
+        buf.append(raw_labels);
+    }
+    fmt::format_to(std::back_inserter(buf), FMT_COMPILE("}} {}\n"), value);
+}
+
+void DumpHistogram(
+    fmt::memory_buffer& buf,
+    std::string_view prometheus_name,
+    std::string_view raw_labels,
+    HistogramView histogram
+) {
+    static constexpr std::string_view kBucket = "bucket";
+
+    const auto bucket_count = histogram.GetBucketCount();
+    std::uint64_t cumulative_sum = 0;
+    for (std::size_t i = 0; i < bucket_count; ++i) {
+        cumulative_sum += histogram.GetValueAt(i);
+        AppendHistogramMetric(
+            buf,
+            kBucket,
+            prometheus_name,
+            fmt::to_string(histogram.GetUpperBoundAt(i)),
+            fmt::to_string(cumulative_sum),
+            raw_labels
+        );
+    }
+    cumulative_sum += histogram.GetValueAtInf();
+    AppendHistogramMetric(buf, kBucket, prometheus_name, "+Inf", fmt::to_string(cumulative_sum), raw_labels);
+    AppendHistogramMetric(
+        buf,
+        "count",
+        prometheus_name,
+        /* upper_bound */ "",
+        fmt::to_string(histogram.GetTotalCount()),
+        raw_labels
+    );
+}
+
+// Passes the output of a builder to the consumer in parts. The exceptions
+// of the consumer would be caught by the metric visitation, so they are
+// rethrown from Finish instead.
+class ChunkSink final {
+public:
+    ChunkSink(const PrometheusFormatter::ChunkConsumer& consumer, std::size_t chunk_size)
+        : consumer_(consumer), chunk_size_(chunk_size) {}
+
+    // The rest of the output is dropped after a failure
+    bool IsFailed() const noexcept { return exception_ != nullptr; }
+
+    void FlushIfFull(fmt::memory_buffer& buf) {
+        if (buf.size() >= chunk_size_) Flush(buf);
+    }
+
+    void Finish(fmt::memory_buffer& buf) {
+        if (!exception_ && buf.size() != 0) Flush(buf);
+        if (exception_) std::rethrow_exception(exception_);
+    }
+
+private:
+    void Flush(fmt::memory_buffer& buf) {
+        try {
+            consumer_(fmt::to_string(buf));
+        } catch (...) {
+            exception_ = std::current_exception();
+        }
+        buf.clear();
+    }
+
+    const PrometheusFormatter::ChunkConsumer& consumer_;
+    const std::size_t chunk_size_;
+    std::exception_ptr exception_;
+};
+
 template <Typed IsTyped>
 class FormatBuilder final : public utils::statistics::BaseFormatBuilder {
 public:
-    explicit FormatBuilder() = default;
+    // Without a sink the output is accumulated until Release
+    explicit FormatBuilder(ChunkSink* sink = nullptr) : sink_(sink) {}
 
     void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels, const MetricValue& value) override {
+        if (sink_ && sink_->IsFailed()) return;
+
         if (value.IsHistogram()) {
             HandleHistogram(path, labels, value);
-            return;
+        } else {
+            DumpMetricNameAndType(path, value);
+            DumpLabels(labels);
+            fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
         }
 
-        DumpMetricNameAndType(path, value);
-        DumpLabels(labels);
-        fmt::format_to(std::back_inserter(buf_), FMT_COMPILE(" {}\n"), value);
+        if (sink_) sink_->FlushIfFull(buf_);
     }
 
-    std::string Release() { return fmt::to_string(buf_); }
+    std::string Release() {
+        UASSERT(!sink_);
+        return fmt::to_string(buf_);
+    }
 
-private:
-    void AppendHistogramMetric(
-        std::string_view metric_suffix,
-        std::string_view path,
-        const std::string_view& upper_bound,
-        std::string_view value,
-        utils::statistics::LabelsSpan labels
-    ) {
-        fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}_{}{{"), path, metric_suffix);
-        if (!upper_bound.empty()) {
-            fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("le=\"{}\""), upper_bound);
-        }
-        if (!labels.empty()) {
-            if (!upper_bound.empty()) {
-                fmt::format_to(std::back_inserter(buf_), ",");
-            }
-            DumpLabelsRaw(labels);
-        }
-        fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("}} {}\n"), value);
+    void Finish() {
+        UASSERT(sink_);
+        sink_->Finish(buf_);
     }
 
+private:
     void HandleHistogram(std::string_view path, utils::statistics::LabelsSpan labels, const MetricValue& value) {
-        static constexpr std::string_view kBucket = "bucket";
-
         const auto prometheus_name = impl::ToPrometheusName(path);
-        DumpMetricType(prometheus_name, value);
-
-        auto histogram = value.AsHistogram();
-        const auto bucket_count = histogram.GetBucketCount();
-        std::uint64_t cumulative_sum = 0;
-        for (std::size_t i = 0; i < bucket_count; ++i) {
-            cumulative_sum += histogram.GetValueAt(i);
-            AppendHistogramMetric(
-                kBucket,
-                prometheus_name,
-                fmt::to_string(histogram.GetUpperBoundAt(i)),
-                fmt::to_string(cumulative_sum),
-                labels
-            );
-        }
-        cumulative_sum += histogram.GetValueAtInf();
-        AppendHistogramMetric(kBucket, prometheus_name, "+Inf", fmt::to_string(cumulative_sum), labels);
-        AppendHistogramMetric(
-            "count",
-            prometheus_name,
-            /* upper_bound */ "",
-            fmt::to_string(histogram.GetTotalCount()),
-            labels
-        );
+        DumpMetricType(buf_, prometheus_name, value, IsTyped);
+
+        fmt::memory_buffer raw_labels;
+        DumpLabelsRaw(raw_labels, labels);
+        const std::string_view raw_labels_view{raw_labels.data(), raw_labels.size()};
+        DumpHistogram(buf_, prometheus_name, raw_labels_view, value.AsHistogram());
     }
 
     void DumpMetricNameAndType(std::string_view name, const MetricValue& value) {
@@ -98,55 +208,234 @@ private:
         }
 
         auto prometheus_name = impl::ToPrometheusName(name);
-        DumpMetricType(prometheus_name, value);
+        DumpMetricType(buf_, prometheus_name, value, IsTyped);
         buf_.append(prometheus_name);
         metrics_.emplace(name, std::move(prometheus_name));
     }
 
-    void DumpMetricType([[maybe_unused]] std::string_view prometheus_name, [[maybe_unused]] const MetricValue& value) {
-        if constexpr (IsTyped == Typed::kNo) {
-            const bool should_skip = value.Visit(utils::Overloaded{
-                [](std::int64_t) { return true; },
-                [](double) { return true; },
-                [](Rate) { return false; },
-                [](HistogramView) { return false; },
-            });
-            if (should_skip) return;
+    void DumpLabels(utils::statistics::LabelsSpan labels) {
+        buf_.push_back('{');
+        DumpLabelsRaw(buf_, labels);
+        buf_.push_back('}');
+    }
+
+    ChunkSink* const sink_;
+    fmt::memory_buffer buf_;
+    utils::impl::TransparentMap<std::string, std::string> metrics_;
+};
+
+// The series that were not written during this many calls are forgotten
+constexpr std::uint64_t kMaxIdleScrapes = 4;
+
+// A metric path with its labels, separated by zeros
+void AppendSeriesKey(std::string& key, std::string_view path, utils::statistics::LabelsSpan labels) {
+    key.append(path);
+    for (const auto& label : labels) {
+        key.push_back('\0');
+        key.append(label.Name());
+        key.push_back('\0');
+        key.append(label.Value());
+    }
+}
+
+bool IsSeriesKey(std::string_view key, std::string_view path, utils::statistics::LabelsSpan labels) {
+    const auto consume = [&key](std::string_view part) {
+        if (key.substr(0, part.size()) != part) return false;
+        key.remove_prefix(part.size());
+        return true;
+    };
+    const auto consume_separator = [&key] {
+        if (key.empty() || key.front() != '\0') return false;
+        key.remove_prefix(1);
+        return true;
+    };
+
+    if (!consume(path)) return false;
+    for (const auto& label : labels) {
+        if (!consume_separator() || !consume(label.Name()) || !consume_separator() || !consume(label.Value())) {
+            return false;
+        }
+    }
+    return key.empty();
+}
+
+// Formatted series of PrometheusFormatter, kept between the calls
+struct SeriesCache final {
+    struct Family final {
+        std::string prometheus_name;
+        // The scrape that has written the name first, and maybe the type
+        std::uint64_t named_scrape{0};
+        std::uint64_t last_scrape{0};
+    };
+
+    struct Series final {
+        // The line of the last value followed by the key, to keep the data
+        // that is read on each scrape together
+        std::string line_and_key;
+        std::size_t line_size{0};
+        std::string raw_labels;
+        Family* family{nullptr};
+        // Not used for histograms
+        std::optional<MetricValue> value;
+        std::uint64_t last_scrape{0};
+
+        std::string_view GetLine() const { return std::string_view{line_and_key}.substr(0, line_size); }
+        std::string_view GetKey() const { return std::string_view{line_and_key}.substr(line_size); }
+
+        void SetLine(std::string_view line) {
+            line_and_key.replace(0, line_size, line);
+            line_size = line.size();
         }
+    };
 
-        const auto type = value.Visit(utils::Overloaded{
-            [](std::int64_t) -> std::string_view { return "gauge"; },
-            [](double) -> std::string_view { return "gauge"; },
-            [](Rate) -> std::string_view { return "counter"; },
-            [](HistogramView) -> std::string_view { return "histogram"; },
-        });
-        fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("# TYPE {} {}\n"), prometheus_name, type);
+    utils::impl::TransparentMap<std::string, Family> families;
+    // In the order of the last scrape, which is usually the same each time
+    std::vector<Series> series;
+    // Scrapes are numbered from 1
+    std::uint64_t scrape{0};
+};
+
+class CachingFormatBuilder final : public utils::statistics::BaseFormatBuilder {
+public:
+    CachingFormatBuilder(
+        SeriesCache& cache,
+        const PrometheusFormatterSettings& settings,
+        const PrometheusFormatter::ChunkConsumer& consumer
+    )
+        : cache_(cache),
+          settings_(settings),
+          sink_(consumer, settings.chunk_size),
+          previous_series_(std::move(cache_.series)) {
+        ++cache_.scrape;
+        cache_.series.clear();
+        cache_.series.reserve(previous_series_.size());
     }
 
-    void DumpLabelsRaw(utils::statistics::LabelsSpan labels) {
-        bool sep = false;
-        for (const auto& label : labels) {
-            if (sep) {
-                buf_.push_back(',');
+    void HandleMetric(std::string_view path, utils::statistics::LabelsSpan labels, const MetricValue& value) override {
+        if (sink_.IsFailed()) return;
+
+        auto& series = FindOrAddSeries(path, labels);
+        auto& family = *series.family;
+        family.last_scrape = cache_.scrape;
+        const auto is_typed = settings_.typed ? Typed::kYes : Typed::kNo;
+
+        if (value.IsHistogram()) {
+            DumpMetricType(buf_, family.prometheus_name, value, is_typed);
+            DumpHistogram(buf_, family.prometheus_name, series.raw_labels, value.AsHistogram());
+        } else {
+            if (family.named_scrape != cache_.scrape) {
+                family.named_scrape = cache_.scrape;
+                DumpMetricType(buf_, family.prometheus_name, value, is_typed);
+            }
+            if (!series.value || !(*series.value == value)) {
+                series.SetLine(fmt::format(
+                    FMT_COMPILE("{}{{{}}} {}\n"), family.prometheus_name, series.raw_labels, value
+                ));
+                series.value = value;
             }
-            fmt::format_to(std::back_inserter(buf_), FMT_COMPILE("{}=\""), impl::ToPrometheusLabel(label.Name()));
-            const auto& value = label.Value();
-            std::replace_copy(value.cbegin(), value.cend(), std::back_inserter(buf_), '"', '\'');
-            buf_.push_back('"');
-            sep = true;
+            buf_.append(series.GetLine());
         }
+
+        sink_.FlushIfFull(buf_);
     }
 
-    void DumpLabels(utils::statistics::LabelsSpan labels) {
-        buf_.push_back('{');
-        DumpLabelsRaw(labels);
-        buf_.push_back('}');
+    void Finish() {
+
+        // The series missing from this scrape are kept for a while, e.g. for
+        // the scrapes of other prefixes
+        for (auto& series : previous_series_) {
+            if (!series.line_and_key.empty() && cache_.scrape - series.last_scrape < kMaxIdleScrapes) {
+                cache_.series.push_back(std::move(series));
+            }
+        }
+        // A family is used at least as recently as each of its series
+        for (auto it = cache_.families.begin(); it != cache_.families.end();) {
+            it = (cache_.scrape - it->second.last_scrape >= kMaxIdleScrapes) ? cache_.families.erase(it)
+                                                                             : std::next(it);
+        }
+
+        sink_.Finish(buf_);
+    }
+
+private:
+    SeriesCache::Series& FindOrAddSeries(std::string_view path, utils::statistics::LabelsSpan labels) {
+        // Usually the series are written in the same order as the last time
+        if (next_previous_ < previous_series_.size() &&
+            IsSeriesKey(previous_series_[next_previous_].GetKey(), path, labels)) {
+            return Take(previous_series_[next_previous_++]);
+        }
+
+        std::string key;
+        AppendSeriesKey(key, path, labels);
+        const auto hash = std::hash<std::string>{}(key);
+
+        if (previous_index_.empty()) BuildPreviousIndex();
+        const auto [begin, end] = previous_index_.equal_range(hash);
+        for (auto it = begin; it != end; ++it) {
+            auto& series = previous_series_[it->second];
+            // The taken series are empty
+            if (series.GetKey() == key) {
+                if (it->second == next_previous_) ++next_previous_;
+                return Take(series);
+            }
+        }
+
+        SeriesCache::Series series;
+        series.line_and_key = std::move(key);
+        series.family = &FindOrAddFamily(path);
+
+        fmt::memory_buffer raw_labels;
+        DumpLabelsRaw(raw_labels, labels);
+        series.raw_labels = fmt::to_string(raw_labels);
+        return Take(series);
+    }
+
+    void BuildPreviousIndex() {
+        previous_index_.reserve(previous_series_.size());
+        for (std::size_t i = 0; i < previous_series_.size(); ++i) {
+            previous_index_.emplace(std::hash<std::string_view>{}(previous_series_[i].GetKey()), i);
+        }
+    }
+
+    SeriesCache::Family& FindOrAddFamily(std::string_view path) {
+        if (auto* const family = utils::impl::FindTransparentOrNullptr(cache_.families, path)) {
+            return *family;
+        }
+        return cache_.families.emplace(path, SeriesCache::Family{impl::ToPrometheusName(path)}).first->second;
+    }
+
+    SeriesCache::Series& Take(SeriesCache::Series& series) {
+        auto& taken = cache_.series.emplace_back(std::move(series));
+        series = {};
+        taken.last_scrape = cache_.scrape;
+        return taken;
     }
 
+    SeriesCache& cache_;
+    const PrometheusFormatterSettings& settings_;
+    ChunkSink sink_;
+
+    std::vector<SeriesCache::Series> previous_series_;
+    std::size_t next_previous_{0};
+    // Built on the first series out of the previous order
+    std::unordered_multimap<std::size_t, std::size_t> previous_index_;
+
     fmt::memory_buffer buf_;
-    utils::impl::TransparentMap<std::string, std::string> metrics_;
 };
 
+template <Typed IsTyped>
+void WriteChunked(
+    const utils::statistics::Storage& statistics,
+    const utils::statistics::Request& request,
+    const PrometheusFormatterSettings& settings,
+    const PrometheusFormatter::ChunkConsumer& consumer
+) {
+    ChunkSink sink{consumer, settings.chunk_size};
+    FormatBuilder<IsTyped> builder{&sink};
+    statistics.VisitMetrics(builder, request);
+    builder.Finish();
+}
+
 }  // namespace
 
 std::string ToPrometheusName(std::string_view data) {
@@ -195,6 +484,68 @@ ToPrometheusFormatUntyped(const utils::statistics::Storage& statistics, const ut
     return builder.Release();
 }
 
+struct PrometheusFormatter::Impl final {
+    explicit Impl(const PrometheusFormatterSettings& settings) : settings(settings) {}
+
+    // Returns false if the cache is disabled or is used by another call
+    bool TryWriteCached(
+        const utils::statistics::Storage& statistics,
+        const utils::statistics::Request& request,
+        const ChunkConsumer& consumer
+    ) {
+        if (!settings.cache_series) return false;
+        const std::unique_lock lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock()) return false;
+
+        impl::CachingFormatBuilder builder{cache, settings, consumer};
+        statistics.VisitMetrics(builder, request);
+        builder.Finish();
+        return true;
+    }
+
+    const PrometheusFormatterSettings settings;
+    engine::Mutex mutex;
+    impl::SeriesCache cache;
+};
+
+PrometheusFormatter::PrometheusFormatter(const PrometheusFormatterSettings& settings)
+    : impl_(std::make_unique<Impl>(settings)) {}
+
+PrometheusFormatter::~PrometheusFormatter() = default;
+
+std::string PrometheusFormatter::ToString(
+    const utils::statistics::Storage& statistics,
+    const utils::statistics::Request& request
+) const {
+    std::string result;
+    const auto consumer = [&result](std::string&& chunk) {
+        if (result.empty()) {
+            result = std::move(chunk);
+        } else {
+            result.append(chunk);
+        }
+    };
+    if (impl_->TryWriteCached(statistics, request, consumer)) return result;
+
+    return impl_->settings.typed ? ToPrometheusFormat(statistics, request)
+                                 : ToPrometheusFormatUntyped(statistics, request);
+}
+
+void PrometheusFormatter::Write(
+    const utils::statistics::Storage& statistics,
+    const utils::statistics::Request& request,
+    const ChunkConsumer& consumer
+) const {
+    if (impl_->TryWriteCached(statistics, request, consumer)) return;
+
+    // Formats as ToPrometheusFormat() does, only passing the output in parts
+    if (impl_->settings.typed) {
+        impl::WriteChunked<impl::Typed::kYes>(statistics, request, impl_->settings, consumer);
+    } else {
+        impl::WriteChunked<impl::Typed::kNo>(statistics, request, impl_->settings, consumer);
+    }
+}
+
 }  // namespace utils::statistics
 
 USERVER_NAMESPACE_END
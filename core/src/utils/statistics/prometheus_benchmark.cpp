@@ -0,0 +1,95 @@
+#include <userver/utils/statistics/prometheus.hpp>
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include <userver/engine/run_standalone.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
+#include <userver/utils/statistics/storage.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr std::size_t kHandlers = 1000;
+constexpr std::size_t kStatuses = 10;
+constexpr std::size_t kSeriesPerStatus = 10;
+
+// Writes kHandlers * kStatuses * kSeriesPerStatus series, like the metrics of
+// a service with a lot of handlers
+class ManySeries final {
+public:
+    explicit ManySeries(utils::statistics::Storage& storage)
+        : counters_(kHandlers * kStatuses * kSeriesPerStatus),
+          holder_(storage.RegisterWriter("http.handler", [this](utils::statistics::Writer& writer) {
+              Write(writer);
+          })) {}
+
+    // Changes the values of `share` of the series
+    void Change(double share) {
+        const auto step = static_cast<std::size_t>(1 / share);
+        for (std::size_t i = 0; i < counters_.size(); i += step) {
+            ++counters_[i];
+        }
+    }
+
+    std::size_t GetSeriesCount() const { return counters_.size(); }
+
+private:
+    void Write(utils::statistics::Writer& writer) const {
+        std::size_t index = 0;
+        for (std::size_t handler = 0; handler < kHandlers; ++handler) {
+            const auto path = "/v1/handler-" + std::to_string(handler);
+            for (std::size_t status = 0; status < kStatuses; ++status) {
+                const auto status_str = std::to_string(200 + status);
+                for (std::size_t series = 0; series < kSeriesPerStatus; ++series) {
+                    writer["reply-codes"]["series-" + std::to_string(series)].ValueWithLabels(
+                        counters_[index++], {{"http_path", path}, {"http_code", status_str}}
+                    );
+                }
+            }
+        }
+    }
+
+    std::vector<utils::statistics::RateCounter> counters_;
+    utils::statistics::Entry holder_;
+};
+
+}  // namespace
+
+void PrometheusFormatUncached(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        utils::statistics::Storage storage;
+        ManySeries metrics{storage};
+        for ([[maybe_unused]] auto _ : state) {
+            benchmark::DoNotOptimize(utils::statistics::ToPrometheusFormat(storage));
+        }
+        state.counters["series"] = metrics.GetSeriesCount();
+    });
+}
+BENCHMARK(PrometheusFormatUncached)->Unit(benchmark::kMillisecond);
+
+// The argument is the per mille of the series that change their values
+// between the scrapes
+void PrometheusFormatterCached(benchmark::State& state) {
+    engine::RunStandalone([&] {
+        utils::statistics::Storage storage;
+        ManySeries metrics{storage};
+        const utils::statistics::PrometheusFormatter formatter;
+        benchmark::DoNotOptimize(formatter.ToString(storage));
+
+        for ([[maybe_unused]] auto _ : state) {
+            if (state.range(0) != 0) {
+                state.PauseTiming();
+                metrics.Change(state.range(0) / 1000.0);
+                state.ResumeTiming();
+            }
+            formatter.Write(storage, {}, [](std::string&& chunk) { benchmark::DoNotOptimize(chunk); });
+        }
+        state.counters["series"] = metrics.GetSeriesCount();
+    });
+}
+BENCHMARK(PrometheusFormatterCached)->Arg(0)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+USERVER_NAMESPACE_END
@@ -1,9 +1,12 @@
 #include <algorithm>
+#include <stdexcept>
 
 #include <userver/utest/utest.hpp>
 
 #include <userver/formats/json/serialize.hpp>
+#include <userver/utils/statistics/histogram.hpp>
 #include <userver/utils/statistics/metadata.hpp>
+#include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/storage.hpp>
 #include <userver/utils/text.hpp>
 
@@ -26,13 +29,34 @@ void TestToMetricsPrometheus(
     const std::string_view expected,
     const bool sorted = false
 ) {
-    const auto result =
-        ToPrometheusFormat(statistics, utils::statistics::Request::MakeWithPrefix({}, {{"application", "processing"}}));
+    const auto request = utils::statistics::Request::MakeWithPrefix({}, {{"application", "processing"}});
+    const auto result = ToPrometheusFormat(statistics, request);
     if (sorted) {
         EXPECT_EQ(Sorted(expected), Sorted(result));
     } else {
         EXPECT_EQ(expected, result);
     }
+
+    const PrometheusFormatter formatter;
+    EXPECT_EQ(formatter.ToString(statistics, request), result);
+    // The second call uses the cached series
+    EXPECT_EQ(formatter.ToString(statistics, request), result);
+}
+
+struct ChangingMetrics final {
+    std::int64_t gauge{1};
+    RateCounter rate{2};
+    Histogram histogram{std::vector<double>{1.5, 5, 42}};
+    bool with_labels{true};
+};
+
+void DumpMetric(Writer& writer, const ChangingMetrics& metrics) {
+    writer["gauge"] = metrics.gauge;
+    writer["rate"] = metrics.rate;
+    writer["histogram"] = metrics.histogram;
+    if (metrics.with_labels) {
+        writer["gauge"].ValueWithLabels(metrics.gauge + 1, {{"label", "value \"quoted\""}, {"other.label", "x"}});
+    }
 }
 
 }  // namespace
@@ -392,6 +416,79 @@ child{application="processing"} 8
     }
 }
 
+UTEST(MetricsPrometheus, FormatterFollowsChanges) {
+    ChangingMetrics metrics;
+    utils::statistics::Storage storage;
+    auto holder = storage.RegisterWriter("changing", [&metrics](Writer& writer) { writer = metrics; });
+
+    const PrometheusFormatter typed;
+    const PrometheusFormatter untyped{{/*typed=*/false}};
+    const auto check = [&] {
+        EXPECT_EQ(typed.ToString(storage), ToPrometheusFormat(storage));
+        EXPECT_EQ(untyped.ToString(storage), ToPrometheusFormatUntyped(storage));
+    };
+
+    check();
+    check();
+
+    metrics.gauge = -5;
+    ++metrics.rate;
+    metrics.histogram.Account(3);
+    check();
+
+    // The series are forgotten and formatted anew
+    metrics.with_labels = false;
+    for (int i = 0; i < 10; ++i) check();
+    metrics.with_labels = true;
+    check();
+
+    const auto request = Request::MakeWithPrefix("changing.gauge", {{"application", "processing"}});
+    EXPECT_EQ(typed.ToString(storage, request), ToPrometheusFormat(storage, request));
+    check();
+}
+
+UTEST(MetricsPrometheus, FormatterChunks) {
+    ChangingMetrics metrics;
+    utils::statistics::Storage storage;
+    auto holder = storage.RegisterWriter("changing", [&metrics](Writer& writer) { writer = metrics; });
+
+    for (const bool cache_series : {true, false}) {
+        PrometheusFormatterSettings settings;
+        settings.cache_series = cache_series;
+        settings.chunk_size = 1;
+        const PrometheusFormatter formatter{settings};
+
+        std::vector<std::string> chunks;
+        formatter.Write(storage, {}, [&chunks](std::string&& chunk) { chunks.push_back(std::move(chunk)); });
+
+        EXPECT_GT(chunks.size(), 1) << "cache_series=" << cache_series;
+        EXPECT_EQ(utils::text::Join(chunks, ""), ToPrometheusFormat(storage)) << "cache_series=" << cache_series;
+    }
+}
+
+UTEST(MetricsPrometheus, FormatterConsumerThrows) {
+    ChangingMetrics metrics;
+    utils::statistics::Storage storage;
+    auto holder = storage.RegisterWriter("changing", [&metrics](Writer& writer) { writer = metrics; });
+
+    for (const bool cache_series : {true, false}) {
+        PrometheusFormatterSettings settings;
+        settings.cache_series = cache_series;
+        settings.chunk_size = 1;
+        const PrometheusFormatter formatter{settings};
+
+        std::size_t calls = 0;
+        const auto throwing_consumer = [&calls](std::string&&) {
+            ++calls;
+            throw std::runtime_error("client has gone");
+        };
+        UEXPECT_THROW_MSG(formatter.Write(storage, {}, throwing_consumer), std::runtime_error, "client has gone");
+        EXPECT_EQ(calls, 1);
+
+        EXPECT_EQ(formatter.ToString(storage), ToPrometheusFormat(storage));
+    }
+}
+
 }  // namespace utils::statistics::impl
 
 USERVER_NAMESPACE_END
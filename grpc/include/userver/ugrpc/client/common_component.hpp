@@ -29,6 +29,8 @@ namespace ugrpc::client {
 /// ---- | ----------- | -------------
 /// blocking-task-processor | the task processor for blocking channel creation | -
 /// native-log-level | min log level for the native gRPC library | 'error'
+/// timings-us | set to true to add the `timings-us` percentiles of the RPCs in microseconds | false
+/// timings-histogram | set to true to add the `timings-histogram` histogram of the RPCs in microseconds, see utils::statistics::kTimingsHistogramBounds | false
 ///
 /// @see ugrpc::client::ClientFactoryComponent
 
@@ -9,9 +9,10 @@
 #include <userver/ugrpc/impl/code_statistics.hpp>
 #include <userver/ugrpc/impl/static_metadata.hpp>
 
+#include <userver/engine/task/resource_usage.hpp>
 #include <userver/utils/fixed_array.hpp>
 #include <userver/utils/statistics/fwd.hpp>
-#include <userver/utils/statistics/percentile.hpp>
+#include <userver/utils/statistics/log_linear_histogram.hpp>
 #include <userver/utils/statistics/rate_counter.hpp>
 #include <userver/utils/statistics/recentperiod.hpp>
 
@@ -35,7 +36,7 @@ public:
 
     void AccountStatus(grpc::StatusCode code) noexcept;
 
-    void AccountTiming(std::chrono::milliseconds timing) noexcept;
+    void AccountTiming(std::chrono::microseconds timing) noexcept;
 
     // All errors without gRPC status codes are categorized as "network errors".
     // See server::RpcInterruptedError.
@@ -52,6 +53,9 @@ public:
 
     void AccountCancelled() noexcept;
 
+    // CPU time and memory allocations of a server handler
+    void AccountResourceUsage(const engine::TaskResourceUsage& usage) noexcept;
+
     friend void DumpMetric(utils::statistics::Writer& writer, const MethodStatistics& stats);
 
     std::uint64_t GetStarted() const noexcept;
@@ -59,7 +63,8 @@ public:
     void MoveStartedTo(MethodStatistics& other) noexcept;
 
 private:
-    using Percentile = utils::statistics::Percentile<2000, std::uint32_t, 256, 100>;
+    // Microseconds up to 134 seconds with 1.6% precision
+    using Percentile = utils::statistics::LogLinearHistogram<6, 27>;
     using Timings = utils::statistics::RecentPeriod<Percentile, Percentile>;
     using RateCounter = utils::statistics::RateCounter;
 
@@ -78,6 +83,10 @@ private:
 
     RateCounter deadline_updated_{0};
     RateCounter deadline_cancelled_{0};
+
+    RateCounter cpu_time_us_{0};
+    RateCounter allocated_bytes_{0};
+    RateCounter deallocated_bytes_{0};
 };
 
 struct MethodStatisticsSnapshot final {
@@ -90,6 +99,8 @@ struct MethodStatisticsSnapshot final {
     void Add(const MethodStatisticsSnapshot& other);
 
     StatisticsDomain domain;
+    // Not summed, set by the owner of the statistics
+    utils::statistics::TimingsMetrics timings_metrics{};
 
     Rate started{0};
     Rate started_renamed{0};
@@ -101,6 +112,10 @@ struct MethodStatisticsSnapshot final {
 
     Rate deadline_updated{0};
     Rate deadline_cancelled{0};
+
+    Rate cpu_time_us{0};
+    Rate allocated_bytes{0};
+    Rate deallocated_bytes{0};
 };
 
 void DumpMetric(utils::statistics::Writer& writer, const MethodStatisticsSnapshot& stats);
@@ -130,6 +145,7 @@ public:
 
     std::uint64_t GetStartedRequests() const;
 
+    // The method snapshots are written with the timings metrics of `total`
     void DumpAndCountTotal(
         utils::statistics::Writer& writer,
         std::optional<std::string_view> client_name,
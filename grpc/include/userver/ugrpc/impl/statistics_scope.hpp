@@ -6,6 +6,7 @@
 
 #include <grpcpp/support/status.h>
 
+#include <userver/engine/task/resource_usage.hpp>
 #include <userver/utils/not_null.hpp>
 
 USERVER_NAMESPACE_BEGIN
@@ -30,6 +31,10 @@ public:
 
     void OnNetworkError();
 
+    // Accounts the resources that the current task consumes until Flush.
+    // Must only be used if Flush is called from the same task.
+    void StartResourceUsageAccounting() noexcept;
+
     void Flush();
 
     // Not thread-safe with respect to Flush.
@@ -58,8 +63,11 @@ private:
 
     void AccountTiming();
 
+    void AccountResourceUsage() noexcept;
+
     utils::NotNull<MethodStatistics*> statistics_;
     std::optional<std::chrono::steady_clock::time_point> start_time_;
+    std::optional<engine::TaskResourceUsage> start_resource_usage_;
     FinishKind finish_kind_{FinishKind::kAutomatic};
     grpc::StatusCode finish_code_{};
     std::atomic<bool> is_cancelled_{false};
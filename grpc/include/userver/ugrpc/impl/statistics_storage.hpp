@@ -20,7 +20,11 @@ namespace ugrpc::impl {
 /// Allows to create ServiceStatistics and generic MethodStatistics on the fly.
 class StatisticsStorage final {
 public:
-    explicit StatisticsStorage(utils::statistics::Storage& statistics_storage, StatisticsDomain domain);
+    explicit StatisticsStorage(
+        utils::statistics::Storage& statistics_storage,
+        StatisticsDomain domain,
+        utils::statistics::TimingsMetrics timings_metrics = {}
+    );
 
     StatisticsStorage(const StatisticsStorage&) = delete;
     StatisticsStorage& operator=(const StatisticsStorage&) = delete;
@@ -80,6 +84,7 @@ private:
     void ExtendStatistics(utils::statistics::Writer& writer);
 
     const StatisticsDomain domain_;
+    const utils::statistics::TimingsMetrics timings_metrics_;
     utils::statistics::StripedRateCounter global_started_;
     concurrent::Variable<
         std::unordered_map<ServiceKey, ServiceStatistics, ServiceKeyHasher, ServiceKeyComparer>,
@@ -183,6 +183,7 @@ private:
         utils::FastScopeGuard destroy_span([&]() noexcept { span_.reset(); });
 
         ugrpc::impl::RpcStatisticsScope statistics_scope{method_data_.statistics};
+        statistics_scope.StartResourceUsageAccounting();
 
         auto& access_tskv_logger = method_data_.service_data.settings.access_tskv_logger;
         auto& statistics_storage = method_data_.service_data.settings.statistics_storage;
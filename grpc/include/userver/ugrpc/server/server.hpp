@@ -71,6 +71,9 @@ struct ServerConfig final {
     /// Serve a web page with runtime info about gRPC connections
     bool enable_channelz{false};
 
+    /// The optional metrics of the RPC timings in microseconds
+    utils::statistics::TimingsMetrics timings_metrics{};
+
     /// 'access-tskv.log' logger
     logging::LoggerPtr access_tskv_logger{logging::MakeNullLogger()};
 
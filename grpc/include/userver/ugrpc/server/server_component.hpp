@@ -33,6 +33,8 @@ struct ServiceDefaults;
 /// channel-args | a map of channel arguments, see gRPC Core docs | {}
 /// native-log-level | min log level for the native gRPC library | 'error'
 /// enable-channelz | initialize service with runtime info about gRPC connections | false
+/// timings-us | set to true to add the `timings-us` percentiles of the RPCs in microseconds | false
+/// timings-histogram | set to true to add the `timings-histogram` histogram of the RPCs in microseconds, see utils::statistics::kTimingsHistogramBounds | false
 /// service-defaults | default config values for gRPC services, see config schema | {}
 /// tls.cert | path to file with server TLS certificate | -
 /// tls.key | path to file with secret key from server TLS certificate | -
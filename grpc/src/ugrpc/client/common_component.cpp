@@ -47,7 +47,11 @@ CommonComponent::CommonComponent(const components::ComponentConfig& config, cons
       )),
       client_statistics_storage_(
           context.FindComponent<components::StatisticsStorage>().GetStorage(),
-          ugrpc::impl::StatisticsDomain::kClient
+          ugrpc::impl::StatisticsDomain::kClient,
+          utils::statistics::TimingsMetrics{
+              config["timings-us"].As<bool>(false),
+              config["timings-histogram"].As<bool>(false),
+          }
       ) {
     ugrpc::impl::SetupNativeLogging();
     ugrpc::impl::UpdateNativeLogLevel(config["native-log-level"].As<logging::Level>(logging::Level::kError));
@@ -78,6 +82,14 @@ properties:
             completion queue count to create. Should be ~2 times less than worker
             threads for best RPS.
         minimum: 1
+    timings-us:
+        type: boolean
+        description: set to true to add the `timings-us` percentiles of the RPCs in microseconds
+        defaultDescription: false
+    timings-histogram:
+        type: boolean
+        description: set to true to add the `timings-histogram` histogram of the RPCs in microseconds
+        defaultDescription: false
 )");
 }
 
@@ -24,7 +24,7 @@ void MethodStatistics::AccountStarted() noexcept {
 
 void MethodStatistics::AccountStatus(grpc::StatusCode code) noexcept { status_codes_.Account(code); }
 
-void MethodStatistics::AccountTiming(std::chrono::milliseconds timing) noexcept {
+void MethodStatistics::AccountTiming(std::chrono::microseconds timing) noexcept {
     timings_.GetCurrentCounter().Account(timing.count());
 }
 
@@ -38,6 +38,13 @@ void MethodStatistics::AccountDeadlinePropagated() noexcept { ++deadline_updated
 
 void MethodStatistics::AccountCancelled() noexcept { ++cancelled_; }
 
+void MethodStatistics::AccountResourceUsage(const engine::TaskResourceUsage& usage) noexcept {
+    const auto cpu_time_us = std::chrono::duration_cast<std::chrono::microseconds>(usage.cpu_time);
+    cpu_time_us_.Add(utils::statistics::Rate{static_cast<std::uint64_t>(cpu_time_us.count())});
+    allocated_bytes_.Add(utils::statistics::Rate{usage.allocated_bytes});
+    deallocated_bytes_.Add(utils::statistics::Rate{usage.deallocated_bytes});
+}
+
 void DumpMetric(utils::statistics::Writer& writer, const MethodStatistics& stats) {
     writer = MethodStatisticsSnapshot{stats};
 }
@@ -53,7 +60,7 @@ void DumpMetric(utils::statistics::Writer& writer, const MethodStatisticsSnapsho
         return;
     }
 
-    writer["timings"] = stats.timings;
+    utils::statistics::DumpTimings(writer, stats.timings, stats.timings_metrics);
 
     utils::statistics::Rate total_requests{};
     utils::statistics::Rate error_requests{};
@@ -107,6 +114,14 @@ void DumpMetric(utils::statistics::Writer& writer, const MethodStatisticsSnapsho
 
     writer["deadline-propagated"] = stats.deadline_updated;
     writer["cancelled-by-deadline-propagation"] = deadline_cancelled_value;
+
+    if (stats.domain == StatisticsDomain::kServer) {
+        // Client RPCs are completed outside of the calling task, so only the
+        // server handlers account the resources they consume
+        writer["cpu-time-us"] = stats.cpu_time_us;
+        writer["allocated-bytes"] = stats.allocated_bytes;
+        writer["deallocated-bytes"] = stats.deallocated_bytes;
+    }
 }
 
 MethodStatisticsSnapshot::MethodStatisticsSnapshot(const StatisticsDomain domain) : domain(domain) {}
@@ -120,7 +135,10 @@ MethodStatisticsSnapshot::MethodStatisticsSnapshot(const MethodStatistics& stats
       internal_errors(stats.internal_errors_.Load()),
       cancelled(stats.cancelled_.Load()),
       deadline_updated(stats.deadline_updated_.Load()),
-      deadline_cancelled(stats.deadline_cancelled_.Load()) {
+      deadline_cancelled(stats.deadline_cancelled_.Load()),
+      cpu_time_us(stats.cpu_time_us_.Load()),
+      allocated_bytes(stats.allocated_bytes_.Load()),
+      deallocated_bytes(stats.deallocated_bytes_.Load()) {
     // For the 'active' metric, it is important to load the 'started' value after
     // loading the 'started_renamed' and 'total_requests' values.
     // More details in DumpMetric for MethodStatisticsSnapshot
@@ -139,6 +157,9 @@ void MethodStatisticsSnapshot::Add(const MethodStatisticsSnapshot& other) {
     cancelled += other.cancelled;
     deadline_updated += other.deadline_updated;
     deadline_cancelled += other.deadline_cancelled;
+    cpu_time_us += other.cpu_time_us;
+    allocated_bytes += other.allocated_bytes;
+    deallocated_bytes += other.deallocated_bytes;
 }
 
 void DumpMetricWithLabels(
@@ -210,7 +231,8 @@ void ServiceStatistics::DumpAndCountTotal(
     MethodStatisticsSnapshot& total
 ) const {
     for (const auto& [i, method_full_name] : utils::enumerate(metadata_.method_full_names)) {
-        const MethodStatisticsSnapshot snapshot{method_statistics_[i]};
+        MethodStatisticsSnapshot snapshot{method_statistics_[i]};
+        snapshot.timings_metrics = total.timings_metrics;
         total.Add(snapshot);
         DumpMetricWithLabels(writer, snapshot, client_name, method_full_name, metadata_.service_full_name);
     }
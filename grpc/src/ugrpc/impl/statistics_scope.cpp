@@ -46,6 +46,10 @@ void RpcStatisticsScope::OnCancelled() {
     is_cancelled_.store(true, std::memory_order_relaxed);
 }
 
+void RpcStatisticsScope::StartResourceUsageAccounting() noexcept {
+    start_resource_usage_ = engine::current_task::GetResourceUsage();
+}
+
 void RpcStatisticsScope::Flush() {
     if (!start_time_) {
         return;
@@ -60,6 +64,7 @@ void RpcStatisticsScope::Flush() {
     }
 
     AccountTiming();
+    AccountResourceUsage();
     switch (finish_kind_) {
         case FinishKind::kAutomatic:
             statistics_->AccountStatus(grpc::StatusCode::UNKNOWN);
@@ -94,11 +99,18 @@ void RpcStatisticsScope::AccountTiming() {
     if (!start_time_) return;
 
     statistics_->AccountTiming(
-        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - *start_time_)
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - *start_time_)
     );
     start_time_.reset();
 }
 
+void RpcStatisticsScope::AccountResourceUsage() noexcept {
+    if (!start_resource_usage_) return;
+
+    statistics_->AccountResourceUsage(engine::current_task::GetResourceUsage() - *start_resource_usage_);
+    start_resource_usage_.reset();
+}
+
 }  // namespace ugrpc::impl
 
 USERVER_NAMESPACE_END
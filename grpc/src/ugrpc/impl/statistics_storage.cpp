@@ -21,8 +21,12 @@ std::string_view ToString(StatisticsDomain domain) {
     return utils::impl::EnumToStringView(domain, kMap);
 }
 
-StatisticsStorage::StatisticsStorage(utils::statistics::Storage& statistics_storage, StatisticsDomain domain)
-    : domain_(domain) {
+StatisticsStorage::StatisticsStorage(
+    utils::statistics::Storage& statistics_storage,
+    StatisticsDomain domain,
+    utils::statistics::TimingsMetrics timings_metrics
+)
+    : domain_(domain), timings_metrics_(timings_metrics) {
     statistics_holder_ = statistics_storage.RegisterWriter(
         fmt::format("grpc.{}", ToString(domain)),
         [this](utils::statistics::Writer& writer) { ExtendStatistics(writer); }
@@ -77,6 +81,7 @@ StatisticsStorage::GetGenericStatistics(std::string_view call_name, std::optiona
 
 void StatisticsStorage::ExtendStatistics(utils::statistics::Writer& writer) {
     MethodStatisticsSnapshot total{domain_};
+    total.timings_metrics = timings_metrics_;
 
     {
         auto by_destination = writer["by-destination"];
@@ -99,7 +104,8 @@ void StatisticsStorage::ExtendStatistics(utils::statistics::Writer& writer) {
 
                 const auto service_name = call_name.substr(0, slash_pos);
 
-                const MethodStatisticsSnapshot snapshot{method_stats};
+                MethodStatisticsSnapshot snapshot{method_stats};
+                snapshot.timings_metrics = timings_metrics_;
                 total.Add(snapshot);
                 DumpMetricWithLabels(by_destination, snapshot, key.client_name, call_name, service_name);
             }
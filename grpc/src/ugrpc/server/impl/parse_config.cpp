@@ -98,6 +98,8 @@ ServerConfig ParseServerConfig(const yaml_config::YamlConfig& value, const compo
     config.channel_args = value["channel-args"].As<decltype(config.channel_args)>({});
     config.native_log_level = value["native-log-level"].As<logging::Level>(logging::Level::kError);
     config.enable_channelz = value["enable-channelz"].As<bool>(false);
+    config.timings_metrics.percentiles_us = value["timings-us"].As<bool>(false);
+    config.timings_metrics.histogram = value["timings-histogram"].As<bool>(false);
 
     const auto ca = value["tls"]["ca"].As<std::optional<std::string>>();
     if (ca) {
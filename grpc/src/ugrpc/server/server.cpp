@@ -130,7 +130,7 @@ Server::Impl::Impl(
     utils::statistics::Storage& statistics_storage,
     dynamic_config::Source config_source
 )
-    : statistics_storage_(statistics_storage, ugrpc::impl::StatisticsDomain::kServer),
+    : statistics_storage_(statistics_storage, ugrpc::impl::StatisticsDomain::kServer, config.timings_metrics),
       config_source_(config_source),
       access_tskv_logger_(std::move(config.access_tskv_logger)) {
     LOG_INFO() << "Configuring the gRPC server";
@@ -82,6 +82,14 @@ properties:
     enable-channelz:
         type: boolean
         description: enable channelz
+    timings-us:
+        type: boolean
+        description: set to true to add the `timings-us` percentiles of the RPCs in microseconds
+        defaultDescription: false
+    timings-histogram:
+        type: boolean
+        description: set to true to add the `timings-histogram` histogram of the RPCs in microseconds
+        defaultDescription: false
     tls:
         type: object
         additionalProperties: false
@@ -77,7 +77,9 @@ std::chrono::milliseconds GetMongoCacheUpdateCorrection(const ComponentConfig&);
 ///   static constexpr auto kKeyField = &CachedObject::name;
 ///   // Type of kKeyField
 ///   using KeyType = std::string;
-///   // Type of cache map, e.g. unordered_map, map, bimap
+///   // Type of cache map, e.g. unordered_map, map, bimap. For caches with
+///   // incremental updates consider cache::PersistentHashMap: it is copied
+///   // in O(1) on each update instead of copying all the elements.
 ///   using DataType = std::unordered_map<KeyType, ObjectType>;
 ///
 ///   // Whether the cache prefers to read from replica (if true, you might get stale data)
@@ -234,7 +236,12 @@ void MongoCache<MongoCacheTraits>::Update(
             auto key = (object.*MongoCacheTraits::kKeyField);
 
             if (type == cache::UpdateType::kIncremental || new_cache->count(key) == 0) {
-                (*new_cache)[key] = std::move(object);
+                if constexpr (mongo_cache::impl::kHasInsertOrAssign<typename MongoCacheTraits::DataType>) {
+                    // Does not copy the old value of persistent containers
+                    new_cache->insert_or_assign(std::move(key), std::move(object));
+                } else {
+                    (*new_cache)[key] = std::move(object);
+                }
             } else {
                 LOG_LIMITED_ERROR() << "Found duplicate key for 2 items in cache " << MongoCacheTraits::kName
                                     << ", key=" << key;
@@ -39,6 +39,14 @@ using DataType = typename T::DataType;
 template <typename T>
 inline constexpr bool kHasValidDataType = meta::kIsMap<meta::DetectedType<DataType, T>>;
 
+template <typename T>
+using HasInsertOrAssign = decltype(std::declval<T&>().insert_or_assign(
+    std::declval<const typename T::key_type&>(),
+    std::declval<typename T::mapped_type&&>()
+));
+template <typename T>
+inline constexpr bool kHasInsertOrAssign = meta::kIsDetected<HasInsertOrAssign, T>;
+
 template <typename T>
 using HasSecondaryPreferred = decltype(T::kIsSecondaryPreferred);
 template <typename T>
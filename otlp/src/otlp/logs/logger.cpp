@@ -1,6 +1,8 @@
 #include "logger.hpp"
 
+#include <charconv>
 #include <chrono>
+#include <cstdint>
 #include <iostream>
 
 #include <userver/engine/async.hpp>
@@ -12,6 +14,7 @@
 #include <userver/utils/assert.hpp>
 #include <userver/utils/encoding/hex.hpp>
 #include <userver/utils/encoding/tskv_parser_read.hpp>
+#include <userver/utils/from_string.hpp>
 #include <userver/utils/overloaded.hpp>
 #include <userver/utils/text_light.hpp>
 
@@ -25,6 +28,11 @@ constexpr std::string_view kTelemetrySdkName = "telemetry.sdk.name";
 constexpr std::string_view kServiceName = "service.name";
 
 const std::string kTimestampFormat = "%Y-%m-%dT%H:%M:%E*S";
+
+std::uint64_t ToUnixNano(std::chrono::system_clock::time_point timestamp) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timestamp.time_since_epoch()).count();
+}
+
 }  // namespace
 
 SinkType Parse(const yaml_config::YamlConfig& value, formats::parse::To<SinkType>) {
@@ -46,7 +54,7 @@ Logger::Logger(
     opentelemetry::proto::collector::trace::v1::TraceServiceClient trace_client,
     LoggerConfig&& config
 )
-    : LoggerBase(logging::Format::kTskv),
+    : LoggerBase(logging::Format::kStructured),
       config_(std::move(config)),
       queue_(Queue::Create(config_.max_queue_size)),
       queue_producer_(queue_->GetMultiProducer()) {
@@ -77,6 +85,85 @@ void Logger::PrependCommonTags(logging::impl::TagWriter writer) const {
 
 bool Logger::DoShouldLog(logging::Level level) const noexcept { return logging::impl::default_::DoShouldLog(level); }
 
+void Logger::LogStructured(const logging::impl::LogRecord& record) {
+    if (config_.logs_sink == SinkType::kDefault || config_.logs_sink == SinkType::kBoth) {
+        if (default_logger_) default_logger_->LogStructured(record);
+        if (config_.logs_sink == SinkType::kDefault) {
+            return;
+        }
+    }
+
+    ::opentelemetry::proto::logs::v1::LogRecord log_record;
+
+    ++stats_.by_level[static_cast<int>(record.level)];
+
+    log_record.mutable_body()->set_string_value(grpc::string(record.text));
+    log_record.set_severity_text(grpc::string(logging::ToUpperCaseString(record.level)));
+    log_record.set_time_unix_nano(ToUnixNano(record.timestamp));
+
+    for (const auto& tag : record.tags) {
+        if (tag.key == "trace_id") {
+            log_record.set_trace_id(utils::encoding::FromHex(tag.value));
+        } else if (tag.key == "span_id") {
+            log_record.set_span_id(utils::encoding::FromHex(tag.value));
+        } else {
+            AddAttribute(*log_record.add_attributes(), tag);
+        }
+    }
+
+    // Drop a log if overflown
+    auto ok = queue_producer_.PushNoblock(std::move(log_record));
+    if (!ok) {
+        ++stats_.dropped;
+    }
+}
+
+void Logger::TraceStructured(const logging::impl::LogRecord& record) {
+    if (config_.tracing_sink == SinkType::kDefault || config_.tracing_sink == SinkType::kBoth) {
+        if (default_logger_) default_logger_->TraceStructured(record);
+        if (config_.tracing_sink == SinkType::kDefault) {
+            return;
+        }
+    }
+
+    ::opentelemetry::proto::trace::v1::Span span;
+
+    std::string_view start_timestamp;
+    std::string_view total_time;
+
+    for (const auto& tag : record.tags) {
+        if (tag.key == "trace_id") {
+            span.set_trace_id(utils::encoding::FromHex(tag.value));
+        } else if (tag.key == "span_id") {
+            span.set_span_id(utils::encoding::FromHex(tag.value));
+        } else if (tag.key == "parent_id") {
+            span.set_parent_span_id(utils::encoding::FromHex(tag.value));
+        } else if (tag.key == "stopwatch_name") {
+            span.set_name(std::string(tag.value));
+        } else if (tag.key == "total_time") {
+            total_time = tag.value;
+        } else if (tag.key == "start_timestamp") {
+            start_timestamp = tag.value;
+        } else {
+            AddAttribute(*span.add_attributes(), tag);
+        }
+    }
+
+    auto start_timestamp_double = utils::FromString<double>(start_timestamp);
+    span.set_start_time_unix_nano(start_timestamp_double * 1'000'000'000);
+    span.set_end_time_unix_nano(
+        (start_timestamp_double + utils::FromString<double>(total_time) / 1'000) * 1'000'000'000LL
+    );
+
+    // Drop a trace if overflown
+    auto ok = queue_producer_.PushNoblock(std::move(span));
+    if (!ok) {
+        ++stats_.dropped;
+    }
+}
+
+// Text records only come from the loggers that forward to this one, e.g. from
+// the MemLogger that collects the logs written before the logger has started
 void Logger::Log(logging::Level level, std::string_view msg) {
     if (config_.logs_sink == SinkType::kDefault || config_.logs_sink == SinkType::kBoth) {
         if (default_logger_) default_logger_->Log(level, msg);
@@ -297,6 +384,38 @@ void Logger::DoTrace(
     // TODO: count exceptions
 }
 
+void Logger::AddAttribute(
+    ::opentelemetry::proto::common::v1::KeyValue& attribute,
+    const logging::impl::LogTag& tag
+) const {
+    attribute.set_key(std::string{MapAttribute(tag.key)});
+    auto& value = *attribute.mutable_value();
+
+    switch (tag.type) {
+        case logging::impl::TagType::kInteger: {
+            std::int64_t result = 0;
+            const auto* const end = tag.value.data() + tag.value.size();
+            const auto [ptr, ec] = std::from_chars(tag.value.data(), end, result);
+            // Large unsigned values go as strings
+            if (ec == std::errc{} && ptr == end) {
+                value.set_int_value(result);
+                return;
+            }
+            break;
+        }
+        case logging::impl::TagType::kFloat:
+            // 'inf' and 'nan' go as strings
+            if (!tag.value.empty() && tag.value.find_first_of("in") == std::string_view::npos) {
+                value.set_double_value(utils::FromString<double>(tag.value));
+                return;
+            }
+            break;
+        case logging::impl::TagType::kString:
+            break;
+    }
+    value.set_string_value(std::string{tag.value});
+}
+
 std::string_view Logger::MapAttribute(std::string_view attr) const {
     for (const auto& [key, value] : config_.attributes_mapping) {
         if (key == attr) return value;
@@ -9,6 +9,7 @@
 #include <userver/concurrent/queue.hpp>
 #include <userver/engine/task/task.hpp>
 #include <userver/formats/yaml.hpp>
+#include <userver/logging/impl/log_record.hpp>
 #include <userver/logging/impl/log_stats.hpp>
 #include <userver/logging/impl/logger_base.hpp>
 #include <userver/yaml_config/yaml_config.hpp>
@@ -45,6 +46,10 @@ public:
 
     void Trace(logging::Level level, std::string_view msg) override;
 
+    void LogStructured(const logging::impl::LogRecord& record) override;
+
+    void TraceStructured(const logging::impl::LogRecord& record) override;
+
     void PrependCommonTags(logging::impl::TagWriter writer) const override;
 
     void Stop() noexcept;
@@ -73,6 +78,8 @@ private:
 
     std::string_view MapAttribute(std::string_view attr) const;
 
+    void AddAttribute(::opentelemetry::proto::common::v1::KeyValue& attribute, const logging::impl::LogTag& tag) const;
+
     logging::impl::LogStatistics stats_;
     const LoggerConfig config_;
     std::shared_ptr<Queue> queue_;
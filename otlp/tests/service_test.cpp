@@ -1,5 +1,6 @@
 #include <userver/utest/utest.hpp>
 
+#include <unordered_map>
 #include <vector>
 
 #include <otlp/logs/logger.hpp>
@@ -131,6 +132,28 @@ UTEST_F(LogServiceTest, SmokeLogs) {
         << log.time_unix_nano() - timestamp.count() - 1'000'000'000;
 }
 
+UTEST_F(LogServiceTest, TypedAttributes) {
+    LOG_INFO() << "log" << logging::LogExtra{{"int_attr", 42}, {"double_attr", 0.5}, {"string_attr", "42"}};
+
+    while (GetService1().logs.size() < 1) {
+        engine::SleepFor(std::chrono::milliseconds(10));
+    }
+
+    std::unordered_map<std::string, opentelemetry::proto::common::v1::AnyValue> attributes;
+    for (const auto& attribute : GetService1().logs[0].attributes()) {
+        attributes.emplace(attribute.key(), attribute.value());
+    }
+
+    ASSERT_EQ(attributes.count("int_attr"), 1);
+    EXPECT_EQ(attributes["int_attr"].int_value(), 42);
+    ASSERT_EQ(attributes.count("double_attr"), 1);
+    EXPECT_EQ(attributes["double_attr"].double_value(), 0.5);
+    ASSERT_EQ(attributes.count("string_attr"), 1);
+    EXPECT_EQ(attributes["string_attr"].string_value(), "42");
+    EXPECT_EQ(attributes.count("text"), 0);
+    EXPECT_EQ(attributes.count("timestamp"), 0);
+}
+
 UTEST_F(LogServiceTest, SmokeTrace) {
     auto timestamp =
         std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch());
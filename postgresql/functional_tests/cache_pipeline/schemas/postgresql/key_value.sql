@@ -0,0 +1,5 @@
+CREATE TABLE IF NOT EXISTS key_value_history (
+  position SERIAL PRIMARY KEY,
+  key VARCHAR NOT NULL,
+  value VARCHAR NOT NULL
+)
@@ -0,0 +1,69 @@
+#include <userver/clients/dns/component.hpp>
+#include <userver/testsuite/testsuite_support.hpp>
+
+#include <userver/utest/using_namespace_userver.hpp>
+
+#include <userver/clients/http/component.hpp>
+#include <userver/components/minimal_server_component_list.hpp>
+#include <userver/server/handlers/exceptions.hpp>
+#include <userver/server/handlers/http_handler_base.hpp>
+#include <userver/server/handlers/tests_control.hpp>
+#include <userver/utils/daemon_run.hpp>
+
+#include <userver/storages/postgres/component.hpp>
+
+#include <userver/cache/base_postgres_cache.hpp>
+
+namespace pg::cache_pipeline {
+
+struct KeyValue {
+    std::string key;
+    std::string value;
+};
+
+struct KeyValueCachePolicy {
+    static constexpr std::string_view kName = "key-value-pg-cache";
+
+    using ValueType = KeyValue;
+    static constexpr auto kKeyMember = &KeyValue::key;
+    // The later rows with the same key must override the earlier ones
+    static constexpr const char* kQuery = "SELECT key, value FROM key_value_history ORDER BY position";
+    static constexpr const char* kUpdatedField = "";
+};
+
+using KeyValueCache = components::PostgreCache<KeyValueCachePolicy>;
+
+class CacheHandler final : public server::handlers::HttpHandlerBase {
+public:
+    static constexpr std::string_view kName = "handler-cache";
+
+    CacheHandler(const components::ComponentConfig& config, const components::ComponentContext& context)
+        : HttpHandlerBase(config, context), cache_(context.FindComponent<KeyValueCache>()) {}
+
+    std::string HandleRequestThrow(const server::http::HttpRequest& request, server::request::RequestContext&)
+        const override {
+        const auto data = cache_.Get();
+        const auto it = data->find(request.GetArg("key"));
+        if (it == data->end()) {
+            throw server::handlers::ResourceNotFound(server::handlers::ExternalBody{"No such key"});
+        }
+        return it->second.value;
+    }
+
+private:
+    KeyValueCache& cache_;
+};
+
+}  // namespace pg::cache_pipeline
+
+int main(int argc, char* argv[]) {
+    const auto component_list = components::MinimalServerComponentList()
+                                    .Append<pg::cache_pipeline::CacheHandler>()
+                                    .Append<pg::cache_pipeline::KeyValueCache>()
+                                    .Append<components::HttpClient>()
+                                    .Append<components::Postgres>("key-value-database")
+                                    .Append<components::TestsuiteSupport>()
+                                    .Append<server::handlers::TestsControl>()
+                                    .Append<clients::dns::Component>();
+    return utils::DaemonMain(argc, argv, component_list);
+}
@@ -0,0 +1,13 @@
+import pytest
+
+from testsuite.databases.pgsql import discover
+
+pytest_plugins = ['pytest_userver.plugins.postgresql']
+
+
+@pytest.fixture(scope='session')
+def pgsql_local(service_source_dir, pgsql_local_create):
+    databases = discover.find_schemas(
+        'pg', [service_source_dir.joinpath('schemas/postgresql')],
+    )
+    return pgsql_local_create(list(databases.values()))
@@ -0,0 +1,22 @@
+async def _get_value(service_client, key: str):
+    response = await service_client.get('/cache', params={'key': key})
+    if response.status == 404:
+        return None
+    assert response.status == 200
+    return response.text
+
+
+async def test_later_rows_override(service_client, pgsql):
+    cursor = pgsql['key_value'].cursor()
+    cursor.execute(
+        'INSERT INTO key_value_history (key, value) VALUES '
+        "('a', 'a-1'), ('b', 'b-1'), ('c', 'c-1'), ('d', 'd-1'), "
+        "('a', 'a-2'), ('e', 'e-1'), ('b', 'b-2'), ('a', 'a-3')",
+    )
+    await service_client.invalidate_caches()
+
+    assert await _get_value(service_client, 'a') == 'a-3'
+    assert await _get_value(service_client, 'b') == 'b-2'
+    assert await _get_value(service_client, 'c') == 'c-1'
+    assert await _get_value(service_client, 'e') == 'e-1'
+    assert await _get_value(service_client, 'f') is None
@@ -6,10 +6,13 @@
 #include <userver/cache/base_postgres_cache_fwd.hpp>
 
 #include <chrono>
+#include <deque>
 #include <map>
+#include <optional>
 #include <string_view>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -23,9 +26,12 @@
 #include <userver/storages/postgres/io/chrono.hpp>
 
 #include <userver/compiler/demangle.hpp>
+#include <userver/concurrent/queue.hpp>
+#include <userver/engine/future.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/tracing/span.hpp>
 #include <userver/utils/assert.hpp>
+#include <userver/utils/async.hpp>
 #include <userver/utils/cpu_relax.hpp>
 #include <userver/utils/meta.hpp>
 #include <userver/utils/void_t.hpp>
@@ -66,6 +72,25 @@ namespace components {
 /// incremental-update-op-timeout | timeout for an incremental update | 1s
 /// update-correction | incremental update window adjustment | - (0 for caches with defined GetLastKnownUpdated)
 /// chunk-size | number of rows to request from PostgreSQL via portals, 0 to fetch all rows in one request without portals | 1000
+/// pipeline-depth | number of fetched chunks that may wait for parsing and insertion while the next chunk is fetched, 0 to fetch, parse and insert the chunks one after another; requires non-zero `chunk-size` | 0
+///
+/// ### Update pipelining
+///
+/// By default an update fetches a chunk of rows, parses and inserts it into
+/// the new cache data, and only then fetches the next chunk, so the CPU idles
+/// during the round-trips to the database. With a non-zero `pipeline-depth`
+/// each fetched chunk is parsed in a separate task, and a dedicated task
+/// inserts the parsed chunks in the order of fetching, so the fetching of
+/// the next chunks overlaps with the parsing and the insertion. A row still
+/// overwrites the previous rows with the same key, as in the sequential mode.
+/// The memory for about `pipeline-depth` chunks of rows and parsed values is
+/// required in addition to the cache data.
+///
+/// The time spent in each stage of the last update is reported in the
+/// `time.last-update-stage-duration-ms` cache metrics, see
+/// cache::UpdateStatisticsScope::AddStageDuration. The stages are `copy_data`,
+/// `fetch`, `parse` and, with pipelining, `insert`. Without pipelining the
+/// insertion is accounted in `parse`. With pipelining the stages overlap.
 ///
 /// @section pg_cc_cache_policy Cache policy
 ///
@@ -97,6 +122,14 @@ namespace components {
 ///
 /// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Custom Container With Write Notification Example
 ///
+/// For caches with incremental updates consider cache::PersistentHashMap as
+/// a CacheContainer. Each update works on a copy of the previous cache data,
+/// and a copy of cache::PersistentHashMap is made in O(1) and shares the
+/// unmodified elements with the original, so an update costs
+/// O(delta * log(size)) instead of O(size).
+///
+/// @snippet cache/postgres_cache_test.cpp Pg Cache Policy Persistent Container Example
+///
 /// @section pg_cc_forward_declaration Forward Declaration
 ///
 /// To forward declare a cache you can forward declare a trait and
@@ -368,6 +401,7 @@ inline constexpr std::chrono::milliseconds kCpuRelaxInterval{2};
 inline constexpr std::string_view kCopyStage = "copy_data";
 inline constexpr std::string_view kFetchStage = "fetch";
 inline constexpr std::string_view kParseStage = "parse";
+inline constexpr std::string_view kInsertStage = "insert";
 
 inline constexpr std::size_t kDefaultChunkSize = 1000;
 }  // namespace pg_cache::detail
@@ -402,6 +436,26 @@ public:
 private:
     using CachedData = std::unique_ptr<DataType>;
 
+    struct ParsedChunk final {
+        std::vector<ValueType> values;
+        std::size_t parse_failures{0};
+        std::chrono::steady_clock::time_point parse_start{};
+        std::chrono::steady_clock::duration parse_duration{};
+    };
+
+    struct PipelineTotals final {
+        std::size_t rows{0};
+        std::size_t parse_failures{0};
+        // Summed over the concurrent parse tasks, for the stage statistics
+        std::chrono::steady_clock::duration parse_duration{};
+        std::chrono::steady_clock::duration insert_duration{};
+        // From the start of the first parsing till the end of the last
+        // insertion, for the CPU relax calibration
+        std::chrono::steady_clock::duration wall_duration{};
+    };
+
+    using ParseQueue = concurrent::SpscQueue<engine::Future<ParsedChunk>>;
+
     UpdatedFieldType GetLastUpdated(std::chrono::system_clock::time_point last_update, const DataType& cache) const;
 
     void Update(
@@ -421,6 +475,16 @@ private:
         tracing::ScopeTime& scope
     );
 
+    PipelineTotals FetchPipelined(
+        storages::postgres::Portal& portal,
+        DataType& data_cache,
+        cache::UpdateStatisticsScope& stats_scope,
+        tracing::ScopeTime& scope
+    );
+    ParsedChunk ParseChunk(storages::postgres::ResultSet res) const;
+
+    static void LogParseError(const std::exception& e);
+
     static storages::postgres::Query GetAllQuery();
     static storages::postgres::Query GetDeltaQuery();
 
@@ -432,6 +496,7 @@ private:
     const std::chrono::milliseconds full_update_timeout_;
     const std::chrono::milliseconds incremental_update_timeout_;
     const std::size_t chunk_size_;
+    const std::size_t pipeline_depth_;
     std::size_t cpu_relax_iterations_parse_{0};
     std::size_t cpu_relax_iterations_copy_{0};
 };
@@ -448,7 +513,8 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config, co
       incremental_update_timeout_{config["incremental-update-op-timeout"].As<std::chrono::milliseconds>(
           pg_cache::detail::kDefaultIncrementalUpdateTimeout
       )},
-      chunk_size_{config["chunk-size"].As<size_t>(pg_cache::detail::kDefaultChunkSize)} {
+      chunk_size_{config["chunk-size"].As<size_t>(pg_cache::detail::kDefaultChunkSize)},
+      pipeline_depth_{config["pipeline-depth"].As<size_t>(0)} {
     UINVARIANT(
         !chunk_size_ || storages::postgres::Portal::IsSupportedByDriver(),
         "Either set 'chunk-size' to 0, or enable PostgreSQL portals by building "
@@ -462,6 +528,12 @@ PostgreCache<PostgreCachePolicy>::PostgreCache(const ComponentConfig& config, co
             config.Name() + "' cache"
         );
     }
+    if (pipeline_depth_ > 0 && chunk_size_ == 0) {
+        throw std::logic_error(
+            "Update pipelining is requested in config for '" + config.Name() +
+            "' cache, but it requires a non-zero 'chunk-size'"
+        );
+    }
     if (correction_.count() < 0) {
         throw std::logic_error(
             "Refusing to set forward (negative) update correction requested in "
@@ -570,6 +642,9 @@ void PostgreCache<PostgreCachePolicy>::Update(
     scope.Reset(std::string{pg_cache::detail::kFetchStage});
 
     size_t changes = 0;
+    // Parsing and insertion of the pipelined updates are not measured by scope,
+    // their wall time is used instead
+    std::chrono::steady_clock::duration pipelined_parse_duration{};
     // Iterate clusters
     for (auto& cluster : clusters_) {
         if (chunk_size_ > 0) {
@@ -579,14 +654,20 @@ void PostgreCache<PostgreCachePolicy>::Update(
                 pg::CommandControl{timeout, pg_cache::detail::kStatementTimeoutOff}
             );
             auto portal = trx.MakePortal(query, GetLastUpdated(last_update, *data_cache));
-            while (portal) {
-                scope.Reset(std::string{pg_cache::detail::kFetchStage});
-                auto res = portal.Fetch(chunk_size_);
-                stats_scope.IncreaseDocumentsReadCount(res.Size());
-
-                scope.Reset(std::string{pg_cache::detail::kParseStage});
-                CacheResults(res, data_cache, stats_scope, scope);
-                changes += res.Size();
+            if (pipeline_depth_ > 0) {
+                const auto totals = FetchPipelined(portal, *data_cache, stats_scope, scope);
+                pipelined_parse_duration += totals.wall_duration;
+                changes += totals.rows;
+            } else {
+                while (portal) {
+                    scope.Reset(std::string{pg_cache::detail::kFetchStage});
+                    auto res = portal.Fetch(chunk_size_);
+                    stats_scope.IncreaseDocumentsReadCount(res.Size());
+
+                    scope.Reset(std::string{pg_cache::detail::kParseStage});
+                    CacheResults(res, data_cache, stats_scope, scope);
+                    changes += res.Size();
+                }
             }
             trx.Commit();
         } else {
@@ -627,7 +708,8 @@ void PostgreCache<PostgreCachePolicy>::Update(
     }
 
     if (changes > 0) {
-        const auto elapsed_parse = scope.ElapsedTotal(std::string{pg_cache::detail::kParseStage});
+        const auto elapsed_parse = scope.ElapsedTotal(std::string{pg_cache::detail::kParseStage}) +
+                                   tracing::ScopeTime::DurationMillis{pipelined_parse_duration};
         if (elapsed_parse > pg_cache::detail::kCpuRelaxThreshold) {
             cpu_relax_iterations_parse_ = static_cast<std::size_t>(
                 static_cast<double>(changes) / (elapsed_parse / pg_cache::detail::kCpuRelaxInterval)
@@ -637,6 +719,11 @@ void PostgreCache<PostgreCachePolicy>::Update(
                         << " iterations";
         }
     }
+    using pg_cache::detail::kCopyStage, pg_cache::detail::kFetchStage, pg_cache::detail::kParseStage;
+    for (const auto stage : {kCopyStage, kFetchStage, kParseStage}) {
+        stats_scope.AddStageDuration(stage, scope.DurationTotal(std::string{stage}));
+    }
+
     if (changes > 0 || type == cache::UpdateType::kFull) {
         // Set current cache
         pg_cache::detail::OnWritesDone(*data_cache);
@@ -670,12 +757,118 @@ void PostgreCache<PostgreCachePolicy>::CacheResults(
             );
         } catch (const std::exception& e) {
             stats_scope.IncreaseDocumentsParseFailures(1);
-            LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '"
-                        << compiler::GetTypeName<ValueType>() << "': " << e.what();
+            LogParseError(e);
         }
     }
 }
 
+template <typename PostgreCachePolicy>
+typename PostgreCache<PostgreCachePolicy>::PipelineTotals PostgreCache<PostgreCachePolicy>::FetchPipelined(
+    storages::postgres::Portal& portal,
+    DataType& data_cache,
+    cache::UpdateStatisticsScope& stats_scope,
+    tracing::ScopeTime& scope
+) {
+    // The chunks are parsed concurrently, but inserted one by one in the order
+    // of fetching, so that the later rows with the same key win
+    auto queue = ParseQueue::Create(pipeline_depth_);
+    auto insert_task = utils::Async("pg_cache_insert", [this, consumer = queue->GetConsumer(), &data_cache] {
+        PipelineTotals totals;
+        utils::CpuRelax relax{cpu_relax_iterations_parse_, nullptr};
+        std::optional<std::chrono::steady_clock::time_point> first_parse_start;
+        engine::Future<ParsedChunk> parsed;
+        while (consumer.Pop(parsed)) {
+            auto chunk = parsed.get();
+            if (!first_parse_start) first_parse_start = chunk.parse_start;
+            totals.parse_failures += chunk.parse_failures;
+            totals.parse_duration += chunk.parse_duration;
+
+            const auto insert_start = std::chrono::steady_clock::now();
+            for (auto& value : chunk.values) {
+                relax.Relax();
+                try {
+                    using pg_cache::detail::CacheInsertOrAssign;
+                    CacheInsertOrAssign(data_cache, std::move(value), PostgreCachePolicy::kKeyMember);
+                } catch (const std::exception& e) {
+                    ++totals.parse_failures;
+                    LogParseError(e);
+                }
+            }
+            totals.insert_duration += std::chrono::steady_clock::now() - insert_start;
+        }
+        if (first_parse_start) totals.wall_duration = std::chrono::steady_clock::now() - *first_parse_start;
+        return totals;
+    });
+
+    std::size_t rows = 0;
+    // The results are passed through the queue, only the running tasks are
+    // kept here. They must outlive the insertion that waits for them.
+    std::deque<engine::TaskWithResult<void>> parse_tasks;
+    {
+        auto producer = queue->GetProducer();
+        while (portal) {
+            scope.Reset(std::string{pg_cache::detail::kFetchStage});
+            auto res = portal.Fetch(chunk_size_);
+            scope.Reset();
+            stats_scope.IncreaseDocumentsReadCount(res.Size());
+            rows += res.Size();
+
+            // Waits while pipeline_depth_ chunks are waiting for insertion,
+            // so that the chunk is parsed only when it has a place in the
+            // queue; fails if the insertion has failed
+            engine::Promise<ParsedChunk> promise;
+            if (!producer.Push(promise.get_future())) break;
+            parse_tasks.push_back(
+                utils::Async("pg_cache_parse", [this, res = std::move(res), promise = std::move(promise)]() mutable {
+                    try {
+                        promise.set_value(ParseChunk(std::move(res)));
+                    } catch (const std::exception&) {
+                        promise.set_exception(std::current_exception());
+                    }
+                })
+            );
+            while (!parse_tasks.empty() && parse_tasks.front().IsFinished()) parse_tasks.pop_front();
+        }
+    }
+
+    auto totals = insert_task.Get();
+    totals.rows = rows;
+    stats_scope.IncreaseDocumentsParseFailures(totals.parse_failures);
+    stats_scope.AddStageDuration(pg_cache::detail::kParseStage, totals.parse_duration);
+    stats_scope.AddStageDuration(pg_cache::detail::kInsertStage, totals.insert_duration);
+    return totals;
+}
+
+template <typename PostgreCachePolicy>
+typename PostgreCache<PostgreCachePolicy>::ParsedChunk PostgreCache<PostgreCachePolicy>::ParseChunk(
+    storages::postgres::ResultSet res
+) const {
+    ParsedChunk chunk;
+    chunk.parse_start = std::chrono::steady_clock::now();
+    chunk.values.reserve(res.Size());
+
+    auto values = res.AsSetOf<RawValueType>(storages::postgres::kRowTag);
+    utils::CpuRelax relax{cpu_relax_iterations_parse_, nullptr};
+    for (auto p = values.begin(); p != values.end(); ++p) {
+        relax.Relax();
+        try {
+            chunk.values.push_back(pg_cache::detail::ExtractValue<PostgreCachePolicy>(*p));
+        } catch (const std::exception& e) {
+            ++chunk.parse_failures;
+            LogParseError(e);
+        }
+    }
+
+    chunk.parse_duration = std::chrono::steady_clock::now() - chunk.parse_start;
+    return chunk;
+}
+
+template <typename PostgreCachePolicy>
+void PostgreCache<PostgreCachePolicy>::LogParseError(const std::exception& e) {
+    LOG_ERROR() << "Error parsing data row in cache '" << kName << "' to '" << compiler::GetTypeName<ValueType>()
+                << "': " << e.what();
+}
+
 template <typename PostgreCachePolicy>
 typename PostgreCache<PostgreCachePolicy>::CachedData
 PostgreCache<PostgreCachePolicy>::GetDataSnapshot(cache::UpdateType type, tracing::ScopeTime& scope) {
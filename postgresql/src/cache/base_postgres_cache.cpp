@@ -28,6 +28,11 @@ properties:
         type: integer
         description: number of rows to request from PostgreSQL, 0 to fetch all rows in one request
         defaultDescription: 1000
+    pipeline-depth:
+        type: integer
+        description: number of fetched chunks that may wait for parsing and insertion while the next chunk is fetched, 0 to process the chunks one after another
+        defaultDescription: 0
+        minimum: 0
     pgcomponent:
         type: string
         description: PostgreSQL component name
@@ -4,6 +4,7 @@
 
 #include <boost/functional/hash.hpp>
 
+#include <userver/cache/persistent_hash_map.hpp>
 #include <userver/components/minimal_server_component_list.hpp>
 #include <userver/utils/projected_set.hpp>
 
@@ -277,6 +278,19 @@ struct PostgresExamplePolicy7 {
     using CacheContainer = utils::ProjectedUnorderedSet<ValueType, kKeyMember>;
 };
 
+/*! [Pg Cache Policy Persistent Container Example] */
+struct PostgresExamplePolicy8 {
+    static constexpr std::string_view kName = "my-pg-cache";
+    using ValueType = MyStructure;
+    static constexpr auto kKeyMember = &MyStructure::id;
+    static constexpr const char* kQuery = "select id, bar, updated from test.my_data";
+    static constexpr const char* kUpdatedField = "updated";
+    using UpdatedFieldType = storages::postgres::TimePointTz;
+    // Incremental updates copy only the modified parts of the container
+    using CacheContainer = cache::PersistentHashMap<int, MyStructure>;
+};
+/*! [Pg Cache Policy Persistent Container Example] */
+
 // Instantiation test
 using MyCache1 = PostgreCache<PostgresExamplePolicy>;
 using MyCache2 = PostgreCache<PostgresExamplePolicy2>;
@@ -286,6 +300,7 @@ using MyTrivialCache = PostgreCache<PostgresTrivialPolicy>;
 using MyCache5 = PostgreCache<PostgresExamplePolicy5>;
 using MyCache6 = PostgreCache<PostgresExamplePolicy6>;
 using MyCache7 = PostgreCache<PostgresExamplePolicy7>;
+using MyCache8 = PostgreCache<PostgresExamplePolicy8>;
 
 // NB: field access required for actual instantiation
 static_assert(MyCache1::kIncrementalUpdates);
@@ -295,6 +310,7 @@ static_assert(MyCache4::kIncrementalUpdates);
 static_assert(MyCache5::kIncrementalUpdates);
 static_assert(MyCache6::kIncrementalUpdates);
 static_assert(MyCache7::kIncrementalUpdates);
+static_assert(MyCache8::kIncrementalUpdates);
 
 namespace pg = storages::postgres;
 static_assert(MyCache1::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
@@ -304,6 +320,7 @@ static_assert(MyCache4::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache5::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache6::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 static_assert(MyCache7::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
+static_assert(MyCache8::kClusterHostTypeFlags == pg::ClusterHostType::kSlave);
 
 // Update() instantiation test
 [[maybe_unused]] void
@@ -316,6 +333,7 @@ VerifyUpdateCompiles(const components::ComponentConfig& config, const components
     MyCache5 cache5{config, context};
     MyCache6 cache6{config, context};
     MyCache7 cache7{config, context};
+    MyCache8 cache8{config, context};
 }
 
 inline auto SampleOfComponentRegistration() {
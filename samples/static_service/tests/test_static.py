@@ -27,3 +27,39 @@ async def test_hidden_file(service_client, service_source_dir):
     response = await service_client.get('/dir1/.hidden_file.txt')
     assert response.status == 404
     assert response.content.decode() == 'File not found'
+
+
+async def test_range(service_client, service_source_dir):
+    file = service_source_dir.joinpath('public') / 'index.html'
+    content = file.open().read().encode()
+
+    response = await service_client.get(
+        '/index.html', headers={'Range': 'bytes=1-4'},
+    )
+    assert response.status == 206
+    assert response.headers['Content-Range'] == f'bytes 1-4/{len(content)}'
+    assert response.content == content[1:5]
+
+    response = await service_client.get(
+        '/index.html', headers={'Range': f'bytes={len(content)}-'},
+    )
+    assert response.status == 416
+    assert response.headers['Content-Range'] == f'bytes */{len(content)}'
+
+
+async def test_not_modified(service_client):
+    response = await service_client.get('/index.html')
+    assert response.status == 200
+    etag = response.headers['ETag']
+    last_modified = response.headers['Last-Modified']
+
+    response = await service_client.get(
+        '/index.html', headers={'If-None-Match': etag},
+    )
+    assert response.status == 304
+    assert response.content == b''
+
+    response = await service_client.get(
+        '/index.html', headers={'If-Modified-Since': last_modified},
+    )
+    assert response.status == 304
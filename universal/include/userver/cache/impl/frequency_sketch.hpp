@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// Count-min sketch of 4-bit saturating counters that estimates how often
+/// the keys were accessed recently. Once the number of recorded accesses
+/// reaches 10 x capacity all the counters are halved, so that the keys that
+/// were popular long ago do not stay "hot" forever.
+///
+/// Works with the hashes of the keys, so that the owning container computes
+/// the hash once and uses its own hash function.
+///
+/// RecordAccess and GetFrequency may be called concurrently, the concurrent
+/// increments of the same counter may be lost. SetCapacity and Clear require
+/// exclusive access.
+class FrequencySketch final {
+public:
+    explicit FrequencySketch(std::size_t capacity) { SetCapacity(capacity); }
+
+    FrequencySketch(FrequencySketch&& other) noexcept;
+    FrequencySketch& operator=(FrequencySketch&& other) noexcept;
+
+    /// Resizes the sketch for the given number of the tracked keys, drops all
+    /// the collected frequencies
+    void SetCapacity(std::size_t capacity);
+
+    void RecordAccess(std::size_t hash) noexcept;
+
+    std::uint32_t GetFrequency(std::size_t hash) const noexcept;
+
+    void Clear() noexcept;
+
+private:
+    static constexpr std::size_t kDepth = 4;
+    static constexpr std::size_t kCountersPerWord = 16;
+    static constexpr std::uint32_t kMaxFrequency = 15;
+    static constexpr std::uint64_t kHalveMask = 0x7777'7777'7777'7777;
+
+    std::size_t GetCounterIndex(std::uint64_t hash, std::size_t row) const noexcept;
+    std::uint32_t GetCounter(std::size_t index) const noexcept;
+    void IncrementCounter(std::size_t index, std::uint32_t frequency) noexcept;
+    void Halve() noexcept;
+
+    std::unique_ptr<std::atomic<std::uint64_t>[]> table_;
+    std::size_t table_size_{0};
+    std::size_t counters_mask_{0};
+    std::size_t sample_size_{0};
+    std::atomic<std::size_t> additions_{0};
+};
+
+inline FrequencySketch::FrequencySketch(FrequencySketch&& other) noexcept
+    : table_(std::move(other.table_)),
+      table_size_(std::exchange(other.table_size_, 0)),
+      counters_mask_(other.counters_mask_),
+      sample_size_(other.sample_size_),
+      additions_(other.additions_.load(std::memory_order_relaxed)) {}
+
+inline FrequencySketch& FrequencySketch::operator=(FrequencySketch&& other) noexcept {
+    table_ = std::move(other.table_);
+    table_size_ = std::exchange(other.table_size_, 0);
+    counters_mask_ = other.counters_mask_;
+    sample_size_ = other.sample_size_;
+    additions_.store(other.additions_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
+}
+
+inline void FrequencySketch::SetCapacity(std::size_t capacity) {
+    capacity = std::max<std::size_t>(capacity, 1);
+
+    // A word of 16 counters (8 bytes) per tracked key keeps the overestimation
+    // low even when the sketch sees many more keys than the cache holds
+    std::size_t counters = kCountersPerWord;
+    while (counters < capacity * kCountersPerWord) counters *= 2;
+
+    table_size_ = counters / kCountersPerWord;
+    table_ = std::make_unique<std::atomic<std::uint64_t>[]>(table_size_);
+    counters_mask_ = counters - 1;
+    sample_size_ = capacity * 10;
+    Clear();
+}
+
+inline void FrequencySketch::RecordAccess(std::size_t hash) noexcept {
+    std::size_t indices[kDepth];
+    std::uint32_t min_frequency = kMaxFrequency;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+        indices[row] = GetCounterIndex(hash, row);
+        min_frequency = std::min(min_frequency, GetCounter(indices[row]));
+    }
+    if (min_frequency == kMaxFrequency) return;
+
+    // Conservative update: only the smallest counters are incremented
+    for (const auto index : indices) IncrementCounter(index, min_frequency);
+
+    // Exactly one of the concurrent callers reaches the sample size
+    if (additions_.fetch_add(1, std::memory_order_relaxed) + 1 == sample_size_) Halve();
+}
+
+inline std::uint32_t FrequencySketch::GetFrequency(std::size_t hash) const noexcept {
+    std::uint32_t min_frequency = kMaxFrequency;
+    for (std::size_t row = 0; row < kDepth; ++row) {
+        min_frequency = std::min(min_frequency, GetCounter(GetCounterIndex(hash, row)));
+    }
+    return min_frequency;
+}
+
+inline void FrequencySketch::Clear() noexcept {
+    for (std::size_t i = 0; i < table_size_; ++i) table_[i].store(0, std::memory_order_relaxed);
+    additions_.store(0, std::memory_order_relaxed);
+}
+
+inline std::size_t FrequencySketch::GetCounterIndex(std::uint64_t hash, std::size_t row) const noexcept {
+    // Hashes of the user types are often poorly distributed (e.g. identity for
+    // integers), so the hash is mixed first. The rows are derived from the
+    // two halves of the mixed hash, as in utils::FilterBloom.
+    hash *= 0x9E37'79B9'7F4A'7C15;
+    hash ^= hash >> 29;
+    const auto first = hash & 0xFFFF'FFFF;
+    const auto second = (hash >> 32) | 1;
+    return static_cast<std::size_t>(first + second * row) & counters_mask_;
+}
+
+inline std::uint32_t FrequencySketch::GetCounter(std::size_t index) const noexcept {
+    const auto shift = (index % kCountersPerWord) * 4;
+    const auto word = table_[index / kCountersPerWord].load(std::memory_order_relaxed);
+    return static_cast<std::uint32_t>((word >> shift) & 0xF);
+}
+
+inline void FrequencySketch::IncrementCounter(std::size_t index, std::uint32_t frequency) noexcept {
+    const auto shift = (index % kCountersPerWord) * 4;
+    auto& word = table_[index / kCountersPerWord];
+    auto value = word.load(std::memory_order_relaxed);
+    // The counter is left as is if it has been changed concurrently, this also
+    // keeps it from overflowing into the neighbour
+    while (((value >> shift) & 0xF) == frequency) {
+        if (word.compare_exchange_weak(value, value + (std::uint64_t{1} << shift), std::memory_order_relaxed)) break;
+    }
+}
+
+inline void FrequencySketch::Halve() noexcept {
+    for (std::size_t i = 0; i < table_size_; ++i) {
+        auto value = table_[i].load(std::memory_order_relaxed);
+        while (!table_[i].compare_exchange_weak(value, (value >> 1) & kHalveMask, std::memory_order_relaxed)) {
+        }
+    }
+    additions_.fetch_sub(sample_size_ / 2, std::memory_order_relaxed);
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -113,6 +113,10 @@ public:
 
     U* Get(const T& key);
 
+    const U* Peek(const T& key) const;
+
+    const LruNode<T, U>* PeekNode(const T& key) const;
+
     const T* GetLeastUsedKey() const;
 
     U* GetLeastUsedValue();
@@ -227,6 +231,19 @@ U* LruBase<T, U, Hash, Eq>::Get(const T& key) {
     return &it->GetValue();
 }
 
+template <typename T, typename U, typename Hash, typename Eq>
+const U* LruBase<T, U, Hash, Eq>::Peek(const T& key) const {
+    const auto* node = PeekNode(key);
+    return node ? &node->GetValue() : nullptr;
+}
+
+template <typename T, typename U, typename Hash, typename Eq>
+const LruNode<T, U>* LruBase<T, U, Hash, Eq>::PeekNode(const T& key) const {
+    auto it = map_.find(key, map_.hash_function(), map_.key_eq());
+    if (it == map_.end()) return nullptr;
+    return &*it;
+}
+
 template <typename T, typename U, typename Hash, typename Eq>
 const T* LruBase<T, U, Hash, Eq>::GetLeastUsedKey() const {
     if (list_.empty()) return nullptr;
@@ -0,0 +1,290 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/impl/lru.hpp>
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache::impl {
+
+/// W-TinyLFU eviction, see https://arxiv.org/abs/1512.00727
+///
+/// New elements get into the window LRU (1% of the capacity). The elements
+/// evicted from the window are candidates for the main segmented LRU: if it is
+/// full, the candidate replaces the main victim only if the candidate was
+/// accessed more often recently according to the frequency sketch. Otherwise
+/// the candidate is dropped. The main space is split into the probation and
+/// the protected (80%) segments, the elements hit in probation are promoted.
+template <typename T, typename U, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+class TinyLfuBase final {
+public:
+    using NodeType = std::unique_ptr<LruNode<T, U>>;
+
+    explicit TinyLfuBase(std::size_t max_size, const Hash& hash = Hash(), const Equal& equal = Equal());
+
+    TinyLfuBase(TinyLfuBase&& other) noexcept = default;
+    TinyLfuBase& operator=(TinyLfuBase&& other) noexcept = default;
+
+    TinyLfuBase(const TinyLfuBase&) = delete;
+    TinyLfuBase& operator=(const TinyLfuBase&) = delete;
+
+    bool Put(const T& key, U value);
+
+    template <typename... Args>
+    U* Emplace(const T& key, Args&&... args);
+
+    void Erase(const T& key);
+
+    U* Get(const T& key);
+
+    const U* Peek(const T& key) const;
+
+    const LruNode<T, U>* PeekNode(const T& key) const;
+
+    // Counts a lookup for the admission, hit or miss. Thread-safe with respect
+    // to other RecordLookup and Peek calls.
+    void RecordLookup(const T& key) const noexcept;
+
+    // Get without RecordLookup, for the lookups that were recorded already
+    U* UpdateUsage(const T& key);
+
+    U* GetLeastUsedValue();
+
+    void SetMaxSize(std::size_t new_max_size);
+
+    void Clear() noexcept;
+
+    template <typename Function>
+    void VisitAll(Function&& func) const;
+
+    template <typename Function>
+    void VisitAll(Function&& func);
+
+    std::size_t GetSize() const;
+
+    std::size_t GetCapacity() const;
+
+private:
+    struct Capacities {
+        explicit Capacities(std::size_t max_size);
+
+        std::size_t window;
+        std::size_t main;
+        std::size_t protected_part;
+    };
+
+    U* GetFromMain(const T& key);
+    U& Add(const T& key, U value);
+    void Admit(NodeType&& candidate);
+    NodeType ExtractMainVictim();
+    std::size_t GetMainSize() const;
+
+    Hash hash_;
+    Capacities capacities_;
+    LruBase<T, U, Hash, Equal> window_;
+    LruBase<T, U, Hash, Equal> probation_part_;
+    LruBase<T, U, Hash, Equal> protected_part_;
+    mutable FrequencySketch sketch_;
+};
+
+template <typename T, typename U, typename Hash, typename Equal>
+TinyLfuBase<T, U, Hash, Equal>::Capacities::Capacities(std::size_t max_size) {
+    UASSERT(max_size > 0);
+    max_size = std::max<std::size_t>(max_size, 1);
+    window = std::max<std::size_t>(max_size / 100, 1);
+    main = max_size - window;
+    protected_part = std::max<std::size_t>(main * 4 / 5, 1);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+TinyLfuBase<T, U, Hash, Equal>::TinyLfuBase(std::size_t max_size, const Hash& hash, const Equal& equal)
+    : hash_(hash),
+      capacities_(max_size),
+      window_(capacities_.window, hash, equal),
+      // probation may take all the main space while protected is not full yet
+      probation_part_(std::max<std::size_t>(capacities_.main, 1), hash, equal),
+      protected_part_(capacities_.protected_part, hash, equal),
+      sketch_(max_size) {}
+
+template <typename T, typename U, typename Hash, typename Equal>
+bool TinyLfuBase<T, U, Hash, Equal>::Put(const T& key, U value) {
+    auto* const existing = Get(key);
+    if (existing) {
+        *existing = std::move(value);
+        return false;
+    }
+
+    Add(key, std::move(value));
+    return true;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename... Args>
+U* TinyLfuBase<T, U, Hash, Equal>::Emplace(const T& key, Args&&... args) {
+    auto* const existing = Get(key);
+    if (existing) return existing;
+
+    return &Add(key, U{std::forward<Args>(args)...});
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::Erase(const T& key) {
+    window_.Erase(key);
+    probation_part_.Erase(key);
+    protected_part_.Erase(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfuBase<T, U, Hash, Equal>::Get(const T& key) {
+    RecordLookup(key);
+    return UpdateUsage(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+const U* TinyLfuBase<T, U, Hash, Equal>::Peek(const T& key) const {
+    const auto* node = PeekNode(key);
+    return node ? &node->GetValue() : nullptr;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+const LruNode<T, U>* TinyLfuBase<T, U, Hash, Equal>::PeekNode(const T& key) const {
+    const auto* node = window_.PeekNode(key);
+    if (!node) node = protected_part_.PeekNode(key);
+    if (!node) node = probation_part_.PeekNode(key);
+    return node;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::RecordLookup(const T& key) const noexcept {
+    sketch_.RecordAccess(hash_(key));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfuBase<T, U, Hash, Equal>::UpdateUsage(const T& key) {
+    auto* const value = window_.Get(key);
+    if (value) return value;
+
+    return GetFromMain(key);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfuBase<T, U, Hash, Equal>::GetLeastUsedValue() {
+    auto* value = probation_part_.GetLeastUsedValue();
+    if (!value) value = protected_part_.GetLeastUsedValue();
+    if (!value) value = window_.GetLeastUsedValue();
+    return value;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::SetMaxSize(std::size_t new_max_size) {
+    const Capacities capacities(new_max_size);
+    if (capacities.window + capacities.main == GetCapacity()) return;
+
+    window_.SetMaxSize(capacities.window);
+    while (protected_part_.GetSize() > capacities.protected_part) {
+        probation_part_.InsertNode(protected_part_.ExtractLeastUsedNode());
+    }
+    while (GetMainSize() > capacities.main) {
+        ExtractMainVictim();
+    }
+    probation_part_.SetMaxSize(std::max<std::size_t>(capacities.main, 1));
+    protected_part_.SetMaxSize(capacities.protected_part);
+
+    capacities_ = capacities;
+    sketch_.SetCapacity(new_max_size);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::Clear() noexcept {
+    window_.Clear();
+    probation_part_.Clear();
+    protected_part_.Clear();
+    sketch_.Clear();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void TinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) const {
+    window_.VisitAll(func);
+    probation_part_.VisitAll(func);
+    protected_part_.VisitAll(func);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+template <typename Function>
+void TinyLfuBase<T, U, Hash, Equal>::VisitAll(Function&& func) {
+    window_.VisitAll(func);
+    probation_part_.VisitAll(func);
+    protected_part_.VisitAll(func);
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfuBase<T, U, Hash, Equal>::GetSize() const {
+    return window_.GetSize() + GetMainSize();
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfuBase<T, U, Hash, Equal>::GetCapacity() const {
+    return capacities_.window + capacities_.main;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U* TinyLfuBase<T, U, Hash, Equal>::GetFromMain(const T& key) {
+    auto* const value = protected_part_.Get(key);
+    if (value) return value;
+
+    auto node = probation_part_.ExtractNode(key);
+    if (!node) return nullptr;
+
+    if (protected_part_.GetSize() >= capacities_.protected_part) {
+        probation_part_.InsertNode(protected_part_.ExtractLeastUsedNode());
+    }
+    return &protected_part_.InsertNode(std::move(node));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+U& TinyLfuBase<T, U, Hash, Equal>::Add(const T& key, U value) {
+    if (window_.GetSize() >= capacities_.window) {
+        Admit(window_.ExtractLeastUsedNode());
+    }
+    return window_.InsertNode(std::make_unique<LruNode<T, U>>(T{key}, std::move(value)));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+void TinyLfuBase<T, U, Hash, Equal>::Admit(NodeType&& candidate) {
+    UASSERT(candidate);
+    if (capacities_.main == 0) return;
+
+    if (GetMainSize() >= capacities_.main) {
+        const auto* victim_key = probation_part_.GetLeastUsedKey();
+        if (!victim_key) victim_key = protected_part_.GetLeastUsedKey();
+        UASSERT(victim_key);
+
+        if (sketch_.GetFrequency(hash_(candidate->GetKey())) <= sketch_.GetFrequency(hash_(*victim_key))) {
+            return;
+        }
+        ExtractMainVictim();
+    }
+    probation_part_.InsertNode(std::move(candidate));
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+typename TinyLfuBase<T, U, Hash, Equal>::NodeType TinyLfuBase<T, U, Hash, Equal>::ExtractMainVictim() {
+    auto victim = probation_part_.ExtractLeastUsedNode();
+    if (!victim) victim = protected_part_.ExtractLeastUsedNode();
+    return victim;
+}
+
+template <typename T, typename U, typename Hash, typename Equal>
+std::size_t TinyLfuBase<T, U, Hash, Equal>::GetMainSize() const {
+    return probation_part_.GetSize() + protected_part_.GetSize();
+}
+
+}  // namespace cache::impl
+
+USERVER_NAMESPACE_END
@@ -3,7 +3,11 @@
 /// @file userver/cache/lru_map.hpp
 /// @brief @copybrief cache::LruMap
 
+#include <type_traits>
+
 #include <userver/cache/impl/lru.hpp>
+#include <userver/cache/impl/tiny_lfu.hpp>
+#include <userver/cache/policy.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -14,7 +18,15 @@ namespace cache {
 ///
 /// LRU key value storage (LRU cache), thread safety matches Standard Library
 /// thread safety
-template <typename T, typename U, typename Hash = std::hash<T>, typename Equal = std::equal_to<T>>
+///
+/// The eviction policy is selected by the `Policy` template parameter, see
+/// cache::CachePolicy.
+template <
+    typename T,
+    typename U,
+    typename Hash = std::hash<T>,
+    typename Equal = std::equal_to<T>,
+    CachePolicy Policy = CachePolicy::kLRU>
 class LruMap final {
 public:
     explicit LruMap(size_t max_size, const Hash& hash = Hash(), const Equal& equal = Equal())
@@ -45,6 +57,38 @@ public:
     /// @warning Returned pointer may be freed on the next map access!
     U* Get(const T& key) { return impl_.Get(key); }
 
+    /// Returns pointer to value if the key is in LRU without updating its
+    /// usage; returns nullptr otherwise. Does not modify the map, so it may be
+    /// called concurrently with other const member functions.
+    /// @warning Returned pointer may be freed on the next map access!
+    const U* Peek(const T& key) const { return impl_.Peek(key); }
+
+    /// Same as Peek, but returns the node that holds both the key and the
+    /// value. The node is never reallocated while the key is in LRU, so it may
+    /// refer to the element without copying the key.
+    /// @warning Returned pointer may be freed on the next map access, except
+    /// for the UpdateUsage and Get calls!
+    const impl::LruNode<T, U>* PeekNode(const T& key) const { return impl_.PeekNode(key); }
+
+    /// Counts a lookup of the key, hit or miss, for the frequency-based
+    /// policies without updating the usage; does nothing for
+    /// CachePolicy::kLRU. May be called concurrently with other const member
+    /// functions.
+    void RecordLookup(const T& key) const noexcept {
+        if constexpr (Policy == CachePolicy::kTinyLFU) impl_.RecordLookup(key);
+    }
+
+    /// Same as Get, but does not count the lookup, for the lookups already
+    /// counted by RecordLookup.
+    /// @warning Returned pointer may be freed on the next map access!
+    U* UpdateUsage(const T& key) {
+        if constexpr (Policy == CachePolicy::kTinyLFU) {
+            return impl_.UpdateUsage(key);
+        } else {
+            return impl_.Get(key);
+        }
+    }
+
     /// Returns value by key and updates its usage; returns default_value
     /// otherwise without modifying the cache.
     U GetOr(const T& key, const U& default_value) {
@@ -81,7 +125,12 @@ public:
     std::size_t GetCapacity() const { return impl_.GetCapacity(); }
 
 private:
-    impl::LruBase<T, U, Hash, Equal> impl_;
+    using Impl = std::conditional_t<
+        Policy == CachePolicy::kTinyLFU,
+        impl::TinyLfuBase<T, U, Hash, Equal>,
+        impl::LruBase<T, U, Hash, Equal>>;
+
+    Impl impl_;
 };
 
 }  // namespace cache
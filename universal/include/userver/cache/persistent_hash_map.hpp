@@ -0,0 +1,536 @@
+#pragma once
+
+/// @file userver/cache/persistent_hash_map.hpp
+/// @brief @copybrief cache::PersistentHashMap
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <boost/smart_ptr/intrusive_ptr.hpp>
+
+#include <userver/utils/assert.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+namespace impl::hamt {
+
+inline constexpr std::size_t kBitsPerLevel = 5;
+inline constexpr std::size_t kLevelMask = (1 << kBitsPerLevel) - 1;
+inline constexpr std::size_t kHashBits = sizeof(std::size_t) * 8;
+// The nodes at this shift hold the entries with completely equal hashes
+inline constexpr std::size_t kCollisionShift = (kHashBits + kBitsPerLevel - 1) / kBitsPerLevel * kBitsPerLevel;
+inline constexpr std::size_t kMaxDepth = kCollisionShift / kBitsPerLevel + 1;
+
+// A copy of a node or a leaf starts unshared
+class RefCounter final {
+public:
+    RefCounter() noexcept = default;
+    RefCounter(const RefCounter&) noexcept {}
+    RefCounter& operator=(const RefCounter&) = delete;
+
+    void Add() noexcept { refs_.fetch_add(1, std::memory_order_relaxed); }
+    bool Release() noexcept { return refs_.fetch_sub(1, std::memory_order_acq_rel) == 1; }
+
+    // The owner may modify the object in place if it is the only owner. Only
+    // the owners may create new references, so the result can not go stale.
+    bool IsUnique() const noexcept { return refs_.load(std::memory_order_acquire) == 1; }
+
+private:
+    std::atomic<std::size_t> refs_{0};
+};
+
+template <typename Value>
+struct Leaf final {
+    template <typename... Args>
+    explicit Leaf(std::size_t hash, Args&&... args) : hash(hash), value(std::forward<Args>(args)...) {}
+
+    RefCounter refs;
+    const std::size_t hash;
+    Value value;
+
+    friend void intrusive_ptr_add_ref(const Leaf* leaf) noexcept { const_cast<Leaf*>(leaf)->refs.Add(); }
+    friend void intrusive_ptr_release(const Leaf* leaf) noexcept {
+        if (const_cast<Leaf*>(leaf)->refs.Release()) delete leaf;
+    }
+};
+
+// CHAMP-style node: a slot holds either a leaf or a child node, the leaves
+// and the children are stored compactly in the order of their slots.
+// Collision nodes only have leaves, which are not ordered.
+template <typename Value>
+struct Node final {
+    using LeafPtr = boost::intrusive_ptr<Leaf<Value>>;
+    using NodePtr = boost::intrusive_ptr<Node>;
+
+    RefCounter refs;
+    std::uint32_t leaf_map{0};
+    std::uint32_t node_map{0};
+    std::vector<LeafPtr> leaves;
+    std::vector<NodePtr> children;
+
+    friend void intrusive_ptr_add_ref(const Node* node) noexcept { const_cast<Node*>(node)->refs.Add(); }
+    friend void intrusive_ptr_release(const Node* node) noexcept {
+        if (const_cast<Node*>(node)->refs.Release()) delete node;
+    }
+};
+
+constexpr std::uint32_t GetSlotBit(std::size_t hash, std::size_t shift) noexcept {
+    return std::uint32_t{1} << ((hash >> shift) & kLevelMask);
+}
+
+constexpr std::size_t GetIndex(std::uint32_t map, std::uint32_t bit) noexcept {
+    return __builtin_popcount(map & (bit - 1));
+}
+
+}  // namespace impl::hamt
+
+/// @ingroup userver_universal userver_containers
+///
+/// @brief Persistent (immutable with structural sharing) hash map.
+///
+/// Copying the map is O(1): the copies share the structure, and a modification
+/// of a copy only copies the O(log n) nodes on the path to the modified entry.
+/// This makes it a good `CacheContainer` for caches with incremental updates:
+/// applying a delta to a copy of the previous snapshot costs
+/// O(delta * log n) instead of copying all the entries.
+///
+/// Implemented as a hash array mapped trie with 32-way branching. The entries
+/// are stored in separately allocated leaves, so the values are never copied
+/// on modification of the structure.
+///
+/// The entries are only modifiable via operator[], iterators are constant.
+/// Modifications invalidate the iterators and the references.
+///
+/// Thread safety matches the Standard Library containers thread safety, the
+/// copies of a map may be used concurrently from different threads.
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename Equal = std::equal_to<Key>>
+class PersistentHashMap final {
+    using Leaf = impl::hamt::Leaf<std::pair<const Key, T>>;
+    using Node = impl::hamt::Node<std::pair<const Key, T>>;
+    using LeafPtr = typename Node::LeafPtr;
+    using NodePtr = typename Node::NodePtr;
+
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<const Key, T>;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using hasher = Hash;
+    using key_equal = Equal;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+
+    class const_iterator final {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = PersistentHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using reference = const value_type&;
+        using pointer = const value_type*;
+
+        const_iterator() noexcept = default;
+
+        reference operator*() const noexcept {
+            UASSERT(leaf_);
+            return leaf_->value;
+        }
+        pointer operator->() const noexcept { return &**this; }
+
+        const_iterator& operator++() noexcept {
+            Advance();
+            return *this;
+        }
+        const_iterator operator++(int) noexcept {
+            auto copy = *this;
+            Advance();
+            return copy;
+        }
+
+        bool operator==(const const_iterator& other) const noexcept { return leaf_ == other.leaf_; }
+        bool operator!=(const const_iterator& other) const noexcept { return leaf_ != other.leaf_; }
+
+    private:
+        friend class PersistentHashMap;
+
+        // The position of the next item to visit in the node: the leaves
+        // go first, then the children
+        struct Frame final {
+            const Node* node{nullptr};
+            std::size_t next{0};
+        };
+
+        explicit const_iterator(const Node* root) noexcept {
+            if (root) {
+                Push(root, 0);
+                Advance();
+            }
+        }
+
+        void Push(const Node* node, std::size_t next) noexcept {
+            UASSERT(depth_ < stack_.size());
+            stack_[depth_++] = Frame{node, next};
+        }
+
+        void Advance() noexcept {
+            while (depth_ != 0) {
+                auto& frame = stack_[depth_ - 1];
+                const auto& leaves = frame.node->leaves;
+                if (frame.next < leaves.size()) {
+                    leaf_ = leaves[frame.next++].get();
+                    return;
+                }
+                const auto child_index = frame.next - leaves.size();
+                if (child_index < frame.node->children.size()) {
+                    ++frame.next;
+                    Push(frame.node->children[child_index].get(), 0);
+                    continue;
+                }
+                --depth_;
+            }
+            leaf_ = nullptr;
+        }
+
+        std::array<Frame, impl::hamt::kMaxDepth> stack_{};
+        std::size_t depth_{0};
+        const Leaf* leaf_{nullptr};
+    };
+
+    using iterator = const_iterator;
+
+    PersistentHashMap() = default;
+
+    explicit PersistentHashMap(const Hash& hash, const Equal& equal = Equal()) : hash_(hash), equal_(equal) {}
+
+    /// O(1), the maps share the structure
+    PersistentHashMap(const PersistentHashMap&) = default;
+    PersistentHashMap(PersistentHashMap&& other) noexcept
+        : root_(std::move(other.root_)),
+          size_(std::exchange(other.size_, 0)),
+          hash_(std::move(other.hash_)),
+          equal_(std::move(other.equal_)) {}
+
+    /// O(1), the maps share the structure
+    PersistentHashMap& operator=(const PersistentHashMap&) = default;
+    PersistentHashMap& operator=(PersistentHashMap&& other) noexcept {
+        root_ = std::move(other.root_);
+        size_ = std::exchange(other.size_, 0);
+        hash_ = std::move(other.hash_);
+        equal_ = std::move(other.equal_);
+        return *this;
+    }
+
+    ~PersistentHashMap() = default;
+
+    const_iterator begin() const noexcept { return const_iterator{root_.get()}; }
+    const_iterator end() const noexcept { return const_iterator{}; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    size_type size() const noexcept { return size_; }
+    bool empty() const noexcept { return size_ == 0; }
+
+    void clear() noexcept {
+        root_.reset();
+        size_ = 0;
+    }
+
+    const_iterator find(const Key& key) const {
+        const_iterator it;
+        const auto hash = hash_(key);
+        const Node* node = root_.get();
+        for (std::size_t shift = 0; node; shift += impl::hamt::kBitsPerLevel) {
+            if (shift == impl::hamt::kCollisionShift) {
+                for (std::size_t i = 0; i < node->leaves.size(); ++i) {
+                    if (equal_(node->leaves[i]->value.first, key)) {
+                        it.Push(node, i + 1);
+                        it.leaf_ = node->leaves[i].get();
+                        return it;
+                    }
+                }
+                return end();
+            }
+
+            const auto bit = impl::hamt::GetSlotBit(hash, shift);
+            if (node->leaf_map & bit) {
+                const auto index = impl::hamt::GetIndex(node->leaf_map, bit);
+                const auto& leaf = node->leaves[index];
+                if (leaf->hash != hash || !equal_(leaf->value.first, key)) return end();
+                it.Push(node, index + 1);
+                it.leaf_ = leaf.get();
+                return it;
+            }
+            if (!(node->node_map & bit)) return end();
+
+            const auto index = impl::hamt::GetIndex(node->node_map, bit);
+            it.Push(node, node->leaves.size() + index + 1);
+            node = node->children[index].get();
+        }
+        return end();
+    }
+
+    size_type count(const Key& key) const { return FindLeaf(key) ? 1 : 0; }
+
+    bool contains(const Key& key) const { return FindLeaf(key) != nullptr; }
+
+    /// @throws std::out_of_range if there is no such key
+    const T& at(const Key& key) const {
+        const auto* leaf = FindLeaf(key);
+        if (!leaf) throw std::out_of_range("PersistentHashMap::at");
+        return leaf->value.second;
+    }
+
+    /// @brief Returns a reference to the value, inserts a default constructed
+    /// one if there is no such key.
+    /// @note Copies the value if it is shared with other copies of the map,
+    /// prefer insert_or_assign for overwriting the values.
+    T& operator[](const Key& key) {
+        const auto hash = hash_(key);
+        if (auto* slot = FindMutableSlot(hash, key)) {
+            if (!(*slot)->refs.IsUnique()) *slot = LeafPtr{new Leaf(hash, (*slot)->value)};
+            return (*slot)->value.second;
+        }
+        return InsertNewLeaf(LeafPtr{new Leaf(hash, std::piecewise_construct, std::tuple{key}, std::tuple{})})
+            ->value.second;
+    }
+
+    template <typename M>
+    std::pair<const_iterator, bool> insert_or_assign(const Key& key, M&& value) {
+        return InsertOrAssign(key, std::forward<M>(value));
+    }
+
+    template <typename M>
+    std::pair<const_iterator, bool> insert_or_assign(Key&& key, M&& value) {
+        return InsertOrAssign(std::move(key), std::forward<M>(value));
+    }
+
+    /// Does nothing if the key is already present
+    std::pair<const_iterator, bool> insert(const value_type& value) { return Emplace(value.first, value); }
+
+    /// Does nothing if the key is already present
+    std::pair<const_iterator, bool> insert(value_type&& value) { return Emplace(value.first, std::move(value)); }
+
+    /// Does nothing if the key is already present
+    template <typename... Args>
+    std::pair<const_iterator, bool> try_emplace(const Key& key, Args&&... args) {
+        return Emplace(
+            key,
+            std::piecewise_construct,
+            std::forward_as_tuple(key),
+            std::forward_as_tuple(std::forward<Args>(args)...)
+        );
+    }
+
+    /// @returns the number of erased entries
+    size_type erase(const Key& key) {
+        const auto hash = hash_(key);
+        if (!FindLeaf(key)) return 0;
+
+        Erase(root_, hash, key, 0);
+        if (root_->leaves.empty() && root_->children.empty()) root_.reset();
+        --size_;
+        return 1;
+    }
+
+    hasher hash_function() const { return hash_; }
+    key_equal key_eq() const { return equal_; }
+
+private:
+    const Leaf* FindLeaf(const Key& key) const {
+        const auto hash = hash_(key);
+        const Node* node = root_.get();
+        for (std::size_t shift = 0; node; shift += impl::hamt::kBitsPerLevel) {
+            if (shift == impl::hamt::kCollisionShift) {
+                for (const auto& leaf : node->leaves) {
+                    if (equal_(leaf->value.first, key)) return leaf.get();
+                }
+                return nullptr;
+            }
+
+            const auto bit = impl::hamt::GetSlotBit(hash, shift);
+            if (node->leaf_map & bit) {
+                const auto& leaf = node->leaves[impl::hamt::GetIndex(node->leaf_map, bit)];
+                return leaf->hash == hash && equal_(leaf->value.first, key) ? leaf.get() : nullptr;
+            }
+            if (!(node->node_map & bit)) return nullptr;
+            node = node->children[impl::hamt::GetIndex(node->node_map, bit)].get();
+        }
+        return nullptr;
+    }
+
+    template <typename K, typename M>
+    std::pair<const_iterator, bool> InsertOrAssign(K&& key, M&& value) {
+        const auto hash = hash_(key);
+        LeafPtr leaf{new Leaf(hash, std::forward<K>(key), std::forward<M>(value))};
+        if (auto* slot = FindMutableSlot(hash, leaf->value.first)) {
+            // A new leaf instead of assignment to keep the old one intact if
+            // it is shared
+            *slot = std::move(leaf);
+            return {find((*slot)->value.first), false};
+        }
+        const auto* inserted = InsertNewLeaf(std::move(leaf));
+        return {find(inserted->value.first), true};
+    }
+
+    template <typename... Args>
+    std::pair<const_iterator, bool> Emplace(const Key& key, Args&&... args) {
+        if (auto it = find(key); it != end()) return {it, false};
+
+        const auto* inserted = InsertNewLeaf(LeafPtr{new Leaf(hash_(key), std::forward<Args>(args)...)});
+        return {find(inserted->value.first), true};
+    }
+
+    static void MakeUnique(NodePtr& node) {
+        if (!node->refs.IsUnique()) node = NodePtr{new Node(*node)};
+    }
+
+    // Returns the slot of the leaf with the key after making the path to it
+    // unshared, or nullptr if there is no such key
+    LeafPtr* FindMutableSlot(std::size_t hash, const Key& key) {
+        if (!root_ || !FindLeaf(key)) return nullptr;
+
+        NodePtr* node = &root_;
+        for (std::size_t shift = 0;; shift += impl::hamt::kBitsPerLevel) {
+            MakeUnique(*node);
+            auto& current = **node;
+            if (shift == impl::hamt::kCollisionShift) {
+                for (auto& leaf : current.leaves) {
+                    if (equal_(leaf->value.first, key)) return &leaf;
+                }
+                UASSERT_MSG(false, "the key must be present");
+                return nullptr;
+            }
+
+            const auto bit = impl::hamt::GetSlotBit(hash, shift);
+            if (current.leaf_map & bit) return &current.leaves[impl::hamt::GetIndex(current.leaf_map, bit)];
+            UASSERT(current.node_map & bit);
+            node = &current.children[impl::hamt::GetIndex(current.node_map, bit)];
+        }
+    }
+
+    // The key of the leaf must not be present in the map
+    Leaf* InsertNewLeaf(LeafPtr leaf) {
+        auto* result = leaf.get();
+        if (!root_) root_ = NodePtr{new Node};
+
+        const auto hash = leaf->hash;
+        NodePtr* node = &root_;
+        for (std::size_t shift = 0;; shift += impl::hamt::kBitsPerLevel) {
+            MakeUnique(*node);
+            auto& current = **node;
+            if (shift == impl::hamt::kCollisionShift) {
+                current.leaves.push_back(std::move(leaf));
+                break;
+            }
+
+            const auto bit = impl::hamt::GetSlotBit(hash, shift);
+            if (current.node_map & bit) {
+                node = &current.children[impl::hamt::GetIndex(current.node_map, bit)];
+                continue;
+            }
+
+            const auto leaf_index = impl::hamt::GetIndex(current.leaf_map, bit);
+            if (!(current.leaf_map & bit)) {
+                current.leaves.insert(current.leaves.begin() + leaf_index, std::move(leaf));
+                current.leaf_map |= bit;
+                break;
+            }
+
+            // The slot is taken by another leaf, push both of them down
+            auto child = MergeLeaves(current.leaves[leaf_index], std::move(leaf), shift + impl::hamt::kBitsPerLevel);
+            current.leaves.erase(current.leaves.begin() + leaf_index);
+            current.leaf_map &= ~bit;
+            current.children.insert(
+                current.children.begin() + impl::hamt::GetIndex(current.node_map, bit), std::move(child)
+            );
+            current.node_map |= bit;
+            break;
+        }
+
+        ++size_;
+        return result;
+    }
+
+    static NodePtr MergeLeaves(LeafPtr first, LeafPtr second, std::size_t shift) {
+        NodePtr node{new Node};
+        if (shift == impl::hamt::kCollisionShift) {
+            node->leaves.push_back(std::move(first));
+            node->leaves.push_back(std::move(second));
+            return node;
+        }
+
+        const auto first_bit = impl::hamt::GetSlotBit(first->hash, shift);
+        const auto second_bit = impl::hamt::GetSlotBit(second->hash, shift);
+        if (first_bit == second_bit) {
+            const auto next_shift = shift + impl::hamt::kBitsPerLevel;
+            node->children.push_back(MergeLeaves(std::move(first), std::move(second), next_shift));
+            node->node_map = first_bit;
+            return node;
+        }
+
+        if (second_bit < first_bit) std::swap(first, second);
+        node->leaves.push_back(std::move(first));
+        node->leaves.push_back(std::move(second));
+        node->leaf_map = first_bit | second_bit;
+        return node;
+    }
+
+    // The key must be present in the map. Keeps the trie compact: a node with
+    // a single leaf and no children is replaced with that leaf.
+    void Erase(NodePtr& node, std::size_t hash, const Key& key, std::size_t shift) {
+        MakeUnique(node);
+        auto& current = *node;
+        if (shift == impl::hamt::kCollisionShift) {
+            for (auto it = current.leaves.begin(); it != current.leaves.end(); ++it) {
+                if (equal_((*it)->value.first, key)) {
+                    current.leaves.erase(it);
+                    return;
+                }
+            }
+            UASSERT_MSG(false, "the key must be present");
+            return;
+        }
+
+        const auto bit = impl::hamt::GetSlotBit(hash, shift);
+        if (current.leaf_map & bit) {
+            current.leaves.erase(current.leaves.begin() + impl::hamt::GetIndex(current.leaf_map, bit));
+            current.leaf_map &= ~bit;
+            return;
+        }
+
+        UASSERT(current.node_map & bit);
+        const auto child_index = impl::hamt::GetIndex(current.node_map, bit);
+        auto& child = current.children[child_index];
+        Erase(child, hash, key, shift + impl::hamt::kBitsPerLevel);
+        if (!child->children.empty() || child->leaves.size() > 1) return;
+
+        auto last_leaf = child->leaves.empty() ? LeafPtr{} : std::move(child->leaves.front());
+        current.children.erase(current.children.begin() + child_index);
+        current.node_map &= ~bit;
+        if (last_leaf) {
+            current.leaves.insert(
+                current.leaves.begin() + impl::hamt::GetIndex(current.leaf_map, bit), std::move(last_leaf)
+            );
+            current.leaf_map |= bit;
+        }
+    }
+
+    NodePtr root_;
+    std::size_t size_{0};
+    Hash hash_;
+    Equal equal_;
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
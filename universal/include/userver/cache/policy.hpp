@@ -0,0 +1,24 @@
+#pragma once
+
+/// @file userver/cache/policy.hpp
+/// @brief @copybrief cache::CachePolicy
+
+USERVER_NAMESPACE_BEGIN
+
+namespace cache {
+
+/// @brief Eviction policy of cache::LruMap and the caches built on top of it
+enum class CachePolicy {
+    /// The least recently used element is evicted
+    kLRU,
+
+    /// W-TinyLFU: new elements get into a small LRU window, an element evicted
+    /// from the window replaces the victim of the main segmented LRU only if
+    /// it was accessed more often recently. Keeps the hot elements in the cache
+    /// on scans and other one-hit-wonder traffic.
+    kTinyLFU,
+};
+
+}  // namespace cache
+
+USERVER_NAMESPACE_END
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include <userver/compression/error.hpp>
+#include <userver/utils/fast_pimpl.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
@@ -12,6 +16,88 @@ namespace compression::zstd {
 /// @throws DecompressionError
 std::string Decompress(std::string_view compressed, size_t max_size);
 
+/// Settings of the zstd compression
+struct CompressionSettings final {
+    /// Compression level, from 1 to 22 (slowest, best ratio). Negative levels
+    /// trade the ratio for speed.
+    int level{3};
+
+    /// Finds the matches far behind the current position. Improves the ratio
+    /// of large inputs with distant repetitions, e.g. of the cache dumps.
+    /// Raises the window (and the decompression memory) to 128MiB.
+    bool long_distance_matching{false};
+
+    /// A dictionary trained by zstd::TrainDictionary on samples of the data.
+    /// Dramatically improves the ratio of small inputs. The same dictionary
+    /// must be passed to zstd::Decompressor.
+    std::string dictionary{};
+};
+
+/// Compresses the string into a single zstd frame.
+std::string Compress(std::string_view data, const CompressionSettings& settings = {});
+
+/// @brief Trains a dictionary on samples of the data to compress.
+/// @param samples representative inputs, usually hundreds of them
+/// @param max_size the maximum size of the dictionary, about 100KiB is enough
+/// @throws std::runtime_error if there is too little data to train on
+std::string TrainDictionary(const std::vector<std::string>& samples, std::size_t max_size);
+
+/// @brief Streaming zstd compressor, produces a single frame per
+/// Compress...Finish sequence.
+///
+/// The output of the compressor is readable by zstd::Decompress, by
+/// zstd::Decompressor and by the `zstd` utility.
+class Compressor final {
+public:
+    explicit Compressor(const CompressionSettings& settings = {});
+
+    Compressor(Compressor&&) noexcept;
+    Compressor& operator=(Compressor&&) noexcept;
+    ~Compressor();
+
+    /// Compresses `data` and appends the compressed data to `output`. The data
+    /// may be buffered internally until the following calls.
+    void Compress(std::string_view data, std::string& output);
+
+    /// Flushes the buffered data and ends the frame. The compressor may be
+    /// reused for the next frame afterwards.
+    void Finish(std::string& output);
+
+private:
+    struct Impl;
+    utils::FastPimpl<Impl, 8, 8> impl_;
+};
+
+/// @brief Streaming zstd decompressor, that produces the output in portions
+/// of at most the given size.
+class Decompressor final {
+public:
+    /// @param dictionary the dictionary that the data was compressed with
+    explicit Decompressor(std::string dictionary = {});
+
+    Decompressor(Decompressor&&) noexcept;
+    Decompressor& operator=(Decompressor&&) noexcept;
+    ~Decompressor();
+
+    /// @brief Decompresses the beginning of `input` into `output`, removes
+    /// the consumed part from `input`.
+    ///
+    /// May be called with an empty `input` to retrieve the data that the
+    /// decompressor has buffered internally.
+    ///
+    /// @returns the number of bytes written to `output`
+    /// @throws DecompressionError
+    std::size_t Decompress(std::string_view& input, char* output, std::size_t output_size);
+
+    /// @returns true if at least one frame was decompressed and the last frame
+    /// is complete, i.e. the input was not truncated
+    bool IsFrameComplete() const noexcept;
+
+private:
+    struct Impl;
+    utils::FastPimpl<Impl, 16, 8> impl_;
+};
+
 }  // namespace compression::zstd
 
 USERVER_NAMESPACE_END
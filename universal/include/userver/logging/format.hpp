@@ -10,7 +10,17 @@ USERVER_NAMESPACE_BEGIN
 namespace logging {
 
 /// Log formats
-enum class Format { kTskv, kLtsv, kRaw };
+enum class Format {
+    kTskv,
+    kLtsv,
+    kRaw,
+    /// A JSON object per line, numeric tags are written as JSON numbers
+    kJson,
+    /// Not a text format: records are passed to the logger as
+    /// logging::impl::LogRecord without serialization. Can not be parsed from
+    /// a string, it is meant for loggers that serialize records themselves.
+    kStructured,
+};
 
 /// Parse Format enum from string
 Format FormatFromString(std::string_view format_str);
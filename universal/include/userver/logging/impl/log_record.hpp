@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <string_view>
+
+#include <userver/logging/level.hpp>
+#include <userver/utils/span.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace logging::impl {
+
+/// The type of the value the tag has been written from
+enum class TagType { kString, kInteger, kFloat };
+
+/// A single tag of a LogRecord, the value is not escaped
+struct LogTag final {
+    std::string_view key;
+    std::string_view value;
+    TagType type{TagType::kString};
+};
+
+/// @brief Log record as it is built by LogHelper, before serialization.
+///
+/// Loggers of Format::kStructured receive records in this form and serialize
+/// them on their own, e.g. to protobuf. All the views are valid only during
+/// the LoggerBase::LogStructured or LoggerBase::TraceStructured call.
+struct LogRecord final {
+    Level level{Level::kNone};
+    std::chrono::system_clock::time_point timestamp;
+    std::string_view text;
+    utils::span<const LogTag> tags;
+};
+
+}  // namespace logging::impl
+
+USERVER_NAMESPACE_END
@@ -10,6 +10,7 @@ USERVER_NAMESPACE_BEGIN
 namespace logging::impl {
 
 class TagWriter;
+struct LogRecord;
 
 /// Base logger class
 class LoggerBase {
@@ -28,6 +29,16 @@ public:
 
     virtual void Trace(Level level, std::string_view msg);
 
+    /// @brief Receives the records instead of Log if the logger has
+    /// Format::kStructured. By default serializes the record to text and
+    /// passes it to Log.
+    virtual void LogStructured(const LogRecord& record);
+
+    /// @brief Receives the records instead of Trace if the logger has
+    /// Format::kStructured. By default serializes the record to text and
+    /// passes it to Trace.
+    virtual void TraceStructured(const LogRecord& record);
+
     virtual void Flush();
 
     virtual void PrependCommonTags(TagWriter writer) const;
@@ -4,6 +4,7 @@
 #include <type_traits>
 
 #include <userver/compiler/impl/constexpr.hpp>
+#include <userver/logging/impl/log_record.hpp>
 #include <userver/logging/log_extra.hpp>
 #include <userver/logging/log_helper.hpp>
 #include <userver/utils/encoding/tskv.hpp>
@@ -44,6 +45,9 @@ public:
     template <typename T>
     void PutTag(RuntimeTagKey key, const T& value);
 
+    // Writes a tag with the value that is already formatted
+    void PutTag(const LogTag& tag);
+
     // The tags must not be duplicated in other Put* calls.
     void PutLogExtra(const LogExtra& extra);
 
@@ -59,11 +63,24 @@ private:
     void PutKey(TagKey key);
     void PutKey(RuntimeTagKey key);
 
-    void MarkValueEnd() noexcept;
+    void MarkValueEnd(TagType type);
 
     LogHelper& lh_;
 };
 
+template <typename T>
+constexpr TagType GetTagType() noexcept {
+    if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char>) {
+        return TagType::kString;
+    } else if constexpr (std::is_integral_v<T>) {
+        return TagType::kInteger;
+    } else if constexpr (std::is_floating_point_v<T>) {
+        return TagType::kFloat;
+    } else {
+        return TagType::kString;
+    }
+}
+
 constexpr bool DoesTagNeedEscaping(std::string_view key) noexcept {
     for (const char c : key) {
         const bool needs_no_escaping_in_all_formats = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
@@ -86,14 +103,14 @@ template <typename T>
 void TagWriter::PutTag(TagKey key, const T& value) {
     PutKey(key);
     lh_ << value;
-    MarkValueEnd();
+    MarkValueEnd(GetTagType<T>());
 }
 
 template <typename T>
 void TagWriter::PutTag(RuntimeTagKey key, const T& value) {
     PutKey(key);
     lh_ << value;
-    MarkValueEnd();
+    MarkValueEnd(GetTagType<T>());
 }
 
 }  // namespace logging::impl
@@ -0,0 +1,84 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+constexpr int kDeltaSize = 100;
+
+template <typename Map>
+Map FillMap(int size) {
+    Map map;
+    for (int i = 0; i < size; ++i) {
+        map.insert_or_assign(i, std::to_string(i));
+    }
+    return map;
+}
+
+// Models an incremental cache update: copy the previous snapshot and apply
+// a small delta to the copy
+template <typename Map>
+void CopyAndUpdate(benchmark::State& state) {
+    const auto size = static_cast<int>(state.range(0));
+    const auto snapshot = FillMap<Map>(size);
+    int offset = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        Map copy = snapshot;
+        for (int i = 0; i < kDeltaSize; ++i) {
+            copy.insert_or_assign((offset + i * 7919) % size, "updated");
+        }
+        offset = (offset + 1) % size;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+template <typename Map>
+void Find(benchmark::State& state) {
+    const auto size = static_cast<int>(state.range(0));
+    const auto map = FillMap<Map>(size);
+    int key = 0;
+    for ([[maybe_unused]] auto _ : state) {
+        benchmark::DoNotOptimize(map.find(key));
+        key = (key + 7919) % size;
+    }
+}
+
+template <typename Map>
+void Iterate(benchmark::State& state) {
+    const auto map = FillMap<Map>(static_cast<int>(state.range(0)));
+    for ([[maybe_unused]] auto _ : state) {
+        std::size_t total = 0;
+        for (const auto& [key, value] : map) total += value.size();
+        benchmark::DoNotOptimize(total);
+    }
+}
+
+using PersistentMap = cache::PersistentHashMap<int, std::string>;
+using UnorderedMap = std::unordered_map<int, std::string>;
+
+}  // namespace
+
+void PersistentHashMapCopyAndUpdate(benchmark::State& state) { CopyAndUpdate<PersistentMap>(state); }
+BENCHMARK(PersistentHashMapCopyAndUpdate)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+
+void UnorderedMapCopyAndUpdate(benchmark::State& state) { CopyAndUpdate<UnorderedMap>(state); }
+BENCHMARK(UnorderedMapCopyAndUpdate)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+
+void PersistentHashMapFind(benchmark::State& state) { Find<PersistentMap>(state); }
+BENCHMARK(PersistentHashMapFind)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+
+void UnorderedMapFind(benchmark::State& state) { Find<UnorderedMap>(state); }
+BENCHMARK(UnorderedMapFind)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+
+void PersistentHashMapIterate(benchmark::State& state) { Iterate<PersistentMap>(state); }
+BENCHMARK(PersistentHashMapIterate)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+
+void UnorderedMapIterate(benchmark::State& state) { Iterate<UnorderedMap>(state); }
+BENCHMARK(UnorderedMapIterate)->RangeMultiplier(10)->Range(1'000, 1'000'000);
+
+USERVER_NAMESPACE_END
@@ -0,0 +1,187 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+#include <userver/cache/persistent_hash_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using Map = cache::PersistentHashMap<int, std::string>;
+
+// Lots of collisions on every level
+struct BadHash {
+    std::size_t operator()(int value) const noexcept { return value % 3; }
+};
+
+template <typename PersistentMap>
+std::map<typename PersistentMap::key_type, typename PersistentMap::mapped_type> ToMap(const PersistentMap& map) {
+    std::map<typename PersistentMap::key_type, typename PersistentMap::mapped_type> result;
+    for (const auto& [key, value] : map) {
+        EXPECT_TRUE(result.emplace(key, value).second) << "duplicate key " << key;
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(PersistentHashMap, Empty) {
+    const Map map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.size(), 0);
+    EXPECT_EQ(map.begin(), map.end());
+    EXPECT_EQ(map.find(1), map.end());
+    EXPECT_EQ(map.count(1), 0);
+    EXPECT_THROW(map.at(1), std::out_of_range);
+}
+
+TEST(PersistentHashMap, InsertFindErase) {
+    Map map;
+    EXPECT_TRUE(map.insert_or_assign(1, "one").second);
+    EXPECT_TRUE(map.insert({2, "two"}).second);
+    EXPECT_TRUE(map.try_emplace(3, 3, 'x').second);
+    map[4] = "four";
+    EXPECT_EQ(map.size(), 4);
+
+    EXPECT_EQ(map.at(1), "one");
+    EXPECT_EQ(map.find(2)->second, "two");
+    EXPECT_EQ(map.at(3), "xxx");
+    EXPECT_EQ(map[4], "four");
+    EXPECT_TRUE(map.contains(4));
+
+    const auto [it, inserted] = map.insert_or_assign(1, "uno");
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(it->second, "uno");
+    EXPECT_FALSE(map.insert({2, "dos"}).second);
+    EXPECT_FALSE(map.try_emplace(3, "tres").second);
+    EXPECT_EQ(map.at(2), "two");
+    EXPECT_EQ(map.at(3), "xxx");
+    EXPECT_EQ(map.size(), 4);
+
+    EXPECT_EQ(map.erase(5), 0);
+    EXPECT_EQ(map.erase(1), 1);
+    EXPECT_EQ(map.count(1), 0);
+    EXPECT_EQ(map.size(), 3);
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentHashMap, SnapshotIsolation) {
+    Map original;
+    for (int i = 0; i < 1000; ++i) original.insert_or_assign(i, std::to_string(i));
+    const auto expected = ToMap(original);
+
+    Map copy = original;
+    for (int i = 0; i < 1000; i += 3) copy.insert_or_assign(i, "changed");
+    for (int i = 1; i < 1000; i += 3) copy.erase(i);
+    for (int i = 1000; i < 1100; ++i) copy[i] = "new";
+    copy[2] += "-appended";
+
+    EXPECT_EQ(ToMap(original), expected);
+    EXPECT_EQ(original.size(), 1000);
+
+    EXPECT_EQ(copy.size(), 1000 - 333 + 100);
+    EXPECT_EQ(copy.at(0), "changed");
+    EXPECT_EQ(copy.count(1), 0);
+    EXPECT_EQ(copy.at(2), "2-appended");
+    EXPECT_EQ(copy.at(1050), "new");
+}
+
+TEST(PersistentHashMap, Collisions) {
+    cache::PersistentHashMap<int, int, BadHash> map;
+    for (int i = 0; i < 100; ++i) EXPECT_TRUE(map.insert_or_assign(i, i * 2).second);
+
+    const auto snapshot = map;
+    for (int i = 0; i < 100; i += 2) EXPECT_EQ(map.erase(i), 1);
+
+    EXPECT_EQ(map.size(), 50);
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_EQ(map.count(i), i % 2) << i;
+        EXPECT_EQ(snapshot.at(i), i * 2) << i;
+    }
+    EXPECT_EQ(ToMap(map).size(), 50);
+
+    for (int i = 1; i < 100; i += 2) EXPECT_EQ(map.erase(i), 1);
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(ToMap(snapshot).size(), 100);
+}
+
+TEST(PersistentHashMap, FindIteratorContinues) {
+    Map map;
+    for (int i = 0; i < 500; ++i) map.insert_or_assign(i, std::to_string(i));
+
+    // Iteration from a found element visits the rest of the elements in the
+    // same order as the iteration from begin()
+    std::vector<int> keys;
+    for (const auto& [key, value] : map) keys.push_back(key);
+    ASSERT_EQ(keys.size(), map.size());
+
+    for (const std::size_t start : {std::size_t{0}, std::size_t{1}, keys.size() / 2, keys.size() - 1}) {
+        auto it = map.find(keys[start]);
+        for (std::size_t i = start; i < keys.size(); ++i, ++it) {
+            ASSERT_NE(it, map.end());
+            EXPECT_EQ(it->first, keys[i]);
+        }
+        EXPECT_EQ(it, map.end());
+    }
+}
+
+TEST(PersistentHashMap, RandomizedAgainstUnorderedMap) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> key_distribution(0, 2000);
+    std::uniform_int_distribution<int> op_distribution(0, 3);
+
+    Map map;
+    std::unordered_map<int, std::string> reference;
+    std::vector<std::pair<Map, std::unordered_map<int, std::string>>> snapshots;
+
+    for (int i = 0; i < 20000; ++i) {
+        const auto key = key_distribution(rng);
+        switch (op_distribution(rng)) {
+            case 0:
+                map.insert_or_assign(key, std::to_string(i));
+                reference.insert_or_assign(key, std::to_string(i));
+                break;
+            case 1:
+                map[key] += "+";
+                reference[key] += "+";
+                break;
+            case 2:
+                EXPECT_EQ(map.erase(key), reference.erase(key));
+                break;
+            case 3:
+                EXPECT_EQ(map.try_emplace(key, "emplaced").second, reference.try_emplace(key, "emplaced").second);
+                break;
+        }
+        ASSERT_EQ(map.size(), reference.size());
+        if (i % 2000 == 0) snapshots.emplace_back(map, reference);
+    }
+
+    const std::map<int, std::string> expected(reference.begin(), reference.end());
+    EXPECT_EQ(ToMap(map), expected);
+    for (const auto& [snapshot, snapshot_reference] : snapshots) {
+        const std::map<int, std::string> snapshot_expected(snapshot_reference.begin(), snapshot_reference.end());
+        EXPECT_EQ(ToMap(snapshot), snapshot_expected);
+    }
+}
+
+TEST(PersistentHashMap, MoveOnlyValues) {
+    cache::PersistentHashMap<std::string, std::unique_ptr<int>> map;
+    map.insert_or_assign("a", std::make_unique<int>(1));
+    map.try_emplace("b", std::make_unique<int>(2));
+    EXPECT_EQ(*map.at("a"), 1);
+    EXPECT_EQ(*map.at("b"), 2);
+
+    auto moved = std::move(map);
+    EXPECT_EQ(moved.size(), 2);
+    EXPECT_EQ(*moved.at("b"), 2);
+}
+
+USERVER_NAMESPACE_END
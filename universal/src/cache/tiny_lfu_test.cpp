@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include <userver/cache/impl/frequency_sketch.hpp>
+#include <userver/cache/lru_map.hpp>
+
+USERVER_NAMESPACE_BEGIN
+
+namespace {
+
+using TinyLfu = cache::LruMap<int, int, std::hash<int>, std::equal_to<int>, cache::CachePolicy::kTinyLFU>;
+using Lru = cache::LruMap<int, int>;
+
+// Zipf-like workload over a small hot set interleaved with a scan over keys
+// that are never requested again
+template <typename Cache>
+double GetHitRatioWithScans(Cache& cache) {
+    constexpr int kHotKeys = 100;
+    constexpr int kRequests = 100'000;
+
+    std::mt19937 rng(42);
+    std::geometric_distribution<int> hot_distribution(0.05);
+    int scan_key = kHotKeys;
+
+    int hits = 0;
+    for (int i = 0; i < kRequests; ++i) {
+        const auto key = (i % 2 == 0) ? hot_distribution(rng) % kHotKeys : scan_key++;
+        if (cache.Get(key)) {
+            ++hits;
+        } else {
+            cache.Put(key, key);
+        }
+    }
+    return static_cast<double>(hits) / kRequests;
+}
+
+}  // namespace
+
+TEST(FrequencySketch, Estimate) {
+    cache::impl::FrequencySketch sketch(100);
+    EXPECT_EQ(sketch.GetFrequency(1), 0);
+
+    for (int i = 0; i < 5; ++i) sketch.RecordAccess(1);
+    sketch.RecordAccess(2);
+
+    EXPECT_EQ(sketch.GetFrequency(1), 5);
+    EXPECT_EQ(sketch.GetFrequency(2), 1);
+    EXPECT_EQ(sketch.GetFrequency(3), 0);
+
+    for (int i = 0; i < 100; ++i) sketch.RecordAccess(1);
+    EXPECT_EQ(sketch.GetFrequency(1), 15) << "counters saturate";
+
+    sketch.Clear();
+    EXPECT_EQ(sketch.GetFrequency(1), 0);
+}
+
+TEST(FrequencySketch, Aging) {
+    cache::impl::FrequencySketch sketch(10);
+    for (int i = 0; i < 8; ++i) sketch.RecordAccess(1);
+
+    // 10 x capacity accesses halve all the counters
+    for (std::size_t key = 100; key < 192; ++key) sketch.RecordAccess(key);
+    EXPECT_EQ(sketch.GetFrequency(1), 4);
+}
+
+TEST(FrequencySketch, ConcurrentRecords) {
+    cache::impl::FrequencySketch sketch(1000);
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; ++thread) {
+        threads.emplace_back([&sketch] {
+            for (int i = 0; i < 1000; ++i) sketch.RecordAccess(i % 2);
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    EXPECT_EQ(sketch.GetFrequency(0), 15);
+    EXPECT_EQ(sketch.GetFrequency(1), 15);
+    EXPECT_EQ(sketch.GetFrequency(2), 0) << "counters must not overflow into the neighbours";
+}
+
+TEST(TinyLfu, SetGet) {
+    TinyLfu cache(10);
+    EXPECT_EQ(nullptr, cache.Get(1));
+    EXPECT_TRUE(cache.Put(1, 2));
+    EXPECT_EQ(2, cache.GetOr(1, -1));
+    EXPECT_FALSE(cache.Put(1, 3));
+    EXPECT_EQ(3, cache.GetOr(1, -1));
+    EXPECT_EQ(3, *cache.Peek(1));
+
+    EXPECT_EQ(4, *cache.Emplace(2, 4));
+    EXPECT_EQ(4, *cache.Emplace(2, 5));
+
+    cache.Erase(1);
+    EXPECT_EQ(nullptr, cache.Get(1));
+    EXPECT_EQ(nullptr, cache.Peek(1));
+    EXPECT_EQ(1, cache.GetSize());
+
+    cache.Clear();
+    EXPECT_EQ(0, cache.GetSize());
+}
+
+TEST(TinyLfu, SizeLimit) {
+    TinyLfu cache(100);
+    EXPECT_EQ(100, cache.GetCapacity());
+    for (int i = 0; i < 1000; ++i) {
+        cache.Put(i, i);
+        ASSERT_LE(cache.GetSize(), 100);
+    }
+    EXPECT_EQ(100, cache.GetSize());
+
+    std::set<int> keys;
+    cache.VisitAll([&keys](int key, int value) {
+        EXPECT_EQ(key, value);
+        EXPECT_TRUE(keys.insert(key).second);
+    });
+    EXPECT_EQ(keys.size(), 100);
+
+    cache.SetMaxSize(10);
+    EXPECT_EQ(10, cache.GetCapacity());
+    EXPECT_LE(cache.GetSize(), 10);
+
+    cache.SetMaxSize(1);
+    cache.Put(1, 1);
+    cache.Put(2, 2);
+    EXPECT_EQ(1, cache.GetSize());
+    EXPECT_EQ(2, cache.GetOr(2, -1));
+}
+
+TEST(TinyLfu, FrequentKeysSurviveScan) {
+    TinyLfu cache(100);
+    for (int i = 0; i < 50; ++i) {
+        for (int j = 0; j < 3; ++j) {
+            if (!cache.Get(i)) cache.Put(i, i);
+        }
+    }
+    // Moves the last hot key out of the window
+    cache.Put(-1, -1);
+
+    // A scan 5 times longer than the cache, but shorter than the aging period
+    for (int i = 1000; i < 1500; ++i) cache.Put(i, i);
+
+    for (int i = 0; i < 50; ++i) {
+        EXPECT_NE(nullptr, cache.Peek(i)) << i;
+    }
+}
+
+TEST(TinyLfu, ScanResistantHitRatio) {
+    TinyLfu tiny_lfu(50);
+    Lru lru(50);
+
+    const auto tiny_lfu_hit_ratio = GetHitRatioWithScans(tiny_lfu);
+    const auto lru_hit_ratio = GetHitRatioWithScans(lru);
+
+    EXPECT_GT(tiny_lfu_hit_ratio, lru_hit_ratio + 0.05) << tiny_lfu_hit_ratio << " vs " << lru_hit_ratio;
+}
+
+USERVER_NAMESPACE_END
@@ -1,7 +1,10 @@
 #include <userver/compression/zstd.hpp>
 
 #include <memory>
+#include <stdexcept>
 
+#include <fmt/format.h>
+#include <zdict.h>
 #include <zstd.h>
 #include <zstd_errors.h>
 
@@ -12,6 +15,21 @@ namespace compression::zstd {
 namespace {
 // The same size as in ZSTD_DStreamOutSize();
 const size_t kDecompressBufferSize = ZSTD_DStreamOutSize();
+
+struct CCtxDeleter {
+    void operator()(ZSTD_CCtx* ctx) const noexcept { ZSTD_freeCCtx(ctx); }
+};
+
+struct DCtxDeleter {
+    void operator()(ZSTD_DCtx* ctx) const noexcept { ZSTD_freeDCtx(ctx); }
+};
+
+void CheckCompressionResult(std::size_t result, std::string_view operation) {
+    if (ZSTD_isError(result)) {
+        throw std::runtime_error(fmt::format("ZSTD {} failed: {}", operation, ZSTD_getErrorName(result)));
+    }
+}
+
 }  // namespace
 
 std::string DecompressStream(std::string_view compressed, size_t max_size) {
@@ -80,5 +98,127 @@ std::string Decompress(std::string_view compressed, size_t max_size) {
     return decompressed;
 }
 
+struct Compressor::Impl {
+    std::unique_ptr<ZSTD_CCtx, CCtxDeleter> ctx;
+};
+
+Compressor::Compressor(const CompressionSettings& settings) : impl_(Impl{{ZSTD_createCCtx(), CCtxDeleter{}}}) {
+    auto* ctx = impl_->ctx.get();
+    if (ctx == nullptr) {
+        throw std::runtime_error("Couldn't create ZSTD compression context");
+    }
+
+    CheckCompressionResult(ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, settings.level), "set level");
+    if (settings.long_distance_matching) {
+        CheckCompressionResult(ZSTD_CCtx_setParameter(ctx, ZSTD_c_enableLongDistanceMatching, 1), "enable LDM");
+    }
+    if (!settings.dictionary.empty()) {
+        CheckCompressionResult(
+            ZSTD_CCtx_loadDictionary(ctx, settings.dictionary.data(), settings.dictionary.size()), "load dictionary"
+        );
+    }
+}
+
+Compressor::Compressor(Compressor&&) noexcept = default;
+
+Compressor& Compressor::operator=(Compressor&&) noexcept = default;
+
+Compressor::~Compressor() = default;
+
+void Compressor::Compress(std::string_view data, std::string& output) {
+    ZSTD_inBuffer input{data.data(), data.size(), 0};
+    while (input.pos < input.size) {
+        const auto old_size = output.size();
+        output.resize(old_size + ZSTD_CStreamOutSize());
+        ZSTD_outBuffer out{output.data() + old_size, output.size() - old_size, 0};
+
+        const auto result = ZSTD_compressStream2(impl_->ctx.get(), &out, &input, ZSTD_e_continue);
+        output.resize(old_size + out.pos);
+        CheckCompressionResult(result, "compression");
+    }
+}
+
+void Compressor::Finish(std::string& output) {
+    ZSTD_inBuffer input{nullptr, 0, 0};
+    for (std::size_t remaining = 1; remaining != 0;) {
+        const auto old_size = output.size();
+        output.resize(old_size + ZSTD_CStreamOutSize());
+        ZSTD_outBuffer out{output.data() + old_size, output.size() - old_size, 0};
+
+        remaining = ZSTD_compressStream2(impl_->ctx.get(), &out, &input, ZSTD_e_end);
+        output.resize(old_size + out.pos);
+        CheckCompressionResult(remaining, "compression");
+    }
+}
+
+std::string Compress(std::string_view data, const CompressionSettings& settings) {
+    std::string result;
+    Compressor compressor(settings);
+    compressor.Compress(data, result);
+    compressor.Finish(result);
+    return result;
+}
+
+std::string TrainDictionary(const std::vector<std::string>& samples, std::size_t max_size) {
+    std::string samples_buffer;
+    std::vector<std::size_t> sample_sizes;
+    sample_sizes.reserve(samples.size());
+    for (const auto& sample : samples) {
+        samples_buffer += sample;
+        sample_sizes.push_back(sample.size());
+    }
+
+    std::string dictionary(max_size, '\0');
+    const auto size = ZDICT_trainFromBuffer(
+        dictionary.data(),
+        dictionary.size(),
+        samples_buffer.data(),
+        sample_sizes.data(),
+        static_cast<unsigned>(sample_sizes.size())
+    );
+    if (ZDICT_isError(size)) {
+        throw std::runtime_error(fmt::format("ZSTD dictionary training failed: {}", ZDICT_getErrorName(size)));
+    }
+    dictionary.resize(size);
+    return dictionary;
+}
+
+struct Decompressor::Impl {
+    std::unique_ptr<ZSTD_DCtx, DCtxDeleter> ctx;
+    bool is_frame_complete{false};
+};
+
+Decompressor::Decompressor(std::string dictionary) : impl_(Impl{{ZSTD_createDCtx(), DCtxDeleter{}}, false}) {
+    auto* ctx = impl_->ctx.get();
+    if (ctx == nullptr) {
+        throw std::runtime_error("Couldn't create ZSTD decompression context");
+    }
+    if (!dictionary.empty()) {
+        CheckCompressionResult(ZSTD_DCtx_loadDictionary(ctx, dictionary.data(), dictionary.size()), "load dictionary");
+    }
+}
+
+Decompressor::Decompressor(Decompressor&&) noexcept = default;
+
+Decompressor& Decompressor::operator=(Decompressor&&) noexcept = default;
+
+Decompressor::~Decompressor() = default;
+
+std::size_t Decompressor::Decompress(std::string_view& input, char* output, std::size_t output_size) {
+    ZSTD_inBuffer in{input.data(), input.size(), 0};
+    ZSTD_outBuffer out{output, output_size, 0};
+
+    const auto result = ZSTD_decompressStream(impl_->ctx.get(), &out, &in);
+    if (ZSTD_isError(result)) {
+        throw ErrWithCode(ZSTD_getErrorName(result));
+    }
+
+    input.remove_prefix(in.pos);
+    if (in.pos != 0 || out.pos != 0) impl_->is_frame_complete = (result == 0);
+    return out.pos;
+}
+
+bool Decompressor::IsFrameComplete() const noexcept { return impl_->is_frame_complete; }
+
 }  // namespace compression::zstd
 USERVER_NAMESPACE_END
@@ -44,4 +44,25 @@ static void ZstdDecompress(benchmark::State& state) {
 }
 BENCHMARK(ZstdDecompress)->RangeMultiplier(2)->Range(1 << 10, 1 << 15);
 
+// Streaming compression of a dump-like input in small writes,
+// state.range(0) is the compression level
+static void ZstdStreamingCompress(benchmark::State& state) {
+    const auto data = GenerateRandomData(1 << 20);
+    compression::zstd::CompressionSettings settings;
+    settings.level = state.range(0);
+    compression::zstd::Compressor compressor(settings);
+
+    std::string compressed;
+    for ([[maybe_unused]] auto _ : state) {
+        compressed.clear();
+        for (std::size_t pos = 0; pos < data.size(); pos += 1 << 17) {
+            compressor.Compress(std::string_view{data}.substr(pos, 1 << 17), compressed);
+        }
+        compressor.Finish(compressed);
+        benchmark::DoNotOptimize(compressed);
+    }
+    state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(ZstdStreamingCompress)->Arg(-1)->Arg(1)->Arg(3)->Arg(9);
+
 USERVER_NAMESPACE_END
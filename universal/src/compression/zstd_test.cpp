@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <string>
+#include <vector>
+
 #include <zstd.h>
 #include <userver/compression/zstd.hpp>
 
@@ -60,4 +63,125 @@ TEST(Zstd, TestOverflow) {
     );
 }
 
+namespace {
+
+std::string MakeData(std::size_t size) {
+    std::string data;
+    for (std::size_t i = 0; data.size() < size; ++i) data += "key-" + std::to_string(i % 1000) + ";";
+    data.resize(size);
+    return data;
+}
+
+std::string DecompressInPortions(
+    std::string_view compressed,
+    std::size_t portion_size,
+    compression::zstd::Decompressor& decompressor
+) {
+    std::string result;
+    std::string portion(portion_size, '\0');
+    while (true) {
+        const auto size = decompressor.Decompress(compressed, portion.data(), portion.size());
+        if (size == 0 && compressed.empty()) break;
+        result.append(portion.data(), size);
+    }
+    return result;
+}
+
+}  // namespace
+
+TEST(Zstd, StreamingRoundTrip) {
+    const auto data = MakeData(1'000'000);
+
+    compression::zstd::Compressor compressor;
+    std::string compressed;
+    for (std::size_t pos = 0; pos < data.size(); pos += 1000) {
+        compressor.Compress(std::string_view{data}.substr(pos, 1000), compressed);
+    }
+    compressor.Finish(compressed);
+    EXPECT_LT(compressed.size(), data.size() / 10);
+
+    compression::zstd::Decompressor decompressor;
+    EXPECT_EQ(DecompressInPortions(compressed, 777, decompressor), data);
+    EXPECT_TRUE(decompressor.IsFrameComplete());
+
+    EXPECT_EQ(compression::zstd::Decompress(compressed, data.size()), data);
+}
+
+TEST(Zstd, StreamingReuse) {
+    compression::zstd::Compressor compressor;
+    std::string compressed;
+    compressor.Compress("first", compressed);
+    compressor.Finish(compressed);
+    compressor.Compress("second", compressed);
+    compressor.Finish(compressed);
+
+    compression::zstd::Decompressor decompressor;
+    EXPECT_EQ(DecompressInPortions(compressed, 3, decompressor), "firstsecond");
+    EXPECT_TRUE(decompressor.IsFrameComplete());
+}
+
+TEST(Zstd, EmptyFrame) {
+    const auto compressed = compression::zstd::Compress({});
+    EXPECT_FALSE(compressed.empty());
+
+    compression::zstd::Decompressor decompressor;
+    EXPECT_EQ(DecompressInPortions(compressed, 16, decompressor), "");
+    EXPECT_TRUE(decompressor.IsFrameComplete());
+}
+
+TEST(Zstd, Truncated) {
+    const auto data = MakeData(100'000);
+    const auto compressed = compression::zstd::Compress(data);
+
+    compression::zstd::Decompressor decompressor;
+    const auto truncated = std::string_view{compressed}.substr(0, compressed.size() / 2);
+    const auto result = DecompressInPortions(truncated, 1000, decompressor);
+    EXPECT_LT(result.size(), data.size());
+    EXPECT_FALSE(decompressor.IsFrameComplete());
+}
+
+TEST(Zstd, Corrupted) {
+    auto compressed = compression::zstd::Compress(MakeData(100'000));
+    compressed[0] = 'x';
+
+    compression::zstd::Decompressor decompressor;
+    EXPECT_THROW(DecompressInPortions(compressed, 1000, decompressor), compression::DecompressionError);
+}
+
+TEST(Zstd, LongDistanceMatching) {
+    compression::zstd::CompressionSettings settings;
+    settings.long_distance_matching = true;
+    settings.level = 1;
+
+    const auto data = MakeData(1'000'000);
+    const auto compressed = compression::zstd::Compress(data, settings);
+
+    compression::zstd::Decompressor decompressor;
+    EXPECT_EQ(DecompressInPortions(compressed, 1 << 16, decompressor), data);
+}
+
+TEST(Zstd, Dictionary) {
+    std::vector<std::string> samples;
+    for (int i = 0; i < 1000; ++i) {
+        samples.push_back(
+            R"({"id":)" + std::to_string(i) + R"(,"name":"user-)" + std::to_string(i * 7) +
+            R"(","status":"active","roles":["reader","writer"]})"
+        );
+    }
+
+    compression::zstd::CompressionSettings settings;
+    settings.dictionary = compression::zstd::TrainDictionary(samples, 4096);
+    ASSERT_FALSE(settings.dictionary.empty());
+
+    const auto& sample = samples[42];
+    const auto compressed = compression::zstd::Compress(sample, settings);
+    EXPECT_LT(compressed.size(), compression::zstd::Compress(sample).size());
+
+    compression::zstd::Decompressor decompressor(settings.dictionary);
+    EXPECT_EQ(DecompressInPortions(compressed, 16, decompressor), sample);
+
+    compression::zstd::Decompressor no_dictionary;
+    EXPECT_THROW(DecompressInPortions(compressed, 16, no_dictionary), compression::DecompressionError);
+}
+
 USERVER_NAMESPACE_END
@@ -1,17 +1,37 @@
 #include <userver/logging/impl/logger_base.hpp>
 
+#include <logging/log_helper_impl.hpp>
+#include <userver/logging/impl/log_record.hpp>
 #include <userver/logging/impl/tag_writer.hpp>
 
 USERVER_NAMESPACE_BEGIN
 
 namespace logging::impl {
 
+namespace {
+
+Format GetTextFormat(Format format) noexcept { return format == Format::kStructured ? Format::kTskv : format; }
+
+}  // namespace
+
 LoggerBase::LoggerBase(Format format) noexcept : format_(format) {}
 
 LoggerBase::~LoggerBase() = default;
 
 void LoggerBase::Trace(Level level, std::string_view msg) { Log(level, msg); }
 
+void LoggerBase::LogStructured(const LogRecord& record) {
+    LogBuffer buffer;
+    FormatLogRecord(buffer, GetTextFormat(format_), record);
+    Log(record.level, std::string_view{buffer.data(), buffer.size()});
+}
+
+void LoggerBase::TraceStructured(const LogRecord& record) {
+    LogBuffer buffer;
+    FormatLogRecord(buffer, GetTextFormat(format_), record);
+    Trace(record.level, std::string_view{buffer.data(), buffer.size()});
+}
+
 void LoggerBase::Flush() {}
 
 void LoggerBase::PrependCommonTags(TagWriter /*writer*/) const {}
@@ -1,5 +1,7 @@
 #include <userver/logging/impl/tag_writer.hpp>
 
+#include <variant>
+
 #include <fmt/format.h>
 #include <boost/container/small_vector.hpp>
 
@@ -29,10 +31,17 @@ std::string_view RuntimeTagKey::GetUnescapedKey() const noexcept { return unesca
 
 void TagWriter::PutLogExtra(const LogExtra& extra) {
     for (const auto& item : *extra.extra_) {
-        PutTag(RuntimeTagKey{item.first}, item.second.GetValue());
+        // Unwrap the variant to keep the type of the value
+        std::visit([&](const auto& value) { PutTag(RuntimeTagKey{item.first}, value); }, item.second.GetValue());
     }
 }
 
+void TagWriter::PutTag(const LogTag& tag) {
+    PutKey(RuntimeTagKey{tag.key});
+    lh_ << tag.value;
+    MarkValueEnd(tag.type);
+}
+
 void TagWriter::ExtendLogExtra(const LogExtra& extra) { lh_.pimpl_->GetLogExtra().Extend(extra); }
 
 TagWriter::TagWriter(LogHelper& lh) noexcept : lh_(lh) {}
@@ -41,7 +50,7 @@ void TagWriter::PutKey(TagKey key) { lh_.pimpl_->PutRawKey(key.GetEscapedKey());
 
 void TagWriter::PutKey(RuntimeTagKey key) { lh_.pimpl_->PutKey(key.GetUnescapedKey()); }
 
-void TagWriter::MarkValueEnd() noexcept { lh_.pimpl_->MarkValueEnd(); }
+void TagWriter::MarkValueEnd(TagType type) { lh_.pimpl_->MarkValueEnd(type); }
 
 }  // namespace logging::impl
 
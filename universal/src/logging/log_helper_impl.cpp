@@ -1,10 +1,12 @@
 #include "log_helper_impl.hpp"
 
 #include <array>
+#include <cstring>
 
 #include <fmt/chrono.h>
 #include <fmt/compile.h>
 #include <fmt/format.h>
+#include <boost/container/small_vector.hpp>
 
 #include <userver/compiler/impl/constexpr.hpp>
 #include <userver/compiler/thread_local.hpp>
@@ -18,13 +20,16 @@ namespace logging {
 
 namespace {
 
-char GetSeparatorFromLogger(LoggerRef logger) {
-    switch (logger.GetFormat()) {
+char GetKeyValueSeparator(Format format) {
+    switch (format) {
         case Format::kTskv:
         case Format::kRaw:
             return '=';
         case Format::kLtsv:
             return ':';
+        case Format::kJson:
+        case Format::kStructured:
+            return '\0';
     }
 
     UINVARIANT(false, "Invalid logging::Format enum value");
@@ -65,44 +70,80 @@ TimeString GetCurrentTimeString(TimePoint now) noexcept {
     return cached_time->string;
 }
 
-}  // namespace
+constexpr bool NeedsJsonEscaping(char c) noexcept {
+    return static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\';
+}
 
-auto LogHelper::Impl::BufferStd::overflow(int_type c) -> int_type {
-    if (c == std::streambuf::traits_type::eof()) return c;
-    impl_.PutValuePart(static_cast<char>(c));
-    return c;
+bool NeedsJsonEscaping(std::string_view str) noexcept {
+    for (const char c : str) {
+        if (NeedsJsonEscaping(c)) return true;
+    }
+    return false;
 }
 
-std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s, std::streamsize n) {
-    impl_.PutValuePart(std::string_view(s, n));
-    return n;
+void EncodeJson(LogBuffer& buffer, char c) {
+    switch (c) {
+        case '"':
+            buffer.append(std::string_view{"\\\""});
+            return;
+        case '\\':
+            buffer.append(std::string_view{"\\\\"});
+            return;
+        case '\n':
+            buffer.append(std::string_view{"\\n"});
+            return;
+        case '\r':
+            buffer.append(std::string_view{"\\r"});
+            return;
+        case '\t':
+            buffer.append(std::string_view{"\\t"});
+            return;
+        default:
+            break;
+    }
+
+    if (NeedsJsonEscaping(c)) {
+        fmt::format_to(fmt::appender(buffer), FMT_COMPILE("\\u{:04x}"), static_cast<unsigned char>(c));
+    } else {
+        buffer.push_back(c);
+    }
 }
 
-LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
-    : logger_(&logger),
-      level_(std::max(level, logger_->GetLevel())),
-      key_value_separator_(GetSeparatorFromLogger(*logger_)) {
-    static_assert(
-        sizeof(LogHelper::Impl) < 4096,
-        "Structures with size more than 4096 would consume at least "
-        "8KB memory in allocator."
-    );
-    if constexpr (utils::impl::kEnableAssert) {
-        debug_tag_keys_.emplace();
+void EncodeJson(LogBuffer& buffer, std::string_view str) {
+    while (!str.empty()) {
+        std::size_t plain_size = 0;
+        while (plain_size < str.size() && !NeedsJsonEscaping(str[plain_size])) ++plain_size;
+        buffer.append(str.substr(0, plain_size));
+        if (plain_size == str.size()) return;
+
+        EncodeJson(buffer, str[plain_size]);
+        str.remove_prefix(plain_size + 1);
     }
 }
 
-void LogHelper::Impl::PutMessageBegin() {
-    UASSERT(msg_.size() == 0);
+bool IsJsonNumber(std::string_view value, impl::TagType type) noexcept {
+    switch (type) {
+        case impl::TagType::kString:
+            return false;
+        case impl::TagType::kInteger:
+            return !value.empty();
+        case impl::TagType::kFloat:
+            // 'inf' and 'nan' are not valid JSON numbers
+            return !value.empty() && value.find_first_of("in") == std::string_view::npos;
+    }
+    return false;
+}
 
-    switch (logger_->GetFormat()) {
+void WriteMessageBegin(LogBuffer& msg, Format format, Level level, TimePoint now) {
+    UASSERT(msg.size() == 0);
+
+    switch (format) {
         case Format::kTskv: {
             constexpr std::string_view kTemplate = "tskv\ttimestamp=0000-00-00T00:00:00.000000\tlevel=";
-            const auto now = TimePoint::clock::now();
-            const auto level_string = logging::ToUpperCaseString(level_);
-            msg_.resize(kTemplate.size() + level_string.size());
+            const auto level_string = logging::ToUpperCaseString(level);
+            msg.resize(kTemplate.size() + level_string.size());
             fmt::format_to(
-                msg_.data(),
+                msg.data(),
                 FMT_COMPILE("tskv\ttimestamp={}.{:06}\tlevel={}"),
                 GetCurrentTimeString(now).ToStringView(),
                 FractionalMicroseconds(now),
@@ -112,11 +153,10 @@ void LogHelper::Impl::PutMessageBegin() {
         }
         case Format::kLtsv: {
             constexpr std::string_view kTemplate = "timestamp:0000-00-00T00:00:00.000000\tlevel:";
-            const auto now = TimePoint::clock::now();
-            const auto level_string = logging::ToUpperCaseString(level_);
-            msg_.resize(kTemplate.size() + level_string.size());
+            const auto level_string = logging::ToUpperCaseString(level);
+            msg.resize(kTemplate.size() + level_string.size());
             fmt::format_to(
-                msg_.data(),
+                msg.data(),
                 FMT_COMPILE("timestamp:{}.{:06}\tlevel:{}"),
                 GetCurrentTimeString(now).ToStringView(),
                 FractionalMicroseconds(now),
@@ -124,49 +164,211 @@ void LogHelper::Impl::PutMessageBegin() {
             );
             return;
         }
+        case Format::kJson: {
+            constexpr std::string_view kTemplate = R"({"timestamp":"0000-00-00T00:00:00.000000","level":"")";
+            const auto level_string = logging::ToUpperCaseString(level);
+            msg.resize(kTemplate.size() + level_string.size());
+            fmt::format_to(
+                msg.data(),
+                FMT_COMPILE(R"({{"timestamp":"{}.{:06}","level":"{}")"),
+                GetCurrentTimeString(now).ToStringView(),
+                FractionalMicroseconds(now),
+                level_string
+            );
+            return;
+        }
         case Format::kRaw: {
-            msg_.append(std::string_view{"tskv"});
+            msg.append(std::string_view{"tskv"});
             return;
         }
+        case Format::kStructured:
+            return;
     }
     UASSERT_MSG(false, "Invalid value of Format enum");
 }
 
-void LogHelper::Impl::PutMessageEnd() { msg_.push_back('\n'); }
+void WriteRawKey(LogBuffer& msg, Format format, std::string_view key) {
+    if (format == Format::kJson) {
+        msg.append(std::string_view{R"(,")"});
+        msg.append(key);
+        msg.append(std::string_view{R"(":")"});
+        return;
+    }
+
+    const auto old_size = msg.size();
+    msg.resize(old_size + 1 + key.size() + 1);
+
+    auto* position = msg.data() + old_size;
+    *(position++) = utils::encoding::kTskvPairsSeparator;
+    key.copy(position, key.size());
+    position += key.size();
+    *(position++) = GetKeyValueSeparator(format);
+}
+
+bool ShouldKeyBeEscaped(Format format, std::string_view key) noexcept {
+    return format == Format::kJson ? NeedsJsonEscaping(key) : utils::encoding::ShouldKeyBeEscaped(key);
+}
+
+void WriteEscapedKey(LogBuffer& msg, Format format, std::string_view key) {
+    if (format == Format::kJson) {
+        msg.append(std::string_view{R"(,")"});
+        EncodeJson(msg, key);
+        msg.append(std::string_view{R"(":")"});
+        return;
+    }
+
+    msg.push_back(utils::encoding::kTskvPairsSeparator);
+    utils::encoding::EncodeTskv(msg, key, utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
+    msg.push_back(GetKeyValueSeparator(format));
+}
+
+void WriteValuePart(LogBuffer& msg, Format format, std::string_view value) {
+    switch (format) {
+        case Format::kJson:
+            EncodeJson(msg, value);
+            return;
+        case Format::kStructured:
+            msg.append(value);
+            return;
+        default:
+            utils::encoding::EncodeTskv(msg, value, utils::encoding::EncodeTskvMode::kValue);
+            return;
+    }
+}
+
+void WriteValueEnd(LogBuffer& msg, Format format, std::size_t value_begin, impl::TagType type) {
+    if (format != Format::kJson) return;
+
+    const auto value_size = msg.size() - value_begin;
+    if (IsJsonNumber({msg.data() + value_begin, value_size}, type)) {
+        // Numbers go without the quotes, drop the opening one
+        std::memmove(msg.data() + value_begin - 1, msg.data() + value_begin, value_size);
+        msg.resize(msg.size() - 1);
+    } else {
+        msg.push_back('"');
+    }
+}
+
+void WriteMessageEnd(LogBuffer& msg, Format format) {
+    switch (format) {
+        case Format::kJson:
+            msg.append(std::string_view{"}\n"});
+            return;
+        case Format::kStructured:
+            return;
+        default:
+            msg.push_back('\n');
+            return;
+    }
+}
+
+}  // namespace
+
+namespace impl {
+
+void FormatLogRecord(LogBuffer& buffer, Format format, const LogRecord& record) {
+    UASSERT(format != Format::kStructured);
+    WriteMessageBegin(buffer, format, record.level, record.timestamp);
+
+    const auto write_tag = [&buffer, format](std::string_view key, std::string_view value, TagType type) {
+        if (ShouldKeyBeEscaped(format, key)) {
+            WriteEscapedKey(buffer, format, key);
+        } else {
+            WriteRawKey(buffer, format, key);
+        }
+        const auto value_begin = buffer.size();
+        WriteValuePart(buffer, format, value);
+        WriteValueEnd(buffer, format, value_begin, type);
+    };
+    for (const auto& tag : record.tags) {
+        write_tag(tag.key, tag.value, tag.type);
+    }
+    write_tag("text", record.text, TagType::kString);
+
+    WriteMessageEnd(buffer, format);
+}
+
+}  // namespace impl
+
+auto LogHelper::Impl::BufferStd::overflow(int_type c) -> int_type {
+    if (c == std::streambuf::traits_type::eof()) return c;
+    impl_.PutValuePart(static_cast<char>(c));
+    return c;
+}
+
+std::streamsize LogHelper::Impl::BufferStd::xsputn(const char_type* s, std::streamsize n) {
+    impl_.PutValuePart(std::string_view(s, n));
+    return n;
+}
+
+LogHelper::Impl::Impl(LoggerRef logger, Level level) noexcept
+    : logger_(&logger), level_(std::max(level, logger_->GetLevel())), format_(logger_->GetFormat()) {
+    static_assert(
+        sizeof(LogHelper::Impl) < 4096,
+        "Structures with size more than 4096 would consume at least "
+        "8KB memory in allocator."
+    );
+    if constexpr (utils::impl::kEnableAssert) {
+        debug_tag_keys_.emplace();
+    }
+}
+
+void LogHelper::Impl::PutMessageBegin() {
+    timestamp_ = TimePoint::clock::now();
+    WriteMessageBegin(msg_, format_, level_, timestamp_);
+}
+
+void LogHelper::Impl::PutMessageEnd() { WriteMessageEnd(msg_, format_); }
 
 void LogHelper::Impl::PutKey(std::string_view key) {
-    if (!utils::encoding::ShouldKeyBeEscaped(key)) {
+    // Keys of the structured records are passed unescaped
+    if (format_ == Format::kStructured || !ShouldKeyBeEscaped(format_, key)) {
         PutRawKey(key);
     } else {
-        UASSERT(!std::exchange(is_within_value_, true));
+        UASSERT(!is_within_value_);
+        is_within_value_ = true;
         CheckRepeatedKeys(key);
-        msg_.push_back(utils::encoding::kTskvPairsSeparator);
-        utils::encoding::EncodeTskv(msg_, key, utils::encoding::EncodeTskvMode::kKeyReplacePeriod);
-        msg_.push_back(key_value_separator_);
+        WriteEscapedKey(msg_, format_, key);
+        value_begin_ = msg_.size();
     }
 }
 
 void LogHelper::Impl::PutRawKey(std::string_view key) {
-    UASSERT(!std::exchange(is_within_value_, true));
+    UASSERT(!is_within_value_);
+    is_within_value_ = true;
     CheckRepeatedKeys(key);
-    const auto old_size = msg_.size();
-    msg_.resize(old_size + 1 + key.size() + 1);
 
-    auto* position = msg_.data() + old_size;
-    *(position++) = utils::encoding::kTskvPairsSeparator;
-    key.copy(position, key.size());
-    position += key.size();
-    *(position++) = key_value_separator_;
+    if (format_ == Format::kStructured) {
+        // The header is filled in MarkValueEnd
+        tag_begin_ = msg_.size();
+        msg_.resize(tag_begin_ + sizeof(TagHeader));
+        msg_.append(key);
+        value_begin_ = msg_.size();
+        return;
+    }
+
+    WriteRawKey(msg_, format_, key);
+    value_begin_ = msg_.size();
 }
 
 void LogHelper::Impl::PutValuePart(std::string_view value) {
     UASSERT(is_within_value_);
-    utils::encoding::EncodeTskv(msg_, value, utils::encoding::EncodeTskvMode::kValue);
+    WriteValuePart(msg_, format_, value);
 }
 
 void LogHelper::Impl::PutValuePart(char text_part) {
     UASSERT(is_within_value_);
-    utils::encoding::EncodeTskv(fmt::appender(msg_), text_part, utils::encoding::EncodeTskvMode::kValue);
+    switch (format_) {
+        case Format::kJson:
+            EncodeJson(msg_, text_part);
+            return;
+        case Format::kStructured:
+            msg_.push_back(text_part);
+            return;
+        default:
+            utils::encoding::EncodeTskv(fmt::appender(msg_), text_part, utils::encoding::EncodeTskvMode::kValue);
+            return;
+    }
 }
 
 LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() noexcept {
@@ -174,12 +376,26 @@ LogBuffer& LogHelper::Impl::GetBufferForRawValuePart() noexcept {
     return msg_;
 }
 
-void LogHelper::Impl::MarkValueEnd() noexcept { UASSERT(std::exchange(is_within_value_, false)); }
+void LogHelper::Impl::MarkValueEnd(impl::TagType type) {
+    UASSERT(is_within_value_);
+    is_within_value_ = false;
+
+    if (format_ == Format::kStructured) {
+        TagHeader header;
+        header.key_size = static_cast<std::uint32_t>(value_begin_ - tag_begin_ - sizeof(TagHeader));
+        header.value_size = static_cast<std::uint32_t>(msg_.size() - value_begin_);
+        header.type = type;
+        std::memcpy(msg_.data() + tag_begin_, &header, sizeof(header));
+        return;
+    }
+    WriteValueEnd(msg_, format_, value_begin_, type);
+}
 
 void LogHelper::Impl::MarkAsTrace() noexcept { is_trace_ = true; }
 
 void LogHelper::Impl::StartText() {
     PutRawKey("text");
+    text_tag_begin_ = tag_begin_;
     initial_length_ = msg_.size();
 }
 
@@ -197,6 +413,11 @@ void LogHelper::Impl::LogTheMessage() const {
     }
 
     UASSERT(logger_);
+    if (format_ == Format::kStructured) {
+        LogStructured();
+        return;
+    }
+
     const std::string_view message(msg_.data(), msg_.size());
     if (is_trace_)
         logger_->Trace(level_, message);
@@ -204,6 +425,35 @@ void LogHelper::Impl::LogTheMessage() const {
         logger_->Log(level_, message);
 }
 
+void LogHelper::Impl::LogStructured() const {
+    boost::container::small_vector<impl::LogTag, 16> tags;
+    impl::LogRecord record;
+    record.level = level_;
+    record.timestamp = timestamp_;
+
+    std::size_t position = 0;
+    while (position < msg_.size()) {
+        TagHeader header;
+        std::memcpy(&header, msg_.data() + position, sizeof(header));
+        const auto* const key_begin = msg_.data() + position + sizeof(header);
+        const std::string_view key{key_begin, header.key_size};
+        const std::string_view value{key_begin + header.key_size, header.value_size};
+
+        if (position == text_tag_begin_) {
+            record.text = value;
+        } else {
+            tags.push_back({key, value, header.type});
+        }
+        position += sizeof(header) + header.key_size + header.value_size;
+    }
+    record.tags = tags;
+
+    if (is_trace_)
+        logger_->TraceStructured(record);
+    else
+        logger_->LogStructured(record);
+}
+
 void LogHelper::Impl::MarkAsBroken() noexcept { logger_ = nullptr; }
 
 bool LogHelper::Impl::IsBroken() const noexcept { return !logger_; }
@@ -1,11 +1,15 @@
 #pragma once
 
+#include <chrono>
+#include <cstdint>
 #include <optional>
 #include <ostream>
 #include <unordered_set>
 
 #include <fmt/format.h>
 
+#include <userver/logging/format.hpp>
+#include <userver/logging/impl/log_record.hpp>
 #include <userver/logging/level.hpp>
 #include <userver/logging/log.hpp>
 #include <userver/logging/log_extra.hpp>
@@ -17,6 +21,13 @@ namespace logging {
 inline constexpr std::size_t kInitialLogBufferSize = 1500;
 using LogBuffer = fmt::basic_memory_buffer<char, kInitialLogBufferSize>;
 
+namespace impl {
+
+// Serializes the record the same way LogHelper does for the text formats
+void FormatLogRecord(LogBuffer& buffer, Format format, const LogRecord& record);
+
+}  // namespace impl
+
 struct LogHelper::InternalTag final {};
 
 class LogHelper::Impl final {
@@ -38,7 +49,7 @@ public:
     LogBuffer& GetBufferForRawValuePart() noexcept;
 
     bool IsWithinValue() const noexcept { return is_within_value_; }
-    void MarkValueEnd() noexcept;
+    void MarkValueEnd(impl::TagType type = impl::TagType::kString);
 
     LogExtra& GetLogExtra() { return extra_; }
 
@@ -76,17 +87,31 @@ private:
         explicit LazyInitedStream(Impl& impl) : sbuf{impl}, ostr(&sbuf) {}
     };
 
+    // For Format::kStructured msg_ contains the tags one after another,
+    // each one is the header followed by the unescaped key and value
+    struct TagHeader final {
+        std::uint32_t key_size{0};
+        std::uint32_t value_size{0};
+        impl::TagType type{impl::TagType::kString};
+    };
+
     LazyInitedStream& GetLazyInitedStream();
 
     void CheckRepeatedKeys(std::string_view raw_key);
 
+    void LogStructured() const;
+
     impl::LoggerBase* logger_;
     const Level level_;
-    const char key_value_separator_;
+    const Format format_;
     LogBuffer msg_;
     std::optional<LazyInitedStream> lazy_stream_;
     LogExtra extra_;
     std::size_t initial_length_{0};
+    std::size_t value_begin_{0};
+    std::size_t tag_begin_{0};
+    std::size_t text_tag_begin_{0};
+    std::chrono::system_clock::time_point timestamp_{};
     bool is_within_value_{false};
     bool is_trace_{false};
     std::optional<std::unordered_set<std::string>> debug_tag_keys_;